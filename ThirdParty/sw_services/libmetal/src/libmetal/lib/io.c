@@ -32,11 +32,79 @@ void metal_io_init(struct metal_io_region *io, void *virt,
 	metal_sys_io_mem_map(io);
 }
 
+/* Word of the block copies, 64-bit wide on 64-bit targets. */
+typedef unsigned long metal_io_word_t;
+
+#define METAL_IO_WORD		sizeof(metal_io_word_t)
+#define METAL_IO_WORD_BITS	(METAL_IO_WORD * CHAR_BIT)
+
+/* Merges two consecutive aligned words into the word at byte shift / 8. */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define METAL_IO_MERGE(lo, hi, shift) \
+	(((lo) << (shift)) | ((hi) >> (METAL_IO_WORD_BITS - (shift))))
+#else
+#define METAL_IO_MERGE(lo, hi, shift) \
+	(((lo) >> (shift)) | ((hi) << (METAL_IO_WORD_BITS - (shift))))
+#endif
+
+/*
+ * Copy with accesses no larger than a word and aligned to their size, so
+ * that it is also safe on device memory. When source and destination are
+ * not co-aligned, the destination is written a word at a time from
+ * aligned source words merged by shifting; the source words holding the
+ * first and last bytes are then read in full.
+ */
+static void metal_io_copy(void *restrict dst, const void *restrict src,
+			  int len)
+{
+	unsigned char *d = dst;
+	const unsigned char *s = src;
+	const metal_io_word_t *sw;
+	metal_io_word_t *dw;
+	metal_io_word_t lo, hi;
+	unsigned int shift;
+
+	if (len >= (int)(2 * METAL_IO_WORD)) {
+		for (; (uintptr_t)d % METAL_IO_WORD; d++, s++, len--)
+			*d = *s;
+
+		dw = (metal_io_word_t *)d;
+		shift = ((uintptr_t)s % METAL_IO_WORD) * CHAR_BIT;
+		if (!shift) {
+			sw = (const metal_io_word_t *)s;
+			for (; len >= (int)(4 * METAL_IO_WORD);
+			     dw += 4, sw += 4, len -= 4 * METAL_IO_WORD) {
+				dw[0] = sw[0];
+				dw[1] = sw[1];
+				dw[2] = sw[2];
+				dw[3] = sw[3];
+			}
+			for (; len >= (int)METAL_IO_WORD;
+			     dw++, sw++, len -= METAL_IO_WORD)
+				*dw = *sw;
+			s = (const unsigned char *)sw;
+		} else {
+			sw = (const metal_io_word_t *)(s - shift / CHAR_BIT);
+			lo = *sw++;
+			for (; len >= (int)METAL_IO_WORD;
+			     dw++, s += METAL_IO_WORD, len -= METAL_IO_WORD) {
+				hi = *sw++;
+				*dw = METAL_IO_MERGE(lo, hi, shift);
+				lo = hi;
+			}
+		}
+		d = (unsigned char *)dw;
+	}
+
+	for (; len; d++, s++, len--)
+		*d = *s;
+}
+
 int metal_io_block_read(struct metal_io_region *io, unsigned long offset,
 	       void *restrict dst, int len)
 {
 	unsigned char *ptr = metal_io_virt(io, offset);
-	unsigned char *dest = dst;
+	memory_order order;
 	int retlen;
 
 	if (offset >= io->size)
@@ -44,27 +112,18 @@ int metal_io_block_read(struct metal_io_region *io, unsigned long offset,
 	if ((offset + len) > io->size)
 		len = io->size - offset;
 	retlen = len;
+	/* Normal memory only needs later reads not to move before the copy */
+	order = (io->mem_flags & METAL_IO_MEM_NORMAL) ?
+		memory_order_acquire : memory_order_seq_cst;
 	if (io->ops.block_read) {
 		retlen = (*io->ops.block_read)(
-			io, offset, dst, memory_order_seq_cst, len);
+			io, offset, dst, order, len);
+	} else if (io->mem_flags & METAL_IO_MEM_NORMAL) {
+		atomic_thread_fence(order);
+		memcpy(dst, ptr, len);
 	} else {
-		atomic_thread_fence(memory_order_seq_cst);
-		while ( len && (
-			((uintptr_t)dest % sizeof(int)) ||
-			((uintptr_t)ptr % sizeof(int)))) {
-			*(unsigned char *)dest =
-				*(const unsigned char *)ptr;
-			dest++;
-			ptr++;
-			len--;
-		}
-		for (; len >= (int)sizeof(int); dest += sizeof(int),
-					ptr += sizeof(int),
-					len -= sizeof(int))
-			*(unsigned int *)dest = *(const unsigned int *)ptr;
-		for (; len != 0; dest++, ptr++, len--)
-			*(unsigned char *)dest =
-				*(const unsigned char *)ptr;
+		atomic_thread_fence(order);
+		metal_io_copy(dst, ptr, len);
 	}
 	return retlen;
 }
@@ -73,7 +132,7 @@ int metal_io_block_write(struct metal_io_region *io, unsigned long offset,
 	       const void *restrict src, int len)
 {
 	unsigned char *ptr = metal_io_virt(io, offset);
-	const unsigned char *source = src;
+	memory_order order;
 	int retlen;
 
 	if (offset >= io->size)
@@ -81,31 +140,21 @@ int metal_io_block_write(struct metal_io_region *io, unsigned long offset,
 	if ((offset + len) > io->size)
 		len = io->size - offset;
 	retlen = len;
+	/* Normal memory only needs the copy not to move after later writes */
+	order = (io->mem_flags & METAL_IO_MEM_NORMAL) ?
+		memory_order_release : memory_order_seq_cst;
 	if (io->ops.block_write) {
 		retlen = (*io->ops.block_write)(
-			io, offset, src, memory_order_seq_cst, len);
+			io, offset, src, order, len);
+	} else if (io->mem_flags & METAL_IO_MEM_NORMAL) {
+		memcpy(ptr, src, len);
+		atomic_thread_fence(order);
 	} else {
-		while ( len && (
-			((uintptr_t)ptr % sizeof(int)) ||
-			((uintptr_t)source % sizeof(int)))) {
-			*(unsigned char *)ptr =
-				*(const unsigned char *)source;
-			ptr++;
-			source++;
-			len--;
-		}
-		for (; len >= (int)sizeof(int); ptr += sizeof(int),
-					source += sizeof(int),
-					len -= sizeof(int))
-			*(unsigned int *)ptr = *(const unsigned int *)source;
-		for (; len != 0; ptr++, source++, len--)
-			*(unsigned char *)ptr =
-				*(const unsigned char *)source;
-		atomic_thread_fence(memory_order_seq_cst);
+		metal_io_copy(ptr, src, len);
+		atomic_thread_fence(order);
 	}
 	return retlen;
 }
-
 int metal_io_block_set(struct metal_io_region *io, unsigned long offset,
 	       unsigned char value, int len)
 {
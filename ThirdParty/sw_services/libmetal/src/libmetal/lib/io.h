@@ -33,6 +33,13 @@ extern "C" {
 #define NO_ATOMIC_64_SUPPORT
 #endif
 
+/**
+ * Memory flag of metal_io_init(), not passed to the machine mappings: the
+ * I/O region is normal memory, where block accesses may use any access
+ * size and only need acquire (read) or release (write) ordering.
+ */
+#define METAL_IO_MEM_NORMAL	(1U << 31)
+
 struct metal_io_region;
 
 /** Generic I/O operations. */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file	rwlock.h
+ * @brief	Reader-writer spinlock primitives for libmetal.
+ */
+
+#ifndef __METAL_RWLOCK__H__
+#define __METAL_RWLOCK__H__
+
+#include <metal/atomic.h>
+#include <metal/cpu.h>
+#include <metal/spinlock.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup rwlock Reader-writer Spinlock Interfaces
+ *  @{ */
+
+/**
+ * Reader-writer spinlock, for read-mostly data: readers share the lock,
+ * writers hold it alone. Waiting writers hold off new readers, so that
+ * writers are not starved.
+ */
+struct metal_rwlock {
+	atomic_int v;			/**< readers, or -1 for a writer */
+	atomic_int writers;		/**< writers waiting or holding */
+	struct metal_lock_stats *stats;	/**< contention counters, or NULL */
+};
+
+/** Static metal reader-writer lock initialization. */
+#define METAL_RWLOCK_INIT	{ATOMIC_VAR_INIT(0), ATOMIC_VAR_INIT(0), NULL}
+
+/**
+ * @brief	Initialize a libmetal reader-writer lock.
+ * @param[in]	rwlock	Reader-writer lock to initialize.
+ * @param[in]	stats	Contention counters, or NULL.
+ */
+static inline void metal_rwlock_init(struct metal_rwlock *rwlock,
+				     struct metal_lock_stats *stats)
+{
+	atomic_store(&rwlock->v, 0);
+	atomic_store(&rwlock->writers, 0);
+	rwlock->stats = stats;
+}
+
+/**
+ * @brief	Acquire a reader-writer lock for reading.
+ * @param[in]	rwlock	Reader-writer lock to acquire.
+ * @see metal_rwlock_read_release
+ */
+static inline void metal_rwlock_read_acquire(struct metal_rwlock *rwlock)
+{
+	unsigned long spins = 0;
+	int v;
+
+	while (1) {
+		if (!atomic_load_explicit(&rwlock->writers,
+					  memory_order_relaxed)) {
+			v = atomic_load_explicit(&rwlock->v,
+						 memory_order_relaxed);
+			if (v >= 0 &&
+			    atomic_compare_exchange_weak(&rwlock->v, &v, v + 1))
+				break;
+		}
+		metal_cpu_yield();
+		spins++;
+	}
+	metal_lock_stats_update(rwlock->stats, spins);
+}
+
+/**
+ * @brief	Release a reader-writer lock acquired for reading.
+ * @param[in]	rwlock	Reader-writer lock to release.
+ * @see metal_rwlock_read_acquire
+ */
+static inline void metal_rwlock_read_release(struct metal_rwlock *rwlock)
+{
+	atomic_fetch_sub(&rwlock->v, 1);
+}
+
+/**
+ * @brief	Acquire a reader-writer lock for writing.
+ * @param[in]	rwlock	Reader-writer lock to acquire.
+ * @see metal_rwlock_write_release
+ */
+static inline void metal_rwlock_write_acquire(struct metal_rwlock *rwlock)
+{
+	unsigned long spins = 0;
+	int v;
+
+	atomic_fetch_add(&rwlock->writers, 1);
+	while (1) {
+		v = 0;
+		if (atomic_compare_exchange_weak(&rwlock->v, &v, -1))
+			break;
+		metal_cpu_yield();
+		spins++;
+	}
+	metal_lock_stats_update(rwlock->stats, spins);
+}
+
+/**
+ * @brief	Release a reader-writer lock acquired for writing.
+ * @param[in]	rwlock	Reader-writer lock to release.
+ * @see metal_rwlock_write_acquire
+ */
+static inline void metal_rwlock_write_release(struct metal_rwlock *rwlock)
+{
+	atomic_store_explicit(&rwlock->v, 0, memory_order_release);
+	atomic_fetch_sub(&rwlock->writers, 1);
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __METAL_RWLOCK__H__ */
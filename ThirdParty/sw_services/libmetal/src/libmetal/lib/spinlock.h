@@ -45,7 +45,9 @@ static inline void metal_spinlock_init(struct metal_spinlock *slock)
 static inline void metal_spinlock_acquire(struct metal_spinlock *slock)
 {
 	while (atomic_flag_test_and_set(&slock->v)) {
-		metal_cpu_yield();
+		/* Spin on a read, keeping the line shared until released */
+		while (atomic_load_explicit(&slock->v, memory_order_relaxed))
+			metal_cpu_yield();
 	}
 }
 
@@ -59,6 +61,197 @@ static inline void metal_spinlock_release(struct metal_spinlock *slock)
 	atomic_flag_clear(&slock->v);
 }
 
+/**
+ * Lock contention counters. Attach them to a ticket, MCS or reader-writer
+ * lock to have its acquisitions counted, along with the number of spins
+ * waited, in total and at worst.
+ */
+struct metal_lock_stats {
+	atomic_ulong acquires;	/**< acquisitions */
+	atomic_ulong contended;	/**< acquisitions that had to wait */
+	atomic_ulong spins;	/**< spins waited, in total */
+	atomic_ulong max_spins;	/**< longest wait, in spins */
+};
+
+/**
+ * @brief	Reset lock contention counters.
+ * @param[in]	stats	Counters to reset.
+ */
+static inline void metal_lock_stats_init(struct metal_lock_stats *stats)
+{
+	atomic_store(&stats->acquires, 0);
+	atomic_store(&stats->contended, 0);
+	atomic_store(&stats->spins, 0);
+	atomic_store(&stats->max_spins, 0);
+}
+
+/**
+ * @brief	Record a lock acquisition in contention counters.
+ * @param[in]	stats	Counters to update, NULL for none.
+ * @param[in]	spins	Number of spins waited for the lock.
+ */
+static inline void metal_lock_stats_update(struct metal_lock_stats *stats,
+					   unsigned long spins)
+{
+	unsigned long max;
+
+	if (!stats)
+		return;
+	atomic_fetch_add(&stats->acquires, 1);
+	if (!spins)
+		return;
+	atomic_fetch_add(&stats->contended, 1);
+	atomic_fetch_add(&stats->spins, spins);
+	max = atomic_load(&stats->max_spins);
+	while (spins > max &&
+	       !atomic_compare_exchange_weak(&stats->max_spins, &max, spins))
+		;
+}
+
+/**
+ * Ticket spinlock: waiters take the lock in the order they asked for it,
+ * each spinning on a read of the ticket being served.
+ */
+struct metal_ticket_lock {
+	atomic_uint next;		/**< next ticket to hand out */
+	atomic_uint owner;		/**< ticket holding the lock */
+	struct metal_lock_stats *stats;	/**< contention counters, or NULL */
+};
+
+/** Static metal ticket lock initialization. */
+#define METAL_TICKET_LOCK_INIT	{ATOMIC_VAR_INIT(0), ATOMIC_VAR_INIT(0), NULL}
+
+/**
+ * @brief	Initialize a libmetal ticket lock.
+ * @param[in]	tlock	Ticket lock to initialize.
+ * @param[in]	stats	Contention counters, or NULL.
+ */
+static inline void metal_ticket_lock_init(struct metal_ticket_lock *tlock,
+					  struct metal_lock_stats *stats)
+{
+	atomic_store(&tlock->next, 0);
+	atomic_store(&tlock->owner, 0);
+	tlock->stats = stats;
+}
+
+/**
+ * @brief	Acquire a ticket lock.
+ * @param[in]	tlock	Ticket lock to acquire.
+ * @see metal_ticket_lock_release
+ */
+static inline void metal_ticket_lock_acquire(struct metal_ticket_lock *tlock)
+{
+	unsigned int ticket = atomic_fetch_add(&tlock->next, 1);
+	unsigned long spins = 0;
+
+	while (atomic_load_explicit(&tlock->owner, memory_order_acquire) !=
+	       ticket) {
+		metal_cpu_yield();
+		spins++;
+	}
+	metal_lock_stats_update(tlock->stats, spins);
+}
+
+/**
+ * @brief	Release a previously acquired ticket lock.
+ * @param[in]	tlock	Ticket lock to release.
+ * @see metal_ticket_lock_acquire
+ */
+static inline void metal_ticket_lock_release(struct metal_ticket_lock *tlock)
+{
+	unsigned int owner;
+
+	/* Only the holder writes owner */
+	owner = atomic_load_explicit(&tlock->owner, memory_order_relaxed);
+	atomic_store_explicit(&tlock->owner, owner + 1, memory_order_release);
+}
+
+/**
+ * Queue node of an MCS lock, provided by each acquirer and kept until the
+ * lock is released. Each waiter spins on its own node.
+ */
+struct metal_mcs_node {
+	atomic_ulong next;	/**< next waiter, as an address */
+	atomic_int locked;	/**< set while waiting */
+};
+
+/**
+ * MCS queue spinlock: waiters take the lock in order, each spinning on its
+ * own node rather than on a line shared by all, which suits locks
+ * contended by many cores.
+ */
+struct metal_mcs_lock {
+	atomic_ulong tail;		/**< last waiter node, as an address */
+	struct metal_lock_stats *stats;	/**< contention counters, or NULL */
+};
+
+/** Static metal MCS lock initialization. */
+#define METAL_MCS_LOCK_INIT	{ATOMIC_VAR_INIT(0), NULL}
+
+/**
+ * @brief	Initialize a libmetal MCS lock.
+ * @param[in]	mlock	MCS lock to initialize.
+ * @param[in]	stats	Contention counters, or NULL.
+ */
+static inline void metal_mcs_lock_init(struct metal_mcs_lock *mlock,
+				       struct metal_lock_stats *stats)
+{
+	atomic_store(&mlock->tail, 0);
+	mlock->stats = stats;
+}
+
+/**
+ * @brief	Acquire an MCS lock.
+ * @param[in]	mlock	MCS lock to acquire.
+ * @param[in]	node	Queue node of the caller, kept until released.
+ * @see metal_mcs_lock_release
+ */
+static inline void metal_mcs_lock_acquire(struct metal_mcs_lock *mlock,
+					  struct metal_mcs_node *node)
+{
+	struct metal_mcs_node *prev;
+	unsigned long spins = 0;
+
+	atomic_store_explicit(&node->next, 0, memory_order_relaxed);
+	atomic_store_explicit(&node->locked, 1, memory_order_relaxed);
+	prev = (struct metal_mcs_node *)atomic_exchange(&mlock->tail,
+							(unsigned long)node);
+	if (prev) {
+		atomic_store_explicit(&prev->next, (unsigned long)node,
+				      memory_order_release);
+		while (atomic_load_explicit(&node->locked,
+					    memory_order_acquire)) {
+			metal_cpu_yield();
+			spins++;
+		}
+	}
+	metal_lock_stats_update(mlock->stats, spins);
+}
+
+/**
+ * @brief	Release a previously acquired MCS lock.
+ * @param[in]	mlock	MCS lock to release.
+ * @param[in]	node	Queue node given to metal_mcs_lock_acquire().
+ * @see metal_mcs_lock_acquire
+ */
+static inline void metal_mcs_lock_release(struct metal_mcs_lock *mlock,
+					  struct metal_mcs_node *node)
+{
+	unsigned long next, self = (unsigned long)node;
+
+	next = atomic_load_explicit(&node->next, memory_order_acquire);
+	if (!next) {
+		/* No waiter known: the lock is free unless one is queuing */
+		if (atomic_compare_exchange_strong(&mlock->tail, &self, 0))
+			return;
+		while (!(next = atomic_load_explicit(&node->next,
+						     memory_order_acquire)))
+			metal_cpu_yield();
+	}
+	atomic_store_explicit(&((struct metal_mcs_node *)next)->locked, 0,
+			      memory_order_release);
+}
+
 /** @} */
 
 #ifdef __cplusplus
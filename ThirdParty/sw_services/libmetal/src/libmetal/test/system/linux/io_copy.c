@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Checks metal_io_block_read/write against memcpy for every combination of
+ * source and destination alignment, on regions of device and of normal
+ * memory, then logs the throughput of each combination.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "metal-test.h"
+#include <metal/alloc.h>
+#include <metal/io.h>
+#include <metal/log.h>
+#include <metal/sys.h>
+#include <metal/time.h>
+
+#define IO_COPY_ALIGN	8
+#define IO_COPY_SIZE	4096
+#define IO_COPY_BUF	(IO_COPY_SIZE + 2 * IO_COPY_ALIGN)
+#define IO_COPY_LOOPS	2000
+#define IO_COPY_GUARD	0xa5
+
+static const int io_copy_lens[] = {
+	0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 200, 1000,
+};
+
+static void io_copy_pattern(unsigned char *buf, size_t len, unsigned int seed)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = (unsigned char)(seed + i * 7);
+}
+
+static int io_copy_check(struct metal_io_region *io, unsigned char *shm,
+			 unsigned char *buf, const char *name)
+{
+	unsigned char expect[IO_COPY_BUF];
+	unsigned int so, doff, i;
+	int len, ret;
+
+	for (so = 0; so < IO_COPY_ALIGN; so++) {
+		for (doff = 0; doff < IO_COPY_ALIGN; doff++) {
+			for (i = 0; i < sizeof(io_copy_lens) /
+				    sizeof(io_copy_lens[0]); i++) {
+				len = io_copy_lens[i];
+
+				/* read: region at so into buffer at doff */
+				io_copy_pattern(shm, IO_COPY_BUF, so + len);
+				memset(buf, IO_COPY_GUARD, IO_COPY_BUF);
+				memset(expect, IO_COPY_GUARD, IO_COPY_BUF);
+				memcpy(expect + doff, shm + so, len);
+				ret = metal_io_block_read(io, so, buf + doff,
+							  len);
+				if (ret != len ||
+				    memcmp(buf, expect, IO_COPY_BUF)) {
+					metal_log(METAL_LOG_DEBUG,
+						  "%s read %u->%u len %d failed\n",
+						  name, so, doff, len);
+					return -EINVAL;
+				}
+
+				/* write: buffer at so into region at doff */
+				io_copy_pattern(buf, IO_COPY_BUF, doff + len);
+				memset(shm, IO_COPY_GUARD, IO_COPY_BUF);
+				memset(expect, IO_COPY_GUARD, IO_COPY_BUF);
+				memcpy(expect + doff, buf + so, len);
+				ret = metal_io_block_write(io, doff, buf + so,
+							   len);
+				if (ret != len ||
+				    memcmp(shm, expect, IO_COPY_BUF)) {
+					metal_log(METAL_LOG_DEBUG,
+						  "%s write %u->%u len %d failed\n",
+						  name, so, doff, len);
+					return -EINVAL;
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+static unsigned long long io_copy_rate(struct metal_io_region *io,
+				       unsigned char *buf, unsigned int so,
+				       unsigned int doff)
+{
+	unsigned long long t0, ns;
+	unsigned int i;
+
+	t0 = metal_get_timestamp();
+	for (i = 0; i < IO_COPY_LOOPS; i++)
+		metal_io_block_write(io, doff, buf + so, IO_COPY_SIZE);
+	ns = metal_get_timestamp() - t0;
+	if (!ns)
+		ns = 1;
+
+	/* MiB/s */
+	return (unsigned long long)IO_COPY_LOOPS * IO_COPY_SIZE *
+	       1000000000ULL / ns / (1024 * 1024);
+}
+
+static int io_copy(void)
+{
+	struct metal_io_region dev_io, norm_io;
+	metal_phys_addr_t phys = 0;
+	unsigned char *shm, *buf;
+	unsigned long long dev_rate, norm_rate;
+	unsigned int so, doff;
+	int error;
+
+	shm = metal_allocate_memory(IO_COPY_BUF);
+	buf = metal_allocate_memory(IO_COPY_BUF);
+	if (!shm || !buf) {
+		metal_log(METAL_LOG_DEBUG, "failed to allocate memory\n");
+		error = -ENOMEM;
+		goto out;
+	}
+	metal_io_init(&dev_io, shm, &phys, IO_COPY_BUF, -1, 0, NULL);
+	metal_io_init(&norm_io, shm, &phys, IO_COPY_BUF, -1,
+		      METAL_IO_MEM_NORMAL, NULL);
+
+	error = io_copy_check(&dev_io, shm, buf, "device");
+	if (!error)
+		error = io_copy_check(&norm_io, shm, buf, "normal");
+	if (error)
+		goto out_io;
+
+	for (so = 0; so < IO_COPY_ALIGN; so++) {
+		for (doff = 0; doff < IO_COPY_ALIGN; doff++) {
+			dev_rate = io_copy_rate(&dev_io, buf, so, doff);
+			norm_rate = io_copy_rate(&norm_io, buf, so, doff);
+			metal_log(METAL_LOG_INFO,
+				  "src +%u dst +%u: device %llu MiB/s, normal %llu MiB/s\n",
+				  so, doff, dev_rate, norm_rate);
+		}
+	}
+
+out_io:
+	metal_io_finish(&norm_io);
+	metal_io_finish(&dev_io);
+out:
+	if (buf)
+		metal_free_memory(buf);
+	if (shm)
+		metal_free_memory(shm);
+	return error;
+}
+METAL_ADD_TEST(io_copy);
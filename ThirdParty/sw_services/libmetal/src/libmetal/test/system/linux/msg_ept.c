@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2026, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * rpmsg endpoint lookup on the RX path, over an rpmsg-loop master and
+ * remote in one process.
+ * - ept_scaling logs the cost per message with 1 to 1024 endpoints on
+ *   the remote side, sending to the most recently created ones.
+ * - ept_churn dispatches messages to a few endpoints while other
+ *   threads keep creating and destroying endpoints that hash to the same
+ *   buckets. Destroyed endpoints are poisoned before they are created
+ *   again, so a lookup still walking through one would crash or misroute.
+ *   As that race is hard to hit on few cores, it first checks that
+ *   rpmsg_destroy_ept() waits for a lookup in progress.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "metal-test.h"
+#include "rpmsg-loop.h"
+#include <metal/atomic.h>
+#include <metal/log.h>
+#include <metal/sleep.h>
+#include <metal/sys.h>
+#include <metal/time.h>
+
+#define EPT_MASTER_ADDR		0x10
+#define EPT_BASE_ADDR		0x40
+#define EPT_MAX			1024
+#define EPT_RECENT		8
+#define EPT_SCALING_MSGS	100000
+#define EPT_LEN			64
+
+#define EPT_STABLE		4
+#define EPT_CHURN_THREADS	2
+#define EPT_CHURN_PER_THREAD	8
+#define EPT_CHURN_ROUNDS	20000
+
+struct ept_rx {
+	struct rpmsg_endpoint ept;
+	unsigned long count;
+};
+
+static int ept_rx_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
+		     uint32_t src, void *priv)
+{
+	struct ept_rx *rx = priv;
+
+	(void)data;
+	(void)len;
+	(void)src;
+
+	/* the priv field of a poisoned endpoint does not point back to it */
+	if (&rx->ept != ept)
+		metal_log(METAL_LOG_ERROR, "message to %p dispatched to %p\n",
+			  (void *)&rx->ept, (void *)ept);
+	else
+		rx->count++;
+
+	return RPMSG_SUCCESS;
+}
+
+static int ept_loop_start(struct rpmsg_loop *loop, struct rpmsg_endpoint *mept,
+			  struct rpmsg_device **rdev)
+{
+	struct rpmsg_device *mdev;
+	int error;
+
+	error = rpmsg_loop_init(loop, 0);
+	if (error)
+		return error;
+	mdev = rpmsg_loop_start(loop, RPMSG_MASTER);
+	*rdev = mdev ? rpmsg_loop_start(loop, RPMSG_REMOTE) : NULL;
+	if (!*rdev) {
+		rpmsg_loop_finish(loop);
+		return -ENODEV;
+	}
+	/* the master only sends, with rpmsg_sendto */
+	error = rpmsg_create_ept(mept, mdev, "ept", EPT_MASTER_ADDR,
+				 RPMSG_ADDR_ANY, ept_rx_cb, NULL);
+	if (error) {
+		rpmsg_loop_finish(loop);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int ept_create(struct ept_rx *rx, struct rpmsg_device *rdev,
+		      uint32_t addr)
+{
+	memset(rx, 0, sizeof(*rx));
+	if (rpmsg_create_ept(&rx->ept, rdev, "ept", addr, EPT_MASTER_ADDR,
+			     ept_rx_cb, NULL))
+		return -EINVAL;
+	rx->ept.priv = rx;
+
+	return 0;
+}
+
+static int ept_scaling(void)
+{
+	static const unsigned int counts[] = { 1, 8, 32, 128, 512, EPT_MAX };
+	static struct ept_rx rxs[EPT_MAX];
+	uint8_t data[EPT_LEN] = { 0 };
+	struct rpmsg_endpoint mept;
+	struct rpmsg_device *rdev;
+	struct rpmsg_loop loop;
+	unsigned long long t0, t1;
+	unsigned int c, created = 0, i, dst;
+	int error;
+
+	error = ept_loop_start(&loop, &mept, &rdev);
+	if (error)
+		return error;
+
+	for (c = 0; !error && c < sizeof(counts) / sizeof(counts[0]); c++) {
+		while (!error && created < counts[c]) {
+			error = ept_create(&rxs[created], rdev,
+					   EPT_BASE_ADDR + created);
+			if (!error)
+				created++;
+		}
+		if (error)
+			break;
+
+		t0 = metal_get_timestamp();
+		for (i = 0; i < EPT_SCALING_MSGS; i++) {
+			dst = created - 1 - i % EPT_RECENT % created;
+			if (rpmsg_sendto(&mept, data, EPT_LEN,
+					 EPT_BASE_ADDR + dst) != EPT_LEN) {
+				error = -EIO;
+				break;
+			}
+			rpmsg_loop_run(&loop);
+		}
+		t1 = metal_get_timestamp();
+
+		metal_log(METAL_LOG_INFO, "%4u endpoints: %llu ns/msg\n",
+			  created, (t1 - t0) / EPT_SCALING_MSGS);
+	}
+
+	for (i = 0; !error && i < created; i++) {
+		if (i >= created - EPT_RECENT && !rxs[i].count)
+			error = -EINVAL;
+	}
+	for (i = 0; i < created; i++)
+		rpmsg_destroy_ept(&rxs[i].ept);
+	rpmsg_destroy_ept(&mept);
+	rpmsg_loop_finish(&loop);
+
+	return error;
+}
+METAL_ADD_TEST(ept_scaling);
+
+struct ept_churn {
+	struct rpmsg_device *rdev;
+	struct ept_rx drain;
+	atomic_int drained;
+	atomic_int next_thread;
+	atomic_int running;
+	atomic_int error;
+	struct ept_rx rxs[EPT_CHURN_THREADS][EPT_CHURN_PER_THREAD];
+};
+
+/* same hash buckets as the stable endpoints */
+static inline uint32_t ept_churn_addr(unsigned int thread, unsigned int i)
+{
+	return EPT_BASE_ADDR + (i % EPT_STABLE) +
+	       RPMSG_EPT_HASH_SIZE * (1 + thread * EPT_CHURN_PER_THREAD + i);
+}
+
+static void *ept_churn_thread(void *arg)
+{
+	struct ept_churn *churn = arg;
+	unsigned int thread, round, i;
+	struct ept_rx *rx;
+
+	thread = atomic_fetch_add(&churn->next_thread, 1);
+	for (round = 0; round < EPT_CHURN_ROUNDS; round++) {
+		i = round % EPT_CHURN_PER_THREAD;
+		rx = &churn->rxs[thread][i];
+		if (round >= EPT_CHURN_PER_THREAD) {
+			rpmsg_destroy_ept(&rx->ept);
+			memset(rx, 0xa5, sizeof(*rx));
+		}
+		if (ept_create(rx, churn->rdev, ept_churn_addr(thread, i))) {
+			/* the others are destroyed with the device */
+			atomic_store(&churn->error, -EINVAL);
+			atomic_fetch_sub(&churn->running, 1);
+			return NULL;
+		}
+	}
+	for (i = 0; i < EPT_CHURN_PER_THREAD; i++)
+		rpmsg_destroy_ept(&churn->rxs[thread][i].ept);
+	atomic_fetch_sub(&churn->running, 1);
+
+	return NULL;
+}
+
+static void *ept_drain_thread(void *arg)
+{
+	struct ept_churn *churn = arg;
+
+	rpmsg_destroy_ept(&churn->drain.ept);
+	atomic_store(&churn->drained, 1);
+
+	return NULL;
+}
+
+/* an endpoint is unregistered only once the lookups in progress are done */
+static int ept_check_drain(struct ept_churn *churn)
+{
+	pthread_t tid;
+	int error, ts_created, drained;
+
+	error = ept_create(&churn->drain, churn->rdev,
+			   ept_churn_addr(0, 0));
+	if (error)
+		return error;
+
+	/* stand for the RX path, between its lookup and the end of it */
+	atomic_fetch_add(&churn->rdev->rx_lookups, 1);
+	atomic_init(&churn->drained, 0);
+	error = metal_run_noblock(1, ept_drain_thread, churn, &tid,
+				  &ts_created);
+	if (!error)
+		metal_sleep_usec(20000);
+	drained = atomic_load(&churn->drained);
+	atomic_fetch_sub(&churn->rdev->rx_lookups, 1);
+	metal_finish_threads(ts_created, &tid);
+
+	if (!error && (drained || !atomic_load(&churn->drained))) {
+		metal_log(METAL_LOG_ERROR,
+			  "endpoint destroyed during a lookup\n");
+		error = -EINVAL;
+	}
+
+	return error;
+}
+
+static int ept_churn(void)
+{
+	static struct ept_churn churn;
+	pthread_t tids[EPT_CHURN_THREADS];
+	struct ept_rx stable[EPT_STABLE];
+	uint8_t data[EPT_LEN] = { 0 };
+	struct rpmsg_endpoint mept;
+	struct rpmsg_loop loop;
+	unsigned long sent[EPT_STABLE] = { 0 };
+	unsigned long n = 0;
+	unsigned int i, nstable;
+	int error, ts_created;
+
+	error = ept_loop_start(&loop, &mept, &churn.rdev);
+	if (error)
+		return error;
+	for (nstable = 0; !error && nstable < EPT_STABLE; nstable++)
+		error = ept_create(&stable[nstable], churn.rdev,
+				   EPT_BASE_ADDR + nstable);
+	if (error) {
+		nstable--;
+		goto out;
+	}
+	error = ept_check_drain(&churn);
+	if (error)
+		goto out;
+
+	atomic_init(&churn.next_thread, 0);
+	atomic_init(&churn.running, EPT_CHURN_THREADS);
+	atomic_init(&churn.error, 0);
+	error = metal_run_noblock(EPT_CHURN_THREADS, ept_churn_thread, &churn,
+				  tids, &ts_created);
+	if (error) {
+		metal_finish_threads(ts_created, tids);
+		goto out;
+	}
+
+	/* RX dispatch races with the endpoint updates of the threads */
+	while (atomic_load(&churn.running)) {
+		i = n++ % EPT_STABLE;
+		if (rpmsg_sendto(&mept, data, EPT_LEN, EPT_BASE_ADDR + i) !=
+		    EPT_LEN) {
+			error = -EIO;
+			break;
+		}
+		sent[i]++;
+		rpmsg_loop_run(&loop);
+	}
+	metal_finish_threads(ts_created, tids);
+
+	if (!error)
+		error = atomic_load(&churn.error);
+	for (i = 0; !error && i < EPT_STABLE; i++) {
+		if (stable[i].count != sent[i]) {
+			metal_log(METAL_LOG_ERROR,
+				  "endpoint %u got %lu of %lu messages\n",
+				  i, stable[i].count, sent[i]);
+			error = -EINVAL;
+		}
+	}
+	metal_log(METAL_LOG_INFO, "%lu messages during %u endpoint updates\n",
+		  n, 2 * EPT_CHURN_THREADS * EPT_CHURN_ROUNDS);
+
+out:
+	for (i = 0; i < nstable; i++)
+		rpmsg_destroy_ept(&stable[i].ept);
+	rpmsg_destroy_ept(&mept);
+	rpmsg_loop_finish(&loop);
+
+	return error;
+}
+METAL_ADD_TEST(ept_churn);
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2026, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Loopback of rpmsg messages between an rpmsg_virtio master and remote
+ * sharing one I/O region, through the copy path (rpmsg_send, payload read
+ * out of the RX buffer in the endpoint callback) and the zero-copy path
+ * (rpmsg_get_tx_payload_buffer and rpmsg_send_nocopy, RX buffer held with
+ * rpmsg_hold_rx_buffer, consumed in place and handed back with
+ * rpmsg_release_rx_buffer). The zero-copy API is checked first, including
+ * TX buffers given back unsent with rpmsg_release_tx_buffer on both sides,
+ * then messages/s and bytes/s are logged for both paths.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "metal-test.h"
+#include "rpmsg-loop.h"
+#include <metal/io.h>
+#include <metal/log.h>
+#include <metal/sys.h>
+#include <metal/time.h>
+
+#define MSG_MASTER_ADDR	0x10
+#define MSG_REMOTE_ADDR	0x20
+#define MSG_COUNT	200000
+/* payload after the 16 byte rpmsg header */
+#define MSG_PAYLOAD_MAX	(RPMSG_BUFFER_SIZE - 16)
+
+struct msg_rx {
+	struct metal_io_region *io;
+	int hold;
+	/* buffers held by the callback, not yet released */
+	void *held[RPMSG_LOOP_VRING_NUM];
+	size_t held_len[RPMSG_LOOP_VRING_NUM];
+	unsigned int nheld;
+	unsigned int count;
+	uint32_t sum;
+};
+
+static void msg_fill(uint8_t *data, size_t len, unsigned int seq)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		data[i] = (uint8_t)(seq + i);
+}
+
+static uint32_t msg_consume(const uint8_t *data, size_t len)
+{
+	uint32_t sum = 0;
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		sum += data[i];
+	return sum;
+}
+
+static int msg_rx_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
+		     uint32_t src, void *priv)
+{
+	uint8_t rxdata[MSG_PAYLOAD_MAX];
+	struct msg_rx *rx = priv;
+
+	(void)src;
+
+	rx->count++;
+	if (rx->hold) {
+		/* consumed once the callback has returned */
+		rpmsg_hold_rx_buffer(ept, data);
+		rx->held[rx->nheld] = data;
+		rx->held_len[rx->nheld] = len;
+		rx->nheld++;
+	} else {
+		metal_io_block_read(rx->io, metal_io_virt_to_offset(rx->io, data),
+				    rxdata, len);
+		rx->sum += msg_consume(rxdata, len);
+	}
+
+	return RPMSG_SUCCESS;
+}
+
+static void msg_rx_release(struct rpmsg_endpoint *ept, struct msg_rx *rx)
+{
+	unsigned int i;
+
+	for (i = 0; i < rx->nheld; i++) {
+		rx->sum += msg_consume(rx->held[i], rx->held_len[i]);
+		rpmsg_release_rx_buffer(ept, rx->held[i]);
+	}
+	rx->nheld = 0;
+}
+
+static int msg_send_nocopy(struct rpmsg_endpoint *ept, size_t len,
+			   unsigned int seq, int wait)
+{
+	uint32_t size;
+	void *buf;
+
+	buf = rpmsg_get_tx_payload_buffer(ept, &size, wait);
+	if (!buf)
+		return RPMSG_ERR_NO_BUFF;
+	if (size < len)
+		return RPMSG_ERR_BUFF_SIZE;
+	msg_fill(buf, len, seq);
+	return rpmsg_send_nocopy(ept, buf, len);
+}
+
+/* zero-copy API: buffer sizes, held buffers throttling the sender */
+static int msg_check_nocopy(struct rpmsg_loop *loop,
+			    struct rpmsg_endpoint *mept,
+			    struct rpmsg_endpoint *rept, struct msg_rx *rx)
+{
+	uint8_t expect[MSG_PAYLOAD_MAX];
+	unsigned int i, sent;
+	uint32_t size;
+	void *buf;
+	int ret;
+
+	buf = rpmsg_get_tx_payload_buffer(mept, &size, 0);
+	if (!buf || size != MSG_PAYLOAD_MAX) {
+		metal_log(METAL_LOG_ERROR, "bad TX payload buffer, size %u\n",
+			  (unsigned int)size);
+		return -EINVAL;
+	}
+	ret = rpmsg_send_nocopy(mept, buf, size + 1);
+	if (ret != RPMSG_ERR_BUFF_SIZE) {
+		metal_log(METAL_LOG_ERROR, "oversized send returned %d\n", ret);
+		return -EINVAL;
+	}
+	/* the buffer stays reserved after the error, send it for real */
+	msg_fill(buf, size, 0);
+	ret = rpmsg_send_nocopy(mept, buf, size);
+	if (ret != (int)size)
+		return -EINVAL;
+
+	/* the remote holds every RX buffer, so the master runs dry */
+	rx->hold = 1;
+	rpmsg_loop_run(loop);
+	for (sent = 1; sent < 2 * RPMSG_LOOP_VRING_NUM; sent++) {
+		ret = msg_send_nocopy(mept, 64, sent, 0);
+		if (ret < 0)
+			break;
+		rpmsg_loop_run(loop);
+	}
+	if (ret != RPMSG_ERR_NO_BUFF || sent != RPMSG_LOOP_VRING_NUM ||
+	    rx->nheld != RPMSG_LOOP_VRING_NUM) {
+		metal_log(METAL_LOG_ERROR,
+			  "%u sent, %u held before running dry (%d)\n",
+			  sent, rx->nheld, ret);
+		return -EINVAL;
+	}
+
+	/* payloads were written in place and are read in place */
+	msg_fill(expect, MSG_PAYLOAD_MAX, 0);
+	if (rx->held_len[0] != MSG_PAYLOAD_MAX ||
+	    memcmp(rx->held[0], expect, MSG_PAYLOAD_MAX))
+		return -EINVAL;
+	for (i = 1; i < rx->nheld; i++) {
+		msg_fill(expect, 64, i);
+		if (rx->held_len[i] != 64 ||
+		    memcmp(rx->held[i], expect, 64)) {
+			metal_log(METAL_LOG_ERROR, "payload %u corrupted\n", i);
+			return -EINVAL;
+		}
+	}
+
+	/* releasing them lets the master send again */
+	msg_rx_release(rept, rx);
+	rpmsg_loop_run(loop);
+	rx->hold = 0;
+	ret = msg_send_nocopy(mept, 64, 0, 0);
+	if (ret != 64) {
+		metal_log(METAL_LOG_ERROR, "send after release returned %d\n",
+			  ret);
+		return -EINVAL;
+	}
+	rpmsg_loop_run(loop);
+
+	return 0;
+}
+
+/* TX buffers given back unsent are reused, and none is lost */
+static int msg_check_release(struct rpmsg_endpoint *ept)
+{
+	void *bufs[2 * RPMSG_LOOP_VRING_NUM];
+	unsigned int i, n;
+	uint32_t size;
+	void *buf;
+
+	/* take every TX buffer of the side */
+	for (n = 0; n < 2 * RPMSG_LOOP_VRING_NUM; n++) {
+		bufs[n] = rpmsg_get_tx_payload_buffer(ept, &size, 0);
+		if (!bufs[n])
+			break;
+	}
+	if (!n || n == 2 * RPMSG_LOOP_VRING_NUM) {
+		metal_log(METAL_LOG_ERROR, "%u TX buffers available\n", n);
+		return -EINVAL;
+	}
+
+	/* with none left, the one given back is the next one taken */
+	rpmsg_release_tx_buffer(ept, bufs[n - 1]);
+	buf = rpmsg_get_tx_payload_buffer(ept, &size, 0);
+	if (buf != bufs[n - 1] || size != MSG_PAYLOAD_MAX) {
+		metal_log(METAL_LOG_ERROR, "released TX buffer not reused\n");
+		return -EINVAL;
+	}
+
+	/* all of them can be taken again once given back, and no more */
+	for (i = 0; i < n; i++)
+		rpmsg_release_tx_buffer(ept, bufs[i]);
+	for (i = 0; i < n; i++) {
+		bufs[i] = rpmsg_get_tx_payload_buffer(ept, &size, 0);
+		if (!bufs[i]) {
+			metal_log(METAL_LOG_ERROR,
+				  "%u of %u released TX buffers reused\n",
+				  i, n);
+			return -EINVAL;
+		}
+	}
+	buf = rpmsg_get_tx_payload_buffer(ept, &size, 0);
+	for (i = 0; i < n; i++)
+		rpmsg_release_tx_buffer(ept, bufs[i]);
+	if (buf) {
+		metal_log(METAL_LOG_ERROR, "TX buffer created on release\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void msg_report(const char *path, size_t len, unsigned long long ns)
+{
+	unsigned long long msgs, bytes;
+
+	if (!ns)
+		ns = 1;
+	msgs = (unsigned long long)MSG_COUNT * 1000000000ULL / ns;
+	bytes = msgs * len;
+	metal_log(METAL_LOG_INFO, "%-7s %3lu bytes: %llu msgs/s, %llu KiB/s\n",
+		  path, (unsigned long)len, msgs, bytes / 1024);
+}
+
+static int msg_bench(struct rpmsg_loop *loop, struct rpmsg_endpoint *mept,
+		     struct rpmsg_endpoint *rept, struct msg_rx *rx,
+		     size_t len, int nocopy)
+{
+	uint8_t txdata[MSG_PAYLOAD_MAX];
+	unsigned long long t0, t1;
+	uint32_t expect = 0;
+	unsigned int i;
+	int ret;
+
+	rx->hold = nocopy;
+	rx->count = 0;
+	rx->sum = 0;
+
+	t0 = metal_get_timestamp();
+	for (i = 0; i < MSG_COUNT; i++) {
+		if (nocopy) {
+			ret = msg_send_nocopy(mept, len, i, 1);
+		} else {
+			msg_fill(txdata, len, i);
+			ret = rpmsg_send(mept, txdata, len);
+		}
+		if (ret != (int)len) {
+			metal_log(METAL_LOG_ERROR, "send %u returned %d\n",
+				  i, ret);
+			return -EINVAL;
+		}
+		rpmsg_loop_run(loop);
+		msg_rx_release(rept, rx);
+	}
+	rpmsg_loop_run(loop);
+	t1 = metal_get_timestamp();
+
+	msg_report(nocopy ? "nocopy" : "copy", len, t1 - t0);
+
+	for (i = 0; i < MSG_COUNT; i++) {
+		msg_fill(txdata, len, i);
+		expect += msg_consume(txdata, len);
+	}
+	if (rx->count != MSG_COUNT || rx->sum != expect) {
+		metal_log(METAL_LOG_ERROR, "%u of %u received, sum %u != %u\n",
+			  rx->count, MSG_COUNT, rx->sum, expect);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int msg_loopback(void)
+{
+	static const size_t sizes[] = { 16, 128, MSG_PAYLOAD_MAX };
+	struct rpmsg_endpoint mept, rept;
+	struct rpmsg_device *mdev, *rdev;
+	struct rpmsg_loop loop;
+	struct msg_rx rx;
+	unsigned int i;
+	int error;
+
+	error = rpmsg_loop_init(&loop, 0);
+	if (error)
+		return error;
+	mdev = rpmsg_loop_start(&loop, RPMSG_MASTER);
+	rdev = mdev ? rpmsg_loop_start(&loop, RPMSG_REMOTE) : NULL;
+	if (!rdev) {
+		error = -ENODEV;
+		goto out;
+	}
+
+	memset(&rx, 0, sizeof(rx));
+	rx.io = &loop.io;
+	error = rpmsg_create_ept(&mept, mdev, "msg", MSG_MASTER_ADDR,
+				 MSG_REMOTE_ADDR, NULL, NULL);
+	error |= rpmsg_create_ept(&rept, rdev, "msg", MSG_REMOTE_ADDR,
+				  MSG_MASTER_ADDR, msg_rx_cb, NULL);
+	if (error) {
+		error = -EINVAL;
+		goto out;
+	}
+	rept.priv = &rx;
+
+	error = msg_check_nocopy(&loop, &mept, &rept, &rx);
+	if (!error)
+		error = msg_check_release(&mept);
+	if (!error)
+		error = msg_check_release(&rept);
+
+	for (i = 0; !error && i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		error = msg_bench(&loop, &mept, &rept, &rx, sizes[i], 0);
+		if (!error)
+			error = msg_bench(&loop, &mept, &rept, &rx, sizes[i], 1);
+	}
+
+	rpmsg_destroy_ept(&rept);
+	rpmsg_destroy_ept(&mept);
+out:
+	rpmsg_loop_finish(&loop);
+
+	return error;
+}
+METAL_ADD_TEST(msg_loopback);
@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2026, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * rpmsg_virtio master and remote run from the two processes of a fork and
+ * talk over a shared region, as two cores would. The master sends bursts
+ * of messages, one at a time or as a batch. The remote holds each burst,
+ * releases it in reverse order and acknowledges it. The test checks:
+ * - the index virtqueue_get_buffer() gives back is that of the descriptor
+ *   of the buffer, on the master TX reclaim path, where reverse releases
+ *   make it differ from the used ring slot;
+ * - buffers are returned with their full length, whatever the length of
+ *   the message they held, in both directions;
+ * - with VIRTIO_RING_F_EVENT_IDX, each consumer publishes its position
+ *   every time it gets a buffer, unless its callbacks are disabled, as for
+ *   the TX virtqueues.
+ * Notifications per message are logged for each mode, with the p50, p99
+ * and max round trip of a burst, from its first send to its
+ * acknowledgment, while the master sends the bursts back to back.
+ */
+
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "metal-test.h"
+#include "rpmsg-loop.h"
+#include <metal/io.h>
+#include <metal/log.h>
+#include <metal/sys.h>
+#include <metal/time.h>
+
+#define MSG_MASTER_ADDR	0x10
+#define MSG_REMOTE_ADDR	0x20
+#define MSG_BURST	8
+#define MSG_BURSTS	2000
+#define MSG_LEN		64
+/* payload after the 16 byte rpmsg header */
+#define MSG_PAYLOAD_MAX	(RPMSG_BUFFER_SIZE - 16)
+#define MSG_TIMEOUT_NS	10000000000ULL
+
+/* event index a virtqueue is left with by virtqueue_disable_cb() */
+#define MSG_EVENT_DISABLED	((uint16_t)(0 - RPMSG_LOOP_VRING_NUM - 1))
+
+struct msg_mode {
+	const char *name;
+	uint32_t features;
+	int batch;
+};
+
+struct msg_side {
+	struct rpmsg_loop *loop;
+	struct rpmsg_loop_node *node;
+	struct rpmsg_endpoint ept;
+	unsigned int count;
+	void *held[MSG_BURST];
+	size_t held_len[MSG_BURST];
+	int error;
+};
+
+static void msg_fill(uint8_t *data, size_t len, uint32_t seq)
+{
+	size_t i;
+
+	memcpy(data, &seq, sizeof(seq));
+	for (i = sizeof(seq); i < len; i++)
+		data[i] = (uint8_t)(seq + i);
+}
+
+static int msg_check(const uint8_t *data, size_t len, uint32_t seq)
+{
+	uint8_t expect[MSG_PAYLOAD_MAX];
+
+	msg_fill(expect, len, seq);
+	return memcmp(data, expect, len) ? -EINVAL : 0;
+}
+
+/* poll one side until *count reaches want */
+static int msg_wait(struct msg_side *side, unsigned int want)
+{
+	unsigned long long deadline;
+
+	deadline = metal_get_timestamp() + MSG_TIMEOUT_NS;
+	while (side->count < want && !side->error) {
+		if (rpmsg_loop_poll(side->node))
+			continue;
+		if (metal_get_timestamp() > deadline) {
+			metal_log(METAL_LOG_ERROR, "%s: timeout, %u of %u\n",
+				  side->node->vdev.role == RPMSG_MASTER ?
+				  "master" : "remote", side->count, want);
+			return -ETIMEDOUT;
+		}
+		sched_yield();
+	}
+
+	return side->error;
+}
+
+/* the consumer published its position on its last get */
+static int msg_check_event(struct msg_side *side, const struct msg_mode *mode)
+{
+	struct virtqueue *rvq = side->node->rvdev.rvq;
+	struct virtqueue *svq = side->node->rvdev.svq;
+	uint16_t rx_event, rx_pos, tx_event;
+
+	if (!(mode->features & VIRTIO_RING_F_EVENT_IDX))
+		return 0;
+
+	if (side->node->vdev.role == RPMSG_MASTER) {
+		rx_event = vring_used_event(&rvq->vq_ring);
+		rx_pos = rvq->vq_used_cons_idx;
+		tx_event = vring_used_event(&svq->vq_ring);
+	} else {
+		rx_event = vring_avail_event(&rvq->vq_ring);
+		rx_pos = rvq->vq_available_idx;
+		tx_event = vring_avail_event(&svq->vq_ring);
+	}
+	if (rx_event != rx_pos || tx_event != MSG_EVENT_DISABLED) {
+		metal_log(METAL_LOG_ERROR,
+			  "RX event %u at %u, TX event %u\n",
+			  rx_event, rx_pos, tx_event);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int msg_ack_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
+		      uint32_t src, void *priv)
+{
+	struct msg_side *side = priv;
+
+	(void)ept;
+	(void)src;
+
+	if (len != sizeof(uint32_t) || msg_check(data, len, side->count))
+		side->error = -EINVAL;
+	side->count++;
+
+	return RPMSG_SUCCESS;
+}
+
+static int msg_hold_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
+		       uint32_t src, void *priv)
+{
+	struct msg_side *side = priv;
+
+	(void)src;
+
+	if (side->count % MSG_BURST == 0 && side->held[0]) {
+		side->error = -EINVAL;
+		return RPMSG_SUCCESS;
+	}
+	rpmsg_hold_rx_buffer(ept, data);
+	side->held[side->count % MSG_BURST] = data;
+	side->held_len[side->count % MSG_BURST] = len;
+	side->count++;
+
+	return RPMSG_SUCCESS;
+}
+
+static int msg_send_ack(struct msg_side *side, uint32_t seq)
+{
+	uint32_t size;
+	void *buf;
+
+	buf = rpmsg_get_tx_payload_buffer(&side->ept, &size, 1);
+	if (!buf)
+		return -ENOMEM;
+	/* the master gave back the buffer with its full length */
+	if (size != MSG_PAYLOAD_MAX) {
+		metal_log(METAL_LOG_ERROR, "remote TX buffer of %u bytes\n",
+			  (unsigned int)size);
+		return -EINVAL;
+	}
+	msg_fill(buf, sizeof(seq), seq);
+	return rpmsg_send_nocopy(&side->ept, buf, sizeof(seq)) ==
+	       (int)sizeof(seq) ? 0 : -EIO;
+}
+
+static int msg_remote(struct rpmsg_loop *loop, const struct msg_mode *mode)
+{
+	struct rpmsg_device *rdev;
+	struct msg_side side;
+	unsigned int b, i, seq;
+	int error;
+
+	memset(&side, 0, sizeof(side));
+	side.loop = loop;
+	side.node = &loop->remote;
+	rdev = rpmsg_loop_start(loop, RPMSG_REMOTE);
+	if (!rdev)
+		return -ENODEV;
+	error = rpmsg_create_ept(&side.ept, rdev, "msg", MSG_REMOTE_ADDR,
+				 MSG_MASTER_ADDR, msg_hold_cb, NULL);
+	if (error)
+		return -EINVAL;
+	side.ept.priv = &side;
+
+	/* tell the master the endpoint is up */
+	error = msg_send_ack(&side, 0);
+
+	for (b = 0; !error && b < MSG_BURSTS; b++) {
+		error = msg_wait(&side, (b + 1) * MSG_BURST);
+		if (error)
+			break;
+		for (i = 0; i < MSG_BURST; i++) {
+			seq = b * MSG_BURST + i;
+			if (side.held_len[i] != MSG_LEN ||
+			    msg_check(side.held[i], MSG_LEN, seq)) {
+				metal_log(METAL_LOG_ERROR,
+					  "message %u corrupted\n", seq);
+				error = -EINVAL;
+			}
+		}
+		if (!error)
+			error = msg_check_event(&side, mode);
+
+		/* out of order, so used ring slots and descriptors differ */
+		for (i = MSG_BURST; i > 0; i--) {
+			rpmsg_release_rx_buffer(&side.ept, side.held[i - 1]);
+			side.held[i - 1] = NULL;
+		}
+		if (!error)
+			error = msg_send_ack(&side, b + 1);
+	}
+
+	rpmsg_destroy_ept(&side.ept);
+	return error;
+}
+
+static int msg_send_burst(struct msg_side *side, const struct msg_mode *mode,
+			  unsigned int b)
+{
+	uint8_t data[MSG_BURST][MSG_LEN];
+	struct rpmsg_msg msgs[MSG_BURST];
+	int i, sent, ret;
+
+	for (i = 0; i < MSG_BURST; i++) {
+		msg_fill(data[i], MSG_LEN, b * MSG_BURST + i);
+		msgs[i].data = data[i];
+		msgs[i].len = MSG_LEN;
+	}
+
+	for (sent = 0; sent < MSG_BURST; sent += ret) {
+		if (mode->batch)
+			ret = rpmsg_send_batch(&side->ept, &msgs[sent],
+					       MSG_BURST - sent);
+		else
+			ret = rpmsg_send(&side->ept, msgs[sent].data,
+					 MSG_LEN) == MSG_LEN ? 1 : -EIO;
+		if (ret <= 0) {
+			metal_log(METAL_LOG_ERROR, "send returned %d\n", ret);
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+/* drain the TX buffers the remote released but the master did not reuse */
+static int msg_check_tx_reclaim(struct msg_side *side)
+{
+	struct metal_io_region *io = &side->loop->io;
+	struct virtqueue *svq = side->node->rvdev.svq;
+	unsigned int n = 0;
+	uint32_t len;
+	uint16_t idx;
+	void *buf;
+
+	while ((buf = virtqueue_get_buffer(svq, &len, &idx)) != NULL) {
+		if (idx >= svq->vq_nentries ||
+		    svq->vq_ring.desc[idx].addr != metal_io_virt_to_phys(io, buf) ||
+		    len != RPMSG_BUFFER_SIZE) {
+			metal_log(METAL_LOG_ERROR,
+				  "TX buffer %p back as descriptor %u of %u bytes\n",
+				  buf, idx, (unsigned int)len);
+			return -EINVAL;
+		}
+		n++;
+	}
+	if (n != MSG_BURST) {
+		metal_log(METAL_LOG_ERROR, "%u TX buffers reclaimed\n", n);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int msg_cmp_ns(const void *a, const void *b)
+{
+	unsigned long long x = *(const unsigned long long *)a;
+	unsigned long long y = *(const unsigned long long *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+/* percentiles of the burst round trips, sorted in place */
+static void msg_report_rtt(const struct msg_mode *mode,
+			   unsigned long long *rtt, unsigned int n)
+{
+	if (!n)
+		return;
+	qsort(rtt, n, sizeof(*rtt), msg_cmp_ns);
+	metal_log(METAL_LOG_INFO,
+		  "%-16s round trip p50 %llu ns, p99 %llu ns, max %llu ns\n",
+		  mode->name, rtt[n / 2], rtt[n * 99 / 100], rtt[n - 1]);
+}
+
+static int msg_master(struct rpmsg_loop *loop, const struct msg_mode *mode)
+{
+	static unsigned long long rtt[MSG_BURSTS];
+	unsigned long long t0;
+	struct rpmsg_device *rdev;
+	struct msg_side side;
+	unsigned int b;
+	int error;
+
+	memset(&side, 0, sizeof(side));
+	side.loop = loop;
+	side.node = &loop->master;
+	rdev = rpmsg_loop_start(loop, RPMSG_MASTER);
+	if (!rdev)
+		return -ENODEV;
+	error = rpmsg_create_ept(&side.ept, rdev, "msg", MSG_MASTER_ADDR,
+				 MSG_REMOTE_ADDR, msg_ack_cb, NULL);
+	if (error)
+		return -EINVAL;
+	side.ept.priv = &side;
+
+	error = msg_wait(&side, 1);
+	for (b = 0; !error && b < MSG_BURSTS; b++) {
+		t0 = metal_get_timestamp();
+		error = msg_send_burst(&side, mode, b);
+		if (!error)
+			error = msg_wait(&side, b + 2);
+		rtt[b] = metal_get_timestamp() - t0;
+		if (!error)
+			error = msg_check_event(&side, mode);
+	}
+	if (!error)
+		error = msg_check_tx_reclaim(&side);
+
+	metal_log(METAL_LOG_INFO,
+		  "%-16s %.3f kicks/msg, %lu RX buffer return kicks\n",
+		  mode->name,
+		  (double)side.node->notified[1] / (MSG_BURST * MSG_BURSTS),
+		  side.node->notified[0]);
+	if (!error)
+		msg_report_rtt(mode, rtt, MSG_BURSTS);
+
+	rpmsg_destroy_ept(&side.ept);
+	return error;
+}
+
+static int msg_vring_mode(const struct msg_mode *mode)
+{
+	struct rpmsg_loop loop;
+	int error, status;
+	pid_t pid;
+
+	error = rpmsg_loop_init(&loop, mode->features);
+	if (error)
+		return error;
+
+	pid = fork();
+	if (pid < 0) {
+		rpmsg_loop_finish(&loop);
+		return -errno;
+	}
+	if (pid == 0) {
+		error = msg_remote(&loop, mode);
+		rpmsg_loop_finish(&loop);
+		_exit(error ? 1 : 0);
+	}
+
+	error = msg_master(&loop, mode);
+	if (error)
+		kill(pid, SIGKILL);
+	if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) ||
+	    WEXITSTATUS(status)) {
+		metal_log(METAL_LOG_ERROR, "%s: remote failed\n", mode->name);
+		error = -EINVAL;
+	}
+	rpmsg_loop_finish(&loop);
+
+	return error;
+}
+
+static int msg_vring(void)
+{
+	static const struct msg_mode modes[] = {
+		{ "kick", 0, 0 },
+		{ "event_idx", VIRTIO_RING_F_EVENT_IDX, 0 },
+		{ "batch", 0, 1 },
+		{ "batch+event_idx", VIRTIO_RING_F_EVENT_IDX, 1 },
+	};
+	unsigned int i;
+	int error = 0;
+
+	for (i = 0; !error && i < sizeof(modes) / sizeof(modes[0]); i++)
+		error = msg_vring_mode(&modes[i]);
+
+	return error;
+}
+METAL_ADD_TEST(msg_vring);
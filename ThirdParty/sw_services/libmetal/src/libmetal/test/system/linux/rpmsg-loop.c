@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "rpmsg-loop.h"
+#include <metal/alloc.h>
+#include <metal/log.h>
+#include <metal/utilities.h>
+
+#define RPMSG_LOOP_ALIGN	4096
+
+static inline struct rpmsg_loop_ctrl *rpmsg_loop_ctrl(struct rpmsg_loop *loop)
+{
+	return loop->shm;
+}
+
+static inline unsigned long rpmsg_loop_vring_offset(unsigned int i)
+{
+	size_t size = vring_size(RPMSG_LOOP_VRING_NUM, RPMSG_LOOP_ALIGN);
+
+	/* The control block takes the first page */
+	return RPMSG_LOOP_ALIGN +
+	       i * metal_align_up(size, RPMSG_LOOP_ALIGN);
+}
+
+static inline struct rpmsg_loop_node *rpmsg_loop_node(struct virtio_device *vdev)
+{
+	return metal_container_of(vdev, struct rpmsg_loop_node, vdev);
+}
+
+static uint8_t rpmsg_loop_get_status(struct virtio_device *vdev)
+{
+	struct rpmsg_loop *loop = rpmsg_loop_node(vdev)->loop;
+
+	return atomic_load(&rpmsg_loop_ctrl(loop)->status);
+}
+
+static void rpmsg_loop_set_status(struct virtio_device *vdev, uint8_t status)
+{
+	struct rpmsg_loop *loop = rpmsg_loop_node(vdev)->loop;
+
+	atomic_store(&rpmsg_loop_ctrl(loop)->status, status);
+}
+
+static uint32_t rpmsg_loop_get_features(struct virtio_device *vdev)
+{
+	return rpmsg_loop_node(vdev)->loop->features;
+}
+
+static void rpmsg_loop_notify(struct virtqueue *vq)
+{
+	struct rpmsg_loop_node *node = rpmsg_loop_node(vq->vq_dev);
+	struct rpmsg_loop_ctrl *ctrl = rpmsg_loop_ctrl(node->loop);
+	unsigned int peer = node->vdev.role == RPMSG_MASTER ?
+			    RPMSG_REMOTE : RPMSG_MASTER;
+
+	node->notified[vq->vq_queue_index]++;
+	atomic_fetch_or(&ctrl->pending[peer], 1U << vq->vq_queue_index);
+}
+
+static const struct virtio_dispatch rpmsg_loop_dispatch = {
+	.get_status = rpmsg_loop_get_status,
+	.set_status = rpmsg_loop_set_status,
+	.get_features = rpmsg_loop_get_features,
+	.notify = rpmsg_loop_notify,
+};
+
+int rpmsg_loop_init(struct rpmsg_loop *loop, uint32_t features)
+{
+	unsigned long buf_offset = rpmsg_loop_vring_offset(RPMSG_LOOP_VRINGS);
+	size_t buf_size = 2 * RPMSG_LOOP_VRING_NUM * RPMSG_BUFFER_SIZE;
+
+	memset(loop, 0, sizeof(*loop));
+	loop->features = features;
+	loop->size = buf_offset + buf_size;
+	loop->shm = mmap(NULL, loop->size, PROT_READ | PROT_WRITE,
+			 MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (loop->shm == MAP_FAILED) {
+		loop->shm = NULL;
+		metal_log(METAL_LOG_ERROR, "failed to map shared region\n");
+		return -ENOMEM;
+	}
+	metal_io_init(&loop->io, loop->shm, &loop->phys, loop->size, -1,
+		      METAL_IO_MEM_NORMAL, NULL);
+
+	/* The master side carves its RX and TX buffers out of this pool */
+	rpmsg_virtio_init_shm_pool(&loop->shpool,
+				   (char *)loop->shm + buf_offset, buf_size);
+
+	return 0;
+}
+
+struct rpmsg_device *rpmsg_loop_start(struct rpmsg_loop *loop,
+				      unsigned int role)
+{
+	struct rpmsg_loop_node *node;
+	struct virtio_vring_info *vring;
+	unsigned int i;
+	int ret;
+
+	node = role == RPMSG_MASTER ? &loop->master : &loop->remote;
+	memset(node, 0, sizeof(*node));
+	node->loop = loop;
+	node->vdev.role = role;
+	node->vdev.id.device = VIRTIO_ID_RPMSG;
+	node->vdev.func = &rpmsg_loop_dispatch;
+	node->vdev.vrings_num = RPMSG_LOOP_VRINGS;
+	node->vdev.vrings_info = node->vrings;
+
+	for (i = 0; i < RPMSG_LOOP_VRINGS; i++) {
+		vring = &node->vrings[i];
+		vring->vq = virtqueue_allocate(RPMSG_LOOP_VRING_NUM);
+		if (!vring->vq)
+			goto err;
+		vring->io = &loop->io;
+		vring->notifyid = i;
+		vring->info.vaddr = (char *)loop->shm +
+				    rpmsg_loop_vring_offset(i);
+		vring->info.align = RPMSG_LOOP_ALIGN;
+		vring->info.num_descs = RPMSG_LOOP_VRING_NUM;
+	}
+
+	ret = rpmsg_init_vdev(&node->rvdev, &node->vdev, NULL, &loop->io,
+			      &loop->shpool);
+	if (ret) {
+		metal_log(METAL_LOG_ERROR, "rpmsg_init_vdev failed: %d\n", ret);
+		goto err;
+	}
+
+	return rpmsg_virtio_get_rpmsg_device(&node->rvdev);
+
+err:
+	for (i = 0; i < RPMSG_LOOP_VRINGS; i++)
+		metal_free_memory(node->vrings[i].vq);
+	node->loop = NULL;
+	return NULL;
+}
+
+unsigned int rpmsg_loop_poll(struct rpmsg_loop_node *node)
+{
+	struct rpmsg_loop_ctrl *ctrl = rpmsg_loop_ctrl(node->loop);
+	unsigned int pending, i;
+
+	pending = atomic_exchange(&ctrl->pending[node->vdev.role], 0);
+	for (i = 0; i < RPMSG_LOOP_VRINGS; i++) {
+		if (pending & (1U << i))
+			virtqueue_notification(node->vrings[i].vq);
+	}
+
+	return pending;
+}
+
+void rpmsg_loop_run(struct rpmsg_loop *loop)
+{
+	unsigned int pending;
+
+	do {
+		pending = rpmsg_loop_poll(&loop->master);
+		pending |= rpmsg_loop_poll(&loop->remote);
+	} while (pending);
+}
+
+void rpmsg_loop_finish(struct rpmsg_loop *loop)
+{
+	struct rpmsg_loop_node *nodes[] = { &loop->master, &loop->remote };
+	unsigned int n, i;
+
+	for (n = 0; n < sizeof(nodes) / sizeof(nodes[0]); n++) {
+		if (!nodes[n]->loop)
+			continue;
+		rpmsg_deinit_vdev(&nodes[n]->rvdev);
+		/*
+		 * Not virtqueue_free(), which warns about the buffers still
+		 * queued, as they are on a live link.
+		 */
+		for (i = 0; i < RPMSG_LOOP_VRINGS; i++)
+			metal_free_memory(nodes[n]->vrings[i].vq);
+		nodes[n]->loop = NULL;
+	}
+
+	if (loop->shm) {
+		metal_io_finish(&loop->io);
+		munmap(loop->shm, loop->size);
+		loop->shm = NULL;
+	}
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file	rpmsg-loop.h
+ * @brief	OpenAMP rpmsg master/remote pair looped back over a shared
+ *		libmetal I/O region, for the rpmsg tests.
+ */
+
+#ifndef __METAL_TEST_RPMSG_LOOP__H__
+#define __METAL_TEST_RPMSG_LOOP__H__
+
+#include <metal/atomic.h>
+#include <metal/io.h>
+#include <openamp/rpmsg.h>
+#include <openamp/rpmsg_virtio.h>
+#include <openamp/virtqueue.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Descriptors per vring, which is also the number of RX buffers per side. */
+#define RPMSG_LOOP_VRING_NUM	16
+
+/** Number of vrings of an rpmsg virtio device. */
+#define RPMSG_LOOP_VRINGS	2
+
+/**
+ * Control block at the start of the shared region. It stands for the
+ * virtio config space and the inter-processor interrupts: notifying a
+ * vring sets its bit in the pending mask of the other side. The masks are
+ * indexed by role.
+ */
+struct rpmsg_loop_ctrl {
+	atomic_uint status;
+	atomic_uint pending[2];
+};
+
+/** One side of the loop, either RPMSG_MASTER or RPMSG_REMOTE. */
+struct rpmsg_loop_node {
+	struct virtio_device vdev;
+	struct virtio_vring_info vrings[RPMSG_LOOP_VRINGS];
+	struct rpmsg_virtio_device rvdev;
+	struct rpmsg_loop *loop;
+	/** Notifications sent to the other side, per vring. */
+	unsigned long notified[RPMSG_LOOP_VRINGS];
+};
+
+/**
+ * Master and remote sides sharing one region. The region is mapped shared,
+ * so that the two sides can also be run from the two processes of a fork.
+ */
+struct rpmsg_loop {
+	struct metal_io_region io;
+	metal_phys_addr_t phys;
+	void *shm;
+	size_t size;
+	uint32_t features;
+	struct rpmsg_virtio_shm_pool shpool;
+	struct rpmsg_loop_node master;
+	struct rpmsg_loop_node remote;
+};
+
+/**
+ * @brief	Map and lay out the shared region of a loop.
+ * @param[in]	loop		Loop to initialize.
+ * @param[in]	features	Virtio features offered to both sides, for
+ *				example VIRTIO_RING_F_EVENT_IDX.
+ * @return	0 on success, or -errno on failure.
+ */
+int rpmsg_loop_init(struct rpmsg_loop *loop, uint32_t features);
+
+/**
+ * @brief	Bring up one side of a loop with rpmsg_init_vdev. The remote
+ *		side waits for the master side to be up, so in a single
+ *		process the master side must be started first.
+ * @param[in]	loop	Loop the side belongs to.
+ * @param[in]	role	RPMSG_MASTER or RPMSG_REMOTE.
+ * @return	The rpmsg device of the side, or NULL on failure.
+ */
+struct rpmsg_device *rpmsg_loop_start(struct rpmsg_loop *loop,
+				      unsigned int role);
+
+/**
+ * @brief	Deliver the notifications sent to one side, running the
+ *		virtqueue callbacks, as its IPI handler would.
+ * @param[in]	node	Side to deliver to.
+ * @return	Mask of the vrings that had been notified.
+ */
+unsigned int rpmsg_loop_poll(struct rpmsg_loop_node *node);
+
+/**
+ * @brief	Deliver notifications to both sides until none is left.
+ * @param[in]	loop	Loop to run.
+ */
+void rpmsg_loop_run(struct rpmsg_loop *loop);
+
+/**
+ * @brief	Shut down the started sides of a loop and unmap its region.
+ * @param[in]	loop	Loop to release.
+ */
+void rpmsg_loop_finish(struct rpmsg_loop *loop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __METAL_TEST_RPMSG_LOOP__H__ */
@@ -29,11 +29,14 @@
  */
 
 #include <pthread.h>
+#include <unistd.h>
 
 #include "metal-test.h"
 #include <metal/log.h>
+#include <metal/rwlock.h>
 #include <metal/sys.h>
 #include <metal/spinlock.h>
+#include <metal/time.h>
 
 static const int spinlock_test_count = 1000;
 static unsigned int total = 0;
@@ -72,3 +75,135 @@ static int spinlock(void)
 	return error;
 }
 METAL_ADD_TEST(spinlock);
+
+/*
+ * Contention benchmark: threads update a counter under each kind of lock,
+ * which must end up exact, and the time per acquisition and the contention
+ * counters are logged. The reader-writer lock is exercised read-mostly,
+ * readers checking that writers are never seen halfway through an update.
+ * There is one thread per CPU, up to 4: with more threads than CPUs, a
+ * fair lock hands over to waiters that are not running.
+ */
+enum lock_kind {
+	LOCK_SPIN,
+	LOCK_TICKET,
+	LOCK_MCS,
+	LOCK_RW,
+};
+
+static const char * const lock_names[] = { "spin", "ticket", "mcs", "rwlock" };
+
+static const int lock_bench_max_threads = 4;
+static const int lock_bench_count = 100000;
+
+struct lock_bench {
+	enum lock_kind kind;
+	struct metal_spinlock slock;
+	struct metal_ticket_lock tlock;
+	struct metal_mcs_lock mlock;
+	struct metal_rwlock rwlock;
+	unsigned int counter;
+	unsigned int pair[2];
+	atomic_int torn;
+};
+
+static void *lock_bench_thread(void *arg)
+{
+	struct lock_bench *b = arg;
+	struct metal_mcs_node node;
+	int i;
+
+	for (i = 0; i < lock_bench_count; i++) {
+		switch (b->kind) {
+		case LOCK_SPIN:
+			metal_spinlock_acquire(&b->slock);
+			b->counter++;
+			metal_spinlock_release(&b->slock);
+			break;
+		case LOCK_TICKET:
+			metal_ticket_lock_acquire(&b->tlock);
+			b->counter++;
+			metal_ticket_lock_release(&b->tlock);
+			break;
+		case LOCK_MCS:
+			metal_mcs_lock_acquire(&b->mlock, &node);
+			b->counter++;
+			metal_mcs_lock_release(&b->mlock, &node);
+			break;
+		case LOCK_RW:
+			if (i % 16) {
+				metal_rwlock_read_acquire(&b->rwlock);
+				if (b->pair[0] != b->pair[1])
+					atomic_fetch_add(&b->torn, 1);
+				metal_rwlock_read_release(&b->rwlock);
+			} else {
+				metal_rwlock_write_acquire(&b->rwlock);
+				b->pair[0]++;
+				b->counter++;
+				b->pair[1]++;
+				metal_rwlock_write_release(&b->rwlock);
+			}
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+static int spinlock_contention(void)
+{
+	struct metal_lock_stats stats;
+	struct lock_bench b;
+	unsigned long long t0, ns;
+	unsigned int expect;
+	int kind, threads, error = 0;
+
+	threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (threads > lock_bench_max_threads)
+		threads = lock_bench_max_threads;
+	if (threads < 1)
+		threads = 1;
+
+	for (kind = LOCK_SPIN; kind <= LOCK_RW && !error; kind++) {
+		metal_lock_stats_init(&stats);
+		b.kind = kind;
+		metal_spinlock_init(&b.slock);
+		metal_ticket_lock_init(&b.tlock, &stats);
+		metal_mcs_lock_init(&b.mlock, &stats);
+		metal_rwlock_init(&b.rwlock, &stats);
+		b.counter = 0;
+		b.pair[0] = 0;
+		b.pair[1] = 0;
+		atomic_init(&b.torn, 0);
+
+		t0 = metal_get_timestamp();
+		error = metal_run(threads, lock_bench_thread, &b);
+		ns = metal_get_timestamp() - t0;
+		if (error)
+			break;
+
+		/* every 16th reader-writer lock acquisition is a write */
+		if (kind == LOCK_RW)
+			expect = threads * ((lock_bench_count + 15) / 16);
+		else
+			expect = threads * lock_bench_count;
+		if (b.counter != expect || atomic_load(&b.torn)) {
+			metal_log(METAL_LOG_DEBUG,
+				  "%s: counter %u, expected %u, %d torn reads\n",
+				  lock_names[kind], b.counter, expect,
+				  atomic_load(&b.torn));
+			error = -EINVAL;
+		}
+
+		metal_log(METAL_LOG_INFO,
+			  "%-6s %d threads: %llu ns/op, %lu of %lu contended, max %lu spins\n",
+			  lock_names[kind], threads,
+			  ns / (threads * lock_bench_count),
+			  atomic_load(&stats.contended),
+			  atomic_load(&stats.acquires),
+			  atomic_load(&stats.max_spins));
+	}
+
+	return error;
+}
+METAL_ADD_TEST(spinlock_contention);
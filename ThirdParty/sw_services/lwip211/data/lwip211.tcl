@@ -1517,6 +1517,13 @@ proc generate_adapterconfig_include {libhandle} {
 		set ncoalesce [common::get_property CONFIG.n_rx_coalesce $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_COALESCE $ncoalesce"
 		puts $fd ""
+
+		set lowat [common::get_property CONFIG.axi_tx_reap_lowat $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_AXI_TX_REAP_LOWAT $lowat"
+		if {[common::get_property CONFIG.axi_dma_tx_coherent $libhandle] == true} {
+			puts $fd "\#define XLWIP_CONFIG_AXI_DMA_TX_COHERENT 1"
+		}
+		puts $fd ""
 	}
 	if {$have_ps_ethernet == 1} {
 		set emacnum [common::get_property CONFIG.emac_number $libhandle]
@@ -1525,6 +1532,16 @@ proc generate_adapterconfig_include {libhandle} {
 		puts $fd "\#define XLWIP_CONFIG_N_TX_DESC $ndesc"
 		set ndesc [common::get_property CONFIG.n_rx_descriptors $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_DESC $ndesc"
+		set rxpoll [common::get_property CONFIG.emacps_rx_poll $libhandle]
+		if {$rxpoll == true} {
+			puts $fd "\#define XLWIP_CONFIG_EMACPS_RX_POLL 1"
+		}
+		set budget [common::get_property CONFIG.emacps_rx_poll_budget $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_EMACPS_RX_POLL_BUDGET $budget"
+		set intmod [common::get_property CONFIG.emacps_rx_int_moderation $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_EMACPS_RX_INT_MOD $intmod"
+		set numq [common::get_property CONFIG.emacps_num_queues $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_EMACPS_NUM_QUEUES $numq"
 		puts $fd ""
 	}
 
@@ -71,6 +71,12 @@ typedef signed     long long    s64_t;
 
 typedef unsigned long mem_ptr_t;
 
+/* Internet checksum, see xchksum.c */
+#ifndef LWIP_CHKSUM
+#define LWIP_CHKSUM xil_chksum
+u16_t xil_chksum(const void *dataptr, int len);
+#endif
+
 #define PACK_STRUCT_FIELD(x) x
 #define PACK_STRUCT_STRUCT __attribute__((packed))
 #define PACK_STRUCT_BEGIN
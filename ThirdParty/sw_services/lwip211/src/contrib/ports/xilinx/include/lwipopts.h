@@ -191,9 +191,19 @@ a lot of data that needs to be copied, this should be set high. */
 //#define LWIP_DEBUG 1
 #define DBG_TYPES_ON DBG_LEVEL_WARNING
 
-#define CHECKSUM_GEN_IP                 1
-#define CHECKSUM_GEN_TCP                1
-#define CHECKSUM_CHECK_IP               1
-#define CHECKSUM_CHECK_TCP              1
+/* Leave checksums to the MAC when it offloads them */
+#ifndef LWIP_FULL_CSUM_OFFLOAD_TX
+#define LWIP_FULL_CSUM_OFFLOAD_TX       0
+#endif
+#ifndef LWIP_FULL_CSUM_OFFLOAD_RX
+#define LWIP_FULL_CSUM_OFFLOAD_RX       0
+#endif
+
+#define CHECKSUM_GEN_IP                 (!LWIP_FULL_CSUM_OFFLOAD_TX)
+#define CHECKSUM_GEN_TCP                (!LWIP_FULL_CSUM_OFFLOAD_TX)
+#define CHECKSUM_GEN_UDP                (!LWIP_FULL_CSUM_OFFLOAD_TX)
+#define CHECKSUM_CHECK_IP               (!LWIP_FULL_CSUM_OFFLOAD_RX)
+#define CHECKSUM_CHECK_TCP              (!LWIP_FULL_CSUM_OFFLOAD_RX)
+#define CHECKSUM_CHECK_UDP              (!LWIP_FULL_CSUM_OFFLOAD_RX)
 
 #endif /* __LWIPOPTS_H__ */
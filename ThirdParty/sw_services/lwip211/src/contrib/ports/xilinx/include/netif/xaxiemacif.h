@@ -77,6 +77,21 @@ unsigned phy_setup_axiemac (XAxiEthernet *xaxiemacp);
 /* xaxiemacif_hw.c */
 void 	xaxiemac_error_handler(XAxiEthernet * Temac);
 
+/* Completed TX BDs of a ring are only reaped once its free BD count drops
+ * below this low water mark, so that they are reaped in batches. 0 reaps
+ * them on every TX interrupt.
+ */
+#ifndef XLWIP_CONFIG_AXI_TX_REAP_LOWAT
+#define XLWIP_CONFIG_AXI_TX_REAP_LOWAT	0
+#endif
+
+/* Set when the AXI DMA reads TX buffers through a cache coherent port, in
+ * which case they are not flushed before being sent.
+ */
+#ifndef XLWIP_CONFIG_AXI_DMA_TX_COHERENT
+#define XLWIP_CONFIG_AXI_DMA_TX_COHERENT	0
+#endif
+
 /* structure within each netif, encapsulating all information required for
  * using a particular temac instance
  */
@@ -103,6 +118,7 @@ extern xaxiemacif_s xaxiemacif;
 
 #ifndef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_FIFO
 s32_t is_tx_space_available(xaxiemacif_s *emac);
+void reap_sent_bds(xaxiemacif_s *xaxiemacif, s32_t lowat);
 #ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
 s32_t process_sent_bds(XMcdma_ChanCtrl *Tx_Chan);
 #else
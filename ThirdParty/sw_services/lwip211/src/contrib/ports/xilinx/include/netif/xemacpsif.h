@@ -62,6 +62,13 @@ extern "C" {
 #include "xil_smc.h"
 #endif
 
+#if LWIP_STATS
+#include "xtime_l.h"
+#if !defined (ARMR5) || defined (SLEEP_TIMER_BASEADDR)
+#define XEMACPSIF_QSTATS_TIME
+#endif
+#endif
+
 #define ZYNQ_EMACPS_0_BASEADDR 0xE000B000
 #define ZYNQ_EMACPS_1_BASEADDR 0xE000C000
 
@@ -100,10 +107,82 @@ extern "C" {
 
 #define MAX_FRAME_SIZE_JUMBO (XEMACPS_MTU_JUMBO + XEMACPS_HDR_SIZE + XEMACPS_TRL_SIZE)
 
+/* With XLWIP_CONFIG_EMACPS_RX_POLL, the RX interrupt only schedules
+ * emacps_rx_poll, which processes up to this many RX BDs per pass.
+ */
+#ifndef XLWIP_CONFIG_EMACPS_RX_POLL_BUDGET
+#define XLWIP_CONFIG_EMACPS_RX_POLL_BUDGET	32
+#endif
+
+#ifndef XLWIP_CONFIG_EMACPS_RX_INT_MOD
+#define XLWIP_CONFIG_EMACPS_RX_INT_MOD	0
+#endif
+
+/* Number of queues used. Queue 0 carries normal traffic. With 2 queues,
+ * queue 1 carries the traffic selected by xemacpsif_add_screen on the GEM
+ * priority queues, each with its own RX and TX BD ring.
+ */
+#ifndef XLWIP_CONFIG_EMACPS_NUM_QUEUES
+#define XLWIP_CONFIG_EMACPS_NUM_QUEUES	1
+#endif
+
+#define XEMACPSIF_MAX_SCREENS	8
+
+/* Screening rule types for xemacpsif_add_screen */
+#define XEMACPSIF_SCREEN_VLAN_PCP	1	/* VLAN priority, 0 to 7 */
+#define XEMACPSIF_SCREEN_DSCP		2	/* IP DSCP, 0 to 63, ECN not set */
+#define XEMACPSIF_SCREEN_UDP_PORT	3	/* UDP destination port */
+#define XEMACPSIF_SCREEN_ETHTYPE	4	/* Ethertype */
+
+/* A rule steering matching frames to a queue, applied by the GEM screeners
+ * on receive and by emacps_tx_queue on transmit.
+ */
+struct xemacpsif_screen {
+	u8_t type;
+	u8_t queue;
+	u16_t value;
+};
+
+#if LWIP_STATS
+/* Per queue statistics. Latencies are in XTime counts: on transmit from
+ * emacps_sgsend to the BD being completed, on receive from the BD being
+ * reaped to the frame being handed to lwIP.
+ */
+struct xemacpsif_qstats {
+	u32_t tx_frames;
+	u32_t rx_frames;
+	u32_t tx_bds_max;	/* most TX BDs in use */
+	u32_t rx_backlog_max;	/* most frames waiting for lwIP */
+	u64_t tx_lat_sum;
+	u32_t tx_lat_max;
+	u64_t rx_lat_sum;
+	u32_t rx_lat_max;
+};
+
+/* Polled receive statistics, see emacps_rx_poll */
+struct xemacpsif_rx_poll_stats {
+	u32_t polls;	/* poll passes */
+	u32_t budget;	/* poll passes which used up the budget */
+	u32_t drop;	/* received frames dropped by a poll pass */
+};
+#endif
+
+#if LWIP_STATS && XLWIP_CONFIG_EMACPS_RX_POLL
+#define EMACPS_RX_POLL_STATS_INC(xemacpsif, counter) \
+	((xemacpsif)->rx_poll_stats.counter++)
+#else
+#define EMACPS_RX_POLL_STATS_INC(xemacpsif, counter)
+#endif
+
 void 	xemacpsif_setmac(u32_t index, u8_t *addr);
 u8_t*	xemacpsif_getmac(u32_t index);
 err_t 	xemacpsif_init(struct netif *netif);
 s32_t 	xemacpsif_input(struct netif *netif);
+err_t	xemacpsif_add_screen(struct netif *netif, u8_t type, u16_t value,
+							u8_t queue);
+#if LWIP_STATS
+void	xemacpsif_queue_stats_display(struct netif *netif);
+#endif
 
 /* xaxiemacif_hw.c */
 void 	xemacps_error_handler(XEmacPs * Temac);
@@ -124,20 +203,66 @@ typedef struct {
 
 	unsigned int last_rx_frms_cntr;
 
+	/* RX interrupt masked until emacps_rx_poll empties the RX ring */
+	volatile u32_t rx_poll_pending;
+
+	/* queues in use, limited by the number of queues of the GEM */
+	u32_t num_queues;
+
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	/* queue 1 receives on RX hardware queue 1 into its own q. TX queue 1
+	 * is the emacps TX ring, queue 0 transmits on TX hardware queue 0.
+	 */
+	pq_queue_t *prio_recv_q;
+	XEmacPs_BdRing prio_rx_ring;
+	XEmacPs_BdRing bulk_tx_ring;
+	void *prio_rx_bdspace;
+	void *bulk_tx_bdspace;
+
+	struct xemacpsif_screen screens[XEMACPSIF_MAX_SCREENS];
+	u32_t n_screens;
+#endif
+
+#if LWIP_STATS
+	struct xemacpsif_qstats qstats[XLWIP_CONFIG_EMACPS_NUM_QUEUES];
+#if XLWIP_CONFIG_EMACPS_RX_POLL
+	struct xemacpsif_rx_poll_stats rx_poll_stats;
+#endif
+#ifdef XEMACPSIF_QSTATS_TIME
+	XTime tx_stamp[XLWIP_CONFIG_EMACPS_NUM_QUEUES][XLWIP_CONFIG_N_TX_DESC];
+	XTime rx_stamp[XLWIP_CONFIG_EMACPS_NUM_QUEUES][XLWIP_CONFIG_N_RX_DESC];
+	u32_t rx_stamp_seq[XLWIP_CONFIG_EMACPS_NUM_QUEUES][XLWIP_CONFIG_N_RX_DESC];
+	u32_t rx_enq_seq[XLWIP_CONFIG_EMACPS_NUM_QUEUES];
+	u32_t rx_deq_seq[XLWIP_CONFIG_EMACPS_NUM_QUEUES];
+#endif
+#endif
+
 } xemacpsif_s;
 
 extern xemacpsif_s xemacpsif;
 
-s32_t	is_tx_space_available(xemacpsif_s *emac);
+s32_t	is_tx_space_available(xemacpsif_s *emac, u32_t queue);
 
 /* xemacpsif_dma.c */
 
+XEmacPs_BdRing *emacps_txring(xemacpsif_s *xemacpsif, u32_t queue);
+XEmacPs_BdRing *emacps_rxring(xemacpsif_s *xemacpsif, u32_t queue);
+pq_queue_t *emacps_recv_q(xemacpsif_s *xemacpsif, u32_t queue);
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+u32_t emacps_tx_queue(xemacpsif_s *xemacpsif, struct pbuf *p);
+XStatus emacps_apply_screens(xemacpsif_s *xemacpsif);
+#endif
+#if LWIP_STATS
+void emacps_rx_delivered(xemacpsif_s *xemacpsif, u32_t queue);
+#endif
+
 void  process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring);
 u32_t phy_setup_emacps (XEmacPs *xemacpsp, u32_t phy_addr);
 void detect_phy(XEmacPs *xemacpsp);
 void emacps_send_handler(void *arg);
-XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p);
+XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p, u32_t queue);
 void emacps_recv_handler(void *arg);
+s32_t emacps_rx_poll(xemacpsif_s *xemacpsif, s32_t budget);
 void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord);
 void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring);
 void HandleTxErrors(struct xemac_s *xemac);
@@ -139,20 +139,18 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
         struct xemac_s *xemac = (struct xemac_s *)(netif->state);
         xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
 
-#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA
-	/*
-	 * With AXI Ethernet on Zynq, we observed unexplained delays for
-	 * BD Status update. As a result, we are hitting a condition where
-	 * there are no BDs free to transmit packets. So, we have added
-	 * this logic where we look for the status update in a definite
-	 * loop.
-	 */
-	XAxiDma_BdRing *txring = XAxiDma_GetTxRing(&xaxiemacif->axidma);
-#endif
         int count = 100;
 
         SYS_ARCH_PROTECT(lev);
 
+#if defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA) || \
+	defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA)
+	/* reap the completed BDs in a batch once the ring runs low */
+	if (XLWIP_CONFIG_AXI_TX_REAP_LOWAT != 0) {
+		reap_sent_bds(xaxiemacif, XLWIP_CONFIG_AXI_TX_REAP_LOWAT);
+	}
+#endif
+
         while (count) {
 
 		/* check if space is available to send */
@@ -164,8 +162,16 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 #if LINK_STATS
 			lwip_stats.link.drop++;
 #endif
-#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA
-			process_sent_bds(txring);
+			/*
+			 * With AXI Ethernet on Zynq, we observed unexplained
+			 * delays for BD Status update. As a result, we are
+			 * hitting a condition where there are no BDs free to
+			 * transmit packets. So, we have added this logic where
+			 * we look for the status update in a definite loop.
+			 */
+#if defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA) || \
+	defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA)
+			reap_sent_bds(xaxiemacif, 0);
 #endif
 			count--;
 		}
@@ -286,7 +286,7 @@ static void axidma_send_handler(void *arg)
 	}
 	/* If Transmit done interrupt is asserted, process completed BD's */
 	if (irq_status & (XAXIDMA_IRQ_DELAY_MASK | XAXIDMA_IRQ_IOC_MASK)) {
-		process_sent_bds(txringptr);
+		reap_sent_bds(xaxiemacif, XLWIP_CONFIG_AXI_TX_REAP_LOWAT);
 	}
 
 	XAxiDma_BdRingIntEnable(txringptr, XAXIDMA_IRQ_ALL_MASK);
@@ -501,6 +501,20 @@ s32_t process_sent_bds(XAxiDma_BdRing *txring)
 	return (XAxiDma_BdRingFree(txring, n_bds, txbdset));
 }
 
+/*
+ * Reap the completed TX BDs if fewer than lowat BDs are free, or always if
+ * lowat is 0. Leaving completed BDs in the ring until it runs low takes
+ * them back in batches rather than a few per TX interrupt.
+ */
+void reap_sent_bds(xaxiemacif_s *xaxiemacif, s32_t lowat)
+{
+	XAxiDma_BdRing *txring = XAxiDma_GetTxRing(&xaxiemacif->axidma);
+
+	if ((lowat == 0) || (XAxiDma_BdRingGetFreeCnt(txring) < lowat)) {
+		process_sent_bds(txring);
+	}
+}
+
 XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 {
 	struct pbuf *q;
@@ -517,9 +531,21 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 #endif
 	txring = XAxiDma_GetTxRing(&xaxiemacif->axidma);
 
-	/* first count the number of pbufs */
-	for (q = p, n_pbufs = 0; q != NULL; q = q->next)
-		n_pbufs++;
+	/* first count the number of pbufs, empty ones do not take a BD */
+	for (q = p, n_pbufs = 0; q != NULL; q = q->next) {
+		if (q->len != 0)
+			n_pbufs++;
+	}
+	if (n_pbufs == 0) {
+		return XST_FAILURE;
+	}
+
+	/* The frame starts at the first pbuf which takes a BD, which is
+	 * where the checksum offload below must look for the headers.
+	 */
+	while (p->len == 0) {
+		p = p->next;
+	}
 
 	/* obtain as many BD's */
 	status = XAxiDma_BdRingAlloc(txring, n_pbufs, &txbdset);
@@ -531,8 +557,11 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 	for(q = p, txbd = txbdset; q != NULL; q = q->next) {
 		/* Send the data from the pbuf to the interface, one pbuf at a
 		 * time. The size of the data in each pbuf is kept in the ->len
-		 * variable.
+		 * variable. The payload is sent in place, whatever the pbuf
+		 * type, and held with a reference until its BD is reaped.
 		 */
+		if (q->len == 0)
+			continue;
 		XAxiDma_BdSetBufAddr(txbd, (UINTPTR)q->payload);
 		if (q->len > max_frame_size) {
 			XAxiDma_BdSetLength(txbd, max_frame_size,
@@ -543,7 +572,9 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 		}
 		XAxiDma_BdSetId(txbd, (void *)q);
 		XAxiDma_BdSetCtrl(txbd, 0);
+#if !XLWIP_CONFIG_AXI_DMA_TX_COHERENT
 		XCACHE_FLUSH_DCACHE_RANGE(q->payload, q->len);
+#endif
 
 		pbuf_ref(q);
 
@@ -282,7 +282,10 @@ static void axi_mcdma_send_handler(void *CallBackRef, u32 ChanId)
 	xInsideISR++;
 #endif
 
-	process_sent_bds(Tx_Chan);
+	if ((XLWIP_CONFIG_AXI_TX_REAP_LOWAT == 0) ||
+		(Tx_Chan->BdCnt < XLWIP_CONFIG_AXI_TX_REAP_LOWAT)) {
+		process_sent_bds(Tx_Chan);
+	}
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
@@ -492,6 +495,25 @@ s32_t process_sent_bds(XMcdma_ChanCtrl *Tx_Chan)
 	return XST_SUCCESS;
 }
 
+/*
+ * Reap the completed TX BDs of each channel with fewer than lowat free BDs,
+ * or of all channels if lowat is 0.
+ */
+void reap_sent_bds(xaxiemacif_s *xaxiemacif, s32_t lowat)
+{
+	XMcdma_ChanCtrl *Tx_Chan;
+	u8_t ChanId;
+
+	for (ChanId = 1;
+		ChanId <= xaxiemacif->axi_ethernet.Config.AxiMcDmaChan_Cnt;
+								ChanId++) {
+		Tx_Chan = XMcdma_GetMcdmaTxChan(&xaxiemacif->aximcdma, ChanId);
+		if ((lowat == 0) || (Tx_Chan->BdCnt < lowat)) {
+			process_sent_bds(Tx_Chan);
+		}
+	}
+}
+
 #if LWIP_PARTIAL_CSUM_OFFLOAD_TX==1
 static void update_partial_cksum_offload(XMcdma_Bd *txbdset, struct pbuf *p)
 {
@@ -542,9 +564,21 @@ XStatus axi_mcdma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 	static u8_t ChanId = 1;
 	u8_t next_ChanId = ChanId;
 
-	/* first count the number of pbufs */
-	for (q = p; q != NULL; q = q->next)
-		n_pbufs++;
+	/* first count the number of pbufs, empty ones do not take a BD */
+	for (q = p; q != NULL; q = q->next) {
+		if (q->len != 0)
+			n_pbufs++;
+	}
+	if (n_pbufs == 0) {
+		return XST_FAILURE;
+	}
+
+	/* The frame starts at the first pbuf which takes a BD, which is
+	 * where the checksum offload below must look for the headers.
+	 */
+	while (p->len == 0) {
+		p = p->next;
+	}
 
 	/* Transfer packets to TX DMA Channels in round-robin manner */
 	do {
@@ -565,12 +599,17 @@ XStatus axi_mcdma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 	for (q = p, txbd = txbdset; q != NULL; q = q->next) {
 		/* Send the data from the pbuf to the interface, one pbuf at a
 		 * time. The size of the data in each pbuf is kept in the ->len
-		 * variable.
+		 * variable. The payload is sent in place, whatever the pbuf
+		 * type, and held with a reference until its BD is reaped.
 		 */
+		if (q->len == 0)
+			continue;
 		XMcDma_BdSetCtrl(txbd, 0);
 		XMcdma_BdSetSwId(txbd, (void *)q);
 
-		Xil_DCacheFlushRange((UINTPTR)q->payload, q->len);
+		if (!xaxiemacif->aximcdma.Config.IsTxCacheCoherent) {
+			Xil_DCacheFlushRange((UINTPTR)q->payload, q->len);
+		}
 
 		status = XMcDma_ChanSubmit(Tx_Chan, (UINTPTR)q->payload,
 				q->len);
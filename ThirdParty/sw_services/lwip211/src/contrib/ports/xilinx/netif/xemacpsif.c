@@ -86,14 +86,14 @@ int32_t lExpireCounter = 0;
  * this function also assumes that there are available BD's
  */
 static err_t _unbuffered_low_level_output(xemacpsif_s *xemacpsif,
-													struct pbuf *p)
+											struct pbuf *p, u32_t queue)
 {
 	XStatus status = 0;
 
 #if ETH_PAD_SIZE
 	pbuf_header(p, -ETH_PAD_SIZE);	/* drop the padding word */
 #endif
-	status = emacps_sgsend(xemacpsif, p);
+	status = emacps_sgsend(xemacpsif, p, queue);
 	if (status != XST_SUCCESS) {
 #if LINK_STATS
 	lwip_stats.link.drop++;
@@ -127,21 +127,26 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
     err_t err;
     s32_t freecnt;
     XEmacPs_BdRing *txring;
+    u32_t queue = 0;
 
 	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 
 	SYS_ARCH_PROTECT(lev);
 
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	queue = emacps_tx_queue(xemacpsif, p);
+#endif
+
 	/* check if space is available to send */
-    freecnt = is_tx_space_available(xemacpsif);
+    freecnt = is_tx_space_available(xemacpsif, queue);
     if (freecnt <= 5) {
-	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+	txring = emacps_txring(xemacpsif, queue);
 		process_sent_bds(xemacpsif, txring);
 	}
 
-    if (is_tx_space_available(xemacpsif)) {
-		_unbuffered_low_level_output(xemacpsif, p);
+    if (is_tx_space_available(xemacpsif, queue)) {
+		_unbuffered_low_level_output(xemacpsif, p, queue);
 		err = ERR_OK;
 	} else {
 #if LINK_STATS
@@ -167,14 +172,35 @@ static struct pbuf * low_level_input(struct netif *netif)
 	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 	struct pbuf *p;
+	u32_t queue;
+
+#if XLWIP_CONFIG_EMACPS_RX_POLL
+	/* refill the receive qs from the RX rings if the interrupt asked for it */
+	if (xemacpsif->rx_poll_pending) {
+		for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+			if (pq_qlength(emacps_recv_q(xemacpsif, queue)) != 0) {
+				break;
+			}
+		}
+		if (queue == xemacpsif->num_queues) {
+			emacps_rx_poll(xemacpsif, XLWIP_CONFIG_EMACPS_RX_POLL_BUDGET);
+		}
+	}
+#endif
 
-	/* see if there is data to process */
-	if (pq_qlength(xemacpsif->recv_q) == 0)
-		return NULL;
+	/* return one packet, from the priority receive q first */
+	for (queue = xemacpsif->num_queues; queue-- > 0; ) {
+		if (pq_qlength(emacps_recv_q(xemacpsif, queue)) != 0) {
+			p = (struct pbuf *)pq_dequeue(emacps_recv_q(xemacpsif, queue));
+#if LWIP_STATS
+			emacps_rx_delivered(xemacpsif, queue);
+#endif
+			return p;
+		}
+	}
 
-	/* return one packet from receive q */
-	p = (struct pbuf *)pq_dequeue(xemacpsif->recv_q);
-	return p;
+	/* no data to process */
+	return NULL;
 }
 
 /*
@@ -312,6 +338,23 @@ static err_t low_level_init(struct netif *netif)
 	if (!xemacpsif->recv_q)
 		return ERR_MEM;
 
+	xemacpsif->num_queues = 1;
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	xemacpsif->prio_recv_q = pq_create_queue();
+	if (!xemacpsif->prio_recv_q)
+		return ERR_MEM;
+	xemacpsif->n_screens = 0;
+#endif
+#if LWIP_STATS
+	memset(xemacpsif->qstats, 0, sizeof(xemacpsif->qstats));
+#ifdef XEMACPSIF_QSTATS_TIME
+	memset(xemacpsif->tx_stamp, 0, sizeof(xemacpsif->tx_stamp));
+	memset(xemacpsif->rx_stamp_seq, 0, sizeof(xemacpsif->rx_stamp_seq));
+	memset(xemacpsif->rx_enq_seq, 0, sizeof(xemacpsif->rx_enq_seq));
+	memset(xemacpsif->rx_deq_seq, 0, sizeof(xemacpsif->rx_deq_seq));
+#endif
+#endif
+
 	/* maximum transfer unit */
 #ifdef ZYNQMP_USE_JUMBO
 	netif->mtu = XEMACPS_MTU_JUMBO - XEMACPS_HDR_SIZE;
@@ -468,8 +511,7 @@ static void xemacpsif_mld6_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 	u8_t multicast_mac_addr[6];
 	struct xemac_s *xemac = (struct xemac_s *) (netif->state);
 	xemacpsif_s *xemacpsif = (xemacpsif_s *) (xemac->state);
-	XEmacPs_BdRing *txring;
-	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+	u32_t queue;
 
 	multicast_mac_addr[0] = LL_IP6_MULTICAST_ADDR_0;
 	multicast_mac_addr[1] = LL_IP6_MULTICAST_ADDR_1;
@@ -479,7 +521,9 @@ static void xemacpsif_mld6_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 	multicast_mac_addr[5] = ip_addr[15];
 
 	/* Wait till all sent packets are acknowledged from HW */
-	while(txring->HwCnt);
+	for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+		while(emacps_txring(xemacpsif, queue)->HwCnt);
+	}
 
 	SYS_ARCH_DECL_PROTECT(lev);
 
@@ -575,8 +619,7 @@ static void xemacpsif_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 	u8_t multicast_mac_addr[6];
 	struct xemac_s *xemac = (struct xemac_s *) (netif->state);
 	xemacpsif_s *xemacpsif = (xemacpsif_s *) (xemac->state);
-	XEmacPs_BdRing *txring;
-	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+	u32_t queue;
 
 	multicast_mac_addr[0] = 0x01;
 	multicast_mac_addr[1] = 0x00;
@@ -586,7 +629,9 @@ static void xemacpsif_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 	multicast_mac_addr[5] = ip_addr[3];
 
 	/* Wait till all sent packets are acknowledged from HW */
-	while(txring->HwCnt);
+	for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+		while(emacps_txring(xemacpsif, queue)->HwCnt);
+	}
 
 	SYS_ARCH_DECL_PROTECT(lev);
 
@@ -724,6 +769,107 @@ err_t xemacpsif_init(struct netif *netif)
 	return ERR_OK;
 }
 
+/*
+ * xemacpsif_add_screen():
+ *
+ * Steers the frames matching a rule to a queue: received frames through
+ * the GEM screeners, sent frames by looking at their headers. type is one
+ * of the XEMACPSIF_SCREEN_* rule types. Returns ERR_ARG if the netif uses
+ * a single queue or the rule is invalid, and ERR_MEM if no more rules or
+ * screeners are available.
+ *
+ */
+
+err_t xemacpsif_add_screen(struct netif *netif, u8_t type, u16_t value,
+							u8_t queue)
+{
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	struct xemacpsif_screen *scr;
+	err_t err = ERR_OK;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if ((queue >= xemacpsif->num_queues) ||
+		((type == XEMACPSIF_SCREEN_VLAN_PCP) && (value > 7)) ||
+		((type == XEMACPSIF_SCREEN_DSCP) && (value > 63)) ||
+		(type < XEMACPSIF_SCREEN_VLAN_PCP) || (type > XEMACPSIF_SCREEN_ETHTYPE)) {
+		return ERR_ARG;
+	}
+
+	SYS_ARCH_PROTECT(lev);
+	if (xemacpsif->n_screens >= XEMACPSIF_MAX_SCREENS) {
+		err = ERR_MEM;
+	} else {
+		scr = &xemacpsif->screens[xemacpsif->n_screens++];
+		scr->type = type;
+		scr->value = value;
+		scr->queue = queue;
+		if (emacps_apply_screens(xemacpsif) != XST_SUCCESS) {
+			/* out of screeners of this type, drop the rule again */
+			xemacpsif->n_screens--;
+			(void)emacps_apply_screens(xemacpsif);
+			err = ERR_MEM;
+		}
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	return err;
+#else
+	(void)netif;
+	(void)type;
+	(void)value;
+	(void)queue;
+	return ERR_ARG;
+#endif
+}
+
+#if LWIP_STATS
+/*
+ * xemacpsif_queue_stats_display():
+ *
+ * Prints the statistics of each queue and, in polled receive mode, of the
+ * poll passes. Latencies are averages and maximums in microseconds.
+ *
+ */
+
+void xemacpsif_queue_stats_display(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	struct xemacpsif_qstats *qs;
+	u32_t queue;
+
+	for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+		qs = &xemacpsif->qstats[queue];
+		xil_printf("\r\nGEM queue %d\r\n", (int)queue);
+		xil_printf("\ttx frames: %d\r\n", (int)qs->tx_frames);
+		xil_printf("\ttx bds in use max: %d\r\n", (int)qs->tx_bds_max);
+		xil_printf("\trx frames: %d\r\n", (int)qs->rx_frames);
+		xil_printf("\trx backlog max: %d\r\n", (int)qs->rx_backlog_max);
+#ifdef XEMACPSIF_QSTATS_TIME
+		if (qs->tx_frames != 0) {
+			xil_printf("\ttx latency avg/max: %d/%d us\r\n",
+				(int)((qs->tx_lat_sum / qs->tx_frames) * 1000000U / COUNTS_PER_SECOND),
+				(int)(((u64_t)qs->tx_lat_max * 1000000U) / COUNTS_PER_SECOND));
+		}
+		if (qs->rx_frames != 0) {
+			xil_printf("\trx latency avg/max: %d/%d us\r\n",
+				(int)((qs->rx_lat_sum / qs->rx_frames) * 1000000U / COUNTS_PER_SECOND),
+				(int)(((u64_t)qs->rx_lat_max * 1000000U) / COUNTS_PER_SECOND));
+		}
+#endif
+	}
+#if XLWIP_CONFIG_EMACPS_RX_POLL
+	xil_printf("\r\nGEM RX poll\r\n");
+	xil_printf("\tpolls: %d\r\n", (int)xemacpsif->rx_poll_stats.polls);
+	xil_printf("\tbudget used up: %d\r\n",
+		(int)xemacpsif->rx_poll_stats.budget);
+	xil_printf("\tdrop: %d\r\n", (int)xemacpsif->rx_poll_stats.drop);
+#endif
+}
+#endif
+
 /*
  * xemacpsif_resetrx_on_no_rxdata():
  *
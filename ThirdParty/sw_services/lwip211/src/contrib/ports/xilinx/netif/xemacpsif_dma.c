@@ -32,6 +32,9 @@
 #include "lwip/stats.h"
 #include "lwip/sys.h"
 #include "lwip/inet_chksum.h"
+#include "lwip/prot/ethernet.h"
+#include "lwip/prot/ip.h"
+#include "lwip/prot/ip6.h"
 
 #include "netif/xadapter.h"
 #include "netif/xemacpsif.h"
@@ -61,9 +64,13 @@
 /* Byte alignment of BDs */
 #define BD_ALIGNMENT (XEMACPS_DMABD_MINIMUM_ALIGNMENT*2)
 
-/* A max of 4 different ethernet interfaces are supported */
-static UINTPTR tx_pbufs_storage[4*XLWIP_CONFIG_N_TX_DESC];
-static UINTPTR rx_pbufs_storage[4*XLWIP_CONFIG_N_RX_DESC];
+/* A max of 4 different ethernet interfaces are supported, the storage of
+ * queue 1 follows the one of queue 0 for all interfaces
+ */
+#define XEMACPSIF_TX_QUEUE_STORAGE	(4*XLWIP_CONFIG_N_TX_DESC)
+#define XEMACPSIF_RX_QUEUE_STORAGE	(4*XLWIP_CONFIG_N_RX_DESC)
+static UINTPTR tx_pbufs_storage[XEMACPSIF_TX_QUEUE_STORAGE*XLWIP_CONFIG_EMACPS_NUM_QUEUES];
+static UINTPTR rx_pbufs_storage[XEMACPSIF_RX_QUEUE_STORAGE*XLWIP_CONFIG_EMACPS_NUM_QUEUES];
 
 static s32_t emac_intr_num;
 
@@ -124,12 +131,63 @@ long xInsideISR = 0;
 	(((UINTPTR)bdptr - (UINTPTR)(ringptr)->BaseBdAddr) / (ringptr)->Separation)
 
 
-s32_t is_tx_space_available(xemacpsif_s *emac)
+/*
+ * Queue 0 uses the emacps RX ring and, with a single queue, the emacps TX
+ * ring. With 2 queues, the emacps TX ring (TX hardware queue 1) serves
+ * queue 1 and the bulk TX ring (TX hardware queue 0) serves queue 0.
+ */
+XEmacPs_BdRing *emacps_txring(xemacpsif_s *xemacpsif, u32_t queue)
+{
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	if ((queue == 0) && (xemacpsif->num_queues > 1)) {
+		return &xemacpsif->bulk_tx_ring;
+	}
+#endif
+	return &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+}
+
+XEmacPs_BdRing *emacps_rxring(xemacpsif_s *xemacpsif, u32_t queue)
+{
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	if (queue != 0) {
+		return &xemacpsif->prio_rx_ring;
+	}
+#endif
+	return &XEmacPs_GetRxRing(&xemacpsif->emacps);
+}
+
+pq_queue_t *emacps_recv_q(xemacpsif_s *xemacpsif, u32_t queue)
+{
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	if (queue != 0) {
+		return xemacpsif->prio_recv_q;
+	}
+#endif
+	return xemacpsif->recv_q;
+}
+
+static inline u32_t txring_queue(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
+{
+	if (txring == &(XEmacPs_GetTxRing(&xemacpsif->emacps))) {
+		return xemacpsif->num_queues - 1;
+	}
+	return 0;
+}
+
+static inline u32_t rxring_queue(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
+{
+	if (rxring == &XEmacPs_GetRxRing(&xemacpsif->emacps)) {
+		return 0;
+	}
+	return 1;
+}
+
+s32_t is_tx_space_available(xemacpsif_s *emac, u32_t queue)
 {
 	XEmacPs_BdRing *txring;
 	s32_t freecnt = 0;
 
-	txring = &(XEmacPs_GetTxRing(&emac->emacps));
+	txring = emacps_txring(emac, queue);
 
 	/* tx space is available as long as there are valid BD's */
 	freecnt = XEmacPs_BdRingGetFreeCnt(txring);
@@ -191,6 +249,68 @@ u32_t get_base_index_rxpbufsstorage (xemacpsif_s *xemacpsif)
 	return index;
 }
 
+#if LWIP_STATS
+#ifdef XEMACPSIF_QSTATS_TIME
+static inline XTime emacps_qstats_now(void)
+{
+	XTime now;
+
+	XTime_GetTime(&now);
+	return now;
+}
+
+static void emacps_qstats_latency(u64_t *sum, u32_t *max, XTime stamp)
+{
+	u32_t lat = (u32_t)(emacps_qstats_now() - stamp);
+
+	*sum += lat;
+	if (lat > *max) {
+		*max = lat;
+	}
+}
+#endif
+
+/* Account a frame put in the receive q of a queue */
+static void emacps_rx_queued(xemacpsif_s *xemacpsif, u32_t queue)
+{
+	struct xemacpsif_qstats *qs = &xemacpsif->qstats[queue];
+	u32_t backlog = (u32_t)pq_qlength(emacps_recv_q(xemacpsif, queue));
+#ifdef XEMACPSIF_QSTATS_TIME
+	u32_t seq = xemacpsif->rx_enq_seq[queue]++;
+	u32_t slot = seq % XLWIP_CONFIG_N_RX_DESC;
+
+	/* Only the oldest XLWIP_CONFIG_N_RX_DESC waiting frames are timed */
+	if ((seq - xemacpsif->rx_deq_seq[queue]) < XLWIP_CONFIG_N_RX_DESC) {
+		xemacpsif->rx_stamp[queue][slot] = emacps_qstats_now();
+		xemacpsif->rx_stamp_seq[queue][slot] = seq;
+	}
+#endif
+
+	qs->rx_frames++;
+	if (backlog > qs->rx_backlog_max) {
+		qs->rx_backlog_max = backlog;
+	}
+}
+
+/* Account a frame of a queue handed to lwIP */
+void emacps_rx_delivered(xemacpsif_s *xemacpsif, u32_t queue)
+{
+#ifdef XEMACPSIF_QSTATS_TIME
+	struct xemacpsif_qstats *qs = &xemacpsif->qstats[queue];
+	u32_t seq = xemacpsif->rx_deq_seq[queue]++;
+	u32_t slot = seq % XLWIP_CONFIG_N_RX_DESC;
+
+	if (xemacpsif->rx_stamp_seq[queue][slot] == seq) {
+		emacps_qstats_latency(&qs->rx_lat_sum, &qs->rx_lat_max,
+					xemacpsif->rx_stamp[queue][slot]);
+	}
+#else
+	(void)xemacpsif;
+	(void)queue;
+#endif
+}
+#endif
+
 void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 {
 	XEmacPs_Bd *txbdset;
@@ -202,8 +322,11 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 	struct pbuf *p;
 	u32 *temp;
 	u32_t index;
+	u32_t queue;
 
-	index = get_base_index_txpbufsstorage (xemacpsif);
+	queue = txring_queue(xemacpsif, txring);
+	index = get_base_index_txpbufsstorage (xemacpsif) +
+					(queue * XEMACPSIF_TX_QUEUE_STORAGE);
 
 	while (1) {
 		/* obtain processed BD's */
@@ -230,6 +353,15 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 			if (p != NULL) {
 				pbuf_free(p);
 			}
+#if LWIP_STATS && defined(XEMACPSIF_QSTATS_TIME)
+			/* the last BD of each frame holds its submit time */
+			if (xemacpsif->tx_stamp[queue][bdindex] != 0) {
+				emacps_qstats_latency(&xemacpsif->qstats[queue].tx_lat_sum,
+					&xemacpsif->qstats[queue].tx_lat_max,
+					xemacpsif->tx_stamp[queue][bdindex]);
+				xemacpsif->tx_stamp[queue][bdindex] = 0;
+			}
+#endif
 			tx_pbufs_storage[index + bdindex] = 0;
 			curbdpntr = XEmacPs_BdRingNext(txring, curbdpntr);
 			n_pbufs_freed--;
@@ -248,25 +380,26 @@ void emacps_send_handler(void *arg)
 {
 	struct xemac_s *xemac;
 	xemacpsif_s   *xemacpsif;
-	XEmacPs_BdRing *txringptr;
 	u32_t regval;
+	u32_t queue;
 #ifdef OS_IS_FREERTOS
 	xInsideISR++;
 #endif
 	xemac = (struct xemac_s *)(arg);
 	xemacpsif = (xemacpsif_s *)(xemac->state);
-	txringptr = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
 	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_TXSR_OFFSET);
 	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,XEMACPS_TXSR_OFFSET, regval);
 
 	/* If Transmit done interrupt is asserted, process completed BD's */
-	process_sent_bds(xemacpsif, txringptr);
+	for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+		process_sent_bds(xemacpsif, emacps_txring(xemacpsif, queue));
+	}
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
 #endif
 }
 
-XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
+XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p, u32_t queue)
 {
 	struct pbuf *q;
 	s32_t n_pbufs;
@@ -282,9 +415,10 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 	lev = mfcpsr();
 	mtcpsr(lev | 0x000000C0);
 
-	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+	txring = emacps_txring(xemacpsif, queue);
 
-	index = get_base_index_txpbufsstorage (xemacpsif);
+	index = get_base_index_txpbufsstorage (xemacpsif) +
+					(queue * XEMACPSIF_TX_QUEUE_STORAGE);
 
 	/* first count the number of pbufs */
 	for (q = p, n_pbufs = 0; q != NULL; q = q->next)
@@ -355,6 +489,16 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 		LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: Error submitting TxBD\r\n"));
 		return XST_FAILURE;
 	}
+#if LWIP_STATS
+	xemacpsif->qstats[queue].tx_frames++;
+	if ((txring->AllCnt - txring->FreeCnt) > xemacpsif->qstats[queue].tx_bds_max) {
+		xemacpsif->qstats[queue].tx_bds_max = txring->AllCnt - txring->FreeCnt;
+	}
+#ifdef XEMACPSIF_QSTATS_TIME
+	xemacpsif->tx_stamp[queue][XEMACPS_BD_TO_INDEX(txring, last_txbd)] =
+							emacps_qstats_now();
+#endif
+#endif
 	/* Start transmit */
 	XEmacPs_WriteReg((xemacpsif->emacps).Config.BaseAddress,
 	XEMACPS_NWCTRL_OFFSET,
@@ -375,7 +519,8 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 	u32 *temp;
 	u32_t index;
 
-	index = get_base_index_rxpbufsstorage (xemacpsif);
+	index = get_base_index_rxpbufsstorage (xemacpsif) +
+			(rxring_queue(xemacpsif, rxring) * XEMACPSIF_RX_QUEUE_STORAGE);
 
 	freebds = XEmacPs_BdRingGetFreeCnt (rxring);
 	while (freebds > 0) {
@@ -438,30 +583,224 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 	}
 }
 
-void emacps_recv_handler(void *arg)
+#if LWIP_FULL_CSUM_OFFLOAD_RX
+/* TCP or UDP checksum, with pseudo header, of a packet held in one pbuf */
+static s32_t emacps_l4_csum_ok(const u8_t *addrs, u16_t addrlen, u8_t proto,
+						const u8_t *l4, u16_t l4len)
+{
+	u32_t acc;
+
+	acc = (u16_t)~inet_chksum(addrs, addrlen);
+	acc += (u16_t)~inet_chksum(l4, l4len);
+	acc += lwip_htons((u16_t)proto);
+	acc += lwip_htons(l4len);
+	acc = FOLD_U32T(acc);
+	acc = FOLD_U32T(acc);
+
+	return (acc == 0xFFFF);
+}
+
+/*
+ * With receive checksum offload the GEM discards frames with bad IP, TCP
+ * or UDP checksums and lwIP does not check them again. The BD tells which
+ * checksums were verified: the ones left out, such as those of IPv6
+ * packets with hop-by-hop, routing or destination options headers, are
+ * verified here instead. Fragments and frames spread over several pbufs
+ * are passed on unchecked. Returns 0 for a frame to drop.
+ */
+static s32_t emacps_rx_csum_ok(struct pbuf *p, u32_t csstat)
+{
+	const u8_t *frame = (const u8_t *)p->payload;
+	u16_t len = p->len;
+	u16_t off = 12;
+	u16_t ethtype, hlen, iplen;
+	u8_t proto;
+
+	if ((csstat == XEMACPS_RXBUF_CSSTAT_TCP) ||
+		(csstat == XEMACPS_RXBUF_CSSTAT_UDP) || (p->next != NULL) ||
+		(len < 14)) {
+		return 1;
+	}
+
+	ethtype = (u16_t)((frame[off] << 8) | frame[off + 1]);
+	if ((ethtype == ETHTYPE_VLAN) && (len >= 18)) {
+		off += 4;
+		ethtype = (u16_t)((frame[off] << 8) | frame[off + 1]);
+	}
+	off += 2;
+
+	if ((ethtype == ETHTYPE_IP) && (len >= (off + 20))) {
+		hlen = (frame[off] & 0xF) * 4;
+		iplen = (u16_t)((frame[off + 2] << 8) | frame[off + 3]);
+		proto = frame[off + 9];
+		if ((hlen < 20) || (iplen < hlen) || (len < (off + iplen))) {
+			return 0;
+		}
+		if ((csstat == XEMACPS_RXBUF_CSSTAT_NONE) &&
+			(inet_chksum(&frame[off], hlen) != 0)) {
+			return 0;
+		}
+		/* fragments and other protocols */
+		if ((((frame[off + 6] << 8) | frame[off + 7]) & 0x3FFF) ||
+			((proto != IP_PROTO_TCP) && (proto != IP_PROTO_UDP))) {
+			return 1;
+		}
+		/* UDP over IPv4 may come without checksum */
+		if ((proto == IP_PROTO_UDP) && (iplen >= (hlen + 8)) &&
+			(frame[off + hlen + 6] == 0) && (frame[off + hlen + 7] == 0)) {
+			return 1;
+		}
+		return emacps_l4_csum_ok(&frame[off + 12], 8, proto,
+				&frame[off + hlen], iplen - hlen);
+	}
+
+	if ((ethtype == ETHTYPE_IPV6) && (len >= (off + 40))) {
+		proto = frame[off + 6];
+		iplen = (u16_t)((frame[off + 4] << 8) | frame[off + 5]);
+		if (len < (off + 40 + iplen)) {
+			return 0;
+		}
+		/* skip the extension headers in front of TCP or UDP */
+		hlen = 40;
+		while ((proto == IP6_NEXTH_HOPBYHOP) ||
+			(proto == IP6_NEXTH_ROUTING) ||
+			(proto == IP6_NEXTH_DESTOPTS)) {
+			if ((40 + iplen) < (hlen + 8)) {
+				return 0;
+			}
+			proto = frame[off + hlen];
+			hlen += (frame[off + hlen + 1] + 1) * 8;
+			if ((40 + iplen) < hlen) {
+				return 0;
+			}
+		}
+		/* fragments and other protocols */
+		if ((proto != IP_PROTO_TCP) && (proto != IP_PROTO_UDP)) {
+			return 1;
+		}
+		return emacps_l4_csum_ok(&frame[off + 8], 32, proto,
+				&frame[off + hlen], 40 + iplen - hlen);
+	}
+
+	return 1;
+}
+#endif
+
+/*
+ * Process up to budget received BDs: hand their pbufs to the receive queue
+ * and give the BDs back to the hardware with fresh pbufs.
+ * Returns the number of BDs processed.
+ */
+static s32_t process_rx_bds(xemacpsif_s *xemacpsif, u32_t queue, s32_t budget)
 {
 	struct pbuf *p;
 	XEmacPs_Bd *rxbdset, *curbdptr;
-	struct xemac_s *xemac;
-	xemacpsif_s *xemacpsif;
 	XEmacPs_BdRing *rxring;
 	volatile s32_t bd_processed;
 	s32_t rx_bytes, k;
 	u32_t bdindex;
-	u32_t regval;
 	u32_t index;
+
+	rxring = emacps_rxring(xemacpsif, queue);
+	index = get_base_index_rxpbufsstorage (xemacpsif) +
+					(queue * XEMACPSIF_RX_QUEUE_STORAGE);
+
+	bd_processed = XEmacPs_BdRingFromHwRx(rxring, budget, &rxbdset);
+	if (bd_processed <= 0) {
+		return 0;
+	}
+
+	for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
+
+		bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
+		p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
+
+		/*
+		 * Adjust the buffer size to the actual number of bytes received.
+		 */
+#ifdef ZYNQMP_USE_JUMBO
+		rx_bytes = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, curbdptr);
+#else
+		rx_bytes = XEmacPs_BdGetLength(curbdptr);
+#endif
+		pbuf_realloc(p, rx_bytes);
+
+		/* Invalidate RX frame before queuing to handle
+		 * L1 cache prefetch conditions on any architecture.
+		 */
+		Xil_DCacheInvalidateRange((UINTPTR)p->payload, rx_bytes);
+
+#if LWIP_FULL_CSUM_OFFLOAD_RX
+		if (!emacps_rx_csum_ok(p, XEmacPs_BdGetRxCsumStatus(curbdptr))) {
+#if LINK_STATS
+			lwip_stats.link.chkerr++;
+			lwip_stats.link.drop++;
+#endif
+			pbuf_free(p);
+			curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
+			continue;
+		}
+#endif
+
+		/* store it in the receive queue,
+		 * where it'll be processed by a different handler
+		 */
+		if (pq_enqueue(emacps_recv_q(xemacpsif, queue), (void*)p) < 0) {
+#if LINK_STATS
+			lwip_stats.link.memerr++;
+			lwip_stats.link.drop++;
+#endif
+			EMACPS_RX_POLL_STATS_INC(xemacpsif, drop);
+			pbuf_free(p);
+		}
+#if LWIP_STATS
+		else {
+			emacps_rx_queued(xemacpsif, queue);
+		}
+#endif
+		curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
+	}
+	/* free up the BD's */
+	XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
+	setup_rx_bds(xemacpsif, rxring);
+
+	return bd_processed;
+}
+
+static void emacps_rx_intr_mask(xemacpsif_s *xemacpsif)
+{
+	XEmacPs_IntDisable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+	if (xemacpsif->num_queues > 1) {
+		XEmacPs_IntQ1Disable(&xemacpsif->emacps, XEMACPS_INTQ1SR_RXCOMPL_MASK);
+	}
+}
+
+static void emacps_rx_intr_unmask(xemacpsif_s *xemacpsif)
+{
+	XEmacPs_IntEnable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+	if (xemacpsif->num_queues > 1) {
+		XEmacPs_IntQ1Enable(&xemacpsif->emacps, XEMACPS_INTQ1SR_RXCOMPL_MASK);
+	}
+}
+
+void emacps_recv_handler(void *arg)
+{
+	struct xemac_s *xemac;
+	xemacpsif_s *xemacpsif;
+	u32_t regval;
 	u32_t gigeversion;
+#if !XLWIP_CONFIG_EMACPS_RX_POLL
+	u32_t queue;
+#endif
 
 	xemac = (struct xemac_s *)(arg);
 	xemacpsif = (xemacpsif_s *)(xemac->state);
-	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR++;
 #endif
 
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
-	index = get_base_index_rxpbufsstorage (xemacpsif);
 	/*
 	 * If Reception done interrupt is asserted, call RX call back function
 	 * to handle the processed BDs and then raise the according flag.
@@ -472,52 +811,27 @@ void emacps_recv_handler(void *arg)
 			resetrx_on_no_rxdata(xemacpsif);
 	}
 
-	while(1) {
-
-		bd_processed = XEmacPs_BdRingFromHwRx(rxring, XLWIP_CONFIG_N_RX_DESC, &rxbdset);
-		if (bd_processed <= 0) {
-			break;
-		}
-
-		for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
-
-			bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
-			p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
-
-			/*
-			 * Adjust the buffer size to the actual number of bytes received.
-			 */
-#ifdef ZYNQMP_USE_JUMBO
-			rx_bytes = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, curbdptr);
-#else
-			rx_bytes = XEmacPs_BdGetLength(curbdptr);
-#endif
-			pbuf_realloc(p, rx_bytes);
-
-			/* Invalidate RX frame before queuing to handle
-			 * L1 cache prefetch conditions on any architecture.
-			 */
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, rx_bytes);
-
-			/* store it in the receive queue,
-			 * where it'll be processed by a different handler
-			 */
-			if (pq_enqueue(xemacpsif->recv_q, (void*)p) < 0) {
-#if LINK_STATS
-				lwip_stats.link.memerr++;
-				lwip_stats.link.drop++;
+#if XLWIP_CONFIG_EMACPS_RX_POLL
+	/*
+	 * Polled receive: mask the RX interrupt and leave the ring to
+	 * emacps_rx_poll, which unmasks it once the rings are empty.
+	 */
+	emacps_rx_intr_mask(xemacpsif);
+	xemacpsif->rx_poll_pending = 1;
+#if !NO_SYS
+	sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
-				pbuf_free(p);
-			}
-			curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
-		}
-		/* free up the BD's */
-		XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
-		setup_rx_bds(xemacpsif, rxring);
+#else
+	/* Priority queue first */
+	for (queue = xemacpsif->num_queues; queue-- > 0; ) {
+		while (process_rx_bds(xemacpsif, queue,
+						XLWIP_CONFIG_N_RX_DESC) > 0) {
 #if !NO_SYS
-		sys_sem_signal(&xemac->sem_rx_data_available);
+			sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
+		}
 	}
+#endif
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
@@ -525,6 +839,56 @@ void emacps_recv_handler(void *arg)
 	return;
 }
 
+/*
+ * Polled receive, called from the input path with interrupts disabled.
+ * Processes at most budget received frames, priority queue first. If the
+ * budget is not used up, the RX rings are empty and the RX interrupts are
+ * unmasked again; otherwise they stay masked and rx_poll_pending stays set
+ * so that the caller polls again.
+ * Returns the number of frames processed.
+ */
+s32_t emacps_rx_poll(xemacpsif_s *xemacpsif, s32_t budget)
+{
+	XEmacPs_BdRing *rxring;
+	u32_t queue;
+	s32_t n, done = 0;
+
+	EMACPS_RX_POLL_STATS_INC(xemacpsif, polls);
+	for (queue = xemacpsif->num_queues; queue-- > 0; ) {
+		while (done < budget) {
+			n = process_rx_bds(xemacpsif, queue, budget - done);
+			if (n <= 0) {
+				break;
+			}
+			done += n;
+		}
+	}
+
+	if (done >= budget) {
+		EMACPS_RX_POLL_STATS_INC(xemacpsif, budget);
+		return done;
+	}
+
+	xemacpsif->rx_poll_pending = 0;
+	emacps_rx_intr_unmask(xemacpsif);
+
+	/*
+	 * A frame received after a ring was found empty but before the
+	 * interrupt was unmasked may not raise a new interrupt. Check the next
+	 * BD of each ring and keep polling if it has been filled in the meantime.
+	 */
+	for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+		rxring = emacps_rxring(xemacpsif, queue);
+		if ((rxring->HwCnt > 0) && (XEmacPs_BdIsRxNew(rxring->HwHead) != 0)) {
+			emacps_rx_intr_mask(xemacpsif);
+			xemacpsif->rx_poll_pending = 1;
+			break;
+		}
+	}
+
+	return done;
+}
+
 void clean_dma_txdescs(struct xemac_s *xemac)
 {
 	XEmacPs_Bd bdtemplate;
@@ -543,6 +907,18 @@ void clean_dma_txdescs(struct xemac_s *xemac)
 			(UINTPTR) xemacpsif->tx_bdspace, BD_ALIGNMENT,
 				 XLWIP_CONFIG_N_TX_DESC);
 	XEmacPs_BdRingClone(txringptr, &bdtemplate, XEMACPS_SEND);
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	if (xemacpsif->num_queues > 1) {
+		txringptr = &xemacpsif->bulk_tx_ring;
+		XEmacPs_BdRingCreate(txringptr, (UINTPTR) xemacpsif->bulk_tx_bdspace,
+				(UINTPTR) xemacpsif->bulk_tx_bdspace, BD_ALIGNMENT,
+					 XLWIP_CONFIG_N_TX_DESC);
+		XEmacPs_BdRingClone(txringptr, &bdtemplate, XEMACPS_SEND);
+	}
+#endif
+#if LWIP_STATS && defined(XEMACPSIF_QSTATS_TIME)
+	memset(xemacpsif->tx_stamp, 0, sizeof(xemacpsif->tx_stamp));
+#endif
 }
 
 XStatus init_dma(struct xemac_s *xemac)
@@ -607,6 +983,20 @@ XStatus init_dma(struct xemac_s *xemac)
 		bd_space_index += 0x10000;
 	}
 
+	xemacpsif->num_queues = 1;
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	/*
+	 * With priority queues in use, the 64k slots which otherwise hold
+	 * the terminate BDs of the unused queues hold their BD rings.
+	 */
+	if ((gigeversion > 2) &&
+		(XEmacPs_GetQueueCount(&xemacpsif->emacps) > 1)) {
+		xemacpsif->num_queues = 2;
+		xemacpsif->prio_rx_bdspace = (void *)bdrxterminate;
+		xemacpsif->bulk_tx_bdspace = (void *)bdtxterminate;
+	}
+#endif
+
 	LWIP_DEBUGF(NETIF_DEBUG, ("rx_bdspace: %p \r\n", xemacpsif->rx_bdspace));
 	LWIP_DEBUGF(NETIF_DEBUG, ("tx_bdspace: %p \r\n", xemacpsif->tx_bdspace));
 
@@ -722,6 +1112,45 @@ XStatus init_dma(struct xemac_s *xemac)
 	}else {
 		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 0, XEMACPS_SEND);
 	}
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	if (xemacpsif->num_queues > 1) {
+		/*
+		 * RX queue 1 takes the frames routed to it by the screeners and
+		 * TX queue 0 carries the bulk traffic, TX queue 1 having strict
+		 * priority over it.
+		 */
+		rxringptr = &xemacpsif->prio_rx_ring;
+		XEmacPs_BdClear(&bdtemplate);
+		status = XEmacPs_BdRingCreate(rxringptr, (UINTPTR) xemacpsif->prio_rx_bdspace,
+					(UINTPTR) xemacpsif->prio_rx_bdspace, BD_ALIGNMENT,
+					     XLWIP_CONFIG_N_RX_DESC);
+		if (status == XST_SUCCESS) {
+			status = XEmacPs_BdRingClone(rxringptr, &bdtemplate, XEMACPS_RECV);
+		}
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up priority RxBD space\r\n"));
+			return ERR_IF;
+		}
+		setup_rx_bds(xemacpsif, rxringptr);
+
+		txringptr = &xemacpsif->bulk_tx_ring;
+		XEmacPs_BdClear(&bdtemplate);
+		XEmacPs_BdSetStatus(&bdtemplate, XEMACPS_TXBUF_USED_MASK);
+		status = XEmacPs_BdRingCreate(txringptr, (UINTPTR) xemacpsif->bulk_tx_bdspace,
+					(UINTPTR) xemacpsif->bulk_tx_bdspace, BD_ALIGNMENT,
+					     XLWIP_CONFIG_N_TX_DESC);
+		if (status == XST_SUCCESS) {
+			status = XEmacPs_BdRingClone(txringptr, &bdtemplate, XEMACPS_SEND);
+		}
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up bulk TxBD space\r\n"));
+			return ERR_IF;
+		}
+
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->prio_rx_ring.BaseBdAddr, 1, XEMACPS_RECV);
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->bulk_tx_ring.BaseBdAddr, 0, XEMACPS_SEND);
+	} else
+#endif
 	if (gigeversion > 2)
 	{
 		/*
@@ -743,6 +1172,23 @@ XStatus init_dma(struct xemac_s *xemac)
 		XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_TXQBASE_OFFSET),
 				   (UINTPTR)bdtxterminate);
 	}
+	if (gigeversion > 2) {
+		/*
+		 * Hold off the RX interrupt for XLWIP_CONFIG_EMACPS_RX_INT_MOD
+		 * units of 800 ns after a frame is received, so that bursts
+		 * are taken with a single interrupt. 0 disables moderation.
+		 */
+		XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_INTMOD_OFFSET),
+				   (XLWIP_CONFIG_EMACPS_RX_INT_MOD & XEMACPS_INTMOD_RX_MASK));
+	}
+	xemacpsif->rx_poll_pending = 0;
+
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	/* The screeners are cleared by a reset of the controller */
+	if (emacps_apply_screens(xemacpsif) != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error programming the screeners\r\n"));
+	}
+#endif
 
 
 	/*
@@ -803,22 +1249,21 @@ void free_txrx_pbufs(xemacpsif_s *xemacpsif)
 	s32_t index;
 	s32_t index1;
 	struct pbuf *p;
+	u32_t queue;
 
-	index1 = get_base_index_txpbufsstorage (xemacpsif);
+	free_onlytx_pbufs(xemacpsif);
 
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
-		if (tx_pbufs_storage[index] != 0) {
-			p = (struct pbuf *)tx_pbufs_storage[index];
-			pbuf_free(p);
-			tx_pbufs_storage[index] = 0;
+	for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+		index1 = get_base_index_rxpbufsstorage (xemacpsif) +
+					(queue * XEMACPSIF_RX_QUEUE_STORAGE);
+		for (index = index1; index < (index1 + XLWIP_CONFIG_N_RX_DESC); index++) {
+			if (rx_pbufs_storage[index] != 0) {
+				p = (struct pbuf *)rx_pbufs_storage[index];
+				pbuf_free(p);
+				rx_pbufs_storage[index] = 0;
+			}
 		}
 	}
-
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
-		p = (struct pbuf *)rx_pbufs_storage[index];
-		pbuf_free(p);
-
-	}
 }
 
 void free_onlytx_pbufs(xemacpsif_s *xemacpsif)
@@ -826,13 +1271,17 @@ void free_onlytx_pbufs(xemacpsif_s *xemacpsif)
 	s32_t index;
 	s32_t index1;
 	struct pbuf *p;
-
-	index1 = get_base_index_txpbufsstorage (xemacpsif);
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
-		if (tx_pbufs_storage[index] != 0) {
-			p = (struct pbuf *)tx_pbufs_storage[index];
-			pbuf_free(p);
-			tx_pbufs_storage[index] = 0;
+	u32_t queue;
+
+	for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+		index1 = get_base_index_txpbufsstorage (xemacpsif) +
+					(queue * XEMACPSIF_TX_QUEUE_STORAGE);
+		for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
+			if (tx_pbufs_storage[index] != 0) {
+				p = (struct pbuf *)tx_pbufs_storage[index];
+				pbuf_free(p);
+				tx_pbufs_storage[index] = 0;
+			}
 		}
 	}
 }
@@ -858,8 +1307,160 @@ void reset_dma(struct xemac_s *xemac)
 
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, txqueuenum, XEMACPS_SEND);
+
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+	if (xemacpsif->num_queues > 1) {
+		XEmacPs_BdRingPtrReset(&xemacpsif->bulk_tx_ring, xemacpsif->bulk_tx_bdspace);
+		XEmacPs_BdRingPtrReset(&xemacpsif->prio_rx_ring, xemacpsif->prio_rx_bdspace);
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->prio_rx_ring.BaseBdAddr, 1, XEMACPS_RECV);
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->bulk_tx_ring.BaseBdAddr, 0, XEMACPS_SEND);
+	}
+#endif
+}
+
+#if XLWIP_CONFIG_EMACPS_NUM_QUEUES > 1
+/*
+ * Program the screeners from the rules added with xemacpsif_add_screen.
+ * Type 1 screeners match the DSCP or the UDP destination port, type 2
+ * screeners the VLAN priority or an EtherType. Unused screeners are
+ * disabled. Returns XST_FAILURE if the rules need more screeners of a
+ * type than the controller has.
+ */
+XStatus emacps_apply_screens(xemacpsif_s *xemacpsif)
+{
+	XEmacPs *emacps = &xemacpsif->emacps;
+	struct xemacpsif_screen *scr;
+	XStatus status = XST_SUCCESS;
+	u32_t t1 = 0, t2 = 0, etht = 0;
+	u32_t regval;
+	u32_t i;
+
+	if (xemacpsif->num_queues < 2) {
+		return (xemacpsif->n_screens == 0) ? XST_SUCCESS : XST_FAILURE;
+	}
+
+	for (i = 0; (i < xemacpsif->n_screens) && (status == XST_SUCCESS); i++) {
+		scr = &xemacpsif->screens[i];
+		regval = scr->queue & XEMACPS_SCREEN_QUEUE_MASK;
+		switch (scr->type) {
+		case XEMACPSIF_SCREEN_VLAN_PCP:
+			regval |= XEMACPS_SCREEN_T2_VLANEN_MASK |
+				(((u32_t)scr->value << XEMACPS_SCREEN_T2_VLANPRI_SHIFT) &
+					XEMACPS_SCREEN_T2_VLANPRI_MASK);
+			status = XEmacPs_SetScreenT2(emacps, (u8)t2++, regval);
+			break;
+		case XEMACPSIF_SCREEN_ETHTYPE:
+			status = XEmacPs_SetScreenEthType(emacps, (u8)etht, scr->value);
+			regval |= XEMACPS_SCREEN_T2_ETHEN_MASK |
+				((etht << XEMACPS_SCREEN_T2_ETHIDX_SHIFT) &
+					XEMACPS_SCREEN_T2_ETHIDX_MASK);
+			etht++;
+			if (status == XST_SUCCESS) {
+				status = XEmacPs_SetScreenT2(emacps, (u8)t2++, regval);
+			}
+			break;
+		case XEMACPSIF_SCREEN_DSCP:
+			/* The screener compares the whole TOS byte */
+			regval |= XEMACPS_SCREEN_T1_DSTCEN_MASK |
+				((((u32_t)scr->value << 2) << XEMACPS_SCREEN_T1_DSTC_SHIFT) &
+					XEMACPS_SCREEN_T1_DSTC_MASK);
+			status = XEmacPs_SetScreenT1(emacps, (u8)t1++, regval);
+			break;
+		case XEMACPSIF_SCREEN_UDP_PORT:
+			regval |= XEMACPS_SCREEN_T1_UDPEN_MASK |
+				(((u32_t)scr->value << XEMACPS_SCREEN_T1_UDP_SHIFT) &
+					XEMACPS_SCREEN_T1_UDP_MASK);
+			status = XEmacPs_SetScreenT1(emacps, (u8)t1++, regval);
+			break;
+		default:
+			status = XST_FAILURE;
+			break;
+		}
+	}
+	if (status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/* Disable the remaining screeners */
+	while (XEmacPs_SetScreenT1(emacps, (u8)t1++, 0) == XST_SUCCESS);
+	while (XEmacPs_SetScreenT2(emacps, (u8)t2++, 0) == XST_SUCCESS);
+
+	return XST_SUCCESS;
 }
 
+/*
+ * Select the TX queue of a frame with the screening rules, so that traffic
+ * received on the priority queue is also sent on it. Frames matching no
+ * rule go to queue 0. The DSCP is compared without the ECN bits, and UDP
+ * ports only in unfragmented packets and first fragments, since later
+ * fragments carry no UDP header.
+ */
+u32_t emacps_tx_queue(xemacpsif_s *xemacpsif, struct pbuf *p)
+{
+	struct xemacpsif_screen *scr;
+	u8_t *frame;
+	u16_t len, off, ethtype, fragoff;
+	u8_t tclass, nexth;
+	s32_t pcp = -1, dscp = -1, udpport = -1;
+	u32_t i;
+
+	if ((xemacpsif->num_queues < 2) || (xemacpsif->n_screens == 0)) {
+		return 0;
+	}
+
+	/* Only the headers in the first pbuf are looked at */
+	frame = (u8_t *)p->payload + ETH_PAD_SIZE;
+	len = p->len - ETH_PAD_SIZE;
+	if (len < 14) {
+		return 0;
+	}
+	off = 12;
+	ethtype = (u16_t)((frame[off] << 8) | frame[off + 1]);
+	if ((ethtype == 0x8100) && (len >= 18)) {
+		pcp = frame[off + 2] >> 5;
+		off += 4;
+		ethtype = (u16_t)((frame[off] << 8) | frame[off + 1]);
+	}
+	off += 2;
+
+	if ((ethtype == 0x0800) && (len >= (off + 20))) {
+		dscp = (frame[off + 1] & 0xFC) >> 2;
+		fragoff = (u16_t)(((frame[off + 6] & 0x1F) << 8) | frame[off + 7]);
+		if ((frame[off + 9] == 17) && (fragoff == 0) &&
+			(len >= (off + ((frame[off] & 0xF) * 4) + 4))) {
+			off += (frame[off] & 0xF) * 4;
+			udpport = (frame[off + 2] << 8) | frame[off + 3];
+		}
+	} else if ((ethtype == 0x86DD) && (len >= (off + 40))) {
+		tclass = (u8_t)(((frame[off] & 0xF) << 4) | (frame[off + 1] >> 4));
+		dscp = (tclass & 0xFC) >> 2;
+		nexth = frame[off + 6];
+		off += 40;
+		if ((nexth == 44) && (len >= (off + 8))) {
+			/* Fragment header, the offset is in the upper 13 bits */
+			fragoff = (u16_t)(((frame[off + 2] << 8) | frame[off + 3]) >> 3);
+			nexth = (fragoff == 0) ? frame[off] : 0;
+			off += 8;
+		}
+		if ((nexth == 17) && (len >= (off + 4))) {
+			udpport = (frame[off + 2] << 8) | frame[off + 3];
+		}
+	}
+
+	for (i = 0; i < xemacpsif->n_screens; i++) {
+		scr = &xemacpsif->screens[i];
+		if (((scr->type == XEMACPSIF_SCREEN_VLAN_PCP) && (pcp == scr->value)) ||
+			((scr->type == XEMACPSIF_SCREEN_DSCP) && (dscp == scr->value)) ||
+			((scr->type == XEMACPSIF_SCREEN_UDP_PORT) && (udpport == scr->value)) ||
+			((scr->type == XEMACPSIF_SCREEN_ETHTYPE) && (ethtype == scr->value))) {
+			return (scr->queue < xemacpsif->num_queues) ? scr->queue : 0;
+		}
+	}
+
+	return 0;
+}
+#endif
+
 void emac_disable_intr(void)
 {
 	XScuGic_DisableIntr(INTC_DIST_BASE_ADDR, emac_intr_num);
@@ -217,16 +217,13 @@ void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord)
 {
 	struct xemac_s *xemac;
 	xemacpsif_s   *xemacpsif;
-	XEmacPs_BdRing *rxring;
-	XEmacPs_BdRing *txring;
+	u32_t queue;
 #ifdef OS_IS_FREERTOS
 	xInsideISR++;
 #endif
 
 	xemac = (struct xemac_s *)(arg);
 	xemacpsif = (xemacpsif_s *)(xemac->state);
-	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
-	txring = &XEmacPs_GetTxRing(&xemacpsif->emacps);
 
 	if (ErrorWord != 0) {
 		switch (Direction) {
@@ -238,12 +235,16 @@ void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord)
 			if (ErrorWord & XEMACPS_RXSR_RXOVR_MASK) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("Receive over run\r\n"));
 				emacps_recv_handler(arg);
-				setup_rx_bds(xemacpsif, rxring);
+				for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+					setup_rx_bds(xemacpsif, emacps_rxring(xemacpsif, queue));
+				}
 			}
 			if (ErrorWord & XEMACPS_RXSR_BUFFNA_MASK) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("Receive buffer not available\r\n"));
 				emacps_recv_handler(arg);
-				setup_rx_bds(xemacpsif, rxring);
+				for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+					setup_rx_bds(xemacpsif, emacps_rxring(xemacpsif, queue));
+				}
 			}
 			break;
 			case XEMACPS_SEND:
@@ -265,7 +266,9 @@ void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord)
 			}
 			if (ErrorWord & XEMACPS_TXSR_FRAMERX_MASK) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("Transmit collision\r\n"));
-				process_sent_bds(xemacpsif, txring);
+				for (queue = 0; queue < xemacpsif->num_queues; queue++) {
+					process_sent_bds(xemacpsif, emacps_txring(xemacpsif, queue));
+				}
 			}
 			break;
 		}
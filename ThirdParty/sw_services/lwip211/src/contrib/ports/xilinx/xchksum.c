@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+/*
+ * Internet checksum used by lwIP through LWIP_CHKSUM (see arch/cc.h).
+ *
+ * Same result as lwip_standard_chksum: the one's complement sum of the
+ * buffer in host order, not inverted. Once the buffer is aligned the
+ * words are added into a 64 bit accumulator, which needs no carry
+ * handling in the loop, and on 64 bit ARM with NEON 16 bytes are added
+ * per instruction.
+ */
+
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/inet_chksum.h"
+
+#if defined (__aarch64__) && defined (__ARM_NEON)
+#define XCHKSUM_USE_NEON
+#endif
+
+#ifdef XCHKSUM_USE_NEON
+#include <arm_neon.h>
+
+/* 16 byte blocks summed before the 32 bit lanes could overflow */
+#define XCHKSUM_NEON_BLOCKS	0x8000
+#endif
+
+u16_t xil_chksum(const void *dataptr, int len)
+{
+	const u8_t *pb = (const u8_t *)dataptr;
+	const u16_t *ps;
+	const u32_t *pl;
+	u64_t acc = 0;
+	u32_t sum;
+	u16_t t = 0;
+	int odd = ((mem_ptr_t)pb & 1);
+
+	/* Get aligned to u16_t */
+	if (odd && (len > 0)) {
+		((u8_t *)&t)[1] = *pb++;
+		len--;
+	}
+
+	/* Get aligned to u32_t, then to 8 bytes */
+	ps = (const u16_t *)(const void *)pb;
+	if (((mem_ptr_t)ps & 3) && (len > 1)) {
+		acc += *ps++;
+		len -= 2;
+	}
+	pl = (const u32_t *)(const void *)ps;
+	if (((mem_ptr_t)pl & 7) && (len > 3)) {
+		acc += *pl++;
+		len -= 4;
+	}
+
+#ifdef XCHKSUM_USE_NEON
+	while (len > 15) {
+		uint32x4_t vacc = vdupq_n_u32(0);
+		int blocks = len >> 4;
+
+		if (blocks > XCHKSUM_NEON_BLOCKS) {
+			blocks = XCHKSUM_NEON_BLOCKS;
+		}
+		len -= blocks << 4;
+		while (blocks-- > 0) {
+			vacc = vpadalq_u16(vacc, vld1q_u16((const u16_t *)(const void *)pl));
+			pl += 4;
+		}
+		acc += vaddlvq_u32(vacc);
+	}
+#else
+	while (len > 15) {
+		acc += (u64_t)pl[0] + pl[1] + pl[2] + pl[3];
+		pl += 4;
+		len -= 16;
+	}
+#endif
+	while (len > 3) {
+		acc += *pl++;
+		len -= 4;
+	}
+
+	/* Fold the 64 bit accumulator to 32 bits */
+	acc = (acc & 0xFFFFFFFFU) + (acc >> 32);
+	acc = (acc & 0xFFFFFFFFU) + (acc >> 32);
+	sum = FOLD_U32T((u32_t)acc);
+	sum = FOLD_U32T(sum);
+
+	ps = (const u16_t *)(const void *)pl;
+	if (len > 1) {
+		sum += *ps++;
+		len -= 2;
+	}
+
+	/* Consume left-over byte, if any */
+	if (len > 0) {
+		((u8_t *)&t)[0] = *(const u8_t *)ps;
+	}
+
+	/* Add end bytes */
+	sum += t;
+
+	/* Fold 32-bit sum to 16 bits */
+	sum = FOLD_U32T(sum);
+	sum = FOLD_U32T(sum);
+
+	/* Swap if data started on an odd address */
+	if (odd) {
+		sum = SWAP_BYTES_IN_WORD(sum);
+	}
+
+	return (u16_t)sum;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ */
+
+/*
+ * Host check and benchmark of xil_chksum (contrib/ports/xilinx/xchksum.c)
+ * against lwip_standard_chksum from lwIP core.
+ *
+ * Usage: chksum_bench [bench]
+ *
+ * Without arguments the two routines are compared on random buffers for
+ * all start offsets 0-63 and lengths up to 140000 bytes, and on all-ones
+ * buffers large enough to reach the accumulator limits of the NEON loop,
+ * where a plain 64 bit sum is the reference.
+ * With "bench" the throughput of both is printed for a few frame sizes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lwip/opt.h"
+
+u16_t lwip_standard_chksum(const void *dataptr, int len);
+u16_t xil_chksum(const void *dataptr, int len);
+
+#define BUF_SIZE	(2 * 1024 * 1024)
+
+static u8_t buf[BUF_SIZE + 64] __attribute__ ((aligned(64)));
+
+/*
+ * Plain 64 bit sum of the 16 bit words in memory order. lwIP checksums at
+ * most 64 KB at a time and lwip_standard_chksum sums into 32 bits, which
+ * overflows on the large all-ones buffers, so those use this reference.
+ */
+static u16_t wide_chksum(const u8_t *p, int len)
+{
+	u64_t acc = 0;
+	u16_t w;
+	int i;
+
+	for (i = 0; i + 1 < len; i += 2) {
+		memcpy(&w, &p[i], 2);
+		acc += w;
+	}
+	if (len & 1) {
+		w = 0;
+		memcpy(&w, &p[len - 1], 1);
+		acc += w;
+	}
+	while (acc >> 16)
+		acc = (acc & 0xFFFF) + (acc >> 16);
+
+	return (u16_t)acc;
+}
+
+static int check(int off, int len)
+{
+	u16_t ref = (len <= 0x10000) ? lwip_standard_chksum(&buf[off], len) :
+			wide_chksum(&buf[off], len);
+	u16_t val = xil_chksum(&buf[off], len);
+
+	if (ref != val) {
+		printf("FAIL offset %d length %d: 0x%04x != 0x%04x\n",
+				off, len, val, ref);
+		return 1;
+	}
+	return 0;
+}
+
+static int run_checks(void)
+{
+	int fails = 0;
+	int off, len, i;
+
+	srand(1);
+	for (i = 0; i < BUF_SIZE + 64; i++)
+		buf[i] = (u8_t)rand();
+
+	for (off = 0; off < 64; off++) {
+		for (len = 0; len < 256; len++)
+			fails += check(off, len);
+		for (len = 256; len <= 140000; len += 997)
+			fails += check(off, len);
+	}
+
+	/* worst case for the 64 bit and the NEON lane accumulators */
+	memset(buf, 0xFF, sizeof(buf));
+	for (off = 0; off < 8; off++) {
+		fails += check(off, BUF_SIZE);
+		fails += check(off, BUF_SIZE - 1);
+		fails += check(off, 0x8000 * 16);
+		fails += check(off, 0x8000 * 16 + 17);
+	}
+
+	printf("chksum_bench: %s\n", fails ? "FAILED" : "all checksums match");
+	return fails ? 1 : 0;
+}
+
+static double now_s(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double rate(u16_t (*fn)(const void *, int), int len)
+{
+	volatile u16_t sink = 0;
+	long iters = (512L * 1024 * 1024) / len;
+	double t;
+	long i;
+
+	t = now_s();
+	for (i = 0; i < iters; i++)
+		sink += fn(&buf[(i & 7) * 2], len);
+	t = now_s() - t;
+	(void)sink;
+
+	return (double)iters * len / t / 1e9;
+}
+
+static void run_bench(void)
+{
+	static const int sizes[] = { 64, 576, 1500, 9000, 65536 };
+	unsigned int i;
+
+	for (i = 0; i < sizeof(buf); i++)
+		buf[i] = (u8_t)i;
+
+	printf("%8s %14s %14s\n", "bytes", "lwip GB/s", "xil GB/s");
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		printf("%8d %14.1f %14.1f\n", sizes[i],
+				rate(lwip_standard_chksum, sizes[i]),
+				rate(xil_chksum, sizes[i]));
+	}
+}
+
+int main(int argc, char **argv)
+{
+	if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+		run_bench();
+		return 0;
+	}
+	return run_checks();
+}
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ */
+
+
+/*
+ * Host test of the software RX checksum check of the emacps adapter
+ * (emacps_rx_csum_ok in xemacpsif_dma.c), which is built into this test
+ * with LWIP_FULL_CSUM_OFFLOAD_RX set. Frames are built by hand, given the
+ * BD checksum status the GEM would report, and checked for the expected
+ * accept or drop decision, before and after corrupting their payload.
+ */
+
+#define LWIP_FULL_CSUM_OFFLOAD_RX 1
+#include "../src/contrib/ports/xilinx/netif/xemacpsif_dma.c"
+
+#include <string.h>
+
+#define L4_TCP	6
+#define L4_UDP	17
+
+static u8_t frame[2048];
+static int fails;
+
+static u32_t sum16(const u8_t *p, int len, u32_t acc)
+{
+	int i;
+
+	for (i = 0; i + 1 < len; i += 2)
+		acc += (p[i] << 8) | p[i + 1];
+	if (len & 1)
+		acc += p[len - 1] << 8;
+	return acc;
+}
+
+static u16_t fold(u32_t acc)
+{
+	while (acc >> 16)
+		acc = (acc & 0xFFFF) + (acc >> 16);
+	return (u16_t)~acc;
+}
+
+/* TCP or UDP segment with a valid checksum at l4, pseudo header at addrs */
+static int put_l4(u8_t *l4, u8_t proto, int paylen, const u8_t *addrs,
+		int addrlen)
+{
+	int hlen = (proto == L4_TCP) ? 20 : 8;
+	int len = hlen + paylen;
+	int csoff = (proto == L4_TCP) ? 16 : 6;
+	u32_t acc;
+	u16_t cs;
+	int i;
+
+	memset(l4, 0, hlen);
+	l4[0] = 0x12; l4[1] = 0x34; l4[2] = 0x13; l4[3] = 0x89;
+	if (proto == L4_TCP) {
+		l4[12] = 5 << 4;
+	} else {
+		l4[4] = len >> 8;
+		l4[5] = len & 0xFF;
+	}
+	for (i = 0; i < paylen; i++)
+		l4[hlen + i] = (u8_t)(i * 7 + 3);
+
+	acc = sum16(addrs, addrlen, 0);
+	acc += proto;
+	acc += len;
+	acc = sum16(l4, len, acc);
+	cs = fold(acc);
+	l4[csoff] = cs >> 8;
+	l4[csoff + 1] = cs & 0xFF;
+
+	return len;
+}
+
+static int eth(u16_t type)
+{
+	memset(frame, 0, 12);
+	frame[0] = 0x02;
+	frame[6] = 0x02;
+	frame[12] = type >> 8;
+	frame[13] = type & 0xFF;
+	return 14;
+}
+
+static int ipv4(u8_t proto, int paylen, u16_t frag)
+{
+	int off = eth(0x0800);
+	u8_t *ip = &frame[off];
+	int len;
+	u16_t cs;
+
+	memset(ip, 0, 20);
+	ip[0] = 0x45;
+	ip[6] = frag >> 8;
+	ip[7] = frag & 0xFF;
+	ip[8] = 64;
+	ip[9] = proto;
+	ip[12] = 192; ip[13] = 168; ip[14] = 1; ip[15] = 10;
+	ip[16] = 192; ip[17] = 168; ip[18] = 1; ip[19] = 100;
+	len = 20 + put_l4(&ip[20], proto, paylen, &ip[12], 8);
+	ip[2] = len >> 8;
+	ip[3] = len & 0xFF;
+	cs = fold(sum16(ip, 20, 0));
+	ip[10] = cs >> 8;
+	ip[11] = cs & 0xFF;
+
+	return off + len;
+}
+
+/*
+ * IPv6 packet with the extension headers listed in exts, 0-terminated by
+ * EXT_END. Each extension header is 8 bytes, 16 for a routing header.
+ */
+#define EXT_END	0xFF
+
+static int ipv6(const u8_t *exts, u8_t proto, int paylen)
+{
+	int off = eth(0x86DD);
+	u8_t *ip = &frame[off];
+	u8_t *nh = &ip[6];
+	int hlen = 40;
+	int len, i;
+
+	memset(ip, 0, 40);
+	ip[0] = 0x60;
+	ip[7] = 64;
+	ip[8] = 0xFE; ip[9] = 0x80; ip[23] = 0x10;
+	ip[24] = 0xFE; ip[25] = 0x80; ip[39] = 0x20;
+
+	for (i = 0; exts[i] != EXT_END; i++) {
+		int elen = (exts[i] == IP6_NEXTH_ROUTING) ? 16 : 8;
+
+		*nh = exts[i];
+		memset(&ip[hlen], 0, elen);
+		ip[hlen + 1] = (elen / 8) - 1;
+		nh = &ip[hlen];
+		hlen += elen;
+	}
+	*nh = proto;
+
+	len = hlen - 40 + put_l4(&ip[hlen], proto, paylen, &ip[8], 32);
+	ip[4] = len >> 8;
+	ip[5] = len & 0xFF;
+
+	return off + 40 + len;
+}
+
+static void expect(const char *name, int len, u32_t csstat, int ok)
+{
+	struct pbuf p;
+	int got;
+
+	memset(&p, 0, sizeof(p));
+	p.payload = frame;
+	p.len = p.tot_len = len;
+	got = emacps_rx_csum_ok(&p, csstat) ? 1 : 0;
+	if (got != ok) {
+		printf("FAIL %s: %s, expected %s\n", name,
+				got ? "accepted" : "dropped",
+				ok ? "accepted" : "dropped");
+		fails++;
+	}
+}
+
+/* the frame as built must pass, with one payload byte flipped it must not */
+static void good_bad(const char *name, int len, u32_t csstat)
+{
+	expect(name, len, csstat, 1);
+	frame[len - 1] ^= 0x5A;
+	expect(name, len, csstat, 0);
+}
+
+int main(void)
+{
+	static const u8_t none[] = { EXT_END };
+	static const u8_t hbh[] = { IP6_NEXTH_HOPBYHOP, EXT_END };
+	static const u8_t hbh_rt_dst[] = { IP6_NEXTH_HOPBYHOP,
+		IP6_NEXTH_ROUTING, IP6_NEXTH_DESTOPTS, EXT_END };
+	static const u8_t frag[] = { IP6_NEXTH_FRAGMENT, EXT_END };
+	static const u8_t dst_frag[] = { IP6_NEXTH_DESTOPTS,
+		IP6_NEXTH_FRAGMENT, EXT_END };
+	int len;
+
+	len = ipv4(L4_TCP, 100, 0);
+	good_bad("ipv4 tcp", len, XEMACPS_RXBUF_CSSTAT_NONE);
+	len = ipv4(L4_UDP, 33, 0);
+	good_bad("ipv4 udp", len, XEMACPS_RXBUF_CSSTAT_IP);
+	len = ipv4(L4_TCP, 100, 0x2000);
+	frame[len - 1] ^= 0x5A;
+	expect("ipv4 fragment", len, XEMACPS_RXBUF_CSSTAT_IP, 1);
+
+	len = ipv6(none, L4_UDP, 64);
+	good_bad("ipv6 udp", len, XEMACPS_RXBUF_CSSTAT_NONE);
+	len = ipv6(hbh, L4_TCP, 200);
+	good_bad("ipv6 hop-by-hop tcp", len, XEMACPS_RXBUF_CSSTAT_NONE);
+	len = ipv6(hbh_rt_dst, L4_UDP, 51);
+	good_bad("ipv6 hop-by-hop routing dest-opts udp", len,
+			XEMACPS_RXBUF_CSSTAT_NONE);
+	len = ipv6(hbh_rt_dst, L4_TCP, 1000);
+	good_bad("ipv6 hop-by-hop routing dest-opts tcp", len,
+			XEMACPS_RXBUF_CSSTAT_NONE);
+
+	/* the MAC checked it: passed on without a software check */
+	len = ipv6(none, L4_TCP, 64);
+	frame[len - 1] ^= 0x5A;
+	expect("ipv6 tcp checked by the MAC", len,
+			XEMACPS_RXBUF_CSSTAT_TCP, 1);
+
+	/* fragments cannot be checked before reassembly */
+	len = ipv6(frag, L4_UDP, 64);
+	frame[len - 1] ^= 0x5A;
+	expect("ipv6 fragment", len, XEMACPS_RXBUF_CSSTAT_NONE, 1);
+	len = ipv6(dst_frag, L4_TCP, 64);
+	frame[len - 1] ^= 0x5A;
+	expect("ipv6 dest-opts fragment", len, XEMACPS_RXBUF_CSSTAT_NONE, 1);
+
+	/* an extension header running past the payload length */
+	len = ipv6(hbh, L4_UDP, 0);
+	frame[14 + 40 + 1] = 4;
+	expect("ipv6 truncated extension header", len,
+			XEMACPS_RXBUF_CSSTAT_NONE, 0);
+	len = ipv6(none, L4_UDP, 0);
+	frame[14 + 6] = IP6_NEXTH_DESTOPTS;
+	frame[14 + 5] = 4;
+	expect("ipv6 payload shorter than an extension header",
+			14 + 44, XEMACPS_RXBUF_CSSTAT_NONE, 0);
+
+	/* the frame is shorter than its IPv6 payload length */
+	len = ipv6(hbh, L4_TCP, 40);
+	expect("ipv6 short frame", len - 1, XEMACPS_RXBUF_CSSTAT_NONE, 0);
+
+	printf("rx_csum_test: %s\n", fails ? "FAILED" : "passed");
+	return fails ? 1 : 0;
+}
@@ -0,0 +1,41 @@
+/* Host replacement of contrib/ports/xilinx/include/arch/cc.h */
+#ifndef __ARCH_CC_H__
+#define __ARCH_CC_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "lwipopts.h"
+
+#define LWIP_TIMEVAL_PRIVATE 0
+#include <sys/time.h>
+
+#define LWIP_NO_STDINT_H 1
+
+typedef uint8_t  u8_t;
+typedef int8_t   s8_t;
+typedef uint16_t u16_t;
+typedef int16_t  s16_t;
+typedef uint32_t u32_t;
+typedef int32_t  s32_t;
+typedef uint64_t u64_t;
+typedef int64_t  s64_t;
+typedef uintptr_t mem_ptr_t;
+
+#define S16_F "d"
+#define U16_F "d"
+#define S32_F "d"
+#define U32_F "x"
+#define X16_F "x"
+#define X32_F "x"
+
+#define PACK_STRUCT_FIELD(x) x
+#define PACK_STRUCT_STRUCT __attribute__((packed))
+#define PACK_STRUCT_BEGIN
+#define PACK_STRUCT_END
+
+#define LWIP_PLATFORM_ASSERT(x)
+#define LWIP_PLATFORM_DIAG(x) do { printf x; } while(0)
+
+#endif /* __ARCH_CC_H__ */
@@ -0,0 +1,12 @@
+/* Host lwipopts.h for the lwip211 port tests */
+#ifndef __LWIPOPTS_H_
+#define __LWIPOPTS_H_
+
+#define NO_SYS 1
+#define LWIP_IPV4 1
+#define LWIP_IPV6 1
+#define LWIP_NETCONN 0
+#define LWIP_SOCKET 0
+#define LWIP_STATS 0
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * Scalar model of the NEON intrinsics used by xchksum.c, so that its NEON
+ * loop can be built and checked on a host without an AArch64 toolchain.
+ * Lane arithmetic wraps exactly as on the hardware.
+ */
+#ifndef ARM_NEON_MODEL_H
+#define ARM_NEON_MODEL_H
+
+#include <stdint.h>
+
+typedef struct { uint16_t v[8]; } uint16x8_t;
+typedef struct { uint32_t v[4]; } uint32x4_t;
+
+static inline uint32x4_t vdupq_n_u32(uint32_t x)
+{
+	uint32x4_t r = {{ x, x, x, x }};
+	return r;
+}
+
+static inline uint16x8_t vld1q_u16(const uint16_t *p)
+{
+	uint16x8_t r;
+	int i;
+
+	for (i = 0; i < 8; i++)
+		r.v[i] = p[i];
+	return r;
+}
+
+/* pairwise add of the 16 bit lanes, accumulated into the 32 bit lanes */
+static inline uint32x4_t vpadalq_u16(uint32x4_t a, uint16x8_t b)
+{
+	int i;
+
+	for (i = 0; i < 4; i++)
+		a.v[i] += (uint32_t)b.v[2 * i] + b.v[2 * i + 1];
+	return a;
+}
+
+static inline uint64_t vaddlvq_u32(uint32x4_t a)
+{
+	return (uint64_t)a.v[0] + a.v[1] + a.v[2] + a.v[3];
+}
+
+#endif
@@ -0,0 +1,11 @@
+/* Host stand-in for the BSP xil_exception.h */
+#ifndef XIL_EXCEPTION_H
+#define XIL_EXCEPTION_H
+
+typedef void (*Xil_ExceptionHandler)(void *data);
+typedef void (*Xil_InterruptHandler)(void *data);
+
+#define Xil_ExceptionEnable()
+#define Xil_ExceptionDisable()
+
+#endif
@@ -0,0 +1,4 @@
+/* Host stand-in for the generated xparameters.h */
+#define XPAR_SCUGIC_0_CPU_BASEADDR	0xF9001000U
+#define XPAR_SCUGIC_0_DIST_BASEADDR	0xF9000000U
+#define XPAR_XEMACPS_0_BASEADDR		0xFF0B0000U
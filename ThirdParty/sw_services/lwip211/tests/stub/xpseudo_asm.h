@@ -0,0 +1,10 @@
+/* Host stand-in for the BSP xpseudo_asm.h */
+#ifndef XPSEUDO_ASM_H
+#define XPSEUDO_ASM_H
+
+#define dsb()
+#define isb()
+#define mfcpsr()	0U
+#define mtcpsr(v)	((void)(v))
+
+#endif
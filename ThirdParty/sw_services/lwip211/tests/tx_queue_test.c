@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ */
+
+/*
+ * Host test of the TX queue selection of the emacps adapter
+ * (emacps_tx_queue in xemacpsif_dma.c), built into this test with two
+ * queues. Frames are built by hand and classified against a DSCP, a UDP
+ * port and a VLAN priority rule: ECN bits must not change the DSCP match,
+ * and only unfragmented packets and first fragments may match on their UDP
+ * port, since later fragments carry payload where the UDP header would be.
+ */
+
+#define XLWIP_CONFIG_EMACPS_NUM_QUEUES 2
+#include "../src/contrib/ports/xilinx/netif/xemacpsif_dma.c"
+
+#include <string.h>
+
+#define DSCP_EF		46
+#define UDP_PORT	5001
+#define OTHER_PORT	7
+
+static u8_t frame[256];
+static xemacpsif_s emac;
+static int fails;
+
+static int eth(u16_t type, int vlan_pcp)
+{
+	int off = 12;
+
+	memset(frame, 0, sizeof(frame));
+	frame[0] = 0x02;
+	frame[6] = 0x02;
+	if (vlan_pcp >= 0) {
+		frame[off++] = 0x81;
+		frame[off++] = 0x00;
+		frame[off++] = (u8_t)(vlan_pcp << 5);
+		frame[off++] = 0x01;
+	}
+	frame[off++] = type >> 8;
+	frame[off++] = type & 0xFF;
+	return off;
+}
+
+/* UDP header with the port as destination, then a payload of paylen */
+static int udp(u8_t *l4, u16_t port, int paylen)
+{
+	l4[0] = 0x30; l4[1] = 0x39;
+	l4[2] = port >> 8;
+	l4[3] = port & 0xFF;
+	l4[4] = (8 + paylen) >> 8;
+	l4[5] = (8 + paylen) & 0xFF;
+	/* payload that looks like a UDP header to the priority port */
+	if (paylen >= 4) {
+		l4[8 + 2] = UDP_PORT >> 8;
+		l4[8 + 3] = UDP_PORT & 0xFF;
+	}
+	return 8 + paylen;
+}
+
+/*
+ * IPv4 UDP packet. frag is the flags and fragment offset field. A later
+ * fragment starts with payload, built here to hold the priority port where
+ * the UDP destination port would be.
+ */
+static int ipv4(u8_t tos, u16_t port, u16_t frag, int vlan_pcp)
+{
+	int off = eth(0x0800, vlan_pcp);
+	u8_t *ip = &frame[off];
+	int len;
+
+	ip[0] = 0x45;
+	ip[1] = tos;
+	ip[6] = frag >> 8;
+	ip[7] = frag & 0xFF;
+	ip[8] = 64;
+	ip[9] = 17;
+	if ((frag & 0x1FFF) != 0) {
+		ip[20 + 2] = UDP_PORT >> 8;
+		ip[20 + 3] = UDP_PORT & 0xFF;
+		len = 20 + 32;
+	} else {
+		len = 20 + udp(&ip[20], port, 32);
+	}
+	ip[2] = len >> 8;
+	ip[3] = len & 0xFF;
+	return off + len;
+}
+
+/*
+ * IPv6 UDP packet with traffic class tclass, with a fragment header if
+ * fragoff is not negative. fragoff is in 8 byte units.
+ */
+static int ipv6(u8_t tclass, u16_t port, int fragoff)
+{
+	int off = eth(0x86DD, -1);
+	u8_t *ip = &frame[off];
+	int hlen = 40;
+	int len;
+
+	ip[0] = 0x60 | (tclass >> 4);
+	ip[1] = (u8_t)(tclass << 4);
+	ip[6] = 17;
+	ip[7] = 64;
+	if (fragoff >= 0) {
+		ip[6] = 44;
+		ip[40] = 17;
+		ip[42] = (u8_t)((fragoff << 3) >> 8);
+		ip[43] = (u8_t)((fragoff << 3) & 0xF8) | 1;
+		hlen += 8;
+	}
+	if (fragoff > 0) {
+		ip[hlen + 2] = UDP_PORT >> 8;
+		ip[hlen + 3] = UDP_PORT & 0xFF;
+		len = hlen - 40 + 32;
+	} else {
+		len = hlen - 40 + udp(&ip[hlen], port, 32);
+	}
+	ip[4] = len >> 8;
+	ip[5] = len & 0xFF;
+	return off + 40 + len;
+}
+
+static void expect(const char *name, int len, u32_t queue)
+{
+	struct pbuf p;
+	u32_t got;
+
+	memset(&p, 0, sizeof(p));
+	p.payload = frame;
+	p.len = p.tot_len = len;
+	got = emacps_tx_queue(&emac, &p);
+	if (got != queue) {
+		printf("FAIL %s: queue %u, expected %u\n", name,
+				(unsigned)got, (unsigned)queue);
+		fails++;
+	}
+}
+
+static void rules(u8_t type, u16_t value)
+{
+	emac.num_queues = 2;
+	emac.n_screens = 1;
+	emac.screens[0].type = type;
+	emac.screens[0].queue = 1;
+	emac.screens[0].value = value;
+}
+
+int main(void)
+{
+	int len;
+
+	rules(XEMACPSIF_SCREEN_DSCP, DSCP_EF);
+	len = ipv4(DSCP_EF << 2, OTHER_PORT, 0, -1);
+	expect("ipv4 dscp", len, 1);
+	len = ipv4((DSCP_EF << 2) | 0x1, OTHER_PORT, 0, -1);
+	expect("ipv4 dscp ect(1)", len, 1);
+	len = ipv4((DSCP_EF << 2) | 0x3, OTHER_PORT, 0, -1);
+	expect("ipv4 dscp ce", len, 1);
+	len = ipv4(0x3, OTHER_PORT, 0, -1);
+	expect("ipv4 ce only", len, 0);
+	len = ipv4((DSCP_EF << 2) | 0x2, OTHER_PORT, 0x2040, -1);
+	expect("ipv4 dscp later fragment", len, 1);
+	len = ipv6((DSCP_EF << 2) | 0x3, OTHER_PORT, -1);
+	expect("ipv6 dscp ce", len, 1);
+	len = ipv6(0x3, OTHER_PORT, -1);
+	expect("ipv6 ce only", len, 0);
+
+	rules(XEMACPSIF_SCREEN_UDP_PORT, UDP_PORT);
+	len = ipv4(0, UDP_PORT, 0, -1);
+	expect("ipv4 udp", len, 1);
+	len = ipv4(0, OTHER_PORT, 0, -1);
+	expect("ipv4 other udp port", len, 0);
+	len = ipv4(0, UDP_PORT, 0x2000, -1);
+	expect("ipv4 udp first fragment", len, 1);
+	len = ipv4(0, OTHER_PORT, 0x2000, -1);
+	expect("ipv4 other port first fragment", len, 0);
+	len = ipv4(0, UDP_PORT, 0x2004, -1);
+	expect("ipv4 udp middle fragment", len, 0);
+	len = ipv4(0, UDP_PORT, 0x0004, -1);
+	expect("ipv4 udp last fragment", len, 0);
+	len = ipv4(0, UDP_PORT, 0x4000, -1);
+	expect("ipv4 udp don't fragment", len, 1);
+	len = ipv4(0, UDP_PORT, 0, 5);
+	expect("ipv4 udp in a vlan", len, 1);
+	len = ipv6(0, UDP_PORT, -1);
+	expect("ipv6 udp", len, 1);
+	len = ipv6(0, UDP_PORT, 0);
+	expect("ipv6 udp first fragment", len, 1);
+	len = ipv6(0, OTHER_PORT, 0);
+	expect("ipv6 other port first fragment", len, 0);
+	len = ipv6(0, UDP_PORT, 4);
+	expect("ipv6 udp later fragment", len, 0);
+
+	/* the port of a first fragment is read from the first pbuf only */
+	len = ipv4(0, UDP_PORT, 0, -1);
+	expect("ipv4 udp header cut off", 14 + 20 + 2, 0);
+
+	rules(XEMACPSIF_SCREEN_VLAN_PCP, 5);
+	len = ipv4(0, UDP_PORT, 0x0004, 5);
+	expect("vlan pcp later fragment", len, 1);
+	len = ipv4(0, UDP_PORT, 0, 3);
+	expect("other vlan pcp", len, 0);
+
+	printf("tx_queue_test: %s\n", fails ? "FAILED" : "passed");
+	return fails ? 1 : 0;
+}
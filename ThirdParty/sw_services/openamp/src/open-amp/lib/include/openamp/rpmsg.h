@@ -12,6 +12,7 @@
 #ifndef _RPMSG_H_
 #define _RPMSG_H_
 
+#include <metal/atomic.h>
 #include <metal/compiler.h>
 #include <metal/mutex.h>
 #include <metal/list.h>
@@ -26,7 +27,13 @@ extern "C" {
 
 /* Configurable parameters */
 #define RPMSG_NAME_SIZE		(32)
+#ifndef RPMSG_ADDR_BMP_SIZE
 #define RPMSG_ADDR_BMP_SIZE	(128)
+#endif
+/* Buckets of the endpoint address hash table, a power of 2 */
+#ifndef RPMSG_EPT_HASH_SIZE
+#define RPMSG_EPT_HASH_SIZE	(32)
+#endif
 
 #define RPMSG_NS_EPT_ADDR	(0x35)
 #define RPMSG_ADDR_ANY		0xFFFFFFFF
@@ -45,6 +52,18 @@ extern "C" {
 struct rpmsg_endpoint;
 struct rpmsg_device;
 
+/*
+ * Link of the endpoint address hash table, read by the lock-free RX lookup
+ * with atomic_load_explicit(). It is an atomic object when the compiler
+ * has C11 atomics, a plain pointer for the libmetal GCC atomics otherwise.
+ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && \
+	!defined(__STDC_NO_ATOMICS__) && !defined(__cplusplus)
+typedef struct rpmsg_endpoint *_Atomic rpmsg_ept_link;
+#else
+typedef struct rpmsg_endpoint *rpmsg_ept_link;
+#endif
+
 typedef int (*rpmsg_ept_cb)(struct rpmsg_endpoint *ept, void *data,
 			    size_t len, uint32_t src, void *priv);
 typedef void (*rpmsg_ns_unbind_cb)(struct rpmsg_endpoint *ept);
@@ -62,6 +81,7 @@ typedef void (*rpmsg_ns_bind_cb)(struct rpmsg_device *rdev,
  * @ns_unbind_cb: end point service unbind callback, called when remote
  *                ept is destroyed.
  * @node: end point node.
+ * @hash_next: next end point in the same address hash bucket.
  * @priv: private data for the driver's use
  *
  * In essence, an rpmsg endpoint represents a listener on the rpmsg bus, as
@@ -75,17 +95,46 @@ struct rpmsg_endpoint {
 	rpmsg_ept_cb cb;
 	rpmsg_ns_unbind_cb ns_unbind_cb;
 	struct metal_list node;
+	rpmsg_ept_link hash_next;
 	void *priv;
 };
 
+/**
+ * struct rpmsg_msg - message of a batch send
+ * @data: payload of the message
+ * @len: length of the payload
+ */
+struct rpmsg_msg {
+	const void *data;
+	int len;
+};
+
 /**
  * struct rpmsg_device_ops - RPMsg device operations
  * @send_offchannel_raw: send RPMsg data
+ * @hold_rx_buffer: hold RPMsg RX buffer
+ * @release_rx_buffer: release RPMsg RX buffer
+ * @get_tx_payload_buffer: get RPMsg TX buffer
+ * @release_tx_buffer: give back an unsent RPMsg TX buffer
+ * @send_offchannel_nocopy: send RPMsg data without copy
+ * @send_offchannel_batch: send several RPMsg messages with one notification
  */
 struct rpmsg_device_ops {
 	int (*send_offchannel_raw)(struct rpmsg_device *rdev,
 				   uint32_t src, uint32_t dst,
 				   const void *data, int size, int wait);
+	void (*hold_rx_buffer)(struct rpmsg_device *rdev, void *rxbuf);
+	void (*release_rx_buffer)(struct rpmsg_device *rdev, void *rxbuf);
+	void *(*get_tx_payload_buffer)(struct rpmsg_device *rdev,
+				       uint32_t *len, int wait);
+	void (*release_tx_buffer)(struct rpmsg_device *rdev, void *txbuf);
+	int (*send_offchannel_nocopy)(struct rpmsg_device *rdev,
+				      uint32_t src, uint32_t dst,
+				      const void *data, int len);
+	int (*send_offchannel_batch)(struct rpmsg_device *rdev,
+				     uint32_t src, uint32_t dst,
+				     const struct rpmsg_msg *msgs, int num,
+				     int wait);
 };
 
 /**
@@ -93,6 +142,8 @@ struct rpmsg_device_ops {
  * @endpoints: list of endpoints
  * @ns_ept: name service endpoint
  * @bitmap: table endpoint address allocation.
+ * @ept_hash: endpoints hashed by local address, for RX dispatch
+ * @rx_lookups: number of lock-free endpoint lookups in progress
  * @lock: mutex lock for rpmsg management
  * @ns_bind_cb: callback handler for name service announcement without local
  *              endpoints waiting to bind.
@@ -103,6 +154,8 @@ struct rpmsg_device {
 	struct metal_list endpoints;
 	struct rpmsg_endpoint ns_ept;
 	unsigned long bitmap[metal_bitmap_longs(RPMSG_ADDR_BMP_SIZE)];
+	rpmsg_ept_link ept_hash[RPMSG_EPT_HASH_SIZE];
+	atomic_int rx_lookups;
 	metal_mutex_t lock;
 	rpmsg_ns_bind_cb ns_bind_cb;
 	struct rpmsg_device_ops ops;
@@ -267,6 +320,180 @@ static inline int rpmsg_trysend_offchannel(struct rpmsg_endpoint *ept,
 	return rpmsg_send_offchannel_raw(ept, src, dst, data, len, false);
 }
 
+/**
+ * rpmsg_hold_rx_buffer() - hold an RX buffer beyond the endpoint callback
+ * @ept: the rpmsg endpoint
+ * @rxbuf: RX buffer with the payload, as passed to the callback
+ *
+ * Called from the endpoint callback, this keeps the RX buffer from being
+ * returned to the remote side when the callback returns, so the payload can
+ * be processed in place later. The buffer must be given back with
+ * rpmsg_release_rx_buffer(). While it is held the remote side has one RX
+ * buffer less to send with.
+ */
+void rpmsg_hold_rx_buffer(struct rpmsg_endpoint *ept, void *rxbuf);
+
+/**
+ * rpmsg_release_rx_buffer() - release a held RX buffer
+ * @ept: the rpmsg endpoint
+ * @rxbuf: RX buffer held with rpmsg_hold_rx_buffer()
+ *
+ * This function returns the RX buffer to the remote side.
+ */
+void rpmsg_release_rx_buffer(struct rpmsg_endpoint *ept, void *rxbuf);
+
+/**
+ * rpmsg_get_tx_payload_buffer() - get a TX buffer to fill in place
+ * @ept: the rpmsg endpoint
+ * @len: returns the size of the payload buffer
+ * @wait: wait for a buffer to become available if none is free
+ *
+ * This function reserves a TX buffer in shared memory and returns a
+ * pointer to its payload area, to be filled by the caller and sent with
+ * rpmsg_send_nocopy(), rpmsg_sendto_nocopy() or
+ * rpmsg_send_offchannel_nocopy(), or given back unsent with
+ * rpmsg_release_tx_buffer().
+ *
+ * Returns the payload buffer, or NULL if no buffer is available.
+ */
+void *rpmsg_get_tx_payload_buffer(struct rpmsg_endpoint *ept,
+				  uint32_t *len, int wait);
+
+/**
+ * rpmsg_release_tx_buffer() - give back an unsent TX buffer
+ * @ept: the rpmsg endpoint
+ * @txbuf: payload buffer returned by rpmsg_get_tx_payload_buffer()
+ *
+ * This function returns a TX buffer that will not be sent, for example
+ * when building the message failed, so that a later send can use it.
+ */
+void rpmsg_release_tx_buffer(struct rpmsg_endpoint *ept, void *txbuf);
+
+/**
+ * rpmsg_send_offchannel_nocopy() - send a message in a TX buffer, specifying
+ * source and destination address.
+ * @ept: the rpmsg endpoint
+ * @src: source address
+ * @dst: destination address
+ * @data: payload buffer returned by rpmsg_get_tx_payload_buffer()
+ * @len: length of the payload
+ *
+ * This function sends the @len bytes written in place in @data to the
+ * remote @dst address from the source @src address, without copying them.
+ * The buffer belongs to the remote side once sent.
+ *
+ * Returns number of bytes it has sent or negative error value on failure.
+ */
+int rpmsg_send_offchannel_nocopy(struct rpmsg_endpoint *ept, uint32_t src,
+				 uint32_t dst, const void *data, int len);
+
+/**
+ * rpmsg_sendto_nocopy() - send a message in a TX buffer, specify dst
+ * @ept: the rpmsg endpoint
+ * @data: payload buffer returned by rpmsg_get_tx_payload_buffer()
+ * @len: length of the payload
+ * @dst: destination address
+ *
+ * This function sends @data of length @len to the remote @dst address,
+ * using @ept's source address, without copying it.
+ *
+ * Returns number of bytes it has sent or negative error value on failure.
+ */
+static inline int rpmsg_sendto_nocopy(struct rpmsg_endpoint *ept,
+				      const void *data, int len, uint32_t dst)
+{
+	return rpmsg_send_offchannel_nocopy(ept, ept->addr, dst, data, len);
+}
+
+/**
+ * rpmsg_send_nocopy() - send a message in a TX buffer
+ * @ept: the rpmsg endpoint
+ * @data: payload buffer returned by rpmsg_get_tx_payload_buffer()
+ * @len: length of the payload
+ *
+ * This function sends @data of length @len based on the @ept, without
+ * copying it.
+ *
+ * Returns number of bytes it has sent or negative error value on failure.
+ */
+static inline int rpmsg_send_nocopy(struct rpmsg_endpoint *ept,
+				    const void *data, int len)
+{
+	if (ept->dest_addr == RPMSG_ADDR_ANY)
+		return RPMSG_ERR_ADDR;
+	return rpmsg_send_offchannel_nocopy(ept, ept->addr, ept->dest_addr,
+					    data, len);
+}
+
+/**
+ * rpmsg_send_offchannel_batch() - send several messages across to the remote
+ * processor, specifying source and destination address.
+ * @ept: the rpmsg endpoint
+ * @src: source address
+ * @dst: destination address
+ * @msgs: messages to send
+ * @num: number of messages
+ * @wait: wait for a buffer to become available if none is free
+ *
+ * This function sends the @num messages of @msgs, in order, to the remote
+ * @dst address from the source @src address. The messages are queued
+ * together and the remote side is notified once for all of them rather
+ * than once per message. If fewer TX buffers than messages are free, only
+ * the first messages are sent: @wait only applies while no buffer at all
+ * is available.
+ *
+ * Returns number of messages it has sent or negative error value if none
+ * was sent.
+ */
+int rpmsg_send_offchannel_batch(struct rpmsg_endpoint *ept, uint32_t src,
+				uint32_t dst, const struct rpmsg_msg *msgs,
+				int num, int wait);
+
+/**
+ * rpmsg_send_batch() - send several messages across to the remote processor
+ * @ept: the rpmsg endpoint
+ * @msgs: messages to send
+ * @num: number of messages
+ *
+ * This function sends the @num messages of @msgs based on the @ept,
+ * notifying the remote side once. If there are no TX buffers available,
+ * the function will block until one becomes available, or a timeout of
+ * 15 seconds elapses. When the latter happens, -ERESTARTSYS is returned.
+ *
+ * Returns number of messages it has sent or negative error value on failure.
+ */
+static inline int rpmsg_send_batch(struct rpmsg_endpoint *ept,
+				   const struct rpmsg_msg *msgs, int num)
+{
+	if (ept->dest_addr == RPMSG_ADDR_ANY)
+		return RPMSG_ERR_ADDR;
+	return rpmsg_send_offchannel_batch(ept, ept->addr, ept->dest_addr,
+					   msgs, num, true);
+}
+
+/**
+ * rpmsg_trysend_batch() - send several messages across to the remote
+ * processor
+ * @ept: the rpmsg endpoint
+ * @msgs: messages to send
+ * @num: number of messages
+ *
+ * This function sends the @num messages of @msgs based on the @ept,
+ * notifying the remote side once. If there are no TX buffers available,
+ * the function will immediately return -ENOMEM without waiting until one
+ * becomes available.
+ *
+ * Returns number of messages it has sent or negative error value on failure.
+ */
+static inline int rpmsg_trysend_batch(struct rpmsg_endpoint *ept,
+				      const struct rpmsg_msg *msgs, int num)
+{
+	if (ept->dest_addr == RPMSG_ADDR_ANY)
+		return RPMSG_ERR_ADDR;
+	return rpmsg_send_offchannel_batch(ept, ept->addr, ept->dest_addr,
+					   msgs, num, false);
+}
+
 /**
  * rpmsg_init_ept - initialize rpmsg endpoint
  *
@@ -332,6 +559,10 @@ int rpmsg_create_ept(struct rpmsg_endpoint *ept, struct rpmsg_device *rdev,
  *
  * It unregisters the rpmsg endpoint from the rpmsg device and calls the
  * destroy endpoint callback if it is provided.
+ *
+ * Messages are dispatched to the endpoint callback without the device lock,
+ * so the endpoint must not be destroyed from another thread while its
+ * callback may be running. Destroying it from its own callback is fine.
  */
 void rpmsg_destroy_ept(struct rpmsg_endpoint *ept);
 
@@ -44,7 +44,11 @@ extern "C" {
 /* Support for indirect buffer descriptors. */
 #define VIRTIO_RING_F_INDIRECT_DESC    (1 << 28)
 
-/* Support to suppress interrupt until specific index is reached. */
+/*
+ * Support to suppress interrupt until specific index is reached. Enabled
+ * by setting it in the device features of the resource table vdev entry:
+ * each side is then only notified once it has caught up with the other.
+ */
 #define VIRTIO_RING_F_EVENT_IDX        (1 << 29)
 
 struct virtqueue_buf {
@@ -83,6 +87,12 @@ struct virtqueue {
 	 */
 	uint16_t vq_available_idx;
 
+	/*
+	 * Set while callbacks are disabled. With VIRTIO_RING_F_EVENT_IDX
+	 * the ring flags are not used, so this is the only record of it.
+	 */
+	uint16_t vq_cb_disabled;
+
 #ifdef VQUEUE_DEBUG
 	bool vq_inuse;
 #endif
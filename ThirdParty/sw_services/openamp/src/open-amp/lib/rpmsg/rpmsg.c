@@ -9,6 +9,7 @@
 
 #include <openamp/rpmsg.h>
 #include <metal/alloc.h>
+#include <metal/cpu.h>
 
 #include "rpmsg_internal.h"
 
@@ -26,8 +27,16 @@ static uint32_t rpmsg_get_address(unsigned long *bitmap, int size)
 {
 	unsigned int addr = RPMSG_ADDR_ANY;
 	unsigned int nextbit;
+	unsigned int i;
 
-	nextbit = metal_bitmap_next_clear_bit(bitmap, 0, size);
+	/* Skip the words with all addresses taken */
+	for (i = 0; i < metal_bitmap_longs(size); i++) {
+		if (bitmap[i] != ~0UL)
+			break;
+	}
+
+	nextbit = metal_bitmap_next_clear_bit(bitmap, i * METAL_BITS_PER_ULONG,
+					      size);
 	if (nextbit < (uint32_t)size) {
 		addr = nextbit;
 		metal_bitmap_set_bit(bitmap, nextbit);
@@ -124,6 +133,97 @@ int rpmsg_send_offchannel_raw(struct rpmsg_endpoint *ept, uint32_t src,
 	return RPMSG_ERR_PARAM;
 }
 
+void rpmsg_hold_rx_buffer(struct rpmsg_endpoint *ept, void *rxbuf)
+{
+	struct rpmsg_device *rdev;
+
+	if (!ept || !ept->rdev || !rxbuf)
+		return;
+
+	rdev = ept->rdev;
+
+	if (rdev->ops.hold_rx_buffer)
+		rdev->ops.hold_rx_buffer(rdev, rxbuf);
+}
+
+void rpmsg_release_rx_buffer(struct rpmsg_endpoint *ept, void *rxbuf)
+{
+	struct rpmsg_device *rdev;
+
+	if (!ept || !ept->rdev || !rxbuf)
+		return;
+
+	rdev = ept->rdev;
+
+	if (rdev->ops.release_rx_buffer)
+		rdev->ops.release_rx_buffer(rdev, rxbuf);
+}
+
+void *rpmsg_get_tx_payload_buffer(struct rpmsg_endpoint *ept,
+				  uint32_t *len, int wait)
+{
+	struct rpmsg_device *rdev;
+
+	if (!ept || !ept->rdev || !len)
+		return NULL;
+
+	rdev = ept->rdev;
+
+	if (rdev->ops.get_tx_payload_buffer)
+		return rdev->ops.get_tx_payload_buffer(rdev, len, wait);
+
+	return NULL;
+}
+
+void rpmsg_release_tx_buffer(struct rpmsg_endpoint *ept, void *txbuf)
+{
+	struct rpmsg_device *rdev;
+
+	if (!ept || !ept->rdev || !txbuf)
+		return;
+
+	rdev = ept->rdev;
+
+	if (rdev->ops.release_tx_buffer)
+		rdev->ops.release_tx_buffer(rdev, txbuf);
+}
+
+int rpmsg_send_offchannel_nocopy(struct rpmsg_endpoint *ept, uint32_t src,
+				 uint32_t dst, const void *data, int len)
+{
+	struct rpmsg_device *rdev;
+
+	if (!ept || !ept->rdev || !data || dst == RPMSG_ADDR_ANY)
+		return RPMSG_ERR_PARAM;
+
+	rdev = ept->rdev;
+
+	if (rdev->ops.send_offchannel_nocopy)
+		return rdev->ops.send_offchannel_nocopy(rdev, src, dst,
+							data, len);
+
+	return RPMSG_ERR_PARAM;
+}
+
+int rpmsg_send_offchannel_batch(struct rpmsg_endpoint *ept, uint32_t src,
+				uint32_t dst, const struct rpmsg_msg *msgs,
+				int num, int wait)
+{
+	struct rpmsg_device *rdev;
+
+	if (!ept || !ept->rdev || !msgs || num <= 0 ||
+	    dst == RPMSG_ADDR_ANY)
+		return RPMSG_ERR_PARAM;
+
+	rdev = ept->rdev;
+
+	if (rdev->ops.send_offchannel_batch)
+		return rdev->ops.send_offchannel_batch(rdev, src, dst,
+						       msgs, num, wait);
+
+	return RPMSG_ERR_PARAM;
+}
+
 int rpmsg_send_ns_message(struct rpmsg_endpoint *ept, unsigned long flags)
 {
 	struct rpmsg_ns_msg ns_msg;
@@ -141,6 +241,33 @@ int rpmsg_send_ns_message(struct rpmsg_endpoint *ept, unsigned long flags)
 		return RPMSG_SUCCESS;
 }
 
+/**
+ * rpmsg_lookup_addr
+ *
+ * Finds the endpoint with the given local address in the address hash
+ * table. Safe against concurrent endpoint registration and removal.
+ *
+ * @param rdev - pointer to rpmsg device
+ * @param addr - local address of the endpoint
+ *
+ * return - pointer to the endpoint or NULL
+ */
+static struct rpmsg_endpoint *rpmsg_lookup_addr(struct rpmsg_device *rdev,
+						uint32_t addr)
+{
+	struct rpmsg_endpoint *ept;
+
+	/* pairs with the release stores of rpmsg_register_endpoint() */
+	ept = atomic_load_explicit(&rdev->ept_hash[addr &
+						   (RPMSG_EPT_HASH_SIZE - 1)],
+				   memory_order_acquire);
+	while (ept && ept->addr != addr)
+		ept = atomic_load_explicit(&ept->hash_next,
+					   memory_order_acquire);
+
+	return ept;
+}
+
 struct rpmsg_endpoint *rpmsg_get_endpoint(struct rpmsg_device *rdev,
 					  const char *name, uint32_t addr,
 					  uint32_t dest_addr)
@@ -148,13 +275,17 @@ struct rpmsg_endpoint *rpmsg_get_endpoint(struct rpmsg_device *rdev,
 	struct metal_list *node;
 	struct rpmsg_endpoint *ept;
 
+	/* try to get by local address only */
+	if (addr != RPMSG_ADDR_ANY) {
+		ept = rpmsg_lookup_addr(rdev, addr);
+		if (ept || !name)
+			return ept;
+	}
+
 	metal_list_for_each(&rdev->endpoints, node) {
 		int name_match = 0;
 
 		ept = metal_container_of(node, struct rpmsg_endpoint, node);
-		/* try to get by local address only */
-		if (addr != RPMSG_ADDR_ANY && ept->addr == addr)
-			return ept;
 		/* try to find match on local end remote address */
 		if (addr == ept->addr && dest_addr == ept->dest_addr)
 			return ept;
@@ -174,9 +305,40 @@ struct rpmsg_endpoint *rpmsg_get_endpoint(struct rpmsg_device *rdev,
 	return NULL;
 }
 
+struct rpmsg_endpoint *rpmsg_get_ept_from_addr(struct rpmsg_device *rdev,
+					       uint32_t addr)
+{
+	struct rpmsg_endpoint *ept;
+
+	/*
+	 * No lock: endpoints are published to the hash table only once
+	 * initialized, and rpmsg_destroy_ept() waits for the lookups in
+	 * progress, so that none is left walking a hash chain through an
+	 * unlinked endpoint. This does not cover the endpoint callback the
+	 * caller then runs: as when the lookup was done under the device
+	 * lock, an endpoint must not be destroyed while its callback may be
+	 * running, other than from the callback itself.
+	 */
+	atomic_fetch_add(&rdev->rx_lookups, 1);
+	ept = rpmsg_lookup_addr(rdev, addr);
+	atomic_fetch_sub(&rdev->rx_lookups, 1);
+
+	return ept;
+}
+
+/**
+ * rpmsg_unregister_endpoint
+ *
+ * Removes an endpoint from the device, with the device lock held. Lookups
+ * may still be walking through it until rpmsg_wait_rx_lookups() returns.
+ *
+ * @param ept - pointer to the endpoint
+ */
 static void rpmsg_unregister_endpoint(struct rpmsg_endpoint *ept)
 {
 	struct rpmsg_device *rdev;
+	struct rpmsg_endpoint *next;
+	rpmsg_ept_link *pept;
 
 	if (!ept)
 		return;
@@ -187,13 +349,54 @@ static void rpmsg_unregister_endpoint(struct rpmsg_endpoint *ept)
 		rpmsg_release_address(rdev->bitmap, RPMSG_ADDR_BMP_SIZE,
 				      ept->addr);
 	metal_list_del(&ept->node);
+
+	/*
+	 * Unlink from the hash table, leaving hash_next as is for the lookups
+	 * currently on this endpoint.
+	 */
+	pept = &rdev->ept_hash[ept->addr & (RPMSG_EPT_HASH_SIZE - 1)];
+	while ((next = atomic_load_explicit(pept, memory_order_relaxed)) &&
+	       next != ept)
+		pept = &next->hash_next;
+	if (next)
+		atomic_store_explicit(pept,
+				      atomic_load_explicit(&ept->hash_next,
+							   memory_order_relaxed),
+				      memory_order_release);
+}
+
+/**
+ * rpmsg_wait_rx_lookups
+ *
+ * Waits for the lock-free lookups in progress, after an endpoint has been
+ * unregistered and before its memory can be reused. Called without the
+ * device lock, so that the RX path is not held up behind it.
+ *
+ * @param rdev - pointer to rpmsg device
+ */
+static void rpmsg_wait_rx_lookups(struct rpmsg_device *rdev)
+{
+	/* the unlink is ordered before the lookup count is read */
+	atomic_thread_fence(memory_order_seq_cst);
+	while (atomic_load(&rdev->rx_lookups))
+		metal_cpu_yield();
 }
 
 void rpmsg_register_endpoint(struct rpmsg_device *rdev,
 			     struct rpmsg_endpoint *ept)
 {
+	rpmsg_ept_link *bucket;
+
 	ept->rdev = rdev;
 	metal_list_add_tail(&rdev->endpoints, &ept->node);
+
+	/* Publish the endpoint to lock-free lookups once fully initialized */
+	bucket = &rdev->ept_hash[ept->addr & (RPMSG_EPT_HASH_SIZE - 1)];
+	atomic_store_explicit(&ept->hash_next,
+			      atomic_load_explicit(bucket,
+						   memory_order_relaxed),
+			      memory_order_relaxed);
+	atomic_store_explicit(bucket, ept, memory_order_release);
 }
 
 int rpmsg_create_ept(struct rpmsg_endpoint *ept, struct rpmsg_device *rdev,
@@ -232,8 +435,12 @@ int rpmsg_create_ept(struct rpmsg_endpoint *ept, struct rpmsg_device *rdev,
 		metal_mutex_release(&rdev->lock);
 		status = rpmsg_send_ns_message(ept, RPMSG_NS_CREATE);
 		metal_mutex_acquire(&rdev->lock);
-		if (status)
+		if (status) {
 			rpmsg_unregister_endpoint(ept);
+			metal_mutex_release(&rdev->lock);
+			rpmsg_wait_rx_lookups(rdev);
+			return status;
+		}
 	}
 
 ret_status:
@@ -262,4 +469,5 @@ void rpmsg_destroy_ept(struct rpmsg_endpoint *ept)
 	metal_mutex_acquire(&rdev->lock);
 	rpmsg_unregister_endpoint(ept);
 	metal_mutex_release(&rdev->lock);
+	rpmsg_wait_rx_lookups(rdev);
 }
@@ -36,6 +36,17 @@ extern "C" {
 #endif
 
 #define RPMSG_LOCATE_DATA(p) ((unsigned char *)(p) + sizeof(struct rpmsg_hdr))
+#define RPMSG_LOCATE_HDR(p) \
+	((struct rpmsg_hdr *)((unsigned char *)(p) - sizeof(struct rpmsg_hdr)))
+
+/*
+ * While a buffer is owned by the local side, the reserved field of its
+ * header keeps the virtqueue descriptor index and, for a held RX buffer,
+ * the RPMSG_BUF_HELD flag. It is cleared before the buffer is sent.
+ */
+#define RPMSG_BUF_HELD		(1U << 31)
+#define RPMSG_BUF_IDX_MASK	0xFFFFU
+
 /**
  * enum rpmsg_ns_flags - dynamic name service announcement flags
  *
@@ -95,11 +106,8 @@ struct rpmsg_endpoint *rpmsg_get_endpoint(struct rpmsg_device *rvdev,
 void rpmsg_register_endpoint(struct rpmsg_device *rdev,
 			     struct rpmsg_endpoint *ept);
 
-static inline struct rpmsg_endpoint *
-rpmsg_get_ept_from_addr(struct rpmsg_device *rdev, uint32_t addr)
-{
-	return rpmsg_get_endpoint(rdev, NULL, addr, RPMSG_ADDR_ANY);
-}
+struct rpmsg_endpoint *rpmsg_get_ept_from_addr(struct rpmsg_device *rdev,
+					       uint32_t addr);
 
 #if defined __cplusplus
 }
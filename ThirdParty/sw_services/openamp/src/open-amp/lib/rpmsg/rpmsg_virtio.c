@@ -23,6 +23,19 @@
 /* Time to wait - In multiple of 1 msecs. */
 #define RPMSG_TICKS_PER_INTERVAL                1000
 
+/* Most messages queued before notifying the remote side, in a batch send. */
+#define RPMSG_BATCH_MAX                         16
+
+/*
+ * A TX buffer given back unsent with rpmsg_release_tx_buffer() is kept on
+ * the reclaimer list, linked through the start of its own payload. The
+ * header keeps the descriptor index in its reserved field.
+ */
+struct rpmsg_virtio_reclaimed {
+	struct rpmsg_hdr hdr;
+	struct metal_list node;
+};
+
 #ifndef VIRTIO_SLAVE_ONLY
 metal_weak void *
 rpmsg_virtio_shm_pool_get_buffer(struct rpmsg_virtio_shm_pool *shpool,
@@ -123,6 +136,39 @@ static int rpmsg_virtio_enqueue_buffer(struct rpmsg_virtio_device *rvdev,
 	return 0;
 }
 
+/**
+ * rpmsg_virtio_get_tx_buffer_len
+ *
+ * Returns the size of a reserved TX buffer.
+ *
+ * @param rvdev   - pointer to rpmsg virtio device
+ * @param idx     - buffer index
+ *
+ * @return - buffer size, header included.
+ *
+ */
+static uint32_t
+rpmsg_virtio_get_tx_buffer_len(struct rpmsg_virtio_device *rvdev, uint16_t idx)
+{
+	unsigned int role = rpmsg_virtio_get_role(rvdev);
+	uint32_t len = 0;
+
+#ifndef VIRTIO_SLAVE_ONLY
+	if (role == RPMSG_MASTER) {
+		/* Buffers are provided by us, all of the same size */
+		(void)idx;
+		len = RPMSG_BUFFER_SIZE;
+	}
+#endif /*!VIRTIO_SLAVE_ONLY*/
+
+#ifndef VIRTIO_MASTER_ONLY
+	if (role == RPMSG_REMOTE)
+		len = virtqueue_get_buffer_length(rvdev->svq, idx);
+#endif /*!VIRTIO_MASTER_ONLY*/
+
+	return len;
+}
+
 /**
  * rpmsg_virtio_get_tx_buffer
  *
@@ -138,8 +184,19 @@ static void *rpmsg_virtio_get_tx_buffer(struct rpmsg_virtio_device *rvdev,
 					uint32_t *len, uint16_t *idx)
 {
 	unsigned int role = rpmsg_virtio_get_role(rvdev);
+	struct rpmsg_virtio_reclaimed *r;
 	void *data = NULL;
 
+	/* Buffers given back unsent are still owned by us, use them first */
+	if (!metal_list_is_empty(&rvdev->reclaimer)) {
+		r = metal_container_of(rvdev->reclaimer.next,
+				       struct rpmsg_virtio_reclaimed, node);
+		metal_list_del(&r->node);
+		*idx = r->hdr.reserved & RPMSG_BUF_IDX_MASK;
+		*len = rpmsg_virtio_get_tx_buffer_len(rvdev, *idx);
+		return r;
+	}
+
 #ifndef VIRTIO_SLAVE_ONLY
 	if (role == RPMSG_MASTER) {
 		data = virtqueue_get_buffer(rvdev->svq, len, idx);
@@ -253,6 +310,17 @@ static int _rpmsg_virtio_get_buffer_size(struct rpmsg_virtio_device *rvdev)
 		length =
 		    (int)virtqueue_get_desc_size(rvdev->svq) -
 		    sizeof(struct rpmsg_hdr);
+		if (length <= 0 && !metal_list_is_empty(&rvdev->reclaimer)) {
+			struct rpmsg_virtio_reclaimed *r;
+
+			/* No new buffer, but one was given back unsent */
+			r = metal_container_of(rvdev->reclaimer.next,
+					       struct rpmsg_virtio_reclaimed,
+					       node);
+			length = (int)rpmsg_virtio_get_tx_buffer_len(rvdev,
+					r->hdr.reserved & RPMSG_BUF_IDX_MASK) -
+				 sizeof(struct rpmsg_hdr);
+		}
 		if (length < 0) {
 			length = 0;
 		}
@@ -263,40 +331,40 @@ static int _rpmsg_virtio_get_buffer_size(struct rpmsg_virtio_device *rvdev)
 }
 
 /**
- * This function sends rpmsg "message" to remote device.
+ * rpmsg_virtio_reserve_tx_buffers
  *
- * @param rdev    - pointer to rpmsg device
- * @param src     - source address of channel
- * @param dst     - destination address of channel
- * @param data    - data to transmit
- * @param size    - size of data
+ * Gets up to num TX buffers able to hold size bytes of payload, under one
+ * acquisition of the device lock, waiting for the first one if asked to.
+ * The virtqueue descriptor index of each buffer is kept in the reserved
+ * field of its header until the buffer is sent.
+ *
+ * @param rvdev   - pointer to rpmsg virtio device
+ * @param size    - largest payload size, 0 for any buffer
+ * @param rp_hdrs - returns the headers of the buffers
+ * @param num     - number of buffers wanted
  * @param wait    - boolean, wait or not for buffer to become
  *                  available
+ * @param err     - returns the error when no buffer is returned
  *
- * @return - size of data sent or negative value for failure.
+ * @return - number of buffers reserved, 0 on failure.
  *
  */
-static int rpmsg_virtio_send_offchannel_raw(struct rpmsg_device *rdev,
-					    uint32_t src, uint32_t dst,
-					    const void *data,
-					    int size, int wait)
+static int rpmsg_virtio_reserve_tx_buffers(struct rpmsg_virtio_device *rvdev,
+					   int size, struct rpmsg_hdr **rp_hdrs,
+					   int num, int wait, int *err)
 {
-	struct rpmsg_virtio_device *rvdev;
-	struct rpmsg_hdr rp_hdr;
-	void *buffer = NULL;
-	uint16_t idx;
+	struct rpmsg_device *rdev = &rvdev->rdev;
+	uint32_t len;
+	uint16_t idx = 0;
 	int tick_count;
-	uint32_t buff_len;
 	int status;
-	struct metal_io_region *io;
-
-	/* Get the associated remote device for channel. */
-	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+	int count = 0;
 
 	status = rpmsg_virtio_get_status(rvdev);
 	/* Validate device state */
 	if (!(status & VIRTIO_CONFIG_STATUS_DRIVER_OK)) {
-		return RPMSG_ERR_DEV_STATE;
+		*err = RPMSG_ERR_DEV_STATE;
+		return 0;
 	}
 
 	if (wait)
@@ -310,50 +378,352 @@ static int rpmsg_virtio_send_offchannel_raw(struct rpmsg_device *rdev,
 		/* Lock the device to enable exclusive access to virtqueues */
 		metal_mutex_acquire(&rdev->lock);
 		avail_size = _rpmsg_virtio_get_buffer_size(rvdev);
-		if (size <= avail_size)
-			buffer = rpmsg_virtio_get_tx_buffer(rvdev, &buff_len,
-							    &idx);
+		if (size <= avail_size) {
+			while (count < num) {
+				rp_hdrs[count] =
+					rpmsg_virtio_get_tx_buffer(rvdev, &len,
+								   &idx);
+				if (!rp_hdrs[count])
+					break;
+				rp_hdrs[count]->reserved = idx;
+				count++;
+			}
+		}
 		metal_mutex_release(&rdev->lock);
-		if (buffer || !tick_count)
+		if (count || !tick_count)
 			break;
-		if (avail_size != 0)
-			return RPMSG_ERR_BUFF_SIZE;
+		if (avail_size != 0) {
+			*err = RPMSG_ERR_BUFF_SIZE;
+			return 0;
+		}
 		metal_sleep_usec(RPMSG_TICKS_PER_INTERVAL);
 		tick_count--;
 	}
-	if (!buffer)
-		return RPMSG_ERR_NO_BUFF;
+	if (!count)
+		*err = RPMSG_ERR_NO_BUFF;
 
-	/* Initialize RPMSG header. */
-	rp_hdr.dst = dst;
-	rp_hdr.src = src;
-	rp_hdr.len = size;
-	rp_hdr.reserved = 0;
+	return count;
+}
 
-	/* Copy data to rpmsg buffer. */
-	io = rvdev->shbuf_io;
-	status = metal_io_block_write(io, metal_io_virt_to_offset(io, buffer),
-				      &rp_hdr, sizeof(rp_hdr));
-	RPMSG_ASSERT(status == sizeof(rp_hdr), "failed to write header\r\n");
-
-	status = metal_io_block_write(io,
-				      metal_io_virt_to_offset(io,
-				      RPMSG_LOCATE_DATA(buffer)),
-				      data, size);
-	RPMSG_ASSERT(status == size, "failed to write buffer\r\n");
-	metal_mutex_acquire(&rdev->lock);
+/**
+ * rpmsg_virtio_send_buffers
+ *
+ * Writes the headers of reserved TX buffers and hands the buffers over to
+ * the remote side, in order, with a single notification.
+ *
+ * @param rvdev   - pointer to rpmsg virtio device
+ * @param src     - source address of channel
+ * @param dst     - destination address of channel
+ * @param rp_hdrs - headers of the reserved buffers
+ * @param msgs    - messages, only the payload sizes are used
+ * @param num     - number of buffers
+ *
+ */
+static void rpmsg_virtio_send_buffers(struct rpmsg_virtio_device *rvdev,
+				      uint32_t src, uint32_t dst,
+				      struct rpmsg_hdr **rp_hdrs,
+				      const struct rpmsg_msg *msgs, int num)
+{
+	struct rpmsg_device *rdev = &rvdev->rdev;
+	struct metal_io_region *io = rvdev->shbuf_io;
+	uint16_t idx[RPMSG_BATCH_MAX];
+	struct rpmsg_hdr hdr;
+	uint32_t buff_len;
+	int status;
+	int i;
+
+	/* Initialize RPMSG headers. */
+	hdr.dst = dst;
+	hdr.src = src;
+	hdr.reserved = 0;
+	hdr.flags = 0;
+	for (i = 0; i < num; i++) {
+		idx[i] = rp_hdrs[i]->reserved & RPMSG_BUF_IDX_MASK;
+		hdr.len = msgs[i].len;
+		status = metal_io_block_write(io,
+					      metal_io_virt_to_offset(io,
+								      rp_hdrs[i]),
+					      &hdr, sizeof(hdr));
+		RPMSG_ASSERT(status == sizeof(hdr), "failed to write header\r\n");
+	}
 
-	/* Enqueue buffer on virtqueue. */
-	status = rpmsg_virtio_enqueue_buffer(rvdev, buffer, buff_len, idx);
-	RPMSG_ASSERT(status == VQUEUE_SUCCESS, "failed to enqueue buffer\r\n");
+	metal_mutex_acquire(&rdev->lock);
+	for (i = 0; i < num; i++) {
+		buff_len = rpmsg_virtio_get_tx_buffer_len(rvdev, idx[i]);
+
+		/* Enqueue buffer on virtqueue. */
+		status = rpmsg_virtio_enqueue_buffer(rvdev, rp_hdrs[i],
+						     buff_len, idx[i]);
+		RPMSG_ASSERT(status == VQUEUE_SUCCESS,
+			     "failed to enqueue buffer\r\n");
+	}
 	/* Let the other side know that there is a job to process. */
 	virtqueue_kick(rvdev->svq);
 
 	metal_mutex_release(&rdev->lock);
+}
+
+/**
+ * rpmsg_virtio_send_offchannel_batch
+ *
+ * Copies messages to TX buffers and sends them, notifying the remote side
+ * once per group of up to RPMSG_BATCH_MAX messages.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param src     - source address of channel
+ * @param dst     - destination address of channel
+ * @param msgs    - messages to transmit
+ * @param num     - number of messages
+ * @param wait    - boolean, wait or not for buffer to become
+ *                  available
+ *
+ * @return - number of messages sent or negative value if none was sent.
+ *
+ */
+static int rpmsg_virtio_send_offchannel_batch(struct rpmsg_device *rdev,
+					      uint32_t src, uint32_t dst,
+					      const struct rpmsg_msg *msgs,
+					      int num, int wait)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr *rp_hdrs[RPMSG_BATCH_MAX];
+	struct metal_io_region *io;
+	int sent = 0;
+	int status;
+	int count;
+	int size;
+	int i;
+
+	/* Get the associated remote device for channel. */
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+	io = rvdev->shbuf_io;
+
+	while (sent < num) {
+		count = num - sent;
+		if (count > RPMSG_BATCH_MAX)
+			count = RPMSG_BATCH_MAX;
+
+		/* All buffers of a device are large enough or none is */
+		size = 0;
+		for (i = 0; i < count; i++) {
+			if (msgs[sent + i].len < 0)
+				return sent ? sent : RPMSG_ERR_PARAM;
+			if (msgs[sent + i].len > size)
+				size = msgs[sent + i].len;
+		}
+
+		/* Only wait while nothing has been sent */
+		count = rpmsg_virtio_reserve_tx_buffers(rvdev, size, rp_hdrs,
+							count, wait && !sent,
+							&status);
+		if (!count)
+			return sent ? sent : status;
+
+		/* Copy data to rpmsg buffers. */
+		for (i = 0; i < count; i++) {
+			status = metal_io_block_write(io,
+						      metal_io_virt_to_offset(io,
+						      RPMSG_LOCATE_DATA(rp_hdrs[i])),
+						      msgs[sent + i].data,
+						      msgs[sent + i].len);
+			RPMSG_ASSERT(status == msgs[sent + i].len,
+				     "failed to write buffer\r\n");
+		}
+
+		rpmsg_virtio_send_buffers(rvdev, src, dst, rp_hdrs,
+					  &msgs[sent], count);
+		sent += count;
+	}
+
+	return sent;
+}
+
+/**
+ * This function sends rpmsg "message" to remote device.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param src     - source address of channel
+ * @param dst     - destination address of channel
+ * @param data    - data to transmit
+ * @param size    - size of data
+ * @param wait    - boolean, wait or not for buffer to become
+ *                  available
+ *
+ * @return - size of data sent or negative value for failure.
+ *
+ */
+static int rpmsg_virtio_send_offchannel_raw(struct rpmsg_device *rdev,
+					    uint32_t src, uint32_t dst,
+					    const void *data,
+					    int size, int wait)
+{
+	struct rpmsg_msg msg;
+	int status;
+
+	msg.data = data;
+	msg.len = size;
+	status = rpmsg_virtio_send_offchannel_batch(rdev, src, dst, &msg, 1,
+						    wait);
+	if (status < 0)
+		return status;
 
 	return size;
 }
 
+/**
+ * rpmsg_virtio_get_tx_payload_buffer
+ *
+ * Reserves a TX buffer to be filled in place and sent with
+ * rpmsg_virtio_send_offchannel_nocopy.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param len     - returns the size of the payload buffer
+ * @param wait    - boolean, wait or not for buffer to become
+ *                  available
+ *
+ * @return - pointer to the payload buffer or NULL.
+ *
+ */
+static void *rpmsg_virtio_get_tx_payload_buffer(struct rpmsg_device *rdev,
+						uint32_t *len, int wait)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr *rp_hdr;
+	uint32_t buff_len;
+	int status;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+
+	if (!rpmsg_virtio_reserve_tx_buffers(rvdev, 0, &rp_hdr, 1, wait,
+					     &status))
+		return NULL;
+
+	/*
+	 * The descriptor of a reserved buffer is ours until it is sent, its
+	 * length can be read without the device lock.
+	 */
+	buff_len = rpmsg_virtio_get_tx_buffer_len(rvdev, rp_hdr->reserved);
+	*len = buff_len - sizeof(struct rpmsg_hdr);
+
+	return RPMSG_LOCATE_DATA(rp_hdr);
+}
+
+/**
+ * rpmsg_virtio_send_offchannel_nocopy
+ *
+ * Sends the payload written in place in a TX buffer reserved with
+ * rpmsg_virtio_get_tx_payload_buffer. On error the buffer stays reserved
+ * and can be sent again.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param src     - source address of channel
+ * @param dst     - destination address of channel
+ * @param data    - payload buffer
+ * @param len     - size of payload
+ *
+ * @return - size of data sent or negative value for failure.
+ *
+ */
+static int rpmsg_virtio_send_offchannel_nocopy(struct rpmsg_device *rdev,
+					       uint32_t src, uint32_t dst,
+					       const void *data, int len)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr *rp_hdr;
+	struct rpmsg_msg msg;
+	uint32_t buff_len;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+	rp_hdr = RPMSG_LOCATE_HDR(data);
+
+	/* The payload cannot be larger than the buffer it was written to */
+	buff_len = rpmsg_virtio_get_tx_buffer_len(rvdev, rp_hdr->reserved &
+						  RPMSG_BUF_IDX_MASK);
+	if (len < 0 || (uint32_t)len > buff_len - sizeof(struct rpmsg_hdr))
+		return RPMSG_ERR_BUFF_SIZE;
+
+	msg.data = data;
+	msg.len = len;
+	rpmsg_virtio_send_buffers(rvdev, src, dst, &rp_hdr, &msg, 1);
+
+	return len;
+}
+
+/**
+ * rpmsg_virtio_release_tx_buffer
+ *
+ * Gives back a TX buffer reserved with rpmsg_virtio_get_tx_payload_buffer
+ * that will not be sent. It is reused by the next reservation.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param txbuf   - payload buffer
+ *
+ */
+static void rpmsg_virtio_release_tx_buffer(struct rpmsg_device *rdev,
+					   void *txbuf)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_virtio_reclaimed *r;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+	r = (struct rpmsg_virtio_reclaimed *)RPMSG_LOCATE_HDR(txbuf);
+
+	metal_mutex_acquire(&rdev->lock);
+	metal_list_add_tail(&rvdev->reclaimer, &r->node);
+	metal_mutex_release(&rdev->lock);
+}
+
+/**
+ * rpmsg_virtio_hold_rx_buffer
+ *
+ * Keeps an RX buffer from being returned when the endpoint callback
+ * returns.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param rxbuf   - payload of the RX buffer
+ *
+ */
+static void rpmsg_virtio_hold_rx_buffer(struct rpmsg_device *rdev,
+					void *rxbuf)
+{
+	struct rpmsg_hdr *rp_hdr;
+
+	(void)rdev;
+
+	rp_hdr = RPMSG_LOCATE_HDR(rxbuf);
+	rp_hdr->reserved |= RPMSG_BUF_HELD;
+}
+
+/**
+ * rpmsg_virtio_release_rx_buffer
+ *
+ * Returns a held RX buffer to the remote side.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param rxbuf   - payload of the RX buffer
+ *
+ */
+static void rpmsg_virtio_release_rx_buffer(struct rpmsg_device *rdev,
+					   void *rxbuf)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr *rp_hdr;
+	uint32_t len;
+	uint16_t idx;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+	rp_hdr = RPMSG_LOCATE_HDR(rxbuf);
+	idx = rp_hdr->reserved & RPMSG_BUF_IDX_MASK;
+	rp_hdr->reserved = 0;
+
+	metal_mutex_acquire(&rdev->lock);
+	len = virtqueue_get_buffer_length(rvdev->rvq, idx);
+	rpmsg_virtio_return_buffer(rvdev, rp_hdr, len, idx);
+	/* tell peer we return some rx buffer */
+	virtqueue_kick(rvdev->rvq);
+	metal_mutex_release(&rdev->lock);
+}
+
 /**
  * rpmsg_virtio_tx_callback
  *
@@ -383,6 +753,7 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 	struct rpmsg_device *rdev = &rvdev->rdev;
 	struct rpmsg_endpoint *ept;
 	struct rpmsg_hdr *rp_hdr;
+	int returned = 0;
 	uint32_t len;
 	uint16_t idx;
 	int status;
@@ -395,10 +766,11 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 	metal_mutex_release(&rdev->lock);
 
 	while (rp_hdr) {
-		/* Get the channel node from the remote device channels list. */
-		metal_mutex_acquire(&rdev->lock);
+		/* Keep the descriptor index for rpmsg_release_rx_buffer */
+		rp_hdr->reserved = idx;
+
+		/* Get the channel node from the endpoint address hash table. */
 		ept = rpmsg_get_ept_from_addr(rdev, rp_hdr->dst);
-		metal_mutex_release(&rdev->lock);
 
 		if (ept) {
 			if (ept->dest_addr == RPMSG_ADDR_ANY) {
@@ -417,12 +789,22 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 
 		metal_mutex_acquire(&rdev->lock);
 
-		/* Return used buffers. */
-		rpmsg_virtio_return_buffer(rvdev, rp_hdr, len, idx);
+		/*
+		 * Return used buffers, unless held by the endpoint, with their
+		 * full size rather than the size of the message they held.
+		 */
+		if (!(rp_hdr->reserved & RPMSG_BUF_HELD)) {
+			len = virtqueue_get_buffer_length(rvdev->rvq, idx);
+			rpmsg_virtio_return_buffer(rvdev, rp_hdr, len, idx);
+			returned++;
+		}
 
 		rp_hdr = rpmsg_virtio_get_rx_buffer(rvdev, &len, &idx);
-		if (rp_hdr == NULL) {
-			/* tell peer we return some rx buffer */
+		if (rp_hdr == NULL && returned) {
+			/*
+			 * tell peer we return some rx buffer, held buffers are
+			 * notified when they are released
+			 */
 			virtqueue_kick(rvdev->rvq);
 		}
 		metal_mutex_release(&rdev->lock);
@@ -526,9 +908,16 @@ int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 	memset(rdev, 0, sizeof(*rdev));
 	metal_mutex_init(&rdev->lock);
 	rvdev->vdev = vdev;
+	metal_list_init(&rvdev->reclaimer);
 	rdev->ns_bind_cb = ns_bind_cb;
 	vdev->priv = rvdev;
 	rdev->ops.send_offchannel_raw = rpmsg_virtio_send_offchannel_raw;
+	rdev->ops.hold_rx_buffer = rpmsg_virtio_hold_rx_buffer;
+	rdev->ops.release_rx_buffer = rpmsg_virtio_release_rx_buffer;
+	rdev->ops.get_tx_payload_buffer = rpmsg_virtio_get_tx_payload_buffer;
+	rdev->ops.release_tx_buffer = rpmsg_virtio_release_tx_buffer;
+	rdev->ops.send_offchannel_nocopy = rpmsg_virtio_send_offchannel_nocopy;
+	rdev->ops.send_offchannel_batch = rpmsg_virtio_send_offchannel_batch;
 	role = rpmsg_virtio_get_role(rvdev);
 
 #ifndef VIRTIO_MASTER_ONLY
@@ -629,6 +1018,9 @@ int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 
 	/* Initialize channels and endpoints list */
 	metal_list_init(&rdev->endpoints);
+	for (i = 0; i < RPMSG_EPT_HASH_SIZE; i++)
+		atomic_init(&rdev->ept_hash[i], NULL);
+	atomic_init(&rdev->rx_lookups, 0);
 
 	/*
 	 * Create name service announcement endpoint if device supports name
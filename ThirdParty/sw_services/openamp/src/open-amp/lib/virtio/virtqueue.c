@@ -23,6 +23,7 @@ static int vq_ring_must_notify(struct virtqueue *vq);
 static void vq_ring_notify(struct virtqueue *vq);
 static int virtqueue_nused(struct virtqueue *vq);
 static int virtqueue_navail(struct virtqueue *vq);
+static void vq_ring_update_event(struct virtqueue *vq);
 
 /* Default implementation of P2V based on libmetal */
 static inline void *virtqueue_phys_to_virt(struct virtqueue *vq,
@@ -170,7 +171,11 @@ void *virtqueue_get_buffer(struct virtqueue *vq, uint32_t *len, uint16_t *idx)
 	void *cookie;
 	uint16_t used_idx, desc_idx;
 
-	if (!vq || vq->vq_used_cons_idx == vq->vq_ring.used->idx)
+	if (!vq)
+		return NULL;
+
+	vq_ring_update_event(vq);
+	if (vq->vq_used_cons_idx == vq->vq_ring.used->idx)
 		return NULL;
 
 	VQUEUE_BUSY(vq);
@@ -190,7 +195,7 @@ void *virtqueue_get_buffer(struct virtqueue *vq, uint32_t *len, uint16_t *idx)
 	vq->vq_descx[desc_idx].cookie = NULL;
 
 	if (idx)
-		*idx = used_idx;
+		*idx = desc_idx;
 	VQUEUE_IDLE(vq);
 
 	return cookie;
@@ -236,7 +241,7 @@ void *virtqueue_get_available_buffer(struct virtqueue *vq, uint16_t *avail_idx,
 	uint16_t head_idx = 0;
 	void *buffer;
 
-	atomic_thread_fence(memory_order_seq_cst);
+	vq_ring_update_event(vq);
 	if (vq->vq_available_idx == vq->vq_ring.avail->idx) {
 		return NULL;
 	}
@@ -314,6 +319,8 @@ void virtqueue_disable_cb(struct virtqueue *vq)
 {
 	VQUEUE_BUSY(vq);
 
+	vq->vq_cb_disabled = 1;
+
 	if (vq->vq_dev->features & VIRTIO_RING_F_EVENT_IDX) {
 #ifndef VIRTIO_SLAVE_ONLY
 		if (vq->vq_dev->role == VIRTIO_DEV_MASTER) {
@@ -554,6 +561,8 @@ static void vq_ring_update_avail(struct virtqueue *vq, uint16_t desc_idx)
  */
 static int vq_ring_enable_interrupt(struct virtqueue *vq, uint16_t ndesc)
 {
+	vq->vq_cb_disabled = 0;
+
 	/*
 	 * Enable interrupts, making sure we get the latest index of
 	 * what's already been consumed.
@@ -655,6 +664,34 @@ static int vq_ring_must_notify(struct virtqueue *vq)
 	return 0;
 }
 
+/**
+ *
+ * vq_ring_update_event
+ *
+ * With VIRTIO_RING_F_EVENT_IDX, tells the other side that the next buffer
+ * after the ones consumed so far must be notified, unless callbacks are
+ * disabled. Called each time the consumer looks for a new buffer, so that
+ * the other side only notifies when the consumer has caught up with it.
+ * The barrier orders the update before the check for new buffers, which
+ * would otherwise race with the other side adding one.
+ */
+static void vq_ring_update_event(struct virtqueue *vq)
+{
+	if ((vq->vq_dev->features & VIRTIO_RING_F_EVENT_IDX) &&
+	    !vq->vq_cb_disabled) {
+#ifndef VIRTIO_SLAVE_ONLY
+		if (vq->vq_dev->role == VIRTIO_DEV_MASTER)
+			vring_used_event(&vq->vq_ring) = vq->vq_used_cons_idx;
+#endif /*VIRTIO_SLAVE_ONLY*/
+#ifndef VIRTIO_MASTER_ONLY
+		if (vq->vq_dev->role == VIRTIO_DEV_SLAVE)
+			vring_avail_event(&vq->vq_ring) = vq->vq_available_idx;
+#endif /*VIRTIO_MASTER_ONLY*/
+	}
+
+	atomic_thread_fence(memory_order_seq_cst);
+}
+
 /**
  *
  * vq_ring_notify
@@ -61,6 +61,7 @@
 * 1.0  Hyun    07/12/2018  Initial creation
 * 1.1  Hyun    10/11/2018  Initialize the IO device for mem instance
 * 1.2  Nishad  12/05/2018  Renamed ME attributes to AIE
+* 1.3  ag      10/16/2026  Add XAieIO_WriteTxn()
 * </pre>
 *
 ******************************************************************************/
@@ -393,6 +394,40 @@ void XAieIO_Write128(u64 Addr, u32 *Data)
 	}
 }
 
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to execute a run of transaction writes and
+* mask writes. The writes are posted back to back, with one release barrier
+* ahead of them, instead of one per write.
+*
+* @param	Cmds: Transaction commands, XAIELIB_TXN_OP_WRITE or
+*		XAIELIB_TXN_OP_MASKWRITE.
+* @param	NumCmds: Number of commands.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieIO_WriteTxn(const struct XAieLib_TxnCmd *Cmds, u32 NumCmds)
+{
+	u32 Idx, RegVal;
+	unsigned long Offset;
+
+	atomic_thread_fence(memory_order_release);
+	for (Idx = 0U; Idx < NumCmds; Idx++) {
+		Offset = Cmds[Idx].Addr - IOInst.io_base;
+		RegVal = Cmds[Idx].Value;
+		if (Cmds[Idx].Op == XAIELIB_TXN_OP_MASKWRITE) {
+			RegVal |= metal_io_read32(IOInst.io, Offset) &
+				~Cmds[Idx].Mask;
+		}
+		metal_io_write(IOInst.io, Offset, RegVal, memory_order_relaxed,
+				4);
+	}
+}
+
 /*****************************************************************************/
 /**
 *
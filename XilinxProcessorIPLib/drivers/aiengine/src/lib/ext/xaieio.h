@@ -60,6 +60,7 @@
 * ----- ------  -------- -----------------------------------------------------
 * 1.0  Hyun    07/12/2018  Initial creation
 * 1.1  Nishad  12/05/2018  Renamed ME attributes to AIE
+* 1.2  ag      10/16/2026  Add XAieIO_WriteTxn()
 * </pre>
 *
 ******************************************************************************/
@@ -89,6 +90,9 @@ void XAieIO_Read128(uint64_t Addr, uint32 *Data);
 void XAieIO_Write32(uint64_t Addr, uint32 Data);
 void XAieIO_Write128(uint64_t Addr, uint32 *Data);
 
+struct XAieLib_TxnCmd;
+void XAieIO_WriteTxn(const struct XAieLib_TxnCmd *Cmds, uint32 NumCmds);
+
 typedef struct XAieIO_Mem XAieIO_Mem;
 
 void XAieIO_MemFinish(XAieIO_Mem *IO_MemInstPtr);
@@ -56,14 +56,21 @@
 * 2.4  Hyun    09/13/2019  Use the simulation elf loader function
 * 2.5  Hyun    09/13/2019  Use XAieSim_LoadElfMem()
 * 2.6  Tejus   10/14/2019  Enable assertion for linux and simulation
+* 2.7  ag      10/16/2026  Add the register transaction buffer
+* 2.8  ag      10/16/2026  Load ELFs in memory with the ELF image loader
+* 2.9  ag      10/16/2026  Add the monotonic time and absolute sleep APIs
 * </pre>
 *
 ******************************************************************************/
 #include "xaielib.h"
+#include "xaielib_elf.h"
 
 #ifdef __AIESIM__ /* AIE simulator */
 
 #include <assert.h>
+#include <errno.h>
+#include <stddef.h>
+#include <time.h>
 #include "xaiesim.h"
 
 #elif defined __AIEBAREMTL__ /* Bare-metal application */
@@ -75,14 +82,17 @@
 #include "xil_cache.h"
 #include "xstatus.h"
 #include "sleep.h"
+#include "xtime_l.h"
 
 #include <stdlib.h>
 
 #else /* Non-baremetal application, ex Linux */
 
 #include <assert.h>
+#include <errno.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "xaieio.h"
@@ -116,6 +126,22 @@ typedef struct XAieLib_MemInst
 	void *Platform;	/**< Platform specific data */
 } XAieLib_MemInst;
 
+typedef struct XAieLib_Txn
+{
+	u8 Active;		/**< Writes and polls are being recorded */
+	u32 Status;		/**< Status of the flushes since started */
+	u32 NumCmds;		/**< Number of commands recorded */
+	XAieLib_TxnSubmitFn Submit;	/**< Submission handler, or NULL */
+	void *SubmitData;	/**< Data of the submission handler */
+	XAieLib_TxnCmd Cmds[XAIELIB_TXN_MAX_CMDS];	/**< Command buffer */
+} XAieLib_Txn;
+
+static XAieLib_Txn TxnInst;
+
+/************************** Function Prototypes ******************************/
+static void XAieLib_TxnRecord(u8 Op, u64 Addr, u32 Mask, u32 Value,
+		u32 TimeOutUs);
+
 /************************** Function Definitions *****************************/
 
 /*****************************************************************************/
@@ -194,6 +220,70 @@ int XAieLib_usleep(u64 Usec)
 #endif
 }
 
+/*****************************************************************************/
+/**
+*
+* This returns the time of a monotonic clock in nano seconds.
+*
+* @param	None.
+*
+* @return	Time in nano seconds, from an unspecified origin.
+*
+* @note		On bare-metal, this is the global timer of the processor.
+*
+*******************************************************************************/
+u64 XAieLib_GetTimeNs(void)
+{
+#ifdef __AIEBAREMTL__
+	XTime Now;
+
+	XTime_GetTime(&Now);
+	return (u64)((Now / COUNTS_PER_SECOND) * 1000000000ULL +
+		((Now % COUNTS_PER_SECOND) * 1000000000ULL) /
+		COUNTS_PER_SECOND);
+#else
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return (u64)Now.tv_sec * 1000000000ULL + (u64)Now.tv_nsec;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This provides to sleep until an absolute time of XAieLib_GetTimeNs().
+*
+* @param	DeadlineNs: Time to sleep until, in nano seconds
+*
+* @return	0 for success, and -1 for error.
+*
+* @note		Returns immediately if the time has passed. Unlike a relative
+*		sleep, the time taken between two calls doesn't add up when
+*		the deadlines are computed from a fixed start.
+*
+*******************************************************************************/
+int XAieLib_SleepUntilNs(u64 DeadlineNs)
+{
+#ifdef __AIEBAREMTL__
+	while(XAieLib_GetTimeNs() < DeadlineNs) {
+	}
+	return 0;
+#else
+	struct timespec Deadline;
+	int Ret;
+
+	Deadline.tv_sec = (time_t)(DeadlineNs / 1000000000ULL);
+	Deadline.tv_nsec = (long)(DeadlineNs % 1000000000ULL);
+	do {
+		Ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+				&Deadline, NULL);
+	} while(Ret == EINTR);
+
+	return (Ret == 0) ? 0 : -1;
+#endif
+}
+
 /*****************************************************************************/
 /**
 *
@@ -236,10 +326,15 @@ u32 XAieLib_LoadElfMem(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym)
 {
 #ifdef __AIESIM__
 	return XAIELIB_FAILURE;
-#elif defined __AIEBAREMTL__
-	return XAIELIB_FAILURE;
 #else
-	return XAieSim_LoadElfMem(TileInstPtr, ElfPtr, LoadSym);
+	XAieLib_ElfImage Img;
+
+	(void)LoadSym;
+	if(XAieLib_ElfParse(&Img, ElfPtr) != XAIELIB_SUCCESS) {
+		return XAIELIB_FAILURE;
+	}
+
+	return XAieLib_ElfLoad(&Img, &TileInstPtr, 1U, 0U);
 #endif
 }
 
@@ -741,6 +836,10 @@ u32 XAieLib_MemRead32(XAieLib_MemInst *XAieLib_MemInstPtr, u64 Addr)
 *******************************************************************************/
 u32 XAieLib_Read32(u64 Addr)
 {
+	if (TxnInst.Active != 0U) {
+		(void)XAieLib_TxnFlush();
+	}
+
 #ifdef __AIESIM__
 	return(XAieSim_Read32(Addr));
 #elif defined __AIEBAREMTL__
@@ -767,6 +866,10 @@ void XAieLib_Read128(u64 Addr, u32 *Data)
 {
 	u8 Idx;
 
+	if (TxnInst.Active != 0U) {
+		(void)XAieLib_TxnFlush();
+	}
+
 	for(Idx = 0U; Idx < 4U; Idx++) {
 #ifdef __AIESIM__
 		Data[Idx] = XAieSim_Read32(Addr + Idx*4U);
@@ -793,6 +896,11 @@ void XAieLib_Read128(u64 Addr, u32 *Data)
 *******************************************************************************/
 void XAieLib_Write32(u64 Addr, u32 Data)
 {
+	if (TxnInst.Active != 0U) {
+		XAieLib_TxnRecord(XAIELIB_TXN_OP_WRITE, Addr, 0U, Data, 0U);
+		return;
+	}
+
 #ifdef __AIESIM__
 	XAieSim_Write32(Addr, Data);
 #elif defined __AIEBAREMTL__
@@ -821,6 +929,12 @@ void XAieLib_MaskWrite32(u64 Addr, u32 Mask, u32 Data)
 {
 	u32 RegVal;
 
+	if (TxnInst.Active != 0U) {
+		XAieLib_TxnRecord(XAIELIB_TXN_OP_MASKWRITE, Addr, Mask, Data,
+				0U);
+		return;
+	}
+
 #ifdef __AIESIM__
 	XAieSim_MaskWrite32(Addr, Mask, Data);
 #elif defined __AIEBAREMTL__
@@ -851,6 +965,16 @@ void XAieLib_MaskWrite32(u64 Addr, u32 Mask, u32 Data)
 *******************************************************************************/
 void XAieLib_Write128(u64 Addr, u32 *Data)
 {
+	if (TxnInst.Active != 0U) {
+		u8 Idx;
+
+		for(Idx = 0U; Idx < 4U; Idx++) {
+			XAieLib_TxnRecord(XAIELIB_TXN_OP_WRITE,
+					Addr + Idx * 4U, 0U, Data[Idx], 0U);
+		}
+		return;
+	}
+
 #ifdef __AIESIM__
 	XAieSim_Write128(Addr, Data);
 #elif defined __AIEBAREMTL__
@@ -880,6 +1004,10 @@ void XAieLib_Write128(u64 Addr, u32 *Data)
 void XAieLib_WriteCmd(u8 Command, u8 ColId, u8 RowId, u32 CmdWd0,
 						u32 CmdWd1, u8 *CmdStr)
 {
+	if (TxnInst.Active != 0U) {
+		(void)XAieLib_TxnFlush();
+	}
+
 #ifdef __AIESIM__
 	XAieSim_WriteCmd(Command, ColId, RowId, CmdWd0, CmdWd1, CmdStr);
 #elif defined __AIEBAREMTL__
@@ -899,13 +1027,20 @@ void XAieLib_WriteCmd(u8 Command, u8 ColId, u8 RowId, u32 CmdWd0,
 *
 * @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE
 *
-* @note		None.
+* @note		In a transaction, the poll is recorded and XAIELIB_SUCCESS
+*		returned: a timeout is reported by the flush.
 *
 *******************************************************************************/
 u32 XAieLib_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs)
 {
 	u32 Ret = XAIELIB_FAILURE;
 
+	if (TxnInst.Active != 0U) {
+		XAieLib_TxnRecord(XAIELIB_TXN_OP_MASKPOLL, Addr, Mask, Value,
+				TimeOutUs);
+		return XAIELIB_SUCCESS;
+	}
+
 #ifdef __AIESIM__
 	if (XAieSim_MaskPoll(Addr, Mask, Value, TimeOutUs) == XAIESIM_SUCCESS) {
 		Ret = XAIELIB_SUCCESS;
@@ -938,6 +1073,242 @@ u32 XAieLib_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs)
 	return Ret;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function records a command in the transaction buffer. A mask write
+* right after a write or mask write to the same register is merged into it,
+* and the buffer is flushed when full.
+*
+* @param	Op: XAIELIB_TXN_OP_* command.
+* @param	Addr: Register address.
+* @param	Mask: Mask of mask writes and polls.
+* @param	Value: Value written or polled for.
+* @param	TimeOutUs: Poll timeout.
+*
+* @return	None.
+*
+* @note		Only consecutive commands are merged, as the order of writes
+*		to different registers matters.
+*
+*******************************************************************************/
+static void XAieLib_TxnRecord(u8 Op, u64 Addr, u32 Mask, u32 Value,
+		u32 TimeOutUs)
+{
+	XAieLib_TxnCmd *Cmd;
+
+	if (TxnInst.NumCmds > 0U) {
+		Cmd = &TxnInst.Cmds[TxnInst.NumCmds - 1U];
+		if ((Op == XAIELIB_TXN_OP_MASKWRITE) && (Cmd->Addr == Addr) &&
+				(Cmd->Op != XAIELIB_TXN_OP_MASKPOLL)) {
+			Cmd->Value = (Cmd->Value & ~Mask) | Value;
+			Cmd->Mask |= Mask;
+			return;
+		}
+	}
+
+	if (TxnInst.NumCmds == XAIELIB_TXN_MAX_CMDS) {
+		(void)XAieLib_TxnFlush();
+	}
+
+	Cmd = &TxnInst.Cmds[TxnInst.NumCmds];
+	Cmd->Op = Op;
+	Cmd->Addr = Addr;
+	Cmd->Mask = Mask;
+	Cmd->Value = Value;
+	Cmd->TimeOutUs = TimeOutUs;
+	TxnInst.NumCmds++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function executes a run of write and mask write commands with the
+* platform register accesses.
+*
+* @param	Cmds: Commands to execute.
+* @param	NumCmds: Number of commands.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+static void XAieLib_TxnWriteRun(const XAieLib_TxnCmd *Cmds, u32 NumCmds)
+{
+#if defined __AIESIM__ || defined __AIEBAREMTL__
+	u32 Idx;
+
+	for (Idx = 0U; Idx < NumCmds; Idx++) {
+#ifdef __AIESIM__
+		if (Cmds[Idx].Op == XAIELIB_TXN_OP_MASKWRITE) {
+			XAieSim_MaskWrite32(Cmds[Idx].Addr, Cmds[Idx].Mask,
+					Cmds[Idx].Value);
+		} else {
+			XAieSim_Write32(Cmds[Idx].Addr, Cmds[Idx].Value);
+		}
+#else
+		u32 RegVal = Cmds[Idx].Value;
+
+		if (Cmds[Idx].Op == XAIELIB_TXN_OP_MASKWRITE) {
+			RegVal |= Xil_In32(Cmds[Idx].Addr) & ~Cmds[Idx].Mask;
+		}
+		Xil_Out32(Cmds[Idx].Addr, RegVal);
+#endif
+	}
+#else
+	XAieIO_WriteTxn(Cmds, NumCmds);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This function executes transaction commands in order, handing each run of
+* writes over to the platform at once. It stops at the first poll which
+* times out.
+*
+* @param	Cmds: Commands to execute.
+* @param	NumCmds: Number of commands.
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE
+*
+* @note		None.
+*
+*******************************************************************************/
+static u32 XAieLib_TxnExec(const XAieLib_TxnCmd *Cmds, u32 NumCmds)
+{
+	u32 Idx, Start = 0U;
+
+	for (Idx = 0U; Idx < NumCmds; Idx++) {
+		if (Cmds[Idx].Op != XAIELIB_TXN_OP_MASKPOLL) {
+			continue;
+		}
+		if (Idx > Start) {
+			XAieLib_TxnWriteRun(&Cmds[Start], Idx - Start);
+		}
+		if (XAieLib_MaskPoll(Cmds[Idx].Addr, Cmds[Idx].Mask,
+				Cmds[Idx].Value, Cmds[Idx].TimeOutUs) !=
+				XAIELIB_SUCCESS) {
+			return XAIELIB_FAILURE;
+		}
+		Start = Idx + 1U;
+	}
+	if (NumCmds > Start) {
+		XAieLib_TxnWriteRun(&Cmds[Start], NumCmds - Start);
+	}
+
+	return XAIELIB_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function starts a register transaction: from now on, register writes,
+* mask writes and polls are recorded in the transaction buffer rather than
+* executed, until flushed. Register reads flush the transaction first, so
+* that existing code runs unchanged in a transaction.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		The transaction is global, as the IO instance is.
+*
+*******************************************************************************/
+void XAieLib_TxnStart(void)
+{
+	TxnInst.NumCmds = 0U;
+	TxnInst.Status = XAIELIB_SUCCESS;
+	TxnInst.Active = 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function flushes the transaction buffer: the recorded commands are
+* executed in order, in one submission to the submission handler if any.
+* The transaction stays active.
+*
+* @param	None.
+*
+* @return	XAIELIB_SUCCESS if all the commands recorded since the
+*		transaction started were executed, otherwise XAIELIB_FAILURE.
+*
+* @note		The commands after a poll which timed out are dropped.
+*
+*******************************************************************************/
+u32 XAieLib_TxnFlush(void)
+{
+	u8 Active = TxnInst.Active;
+	u32 NumCmds = TxnInst.NumCmds;
+	u32 Ret;
+
+	if (NumCmds == 0U) {
+		return TxnInst.Status;
+	}
+
+	/* Execute the commands with the register accesses of the platform */
+	TxnInst.Active = 0U;
+	TxnInst.NumCmds = 0U;
+	if (TxnInst.Submit != NULL) {
+		Ret = TxnInst.Submit(TxnInst.Cmds, NumCmds,
+				TxnInst.SubmitData);
+	} else {
+		Ret = XAieLib_TxnExec(TxnInst.Cmds, NumCmds);
+	}
+	TxnInst.Active = Active;
+
+	if (Ret != XAIELIB_SUCCESS) {
+		TxnInst.Status = XAIELIB_FAILURE;
+	}
+
+	return TxnInst.Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function flushes and ends a register transaction.
+*
+* @param	None.
+*
+* @return	XAIELIB_SUCCESS if all the commands recorded since the
+*		transaction started were executed, otherwise XAIELIB_FAILURE.
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieLib_TxnEnd(void)
+{
+	u32 Ret;
+
+	Ret = XAieLib_TxnFlush();
+	TxnInst.Active = 0U;
+
+	return Ret;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the handler submitting the commands of transaction
+* flushes, ex by DMA, instead of the platform register accesses.
+*
+* @param	Submit: Submission handler, or NULL for register accesses.
+* @param	Data: Data passed to the handler.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieLib_TxnSetSubmit(XAieLib_TxnSubmitFn Submit, void *Data)
+{
+	TxnInst.Submit = Submit;
+	TxnInst.SubmitData = Data;
+}
+
 /*****************************************************************************/
 /**
 *
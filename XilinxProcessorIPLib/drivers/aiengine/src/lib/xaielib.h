@@ -45,6 +45,8 @@
 * 1.6  Nishad  12/05/2018  Renamed ME attributes to AIE
 * 1.7  Hyun    01/08/2019  Add XAieLib_MaskPoll()
 * 1.8  Tejus   10/14/2019  Enable assertion for linux and simulation
+* 1.9  ag      10/16/2026  Add the register transaction buffer
+* 2.0  ag      10/16/2026  Add the monotonic time and absolute sleep APIs
 * </pre>
 *
 ******************************************************************************/
@@ -73,6 +75,38 @@ typedef uint64_t		u64;
 /* Enable cache for memory mapping */
 #define XAIELIB_MEM_ATTR_CACHE		0x1U
 
+/* Commands recorded in a register transaction */
+#define XAIELIB_TXN_OP_WRITE		0U
+#define XAIELIB_TXN_OP_MASKWRITE	1U
+#define XAIELIB_TXN_OP_MASKPOLL		2U
+
+/* Number of commands buffered before a transaction is flushed */
+#ifndef XAIELIB_TXN_MAX_CMDS
+#define XAIELIB_TXN_MAX_CMDS		1024U
+#endif
+
+/**************************** Type Definitions *******************************/
+/*
+ * Register transaction command. Writes set Value, mask writes set the
+ * register bits in Mask to Value, polls wait up to TimeOutUs for the
+ * register bits in Mask to equal Value.
+ */
+typedef struct XAieLib_TxnCmd {
+	u64 Addr;		/**< Register address */
+	u32 Mask;		/**< Mask of mask writes and polls */
+	u32 Value;		/**< Value written or polled for */
+	u32 TimeOutUs;		/**< Poll timeout */
+	u8 Op;			/**< XAIELIB_TXN_OP_* */
+} XAieLib_TxnCmd;
+
+/*
+ * Transaction submission handler, replacing the register accesses of a
+ * flush, ex to submit the commands by DMA. Returns XAIELIB_SUCCESS once
+ * all the commands are executed, XAIELIB_FAILURE otherwise.
+ */
+typedef u32 (*XAieLib_TxnSubmitFn)(const XAieLib_TxnCmd *Cmds, u32 NumCmds,
+		void *Data);
+
 /************************** Variable Definitions *****************************/
 
 /************************** Function Prototypes  *****************************/
@@ -84,6 +118,11 @@ void XAieLib_Write128(u64 Addr, u32 *Data);
 void XAieLib_WriteCmd(u8 Command, u8 ColId, u8 RowId, u32 CmdWd0, u32 CmdWd1, u8 *CmdStr);
 u32 XAieLib_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs);
 
+void XAieLib_TxnStart(void);
+u32 XAieLib_TxnFlush(void);
+u32 XAieLib_TxnEnd(void);
+void XAieLib_TxnSetSubmit(XAieLib_TxnSubmitFn Submit, void *Data);
+
 u32 XAieLib_NPIRead32(u64 Addr);
 void XAieLib_NPIWrite32(u64 Addr, u32 Data);
 u32 XAieLib_NPIMaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs);
@@ -91,6 +130,8 @@ u32 XAieLib_NPIMaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs);
 u32 XAieLib_AssertNonvoid(u8 Cond, const char *func, const u32 line);
 void XAieLib_AssertVoid(u8 Cond, const char *func, const u32 line);
 int XAieLib_usleep(u64 Usec);
+u64 XAieLib_GetTimeNs(void);
+int XAieLib_SleepUntilNs(u64 DeadlineNs);
 
 struct XAieGbl_Tile;
 typedef struct XAieGbl_Tile XAieGbl_Tile;
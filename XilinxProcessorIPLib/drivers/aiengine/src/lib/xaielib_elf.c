@@ -0,0 +1,406 @@
+/*******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+
+
+/******************************************************************************/
+/**
+* @file xaielib_elf.c
+* @{
+*
+* This file contains the ELF image loader. An ELF is parsed once into an
+* image of its loadable segments, which is then written to any number of
+* tiles with 128-bit writes.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0  ag      10/16/2026  Initial creation
+* </pre>
+*
+*******************************************************************************/
+
+/***************************** Include Files **********************************/
+#include <string.h>
+
+#include "xaiegbl.h"
+#include "xaiegbl_defs.h"
+#include "xaiegbl_params.h"
+#include "xaielib_elf.h"
+
+/***************************** Constant Definitions ***************************/
+#define XAIELIB_ELF_CLASS32		1U
+#define XAIELIB_ELF_SHT_PROGBITS	1U
+#define XAIELIB_ELF_SHT_NOBITS		8U
+#define XAIELIB_ELF_SHF_WRITE		0x1U
+#define XAIELIB_ELF_SHF_ALLOC		0x2U
+#define XAIELIB_ELF_SHF_EXECINSTR	0x4U
+
+#define XAIELIB_ELF_DMB_MASK		0x7FFFU		/* 32 KB */
+#define XAIELIB_ELF_DMB_SIZE		0x8000U
+#define XAIELIB_ELF_DMB_CARD_OFF	0x18000U
+#define XAIELIB_ELF_DMB_CARD_SHIFT	15U
+
+#define XAIELIB_ELF_CARD_SOUTH		0U
+#define XAIELIB_ELF_CARD_WEST		1U
+#define XAIELIB_ELF_CARD_NORTH		2U
+#define XAIELIB_ELF_CARD_EAST		3U
+
+/**************************** Type Definitions ********************************/
+/*
+ * ELF32 file and section headers. <elf.h> isn't available on all the
+ * platforms the driver builds for.
+ */
+typedef struct {
+	u8 e_ident[16];
+	u16 e_type;
+	u16 e_machine;
+	u32 e_version;
+	u32 e_entry;
+	u32 e_phoff;
+	u32 e_shoff;
+	u32 e_flags;
+	u16 e_ehsize;
+	u16 e_phentsize;
+	u16 e_phnum;
+	u16 e_shentsize;
+	u16 e_shnum;
+	u16 e_shstrndx;
+} XAieLib_Elf32Ehdr;
+
+typedef struct {
+	u32 sh_name;
+	u32 sh_type;
+	u32 sh_flags;
+	u32 sh_addr;
+	u32 sh_offset;
+	u32 sh_size;
+	u32 sh_link;
+	u32 sh_info;
+	u32 sh_addralign;
+	u32 sh_entsize;
+} XAieLib_Elf32Shdr;
+
+/************************** Variable Definitions ******************************/
+extern XAieGbl_Config XAieGbl_ConfigTable[];
+
+/************************** Function Definitions ******************************/
+/*****************************************************************************/
+/**
+*
+* This routine adds the segments of a section to the image, splitting the
+* data memory sections at the 32 KB bank boundaries.
+*
+* @param	ImgPtr: Pointer to the image.
+* @param	Type: XAIELIB_ELF_SEG_* type of the section.
+* @param	Addr: Section address.
+* @param	Size: Section size.
+* @param	Data: Section data, NULL for BSS.
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE.
+*
+* @note		None.
+*
+*******************************************************************************/
+static u32 XAieLib_ElfAddSection(XAieLib_ElfImage *ImgPtr, u8 Type, u32 Addr,
+		u32 Size, const u8 *Data)
+{
+	XAieLib_ElfSeg *Seg;
+	u32 Len;
+
+	while(Size > 0U) {
+		if(ImgPtr->NumSegs == XAIELIB_ELF_SEGS_MAX) {
+			XAie_print("Error: Too many ELF segments\n");
+			return XAIELIB_FAILURE;
+		}
+
+		Seg = &ImgPtr->Segs[ImgPtr->NumSegs++];
+		Seg->Type = Type;
+		Seg->Data = Data;
+		if(Type == XAIELIB_ELF_SEG_PRGMEM) {
+			Seg->CardDir = 0U;
+			Seg->Offset = Addr;
+			Seg->Size = Size;
+			break;
+		}
+
+		/* Data memory bank of the cardinal direction of the address */
+		Seg->CardDir = (Addr & XAIELIB_ELF_DMB_CARD_OFF) >>
+			XAIELIB_ELF_DMB_CARD_SHIFT;
+		Seg->Offset = Addr & XAIELIB_ELF_DMB_MASK;
+		Len = XAIELIB_ELF_DMB_SIZE - Seg->Offset;
+		if(Len > Size) {
+			Len = Size;
+		}
+		Seg->Size = Len;
+
+		Addr += Len;
+		Size -= Len;
+		if(Data != NULL) {
+			Data += Len;
+		}
+	}
+
+	return XAIELIB_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API parses an ELF into an image of its program memory, data memory
+* and BSS segments, to be loaded with XAieLib_ElfLoad().
+*
+* @param	ImgPtr: Pointer to the image to be filled.
+* @param	ElfPtr: Pointer to the ELF in memory. The ELF must be kept
+*		while the image is used.
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE.
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieLib_ElfParse(XAieLib_ElfImage *ImgPtr, const u8 *ElfPtr)
+{
+	const XAieLib_Elf32Ehdr *ElfHdr = (const XAieLib_Elf32Ehdr *)ElfPtr;
+	const XAieLib_Elf32Shdr *SectHdr;
+	const char *ShName;
+	const char *Names;
+	u32 Count;
+	u32 Ret = XAIELIB_SUCCESS;
+
+	XAie_AssertNonvoid(ImgPtr != XAIE_NULL);
+	XAie_AssertNonvoid(ElfPtr != XAIE_NULL);
+
+	ImgPtr->NumSegs = 0U;
+
+	if((memcmp(ElfHdr->e_ident, "\177ELF", 4U) != 0) ||
+			(ElfHdr->e_ident[4] != XAIELIB_ELF_CLASS32) ||
+			(ElfHdr->e_shstrndx >= ElfHdr->e_shnum)) {
+		XAie_print("Error: Invalid ELF\n");
+		return XAIELIB_FAILURE;
+	}
+
+	SectHdr = (const XAieLib_Elf32Shdr *)(ElfPtr + ElfHdr->e_shoff);
+	Names = (const char *)ElfPtr + SectHdr[ElfHdr->e_shstrndx].sh_offset;
+
+	for(Count = 0U; (Count < ElfHdr->e_shnum) &&
+			(Ret == XAIELIB_SUCCESS); Count++) {
+		ShName = Names + SectHdr[Count].sh_name;
+
+		/* Program and data sections */
+		if((SectHdr[Count].sh_type == XAIELIB_ELF_SHT_PROGBITS) &&
+				((SectHdr[Count].sh_flags &
+				  (XAIELIB_ELF_SHF_ALLOC |
+				   XAIELIB_ELF_SHF_EXECINSTR |
+				   XAIELIB_ELF_SHF_WRITE)) != 0U)) {
+			Ret = XAieLib_ElfAddSection(ImgPtr,
+					(strstr(ShName, "data.DMb") != NULL) ?
+					XAIELIB_ELF_SEG_DATMEM :
+					XAIELIB_ELF_SEG_PRGMEM,
+					SectHdr[Count].sh_addr,
+					SectHdr[Count].sh_size,
+					ElfPtr + SectHdr[Count].sh_offset);
+		}
+
+		/* BSS sections */
+		if((SectHdr[Count].sh_type == XAIELIB_ELF_SHT_NOBITS) &&
+				(strstr(ShName, "bss.DMb") != NULL)) {
+			Ret = XAieLib_ElfAddSection(ImgPtr,
+					XAIELIB_ELF_SEG_BSS,
+					SectHdr[Count].sh_addr,
+					SectHdr[Count].sh_size, XAIE_NULL);
+		}
+	}
+
+	return Ret;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine returns the address of the tile owning the data memory bank
+* of the given cardinal direction, as seen from the given tile.
+*
+* @param	TileInstPtr: Pointer to the Tile instance structure.
+* @param	CardDir: Cardinal direction of the bank.
+*
+* @return	Tile address.
+*
+* @note		Banks beyond the array fall back to the tile itself.
+*
+*******************************************************************************/
+static u64 XAieLib_ElfBankTileAddr(XAieGbl_Tile *TileInstPtr, u8 CardDir)
+{
+	u16 TgtRow = TileInstPtr->RowId;
+	u16 TgtCol = TileInstPtr->ColId;
+
+	switch(CardDir) {
+	case XAIELIB_ELF_CARD_SOUTH:
+		if(TgtRow > 0U) {
+			TgtRow -= 1U;
+		}
+		break;
+	case XAIELIB_ELF_CARD_WEST:
+		/* West is the adjacent tile on odd rows, else the same tile */
+		if(((TgtRow % 2U) == 1U) && (TgtCol > 0U)) {
+			TgtCol -= 1U;
+		}
+		break;
+	case XAIELIB_ELF_CARD_NORTH:
+		TgtRow += 1U;
+		break;
+	default:
+		/* East is the adjacent tile on even rows, else the same tile */
+		if((TgtRow % 2U) == 0U) {
+			TgtCol += 1U;
+		}
+		break;
+	}
+
+	if(TgtRow > XAieGbl_ConfigTable->NumRows) {
+		TgtRow = TileInstPtr->RowId;
+	}
+	if(TgtCol >= XAieGbl_ConfigTable->NumCols) {
+		TgtCol = TileInstPtr->ColId;
+	}
+
+	return (TileInstPtr->TileAddr & ~(u64)XAIEGBL_TILE_BASE_ADDRMASK) |
+		((u64)TgtCol << XAIEGBL_TILE_ADDR_COL_SHIFT) |
+		((u64)TgtRow << XAIEGBL_TILE_ADDR_ROW_SHIFT);
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine writes a segment to the memory at the given address, with
+* 128-bit writes for the 16 byte aligned part and 32-bit writes around it.
+*
+* @param	Addr: Address to write to.
+* @param	Data: Data to write, NULL for zeros.
+* @param	Size: Size in bytes.
+* @param	SkipZero: If set, the words which are zero aren't written.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+static void XAieLib_ElfWriteSeg(u64 Addr, const u8 *Data, u32 Size,
+		u8 SkipZero)
+{
+	u32 Buf[4];
+	u32 Len;
+
+	while(Size > 0U) {
+		if(((Addr & 0xFU) == 0U) && (Size >= sizeof(Buf))) {
+			Len = sizeof(Buf);
+		} else if(Size >= sizeof(Buf[0])) {
+			Len = sizeof(Buf[0]);
+		} else {
+			Len = Size;
+		}
+
+		memset(Buf, 0, sizeof(Buf));
+		if(Data != XAIE_NULL) {
+			memcpy(Buf, Data, Len);
+			Data += Len;
+		}
+
+		if(Len == sizeof(Buf)) {
+			if((SkipZero == 0U) || ((Buf[0] | Buf[1] | Buf[2] |
+						Buf[3]) != 0U)) {
+				XAieGbl_Write128(Addr, Buf);
+			}
+		} else if((SkipZero == 0U) || (Buf[0] != 0U)) {
+			XAieGbl_Write32(Addr, Buf[0]);
+		}
+
+		Addr += sizeof(Buf[0]) * ((Len + 3U) / 4U);
+		Size -= Len;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API loads a parsed ELF image to a set of tiles, one tile after the
+* other as separate loads would, without parsing the ELF again.
+*
+* @param	ImgPtr: Pointer to the image from XAieLib_ElfParse().
+* @param	TileInstPtrs: Array of pointers to the tile instances.
+* @param	NumTiles: Number of tiles.
+* @param	Flags: XAIELIB_ELF_LOAD_MEMCLEARED if the memories are known to
+*		be zero, ex right after reset: BSS and zero words aren't
+*		written then.
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE.
+*
+* @note		The AIE array has no broadcast for memory mapped writes, so
+*		every tile is written.
+*
+*******************************************************************************/
+u32 XAieLib_ElfLoad(const XAieLib_ElfImage *ImgPtr,
+		XAieGbl_Tile **TileInstPtrs, u32 NumTiles, u32 Flags)
+{
+	const XAieLib_ElfSeg *Seg;
+	XAieGbl_Tile *TileInstPtr;
+	u8 MemCleared = ((Flags & XAIELIB_ELF_LOAD_MEMCLEARED) != 0U) ? 1U : 0U;
+	u64 Addr;
+	u32 SegIdx;
+	u32 TileIdx;
+
+	XAie_AssertNonvoid(ImgPtr != XAIE_NULL);
+	XAie_AssertNonvoid(TileInstPtrs != XAIE_NULL);
+
+	for(TileIdx = 0U; TileIdx < NumTiles; TileIdx++) {
+		TileInstPtr = TileInstPtrs[TileIdx];
+
+		for(SegIdx = 0U; SegIdx < ImgPtr->NumSegs; SegIdx++) {
+			Seg = &ImgPtr->Segs[SegIdx];
+			if((Seg->Type == XAIELIB_ELF_SEG_BSS) &&
+					(MemCleared != 0U)) {
+				continue;
+			}
+
+			if(Seg->Type == XAIELIB_ELF_SEG_PRGMEM) {
+				Addr = TileInstPtr->TileAddr +
+					XAIEGBL_CORE_PRGMEM;
+			} else {
+				Addr = XAieLib_ElfBankTileAddr(TileInstPtr,
+						Seg->CardDir) +
+					XAIEGBL_MEM_DATMEM;
+			}
+
+			XAieLib_ElfWriteSeg(Addr + Seg->Offset, Seg->Data,
+					Seg->Size, MemCleared);
+		}
+	}
+
+	return XAIELIB_SUCCESS;
+}
+
+/** @} */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+
+
+/******************************************************************************/
+/**
+* @file xaielib_elf.h
+* @{
+*
+* Header file for the ELF image loader, which parses an ELF once and loads
+* it to a set of tiles.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0  ag      10/16/2026  Initial creation
+* </pre>
+*
+*******************************************************************************/
+#ifndef XAIELIB_ELF_H
+#define XAIELIB_ELF_H
+
+/***************************** Include Files *********************************/
+#include "xaiegbl.h"
+
+/***************************** Constant Definitions **************************/
+#ifndef XAIELIB_ELF_SEGS_MAX
+#define XAIELIB_ELF_SEGS_MAX		32U	/* Segments of an image */
+#endif
+
+#define XAIELIB_ELF_SEG_PRGMEM		0U	/* Program memory */
+#define XAIELIB_ELF_SEG_DATMEM		1U	/* Data memory */
+#define XAIELIB_ELF_SEG_BSS		2U	/* Data memory to be zeroed */
+
+/* XAieLib_ElfLoad() flags */
+#define XAIELIB_ELF_LOAD_MEMCLEARED	(1U << 0)	/* Memories are zero */
+
+/**************************** Type Definitions *******************************/
+/**
+ * This typedef contains a segment of an ELF image, within one program memory
+ * or one data memory bank.
+ */
+typedef struct {
+	u8 Type;		/**< XAIELIB_ELF_SEG_* */
+	u8 CardDir;		/**< Data memory bank: S, W, N or E */
+	u32 Offset;		/**< Offset in the program memory or bank */
+	u32 Size;		/**< Size in bytes */
+	const u8 *Data;		/**< Data in the ELF, NULL for BSS */
+} XAieLib_ElfSeg;
+
+/**
+ * This typedef contains the loadable segments of a parsed ELF. The segment
+ * data points into the ELF, which must be kept until the image is unused.
+ */
+typedef struct {
+	u32 NumSegs;				/**< Number of segments */
+	XAieLib_ElfSeg Segs[XAIELIB_ELF_SEGS_MAX];	/**< Segments */
+} XAieLib_ElfImage;
+
+/************************** Function Prototypes  *****************************/
+u32 XAieLib_ElfParse(XAieLib_ElfImage *ImgPtr, const u8 *ElfPtr);
+u32 XAieLib_ElfLoad(const XAieLib_ElfImage *ImgPtr,
+		XAieGbl_Tile **TileInstPtrs, u32 NumTiles, u32 Flags);
+
+#endif		/* end of protection macro */
+
+/** @} */
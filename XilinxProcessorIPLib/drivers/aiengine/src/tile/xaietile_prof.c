@@ -0,0 +1,592 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xaietile_prof.c
+* @{
+*
+* This file contains the performance counter profiling service. The same
+* counters are configured on a set of tiles in one call, then all of them
+* are sampled together into a ring buffer of timestamped samples, from
+* which ratios are derived and a trace is exported.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   ag      10/16/2026  Initial creation
+* 1.1   ag      10/16/2026  Sample at absolute deadlines, count overruns
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "xaiegbl.h"
+#include "xaiegbl_defs.h"
+#include "xaietile_core.h"
+#include "xaietile_perfcnt.h"
+#include "xaietile_pl.h"
+#include "xaietile_prof.h"
+
+/***************************** Macro Definitions *****************************/
+
+/************************** Variable Definitions *****************************/
+static const char *const XAieTileProf_ModName[] = { "core", "pl", "mem" };
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This is an internal API to check if a tile has the module of a counter.
+*
+* @param	TileInstPtr - Pointer to the Tile instance.
+* @param	Module - XAIETILE_PROF_MODULE_*.
+*
+* @return	1 if the tile has the module, 0 otherwise.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static u8 XAieTileProf_HasModule(XAieGbl_Tile *TileInstPtr, u8 Module)
+{
+	if(Module == XAIETILE_PROF_MODULE_PL) {
+		return (TileInstPtr->TileType != XAIEGBL_TILE_TYPE_AIETILE) ?
+			1U : 0U;
+	}
+
+	return (TileInstPtr->TileType == XAIEGBL_TILE_TYPE_AIETILE) ? 1U : 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is an internal API to return a sample of the ring buffer.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	SampleIdx - Index of the sample, 0 being the oldest.
+*
+* @return	Pointer to the sample.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static u32 *XAieTileProf_Slot(XAieTileProf *ProfPtr, u32 SampleIdx)
+{
+	u32 Slot;
+
+	Slot = (ProfPtr->Head + ProfPtr->NumSlots - ProfPtr->NumSamples +
+			SampleIdx) % ProfPtr->NumSlots;
+
+	return ProfPtr->Buf + Slot * ProfPtr->SampleWords;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API initializes a profiling instance for a set of tiles.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	TileInstPtrs - Array of pointers to the tile instances.
+* @param	NumTiles - Number of tiles.
+* @param	Buf - Ring buffer for the samples.
+* @param	BufWords - Size of the ring buffer in 32-bit words.
+*
+* @return	XAIE_SUCCESS on success, otherwise XAIE_FAILURE.
+*
+* @note		The timestamps are read from the timer of the first tile.
+*
+*******************************************************************************/
+u32 XAieTileProf_Init(XAieTileProf *ProfPtr, XAieGbl_Tile **TileInstPtrs,
+		u32 NumTiles, u32 *Buf, u32 BufWords)
+{
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+	XAie_AssertNonvoid(TileInstPtrs != XAIE_NULL);
+	XAie_AssertNonvoid(NumTiles > 0U);
+	XAie_AssertNonvoid(Buf != XAIE_NULL);
+
+	ProfPtr->TileInstPtrs = TileInstPtrs;
+	ProfPtr->NumTiles = NumTiles;
+	ProfPtr->NumCounters = 0U;
+	ProfPtr->TimerTilePtr = TileInstPtrs[0];
+	ProfPtr->Buf = Buf;
+	ProfPtr->BufWords = BufWords;
+	ProfPtr->SampleWords = XAIETILE_PROF_SAMPLE_HDR_WORDS;
+	ProfPtr->NumSlots = BufWords / ProfPtr->SampleWords;
+	ProfPtr->Head = 0U;
+	ProfPtr->NumSamples = 0U;
+	ProfPtr->Dropped = 0U;
+	ProfPtr->Overruns = 0U;
+
+	return (ProfPtr->NumSlots > 0U) ? XAIE_SUCCESS : XAIE_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API configures the counters on every tile of the set which has their
+* module, and empties the ring buffer.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	Counters - Counters and their events.
+* @param	NumCounters - Number of counters.
+*
+* @return	XAIE_SUCCESS on success, otherwise XAIE_FAILURE if the
+*		counters don't fit, or a sample doesn't fit in the buffer.
+*
+* @note		The value of a counter is 0 on tiles without its module.
+*
+*******************************************************************************/
+u32 XAieTileProf_Config(XAieTileProf *ProfPtr,
+		const XAieTileProf_Counter *Counters, u8 NumCounters)
+{
+	const XAieTileProf_Counter *Cnt;
+	XAieGbl_Tile *TileInstPtr;
+	u32 TileIdx;
+	u8 Idx;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+	XAie_AssertNonvoid(Counters != XAIE_NULL);
+
+	if(NumCounters > XAIETILE_PROF_COUNTERS_MAX) {
+		return XAIE_FAILURE;
+	}
+
+	ProfPtr->NumCounters = 0U;
+	for(Idx = 0U; Idx < NumCounters; Idx++) {
+		Cnt = &Counters[Idx];
+		if(Cnt->Module > XAIETILE_PROF_MODULE_MEM) {
+			return XAIE_FAILURE;
+		}
+		ProfPtr->Counters[Idx] = *Cnt;
+	}
+	ProfPtr->NumCounters = NumCounters;
+
+	ProfPtr->SampleWords = XAIETILE_PROF_SAMPLE_HDR_WORDS +
+		ProfPtr->NumTiles * NumCounters;
+	ProfPtr->NumSlots = ProfPtr->BufWords / ProfPtr->SampleWords;
+	ProfPtr->Head = 0U;
+	ProfPtr->NumSamples = 0U;
+	ProfPtr->Dropped = 0U;
+	ProfPtr->Overruns = 0U;
+	if(ProfPtr->NumSlots == 0U) {
+		return XAIE_FAILURE;
+	}
+
+	for(TileIdx = 0U; TileIdx < ProfPtr->NumTiles; TileIdx++) {
+		TileInstPtr = ProfPtr->TileInstPtrs[TileIdx];
+		for(Idx = 0U; Idx < NumCounters; Idx++) {
+			Cnt = &Counters[Idx];
+			if(XAieTileProf_HasModule(TileInstPtr,
+						Cnt->Module) == 0U) {
+				continue;
+			}
+
+			if(Cnt->Module == XAIETILE_PROF_MODULE_CORE) {
+				XAieTileCore_PerfCounterControl(TileInstPtr,
+						Cnt->Counter, Cnt->StartEvent,
+						Cnt->StopEvent,
+						Cnt->ResetEvent);
+			} else if(Cnt->Module == XAIETILE_PROF_MODULE_PL) {
+				XAieTilePl_PerfCounterControl(TileInstPtr,
+						Cnt->Counter, Cnt->StartEvent,
+						Cnt->StopEvent,
+						Cnt->ResetEvent);
+			} else {
+				XAieTileMem_PerfCounterControl(TileInstPtr,
+						Cnt->Counter, Cnt->StartEvent,
+						Cnt->StopEvent,
+						Cnt->ResetEvent);
+			}
+		}
+	}
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is an internal API to read the counters of a tile.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	TileInstPtr - Pointer to the Tile instance.
+* @param	Values - Counter values to be filled.
+*
+* @return	None.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static void XAieTileProf_ReadTile(XAieTileProf *ProfPtr,
+		XAieGbl_Tile *TileInstPtr, u32 *Values)
+{
+	const XAieTileProf_Counter *Cnt;
+	u8 Idx;
+
+	for(Idx = 0U; Idx < ProfPtr->NumCounters; Idx++) {
+		Cnt = &ProfPtr->Counters[Idx];
+		if(XAieTileProf_HasModule(TileInstPtr, Cnt->Module) == 0U) {
+			Values[Idx] = 0U;
+			continue;
+		}
+
+		if(Cnt->Module == XAIETILE_PROF_MODULE_CORE) {
+			Values[Idx] = XAieTileCore_PerfCounterGet(TileInstPtr,
+					Cnt->Counter);
+		} else if(Cnt->Module == XAIETILE_PROF_MODULE_PL) {
+			Values[Idx] = XAieTilePl_PerfCounterGet(TileInstPtr,
+					Cnt->Counter);
+		} else {
+			Values[Idx] = XAieTileMem_PerfCounterGet(TileInstPtr,
+					Cnt->Counter);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API takes a sample of all the counters of all the tiles into the ring
+* buffer. The oldest sample is overwritten when the buffer is full.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+*
+* @return	XAIE_SUCCESS on success, otherwise XAIE_FAILURE.
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieTileProf_Sample(XAieTileProf *ProfPtr)
+{
+	XAieGbl_Tile *TimerTilePtr;
+	u32 *Sample;
+	u64 Timestamp;
+	u32 TileIdx;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+
+	if(ProfPtr->NumCounters == 0U) {
+		return XAIE_FAILURE;
+	}
+
+	TimerTilePtr = ProfPtr->TimerTilePtr;
+	if(TimerTilePtr->TileType == XAIEGBL_TILE_TYPE_AIETILE) {
+		Timestamp = XAieTile_CoreReadTimer(TimerTilePtr);
+	} else {
+		Timestamp = XAieTile_PlReadTimer(TimerTilePtr);
+	}
+
+	Sample = ProfPtr->Buf + ProfPtr->Head * ProfPtr->SampleWords;
+	Sample[0U] = (u32)Timestamp;
+	Sample[1U] = (u32)(Timestamp >> 32U);
+	for(TileIdx = 0U; TileIdx < ProfPtr->NumTiles; TileIdx++) {
+		XAieTileProf_ReadTile(ProfPtr, ProfPtr->TileInstPtrs[TileIdx],
+				&Sample[XAIETILE_PROF_SAMPLE_HDR_WORDS +
+				TileIdx * ProfPtr->NumCounters]);
+	}
+
+	ProfPtr->Head = (ProfPtr->Head + 1U) % ProfPtr->NumSlots;
+	if(ProfPtr->NumSamples == ProfPtr->NumSlots) {
+		ProfPtr->Dropped++;
+	} else {
+		ProfPtr->NumSamples++;
+	}
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API takes samples at a fixed interval.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	IntervalUs - Interval between samples in microseconds.
+* @param	NumSamples - Number of samples to take.
+*
+* @return	XAIE_SUCCESS on success, otherwise XAIE_FAILURE.
+*
+* @note		Sample N is taken at the absolute deadline start + N *
+*		IntervalUs, so the time taken by the samples doesn't add to
+*		the interval. A sample whose deadline has already passed when
+*		the previous one completes is taken at once and counted in
+*		Overruns. The actual times are in the sample timestamps.
+*
+*******************************************************************************/
+u32 XAieTileProf_Run(XAieTileProf *ProfPtr, u32 IntervalUs, u32 NumSamples)
+{
+	u64 StartNs;
+	u64 DeadlineNs;
+	u32 Idx;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+
+	StartNs = XAieLib_GetTimeNs();
+	for(Idx = 0U; Idx < NumSamples; Idx++) {
+		if(Idx > 0U) {
+			DeadlineNs = StartNs + (u64)Idx * IntervalUs * 1000U;
+			if(XAieLib_GetTimeNs() > DeadlineNs) {
+				ProfPtr->Overruns++;
+			} else if(XAieLib_SleepUntilNs(DeadlineNs) != 0) {
+				return XAIE_FAILURE;
+			}
+		}
+		if(XAieTileProf_Sample(ProfPtr) != XAIE_SUCCESS) {
+			return XAIE_FAILURE;
+		}
+	}
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns a sample of the ring buffer.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	SampleIdx - Index of the sample, 0 being the oldest.
+* @param	TimestampPtr - Pointer to the timestamp, or XAIE_NULL.
+* @param	ValuesPtr - Pointer to the counter values of the sample, value
+*		of counter C on tile T being at T * NumCounters + C.
+*
+* @return	XAIE_SUCCESS on success, otherwise XAIE_FAILURE.
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieTileProf_GetSample(XAieTileProf *ProfPtr, u32 SampleIdx,
+		u64 *TimestampPtr, const u32 **ValuesPtr)
+{
+	u32 *Sample;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+
+	if(SampleIdx >= ProfPtr->NumSamples) {
+		return XAIE_FAILURE;
+	}
+
+	Sample = XAieTileProf_Slot(ProfPtr, SampleIdx);
+	if(TimestampPtr != XAIE_NULL) {
+		*TimestampPtr = ((u64)Sample[1U] << 32U) | Sample[0U];
+	}
+	if(ValuesPtr != XAIE_NULL) {
+		*ValuesPtr = &Sample[XAIETILE_PROF_SAMPLE_HDR_WORDS];
+	}
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the ratio of the increments of two counters of a tile
+* between two samples, ex the stall ratio from a counter of stall cycles
+* and a counter of active cycles. With XAIETILE_PROF_COUNTER_TIME as
+* denominator, this is the utilization over the elapsed time, ex of a DMA
+* channel from a counter of its busy cycles.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	FirstIdx - Index of the first sample.
+* @param	LastIdx - Index of the last sample.
+* @param	TileIdx - Index of the tile in the set.
+* @param	NumCounter - Index of the numerator counter.
+* @param	DenCounter - Index of the denominator counter, or
+*		XAIETILE_PROF_COUNTER_TIME.
+*
+* @return	Ratio in 1/XAIETILE_PROF_RATIO_SCALE, 0 if the denominator
+*		didn't increase or the arguments are invalid.
+*
+* @note		The counters are assumed to wrap at most once in between.
+*
+*******************************************************************************/
+u32 XAieTileProf_Ratio(XAieTileProf *ProfPtr, u32 FirstIdx, u32 LastIdx,
+		u32 TileIdx, u8 NumCounter, u8 DenCounter)
+{
+	u32 *First;
+	u32 *Last;
+	u32 Base;
+	u64 Num;
+	u64 Den;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+
+	if((FirstIdx >= LastIdx) || (LastIdx >= ProfPtr->NumSamples) ||
+			(TileIdx >= ProfPtr->NumTiles) ||
+			(NumCounter >= ProfPtr->NumCounters) ||
+			((DenCounter >= ProfPtr->NumCounters) &&
+			 (DenCounter != XAIETILE_PROF_COUNTER_TIME))) {
+		return 0U;
+	}
+
+	First = XAieTileProf_Slot(ProfPtr, FirstIdx);
+	Last = XAieTileProf_Slot(ProfPtr, LastIdx);
+	Base = XAIETILE_PROF_SAMPLE_HDR_WORDS + TileIdx * ProfPtr->NumCounters;
+
+	Num = (u32)(Last[Base + NumCounter] - First[Base + NumCounter]);
+	if(DenCounter == XAIETILE_PROF_COUNTER_TIME) {
+		Den = (((u64)Last[1U] << 32U) | Last[0U]) -
+			(((u64)First[1U] << 32U) | First[0U]);
+	} else {
+		Den = (u32)(Last[Base + DenCounter] -
+				First[Base + DenCounter]);
+	}
+	if(Den == 0U) {
+		return 0U;
+	}
+
+	return (u32)((Num * XAIETILE_PROF_RATIO_SCALE) / Den);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is an internal API to append formatted text to the trace buffer.
+*
+* @param	Buf - Trace buffer.
+* @param	Size - Size of the buffer.
+* @param	LenPtr - Pointer to the length of the trace, updated.
+* @param	Format - Format string.
+*
+* @return	XAIE_SUCCESS on success, otherwise XAIE_FAILURE if the text
+*		doesn't fit.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static u32 XAieTileProf_Emit(char *Buf, u32 Size, u32 *LenPtr,
+		const char *Format, ...)
+{
+	va_list Args;
+	int Ret;
+
+	va_start(Args, Format);
+	Ret = vsnprintf(Buf + *LenPtr, Size - *LenPtr, Format, Args);
+	va_end(Args);
+	if((Ret < 0) || ((u32)Ret >= (Size - *LenPtr))) {
+		return XAIE_FAILURE;
+	}
+	*LenPtr += (u32)Ret;
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API exports the samples in the Trace Event Format, loadable by the
+* trace viewers of the Chromium and Perfetto projects. There's one counter
+* track per tile, with the increment of each counter since the previous
+* sample. Timestamps are in timer cycles.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	Buf - Buffer for the trace, NUL terminated.
+* @param	Size - Size of the buffer.
+*
+* @return	Length of the trace, 0 if the buffer is too small.
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieTileProf_Export(XAieTileProf *ProfPtr, char *Buf, u32 Size)
+{
+	XAieGbl_Tile *TileInstPtr;
+	const XAieTileProf_Counter *Cnt;
+	u32 *Prev;
+	u32 *Cur;
+	u32 Base;
+	u32 Len = 0U;
+	u32 SampleIdx;
+	u32 TileIdx;
+	u64 Timestamp;
+	u8 Idx;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+	XAie_AssertNonvoid(Buf != XAIE_NULL);
+
+	if(Size == 0U) {
+		return 0U;
+	}
+
+	if(XAieTileProf_Emit(Buf, Size, &Len, "{\"traceEvents\":[") !=
+			XAIE_SUCCESS) {
+		return 0U;
+	}
+	for(SampleIdx = 1U; SampleIdx < ProfPtr->NumSamples; SampleIdx++) {
+		Prev = XAieTileProf_Slot(ProfPtr, SampleIdx - 1U);
+		Cur = XAieTileProf_Slot(ProfPtr, SampleIdx);
+		Timestamp = ((u64)Cur[1U] << 32U) | Cur[0U];
+
+		for(TileIdx = 0U; TileIdx < ProfPtr->NumTiles; TileIdx++) {
+			TileInstPtr = ProfPtr->TileInstPtrs[TileIdx];
+			Base = XAIETILE_PROF_SAMPLE_HDR_WORDS +
+				TileIdx * ProfPtr->NumCounters;
+
+			if(XAieTileProf_Emit(Buf, Size, &Len,
+					"%s{\"name\":\"tile_%u_%u\","
+					"\"ph\":\"C\",\"ts\":%llu,\"pid\":0,"
+					"\"args\":{",
+					((SampleIdx == 1U) && (TileIdx == 0U)) ?
+					"" : ",",
+					TileInstPtr->ColId, TileInstPtr->RowId,
+					(unsigned long long)Timestamp) !=
+					XAIE_SUCCESS) {
+				return 0U;
+			}
+			for(Idx = 0U; Idx < ProfPtr->NumCounters; Idx++) {
+				Cnt = &ProfPtr->Counters[Idx];
+				if(XAieTileProf_Emit(Buf, Size, &Len,
+						"%s\"%s%u\":%lu",
+						(Idx == 0U) ? "" : ",",
+						XAieTileProf_ModName[Cnt->Module],
+						Cnt->Counter,
+						(unsigned long)(u32)(Cur[Base + Idx] -
+							Prev[Base + Idx])) !=
+						XAIE_SUCCESS) {
+					return 0U;
+				}
+			}
+			if(XAieTileProf_Emit(Buf, Size, &Len, "}}") !=
+					XAIE_SUCCESS) {
+				return 0U;
+			}
+		}
+	}
+	if(XAieTileProf_Emit(Buf, Size, &Len,
+				"],\"displayTimeUnit\":\"ns\"}\n") !=
+			XAIE_SUCCESS) {
+		return 0U;
+	}
+
+	return Len;
+}
+
+/** @} */
@@ -0,0 +1,122 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xaietile_prof.h
+* @{
+*
+*  Header file for the performance counter profiling service
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0  ag      10/16/2026  Initial creation
+* 1.1  ag      10/16/2026  Count the samples taken after their deadline
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIETILE_PROF_H
+#define XAIETILE_PROF_H
+
+/***************************** Include Files *********************************/
+#include "xaiegbl.h"
+
+/***************************** Constant Definitions **************************/
+#define XAIETILE_PROF_MODULE_CORE		0U
+#define XAIETILE_PROF_MODULE_PL			1U
+#define XAIETILE_PROF_MODULE_MEM		2U
+
+#ifndef XAIETILE_PROF_COUNTERS_MAX
+#define XAIETILE_PROF_COUNTERS_MAX		8U
+#endif
+
+/* Sample layout: timestamp low and high words, then the counter values */
+#define XAIETILE_PROF_SAMPLE_HDR_WORDS		2U
+
+/* Denominator of XAieTileProf_Ratio() for the elapsed timer cycles */
+#define XAIETILE_PROF_COUNTER_TIME		0xFFU
+
+/* Ratios are in 1/XAIETILE_PROF_RATIO_SCALE */
+#define XAIETILE_PROF_RATIO_SCALE		10000U
+
+/***************************** Type Definitions ******************************/
+/**
+ * This typedef contains a performance counter and the events controlling it.
+ * A stall ratio is the ratio of a counter of stall cycles to a counter of
+ * active cycles, a DMA utilization the ratio of a counter of DMA busy cycles
+ * to XAIETILE_PROF_COUNTER_TIME.
+ */
+typedef struct {
+	u8 Module;		/**< XAIETILE_PROF_MODULE_* */
+	u8 Counter;		/**< Counter ID in the module */
+	u16 StartEvent;		/**< Event ID to start */
+	u16 StopEvent;		/**< Event ID to stop */
+	u16 ResetEvent;		/**< Event ID to reset */
+} XAieTileProf_Counter;
+
+/**
+ * This typedef contains the profiling instance: the tile set, its counters
+ * and the ring buffer of samples. A sample holds the timestamp and the value
+ * of each counter on each tile, tile by tile.
+ */
+typedef struct {
+	XAieGbl_Tile **TileInstPtrs;	/**< Tiles */
+	u32 NumTiles;			/**< Number of tiles */
+	XAieTileProf_Counter Counters[XAIETILE_PROF_COUNTERS_MAX]; /**< Counters */
+	u8 NumCounters;			/**< Number of counters */
+	XAieGbl_Tile *TimerTilePtr;	/**< Tile of the timestamp timer */
+	u32 *Buf;			/**< Ring buffer */
+	u32 BufWords;			/**< Size of the ring buffer in words */
+	u32 SampleWords;		/**< Size of a sample in words */
+	u32 NumSlots;			/**< Number of samples in the buffer */
+	u32 Head;			/**< Slot of the next sample */
+	u32 NumSamples;			/**< Number of samples in the buffer */
+	u32 Dropped;			/**< Number of samples overwritten */
+	u32 Overruns;			/**< Samples of XAieTileProf_Run()
+					  taken after their deadline */
+} XAieTileProf;
+
+/***************************** Macro Definitions *****************************/
+
+/************************** Function Prototypes  *****************************/
+u32 XAieTileProf_Init(XAieTileProf *ProfPtr, XAieGbl_Tile **TileInstPtrs,
+		u32 NumTiles, u32 *Buf, u32 BufWords);
+u32 XAieTileProf_Config(XAieTileProf *ProfPtr,
+		const XAieTileProf_Counter *Counters, u8 NumCounters);
+u32 XAieTileProf_Sample(XAieTileProf *ProfPtr);
+u32 XAieTileProf_Run(XAieTileProf *ProfPtr, u32 IntervalUs, u32 NumSamples);
+u32 XAieTileProf_GetSample(XAieTileProf *ProfPtr, u32 SampleIdx,
+		u64 *TimestampPtr, const u32 **ValuesPtr);
+u32 XAieTileProf_Ratio(XAieTileProf *ProfPtr, u32 FirstIdx, u32 LastIdx,
+		u32 TileIdx, u8 NumCounter, u8 DenCounter);
+u32 XAieTileProf_Export(XAieTileProf *ProfPtr, char *Buf, u32 Size);
+
+#endif		/* end of protection macro */
+
+/** @} */
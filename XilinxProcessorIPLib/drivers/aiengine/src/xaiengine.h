@@ -6,6 +6,7 @@
 #include <xaiengine/xaiegbl_params.h>
 #include <xaiengine/xaiegbl_reginit.h>
 #include <xaiengine/xaielib.h>
+#include <xaiengine/xaielib_elf.h>
 #include <xaiengine/xaielib_npi.h>
 #include <xaiengine/xaietile_core.h>
 #include <xaiengine/xaietile_event.h>
@@ -14,6 +15,7 @@
 #include <xaiengine/xaietile_noc.h>
 #include <xaiengine/xaietile_perfcnt.h>
 #include <xaiengine/xaietile_pl.h>
+#include <xaiengine/xaietile_prof.h>
 #include <xaiengine/xaietile_plif.h>
 #include <xaiengine/xaietile_shim.h>
 #include <xaiengine/xaietile_strm.h>
@@ -0,0 +1,247 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file aiesim_mock.c
+*
+* Register space model implementing the AIE simulator interface. The sparse
+* register space is an open addressing hash table of the registers written.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+#include <string.h>
+#include "xaiesim.h"
+#include "aiesim_mock.h"
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u64 Addr;		/**< Register address */
+	u32 Value;		/**< Register value */
+	u8 Used;		/**< Slot holds a register */
+} AieMock_Reg;
+
+/************************** Variable Definitions *****************************/
+
+AieMock_Count AieMockCount;
+u32 AieMock_ReadDelayUs;
+
+static AieMock_Reg Regs[AIEMOCK_MAX_REGS];
+static u32 NumRegs;
+
+/*****************************************************************************/
+static AieMock_Reg *AieMock_Lookup(u64 Addr, u8 Create)
+{
+	u32 Slot = (u32)((Addr >> 2) * 0x9E3779B1U) & (AIEMOCK_MAX_REGS - 1U);
+
+	while (Regs[Slot].Used != 0U) {
+		if (Regs[Slot].Addr == Addr) {
+			return &Regs[Slot];
+		}
+		Slot = (Slot + 1U) & (AIEMOCK_MAX_REGS - 1U);
+	}
+	if (Create == 0U) {
+		return NULL;
+	}
+	if (NumRegs == AIEMOCK_MAX_REGS - 1U) {
+		printf("aiesim_mock: register space full\n");
+		exit(1);
+	}
+	Regs[Slot].Used = 1U;
+	Regs[Slot].Addr = Addr;
+	Regs[Slot].Value = 0U;
+	NumRegs++;
+
+	return &Regs[Slot];
+}
+
+void AieMock_Reset(void)
+{
+	(void)memset(Regs, 0, sizeof(Regs));
+	NumRegs = 0U;
+	AieMock_ReadDelayUs = 0U;
+	AieMock_ResetCount();
+}
+
+void AieMock_ResetCount(void)
+{
+	(void)memset(&AieMockCount, 0, sizeof(AieMockCount));
+}
+
+/* Register value, without counting a read */
+u32 AieMock_Peek(u64 Addr)
+{
+	AieMock_Reg *Reg = AieMock_Lookup(Addr, 0U);
+
+	return (Reg != NULL) ? Reg->Value : 0U;
+}
+
+/* Set a register, without counting a write */
+void AieMock_Poke(u64 Addr, u32 Data)
+{
+	AieMock_Lookup(Addr, 1U)->Value = Data;
+}
+
+/* Number of registers written since the last reset */
+u32 AieMock_NumRegs(void)
+{
+	return NumRegs;
+}
+
+/* Writes of any kind, each one bus transaction */
+u32 AieMock_Writes(void)
+{
+	return AieMockCount.Write32 + AieMockCount.Write128 +
+		AieMockCount.MaskWrite32;
+}
+
+/* Copy the registers written, returns their number */
+u32 AieMock_Snapshot(u64 *Addrs, u32 *Values, u32 MaxRegs)
+{
+	u32 Slot, Num = 0U;
+
+	for (Slot = 0U; Slot < AIEMOCK_MAX_REGS && Num < MaxRegs; Slot++) {
+		if (Regs[Slot].Used != 0U) {
+			Addrs[Num] = Regs[Slot].Addr;
+			Values[Num] = Regs[Slot].Value;
+			Num++;
+		}
+	}
+
+	return Num;
+}
+
+/* Number of differences between the registers and a snapshot */
+u32 AieMock_Compare(const u64 *Addrs, const u32 *Values, u32 Num)
+{
+	u32 Idx, Diff = 0U;
+
+	for (Idx = 0U; Idx < Num; Idx++) {
+		if (AieMock_Peek(Addrs[Idx]) != Values[Idx]) {
+			Diff++;
+		}
+	}
+	if (NumRegs != Num) {
+		Diff += (NumRegs > Num) ? NumRegs - Num : Num - NumRegs;
+	}
+
+	return Diff;
+}
+
+/*****************************************************************************/
+int XAieSim_usleep(u64 Usec)
+{
+	(void)Usec;
+	return 0;
+}
+
+u32 XAieSim_LoadElf(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym)
+{
+	(void)TileInstPtr;
+	(void)ElfPtr;
+	(void)LoadSym;
+	return XAIESIM_FAILURE;
+}
+
+u32 XAieSim_Read32(u64 Addr)
+{
+	u64 EndNs;
+
+	if (AieMock_ReadDelayUs != 0U) {
+		EndNs = XAieLib_GetTimeNs() + AieMock_ReadDelayUs * 1000ULL;
+		while (XAieLib_GetTimeNs() < EndNs) {
+		}
+	}
+	AieMockCount.Read32++;
+	return AieMock_Peek(Addr);
+}
+
+void XAieSim_Write32(u64 Addr, u32 Data)
+{
+	AieMockCount.Write32++;
+	AieMock_Poke(Addr, Data);
+}
+
+void XAieSim_MaskWrite32(u64 Addr, u32 Mask, u32 Data)
+{
+	AieMock_Reg *Reg = AieMock_Lookup(Addr, 1U);
+
+	AieMockCount.MaskWrite32++;
+	Reg->Value = (Reg->Value & ~Mask) | Data;
+}
+
+void XAieSim_Write128(u64 Addr, u32 *Data)
+{
+	u32 Idx;
+
+	AieMockCount.Write128++;
+	for (Idx = 0U; Idx < 4U; Idx++) {
+		AieMock_Poke(Addr + Idx * 4U, Data[Idx]);
+	}
+}
+
+void XAieSim_WriteCmd(u8 Command, u8 ColId, u8 RowId, u32 CmdWd0,
+		u32 CmdWd1, u8 *CmdStr)
+{
+	(void)Command;
+	(void)ColId;
+	(void)RowId;
+	(void)CmdWd0;
+	(void)CmdWd1;
+	(void)CmdStr;
+	AieMockCount.WriteCmd++;
+}
+
+u32 XAieSim_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs)
+{
+	(void)TimeOutUs;
+	AieMockCount.MaskPoll++;
+	return ((AieMock_Peek(Addr) & Mask) == Value) ?
+		XAIESIM_SUCCESS : XAIESIM_FAILURE;
+}
+
+u32 XAieSim_NPIRead32(u64 Addr)
+{
+	return XAieSim_Read32(Addr);
+}
+
+void XAieSim_NPIWrite32(u64 Addr, u32 Data)
+{
+	XAieSim_Write32(Addr, Data);
+}
+
+void XAieSim_NPIMaskWrite32(u64 Addr, u32 Mask, u32 Data)
+{
+	XAieSim_MaskWrite32(Addr, Mask, Data);
+}
+
+u32 XAieSim_NPIMaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs)
+{
+	return XAieSim_MaskPoll(Addr, Mask, Value, TimeOutUs);
+}
@@ -0,0 +1,85 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file aiesim_mock.h
+*
+* Register space model behind the AIE simulator interface, for host builds of
+* the driver with __AIESIM__. Every register reads back the last value
+* written, 0 if never written. The model counts the accesses per kind, so
+* that tests can check how many bus transactions a driver call costs:
+*
+* - XAieSim_Write32() and XAieSim_Write128() each count as one write, a
+*   128-bit write being one burst on the AXI bus.
+* - XAieSim_MaskWrite32() counts as one mask write, XAieSim_Read32() as one
+*   read and XAieSim_MaskPoll() as one poll. A poll checks the register
+*   once: it fails when the register does not match yet.
+*
+* NPI registers share the register space with the array. Reads can be made
+* slow with AieMock_ReadDelayUs, to time driver calls doing many reads.
+*
+******************************************************************************/
+#ifndef AIESIM_MOCK_H
+#define AIESIM_MOCK_H
+
+#include "xaielib.h"
+
+/************************** Constant Definitions *****************************/
+
+#define AIEMOCK_MAX_REGS	(1U << 17)	/**< Registers held by the model */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Access counts of the model.
+ */
+typedef struct {
+	u32 Write32;		/**< 32-bit writes */
+	u32 Write128;		/**< 128-bit writes */
+	u32 MaskWrite32;	/**< Mask writes */
+	u32 Read32;		/**< 32-bit reads */
+	u32 MaskPoll;		/**< Polls */
+	u32 WriteCmd;		/**< Simulator commands */
+} AieMock_Count;
+
+/************************** Variable Definitions *****************************/
+
+extern AieMock_Count AieMockCount;
+extern u32 AieMock_ReadDelayUs;	/**< Busy wait of each read, 0 by default */
+
+/************************** Function Prototypes ******************************/
+
+void AieMock_Reset(void);
+void AieMock_ResetCount(void);
+u32 AieMock_Peek(u64 Addr);
+void AieMock_Poke(u64 Addr, u32 Data);
+u32 AieMock_NumRegs(void);
+u32 AieMock_Compare(const u64 *Addrs, const u32 *Values, u32 NumRegs);
+u32 AieMock_Snapshot(u64 *Addrs, u32 *Values, u32 MaxRegs);
+u32 AieMock_Writes(void);
+
+#endif
@@ -0,0 +1,59 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xaiesim.h
+*
+* Host replacement of the AIE simulator interface the driver is built
+* against with __AIESIM__. The functions are implemented by the register
+* model in aiesim_mock.c.
+*
+******************************************************************************/
+#ifndef XAIESIM_H
+#define XAIESIM_H
+
+#include <stdio.h>
+#include "xaiegbl.h"
+
+#define XAIESIM_SUCCESS		0U
+#define XAIESIM_FAILURE		1U
+
+int XAieSim_usleep(u64 Usec);
+u32 XAieSim_LoadElf(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym);
+u32 XAieSim_Read32(u64 Addr);
+void XAieSim_Write32(u64 Addr, u32 Data);
+void XAieSim_MaskWrite32(u64 Addr, u32 Mask, u32 Data);
+void XAieSim_Write128(u64 Addr, u32 *Data);
+void XAieSim_WriteCmd(u8 Command, u8 ColId, u8 RowId, u32 CmdWd0,
+		u32 CmdWd1, u8 *CmdStr);
+u32 XAieSim_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs);
+u32 XAieSim_NPIRead32(u64 Addr);
+void XAieSim_NPIWrite32(u64 Addr, u32 Data);
+void XAieSim_NPIMaskWrite32(u64 Addr, u32 Mask, u32 Data);
+u32 XAieSim_NPIMaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs);
+
+#endif
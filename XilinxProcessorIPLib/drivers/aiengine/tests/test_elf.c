@@ -0,0 +1,369 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file test_elf.c
+*
+* Host test of the ELF image loader (xaielib_elf.c) against the register
+* space model in aiesim_mock.c. An ELF with program memory, data memory
+* sections in the four cardinal directions, one of them across a bank
+* boundary and one of them unaligned, and a BSS section is built in memory.
+* It is loaded on a 4x4 block of tiles with XAieLib_ElfLoad() and with a
+* reference loader writing one 32-bit word at a time, tile after tile. Both
+* must leave the same memory contents, and the number of register writes of
+* XAieLib_ElfLoad() is checked against the segment layout.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <string.h>
+#include "xaiegbl.h"
+#include "xaielib.h"
+#include "xaielib_elf.h"
+#include "aiesim_mock.h"
+
+/************************** Constant Definitions *****************************/
+
+#define TEST_ROWS		4U	/**< Rows of tiles loaded, from row 1 */
+#define TEST_COLS		4U	/**< Columns of tiles loaded */
+#define TEST_TILES		(TEST_ROWS * TEST_COLS)
+
+#define TEST_SHT_PROGBITS	1U
+#define TEST_SHT_STRTAB		3U
+#define TEST_SHT_NOBITS		8U
+#define TEST_SHF_WA		0x3U	/**< Write, alloc */
+#define TEST_SHF_AX		0x6U	/**< Alloc, exec */
+
+#define TEST_PRGMEM_SIZE	4096U
+#define TEST_MAX_REGS		(64U * 1024U)
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CHECK(Cond)	Test_Check((Cond) ? 1U : 0U, #Cond, __LINE__)
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u8 e_ident[16];
+	u16 e_type;
+	u16 e_machine;
+	u32 e_version;
+	u32 e_entry;
+	u32 e_phoff;
+	u32 e_shoff;
+	u32 e_flags;
+	u16 e_ehsize;
+	u16 e_phentsize;
+	u16 e_phnum;
+	u16 e_shentsize;
+	u16 e_shnum;
+	u16 e_shstrndx;
+} Test_Ehdr;
+
+typedef struct {
+	u32 sh_name;
+	u32 sh_type;
+	u32 sh_flags;
+	u32 sh_addr;
+	u32 sh_offset;
+	u32 sh_size;
+	u32 sh_link;
+	u32 sh_info;
+	u32 sh_addralign;
+	u32 sh_entsize;
+} Test_Shdr;
+
+/* Section of the test ELF, in core address space */
+typedef struct {
+	const char *Name;
+	u32 Type;
+	u32 Flags;
+	u32 Addr;
+	u32 Size;
+} Test_Section;
+
+/************************** Variable Definitions *****************************/
+
+/*
+ * Data memory banks are at 0x20000 (south), 0x28000 (west), 0x30000 (north)
+ * and 0x38000 (east). The west and east sections overlap in the memory of
+ * the tiles they share, so the order of the tile loads matters.
+ */
+static const Test_Section Sections[] = {
+	{ "", 0U, 0U, 0U, 0U },
+	{ ".text", TEST_SHT_PROGBITS, TEST_SHF_AX, 0x0U, TEST_PRGMEM_SIZE },
+	{ ".data.DMb.bank1", TEST_SHT_PROGBITS, TEST_SHF_WA, 0x28010U, 64U },
+	{ ".data.DMb.bank3", TEST_SHT_PROGBITS, TEST_SHF_WA, 0x38020U, 64U },
+	{ ".rodata.DMb.bank0", TEST_SHT_PROGBITS, TEST_SHF_WA, 0x27FF0U, 48U },
+	{ ".data.DMb.bank2", TEST_SHT_PROGBITS, TEST_SHF_WA, 0x30104U, 22U },
+	{ ".bss.DMb.bank2", TEST_SHT_NOBITS, TEST_SHF_WA, 0x30400U, 1024U },
+	{ ".comment", TEST_SHT_PROGBITS, 0U, 0U, 16U },
+	{ ".shstrtab", TEST_SHT_STRTAB, 0U, 0U, 0U },
+};
+
+#define TEST_NUM_SECTIONS	(sizeof(Sections) / sizeof(Sections[0]))
+
+static u32 Failures;
+static u8 Elf[16U * 1024U] __attribute__((aligned(8)));
+static XAieGbl_Tile Tiles[TEST_TILES];
+static XAieGbl_Tile *TilePtrs[TEST_TILES];
+static u64 RefAddrs[TEST_MAX_REGS];
+static u32 RefValues[TEST_MAX_REGS];
+
+/*****************************************************************************/
+static void Test_Check(u32 Ok, const char *Cond, int Line)
+{
+	if (Ok == 0U) {
+		printf("  FAIL line %d: %s\n", Line, Cond);
+		Failures++;
+	}
+}
+
+/*
+ * Build the ELF: the section contents follow the file header, then come the
+ * section names and the section headers. Every 8th 16 byte block of the
+ * program is zero, the data bytes are never zero.
+ */
+static void Test_BuildElf(void)
+{
+	Test_Ehdr *Ehdr = (Test_Ehdr *)Elf;
+	Test_Shdr Shdr[TEST_NUM_SECTIONS];
+	u32 Off = sizeof(*Ehdr), Idx, Byte, NameOff = 0U;
+	char Names[256];
+
+	(void)memset(Elf, 0, sizeof(Elf));
+	(void)memset(Shdr, 0, sizeof(Shdr));
+	for (Idx = 0U; Idx < TEST_NUM_SECTIONS; Idx++) {
+		Shdr[Idx].sh_name = NameOff;
+		(void)strcpy(&Names[NameOff], Sections[Idx].Name);
+		NameOff += strlen(Sections[Idx].Name) + 1U;
+
+		Off = (Off + 15U) & ~15U;
+		Shdr[Idx].sh_type = Sections[Idx].Type;
+		Shdr[Idx].sh_flags = Sections[Idx].Flags;
+		Shdr[Idx].sh_addr = Sections[Idx].Addr;
+		Shdr[Idx].sh_offset = Off;
+		Shdr[Idx].sh_size = Sections[Idx].Size;
+		if (Sections[Idx].Type != TEST_SHT_PROGBITS) {
+			continue;
+		}
+		for (Byte = 0U; Byte < Sections[Idx].Size; Byte++) {
+			if ((Idx == 1U) && ((Byte / 16U) % 8U) == 7U) {
+				continue;
+			}
+			Elf[Off + Byte] = (u8)(((Idx * 37U + Byte) % 255U) + 1U);
+		}
+		Off += Sections[Idx].Size;
+	}
+
+	/* Section names */
+	Shdr[TEST_NUM_SECTIONS - 1U].sh_offset = Off;
+	Shdr[TEST_NUM_SECTIONS - 1U].sh_size = NameOff;
+	(void)memcpy(&Elf[Off], Names, NameOff);
+	Off = (Off + NameOff + 15U) & ~15U;
+
+	(void)memcpy(Ehdr->e_ident, "\177ELF", 4U);
+	Ehdr->e_ident[4] = 1U;
+	Ehdr->e_ident[5] = 1U;
+	Ehdr->e_type = 2U;
+	Ehdr->e_ehsize = sizeof(*Ehdr);
+	Ehdr->e_shoff = Off;
+	Ehdr->e_shentsize = sizeof(Test_Shdr);
+	Ehdr->e_shnum = TEST_NUM_SECTIONS;
+	Ehdr->e_shstrndx = TEST_NUM_SECTIONS - 1U;
+	(void)memcpy(&Elf[Off], Shdr, sizeof(Shdr));
+}
+
+static void Test_InitTiles(void)
+{
+	u32 Row, Col;
+	XAieGbl_Tile *Tile;
+
+	for (Row = 0U; Row < TEST_ROWS; Row++) {
+		for (Col = 0U; Col < TEST_COLS; Col++) {
+			Tile = &Tiles[Row * TEST_COLS + Col];
+			(void)memset(Tile, 0, sizeof(*Tile));
+			Tile->RowId = Row + 1U;
+			Tile->ColId = Col;
+			Tile->TileType = XAIEGBL_TILE_TYPE_AIETILE;
+			Tile->TileAddr = ((u64)Col << XAIEGBL_TILE_ADDR_COL_SHIFT) |
+				((u64)(Row + 1U) << XAIEGBL_TILE_ADDR_ROW_SHIFT);
+			TilePtrs[Row * TEST_COLS + Col] = Tile;
+		}
+	}
+}
+
+/*
+ * Tile owning the data memory in a cardinal direction: the tile below and
+ * the tile above for south and north, the tile on the left on odd rows for
+ * west and the tile on the right on even rows for east, else the tile
+ * itself.
+ */
+static u64 Test_BankTile(const XAieGbl_Tile *Tile, u32 Addr)
+{
+	u32 Row = Tile->RowId, Col = Tile->ColId;
+
+	switch ((Addr >> 15) & 0x3U) {
+	case 0U:
+		Row -= 1U;
+		break;
+	case 1U:
+		Col -= ((Row & 1U) != 0U && Col > 0U) ? 1U : 0U;
+		break;
+	case 2U:
+		Row += 1U;
+		break;
+	default:
+		Col += ((Row & 1U) == 0U) ? 1U : 0U;
+		break;
+	}
+
+	return ((u64)Col << XAIEGBL_TILE_ADDR_COL_SHIFT) |
+		((u64)Row << XAIEGBL_TILE_ADDR_ROW_SHIFT);
+}
+
+/* Per-tile loader writing one 32-bit word at a time */
+static void Test_RefLoad(void)
+{
+	const Test_Shdr *Shdr;
+	const Test_Ehdr *Ehdr = (const Test_Ehdr *)Elf;
+	u32 Tile, Idx, Word, Addr, Value;
+	u64 RegAddr;
+
+	Shdr = (const Test_Shdr *)&Elf[Ehdr->e_shoff];
+	for (Tile = 0U; Tile < TEST_TILES; Tile++) {
+		for (Idx = 1U; Idx < 7U; Idx++) {
+			for (Word = 0U; Word < Shdr[Idx].sh_size; Word += 4U) {
+				Value = 0U;
+				if (Shdr[Idx].sh_type == TEST_SHT_PROGBITS) {
+					(void)memcpy(&Value,
+						&Elf[Shdr[Idx].sh_offset + Word],
+						(Shdr[Idx].sh_size - Word < 4U) ?
+						Shdr[Idx].sh_size - Word : 4U);
+				}
+				Addr = Shdr[Idx].sh_addr + Word;
+				if (Shdr[Idx].sh_flags == TEST_SHF_AX) {
+					RegAddr = Tiles[Tile].TileAddr +
+						XAIEGBL_CORE_PRGMEM + Addr;
+				} else {
+					RegAddr = Test_BankTile(&Tiles[Tile],
+						Addr) + XAIEGBL_MEM_DATMEM +
+						(Addr & 0x7FFFU);
+				}
+				XAieLib_Write32(RegAddr, Value);
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+static void Test_Parse(void)
+{
+	XAieLib_ElfImage Img;
+
+	printf("parse\n");
+	CHECK(XAieLib_ElfParse(&Img, Elf) == XAIELIB_SUCCESS);
+	CHECK(Img.NumSegs == 7U);
+	CHECK(Img.Segs[0].Type == XAIELIB_ELF_SEG_PRGMEM);
+	CHECK(Img.Segs[0].Size == TEST_PRGMEM_SIZE);
+	CHECK(Img.Segs[1].Type == XAIELIB_ELF_SEG_DATMEM);
+	CHECK(Img.Segs[1].CardDir == 1U && Img.Segs[1].Offset == 0x10U);
+	CHECK(Img.Segs[2].CardDir == 3U && Img.Segs[2].Offset == 0x20U);
+	/* Split at the bank boundary */
+	CHECK(Img.Segs[3].CardDir == 0U && Img.Segs[3].Offset == 0x7FF0U);
+	CHECK(Img.Segs[3].Size == 16U);
+	CHECK(Img.Segs[4].CardDir == 1U && Img.Segs[4].Offset == 0U);
+	CHECK(Img.Segs[4].Size == 32U);
+	CHECK(Img.Segs[4].Data == Img.Segs[3].Data + 16U);
+	CHECK(Img.Segs[5].CardDir == 2U && Img.Segs[5].Size == 22U);
+	CHECK(Img.Segs[6].Type == XAIELIB_ELF_SEG_BSS);
+	CHECK(Img.Segs[6].Data == NULL && Img.Segs[6].Size == 1024U);
+
+	Elf[1] = 'X';
+	CHECK(XAieLib_ElfParse(&Img, Elf) == XAIELIB_FAILURE);
+	Elf[1] = 'E';
+}
+
+static void Test_Load(void)
+{
+	XAieLib_ElfImage Img;
+	u32 NumRegs, RefWrites, Idx, NonZero = 0U;
+
+	printf("load on %u tiles\n", TEST_TILES);
+	AieMock_Reset();
+	Test_RefLoad();
+	RefWrites = AieMock_Writes();
+	NumRegs = AieMock_Snapshot(RefAddrs, RefValues, TEST_MAX_REGS);
+	CHECK(NumRegs < TEST_MAX_REGS);
+	printf("  32-bit loader: %u writes\n", RefWrites);
+
+	AieMock_Reset();
+	CHECK(XAieLib_ElfParse(&Img, Elf) == XAIELIB_SUCCESS);
+	CHECK(XAieLib_ElfLoad(&Img, TilePtrs, TEST_TILES, 0U) ==
+			XAIELIB_SUCCESS);
+	printf("  image loader:  %u writes (%u of 128 bits)\n",
+			AieMock_Writes(), AieMockCount.Write128);
+	CHECK(AieMock_Compare(RefAddrs, RefValues, NumRegs) == 0U);
+	CHECK(AieMockCount.Read32 == 0U);
+	CHECK(AieMockCount.MaskWrite32 == 0U);
+	/*
+	 * Per tile: 256 + 4 + 4 + 1 + 2 + 64 128-bit writes and 6 32-bit
+	 * writes for the unaligned 22 bytes.
+	 */
+	CHECK(AieMockCount.Write128 == TEST_TILES * 331U);
+	CHECK(AieMockCount.Write32 == TEST_TILES * 6U);
+
+	/* The memories are zero: BSS and zero blocks are skipped */
+	AieMock_Reset();
+	CHECK(XAieLib_ElfLoad(&Img, TilePtrs, TEST_TILES,
+			XAIELIB_ELF_LOAD_MEMCLEARED) == XAIELIB_SUCCESS);
+	printf("  memory cleared: %u writes\n", AieMock_Writes());
+	for (Idx = 0U; Idx < NumRegs; Idx++) {
+		CHECK(AieMock_Peek(RefAddrs[Idx]) == RefValues[Idx]);
+		NonZero += (RefValues[Idx] != 0U) ? 1U : 0U;
+	}
+	CHECK(AieMock_NumRegs() == NonZero);
+	CHECK(AieMockCount.Write128 == TEST_TILES * (224U + 4U + 4U + 1U +
+				2U));
+	CHECK(AieMockCount.Write32 == TEST_TILES * 6U);
+}
+
+int main(void)
+{
+	Test_BuildElf();
+	Test_InitTiles();
+	Test_Parse();
+	Test_Load();
+
+	if (Failures != 0U) {
+		printf("test_elf: %u check(s) failed\n", Failures);
+		return 1;
+	}
+	printf("test_elf: all checks passed\n");
+	return 0;
+}
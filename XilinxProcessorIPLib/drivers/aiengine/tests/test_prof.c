@@ -0,0 +1,471 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file test_prof.c
+*
+* Host test of the performance counter profiling service (xaietile_prof.c)
+* against the register space model in aiesim_mock.c, on four AIE tiles and a
+* shim tile. The counter and timer registers are set directly in the model
+* between samples. It checks the control registers programmed on the tiles
+* having each counter's module, the sample layout and its register reads,
+* the ring buffer wrap-around, the ratios from counter increments, including
+* a counter wrapping, the exported trace, and the periodic sampling at
+* absolute deadlines with slow register reads.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <string.h>
+#include "xaiegbl.h"
+#include "xaiegbl_reginit.h"
+#include "xaietile_perfcnt.h"
+#include "xaietile_prof.h"
+#include "aiesim_mock.h"
+
+/************************** Constant Definitions *****************************/
+
+#define TEST_AIE_TILES		4U	/**< AIE tiles, row 1 */
+#define TEST_TILES		(TEST_AIE_TILES + 1U)	/**< Plus a shim */
+#define TEST_SHIM		TEST_AIE_TILES	/**< Index of the shim */
+
+/* Counters of the test, in XAieTileProf_Config() order */
+#define TEST_ACTIVE		0U	/**< Core active cycles */
+#define TEST_STALL		1U	/**< Core stall cycles */
+#define TEST_DMA		2U	/**< Memory DMA busy cycles */
+#define TEST_PL			3U	/**< PL stream cycles */
+#define TEST_COUNTERS		4U
+
+#define TEST_SAMPLE_WORDS	(XAIETILE_PROF_SAMPLE_HDR_WORDS + \
+				 TEST_TILES * TEST_COUNTERS)
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CHECK(Cond)	Test_Check((Cond) ? 1U : 0U, #Cond, __LINE__)
+
+/************************** Variable Definitions *****************************/
+
+extern XAieGbl_RegTimer TimerReg[];
+extern XAieGbl_RegPerfCtrls PerfCtrl[];
+extern XAieGbl_RegPerfCtrlReset PerfCtrlReset[];
+extern XAieGbl_RegPerfCounter PerfCounter[];
+
+static const XAieTileProf_Counter Counters[TEST_COUNTERS] = {
+	{ XAIETILE_PROF_MODULE_CORE, 0U, 28U, 29U, 30U },
+	{ XAIETILE_PROF_MODULE_CORE, 1U, 23U, 24U,
+		XAIETILE_PERFCNT_EVENT_INVALID },
+	{ XAIETILE_PROF_MODULE_MEM, 0U, 21U, 22U, 1U },
+	{ XAIETILE_PROF_MODULE_PL, 0U, 11U, 12U, 13U },
+};
+
+static u32 Failures;
+static XAieGbl_Tile Tiles[TEST_TILES];
+static XAieGbl_Tile *TilePtrs[TEST_TILES];
+static u32 Buf[8U * TEST_SAMPLE_WORDS];
+static char Trace[4096];
+
+/*****************************************************************************/
+static void Test_Check(u32 Ok, const char *Cond, int Line)
+{
+	if (Ok == 0U) {
+		printf("  FAIL line %d: %s\n", Line, Cond);
+		Failures++;
+	}
+}
+
+static void Test_InitTiles(void)
+{
+	u32 Idx;
+
+	for (Idx = 0U; Idx < TEST_TILES; Idx++) {
+		(void)memset(&Tiles[Idx], 0, sizeof(Tiles[Idx]));
+		if (Idx == TEST_SHIM) {
+			Tiles[Idx].RowId = 0U;
+			Tiles[Idx].ColId = 0U;
+			Tiles[Idx].TileType = XAIEGBL_TILE_TYPE_SHIMNOC;
+		} else {
+			Tiles[Idx].RowId = 1U;
+			Tiles[Idx].ColId = Idx;
+			Tiles[Idx].TileType = XAIEGBL_TILE_TYPE_AIETILE;
+		}
+		Tiles[Idx].TileAddr =
+			((u64)Tiles[Idx].ColId << XAIEGBL_TILE_ADDR_COL_SHIFT) |
+			((u64)Tiles[Idx].RowId << XAIEGBL_TILE_ADDR_ROW_SHIFT);
+		TilePtrs[Idx] = &Tiles[Idx];
+	}
+}
+
+static u64 Test_CounterAddr(u32 Tile, u32 Cnt)
+{
+	return Tiles[Tile].TileAddr +
+		PerfCounter[Counters[Cnt].Module].RegOff[Counters[Cnt].Counter];
+}
+
+/* Set the timer of the first tile, which timestamps the samples */
+static void Test_SetTimer(u64 Time)
+{
+	u64 Addr = Tiles[0].TileAddr;
+
+	AieMock_Poke(Addr + TimerReg[XAIETILE_TIMER_MODULE_CORE].LowOff,
+			(u32)Time);
+	AieMock_Poke(Addr + TimerReg[XAIETILE_TIMER_MODULE_CORE].HighOff,
+			(u32)(Time >> 32));
+}
+
+/* Set a counter on every tile having it, to Value plus the tile index */
+static void Test_SetCounter(u32 Cnt, u32 Value)
+{
+	u32 Tile;
+
+	for (Tile = 0U; Tile < TEST_TILES; Tile++) {
+		if ((Counters[Cnt].Module == XAIETILE_PROF_MODULE_PL) ==
+				(Tile == TEST_SHIM)) {
+			AieMock_Poke(Test_CounterAddr(Tile, Cnt), Value + Tile);
+		}
+	}
+}
+
+static u32 Test_Field(u64 Addr, const XAieGbl_RegFldAttr *Fld)
+{
+	return XAie_GetField(AieMock_Peek(Addr), Fld->Lsb, Fld->Mask);
+}
+
+/*****************************************************************************/
+static void Test_Config(XAieTileProf *Prof)
+{
+	XAieTileProf_Counter Bad = Counters[0];
+	const XAieTileProf_Counter *Cnt;
+	u32 Tile, Idx;
+	u64 Addr;
+
+	printf("configuration\n");
+	AieMock_Reset();
+	CHECK(XAieTileProf_Init(Prof, TilePtrs, TEST_TILES, Buf,
+				sizeof(Buf) / sizeof(Buf[0])) == XAIE_SUCCESS);
+	CHECK(XAieTileProf_Sample(Prof) == XAIE_FAILURE);
+	CHECK(XAieTileProf_Config(Prof, Counters, TEST_COUNTERS) ==
+			XAIE_SUCCESS);
+	CHECK(Prof->SampleWords == TEST_SAMPLE_WORDS);
+	CHECK(Prof->NumSlots == 8U);
+
+	/*
+	 * A control and a reset mask write per counter and tile, but no
+	 * reset for the stall counter
+	 */
+	CHECK(AieMockCount.MaskWrite32 == TEST_AIE_TILES * (2U + 1U + 2U) +
+			2U);
+	CHECK(AieMockCount.Write32 == 0U);
+	CHECK(AieMockCount.Read32 == 0U);
+	for (Tile = 0U; Tile < TEST_TILES; Tile++) {
+		for (Idx = 0U; Idx < TEST_COUNTERS; Idx++) {
+			Cnt = &Counters[Idx];
+			Addr = Tiles[Tile].TileAddr +
+				PerfCtrl[Cnt->Module].RegOff[Cnt->Counter];
+			if ((Cnt->Module == XAIETILE_PROF_MODULE_PL) !=
+					(Tile == TEST_SHIM)) {
+				continue;
+			}
+			CHECK(Test_Field(Addr, &PerfCtrl[Cnt->Module].
+						Start[Cnt->Counter]) ==
+					Cnt->StartEvent);
+			CHECK(Test_Field(Addr, &PerfCtrl[Cnt->Module].
+						Stop[Cnt->Counter]) ==
+					Cnt->StopEvent);
+			if (Cnt->ResetEvent == XAIETILE_PERFCNT_EVENT_INVALID) {
+				continue;
+			}
+			Addr = Tiles[Tile].TileAddr +
+				PerfCtrlReset[Cnt->Module].RegOff[Cnt->Counter];
+			CHECK(Test_Field(Addr, &PerfCtrlReset[Cnt->Module].
+						Reset[Cnt->Counter]) ==
+					Cnt->ResetEvent);
+		}
+	}
+
+	/* Rejected configurations */
+	Bad.Module = XAIETILE_PROF_MODULE_MEM + 1U;
+	CHECK(XAieTileProf_Config(Prof, &Bad, 1U) == XAIE_FAILURE);
+	CHECK(XAieTileProf_Config(Prof, Counters,
+				XAIETILE_PROF_COUNTERS_MAX + 1U) ==
+			XAIE_FAILURE);
+	CHECK(XAieTileProf_Init(Prof, TilePtrs, TEST_TILES, Buf,
+				TEST_SAMPLE_WORDS) == XAIE_SUCCESS);
+	CHECK(XAieTileProf_Config(Prof, Counters, TEST_COUNTERS) ==
+			XAIE_SUCCESS);
+	CHECK(XAieTileProf_Init(Prof, TilePtrs, TEST_TILES, Buf,
+				TEST_SAMPLE_WORDS - 1U) == XAIE_SUCCESS);
+	CHECK(XAieTileProf_Config(Prof, Counters, TEST_COUNTERS) ==
+			XAIE_FAILURE);
+}
+
+static void Test_Sample(XAieTileProf *Prof)
+{
+	const u32 *Values;
+	u64 Timestamp;
+	u32 Tile;
+
+	printf("samples\n");
+	AieMock_Reset();
+	CHECK(XAieTileProf_Init(Prof, TilePtrs, TEST_TILES, Buf,
+				sizeof(Buf) / sizeof(Buf[0])) == XAIE_SUCCESS);
+	CHECK(XAieTileProf_Config(Prof, Counters, TEST_COUNTERS) ==
+			XAIE_SUCCESS);
+
+	Test_SetTimer(0x100000005ULL);
+	Test_SetCounter(TEST_ACTIVE, 1000U);
+	Test_SetCounter(TEST_STALL, 2000U);
+	Test_SetCounter(TEST_DMA, 3000U);
+	Test_SetCounter(TEST_PL, 4000U);
+	AieMock_ResetCount();
+	CHECK(XAieTileProf_Sample(Prof) == XAIE_SUCCESS);
+	/* Timer low and high, then one read per counter a tile has */
+	CHECK(AieMockCount.Read32 == 2U + TEST_AIE_TILES * 3U + 1U);
+	CHECK(AieMock_Writes() == 0U);
+
+	CHECK(XAieTileProf_GetSample(Prof, 0U, &Timestamp, &Values) ==
+			XAIE_SUCCESS);
+	CHECK(Timestamp == 0x100000005ULL);
+	for (Tile = 0U; Tile < TEST_AIE_TILES; Tile++) {
+		CHECK(Values[Tile * TEST_COUNTERS + TEST_ACTIVE] ==
+				1000U + Tile);
+		CHECK(Values[Tile * TEST_COUNTERS + TEST_STALL] ==
+				2000U + Tile);
+		CHECK(Values[Tile * TEST_COUNTERS + TEST_DMA] == 3000U + Tile);
+		CHECK(Values[Tile * TEST_COUNTERS + TEST_PL] == 0U);
+	}
+	/* The shim has no core and memory modules */
+	Values += TEST_SHIM * TEST_COUNTERS;
+	CHECK(Values[TEST_ACTIVE] == 0U && Values[TEST_DMA] == 0U);
+	CHECK(Values[TEST_PL] == 4000U + TEST_SHIM);
+	CHECK(XAieTileProf_GetSample(Prof, 1U, NULL, NULL) == XAIE_FAILURE);
+
+	/* Periodic sampling */
+	CHECK(XAieTileProf_Run(Prof, 10U, 3U) == XAIE_SUCCESS);
+	CHECK(Prof->NumSamples == 4U);
+}
+
+/* Run with slow reads, returns the elapsed time in microseconds */
+static u64 Test_TimedRun(XAieTileProf *Prof, u32 IntervalUs, u32 NumSamples)
+{
+	u64 StartNs;
+
+	CHECK(XAieTileProf_Config(Prof, Counters, TEST_COUNTERS) ==
+			XAIE_SUCCESS);
+	StartNs = XAieLib_GetTimeNs();
+	CHECK(XAieTileProf_Run(Prof, IntervalUs, NumSamples) == XAIE_SUCCESS);
+
+	return (XAieLib_GetTimeNs() - StartNs) / 1000U;
+}
+
+static void Test_Run(XAieTileProf *Prof)
+{
+	u64 SampleUs, ElapsedUs;
+
+	printf("periodic sampling\n");
+	AieMock_Reset();
+	CHECK(XAieTileProf_Init(Prof, TilePtrs, TEST_TILES, Buf,
+				sizeof(Buf) / sizeof(Buf[0])) == XAIE_SUCCESS);
+
+	/* 15 reads per sample, about 3 ms */
+	AieMock_ReadDelayUs = 200U;
+	SampleUs = Test_TimedRun(Prof, 0U, 1U);
+	CHECK(SampleUs >= 3000U);
+
+	/*
+	 * Deadlines every 10 ms: the samples end 5 intervals and one sample
+	 * after the start, and would take 5 samples more with the time of
+	 * the samples added to each interval.
+	 */
+	ElapsedUs = Test_TimedRun(Prof, 10000U, 6U);
+	CHECK(Prof->NumSamples == 6U);
+	CHECK(Prof->Overruns == 0U);
+	CHECK(ElapsedUs >= 50000U);
+	CHECK(ElapsedUs < 50000U + SampleUs + 2U * SampleUs);
+
+	/* Samples taking longer than the interval overrun it */
+	ElapsedUs = Test_TimedRun(Prof, 1000U, 4U);
+	CHECK(Prof->NumSamples == 4U);
+	CHECK(Prof->Overruns == 3U);
+	CHECK(ElapsedUs >= 4U * 15U * AieMock_ReadDelayUs);
+
+	/* Counted until the next configuration */
+	CHECK(XAieTileProf_Config(Prof, Counters, TEST_COUNTERS) ==
+			XAIE_SUCCESS);
+	CHECK(Prof->Overruns == 0U);
+	AieMock_ReadDelayUs = 0U;
+}
+
+static void Test_Ring(XAieTileProf *Prof)
+{
+	u64 Timestamp;
+	u32 Idx;
+
+	printf("ring buffer\n");
+	AieMock_Reset();
+	CHECK(XAieTileProf_Init(Prof, TilePtrs, TEST_TILES, Buf,
+				3U * TEST_SAMPLE_WORDS + 1U) == XAIE_SUCCESS);
+	CHECK(XAieTileProf_Config(Prof, Counters, TEST_COUNTERS) ==
+			XAIE_SUCCESS);
+	CHECK(Prof->NumSlots == 3U);
+	Buf[3U * TEST_SAMPLE_WORDS] = 0xDEADBEEFU;
+	for (Idx = 1U; Idx <= 5U; Idx++) {
+		Test_SetTimer(Idx * 100U);
+		Test_SetCounter(TEST_ACTIVE, Idx);
+		CHECK(XAieTileProf_Sample(Prof) == XAIE_SUCCESS);
+	}
+	CHECK(Prof->NumSamples == 3U);
+	CHECK(Prof->Dropped == 2U);
+	for (Idx = 0U; Idx < 3U; Idx++) {
+		CHECK(XAieTileProf_GetSample(Prof, Idx, &Timestamp, NULL) ==
+				XAIE_SUCCESS);
+		CHECK(Timestamp == (Idx + 3U) * 100U);
+	}
+	CHECK(XAieTileProf_GetSample(Prof, 3U, &Timestamp, NULL) ==
+			XAIE_FAILURE);
+	/* The word past the last slot is left alone */
+	CHECK(Buf[3U * TEST_SAMPLE_WORDS] == 0xDEADBEEFU);
+}
+
+static void Test_Ratio(XAieTileProf *Prof)
+{
+	printf("ratios\n");
+	AieMock_Reset();
+	CHECK(XAieTileProf_Init(Prof, TilePtrs, TEST_TILES, Buf,
+				sizeof(Buf) / sizeof(Buf[0])) == XAIE_SUCCESS);
+	CHECK(XAieTileProf_Config(Prof, Counters, TEST_COUNTERS) ==
+			XAIE_SUCCESS);
+
+	Test_SetTimer(0xFFFFFF00ULL);
+	Test_SetCounter(TEST_ACTIVE, 0xFFFFFF00U);
+	Test_SetCounter(TEST_STALL, 10U);
+	Test_SetCounter(TEST_DMA, 0U);
+	CHECK(XAieTileProf_Sample(Prof) == XAIE_SUCCESS);
+
+	/* 1000 timer cycles, the timer low word and the counter wrap */
+	Test_SetTimer(0xFFFFFF00ULL + 1000U);
+	Test_SetCounter(TEST_ACTIVE, 0xFFFFFF00U + 500U);
+	Test_SetCounter(TEST_STALL, 10U + 125U);
+	Test_SetCounter(TEST_DMA, 250U);
+	CHECK(XAieTileProf_Sample(Prof) == XAIE_SUCCESS);
+
+	/* Stall ratio 125 / 500, DMA utilization 250 / 1000 */
+	CHECK(XAieTileProf_Ratio(Prof, 0U, 1U, 2U, TEST_STALL, TEST_ACTIVE) ==
+			2500U);
+	CHECK(XAieTileProf_Ratio(Prof, 0U, 1U, 2U, TEST_DMA,
+				XAIETILE_PROF_COUNTER_TIME) == 2500U);
+	CHECK(XAieTileProf_Ratio(Prof, 0U, 1U, 0U, TEST_ACTIVE,
+				XAIETILE_PROF_COUNTER_TIME) == 5000U);
+
+	/* No increment of the denominator, invalid arguments */
+	CHECK(XAieTileProf_Ratio(Prof, 0U, 1U, TEST_SHIM, TEST_PL,
+				TEST_ACTIVE) == 0U);
+	CHECK(XAieTileProf_Ratio(Prof, 1U, 1U, 0U, TEST_STALL,
+				TEST_ACTIVE) == 0U);
+	CHECK(XAieTileProf_Ratio(Prof, 0U, 2U, 0U, TEST_STALL,
+				TEST_ACTIVE) == 0U);
+	CHECK(XAieTileProf_Ratio(Prof, 0U, 1U, TEST_TILES, TEST_STALL,
+				TEST_ACTIVE) == 0U);
+	CHECK(XAieTileProf_Ratio(Prof, 0U, 1U, 0U, TEST_COUNTERS,
+				TEST_ACTIVE) == 0U);
+	CHECK(XAieTileProf_Ratio(Prof, 0U, 1U, 0U, TEST_STALL,
+				TEST_COUNTERS) == 0U);
+}
+
+/* Brackets and braces outside of strings are balanced */
+static u32 Test_Balanced(const char *Json)
+{
+	char Stack[16];
+	u32 Depth = 0U;
+	u8 InStr = 0U;
+
+	for (; *Json != '\0'; Json++) {
+		if (InStr != 0U) {
+			InStr = (*Json == '"') ? 0U : 1U;
+		} else if (*Json == '"') {
+			InStr = 1U;
+		} else if (*Json == '{' || *Json == '[') {
+			if (Depth == sizeof(Stack)) {
+				return 0U;
+			}
+			Stack[Depth++] = (*Json == '{') ? '}' : ']';
+		} else if (*Json == '}' || *Json == ']') {
+			if (Depth == 0U || Stack[--Depth] != *Json) {
+				return 0U;
+			}
+		}
+	}
+
+	return (Depth == 0U && InStr == 0U) ? 1U : 0U;
+}
+
+static void Test_Export(XAieTileProf *Prof)
+{
+	const char *Pos;
+	u32 Len, Events = 0U;
+
+	printf("trace export\n");
+	/* The two samples of the ratio test */
+	Len = XAieTileProf_Export(Prof, Trace, sizeof(Trace));
+	CHECK(Len > 0U && Len == strlen(Trace));
+	CHECK(strncmp(Trace, "{\"traceEvents\":[{", 17U) == 0);
+	CHECK(strcmp(Trace + Len - 26U, "],\"displayTimeUnit\":\"ns\"}\n") ==
+			0);
+	CHECK(Test_Balanced(Trace) == 1U);
+	for (Pos = Trace; (Pos = strstr(Pos, "\"ph\":\"C\"")) != NULL; Pos++) {
+		Events++;
+	}
+	CHECK(Events == TEST_TILES);
+	CHECK(strstr(Trace, "{\"name\":\"tile_2_1\",\"ph\":\"C\","
+				"\"ts\":4294968040,\"pid\":0,\"args\":"
+				"{\"core0\":500,\"core1\":125,\"mem0\":250,"
+				"\"pl0\":0}}") != NULL);
+	CHECK(strstr(Trace, "\"name\":\"tile_0_0\"") != NULL);
+
+	CHECK(XAieTileProf_Export(Prof, Trace, Len) == 0U);
+	CHECK(XAieTileProf_Export(Prof, Trace, Len + 1U) == Len);
+}
+
+int main(void)
+{
+	XAieTileProf Prof;
+
+	Test_InitTiles();
+	Test_Config(&Prof);
+	Test_Sample(&Prof);
+	Test_Ring(&Prof);
+	Test_Ratio(&Prof);
+	Test_Export(&Prof);
+	Test_Run(&Prof);
+
+	if (Failures != 0U) {
+		printf("test_prof: %u check(s) failed\n", Failures);
+		return 1;
+	}
+	printf("test_prof: all checks passed\n");
+	return 0;
+}
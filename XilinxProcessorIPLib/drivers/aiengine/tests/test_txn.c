@@ -0,0 +1,325 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file test_txn.c
+*
+* Host test of the register transaction buffer of xaielib.c against the
+* register space model in aiesim_mock.c. It runs the same register sequence
+* with and without a transaction and checks that both leave the same
+* register state and read back the same values, with the mask writes folded
+* into the write before them. It also checks that reads and simulator
+* commands flush the buffer, that a full buffer flushes itself, that a poll
+* which fails drops the commands after it and that a submission handler
+* receives the whole buffer in one call.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <string.h>
+#include "xaielib.h"
+#include "aiesim_mock.h"
+
+/************************** Constant Definitions *****************************/
+
+#define TEST_BASE	0x20000000ULL	/**< Tile 0, 1 of the array */
+#define TEST_REGS	64U		/**< Registers of the sequence */
+#define TEST_ITERS	512U		/**< Iterations of the sequence */
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CHECK(Cond)	Test_Check((Cond) ? 1U : 0U, #Cond, __LINE__)
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u32 Calls;		/**< Handler calls */
+	u32 NumCmds;		/**< Commands of the last call */
+	u32 Ret;		/**< Value returned by the handler */
+	XAieLib_TxnCmd Cmds[4];	/**< First commands of the last call */
+} Test_Submit;
+
+/************************** Variable Definitions *****************************/
+
+static u32 Failures;
+static u64 SnapAddrs[4U * TEST_REGS];
+static u32 SnapValues[4U * TEST_REGS];
+
+/*****************************************************************************/
+static void Test_Check(u32 Ok, const char *Cond, int Line)
+{
+	if (Ok == 0U) {
+		printf("  FAIL line %d: %s\n", Line, Cond);
+		Failures++;
+	}
+}
+
+static u32 Test_Submitted(const XAieLib_TxnCmd *Cmds, u32 NumCmds,
+		void *Data)
+{
+	Test_Submit *Submit = (Test_Submit *)Data;
+
+	Submit->Calls++;
+	Submit->NumCmds = NumCmds;
+	(void)memcpy(Submit->Cmds, Cmds, sizeof(Submit->Cmds[0]) *
+			((NumCmds < 4U) ? NumCmds : 4U));
+
+	return Submit->Ret;
+}
+
+/*
+ * Configuration style sequence: each register is written, then fields of
+ * it are updated with mask writes, and a status register next to it is
+ * updated field by field and read back from time to time.
+ */
+static u32 Test_Sequence(void)
+{
+	u32 Idx, Sum = 0U;
+	u64 Addr;
+
+	for (Idx = 0U; Idx < TEST_ITERS; Idx++) {
+		Addr = TEST_BASE + (Idx % TEST_REGS) * 4U;
+		XAieLib_Write32(Addr, Idx * 0x01010101U);
+		XAieLib_MaskWrite32(Addr, 0xFF00U, (Idx << 8) & 0xFF00U);
+		XAieLib_MaskWrite32(Addr, 0xF0000U, (Idx << 12) & 0xF0000U);
+		XAieLib_MaskWrite32(Addr + 0x100U, 0xFU, Idx & 0xFU);
+		XAieLib_MaskWrite32(Addr + 0x100U, 0xF0U, Idx & 0xF0U);
+		if ((Idx % 16U) == 15U) {
+			Sum += XAieLib_Read32(Addr + 0x100U);
+			Sum += XAieLib_Read32(Addr);
+		}
+	}
+
+	return Sum;
+}
+
+/*****************************************************************************/
+static void Test_Equivalent(void)
+{
+	u32 Sum, TxnSum, NumRegs;
+
+	printf("equivalent register state\n");
+	AieMock_Reset();
+	Sum = Test_Sequence();
+	CHECK(AieMockCount.Write32 == TEST_ITERS);
+	CHECK(AieMockCount.MaskWrite32 == 4U * TEST_ITERS);
+	CHECK(AieMockCount.Read32 == 2U * TEST_ITERS / 16U);
+	printf("  direct:      %u writes, %u mask writes, %u reads\n",
+			AieMockCount.Write32, AieMockCount.MaskWrite32,
+			AieMockCount.Read32);
+	NumRegs = AieMock_Snapshot(SnapAddrs, SnapValues, 4U * TEST_REGS);
+	CHECK(NumRegs == 2U * TEST_REGS);
+
+	AieMock_Reset();
+	XAieLib_TxnStart();
+	TxnSum = Test_Sequence();
+	CHECK(XAieLib_TxnEnd() == XAIELIB_SUCCESS);
+	printf("  transaction: %u writes, %u mask writes, %u reads\n",
+			AieMockCount.Write32, AieMockCount.MaskWrite32,
+			AieMockCount.Read32);
+	CHECK(TxnSum == Sum);
+	CHECK(AieMock_Compare(SnapAddrs, SnapValues, NumRegs) == 0U);
+	/* Mask writes right after a write or mask write are folded into it */
+	CHECK(AieMockCount.Write32 == TEST_ITERS);
+	CHECK(AieMockCount.MaskWrite32 == TEST_ITERS);
+	CHECK(AieMockCount.Read32 == 2U * TEST_ITERS / 16U);
+}
+
+static void Test_Order(void)
+{
+	u64 A = TEST_BASE, B = TEST_BASE + 4U;
+
+	printf("write order\n");
+	AieMock_Reset();
+	XAieLib_TxnStart();
+	XAieLib_Write32(A, 0x11U);
+	XAieLib_Write32(B, 0x22U);
+	/* Not right after the write to A, so not merged */
+	XAieLib_MaskWrite32(A, 0xF00U, 0x300U);
+	XAieLib_Write32(B, 0x44U);
+	CHECK(AieMock_Writes() == 0U);
+	CHECK(XAieLib_TxnEnd() == XAIELIB_SUCCESS);
+	CHECK(AieMock_Peek(A) == 0x311U);
+	CHECK(AieMock_Peek(B) == 0x44U);
+	CHECK(AieMockCount.Write32 == 3U);
+	CHECK(AieMockCount.MaskWrite32 == 1U);
+
+	/* Back to direct accesses once ended */
+	XAieLib_Write32(A, 0x55U);
+	CHECK(AieMock_Peek(A) == 0x55U);
+}
+
+static void Test_Flush(void)
+{
+	u64 A = TEST_BASE, B = TEST_BASE + 4U;
+	u32 Data[4] = { 1U, 2U, 3U, 4U };
+	u32 Read[4];
+	u32 Idx;
+
+	printf("flush on reads, commands and a full buffer\n");
+	AieMock_Reset();
+	XAieLib_TxnStart();
+	XAieLib_Write32(A, 0x1234U);
+	CHECK(XAieLib_Read32(A) == 0x1234U);
+	CHECK(AieMockCount.Write32 == 1U);
+
+	/* 128-bit writes are recorded as four writes */
+	XAieLib_Write128(B, Data);
+	CHECK(AieMock_Writes() == 1U);
+	XAieLib_Read128(B, Read);
+	CHECK(memcmp(Read, Data, sizeof(Data)) == 0);
+	CHECK(AieMockCount.Write32 == 5U);
+	CHECK(AieMockCount.Write128 == 0U);
+
+	XAieLib_Write32(A, 0x5678U);
+	XAieLib_WriteCmd(XAIELIB_CMDIO_COMMAND_SETSTACK, 0U, 1U, 0U, 0U,
+			NULL);
+	CHECK(AieMock_Peek(A) == 0x5678U);
+	CHECK(AieMockCount.WriteCmd == 1U);
+	/* The transaction is still active */
+	XAieLib_Write32(A, 0x9ABCU);
+	CHECK(AieMock_Peek(A) == 0x5678U);
+	CHECK(XAieLib_TxnEnd() == XAIELIB_SUCCESS);
+	CHECK(AieMock_Peek(A) == 0x9ABCU);
+
+	AieMock_Reset();
+	XAieLib_TxnStart();
+	for (Idx = 0U; Idx < XAIELIB_TXN_MAX_CMDS; Idx++) {
+		XAieLib_Write32(TEST_BASE + Idx * 4U, Idx);
+	}
+	CHECK(AieMock_Writes() == 0U);
+	XAieLib_Write32(TEST_BASE + Idx * 4U, Idx);
+	CHECK(AieMockCount.Write32 == XAIELIB_TXN_MAX_CMDS);
+	CHECK(XAieLib_TxnEnd() == XAIELIB_SUCCESS);
+	CHECK(AieMockCount.Write32 == XAIELIB_TXN_MAX_CMDS + 1U);
+	CHECK(AieMock_Peek(TEST_BASE + Idx * 4U) == Idx);
+
+	/* Nothing recorded, nothing done */
+	AieMock_ResetCount();
+	XAieLib_TxnStart();
+	CHECK(XAieLib_TxnFlush() == XAIELIB_SUCCESS);
+	CHECK(XAieLib_TxnEnd() == XAIELIB_SUCCESS);
+	CHECK(AieMock_Writes() == 0U);
+}
+
+static void Test_Poll(void)
+{
+	u64 A = TEST_BASE, B = TEST_BASE + 4U, C = TEST_BASE + 8U;
+	u64 Status = TEST_BASE + 0x100U;
+
+	printf("polls\n");
+	AieMock_Reset();
+	AieMock_Poke(Status, 0x1U);
+	XAieLib_TxnStart();
+	XAieLib_Write32(A, 1U);
+	CHECK(XAieLib_MaskPoll(Status, 0x1U, 0x1U, 100U) == XAIELIB_SUCCESS);
+	/* A mask write after a poll of the register is not folded into it */
+	XAieLib_MaskWrite32(Status, 0x2U, 0x2U);
+	XAieLib_Write32(B, 2U);
+	CHECK(AieMockCount.MaskPoll == 0U);
+	CHECK(XAieLib_TxnEnd() == XAIELIB_SUCCESS);
+	CHECK(AieMockCount.MaskPoll == 1U);
+	CHECK(AieMock_Peek(Status) == 0x3U);
+	CHECK(AieMock_Peek(B) == 2U);
+
+	/* A poll which times out drops the commands after it */
+	AieMock_Reset();
+	XAieLib_TxnStart();
+	XAieLib_Write32(A, 1U);
+	CHECK(XAieLib_MaskPoll(Status, 0x1U, 0x1U, 100U) == XAIELIB_SUCCESS);
+	XAieLib_Write32(B, 2U);
+	CHECK(XAieLib_TxnFlush() == XAIELIB_FAILURE);
+	CHECK(AieMock_Peek(A) == 1U);
+	CHECK(AieMock_Peek(B) == 0U);
+
+	/* The failure sticks until the transaction ends */
+	XAieLib_Write32(C, 3U);
+	CHECK(XAieLib_TxnFlush() == XAIELIB_FAILURE);
+	CHECK(AieMock_Peek(C) == 3U);
+	CHECK(XAieLib_TxnEnd() == XAIELIB_FAILURE);
+
+	XAieLib_TxnStart();
+	XAieLib_Write32(B, 2U);
+	CHECK(XAieLib_TxnEnd() == XAIELIB_SUCCESS);
+	CHECK(AieMock_Peek(B) == 2U);
+}
+
+static void Test_SubmitHandler(void)
+{
+	Test_Submit Submit;
+	u32 Idx;
+
+	printf("submission handler\n");
+	AieMock_Reset();
+	(void)memset(&Submit, 0, sizeof(Submit));
+	Submit.Ret = XAIELIB_SUCCESS;
+	XAieLib_TxnSetSubmit(Test_Submitted, &Submit);
+
+	XAieLib_TxnStart();
+	for (Idx = 0U; Idx < 10U; Idx++) {
+		XAieLib_Write32(TEST_BASE + Idx * 4U, Idx);
+	}
+	XAieLib_MaskWrite32(TEST_BASE, 0xF0U, 0x50U);
+	(void)XAieLib_MaskPoll(TEST_BASE + 0x100U, 0x1U, 0x1U, 100U);
+	CHECK(XAieLib_TxnEnd() == XAIELIB_SUCCESS);
+	CHECK(Submit.Calls == 1U);
+	CHECK(Submit.NumCmds == 12U);
+	CHECK(Submit.Cmds[0].Op == XAIELIB_TXN_OP_WRITE);
+	CHECK(Submit.Cmds[0].Addr == TEST_BASE);
+	CHECK(AieMock_Writes() == 0U);
+	CHECK(AieMockCount.MaskPoll == 0U);
+
+	Submit.Ret = XAIELIB_FAILURE;
+	XAieLib_TxnStart();
+	XAieLib_Write32(TEST_BASE, 1U);
+	CHECK(XAieLib_TxnEnd() == XAIELIB_FAILURE);
+	CHECK(Submit.Calls == 2U);
+
+	XAieLib_TxnSetSubmit(NULL, NULL);
+	XAieLib_TxnStart();
+	XAieLib_Write32(TEST_BASE, 1U);
+	CHECK(XAieLib_TxnEnd() == XAIELIB_SUCCESS);
+	CHECK(Submit.Calls == 2U);
+	CHECK(AieMockCount.Write32 == 1U);
+}
+
+int main(void)
+{
+	Test_Equivalent();
+	Test_Order();
+	Test_Flush();
+	Test_Poll();
+	Test_SubmitHandler();
+
+	if (Failures != 0U) {
+		printf("test_txn: %u check(s) failed\n", Failures);
+		return 1;
+	}
+	printf("test_txn: all checks passed\n");
+	return 0;
+}
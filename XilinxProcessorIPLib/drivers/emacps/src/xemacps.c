@@ -51,6 +51,9 @@
 * 3.8  hk   09/17/18 Cleanup stale comments.
 * 3.8  mus  11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
 * 3.10 hk   05/16/19 Clear status registers properly in reset
+* 3.10 ag   10/16/26 Support the RX priority queue in XEmacPs_SetQueuePtr,
+*                    clear screening registers in reset and disable the
+*                    priority queue interrupts in stop.
 *
 * </pre>
 ******************************************************************************/
@@ -249,6 +252,8 @@ void XEmacPs_Stop(XEmacPs *InstancePtr)
 	/* Disable all interrupts */
 	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress, XEMACPS_IDR_OFFSET,
 			   XEMACPS_IXR_ALL_MASK);
+	if (InstancePtr->Version > 2)
+		XEmacPs_IntQ1Disable(InstancePtr, XEMACPS_INTQ1_IXR_ALL_MASK);
 
 	/* Disable the receiver & transmitter */
 	Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
@@ -388,6 +393,20 @@ void XEmacPs_Reset(XEmacPs *InstancePtr)
 		(void)XEmacPs_SetTypeIdCheck(InstancePtr, 0x00000000U, i);
 	}
 
+	/* Clear the screeners so that no frame is steered to a priority queue */
+	if (InstancePtr->Version > 2) {
+		Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+					XEMACPS_DCFG8_OFFSET);
+		for (i = 0U; i < (u8)((Reg & XEMACPS_DCFG8_T1SCR_MASK) >>
+				XEMACPS_DCFG8_T1SCR_SHIFT); i++) {
+			(void)XEmacPs_SetScreenT1(InstancePtr, i, 0x00000000U);
+		}
+		for (i = 0U; i < (u8)((Reg & XEMACPS_DCFG8_T2SCR_MASK) >>
+				XEMACPS_DCFG8_T2SCR_SHIFT); i++) {
+			(void)XEmacPs_SetScreenT2(InstancePtr, i, 0x00000000U);
+		}
+	}
+
 	/* clear all counters */
 	for (i = 0U; i < (u8)((XEMACPS_LAST_OFFSET - XEMACPS_OCTTXL_OFFSET) / 4U);
 	     i++) {
@@ -440,6 +459,8 @@ void XEmacPs_StubHandler(void)
 * @note
 * The buffer queue addresses has to be set before starting the transfer, so
 * this function has to be called in prior to XEmacPs_Start()
+* Setting the receive queue 1 also sets its buffer size to the one of
+* receive queue 0.
 *
 ******************************************************************************/
 void XEmacPs_SetQueuePtr(XEmacPs *InstancePtr, UINTPTR QPtr, u8 QueueNum,
@@ -465,10 +486,19 @@ void XEmacPs_SetQueuePtr(XEmacPs *InstancePtr, UINTPTR QPtr, u8 QueueNum,
 				(QPtr & ULONG64_LO_MASK));
 		}
 	}
-	 else {
+	 else if (Direction == XEMACPS_SEND) {
 		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
 			XEMACPS_TXQ1BASE_OFFSET,
 			(QPtr & ULONG64_LO_MASK));
+	} else {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_RXQ1BASE_OFFSET,
+			(QPtr & ULONG64_LO_MASK));
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_RXQ1BUFSIZE_OFFSET,
+			((XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_DMACR_OFFSET) & XEMACPS_DMACR_RXBUF_MASK) >>
+				XEMACPS_DMACR_RXBUF_SHIFT));
 	}
 #ifdef __aarch64__
 	if (Direction == XEMACPS_SEND) {
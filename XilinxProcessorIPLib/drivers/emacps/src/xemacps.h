@@ -49,6 +49,7 @@
  *   - Pause frame support
  *   - Large frame support up to 1536 bytes
  *   - Checksum offload
+ *   - Priority queues and receive screening (Zynq UltraScale+ MPSoC, Versal)
  *
  * <b>Driver Description</b>
  *
@@ -327,6 +328,8 @@
  * 3.8   hk   07/19/18 Fixed CPP, GCC and doxygen warnings - CR-1006327
  *	 hk   09/17/18 Fix PTP interrupt masks and cleanup comments.
  * 3.9   hk   01/23/19 Add RX watermark support
+ * 3.10  ag   10/16/26 Add receive on priority queue 1 and APIs for the
+ *                     screening registers which steer frames to queues.
  *
  * </pre>
  *
@@ -838,6 +841,11 @@ LONG XEmacPs_PhyWrite(XEmacPs *InstancePtr, u32 PhyAddress,
 		      u32 RegisterNum, u16 PhyData);
 LONG XEmacPs_SetTypeIdCheck(XEmacPs *InstancePtr, u32 Id_Check, u8 Index);
 
+u8 XEmacPs_GetQueueCount(XEmacPs *InstancePtr);
+LONG XEmacPs_SetScreenT1(XEmacPs *InstancePtr, u8 Index, u32 Screen);
+LONG XEmacPs_SetScreenT2(XEmacPs *InstancePtr, u8 Index, u32 Screen);
+LONG XEmacPs_SetScreenEthType(XEmacPs *InstancePtr, u8 Index, u16 EthType);
+
 LONG XEmacPs_SendPausePacket(XEmacPs *InstancePtr);
 void XEmacPs_DMABLengthUpdate(XEmacPs *InstancePtr, s32 BLength);
 
@@ -65,6 +65,7 @@
  * 3.2   hk   11/18/15 Change BD typedef and number of words.
  * 3.8   hk   08/18/18 Remove duplicate definition of XEmacPs_BdSetLength
  * 3.8   mus  11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
+ * 3.10  ag   10/16/26 Add XEmacPs_BdGetRxCsumStatus.
  *
  * </pre>
  *
@@ -772,6 +773,24 @@ typedef u32 XEmacPs_Bd[XEMACPS_BD_NUM_WORDS];
     XEMACPS_RXBUF_SOF_MASK)!=0U ? TRUE : FALSE)
 
 
+/*****************************************************************************/
+/**
+ * Get the checksums verified by the hardware for the received frame, one of
+ * the XEMACPS_RXBUF_CSSTAT_* values. Only valid with the receive checksum
+ * offload enabled, in which case frames with bad checksums are discarded.
+ *
+ * @param  BdPtr is the BD pointer to operate on
+ *
+ * @note
+ * C-style signature:
+ *    u32 XEmacPs_BdGetRxCsumStatus(XEmacPs_Bd* BdPtr)
+ *
+ *****************************************************************************/
+#define XEmacPs_BdGetRxCsumStatus(BdPtr)                           \
+    (XEmacPs_BdRead((BdPtr), XEMACPS_BD_STAT_OFFSET) &            \
+    XEMACPS_RXBUF_CSSTAT_MASK)
+
+
 /************************** Function Prototypes ******************************/
 
 #ifdef __cplusplus
@@ -46,6 +46,8 @@
  * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
  * 3.0   hk   02/20/15 Added support for jumbo frames.
  * 3.2   hk   02/22/16 Added SGMII support for Zynq Ultrascale+ MPSoC.
+ * 3.10  ag   10/16/26 Added APIs for the number of queues and the type 1 and
+ *                     type 2 screening registers.
  * </pre>
  *****************************************************************************/
 
@@ -429,6 +431,148 @@ LONG XEmacPs_SetTypeIdCheck(XEmacPs *InstancePtr, u32 Id_Check, u8 Index)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * Get the number of DMA queues of the device, queue 0 and the priority
+ * queues. Only queue 0 is present on GEM versions 2 and older.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ *
+ * @return Number of queues, 1 or more.
+ *
+ *****************************************************************************/
+u8 XEmacPs_GetQueueCount(XEmacPs *InstancePtr)
+{
+	u32 Reg;
+	u8 Count = 1U;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->Version > 2) {
+		Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+					XEMACPS_DCFG6_OFFSET) & XEMACPS_DCFG6_QUEUES_MASK;
+		/* Queues are numbered contiguously from 1 */
+		while ((Reg & ((u32)1U << Count)) != 0x00000000U) {
+			Count++;
+		}
+	}
+
+	return Count;
+}
+
+/*****************************************************************************/
+/**
+ * Write a type 1 screening register. The value is built from the
+ * XEMACPS_SCREEN_QUEUE_MASK and XEMACPS_SCREEN_T1_* fields; a value without
+ * an enable bit disables the screener. Screeners can be changed while the
+ * device is started.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener (0 to number of type 1 screeners - 1).
+ * @param Screen is the value of the screening register.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was set
+ * - XST_INVALID_PARAM if the device has no such screener
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetScreenT1(XEmacPs *InstancePtr, u8 Index, u32 Screen)
+{
+	u32 Reg;
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_DCFG8_OFFSET);
+	if ((InstancePtr->Version <= 2) || ((u32)Index >=
+		((Reg & XEMACPS_DCFG8_T1SCR_MASK) >> XEMACPS_DCFG8_T1SCR_SHIFT))) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCREEN_T1_OFFSET + ((u32)Index * (u32)4)),
+			Screen);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Write a type 2 screening register. The value is built from the
+ * XEMACPS_SCREEN_QUEUE_MASK and XEMACPS_SCREEN_T2_* fields; a value without
+ * an enable bit disables the screener. Ethertype matches refer to a register
+ * set with XEmacPs_SetScreenEthType(). Screeners can be changed while the
+ * device is started.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener (0 to number of type 2 screeners - 1).
+ * @param Screen is the value of the screening register.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was set
+ * - XST_INVALID_PARAM if the device has no such screener
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetScreenT2(XEmacPs *InstancePtr, u8 Index, u32 Screen)
+{
+	u32 Reg;
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_DCFG8_OFFSET);
+	if ((InstancePtr->Version <= 2) || ((u32)Index >=
+		((Reg & XEMACPS_DCFG8_T2SCR_MASK) >> XEMACPS_DCFG8_T2SCR_SHIFT))) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCREEN_T2_OFFSET + ((u32)Index * (u32)4)),
+			Screen);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Set an ethertype register used by the type 2 screeners.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the ethertype register (0 to number of registers - 1).
+ * @param EthType is the ethertype to match.
+ *
+ * @return
+ * - XST_SUCCESS if the ethertype was set
+ * - XST_INVALID_PARAM if the device has no such register
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetScreenEthType(XEmacPs *InstancePtr, u8 Index, u16 EthType)
+{
+	u32 Reg;
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_DCFG8_OFFSET);
+	if ((InstancePtr->Version <= 2) || ((u32)Index >=
+		((Reg & XEMACPS_DCFG8_ETHT_MASK) >> XEMACPS_DCFG8_ETHT_SHIFT))) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCREEN_ETHT_OFFSET + ((u32)Index * (u32)4)),
+			(u32)EthType);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * Set options for the driver/device. The driver should be stopped with
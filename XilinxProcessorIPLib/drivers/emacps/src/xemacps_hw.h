@@ -58,6 +58,10 @@
 * 3.8  hk   09/17/18 Fix PTP interrupt masks.
 * 3.9  hk   01/23/19 Add RX watermark support
 * 3.10 hk   05/16/19 Clear status registers properly in reset
+* 3.10 ag   10/16/26 Add priority queue RX, design config and screening
+*                    register definitions.
+*                    Add RX BD checksum status definitions.
+*                    Add interrupt moderation register definitions.
 * </pre>
 *
 ******************************************************************************/
@@ -151,6 +155,9 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 
 #define XEMACPS_JUMBOMAXLEN_OFFSET   0x00000048U /**< Jumbo max length reg */
 
+#define XEMACPS_INTMOD_OFFSET        0x0000005CU /**< Interrupt moderation reg,
+                                                    ZynqMP and Versal */
+
 #define XEMACPS_RXWATERMARK_OFFSET   0x0000007CU /**< RX watermark reg */
 
 #define XEMACPS_HASHL_OFFSET         0x00000080U /**< Hash Low address reg */
@@ -295,12 +302,18 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_PTPP_RXNANOSEC_OFFSET 0x000001FCU /**< 1588 PTP peer receive
 						      nanosecond counter */
 
+#define XEMACPS_DCFG6_OFFSET         0x00000294U /**< Design Config 6 reg,
+							queues present */
+#define XEMACPS_DCFG8_OFFSET         0x0000029CU /**< Design Config 8 reg,
+							screeners present */
+
 #define XEMACPS_INTQ1_STS_OFFSET     0x00000400U /**< Interrupt Q1 Status
 							reg */
 #define XEMACPS_TXQ1BASE_OFFSET	     0x00000440U /**< TX Q1 Base address
 							reg */
 #define XEMACPS_RXQ1BASE_OFFSET	     0x00000480U /**< RX Q1 Base address
 							reg */
+#define XEMACPS_RXQ1BUFSIZE_OFFSET   0x000004A0U /**< RX Q1 Buffer size reg */
 #define XEMACPS_MSBBUF_TXQBASE_OFFSET  0x000004C8U /**< MSB Buffer TX Q Base
 							reg */
 #define XEMACPS_MSBBUF_RXQBASE_OFFSET  0x000004D4U /**< MSB Buffer RX Q Base
@@ -311,6 +324,12 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 							reg */
 #define XEMACPS_INTQ1_IMR_OFFSET     0x00000640U /**< Interrupt Q1 Mask
 							reg */
+#define XEMACPS_SCREEN_T1_OFFSET     0x00000500U /**< Type 1 screening
+							reg 0 */
+#define XEMACPS_SCREEN_T2_OFFSET     0x00000540U /**< Type 2 screening
+							reg 0 */
+#define XEMACPS_SCREEN_ETHT_OFFSET   0x000006E0U /**< Type 2 screening
+							ethertype reg 0 */
 
 /* Define some bit positions for registers. */
 
@@ -465,9 +484,54 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
  */
 #define XEMACPS_INTQ1SR_TXCOMPL_MASK	0x00000080U /**< Transmit completed OK */
 #define XEMACPS_INTQ1SR_TXERR_MASK	0x00000040U /**< Transmit AMBA Error */
+#define XEMACPS_INTQ1SR_RXUSED_MASK	0x00000004U /**< RX used bit read */
+#define XEMACPS_INTQ1SR_RXCOMPL_MASK	0x00000002U /**< Frame received OK */
 
 #define XEMACPS_INTQ1_IXR_ALL_MASK	((u32)XEMACPS_INTQ1SR_TXCOMPL_MASK | \
-					 (u32)XEMACPS_INTQ1SR_TXERR_MASK)
+					 (u32)XEMACPS_INTQ1SR_TXERR_MASK | \
+					 (u32)XEMACPS_INTQ1SR_RXUSED_MASK | \
+					 (u32)XEMACPS_INTQ1SR_RXCOMPL_MASK)
+
+/*@}*/
+
+/**
+ * @name Design config register bit definitions
+ * @{
+ */
+#define XEMACPS_DCFG6_QUEUES_MASK	0x000000FEU /**< Priority queues 1 to 7
+						      present */
+#define XEMACPS_DCFG8_T1SCR_MASK	0xFF000000U /**< Type 1 screeners */
+#define XEMACPS_DCFG8_T1SCR_SHIFT	24U
+#define XEMACPS_DCFG8_T2SCR_MASK	0x00FF0000U /**< Type 2 screeners */
+#define XEMACPS_DCFG8_T2SCR_SHIFT	16U
+#define XEMACPS_DCFG8_ETHT_MASK		0x0000FF00U /**< Type 2 ethertype
+						      registers */
+#define XEMACPS_DCFG8_ETHT_SHIFT	8U
+
+/*@}*/
+
+/**
+ * @name Screening register bit definitions
+ * A type 1 screener steers IP frames matching a DS/TC byte and/or a UDP
+ * destination port to a queue. A type 2 screener steers frames matching a
+ * VLAN priority and/or an ethertype register to a queue.
+ * @{
+ */
+#define XEMACPS_SCREEN_QUEUE_MASK	0x0000000FU /**< Destination queue */
+#define XEMACPS_SCREEN_T1_DSTC_MASK	0x00000FF0U /**< DS/TC byte to match */
+#define XEMACPS_SCREEN_T1_DSTC_SHIFT	4U
+#define XEMACPS_SCREEN_T1_UDP_MASK	0x0FFFF000U /**< UDP port to match */
+#define XEMACPS_SCREEN_T1_UDP_SHIFT	12U
+#define XEMACPS_SCREEN_T1_DSTCEN_MASK	0x10000000U /**< Match DS/TC byte */
+#define XEMACPS_SCREEN_T1_UDPEN_MASK	0x20000000U /**< Match UDP port */
+#define XEMACPS_SCREEN_T2_VLANPRI_MASK	0x00000070U /**< VLAN priority to
+						      match */
+#define XEMACPS_SCREEN_T2_VLANPRI_SHIFT	4U
+#define XEMACPS_SCREEN_T2_VLANEN_MASK	0x00000100U /**< Match VLAN priority */
+#define XEMACPS_SCREEN_T2_ETHIDX_MASK	0x00000E00U /**< Ethertype register
+						      to match */
+#define XEMACPS_SCREEN_T2_ETHIDX_SHIFT	9U
+#define XEMACPS_SCREEN_T2_ETHEN_MASK	0x00001000U /**< Match ethertype */
 
 /*@}*/
 
@@ -536,6 +600,13 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_RXWM_LOW_SHFT_MSK	16U	/**< Shift for RXWM low */
 /*@}*/
 
+/** @name interrupt moderation register bit definitions
+ * @{
+ */
+#define XEMACPS_INTMOD_RX_MASK		0x000000FFU	/**< RX interrupt moderation
+							     delay, 800 ns units */
+/*@}*/
+
 /* Transmit buffer descriptor status words offset
  * @{
  */
@@ -588,6 +659,12 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
                                                       matched */
 #define XEMACPS_RXBUF_IDFOUND_MASK   0x01000000U /**< Type ID matched */
 #define XEMACPS_RXBUF_IDMATCH_MASK   0x00C00000U /**< ID matched mask */
+#define XEMACPS_RXBUF_CSSTAT_MASK    0x00C00000U /**< Checksums verified, with
+                                                      RX checksum offload */
+#define XEMACPS_RXBUF_CSSTAT_NONE    0x00000000U /**< None verified */
+#define XEMACPS_RXBUF_CSSTAT_IP      0x00400000U /**< IP header only */
+#define XEMACPS_RXBUF_CSSTAT_TCP     0x00800000U /**< IP header and TCP */
+#define XEMACPS_RXBUF_CSSTAT_UDP     0x00C00000U /**< IP header and UDP */
 #define XEMACPS_RXBUF_VLAN_MASK      0x00200000U /**< VLAN tagged */
 #define XEMACPS_RXBUF_PRI_MASK       0x00100000U /**< Priority tagged */
 #define XEMACPS_RXBUF_VPRI_MASK      0x000E0000U /**< Vlan priority */
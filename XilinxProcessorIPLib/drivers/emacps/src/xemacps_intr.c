@@ -53,6 +53,7 @@
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.1   hk   07/27/15 Do not call error handler with '0' error code when
 *                     there is no error. CR# 869403
+* 3.10  ag   10/16/26 Handle receive interrupts of priority queue 1.
 * </pre>
 ******************************************************************************/
 
@@ -179,6 +180,29 @@ void XEmacPs_IntrHandler(void *XEmacPsPtr)
 		InstancePtr->RecvHandler(InstancePtr->RecvRef);
 	}
 
+	/* Receive Q1 complete interrupt. The receive handler serves all
+	 * receive queues, so it is called once if queue 0 received as well.
+	 */
+	if ((InstancePtr->Version > 2) &&
+			((RegQ1ISR & XEMACPS_INTQ1SR_RXCOMPL_MASK) != 0x00000000U)) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				   XEMACPS_INTQ1_STS_OFFSET,
+				   XEMACPS_INTQ1SR_RXCOMPL_MASK);
+		if ((RegISR & XEMACPS_IXR_FRAMERX_MASK) == 0x00000000U) {
+			InstancePtr->RecvHandler(InstancePtr->RecvRef);
+		}
+	}
+
+	/* Receive Q1 buffer not available, reported as for queue 0 */
+	if ((InstancePtr->Version > 2) &&
+			((RegQ1ISR & XEMACPS_INTQ1SR_RXUSED_MASK) != 0x00000000U)) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				   XEMACPS_INTQ1_STS_OFFSET,
+				   XEMACPS_INTQ1SR_RXUSED_MASK);
+		InstancePtr->ErrorHandler(InstancePtr->ErrorRef, XEMACPS_RECV,
+					  XEMACPS_RXSR_BUFFNA_MASK);
+	}
+
 	/* Transmit Q1 complete interrupt */
 	if ((InstancePtr->Version > 2) &&
 			((RegQ1ISR & XEMACPS_INTQ1SR_TXCOMPL_MASK) != 0x00000000U)) {
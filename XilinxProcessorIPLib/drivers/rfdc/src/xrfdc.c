@@ -178,6 +178,8 @@
 *       cog    10/02/19 The register value for the link coupling is inverted in Gen 3 Devices.
 *       cog    10/18/19 DSA was checking DAC tile rather than ADC.
 *       cog    10/18/19 Fix GCB read indexing issue with HSADC devices & TSCB coefficients.
+*       ag     10/16/26 Drop the shadow registers of a tile when it is restarted.
+*                       Added XRFdc_ConfigSetStart() and XRFdc_ConfigSetApply() APIs.
 *
 * </pre>
 *
@@ -192,6 +194,8 @@
 
 /***************** Macros (Inline Functions) Definitions *********************/
 static u32 XRFdc_RestartIPSM(XRFdc *InstancePtr, u32 Type, int Tile_Id, u32 Start, u32 End);
+static u32 XRFdc_TriggerEvent(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 Event,
+			      u32 *TileEventPtr);
 static void StubHandler(void *CallBackRefPtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 StatusEvent);
 static void XRFdc_ADCInitialize(XRFdc *InstancePtr);
 static void XRFdc_DACInitialize(XRFdc *InstancePtr);
@@ -244,6 +248,9 @@ u32 XRFdc_CfgInitialize(XRFdc *InstancePtr, XRFdc_Config *ConfigPtr)
 	}
 #endif
 
+	/* Shadow registers are enabled afterwards by XRFdc_ShadowEnable() */
+	InstancePtr->Shadow = NULL;
+
 	/*
 	 * Set the values read from the device config and the base address.
 	 */
@@ -810,6 +817,7 @@ static u32 XRFdc_RestartIPSM(XRFdc *InstancePtr, u32 Type, int Tile_Id, u32 Star
 
 			/* Wait for restart bit clear */
 			Status = XRFdc_WaitForRestartClr(InstancePtr, Type, Index, BaseAddr, End);
+			XRFdc_ShadowInvalidate(InstancePtr, Type, Index);
 			if (Status != XRFDC_SUCCESS) {
 				goto RETURN_PATH;
 			}
@@ -1536,7 +1544,9 @@ RETURN_PATH:
 /*****************************************************************************/
 /**
 *
-* This function will trigger the update event for an event.
+* Static API to trigger the update event for an event. A tile event is only
+* recorded in *TileEventPtr when it is not NULL, for the caller to trigger
+* once for the tile.
 *
 * @param    InstancePtr is a pointer to the XRfdc instance.
 * @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
@@ -1545,15 +1555,17 @@ RETURN_PATH:
 *           are 0-3.
 * @param    Event is for which dynamic update event will trigger.
 *           XRFDC_EVENT_* defines the different events.
+* @param    TileEventPtr is set to 1 if a tile event is needed, or NULL.
 *
 * @return
 *           - XRFDC_SUCCESS if successful.
 *           - XRFDC_FAILURE if error occurs.
 *
-* @note     Common API for ADC/DAC blocks
+* @note     Static API for ADC/DAC blocks
 *
 ******************************************************************************/
-u32 XRFdc_UpdateEvent(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 Event)
+static u32 XRFdc_TriggerEvent(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 Event,
+			      u32 *TileEventPtr)
 {
 	u32 Status;
 	u32 BaseAddr;
@@ -1561,9 +1573,6 @@ u32 XRFdc_UpdateEvent(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u
 	u32 NoOfBlocks;
 	u32 Index;
 
-	Xil_AssertNonvoid(InstancePtr != NULL);
-	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
-
 	Index = Block_Id;
 	if ((XRFdc_IsHighSpeedADC(InstancePtr, Tile_Id) == 1) && (Type == XRFDC_ADC_TILE)) {
 		NoOfBlocks = XRFDC_NUM_OF_BLKS2;
@@ -1624,6 +1633,8 @@ u32 XRFdc_UpdateEvent(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u
 		if (Type == XRFDC_ADC_TILE) {
 			if (EventSource == XRFDC_EVNT_SRC_SLICE) {
 				XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_UPDATE_DYN_OFFSET, 0x1);
+			} else if (TileEventPtr != NULL) {
+				*TileEventPtr = 1U;
 			} else {
 				BaseAddr = XRFDC_ADC_TILE_DRP_ADDR(Tile_Id) + XRFDC_HSCOM_ADDR;
 				XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_HSCOM_UPDT_DYN_OFFSET, 0x1);
@@ -1631,6 +1642,8 @@ u32 XRFdc_UpdateEvent(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u
 		} else {
 			if (EventSource == XRFDC_EVNT_SRC_SLICE) {
 				XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_DAC_UPDATE_DYN_OFFSET, 0x1);
+			} else if (TileEventPtr != NULL) {
+				*TileEventPtr = 1U;
 			} else {
 				BaseAddr = XRFDC_DAC_TILE_DRP_ADDR(Tile_Id) + XRFDC_HSCOM_ADDR;
 				XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_HSCOM_UPDT_DYN_OFFSET, 0x1);
@@ -1651,6 +1664,158 @@ RETURN_PATH:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function will trigger the update event for an event.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
+* @param    Tile_Id Valid values are 0-3.
+* @param    Block_Id is ADC/DAC block number inside the tile. Valid values
+*           are 0-3.
+* @param    Event is for which dynamic update event will trigger.
+*           XRFDC_EVENT_* defines the different events.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if error occurs.
+*
+* @note     Common API for ADC/DAC blocks. Within a configuration set the
+*           event is deferred to XRFdc_ConfigSetApply(), so only the Event
+*           value is checked here.
+*
+******************************************************************************/
+u32 XRFdc_UpdateEvent(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 Event)
+{
+	u32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	if ((InstancePtr->Shadow == NULL) || (InstancePtr->Shadow->InConfigSet == 0U)) {
+		Status = XRFdc_TriggerEvent(InstancePtr, Type, Tile_Id, Block_Id, Event, NULL);
+		goto RETURN_PATH;
+	}
+
+	if (((Event != XRFDC_EVENT_MIXER) && (Event != XRFDC_EVENT_QMC) && (Event != XRFDC_EVENT_CRSE_DLY)) ||
+	    (Type > XRFDC_DAC_TILE) || (Tile_Id > XRFDC_TILE_ID_MAX) || (Block_Id > XRFDC_BLOCK_ID_MAX)) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid Event value in %s\r\n", __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+	InstancePtr->Shadow->Events[Type][Tile_Id][Block_Id] |= (u8)Event;
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API starts a configuration set. Until XRFdc_ConfigSetApply() the
+* writes to the tile and block registers are held in the shadow registers,
+* and the update events requested with XRFdc_UpdateEvent() are deferred.
+* The other APIs are used as usual in between, to configure any number of
+* tiles and blocks.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if the shadow registers are not enabled or a
+*             configuration set is already started.
+*
+* @note     Common API for ADC/DAC blocks
+*
+******************************************************************************/
+u32 XRFdc_ConfigSetStart(XRFdc *InstancePtr)
+{
+	u32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	if ((InstancePtr->Shadow == NULL) || (InstancePtr->Shadow->InConfigSet != 0U)) {
+		metal_log(METAL_LOG_ERROR, "\n Shadow registers not enabled or configuration set started in %s\r\n",
+			  __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+	memset(InstancePtr->Shadow->Events, 0, sizeof(InstancePtr->Shadow->Events));
+	InstancePtr->Shadow->InConfigSet = 1U;
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API applies a configuration set: the held writes are written out in
+* order of first write, then the deferred update events are triggered, with
+* a single update event per tile for the blocks whose event source is the
+* tile.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if no configuration set is started or an update
+*             event fails.
+*
+* @note     Common API for ADC/DAC blocks
+*
+******************************************************************************/
+u32 XRFdc_ConfigSetApply(XRFdc *InstancePtr)
+{
+	XRFdc_Shadow *ShadowPtr;
+	u32 Status;
+	u32 Type;
+	u32 Tile_Id;
+	u32 Block_Id;
+	u32 Event;
+	u32 TileEvent;
+	u32 BaseAddr;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	ShadowPtr = InstancePtr->Shadow;
+	if ((ShadowPtr == NULL) || (ShadowPtr->InConfigSet == 0U)) {
+		metal_log(METAL_LOG_ERROR, "\n Configuration set not started in %s\r\n", __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+	ShadowPtr->InConfigSet = 0U;
+	XRFdc_ShadowFlush(InstancePtr);
+
+	Status = XRFDC_SUCCESS;
+	for (Type = XRFDC_ADC_TILE; Type <= XRFDC_DAC_TILE; Type++) {
+		for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_NUM_OF_TILES4; Tile_Id++) {
+			TileEvent = 0U;
+			for (Block_Id = XRFDC_BLK_ID0; Block_Id < XRFDC_NUM_OF_BLKS4; Block_Id++) {
+				for (Event = XRFDC_EVENT_MIXER; Event <= XRFDC_EVENT_QMC; Event <<= 1U) {
+					if ((ShadowPtr->Events[Type][Tile_Id][Block_Id] & Event) != 0U) {
+						Status |= XRFdc_TriggerEvent(InstancePtr, Type, Tile_Id, Block_Id,
+									     Event, &TileEvent);
+					}
+				}
+				ShadowPtr->Events[Type][Tile_Id][Block_Id] = 0U;
+			}
+			if (TileEvent != 0U) {
+				BaseAddr = XRFDC_DRP_BASE(Type, Tile_Id) + XRFDC_HSCOM_ADDR;
+				XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_HSCOM_UPDT_DYN_OFFSET, 0x1);
+			}
+		}
+	}
+
+RETURN_PATH:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -253,6 +253,10 @@
 *       cog    10/02/19 Added macros for the clock divider.
 *       cog    10/02/19 Added macro for fabric rate of 16.
 *       cog    10/02/19 Added macros for new VCO ranges.
+*       ag     10/16/26 Added XRFdc_Shadow structure and the shadow register
+*                       and configuration set APIs.
+*       ag     10/16/26 Added XRFdc_Hop_State and XRFdc_Hop_Table structures and
+*                       the frequency hop APIs.
 *
 * </pre>
 *
@@ -670,6 +674,46 @@ typedef struct {
 	XRFdc_ADCBlock_DigitalDataPath ADCBlock_Digital_Datapath[4];
 } XRFdc_ADC_Tile;
 
+/**
+ * Shadow Register Structure, a write-through copy of the 16-bit DRP
+ * registers of all tiles (DAC tiles 0-3 then ADC tiles 0-3).
+ */
+typedef struct {
+	u16 Value[XRFDC_SHADOW_NUM_TILES][XRFDC_SHADOW_TILE_REGS]; /* Last value written */
+	u32 Valid[XRFDC_SHADOW_NUM_TILES][XRFDC_SHADOW_TILE_REGS / 32U]; /* Value holds the register */
+	u32 Dirty[XRFDC_SHADOW_NUM_TILES][XRFDC_SHADOW_TILE_REGS / 32U]; /* Value not yet written */
+	u16 Pending[XRFDC_SHADOW_PENDING_MAX]; /* Dirty registers in order of first write */
+	u32 NumPending;
+	u32 InConfigSet; /* Set between XRFdc_ConfigSetStart() and XRFdc_ConfigSetApply() */
+	u8 Events[2][4][4]; /* Deferred XRFDC_EVENT_* per block */
+} XRFdc_Shadow;
+
+/**
+ * Frequency Hop State, the mixer registers of one block written by
+ * XRFdc_SetMixerSettings() for one set of mixer settings.
+ */
+typedef struct {
+	u32 NumRegs;
+	u32 RegAddr[XRFDC_HOP_REGS_MAX];
+	u16 RegData[XRFDC_HOP_REGS_MAX];
+	u32 BlockMask; /* Blocks written, two for a 4GSPS ADC */
+	u8 MixerInputDataType[4];
+	u8 UpdateMixerScale;
+	XRFdc_Mixer_Settings Mixer_Settings;
+} XRFdc_Hop_State;
+
+/**
+ * Frequency Hop Table, the hop states compiled for one block.
+ */
+typedef struct {
+	u32 Type;
+	u32 Tile_Id;
+	u32 Block_Id;
+	u32 NumStates;
+	u32 CurrentState; /* XRFDC_HOP_STATE_NONE until the first hop */
+	XRFdc_Hop_State *HopStatePtr; /* Array of NumStates states */
+} XRFdc_Hop_Table;
+
 /**
  * RFdc Structure.
  */
@@ -685,8 +729,14 @@ typedef struct {
 	XRFdc_StatusHandler StatusHandler; /* Event handler function */
 	void *CallBackRef; /* Callback reference for event handler */
 	u8 UpdateMixerScale; /* Set to 1, if user overwrite mixer scale */
+	XRFdc_Shadow *Shadow; /* Shadow registers, NULL if not enabled */
 } XRFdc;
 
+/* Shadow register access, used by the register access macros */
+u16 XRFdc_ShadowRead16(XRFdc *InstancePtr, u32 Addr);
+void XRFdc_ShadowWrite16(XRFdc *InstancePtr, u32 Addr, u16 Data);
+void XRFdc_ShadowSync(XRFdc *InstancePtr, u32 Addr, u32 Width, u32 IsWrite);
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 #ifndef __BAREMETAL__
@@ -2090,6 +2140,15 @@ u32 XRFdc_SetDACCompMode(XRFdc *InstancePtr, u32 Tile_Id, u32 Block_Id, u32 Enab
 u32 XRFdc_GetDACCompMode(XRFdc *InstancePtr, u32 Tile_Id, u32 Block_Id, u32 *EnabledPtr);
 u32 XRFdc_SetDSA(XRFdc *InstancePtr, u32 Tile_Id, u32 Block_Id, XRFdc_DSA_Settings *SettingsPtr);
 u32 XRFdc_GetDSA(XRFdc *InstancePtr, u32 Tile_Id, u32 Block_Id, XRFdc_DSA_Settings *SettingsPtr);
+void XRFdc_ShadowEnable(XRFdc *InstancePtr, XRFdc_Shadow *ShadowPtr);
+void XRFdc_ShadowInvalidate(XRFdc *InstancePtr, u32 Type, int Tile_Id);
+void XRFdc_ShadowFlush(XRFdc *InstancePtr);
+u32 XRFdc_ConfigSetStart(XRFdc *InstancePtr);
+u32 XRFdc_ConfigSetApply(XRFdc *InstancePtr);
+u32 XRFdc_CompileHopTable(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
+			  XRFdc_Mixer_Settings *MixerSettingsPtr, u32 NumStates, XRFdc_Hop_State *HopStatePtr,
+			  XRFdc_Hop_Table *HopTablePtr);
+u32 XRFdc_SetHopState(XRFdc *InstancePtr, XRFdc_Hop_Table *HopTablePtr, u32 NumTables, u32 State);
 #ifndef __BAREMETAL__
 s32 XRFdc_GetDeviceNameByDeviceId(char *DevNamePtr, u16 DevId);
 #endif
@@ -85,6 +85,9 @@
 *       cog    09/18/19 Added mask for bypassing PLL output divider.
 *       cog    10/02/19 Added mask for clock divider.
 *       cog    10/02/19 Added mask for PLL output clock divider.
+*       ag     10/16/26 Register access macros go through the shadow registers
+*                       when they are enabled.
+*       ag     10/16/26 Added frequency hop table macros.
 *
 *</pre>
 *
@@ -1976,6 +1979,14 @@ extern "C" {
 #define XRFDC_BLOCK_ADDR_OFFSET(X) (X * 0x400U)
 #define XRFDC_TILE_DRP_OFFSET 0x2000U
 
+#define XRFDC_SHADOW_NUM_TILES 8U /* DAC tiles 0-3 followed by ADC tiles 0-3 */
+#define XRFDC_SHADOW_TILE_REGS (XRFDC_TILE_DRP_OFFSET >> 2U)
+#define XRFDC_SHADOW_PENDING_MAX 256U
+#define XRFDC_SHADOW_NONE 0xFFFFFFFFU
+
+#define XRFDC_HOP_REGS_MAX 24U /* Mixer registers of up to two blocks */
+#define XRFDC_HOP_STATE_NONE 0xFFFFFFFFU
+
 /***************** Macros (Inline Functions) Definitions *********************/
 #define XRFdc_In64 metal_io_read64
 #define XRFdc_Out64 metal_io_write64
@@ -2005,7 +2016,10 @@ extern "C" {
 *
 ******************************************************************************/
 #define XRFdc_ReadReg64(InstancePtr, BaseAddress, RegOffset)                                                           \
-	XRFdc_In64(InstancePtr->io, ((u32)RegOffset + (u32)BaseAddress))
+	(((InstancePtr)->Shadow == NULL) ?                                                                             \
+		 XRFdc_In64(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress)) :                                \
+		 (XRFdc_ShadowSync((InstancePtr), ((u32)RegOffset + (u32)BaseAddress), 8U, 0U),                        \
+		  XRFdc_In64(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress))))
 
 /***************************************************************************/
 /**
@@ -2025,7 +2039,10 @@ extern "C" {
 *
 ******************************************************************************/
 #define XRFdc_WriteReg64(InstancePtr, BaseAddress, RegOffset, RegisterValue)                                           \
-	XRFdc_Out64((InstancePtr->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue))
+	(((InstancePtr)->Shadow == NULL) ?                                                                             \
+		 XRFdc_Out64(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue)) :         \
+		 (XRFdc_ShadowSync((InstancePtr), ((u32)RegOffset + (u32)BaseAddress), 8U, 1U),                        \
+		  XRFdc_Out64(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue))))
 
 /****************************************************************************/
 /**
@@ -2043,7 +2060,10 @@ extern "C" {
 *
 ******************************************************************************/
 #define XRFdc_ReadReg(InstancePtr, BaseAddress, RegOffset)                                                             \
-	XRFdc_In32((InstancePtr->io), ((u32)BaseAddress + (u32)RegOffset))
+	(((InstancePtr)->Shadow == NULL) ?                                                                             \
+		 XRFdc_In32(((InstancePtr)->io), ((u32)BaseAddress + (u32)RegOffset)) :                                \
+		 (XRFdc_ShadowSync((InstancePtr), ((u32)BaseAddress + (u32)RegOffset), 4U, 0U),                        \
+		  XRFdc_In32(((InstancePtr)->io), ((u32)BaseAddress + (u32)RegOffset))))
 
 /***************************************************************************/
 /**
@@ -2063,7 +2083,10 @@ extern "C" {
 *
 ******************************************************************************/
 #define XRFdc_WriteReg(InstancePtr, BaseAddress, RegOffset, RegisterValue)                                             \
-	XRFdc_Out32((InstancePtr->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue))
+	(((InstancePtr)->Shadow == NULL) ?                                                                             \
+		 XRFdc_Out32(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue)) :         \
+		 (XRFdc_ShadowSync((InstancePtr), ((u32)RegOffset + (u32)BaseAddress), 4U, 1U),                        \
+		  XRFdc_Out32(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue))))
 
 /****************************************************************************/
 /**
@@ -2081,7 +2104,8 @@ extern "C" {
 *
 ******************************************************************************/
 #define XRFdc_ReadReg16(InstancePtr, BaseAddress, RegOffset)                                                           \
-	XRFdc_In16((InstancePtr->io), ((u32)RegOffset + (u32)BaseAddress))
+	(((InstancePtr)->Shadow == NULL) ? XRFdc_In16(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress)) :      \
+					   XRFdc_ShadowRead16((InstancePtr), ((u32)RegOffset + (u32)BaseAddress)))
 
 /***************************************************************************/
 /**
@@ -2101,7 +2125,9 @@ extern "C" {
 *
 ******************************************************************************/
 #define XRFdc_WriteReg16(InstancePtr, BaseAddress, RegOffset, RegisterValue)                                           \
-	XRFdc_Out16((InstancePtr->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue))
+	(((InstancePtr)->Shadow == NULL) ?                                                                             \
+		 XRFdc_Out16(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue)) :         \
+		 XRFdc_ShadowWrite16((InstancePtr), ((u32)RegOffset + (u32)BaseAddress), (u16)(RegisterValue)))
 
 /****************************************************************************/
 /**
@@ -2119,7 +2145,10 @@ extern "C" {
 *
 ******************************************************************************/
 #define XRFdc_ReadReg8(InstancePtr, BaseAddress, RegOffset)                                                            \
-	XRFdc_In8((InstancePtr->io), ((u32)RegOffset + (u32)BaseAddress))
+	(((InstancePtr)->Shadow == NULL) ?                                                                             \
+		 XRFdc_In8(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress)) :                                 \
+		 (XRFdc_ShadowSync((InstancePtr), ((u32)RegOffset + (u32)BaseAddress), 1U, 0U),                        \
+		  XRFdc_In8(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress))))
 
 /***************************************************************************/
 /**
@@ -2139,7 +2168,10 @@ extern "C" {
 *
 ******************************************************************************/
 #define XRFdc_WriteReg8(InstancePtr, BaseAddress, RegOffset, RegisterValue)                                            \
-	XRFdc_Out8((InstancePtr->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue))
+	(((InstancePtr)->Shadow == NULL) ?                                                                             \
+		 XRFdc_Out8(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue)) :          \
+		 (XRFdc_ShadowSync((InstancePtr), ((u32)RegOffset + (u32)BaseAddress), 1U, 1U),                        \
+		  XRFdc_Out8(((InstancePtr)->io), ((u32)RegOffset + (u32)BaseAddress), (u32)(RegisterValue))))
 
 #ifdef __cplusplus
 }
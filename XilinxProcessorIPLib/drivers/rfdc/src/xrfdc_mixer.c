@@ -56,6 +56,8 @@
 *                       be incorrect.
 *       cog    09/19/19 Calibration mode 1 does not need the frequency shifting workaround
 *                       for Gen 3 devices.
+*       ag     10/16/26 Added XRFdc_CompileHopTable() and XRFdc_SetHopState()
+*                       for precompiled frequency hopping.
 * </pre>
 *
 ******************************************************************************/
@@ -67,12 +69,29 @@
 
 /**************************** Type Definitions *******************************/
 
+/*
+ * Register capture used to compile a hop state. The I/O region is the first
+ * member, so that the region handle passed to the ops is the capture.
+ */
+typedef struct {
+	struct metal_io_region Io;
+	XRFdc *InstancePtr; /* Device instance, registers not yet captured are read from it */
+	XRFdc_Hop_State *HopStatePtr;
+	u32 DrpAddr;
+	u32 UpdateOffset; /* Update event trigger, never captured */
+	u32 Overflow;
+} XRFdc_HopCapture;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 static void XRFdc_SetFineMixer(XRFdc *InstancePtr, u32 BaseAddr, XRFdc_Mixer_Settings *MixerSettingsPtr);
 static void XRFdc_SetCoarseMixer(XRFdc *InstancePtr, u32 Type, u32 BaseAddr, u32 Tile_Id, u32 Block_Id,
 				 u32 CoarseMixFreq, XRFdc_Mixer_Settings *MixerSettingsPtr);
 static u32 XRFdc_MixerRangeCheck(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, XRFdc_Mixer_Settings *MixerSettingsPtr);
 static void XRFdc_MixersOff(XRFdc *InstancePtr, u32 BaseAddr);
+static uint64_t XRFdc_HopCaptureRead(struct metal_io_region *io, unsigned long offset, memory_order order,
+				     int width);
+static void XRFdc_HopCaptureWrite(struct metal_io_region *io, unsigned long offset, uint64_t value,
+				  memory_order order, int width);
 
 /************************** Function Prototypes ******************************/
 
@@ -957,4 +976,363 @@ RETURN_PATH:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* Static API to read a register of the block being compiled. A register
+* already captured for the hop state reads back its captured value, the
+* others are read from the device.
+*
+* @param    io is the I/O region of the register capture.
+* @param    offset is the register address.
+* @param    order is the memory order of the access.
+* @param    width is the access width in bytes.
+*
+* @return   Register value.
+*
+* @note     None.
+*
+******************************************************************************/
+static uint64_t XRFdc_HopCaptureRead(struct metal_io_region *io, unsigned long offset, memory_order order,
+				     int width)
+{
+	XRFdc_HopCapture *CapturePtr = (XRFdc_HopCapture *)io;
+	XRFdc_Hop_State *HopStatePtr = CapturePtr->HopStatePtr;
+	uint64_t Value;
+	u32 Index;
+
+	(void)order;
+	if (width == 2) {
+		for (Index = 0U; Index < HopStatePtr->NumRegs; Index++) {
+			if (HopStatePtr->RegAddr[Index] == (u32)offset) {
+				Value = HopStatePtr->RegData[Index];
+				goto RETURN_PATH;
+			}
+		}
+		Value = XRFdc_ReadReg16(CapturePtr->InstancePtr, 0U, offset);
+	} else if (width == 1) {
+		Value = XRFdc_ReadReg8(CapturePtr->InstancePtr, 0U, offset);
+	} else {
+		Value = XRFdc_ReadReg(CapturePtr->InstancePtr, 0U, offset);
+	}
+RETURN_PATH:
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+* Static API to capture a register write of the block being compiled in the
+* hop state, in the order of the first write. Nothing is written to the
+* device.
+*
+* @param    io is the I/O region of the register capture.
+* @param    offset is the register address.
+* @param    value is the value to write.
+* @param    order is the memory order of the access.
+* @param    width is the access width in bytes.
+*
+* @return   None
+*
+* @note     A write that cannot be captured sets Overflow.
+*
+******************************************************************************/
+static void XRFdc_HopCaptureWrite(struct metal_io_region *io, unsigned long offset, uint64_t value,
+				  memory_order order, int width)
+{
+	XRFdc_HopCapture *CapturePtr = (XRFdc_HopCapture *)io;
+	XRFdc_Hop_State *HopStatePtr = CapturePtr->HopStatePtr;
+	u32 Block;
+	u32 Index;
+
+	(void)order;
+	if ((width != 2) || ((u32)offset < CapturePtr->DrpAddr) ||
+	    ((u32)offset >= (CapturePtr->DrpAddr + XRFDC_HSCOM_ADDR))) {
+		CapturePtr->Overflow = 1U;
+		goto RETURN_PATH;
+	}
+	Block = ((u32)offset - CapturePtr->DrpAddr) / XRFDC_BLOCK_ADDR_OFFSET(1U);
+	if ((((u32)offset - CapturePtr->DrpAddr) % XRFDC_BLOCK_ADDR_OFFSET(1U)) == CapturePtr->UpdateOffset) {
+		/* The update event is triggered by XRFdc_SetHopState() */
+		goto RETURN_PATH;
+	}
+
+	for (Index = 0U; Index < HopStatePtr->NumRegs; Index++) {
+		if (HopStatePtr->RegAddr[Index] == (u32)offset) {
+			break;
+		}
+	}
+	if (Index == XRFDC_HOP_REGS_MAX) {
+		CapturePtr->Overflow = 1U;
+		goto RETURN_PATH;
+	}
+	if (Index == HopStatePtr->NumRegs) {
+		HopStatePtr->RegAddr[Index] = (u32)offset;
+		HopStatePtr->NumRegs++;
+	}
+	HopStatePtr->RegData[Index] = (u16)value;
+	HopStatePtr->BlockMask |= (1U << Block);
+RETURN_PATH:
+	return;
+}
+
+/*****************************************************************************/
+/**
+* This API compiles a frequency hop table for a block, one hop state for
+* each of the mixer settings passed. Each state holds the absolute values of
+* the mixer registers that XRFdc_SetMixerSettings() writes for its settings,
+* so that XRFdc_SetHopState() switches to it with register writes alone,
+* without the range checks and the floating point computation of the
+* frequency and phase words. Nothing is written to the device.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type is ADC or DAC. 0 for ADC and 1 DAC
+* @param    Tile_Id Valid values are 0-3.
+* @param    Block_Id is ADC/DAC block number inside the tile. Valid values
+*           are 0-3.
+* @param    MixerSettingsPtr is an array of NumStates XRFdc_Mixer_Settings,
+*           the settings of each hop state.
+* @param    NumStates is the number of hop states.
+* @param    HopStatePtr is an array of NumStates hop states, filled in by
+*           this API and used by the hop table.
+* @param    HopTablePtr is a pointer to the hop table to initialize.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if error occurs.
+*
+* @note     The registers shared with other settings of the block, such as
+*           the data type and the fine mixer scale, are compiled with their
+*           other fields as they are at the time of the call, so the table is
+*           to be compiled again if those settings change.
+*
+******************************************************************************/
+u32 XRFdc_CompileHopTable(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
+			  XRFdc_Mixer_Settings *MixerSettingsPtr, u32 NumStates, XRFdc_Hop_State *HopStatePtr,
+			  XRFdc_Hop_Table *HopTablePtr)
+{
+	u32 Status;
+	u32 State;
+	u32 Index;
+	XRFdc *ScratchPtr;
+	XRFdc_HopCapture Capture;
+	XRFdc_Mixer_Settings MixerSettings;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(MixerSettingsPtr != NULL);
+	Xil_AssertNonvoid(HopStatePtr != NULL);
+	Xil_AssertNonvoid(HopTablePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	Status = XRFdc_CheckDigitalPathEnabled(InstancePtr, Type, Tile_Id, Block_Id);
+	if (Status != XRFDC_SUCCESS) {
+		metal_log(METAL_LOG_ERROR, "\n Requested block digital path not enabled in %s\r\n", __func__);
+		goto RETURN_PATH;
+	}
+	if (NumStates == 0U) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid number of hop states in %s\r\n", __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	/* The mixer settings are applied to a copy of the instance, whose I/O region captures the writes */
+	ScratchPtr = metal_allocate_memory(sizeof(XRFdc));
+	if (ScratchPtr == NULL) {
+		metal_log(METAL_LOG_ERROR, "\n Failed to allocate memory in %s\r\n", __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+	Capture.Io = *InstancePtr->io;
+	Capture.Io.ops.read = XRFdc_HopCaptureRead;
+	Capture.Io.ops.write = XRFdc_HopCaptureWrite;
+	Capture.InstancePtr = InstancePtr;
+	Capture.DrpAddr = XRFDC_DRP_BASE(Type, Tile_Id);
+	Capture.UpdateOffset = (Type == XRFDC_ADC_TILE) ? XRFDC_ADC_UPDATE_DYN_OFFSET : XRFDC_DAC_UPDATE_DYN_OFFSET;
+
+	for (State = 0U; State < NumStates; State++) {
+		*ScratchPtr = *InstancePtr;
+		ScratchPtr->io = &Capture.Io;
+		ScratchPtr->Shadow = NULL;
+		Capture.HopStatePtr = &HopStatePtr[State];
+		Capture.Overflow = 0U;
+		HopStatePtr[State].NumRegs = 0U;
+		HopStatePtr[State].BlockMask = 0U;
+
+		MixerSettings = MixerSettingsPtr[State];
+		Status = XRFdc_SetMixerSettings(ScratchPtr, Type, Tile_Id, Block_Id, &MixerSettings);
+		if (Status != XRFDC_SUCCESS) {
+			metal_log(METAL_LOG_ERROR, "\n Invalid mixer settings for hop state %u in %s\r\n", State,
+				  __func__);
+			break;
+		}
+		if (Capture.Overflow != 0U) {
+			metal_log(METAL_LOG_ERROR, "\n Too many register writes for hop state %u in %s\r\n", State,
+				  __func__);
+			Status = XRFDC_FAILURE;
+			break;
+		}
+
+		HopStatePtr[State].Mixer_Settings = MixerSettingsPtr[State];
+		HopStatePtr[State].UpdateMixerScale = ScratchPtr->UpdateMixerScale;
+		for (Index = 0U; Index < XRFDC_NUM_OF_BLKS4; Index++) {
+			if (Type == XRFDC_ADC_TILE) {
+				HopStatePtr[State].MixerInputDataType[Index] =
+					ScratchPtr->ADC_Tile[Tile_Id].ADCBlock_Digital_Datapath[Index].MixerInputDataType;
+			} else {
+				HopStatePtr[State].MixerInputDataType[Index] =
+					ScratchPtr->DAC_Tile[Tile_Id].DACBlock_Digital_Datapath[Index].MixerInputDataType;
+			}
+		}
+	}
+	metal_free_memory(ScratchPtr);
+	if (Status != XRFDC_SUCCESS) {
+		goto RETURN_PATH;
+	}
+
+	HopTablePtr->Type = Type;
+	HopTablePtr->Tile_Id = Tile_Id;
+	HopTablePtr->Block_Id = Block_Id;
+	HopTablePtr->NumStates = NumStates;
+	HopTablePtr->CurrentState = XRFDC_HOP_STATE_NONE;
+	HopTablePtr->HopStatePtr = HopStatePtr;
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This API switches a set of blocks to hop state State of their hop tables.
+* The registers of each block are written first, only those that differ
+* from the current state of its table, then the blocks are armed together:
+* an update event is triggered for each block with the immediate or slice
+* event source and once for each tile with the tile event source. Blocks
+* with the SYSREF, PL or marker event source are left armed for that event.
+* Driver structure is updated with the new mixer settings.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    HopTablePtr is an array of NumTables hop tables compiled with
+*           XRFdc_CompileHopTable().
+* @param    NumTables is the number of hop tables.
+* @param    State is the hop state to switch to.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if State is not a state of all the tables.
+*
+* @note     The mixer registers of the blocks are to be changed through the
+*           hop tables only, as the current state of a table is taken to be
+*           in the registers. Set CurrentState to XRFDC_HOP_STATE_NONE to
+*           write all the registers of the next state.
+*
+******************************************************************************/
+u32 XRFdc_SetHopState(XRFdc *InstancePtr, XRFdc_Hop_Table *HopTablePtr, u32 NumTables, u32 State)
+{
+	u32 Status;
+	u32 Table;
+	u32 Index;
+	u32 Current;
+	u32 Type;
+	u32 Tile_Id;
+	u32 BaseAddr;
+	u32 Offset;
+	u8 TileEvent[2][4] = { { 0U } };
+	XRFdc_Hop_State *HopStatePtr;
+	XRFdc_Hop_State *CurrentPtr;
+	XRFdc_Mixer_Settings *MixerConfigPtr;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(HopTablePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	for (Table = 0U; Table < NumTables; Table++) {
+		if (State >= HopTablePtr[Table].NumStates) {
+			metal_log(METAL_LOG_ERROR, "\n Invalid hop state %u in %s\r\n", State, __func__);
+			Status = XRFDC_FAILURE;
+			goto RETURN_PATH;
+		}
+	}
+
+	for (Table = 0U; Table < NumTables; Table++) {
+		HopStatePtr = &HopTablePtr[Table].HopStatePtr[State];
+		CurrentPtr = NULL;
+		if (HopTablePtr[Table].CurrentState < HopTablePtr[Table].NumStates) {
+			CurrentPtr = &HopTablePtr[Table].HopStatePtr[HopTablePtr[Table].CurrentState];
+		}
+		for (Index = 0U; Index < HopStatePtr->NumRegs; Index++) {
+			if (CurrentPtr != NULL) {
+				/* States of a table mostly hold the same registers in the same order */
+				Current = Index;
+				if ((Current >= CurrentPtr->NumRegs) ||
+				    (CurrentPtr->RegAddr[Current] != HopStatePtr->RegAddr[Index])) {
+					for (Current = 0U; Current < CurrentPtr->NumRegs; Current++) {
+						if (CurrentPtr->RegAddr[Current] == HopStatePtr->RegAddr[Index]) {
+							break;
+						}
+					}
+				}
+				if ((Current < CurrentPtr->NumRegs) &&
+				    (CurrentPtr->RegData[Current] == HopStatePtr->RegData[Index])) {
+					continue;
+				}
+			}
+			XRFdc_WriteReg16(InstancePtr, 0U, HopStatePtr->RegAddr[Index], HopStatePtr->RegData[Index]);
+		}
+	}
+
+	for (Table = 0U; Table < NumTables; Table++) {
+		HopStatePtr = &HopTablePtr[Table].HopStatePtr[State];
+		Type = HopTablePtr[Table].Type;
+		Tile_Id = HopTablePtr[Table].Tile_Id;
+		Offset = (Type == XRFDC_ADC_TILE) ? XRFDC_ADC_UPDATE_DYN_OFFSET : XRFDC_DAC_UPDATE_DYN_OFFSET;
+		for (Index = 0U; Index < XRFDC_NUM_OF_BLKS4; Index++) {
+			if ((HopStatePtr->BlockMask & (1U << Index)) == 0U) {
+				continue;
+			}
+			BaseAddr = XRFDC_BLOCK_BASE(Type, Tile_Id, Index);
+			if (HopStatePtr->Mixer_Settings.EventSource == XRFDC_EVNT_SRC_IMMEDIATE) {
+				XRFdc_ClrSetReg(InstancePtr, BaseAddr, Offset, XRFDC_UPDT_EVNT_MASK,
+						XRFDC_UPDT_EVNT_NCO_MASK);
+			} else if (HopStatePtr->Mixer_Settings.EventSource == XRFDC_EVNT_SRC_SLICE) {
+				XRFdc_WriteReg16(InstancePtr, BaseAddr, Offset, XRFDC_UPDT_EVNT_SLICE_MASK);
+			} else if (HopStatePtr->Mixer_Settings.EventSource == XRFDC_EVNT_SRC_TILE) {
+				TileEvent[Type][Tile_Id] = 1U;
+			}
+
+			/* Update the instance with new values */
+			if (Type == XRFDC_ADC_TILE) {
+				MixerConfigPtr =
+					&InstancePtr->ADC_Tile[Tile_Id].ADCBlock_Digital_Datapath[Index].Mixer_Settings;
+				InstancePtr->ADC_Tile[Tile_Id].ADCBlock_Digital_Datapath[Index].MixerInputDataType =
+					HopStatePtr->MixerInputDataType[Index];
+			} else {
+				MixerConfigPtr =
+					&InstancePtr->DAC_Tile[Tile_Id].DACBlock_Digital_Datapath[Index].Mixer_Settings;
+				InstancePtr->DAC_Tile[Tile_Id].DACBlock_Digital_Datapath[Index].MixerInputDataType =
+					HopStatePtr->MixerInputDataType[Index];
+			}
+			MixerConfigPtr->EventSource = HopStatePtr->Mixer_Settings.EventSource;
+			MixerConfigPtr->PhaseOffset = HopStatePtr->Mixer_Settings.PhaseOffset;
+			MixerConfigPtr->MixerMode = HopStatePtr->Mixer_Settings.MixerMode;
+			MixerConfigPtr->CoarseMixFreq = HopStatePtr->Mixer_Settings.CoarseMixFreq;
+			MixerConfigPtr->Freq = HopStatePtr->Mixer_Settings.Freq;
+			MixerConfigPtr->MixerType = HopStatePtr->Mixer_Settings.MixerType;
+		}
+		InstancePtr->UpdateMixerScale = HopStatePtr->UpdateMixerScale;
+		HopTablePtr[Table].CurrentState = State;
+	}
+
+	for (Type = XRFDC_ADC_TILE; Type <= XRFDC_DAC_TILE; Type++) {
+		for (Tile_Id = 0U; Tile_Id <= XRFDC_TILE_ID_MAX; Tile_Id++) {
+			if (TileEvent[Type][Tile_Id] != 0U) {
+				BaseAddr = XRFDC_DRP_BASE(Type, Tile_Id) + XRFDC_HSCOM_ADDR;
+				XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_HSCOM_UPDT_DYN_OFFSET, 0x1);
+			}
+		}
+	}
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
 /** @} */
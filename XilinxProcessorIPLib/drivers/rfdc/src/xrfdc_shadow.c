@@ -0,0 +1,437 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xrfdc_shadow.c
+* @addtogroup xrfdc_v7_0
+* @{
+*
+* Contains the shadow register interface functions of the XRFdc driver.
+* See xrfdc.h for a detailed description of the device and driver.
+*
+* The shadow registers are a write-through copy of the 16-bit DRP registers
+* of the tiles and their blocks. A register is held once the driver has
+* written it, after which the read half of every read-modify-write is served
+* from memory. Registers the hardware also updates (interrupt status, update
+* triggers, calibration readback) are never held, nor is the control and
+* status region of a tile.
+*
+* Between XRFdc_ConfigSetStart() and XRFdc_ConfigSetApply() the writes to the
+* held registers are only recorded; they are written out once, in order of
+* first write, when the configuration set is applied or when an access to a
+* register that is not held needs them to be visible.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---    -------- -----------------------------------------------
+* 7.0   ag     10/16/26 Initial release.
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xrfdc.h"
+
+/************************** Constant Definitions *****************************/
+#define XRFDC_SHADOW_ADC_TILE0 4U /* Shadow tile index of ADC tile 0 */
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u16 First;
+	u16 Last;
+} XRFdc_ShadowRange;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+static u32 XRFdc_ShadowIndex(u32 Addr);
+static u32 XRFdc_ShadowAddr(u32 Index);
+static u32 XRFdc_ShadowInRange(const XRFdc_ShadowRange *RangePtr, u32 NumRanges, u32 Offset);
+
+/************************** Variable Definitions *****************************/
+/* Block registers, as offsets within a block, that are never held */
+static const XRFdc_ShadowRange XRFdc_BlockVolatile[] = {
+	{ XRFDC_ADC_FABRIC_ISR_OFFSET, XRFDC_DAC_FABRIC_ISR_OFFSET },
+	{ XRFDC_ADC_UPDATE_DYN_OFFSET, XRFDC_DAC_UPDATE_DYN_OFFSET },
+	{ XRFDC_ADC_DEC_ISR_OFFSET, XRFDC_ADC_DEC_ISR_OFFSET },
+	{ XRFDC_DATPATH_ISR_OFFSET, XRFDC_DATPATH_ISR_OFFSET },
+	{ XRFDC_NCO_RST_OFFSET, XRFDC_NCO_RST_OFFSET },
+	{ XRFDC_ADC_SIG_DETECT_MAGN_OFFSET, XRFDC_ADC_SIG_DETECT_MAGN_OFFSET },
+	{ XRFDC_CAL_TSCB_OFFSET_COEFF0_ALT, XRFDC_CAL_TSCB_OFFSET_COEFF7 },
+	{ XRFDC_ADC_TI_DCBSTS0_BG_OFFSET, XRFDC_ADC_TI_DCBSTS7_LB_OFFSET },
+	{ XRFDC_DSA_UPDT_OFFSET, XRFDC_DSA_UPDT_OFFSET },
+	{ XRFDC_ADC_FIFO_LTNCY_LB_OFFSET, XRFDC_ADC_FIFO_LTNCY_MB_OFFSET },
+};
+
+/* HSCOM registers, as offsets from XRFDC_HSCOM_ADDR, that are never held */
+static const XRFdc_ShadowRange XRFdc_HSCOMVolatile[] = {
+	{ XRFDC_MTS_SRCAP_PLL, XRFDC_MTS_SRCAP_PLL },
+	{ XRFDC_MTS_SRCAP_T1, XRFDC_HSCOM_PWR_OFFSET },
+	{ XRFDC_MTS_SRDTC_PLL, XRFDC_MTS_SRDTC_T1 },
+	{ XRFDC_MTS_SRCAP_DIG, XRFDC_HSCOM_UPDT_DYN_OFFSET },
+	{ XRFDC_MTS_SRFLAG, XRFDC_MTS_SRFLAG },
+};
+
+/************************** Function Prototypes ******************************/
+
+/*****************************************************************************/
+/**
+*
+* Static API to check if a register offset is in a table of ranges.
+*
+* @param    RangePtr is the table of ranges.
+* @param    NumRanges is the number of entries in the table.
+* @param    Offset is the register offset.
+*
+* @return
+*           - 1 if the offset is in one of the ranges, otherwise 0.
+*
+******************************************************************************/
+static u32 XRFdc_ShadowInRange(const XRFdc_ShadowRange *RangePtr, u32 NumRanges, u32 Offset)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < NumRanges; Index++) {
+		if ((Offset >= RangePtr[Index].First) && (Offset <= RangePtr[Index].Last)) {
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* Static API to get the shadow index of a register.
+*
+* @param    Addr is the register offset from the base of the IP.
+*
+* @return
+*           - The tile index (DAC tiles 0-3, then ADC tiles 0-3) times
+*             XRFDC_SHADOW_TILE_REGS plus the register index in the tile.
+*           - XRFDC_SHADOW_NONE if the register is never held.
+*
+******************************************************************************/
+static u32 XRFdc_ShadowIndex(u32 Addr)
+{
+	u32 Tile;
+	u32 Offset;
+	u32 Volatile;
+
+	if ((Addr < XRFDC_DAC_TILE_CTRL_STATS_ADDR(0U)) || (Addr >= XRFDC_ADC_TILE_CTRL_STATS_ADDR(4U)) ||
+	    ((Addr & XRFDC_TILE_DRP_OFFSET) == 0U) || ((Addr & 0x3U) != 0U)) {
+		return XRFDC_SHADOW_NONE;
+	}
+
+	Tile = (Addr - XRFDC_DAC_TILE_CTRL_STATS_ADDR(0U)) >> 14U;
+	Offset = Addr & (XRFDC_TILE_DRP_OFFSET - 1U);
+	if (Offset < XRFDC_BLOCK_ADDR_OFFSET(XRFDC_NUM_OF_BLKS4)) {
+		Volatile = XRFdc_ShadowInRange(XRFdc_BlockVolatile,
+					       sizeof(XRFdc_BlockVolatile) / sizeof(XRFdc_BlockVolatile[0]),
+					       Offset & (XRFDC_BLOCK_ADDR_OFFSET(1U) - 1U));
+	} else if (Offset >= XRFDC_HSCOM_ADDR) {
+		Volatile = XRFdc_ShadowInRange(XRFdc_HSCOMVolatile,
+					       sizeof(XRFdc_HSCOMVolatile) / sizeof(XRFdc_HSCOMVolatile[0]),
+					       Offset - XRFDC_HSCOM_ADDR);
+	} else {
+		Volatile = 1U;
+	}
+
+	return (Volatile != 0U) ? XRFDC_SHADOW_NONE : ((Tile * XRFDC_SHADOW_TILE_REGS) + (Offset >> 2U));
+}
+
+/*****************************************************************************/
+/**
+*
+* Static API to get the register offset of a shadow index.
+*
+* @param    Index is the shadow index.
+*
+* @return
+*           - The register offset from the base of the IP.
+*
+******************************************************************************/
+static u32 XRFdc_ShadowAddr(u32 Index)
+{
+	u32 Tile;
+	u32 BaseAddr;
+
+	Tile = Index / XRFDC_SHADOW_TILE_REGS;
+	BaseAddr = (Tile < XRFDC_SHADOW_ADC_TILE0) ? XRFDC_DAC_TILE_DRP_ADDR(Tile) :
+						     XRFDC_ADC_TILE_DRP_ADDR(Tile - XRFDC_SHADOW_ADC_TILE0);
+
+	return BaseAddr + ((Index % XRFDC_SHADOW_TILE_REGS) << 2U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API enables the shadow registers, or disables them when ShadowPtr is
+* NULL. The structure is owned by the caller and must stay valid until the
+* shadow registers are disabled. No register is held when they are enabled.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    ShadowPtr is a pointer to the shadow register structure.
+*
+* @return
+*           - None
+*
+* @note     Enable after XRFdc_CfgInitialize().
+*
+******************************************************************************/
+void XRFdc_ShadowEnable(XRFdc *InstancePtr, XRFdc_Shadow *ShadowPtr)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	if (InstancePtr->Shadow != NULL) {
+		XRFdc_ShadowFlush(InstancePtr);
+	}
+	if (ShadowPtr != NULL) {
+		memset(ShadowPtr->Valid, 0, sizeof(ShadowPtr->Valid));
+		memset(ShadowPtr->Dirty, 0, sizeof(ShadowPtr->Dirty));
+		memset(ShadowPtr->Events, 0, sizeof(ShadowPtr->Events));
+		ShadowPtr->NumPending = 0U;
+		ShadowPtr->InConfigSet = 0U;
+	}
+	InstancePtr->Shadow = ShadowPtr;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API drops the held registers of a tile, so that they are read from
+* the device again. Pending writes are written out first. The driver calls it
+* when a tile is restarted; call it after anything else that changes the
+* tile registers outside the driver.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
+* @param    Tile_Id Valid values are 0-3, and -1 for all tiles.
+*
+* @return
+*           - None
+*
+******************************************************************************/
+void XRFdc_ShadowInvalidate(XRFdc *InstancePtr, u32 Type, int Tile_Id)
+{
+	XRFdc_Shadow *ShadowPtr;
+	u32 Tile;
+	u32 NoOfTiles;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	ShadowPtr = InstancePtr->Shadow;
+	if (ShadowPtr == NULL) {
+		return;
+	}
+	XRFdc_ShadowFlush(InstancePtr);
+
+	if (Tile_Id == XRFDC_SELECT_ALL_TILES) {
+		Tile = XRFDC_TILE_ID0;
+		NoOfTiles = XRFDC_NUM_OF_TILES4;
+	} else {
+		Tile = (u32)Tile_Id;
+		NoOfTiles = Tile + 1U;
+	}
+	for (; Tile < NoOfTiles; Tile++) {
+		memset(ShadowPtr->Valid[(Type == XRFDC_ADC_TILE) ? (XRFDC_SHADOW_ADC_TILE0 + Tile) : Tile], 0,
+		       sizeof(ShadowPtr->Valid[0]));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes out the pending writes of a configuration set, in order of
+* first write.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+*
+* @return
+*           - None
+*
+******************************************************************************/
+void XRFdc_ShadowFlush(XRFdc *InstancePtr)
+{
+	XRFdc_Shadow *ShadowPtr;
+	u32 Index;
+	u32 ShadowIndex;
+	u32 Tile;
+	u32 Reg;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	ShadowPtr = InstancePtr->Shadow;
+	if (ShadowPtr == NULL) {
+		return;
+	}
+
+	for (Index = 0U; Index < ShadowPtr->NumPending; Index++) {
+		ShadowIndex = ShadowPtr->Pending[Index];
+		Tile = ShadowIndex / XRFDC_SHADOW_TILE_REGS;
+		Reg = ShadowIndex % XRFDC_SHADOW_TILE_REGS;
+		XRFdc_Out16(InstancePtr->io, XRFdc_ShadowAddr(ShadowIndex), ShadowPtr->Value[Tile][Reg]);
+		ShadowPtr->Dirty[Tile][Reg >> 5U] &= ~(1U << (Reg & 0x1FU));
+	}
+	ShadowPtr->NumPending = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* Read a 16-bit register, from the shadow registers if it is held.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Addr is the register offset from the base of the IP.
+*
+* @return
+*           - The register value.
+*
+* @note     Called by XRFdc_ReadReg16() when the shadow registers are enabled.
+*
+******************************************************************************/
+u16 XRFdc_ShadowRead16(XRFdc *InstancePtr, u32 Addr)
+{
+	XRFdc_Shadow *ShadowPtr = InstancePtr->Shadow;
+	u32 Index;
+	u32 Tile;
+	u32 Reg;
+
+	Index = XRFdc_ShadowIndex(Addr);
+	if (Index == XRFDC_SHADOW_NONE) {
+		if (ShadowPtr->NumPending != 0U) {
+			XRFdc_ShadowFlush(InstancePtr);
+		}
+	} else {
+		Tile = Index / XRFDC_SHADOW_TILE_REGS;
+		Reg = Index % XRFDC_SHADOW_TILE_REGS;
+		if ((ShadowPtr->Valid[Tile][Reg >> 5U] & (1U << (Reg & 0x1FU))) != 0U) {
+			return ShadowPtr->Value[Tile][Reg];
+		}
+	}
+
+	return XRFdc_In16(InstancePtr->io, Addr);
+}
+
+/*****************************************************************************/
+/**
+*
+* Write a 16-bit register and hold its value. Within a configuration set the
+* write is recorded and written out by XRFdc_ShadowFlush(), and is dropped if
+* the register already holds the value.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Addr is the register offset from the base of the IP.
+* @param    Data is the value to be written to the register.
+*
+* @return
+*           - None
+*
+* @note     Called by XRFdc_WriteReg16() when the shadow registers are enabled.
+*
+******************************************************************************/
+void XRFdc_ShadowWrite16(XRFdc *InstancePtr, u32 Addr, u16 Data)
+{
+	XRFdc_Shadow *ShadowPtr = InstancePtr->Shadow;
+	u32 Index;
+	u32 Tile;
+	u32 Reg;
+	u32 Bit;
+
+	Index = XRFdc_ShadowIndex(Addr);
+	if (Index == XRFDC_SHADOW_NONE) {
+		if (ShadowPtr->NumPending != 0U) {
+			XRFdc_ShadowFlush(InstancePtr);
+		}
+		XRFdc_Out16(InstancePtr->io, Addr, Data);
+		return;
+	}
+
+	Tile = Index / XRFDC_SHADOW_TILE_REGS;
+	Reg = Index % XRFDC_SHADOW_TILE_REGS;
+	Bit = 1U << (Reg & 0x1FU);
+	if (ShadowPtr->InConfigSet == 0U) {
+		XRFdc_Out16(InstancePtr->io, Addr, Data);
+	} else if ((ShadowPtr->Dirty[Tile][Reg >> 5U] & Bit) == 0U) {
+		if (((ShadowPtr->Valid[Tile][Reg >> 5U] & Bit) != 0U) && (ShadowPtr->Value[Tile][Reg] == Data)) {
+			return;
+		}
+		if (ShadowPtr->NumPending == XRFDC_SHADOW_PENDING_MAX) {
+			XRFdc_ShadowFlush(InstancePtr);
+		}
+		ShadowPtr->Dirty[Tile][Reg >> 5U] |= Bit;
+		ShadowPtr->Pending[ShadowPtr->NumPending] = (u16)Index;
+		ShadowPtr->NumPending++;
+	}
+	ShadowPtr->Value[Tile][Reg] = Data;
+	ShadowPtr->Valid[Tile][Reg >> 5U] |= Bit;
+}
+
+/*****************************************************************************/
+/**
+*
+* Prepare for a register access that does not go through the shadow
+* registers: write out the pending writes and, for a write, drop the held
+* registers it overlaps.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Addr is the register offset from the base of the IP.
+* @param    Width is the access width in bytes.
+* @param    IsWrite is 1 for a write, 0 for a read.
+*
+* @return
+*           - None
+*
+* @note     Called by the 8, 32 and 64-bit register access macros when the
+*           shadow registers are enabled.
+*
+******************************************************************************/
+void XRFdc_ShadowSync(XRFdc *InstancePtr, u32 Addr, u32 Width, u32 IsWrite)
+{
+	XRFdc_Shadow *ShadowPtr = InstancePtr->Shadow;
+	u32 RegAddr;
+	u32 Index;
+	u32 Reg;
+
+	if (ShadowPtr->NumPending != 0U) {
+		XRFdc_ShadowFlush(InstancePtr);
+	}
+	if (IsWrite == 0U) {
+		return;
+	}
+
+	for (RegAddr = Addr & ~0x3U; RegAddr < (Addr + Width); RegAddr += 4U) {
+		Index = XRFdc_ShadowIndex(RegAddr);
+		if (Index != XRFDC_SHADOW_NONE) {
+			Reg = Index % XRFDC_SHADOW_TILE_REGS;
+			ShadowPtr->Valid[Index / XRFDC_SHADOW_TILE_REGS][Reg >> 5U] &= ~(1U << (Reg & 0x1FU));
+		}
+	}
+}
+
+/** @} */
@@ -0,0 +1,217 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file rfdc_mock.c
+*
+* Register file standing in for the RFdc IP. The registers are 32 bits
+* wide at 4-byte strides over the XRFDC_REGION_SIZE bytes of the IP; a
+* 16-bit access reads or writes the low half of a register.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rfdc_mock.h"
+
+/************************** Constant Definitions *****************************/
+
+#define RFDCMOCK_NUM_REGS	(XRFDC_REGION_SIZE / 4U)
+
+/************************** Variable Definitions *****************************/
+
+RFdcMock_Count RFdcMockCount;
+RFdcMock_Write RFdcMockLog[RFDCMOCK_LOG_MAX];
+u32 RFdcMockNumLog;
+
+static u32 Regs[RFDCMOCK_NUM_REGS];
+static struct metal_io_region Io;
+
+/*****************************************************************************/
+static u32 *RFdcMock_Reg(unsigned long Offset)
+{
+	if (Offset >= XRFDC_REGION_SIZE) {
+		printf("rfdc_mock: access at 0x%lx outside the IP\n", Offset);
+		exit(1);
+	}
+
+	return &Regs[Offset >> 2];
+}
+
+static uint64_t RFdcMock_Read(struct metal_io_region *IoPtr, unsigned long Offset,
+			      memory_order Order, int Width)
+{
+	(void)IoPtr;
+	(void)Order;
+	if (Width == 2) {
+		RFdcMockCount.Read16++;
+		return *RFdcMock_Reg(Offset) & 0xFFFFU;
+	}
+	RFdcMockCount.Read32++;
+	if (Width == 8) {
+		return *RFdcMock_Reg(Offset) | ((uint64_t)*RFdcMock_Reg(Offset + 4U) << 32);
+	}
+
+	return *RFdcMock_Reg(Offset) & ((Width == 1) ? 0xFFU : 0xFFFFFFFFU);
+}
+
+static void RFdcMock_WriteOp(struct metal_io_region *IoPtr, unsigned long Offset,
+			     uint64_t Value, memory_order Order, int Width)
+{
+	(void)IoPtr;
+	(void)Order;
+	if (Width == 2) {
+		RFdcMockCount.Write16++;
+		*RFdcMock_Reg(Offset) = (u32)Value & 0xFFFFU;
+		if (RFdcMockNumLog < RFDCMOCK_LOG_MAX) {
+			RFdcMockLog[RFdcMockNumLog].Addr = (u32)Offset;
+			RFdcMockLog[RFdcMockNumLog].Value = (u16)Value;
+			RFdcMockNumLog++;
+		}
+		return;
+	}
+	RFdcMockCount.Write32++;
+	if ((Offset >= XRFDC_DAC_TILE_CTRL_STATS_ADDR(0U)) && (Offset < XRFDC_ADC_TILE_CTRL_STATS_ADDR(4U)) &&
+	    ((Offset & 0x3FFFU) == XRFDC_RESTART_OFFSET)) {
+		/* The restart completes at once */
+		Value = 0U;
+	}
+	if (Width == 8) {
+		*RFdcMock_Reg(Offset + 4U) = (u32)(Value >> 32);
+	}
+	*RFdcMock_Reg(Offset) = (u32)Value & ((Width == 1) ? 0xFFU : 0xFFFFFFFFU);
+}
+
+/* I/O region of the register file, all registers 0 */
+struct metal_io_region *RFdcMock_Init(void)
+{
+	static const struct metal_io_ops Ops = {
+		.read = RFdcMock_Read,
+		.write = RFdcMock_WriteOp,
+	};
+
+	metal_io_init(&Io, Regs, NULL, sizeof(Regs), (unsigned)-1, 0U, &Ops);
+	RFdcMock_Reset();
+
+	return &Io;
+}
+
+/*
+ * Gen 3 instance on the register file: four DAC tiles at 6.4 GSPS and four
+ * ADC tiles at 2 GSPS, all blocks available with the fine mixer.
+ */
+void RFdcMock_InitInstance(XRFdc *InstancePtr)
+{
+	u32 Tile;
+	u32 Block;
+
+	(void)memset(InstancePtr, 0, sizeof(*InstancePtr));
+	InstancePtr->RFdc_Config.IPType = XRFDC_GEN3;
+	InstancePtr->io = RFdcMock_Init();
+	InstancePtr->IsReady = XRFDC_COMPONENT_IS_READY;
+	for (Tile = 0U; Tile < XRFDC_NUM_OF_TILES4; Tile++) {
+		InstancePtr->RFdc_Config.DACTile_Config[Tile].Enable = 1U;
+		InstancePtr->RFdc_Config.DACTile_Config[Tile].SamplingRate = 6.4;
+		InstancePtr->RFdc_Config.DACTile_Config[Tile].NumSlices = 4U;
+		InstancePtr->DAC_Tile[Tile].PLL_Settings.SampleRate = 6.4;
+		InstancePtr->RFdc_Config.ADCTile_Config[Tile].Enable = 1U;
+		InstancePtr->RFdc_Config.ADCTile_Config[Tile].SamplingRate = 2.0;
+		InstancePtr->RFdc_Config.ADCTile_Config[Tile].NumSlices = XRFDC_NUM_SLICES_LSADC;
+		InstancePtr->ADC_Tile[Tile].PLL_Settings.SampleRate = 2.0;
+		for (Block = 0U; Block < XRFDC_NUM_OF_BLKS4; Block++) {
+			InstancePtr->RFdc_Config.DACTile_Config[Tile].DACBlock_Analog_Config[Block].BlockAvailable = 1U;
+			InstancePtr->RFdc_Config.DACTile_Config[Tile].DACBlock_Digital_Config[Block].MixerType =
+				XRFDC_MIXER_TYPE_FINE;
+			InstancePtr->DAC_Tile[Tile].DACBlock_Digital_Datapath[Block].Mixer_Settings.MixerType =
+				XRFDC_MIXER_TYPE_FINE;
+			InstancePtr->RFdc_Config.ADCTile_Config[Tile].ADCBlock_Analog_Config[Block].BlockAvailable = 1U;
+			InstancePtr->RFdc_Config.ADCTile_Config[Tile].ADCBlock_Digital_Config[Block].MixerType =
+				XRFDC_MIXER_TYPE_FINE;
+			InstancePtr->ADC_Tile[Tile].ADCBlock_Digital_Datapath[Block].Mixer_Settings.MixerType =
+				XRFDC_MIXER_TYPE_FINE;
+		}
+	}
+}
+
+void RFdcMock_Reset(void)
+{
+	(void)memset(Regs, 0, sizeof(Regs));
+	RFdcMock_ResetCount();
+}
+
+/* Clears the counts and the write log */
+void RFdcMock_ResetCount(void)
+{
+	(void)memset(&RFdcMockCount, 0, sizeof(RFdcMockCount));
+	RFdcMockNumLog = 0U;
+}
+
+/* Register value, without counting a read */
+u32 RFdcMock_Peek(u32 Addr)
+{
+	return *RFdcMock_Reg(Addr);
+}
+
+/* Set a register, without counting a write */
+void RFdcMock_Poke(u32 Addr, u32 Data)
+{
+	*RFdcMock_Reg(Addr) = Data;
+}
+
+/* Reads of any width, each one bus transaction */
+u32 RFdcMock_Reads(void)
+{
+	return RFdcMockCount.Read16 + RFdcMockCount.Read32;
+}
+
+/* Writes of any width, each one bus transaction */
+u32 RFdcMock_Writes(void)
+{
+	return RFdcMockCount.Write16 + RFdcMockCount.Write32;
+}
+
+/* Copy the register file, Image holds XRFDC_REGION_SIZE / 4 registers */
+void RFdcMock_Snapshot(u32 *Image)
+{
+	(void)memcpy(Image, Regs, sizeof(Regs));
+}
+
+/* Number of registers that differ from a snapshot */
+u32 RFdcMock_Compare(const u32 *Image)
+{
+	u32 Idx, Diff = 0U;
+
+	for (Idx = 0U; Idx < RFDCMOCK_NUM_REGS; Idx++) {
+		if (Regs[Idx] != Image[Idx]) {
+			Diff++;
+		}
+	}
+
+	return Diff;
+}
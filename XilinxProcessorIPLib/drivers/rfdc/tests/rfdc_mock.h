@@ -0,0 +1,91 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file rfdc_mock.h
+*
+* Register file standing in for the RFdc IP, for host builds of the driver
+* against libmetal. The register file is a libmetal I/O region whose read
+* and write operations are served from memory, so every register reads back
+* the last value written, 0 if never written. The model counts the accesses
+* per width, so that tests can check how many bus transactions a driver call
+* costs, and logs the 16-bit writes in order.
+*
+* Tests change a register behind the driver with RFdcMock_Poke(), as the
+* hardware does for status and readback registers. The restart register of
+* a tile reads back 0, as if each restart completed at once.
+*
+******************************************************************************/
+#ifndef RFDC_MOCK_H
+#define RFDC_MOCK_H
+
+#include "xrfdc.h"
+
+/************************** Constant Definitions *****************************/
+
+#define RFDCMOCK_LOG_MAX	8192U	/**< 16-bit writes held by the log */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Access counts of the model.
+ */
+typedef struct {
+	u32 Read16;		/**< 16-bit reads */
+	u32 Write16;		/**< 16-bit writes */
+	u32 Read32;		/**< 8, 32 and 64-bit reads */
+	u32 Write32;		/**< 8, 32 and 64-bit writes */
+} RFdcMock_Count;
+
+/**
+ * Logged 16-bit write.
+ */
+typedef struct {
+	u32 Addr;		/**< Register offset from the base of the IP */
+	u16 Value;		/**< Value written */
+} RFdcMock_Write;
+
+/************************** Variable Definitions *****************************/
+
+extern RFdcMock_Count RFdcMockCount;
+extern RFdcMock_Write RFdcMockLog[RFDCMOCK_LOG_MAX];
+extern u32 RFdcMockNumLog;
+
+/************************** Function Prototypes ******************************/
+
+struct metal_io_region *RFdcMock_Init(void);
+void RFdcMock_InitInstance(XRFdc *InstancePtr);
+void RFdcMock_Reset(void);
+void RFdcMock_ResetCount(void);
+u32 RFdcMock_Peek(u32 Addr);
+void RFdcMock_Poke(u32 Addr, u32 Data);
+u32 RFdcMock_Reads(void);
+u32 RFdcMock_Writes(void);
+u32 RFdcMock_Compare(const u32 *Image);
+void RFdcMock_Snapshot(u32 *Image);
+
+#endif /* RFDC_MOCK_H */
@@ -0,0 +1,299 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file test_hop.c
+*
+* Host test and benchmark of the frequency hop tables of xrfdc_mixer.c
+* against the register file in rfdc_mock.c.
+*
+* Usage: test_hop [bench]
+*
+* Without arguments the 16 DAC blocks go through a sequence of hop states
+* twice, once with XRFdc_SetMixerSettings() and XRFdc_UpdateEvent() and
+* once with XRFdc_SetHopState(), for the tile, slice and SYSREF event
+* sources; after every hop the register file and the mixer state of the
+* instance must match. The same is checked for the two blocks of a 4GSPS
+* ADC tile, and that compiling a table writes nothing.
+* With "bench" the median and 99th percentile latency of a hop and its bus
+* transactions are printed for both paths.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xrfdc.h"
+#include "rfdc_mock.h"
+
+/************************** Constant Definitions *****************************/
+
+#define TEST_STATES	8U	/**< Hop states of a table */
+#define TEST_TABLES	16U	/**< DAC blocks, one table each */
+#define TEST_HOPS	12U	/**< Hops of the checked sequence */
+#define TEST_BENCH_HOPS	20000U	/**< Hops of a benchmark run */
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CHECK(Cond)	Test_Check((Cond) ? 1U : 0U, #Cond, __LINE__)
+
+/************************** Variable Definitions *****************************/
+
+static u32 Failures;
+static XRFdc RFdcInst;
+static XRFdc_Mixer_Settings Settings[TEST_STATES];
+static XRFdc_Hop_State HopStates[TEST_TABLES][TEST_STATES];
+static XRFdc_Hop_Table HopTables[TEST_TABLES];
+static u32 RefImage[TEST_HOPS][XRFDC_REGION_SIZE / 4U];
+static XRFdc_DAC_Tile RefDacTile[TEST_HOPS][4];
+static XRFdc_ADC_Tile RefAdcTile[TEST_HOPS][4];
+static u8 RefMixerScale[TEST_HOPS];
+static double Latency[TEST_BENCH_HOPS];
+
+/* States of the checked sequence, with repeats and returns */
+static const u32 Sequence[TEST_HOPS] = { 0U, 3U, 1U, 7U, 7U, 2U, 0U, 5U, 4U, 6U, 3U, 0U };
+
+/*****************************************************************************/
+static void Test_Check(u32 Ok, const char *Cond, int Line)
+{
+	if (Ok == 0U) {
+		printf("  FAIL line %d: %s\n", Line, Cond);
+		Failures++;
+	}
+}
+
+/*
+ * Fine mixer settings of the hop states: the frequency, the phase and the
+ * mixer scale change from state to state.
+ */
+static void Test_Settings(u32 MixerMode, u32 EventSource)
+{
+	u32 State;
+
+	for (State = 0U; State < TEST_STATES; State++) {
+		(void)memset(&Settings[State], 0, sizeof(Settings[State]));
+		Settings[State].Freq = 500.0 + (150.0 * State);
+		Settings[State].PhaseOffset = (10.0 * State) - 30.0;
+		Settings[State].MixerMode = MixerMode;
+		Settings[State].MixerType = XRFDC_MIXER_TYPE_FINE;
+		Settings[State].CoarseMixFreq = XRFDC_COARSE_MIX_OFF;
+		Settings[State].FineMixerScale = (State % 3U == 2U) ? XRFDC_MIXER_SCALE_0P7 : XRFDC_MIXER_SCALE_AUTO;
+		Settings[State].EventSource = EventSource;
+	}
+}
+
+/* One hop of the blocks with XRFdc_SetMixerSettings() and XRFdc_UpdateEvent() */
+static u32 Test_DirectHop(u32 Type, u32 NumTables, u32 State)
+{
+	XRFdc_Mixer_Settings Mixer;
+	u32 Table;
+	u32 Status = XRFDC_SUCCESS;
+
+	for (Table = 0U; Table < NumTables; Table++) {
+		Mixer = Settings[State];
+		Status |= XRFdc_SetMixerSettings(&RFdcInst, Type, HopTables[Table].Tile_Id, HopTables[Table].Block_Id,
+						 &Mixer);
+		/* SYSREF updates are issued outside the driver */
+		if (Mixer.EventSource != XRFDC_EVNT_SRC_SYSREF) {
+			Status |= XRFdc_UpdateEvent(&RFdcInst, Type, HopTables[Table].Tile_Id,
+						    HopTables[Table].Block_Id, XRFDC_EVENT_MIXER);
+		}
+	}
+
+	return Status;
+}
+
+/* Compiles the tables of the blocks, checking that nothing is written */
+static u32 Test_Compile(u32 Type, const u32 *Tiles, const u32 *Blocks, u32 NumTables)
+{
+	u32 Table;
+	u32 Status = XRFDC_SUCCESS;
+
+	RFdcMock_ResetCount();
+	for (Table = 0U; Table < NumTables; Table++) {
+		Status |= XRFdc_CompileHopTable(&RFdcInst, Type, Tiles[Table], Blocks[Table], Settings, TEST_STATES,
+						HopStates[Table], &HopTables[Table]);
+	}
+	CHECK(RFdcMock_Writes() == 0U);
+
+	return Status;
+}
+
+/*
+ * Runs the sequence with the direct path, recording the register file and
+ * the instance after each hop, then with the hop tables, comparing.
+ */
+static void Test_Sequence(u32 Type, const u32 *Tiles, const u32 *Blocks, u32 NumTables, u32 HighSpeedADC)
+{
+	u32 Hop, Table, Diff;
+
+	RFdcMock_InitInstance(&RFdcInst);
+	if (HighSpeedADC != 0U) {
+		RFdcInst.RFdc_Config.ADCTile_Config[Tiles[0]].NumSlices = XRFDC_NUM_SLICES_HSADC;
+	}
+	CHECK(Test_Compile(Type, Tiles, Blocks, NumTables) == XRFDC_SUCCESS);
+	for (Hop = 0U; Hop < TEST_HOPS; Hop++) {
+		CHECK(Test_DirectHop(Type, NumTables, Sequence[Hop]) == XRFDC_SUCCESS);
+		RFdcMock_Snapshot(RefImage[Hop]);
+		(void)memcpy(RefDacTile[Hop], RFdcInst.DAC_Tile, sizeof(RFdcInst.DAC_Tile));
+		(void)memcpy(RefAdcTile[Hop], RFdcInst.ADC_Tile, sizeof(RFdcInst.ADC_Tile));
+		RefMixerScale[Hop] = RFdcInst.UpdateMixerScale;
+	}
+
+	RFdcMock_InitInstance(&RFdcInst);
+	if (HighSpeedADC != 0U) {
+		RFdcInst.RFdc_Config.ADCTile_Config[Tiles[0]].NumSlices = XRFDC_NUM_SLICES_HSADC;
+	}
+	CHECK(Test_Compile(Type, Tiles, Blocks, NumTables) == XRFDC_SUCCESS);
+	for (Table = 0U; Table < NumTables; Table++) {
+		CHECK(HopTables[Table].CurrentState == XRFDC_HOP_STATE_NONE);
+	}
+	Diff = 0U;
+	for (Hop = 0U; Hop < TEST_HOPS; Hop++) {
+		RFdcMock_ResetCount();
+		CHECK(XRFdc_SetHopState(&RFdcInst, HopTables, NumTables, Sequence[Hop]) == XRFDC_SUCCESS);
+		CHECK(RFdcMock_Reads() == 0U);
+		Diff += RFdcMock_Compare(RefImage[Hop]);
+		CHECK(memcmp(RefDacTile[Hop], RFdcInst.DAC_Tile, sizeof(RFdcInst.DAC_Tile)) == 0);
+		CHECK(memcmp(RefAdcTile[Hop], RFdcInst.ADC_Tile, sizeof(RFdcInst.ADC_Tile)) == 0);
+		CHECK(RefMixerScale[Hop] == RFdcInst.UpdateMixerScale);
+	}
+	CHECK(Diff == 0U);
+	CHECK(HopTables[0].CurrentState == Sequence[TEST_HOPS - 1U]);
+	CHECK(XRFdc_SetHopState(&RFdcInst, HopTables, NumTables, TEST_STATES) == XRFDC_FAILURE);
+}
+
+/* The 16 DAC blocks, with each event source */
+static void Test_DACBlocks(void)
+{
+	static const u32 Sources[] = { XRFDC_EVNT_SRC_TILE, XRFDC_EVNT_SRC_SLICE, XRFDC_EVNT_SRC_SYSREF };
+	u32 Tiles[TEST_TABLES], Blocks[TEST_TABLES];
+	u32 Source, Table;
+
+	for (Table = 0U; Table < TEST_TABLES; Table++) {
+		Tiles[Table] = Table / XRFDC_NUM_OF_BLKS4;
+		Blocks[Table] = Table % XRFDC_NUM_OF_BLKS4;
+	}
+	for (Source = 0U; Source < sizeof(Sources) / sizeof(Sources[0]); Source++) {
+		Test_Settings(XRFDC_MIXER_MODE_C2R, Sources[Source]);
+		Test_Sequence(XRFDC_DAC_TILE, Tiles, Blocks, TEST_TABLES, 0U);
+	}
+}
+
+/* Block 1 of a 4GSPS ADC tile, whose mixer is in blocks 2 and 3 */
+static void Test_HighSpeedADC(void)
+{
+	static const u32 Tiles[] = { 1U };
+	static const u32 Blocks[] = { 1U };
+
+	Test_Settings(XRFDC_MIXER_MODE_C2C, XRFDC_EVNT_SRC_TILE);
+	Test_Sequence(XRFDC_ADC_TILE, Tiles, Blocks, 1U, 1U);
+	CHECK(HopStates[0][0].BlockMask == 0xCU);
+}
+
+/*****************************************************************************/
+static double Test_Now(void)
+{
+	struct timespec Ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &Ts);
+	return (Ts.tv_sec * 1e9) + Ts.tv_nsec;
+}
+
+static int Test_CompareLatency(const void *A, const void *B)
+{
+	double Diff = *(const double *)A - *(const double *)B;
+
+	return (Diff > 0) - (Diff < 0);
+}
+
+/* Median and 99th percentile of the hop latencies, sorted in place */
+static void Test_PrintLatency(const char *Name, double *Latency, u32 Writes, u32 Reads)
+{
+	qsort(Latency, TEST_BENCH_HOPS, sizeof(Latency[0]), Test_CompareLatency);
+	printf("  %-31s %6.0f ns median %6.0f ns p99 %4u writes %4u reads\n", Name,
+	       Latency[TEST_BENCH_HOPS / 2U], Latency[(TEST_BENCH_HOPS * 99U) / 100U], Writes / TEST_BENCH_HOPS,
+	       Reads / TEST_BENCH_HOPS);
+}
+
+/*
+ * Latency of each hop of the 16 DAC blocks through the 8 states, and its bus
+ * transactions, with the direct path and with the hop tables.
+ */
+static void Test_Bench(u32 EventSource, const char *Name)
+{
+	u32 Tiles[TEST_TABLES], Blocks[TEST_TABLES];
+	u32 Hop, Table;
+	u32 Status = XRFDC_SUCCESS;
+	double Start;
+
+	for (Table = 0U; Table < TEST_TABLES; Table++) {
+		Tiles[Table] = Table / XRFDC_NUM_OF_BLKS4;
+		Blocks[Table] = Table % XRFDC_NUM_OF_BLKS4;
+	}
+	Test_Settings(XRFDC_MIXER_MODE_C2R, EventSource);
+	RFdcMock_InitInstance(&RFdcInst);
+	Status |= Test_Compile(XRFDC_DAC_TILE, Tiles, Blocks, TEST_TABLES);
+	printf("%s event, 16 DAC blocks, per hop:\n", Name);
+
+	RFdcMock_ResetCount();
+	for (Hop = 0U; Hop < TEST_BENCH_HOPS; Hop++) {
+		Start = Test_Now();
+		Status |= Test_DirectHop(XRFDC_DAC_TILE, TEST_TABLES, Hop % TEST_STATES);
+		Latency[Hop] = Test_Now() - Start;
+	}
+	Test_PrintLatency("SetMixerSettings + UpdateEvent", Latency, RFdcMock_Writes(), RFdcMock_Reads());
+
+	RFdcMock_ResetCount();
+	for (Hop = 0U; Hop < TEST_BENCH_HOPS; Hop++) {
+		Start = Test_Now();
+		Status |= XRFdc_SetHopState(&RFdcInst, HopTables, TEST_TABLES, Hop % TEST_STATES);
+		Latency[Hop] = Test_Now() - Start;
+	}
+	Test_PrintLatency("SetHopState", Latency, RFdcMock_Writes(), RFdcMock_Reads());
+	CHECK(Status == XRFDC_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+	if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+		Test_Bench(XRFDC_EVNT_SRC_TILE, "tile");
+		Test_Bench(XRFDC_EVNT_SRC_SYSREF, "SYSREF");
+	} else {
+		Test_DACBlocks();
+		Test_HighSpeedADC();
+	}
+
+	if (Failures != 0U) {
+		printf("test_hop: %u check(s) failed\n", Failures);
+		return 1;
+	}
+	printf("test_hop: all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,485 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file test_shadow.c
+*
+* Host test of the shadow registers of xrfdc_shadow.c against the register
+* file in rfdc_mock.c. It checks which registers are held: the block
+* registers of XRFdc_BlockVolatile and the HSCOM registers of
+* XRFdc_HSCOMVolatile are read from the device every time, as are the
+* control and status region of a tile and the addresses outside the tiles,
+* while the other tile registers are served from memory once written. It
+* checks that XRFdc_ShadowInvalidate(), a tile restart and a 32-bit write
+* drop the held registers, that a configuration set writes each register
+* once in order of first write and arms a tile once, and counts the bus
+* transactions of a mixer, QMC and coarse delay workload with direct
+* access, with the shadow registers and with a configuration set.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <string.h>
+#include "xrfdc.h"
+#include "rfdc_mock.h"
+
+/************************** Constant Definitions *****************************/
+
+#define TEST_HELD	1U	/**< Register read from the shadow registers */
+#define TEST_DEVICE	0U	/**< Register read from the device */
+#define TEST_ROUNDS	2U	/**< Rounds of the workload */
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CHECK(Cond)	Test_Check((Cond) ? 1U : 0U, #Cond, __LINE__)
+#define NUM(Table)	(sizeof(Table) / sizeof(Table[0]))
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u32 First;		/**< First register of the range */
+	u32 Last;		/**< Last register of the range */
+} Test_Range;
+
+/************************** Variable Definitions *****************************/
+
+static u32 Failures;
+static XRFdc RFdcInst;
+static XRFdc_Shadow Shadow;
+static u32 Image[3][XRFDC_REGION_SIZE / 4U];
+
+/* Same ranges as XRFdc_BlockVolatile */
+static const Test_Range BlockVolatile[] = {
+	{ XRFDC_ADC_FABRIC_ISR_OFFSET, XRFDC_DAC_FABRIC_ISR_OFFSET },
+	{ XRFDC_ADC_UPDATE_DYN_OFFSET, XRFDC_DAC_UPDATE_DYN_OFFSET },
+	{ XRFDC_ADC_DEC_ISR_OFFSET, XRFDC_ADC_DEC_ISR_OFFSET },
+	{ XRFDC_DATPATH_ISR_OFFSET, XRFDC_DATPATH_ISR_OFFSET },
+	{ XRFDC_NCO_RST_OFFSET, XRFDC_NCO_RST_OFFSET },
+	{ XRFDC_ADC_SIG_DETECT_MAGN_OFFSET, XRFDC_ADC_SIG_DETECT_MAGN_OFFSET },
+	{ XRFDC_CAL_TSCB_OFFSET_COEFF0_ALT, XRFDC_CAL_TSCB_OFFSET_COEFF7 },
+	{ XRFDC_ADC_TI_DCBSTS0_BG_OFFSET, XRFDC_ADC_TI_DCBSTS7_LB_OFFSET },
+	{ XRFDC_DSA_UPDT_OFFSET, XRFDC_DSA_UPDT_OFFSET },
+	{ XRFDC_ADC_FIFO_LTNCY_LB_OFFSET, XRFDC_ADC_FIFO_LTNCY_MB_OFFSET },
+};
+
+/* Block registers next to the ranges, and mixer registers, that are held */
+static const u32 BlockHeld[] = {
+	0x00CU, 0x018U, 0x024U, 0x02CU, 0x034U, 0x03CU, 0x08CU, 0x094U, 0x12CU, 0x134U, 0x164U, 0x190U,
+	0x1FCU, 0x240U, 0x250U, 0x258U, 0x27CU, 0x288U, 0x3FCU,
+	XRFDC_MXR_MODE_OFFSET, XRFDC_ADC_NCO_FQWD_LOW_OFFSET, XRFDC_QMC_CFG_OFFSET, XRFDC_DAC_CRSE_DLY_CFG_OFFSET,
+};
+
+/* Same ranges as XRFdc_HSCOMVolatile */
+static const Test_Range HSCOMVolatile[] = {
+	{ XRFDC_MTS_SRCAP_PLL, XRFDC_MTS_SRCAP_PLL },
+	{ XRFDC_MTS_SRCAP_T1, XRFDC_HSCOM_PWR_OFFSET },
+	{ XRFDC_MTS_SRDTC_PLL, XRFDC_MTS_SRDTC_T1 },
+	{ XRFDC_MTS_SRCAP_DIG, XRFDC_HSCOM_UPDT_DYN_OFFSET },
+	{ XRFDC_MTS_SRFLAG, XRFDC_MTS_SRFLAG },
+};
+
+/* HSCOM registers next to the ranges that are held */
+static const u32 HSCOMHeld[] = {
+	0x000U, 0x02CU, 0x034U, 0x08CU, 0x0A0U, 0x0ACU, 0x0BCU, 0x120U, 0x128U, 0x3FCU,
+};
+
+/*****************************************************************************/
+static void Test_Check(u32 Ok, const char *Cond, int Line)
+{
+	if (Ok == 0U) {
+		printf("  FAIL line %d: %s\n", Line, Cond);
+		Failures++;
+	}
+}
+
+/*
+ * Writes a register through the driver, changes it behind the driver and
+ * reads it back: TEST_HELD if the read returned the value written without
+ * a bus read, TEST_DEVICE if it read the device, ~0 otherwise.
+ */
+static u32 Test_Where(u32 Addr)
+{
+	u16 Value;
+
+	XRFdc_WriteReg16(&RFdcInst, 0U, Addr, 0x1234U);
+	RFdcMock_Poke(Addr, 0x5678U);
+	RFdcMock_ResetCount();
+	Value = XRFdc_ReadReg16(&RFdcInst, 0U, Addr);
+	if ((Value == 0x1234U) && (RFdcMock_Reads() == 0U)) {
+		return TEST_HELD;
+	}
+	if ((Value == 0x5678U) && (RFdcMockCount.Read16 == 1U)) {
+		return TEST_DEVICE;
+	}
+
+	return ~0U;
+}
+
+/* Value read by the driver and whether it took a bus read */
+static u16 Test_Read(u32 Addr, u32 *BusReads)
+{
+	u16 Value;
+
+	RFdcMock_ResetCount();
+	Value = XRFdc_ReadReg16(&RFdcInst, 0U, Addr);
+	*BusReads = RFdcMock_Reads();
+
+	return Value;
+}
+
+static void Test_Setup(void)
+{
+	RFdcMock_InitInstance(&RFdcInst);
+	XRFdc_ShadowEnable(&RFdcInst, &Shadow);
+}
+
+/*****************************************************************************/
+/*
+ * Block registers: the first and last register of every XRFdc_BlockVolatile
+ * range are read from the device, the registers around them are held. Each
+ * check runs on a block of a DAC tile and on blocks of an ADC tile.
+ */
+static void Test_BlockVolatile(void)
+{
+	static const u32 Bases[] = {
+		XRFDC_DAC_TILE_DRP_ADDR(1U) + XRFDC_BLOCK_ADDR_OFFSET(2U),
+		XRFDC_ADC_TILE_DRP_ADDR(3U) + XRFDC_BLOCK_ADDR_OFFSET(0U),
+		XRFDC_ADC_TILE_DRP_ADDR(0U) + XRFDC_BLOCK_ADDR_OFFSET(3U),
+	};
+	u32 Base, Idx;
+
+	Test_Setup();
+	for (Base = 0U; Base < NUM(Bases); Base++) {
+		for (Idx = 0U; Idx < NUM(BlockVolatile); Idx++) {
+			CHECK(Test_Where(Bases[Base] + BlockVolatile[Idx].First) == TEST_DEVICE);
+			CHECK(Test_Where(Bases[Base] + BlockVolatile[Idx].Last) == TEST_DEVICE);
+		}
+		for (Idx = 0U; Idx < NUM(BlockHeld); Idx++) {
+			CHECK(Test_Where(Bases[Base] + BlockHeld[Idx]) == TEST_HELD);
+		}
+	}
+	CHECK(Test_Where(XRFDC_DAC_TILE_DRP_ADDR(0U) + XRFDC_BLOCK_ADDR_OFFSET(0U) + XRFDC_DAC_UPDATE_DYN_OFFSET) ==
+	      TEST_DEVICE);
+	CHECK(Test_Where(XRFDC_DAC_TILE_DRP_ADDR(0U) + XRFDC_BLOCK_ADDR_OFFSET(3U) + XRFDC_NCO_RST_OFFSET) ==
+	      TEST_DEVICE);
+}
+
+/*
+ * HSCOM registers: the first and last register of every XRFdc_HSCOMVolatile
+ * range are read from the device, the registers around them are held.
+ */
+static void Test_HSCOMVolatile(void)
+{
+	static const u32 Bases[] = {
+		XRFDC_DAC_TILE_DRP_ADDR(0U) + XRFDC_HSCOM_ADDR,
+		XRFDC_DAC_TILE_DRP_ADDR(3U) + XRFDC_HSCOM_ADDR,
+		XRFDC_ADC_TILE_DRP_ADDR(2U) + XRFDC_HSCOM_ADDR,
+	};
+	u32 Base, Idx;
+
+	Test_Setup();
+	for (Base = 0U; Base < NUM(Bases); Base++) {
+		for (Idx = 0U; Idx < NUM(HSCOMVolatile); Idx++) {
+			CHECK(Test_Where(Bases[Base] + HSCOMVolatile[Idx].First) == TEST_DEVICE);
+			CHECK(Test_Where(Bases[Base] + HSCOMVolatile[Idx].Last) == TEST_DEVICE);
+		}
+		for (Idx = 0U; Idx < NUM(HSCOMHeld); Idx++) {
+			CHECK(Test_Where(Bases[Base] + HSCOMHeld[Idx]) == TEST_HELD);
+		}
+		CHECK(Test_Where(Bases[Base] + XRFDC_HSCOM_CLK_DSTR_OFFSET) == TEST_HELD);
+	}
+}
+
+/*
+ * Registers outside the blocks and HSCOM of a tile: the control and status
+ * region, the DRP space between the blocks and HSCOM, the IP registers
+ * before the tiles, the space after them and unaligned addresses.
+ */
+static void Test_NotHeld(void)
+{
+	static const u32 Addrs[] = {
+		0x0000U,
+		0x0100U,
+		XRFDC_DAC_TILE_CTRL_STATS_ADDR(0U) + XRFDC_RESTART_STATE_OFFSET,
+		XRFDC_DAC_TILE_CTRL_STATS_ADDR(2U) + 0x100U,
+		XRFDC_ADC_TILE_CTRL_STATS_ADDR(3U) + 0x1FFCU,
+		XRFDC_DAC_TILE_DRP_ADDR(1U) + XRFDC_BLOCK_ADDR_OFFSET(4U),
+		XRFDC_ADC_TILE_DRP_ADDR(1U) + XRFDC_HSCOM_ADDR - 4U,
+		XRFDC_ADC_TILE_CTRL_STATS_ADDR(4U) + XRFDC_TILE_DRP_OFFSET,
+		XRFDC_DAC_TILE_DRP_ADDR(0U) + XRFDC_MXR_MODE_OFFSET + 2U,
+	};
+	u32 Idx;
+
+	Test_Setup();
+	for (Idx = 0U; Idx < NUM(Addrs); Idx++) {
+		CHECK(Test_Where(Addrs[Idx]) == TEST_DEVICE);
+	}
+}
+
+/*
+ * XRFdc_ShadowInvalidate() drops the registers of one tile or of all tiles
+ * of a type, blocks and HSCOM alike. A tile restart drops the registers of
+ * the tile, a 32-bit write those it overlaps; a 32-bit read drops nothing.
+ * Pending writes are written out before the registers are dropped.
+ */
+static void Test_Invalidate(void)
+{
+	u32 Dac0 = XRFDC_BLOCK_BASE(XRFDC_DAC_TILE, 0U, 0U) + XRFDC_MXR_MODE_OFFSET;
+	u32 Dac1 = XRFDC_BLOCK_BASE(XRFDC_DAC_TILE, 1U, 0U) + XRFDC_MXR_MODE_OFFSET;
+	u32 Dac2 = XRFDC_DRP_BASE(XRFDC_DAC_TILE, 2U) + XRFDC_HSCOM_ADDR + XRFDC_HSCOM_CLK_DSTR_OFFSET;
+	u32 Adc0 = XRFDC_BLOCK_BASE(XRFDC_ADC_TILE, 0U, 0U) + XRFDC_MXR_MODE_OFFSET;
+	u32 Reads;
+
+	Test_Setup();
+	CHECK(Test_Where(Dac0) == TEST_HELD);
+	CHECK(Test_Where(Dac1) == TEST_HELD);
+	CHECK(Test_Where(Dac2) == TEST_HELD);
+	CHECK(Test_Where(Adc0) == TEST_HELD);
+
+	XRFdc_ShadowInvalidate(&RFdcInst, XRFDC_DAC_TILE, 0);
+	CHECK(Test_Read(Dac0, &Reads) == 0x5678U && Reads == 1U);
+	CHECK(Test_Read(Dac1, &Reads) == 0x1234U && Reads == 0U);
+	CHECK(Test_Read(Dac2, &Reads) == 0x1234U && Reads == 0U);
+	CHECK(Test_Read(Adc0, &Reads) == 0x1234U && Reads == 0U);
+
+	/* A read does not hold the register again, only a write does */
+	CHECK(Test_Read(Dac0, &Reads) == 0x5678U && Reads == 1U);
+
+	XRFdc_ShadowInvalidate(&RFdcInst, XRFDC_ADC_TILE, XRFDC_SELECT_ALL_TILES);
+	CHECK(Test_Read(Adc0, &Reads) == 0x5678U && Reads == 1U);
+	CHECK(Test_Read(Dac1, &Reads) == 0x1234U && Reads == 0U);
+
+	XRFdc_ShadowInvalidate(&RFdcInst, XRFDC_DAC_TILE, 2);
+	CHECK(Test_Read(Dac2, &Reads) == 0x5678U && Reads == 1U);
+	CHECK(Test_Read(Dac1, &Reads) == 0x1234U && Reads == 0U);
+
+	XRFdc_ShadowInvalidate(&RFdcInst, XRFDC_DAC_TILE, XRFDC_SELECT_ALL_TILES);
+	CHECK(Test_Read(Dac1, &Reads) == 0x5678U && Reads == 1U);
+
+	/* Restarting a tile drops its registers only */
+	CHECK(Test_Where(Dac1) == TEST_HELD);
+	CHECK(Test_Where(Dac2) == TEST_HELD);
+	CHECK(XRFdc_Shutdown(&RFdcInst, XRFDC_DAC_TILE, 1) == XRFDC_SUCCESS);
+	CHECK(Test_Read(Dac1, &Reads) == 0x5678U && Reads == 1U);
+	CHECK(Test_Read(Dac2, &Reads) == 0x1234U && Reads == 0U);
+
+	/* A 32-bit write drops the register, a 32-bit read does not */
+	CHECK(Test_Where(Dac0) == TEST_HELD);
+	XRFdc_WriteReg(&RFdcInst, 0U, Dac0, 0x9999U);
+	CHECK(Test_Read(Dac0, &Reads) == 0x9999U && Reads == 1U);
+	(void)XRFdc_ReadReg(&RFdcInst, 0U, Dac2);
+	CHECK(Test_Read(Dac2, &Reads) == 0x1234U && Reads == 0U);
+
+	/* Pending writes are written out first */
+	CHECK(XRFdc_ConfigSetStart(&RFdcInst) == XRFDC_SUCCESS);
+	RFdcMock_ResetCount();
+	XRFdc_WriteReg16(&RFdcInst, 0U, Dac2, 0x4321U);
+	CHECK(RFdcMock_Writes() == 0U && RFdcMock_Peek(Dac2) == 0x5678U);
+	XRFdc_ShadowInvalidate(&RFdcInst, XRFDC_DAC_TILE, 2);
+	CHECK(RFdcMockCount.Write16 == 1U && RFdcMock_Peek(Dac2) == 0x4321U);
+	CHECK(XRFdc_ConfigSetApply(&RFdcInst) == XRFDC_SUCCESS);
+	CHECK(RFdcMockCount.Write16 == 1U);
+
+	/* Disabled, every access goes to the device */
+	XRFdc_ShadowEnable(&RFdcInst, NULL);
+	CHECK(Test_Where(Dac1) == TEST_DEVICE);
+}
+
+/*****************************************************************************/
+/*
+ * Configuration set: the writes are held until a register that is not held
+ * is accessed or the set is applied, then written out once each in order of
+ * first write. A write of the value a register already holds is dropped.
+ * The update events are deferred and the tile is armed once for all its
+ * blocks with the tile event source.
+ */
+static void Test_ConfigSet(void)
+{
+	u32 Base0 = XRFDC_BLOCK_BASE(XRFDC_DAC_TILE, 0U, 0U);
+	u32 Base1 = XRFDC_BLOCK_BASE(XRFDC_DAC_TILE, 0U, 1U);
+	u32 Base2 = XRFDC_BLOCK_BASE(XRFDC_DAC_TILE, 0U, 2U);
+	u32 TileUpdate = XRFDC_DRP_BASE(XRFDC_DAC_TILE, 0U) + XRFDC_HSCOM_ADDR + XRFDC_HSCOM_UPDT_DYN_OFFSET;
+	u32 Idx, TileWrites, Reads;
+
+	RFdcMock_InitInstance(&RFdcInst);
+	CHECK(XRFdc_ConfigSetStart(&RFdcInst) == XRFDC_FAILURE);
+	XRFdc_ShadowEnable(&RFdcInst, &Shadow);
+	CHECK(XRFdc_ConfigSetApply(&RFdcInst) == XRFDC_FAILURE);
+	CHECK(XRFdc_ConfigSetStart(&RFdcInst) == XRFDC_SUCCESS);
+	CHECK(XRFdc_ConfigSetStart(&RFdcInst) == XRFDC_FAILURE);
+
+	RFdcMock_ResetCount();
+	XRFdc_WriteReg16(&RFdcInst, Base0, XRFDC_MXR_MODE_OFFSET, 1U);
+	XRFdc_WriteReg16(&RFdcInst, Base0, XRFDC_QMC_CFG_OFFSET, 2U);
+	XRFdc_WriteReg16(&RFdcInst, Base0, XRFDC_MXR_MODE_OFFSET, 3U);
+	CHECK(RFdcMock_Writes() == 0U);
+	CHECK(Test_Read(Base0 + XRFDC_MXR_MODE_OFFSET, &Reads) == 3U && Reads == 0U);
+	CHECK(Test_Read(Base0 + XRFDC_DAC_FABRIC_ISR_OFFSET, &Reads) == 0U && Reads == 1U);
+	CHECK(RFdcMockNumLog == 2U);
+	CHECK(RFdcMockLog[0].Addr == Base0 + XRFDC_MXR_MODE_OFFSET && RFdcMockLog[0].Value == 3U);
+	CHECK(RFdcMockLog[1].Addr == Base0 + XRFDC_QMC_CFG_OFFSET && RFdcMockLog[1].Value == 2U);
+
+	/* Held values are not written again */
+	RFdcMock_ResetCount();
+	XRFdc_WriteReg16(&RFdcInst, Base0, XRFDC_QMC_CFG_OFFSET, 2U);
+	XRFdc_WriteReg16(&RFdcInst, Base0, XRFDC_MXR_MODE_OFFSET, 3U);
+	XRFdc_ShadowFlush(&RFdcInst);
+	CHECK(RFdcMock_Writes() == 0U);
+
+	/* Blocks 0 and 1 take the tile event, block 2 its own */
+	XRFdc_WriteReg16(&RFdcInst, Base0, XRFDC_NCO_UPDT_OFFSET, XRFDC_EVNT_SRC_TILE);
+	XRFdc_WriteReg16(&RFdcInst, Base1, XRFDC_NCO_UPDT_OFFSET, XRFDC_EVNT_SRC_TILE);
+	XRFdc_WriteReg16(&RFdcInst, Base1, XRFDC_QMC_UPDT_OFFSET, XRFDC_EVNT_SRC_TILE);
+	XRFdc_WriteReg16(&RFdcInst, Base2, XRFDC_NCO_UPDT_OFFSET, XRFDC_EVNT_SRC_SLICE);
+	CHECK(XRFdc_UpdateEvent(&RFdcInst, XRFDC_DAC_TILE, 0U, 0U, XRFDC_EVENT_MIXER) == XRFDC_SUCCESS);
+	CHECK(XRFdc_UpdateEvent(&RFdcInst, XRFDC_DAC_TILE, 0U, 1U, XRFDC_EVENT_MIXER) == XRFDC_SUCCESS);
+	CHECK(XRFdc_UpdateEvent(&RFdcInst, XRFDC_DAC_TILE, 0U, 1U, XRFDC_EVENT_QMC) == XRFDC_SUCCESS);
+	CHECK(XRFdc_UpdateEvent(&RFdcInst, XRFDC_DAC_TILE, 0U, 2U, XRFDC_EVENT_MIXER) == XRFDC_SUCCESS);
+	CHECK(XRFdc_UpdateEvent(&RFdcInst, XRFDC_DAC_TILE, 0U, 2U, 0x8U) == XRFDC_FAILURE);
+	CHECK(RFdcMock_Writes() == 0U && RFdcMock_Reads() == 0U);
+
+	CHECK(XRFdc_ConfigSetApply(&RFdcInst) == XRFDC_SUCCESS);
+	CHECK(RFdcMock_Reads() == 0U);
+	CHECK(RFdcMockNumLog == 6U);
+	CHECK(RFdcMockLog[0].Addr == Base0 + XRFDC_NCO_UPDT_OFFSET);
+	CHECK(RFdcMockLog[3].Addr == Base2 + XRFDC_NCO_UPDT_OFFSET);
+	CHECK(RFdcMockLog[4].Addr == Base2 + XRFDC_DAC_UPDATE_DYN_OFFSET);
+	TileWrites = 0U;
+	for (Idx = 0U; Idx < RFdcMockNumLog; Idx++) {
+		if (RFdcMockLog[Idx].Addr == TileUpdate) {
+			TileWrites++;
+		}
+	}
+	CHECK(TileWrites == 1U && RFdcMockLog[5].Addr == TileUpdate);
+	CHECK(XRFdc_ConfigSetApply(&RFdcInst) == XRFDC_FAILURE);
+
+	/* Outside a configuration set the events are triggered at once */
+	RFdcMock_ResetCount();
+	CHECK(XRFdc_UpdateEvent(&RFdcInst, XRFDC_DAC_TILE, 0U, 0U, XRFDC_EVENT_MIXER) == XRFDC_SUCCESS);
+	CHECK(RFdcMockNumLog == 1U && RFdcMockLog[0].Addr == TileUpdate);
+}
+
+/*****************************************************************************/
+/*
+ * Mixer, QMC and coarse delay settings of the 16 DAC blocks followed by
+ * their update events, in rounds that change the frequency and the delay.
+ */
+static void Test_RunWorkload(u32 UseConfigSet)
+{
+	XRFdc_Mixer_Settings Mixer;
+	XRFdc_QMC_Settings Qmc;
+	XRFdc_CoarseDelay_Settings Delay;
+	u32 Round, Tile, Block;
+	u32 Status = XRFDC_SUCCESS;
+
+	for (Round = 0U; Round < TEST_ROUNDS; Round++) {
+		if (UseConfigSet != 0U) {
+			Status |= XRFdc_ConfigSetStart(&RFdcInst);
+		}
+		for (Tile = 0U; Tile < XRFDC_NUM_OF_TILES4; Tile++) {
+			for (Block = 0U; Block < XRFDC_NUM_OF_BLKS4; Block++) {
+				(void)memset(&Mixer, 0, sizeof(Mixer));
+				Mixer.Freq = 1000.0 + (100.0 * Block) + (50.0 * Round);
+				Mixer.MixerMode = XRFDC_MIXER_MODE_C2R;
+				Mixer.MixerType = XRFDC_MIXER_TYPE_FINE;
+				Mixer.CoarseMixFreq = XRFDC_COARSE_MIX_OFF;
+				Mixer.FineMixerScale = XRFDC_MIXER_SCALE_AUTO;
+				Mixer.EventSource = XRFDC_EVNT_SRC_TILE;
+				Status |= XRFdc_SetMixerSettings(&RFdcInst, XRFDC_DAC_TILE, Tile, Block, &Mixer);
+
+				Qmc.EnableGain = 1U;
+				Qmc.EnablePhase = 1U;
+				Qmc.GainCorrectionFactor = 0.9;
+				Qmc.PhaseCorrectionFactor = 1.5;
+				Qmc.OffsetCorrectionFactor = 3;
+				Qmc.EventSource = XRFDC_EVNT_SRC_TILE;
+				Status |= XRFdc_SetQMCSettings(&RFdcInst, XRFDC_DAC_TILE, Tile, Block, &Qmc);
+
+				Delay.CoarseDelay = Round + (Block % 3U);
+				Delay.EventSource = XRFDC_EVNT_SRC_TILE;
+				Status |= XRFdc_SetCoarseDelaySettings(&RFdcInst, XRFDC_DAC_TILE, Tile, Block, &Delay);
+
+				Status |= XRFdc_UpdateEvent(&RFdcInst, XRFDC_DAC_TILE, Tile, Block, XRFDC_EVENT_MIXER);
+				Status |= XRFdc_UpdateEvent(&RFdcInst, XRFDC_DAC_TILE, Tile, Block, XRFDC_EVENT_QMC);
+				Status |= XRFdc_UpdateEvent(&RFdcInst, XRFDC_DAC_TILE, Tile, Block,
+							    XRFDC_EVENT_CRSE_DLY);
+			}
+		}
+		if (UseConfigSet != 0U) {
+			Status |= XRFdc_ConfigSetApply(&RFdcInst);
+		}
+	}
+	CHECK(Status == XRFDC_SUCCESS);
+}
+
+/*
+ * The workload leaves the same registers in all three modes. The shadow
+ * registers serve the read half of every read-modify-write, the
+ * configuration set also drops the repeated writes and arms each tile once.
+ */
+static void Test_Workload(void)
+{
+	static const char *Names[] = { "direct", "shadow", "config set" };
+	u32 Reads[3], Writes[3];
+	u32 Mode;
+
+	for (Mode = 0U; Mode < 3U; Mode++) {
+		RFdcMock_InitInstance(&RFdcInst);
+		if (Mode != 0U) {
+			XRFdc_ShadowEnable(&RFdcInst, &Shadow);
+		}
+		RFdcMock_ResetCount();
+		Test_RunWorkload((Mode == 2U) ? 1U : 0U);
+		Reads[Mode] = RFdcMock_Reads();
+		Writes[Mode] = RFdcMock_Writes();
+		RFdcMock_Snapshot(Image[Mode]);
+		printf("  %-10s %5u reads %5u writes\n", Names[Mode], Reads[Mode], Writes[Mode]);
+	}
+
+	CHECK(memcmp(Image[0], Image[1], sizeof(Image[0])) == 0);
+	CHECK(memcmp(Image[0], Image[2], sizeof(Image[0])) == 0);
+	CHECK(Reads[1] < Reads[0] && Writes[1] == Writes[0]);
+	CHECK(Reads[2] <= Reads[1] && Writes[2] < Writes[1]);
+}
+
+int main(void)
+{
+	Test_BlockVolatile();
+	Test_HSCOMVolatile();
+	Test_NotHeld();
+	Test_Invalidate();
+	Test_ConfigSet();
+	Test_Workload();
+
+	if (Failures != 0U) {
+		printf("test_shadow: %u check(s) failed\n", Failures);
+		return 1;
+	}
+	printf("test_shadow: all checks passed\n");
+	return 0;
+}
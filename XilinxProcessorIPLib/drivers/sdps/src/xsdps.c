@@ -27,7 +27,7 @@
 /**
 *
 * @file xsdps.c
-* @addtogroup sdps_v3_8
+* @addtogroup sdps_v3_9
 * @{
 *
 * Contains the interface functions of the XSdPs driver.
@@ -96,6 +96,12 @@
 *       aru    03/12/19 Modified the code according to MISRAC-2012.
 * 3.8   mn     04/12/19 Modified TapDelay code for supporting ZynqMP and Versal
 *       mn     09/17/19 Modified ADMA handling API for 32bit and 64bit addresses
+* 3.9   ag     10/16/26 Added vectored read/write with a single ADMA2
+*                       descriptor chain spanning all buffer segments
+*       ag     10/16/26 Require 8 byte aligned segments for 64-bit ADMA2
+*                       descriptors
+*       ag     10/16/26 Return XST_DEVICE_BUSY from polled transfers while
+*                       queued requests are in progress
 * </pre>
 *
 ******************************************************************************/
@@ -143,6 +149,10 @@ void XSdPs_SetupADMA2DescTbl64Bit(XSdPs *InstancePtr, u32 BlkCnt);
 extern s32 XSdPs_Uhs_ModeInit(XSdPs *InstancePtr, u8 Mode);
 static s32 XSdPs_IdentifyCard(XSdPs *InstancePtr);
 static s32 XSdPs_Switch_Voltage(XSdPs *InstancePtr);
+static s32 XSdPs_CheckIoVec(const XSdPs_IoVec *IoVec, u32 IoVecCnt,
+		u32 MaxDesc, u8 Is32Bit, u32 *BlkCnt);
+static s32 XSdPs_VecXferPolled(XSdPs *InstancePtr, u32 Arg,
+		const XSdPs_IoVec *IoVec, u32 IoVecCnt, u8 IsWrite);
 
 u16 TransferMode;
 /*****************************************************************************/
@@ -203,6 +213,9 @@ s32 XSdPs_CfgInitialize(XSdPs *InstancePtr, XSdPs_Config *ConfigPtr,
 	InstancePtr->OTapDelay = 0U;
 	InstancePtr->ITapDelay = 0U;
 	InstancePtr->Dma64BitAddr = 0U;
+	InstancePtr->ReqHead = NULL;
+	InstancePtr->ReqTail = NULL;
+	InstancePtr->IntrMode = 0U;
 
 	/* Disable bus power and issue emmc hw reset */
 	if ((XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
@@ -1344,6 +1357,7 @@ u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd)
 *
 * @return
 * 		- XST_SUCCESS if initialization was successful
+* 		- XST_DEVICE_BUSY if queued requests are in progress
 * 		- XST_FAILURE if failure - could be because another transfer
 * 		is in progress or command or data inhibit is set
 *
@@ -1354,6 +1368,12 @@ s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 	u32 PresentStateReg;
 	u32 StatusReg;
 
+	/* The queued request API owns the descriptor table while busy */
+	if (InstancePtr->ReqHead != NULL) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
 	if ((InstancePtr->HC_Version != XSDPS_HC_SPEC_V3) ||
 				((InstancePtr->Host_Caps & XSDPS_CAPS_SLOT_TYPE_MASK)
 				!= XSDPS_CAPS_EMB_SLOT)) {
@@ -1453,6 +1473,7 @@ RETURN_PATH:
 *
 * @return
 * 		- XST_SUCCESS if initialization was successful
+* 		- XST_DEVICE_BUSY if queued requests are in progress
 * 		- XST_FAILURE if failure - could be because another transfer
 * 		is in progress or command or data inhibit is set
 *
@@ -1463,6 +1484,12 @@ s32 XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
 	u32 PresentStateReg;
 	u32 StatusReg;
 
+	/* The queued request API owns the descriptor table while busy */
+	if (InstancePtr->ReqHead != NULL) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
 	if ((InstancePtr->HC_Version != XSDPS_HC_SPEC_V3) ||
 				((InstancePtr->Host_Caps & XSDPS_CAPS_SLOT_TYPE_MASK)
 				!= XSDPS_CAPS_EMB_SLOT)) {
@@ -1819,6 +1846,407 @@ void XSdPs_SetupADMA2DescTbl(XSdPs *InstancePtr, u32 BlkCnt, const u8 *Buff)
 	}
 }
 
+/*****************************************************************************/
+/**
+*
+* Validates a segment list for a vectored transfer and returns the number of
+* blocks it covers.
+*
+* @param	IoVec is the segment list.
+* @param	IoVecCnt is the number of segments.
+* @param	MaxDesc is the number of descriptors available.
+* @param	Is32Bit is 1 if the descriptors hold 32-bit addresses.
+* @param	BlkCnt returns the number of 512 byte blocks.
+*
+* @return
+* 		- XST_SUCCESS if the list can be described by MaxDesc entries
+* 		- XST_INVALID_PARAM if a segment is empty or misaligned
+* 		(4 bytes for 32-bit, 8 bytes for 64-bit descriptors), a
+* 		32-bit descriptor cannot reach it, the total length is not a
+* 		whole number of blocks or too many descriptors are needed
+*
+******************************************************************************/
+static s32 XSdPs_CheckIoVec(const XSdPs_IoVec *IoVec, u32 IoVecCnt,
+		u32 MaxDesc, u8 Is32Bit, u32 *BlkCnt)
+{
+	u64 TotalLen = 0U;
+	u32 DescCnt = 0U;
+	u32 Index;
+	u32 Align;
+	s32 Status = XST_INVALID_PARAM;
+
+	Align = (Is32Bit != 0U) ? XSDPS_DESC_ADDR_ALIGN :
+			XSDPS_DESC_ADDR_ALIGN_64;
+
+	if ((IoVec == NULL) || (IoVecCnt == 0U)) {
+		goto RETURN_PATH;
+	}
+
+	for (Index = 0U; Index < IoVecCnt; Index++) {
+		if ((IoVec[Index].Length == 0U) ||
+			((IoVec[Index].Address % Align) != 0U) ||
+			((IoVec[Index].Length % Align) != 0U)) {
+			goto RETURN_PATH;
+		}
+		if ((Is32Bit != 0U) && (((u64)IoVec[Index].Address +
+				IoVec[Index].Length) > ADDRESS_BEYOND_32BIT)) {
+			goto RETURN_PATH;
+		}
+		DescCnt += (IoVec[Index].Length + XSDPS_DESC_MAX_LENGTH - 1U) /
+				XSDPS_DESC_MAX_LENGTH;
+		TotalLen += IoVec[Index].Length;
+	}
+
+	if ((DescCnt > MaxDesc) ||
+		((TotalLen % XSDPS_BLK_SIZE_512_MASK) != 0U) ||
+		((TotalLen / XSDPS_BLK_SIZE_512_MASK) > XSDPS_BLK_CNT_MASK)) {
+		goto RETURN_PATH;
+	}
+
+	*BlkCnt = (u32)(TotalLen / XSDPS_BLK_SIZE_512_MASK);
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Builds a 32-bit ADMA2 descriptor chain covering all segments of a vectored
+* transfer. Segments longer than XSDPS_DESC_MAX_LENGTH are split, and only
+* the last descriptor carries the END attribute.
+*
+* @param	DescTbl is the descriptor table to fill.
+* @param	MaxDesc is the number of entries in DescTbl.
+* @param	IoVec is the segment list.
+* @param	IoVecCnt is the number of segments.
+* @param	BlkCnt returns the number of 512 byte blocks transferred.
+*
+* @return	XST_SUCCESS or XST_INVALID_PARAM, see XSdPs_CheckIoVec().
+*
+* @note		The table is neither flushed nor programmed into the
+*		controller; this is left to the caller.
+*
+******************************************************************************/
+s32 XSdPs_BuildADMA2DescTbl32(XSdPs_Adma2Descriptor32 *DescTbl, u32 MaxDesc,
+			const XSdPs_IoVec *IoVec, u32 IoVecCnt, u32 *BlkCnt)
+{
+	u32 DescNum = 0U;
+	u32 Index;
+	u32 Offset;
+	u32 Len;
+	s32 Status;
+
+	Xil_AssertNonvoid(DescTbl != NULL);
+	Xil_AssertNonvoid(BlkCnt != NULL);
+
+	Status = XSdPs_CheckIoVec(IoVec, IoVecCnt, MaxDesc, 1U, BlkCnt);
+	if (Status != XST_SUCCESS) {
+		goto RETURN_PATH;
+	}
+
+	for (Index = 0U; Index < IoVecCnt; Index++) {
+		for (Offset = 0U; Offset < IoVec[Index].Length; Offset += Len) {
+			Len = IoVec[Index].Length - Offset;
+			if (Len > XSDPS_DESC_MAX_LENGTH) {
+				Len = XSDPS_DESC_MAX_LENGTH;
+			}
+			DescTbl[DescNum].Address =
+				(u32)(IoVec[Index].Address + Offset);
+			DescTbl[DescNum].Attribute =
+				XSDPS_DESC_TRAN | XSDPS_DESC_VALID;
+			/* A length field of 0 encodes 64 KB */
+			DescTbl[DescNum].Length = (u16)Len;
+			DescNum++;
+		}
+	}
+	DescTbl[DescNum - 1U].Attribute |= XSDPS_DESC_END;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Builds a 64-bit ADMA2 descriptor chain covering all segments of a vectored
+* transfer. See XSdPs_BuildADMA2DescTbl32().
+*
+* @param	DescTbl is the descriptor table to fill.
+* @param	MaxDesc is the number of entries in DescTbl.
+* @param	IoVec is the segment list.
+* @param	IoVecCnt is the number of segments.
+* @param	BlkCnt returns the number of 512 byte blocks transferred.
+*
+* @return	XST_SUCCESS or XST_INVALID_PARAM, see XSdPs_CheckIoVec().
+*
+******************************************************************************/
+s32 XSdPs_BuildADMA2DescTbl64(XSdPs_Adma2Descriptor64 *DescTbl, u32 MaxDesc,
+			const XSdPs_IoVec *IoVec, u32 IoVecCnt, u32 *BlkCnt)
+{
+	u32 DescNum = 0U;
+	u32 Index;
+	u32 Offset;
+	u32 Len;
+	s32 Status;
+
+	Xil_AssertNonvoid(DescTbl != NULL);
+	Xil_AssertNonvoid(BlkCnt != NULL);
+
+	Status = XSdPs_CheckIoVec(IoVec, IoVecCnt, MaxDesc, 0U, BlkCnt);
+	if (Status != XST_SUCCESS) {
+		goto RETURN_PATH;
+	}
+
+	for (Index = 0U; Index < IoVecCnt; Index++) {
+		for (Offset = 0U; Offset < IoVec[Index].Length; Offset += Len) {
+			Len = IoVec[Index].Length - Offset;
+			if (Len > XSDPS_DESC_MAX_LENGTH) {
+				Len = XSDPS_DESC_MAX_LENGTH;
+			}
+			DescTbl[DescNum].Address =
+				(u64)IoVec[Index].Address + Offset;
+			DescTbl[DescNum].Attribute =
+				XSDPS_DESC_TRAN | XSDPS_DESC_VALID;
+			/* A length field of 0 encodes 64 KB */
+			DescTbl[DescNum].Length = (u16)Len;
+			DescNum++;
+		}
+	}
+	DescTbl[DescNum - 1U].Attribute |= XSDPS_DESC_END;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This function performs a vectored SD read or write in polled mode. One
+* ADMA2 descriptor chain is built over all segments and the whole transfer
+* is issued as a single CMD17/CMD18 or CMD24/CMD25.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	IoVec is the segment list.
+* @param	IoVecCnt is the number of segments.
+* @param	IsWrite is 1 for a write and 0 for a read.
+*
+* @return
+* 		- XST_SUCCESS if the transfer was successful
+* 		- XST_INVALID_PARAM if the segment list is invalid
+* 		- XST_DEVICE_BUSY if queued requests are in progress
+* 		- XST_FAILURE if the card is not present or the transfer failed
+*
+******************************************************************************/
+static s32 XSdPs_VecXferPolled(XSdPs *InstancePtr, u32 Arg,
+		const XSdPs_IoVec *IoVec, u32 IoVecCnt, u8 IsWrite)
+{
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+	static XSdPs_Adma2Descriptor64 Adma2_DescrTbl64[XSDPS_DESC_MAX_NUM];
+#pragma data_alignment = 32
+	static XSdPs_Adma2Descriptor32 Adma2_DescrTbl32[XSDPS_DESC_MAX_NUM];
+#else
+	static XSdPs_Adma2Descriptor64 Adma2_DescrTbl64[XSDPS_DESC_MAX_NUM]
+						__attribute__ ((aligned(32)));
+	static XSdPs_Adma2Descriptor32 Adma2_DescrTbl32[XSDPS_DESC_MAX_NUM]
+						__attribute__ ((aligned(32)));
+#endif
+	s32 Status;
+	u32 PresentStateReg;
+	u32 StatusReg;
+	u32 BlkCnt = 0U;
+	u32 Index;
+	u32 Cmd;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	/* The queued request API owns the descriptor table while busy */
+	if (InstancePtr->ReqHead != NULL) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
+	if (InstancePtr->HC_Version == XSDPS_HC_SPEC_V3) {
+		Status = XSdPs_BuildADMA2DescTbl64(Adma2_DescrTbl64,
+				XSDPS_DESC_MAX_NUM, IoVec, IoVecCnt, &BlkCnt);
+	} else {
+		Status = XSdPs_BuildADMA2DescTbl32(Adma2_DescrTbl32,
+				XSDPS_DESC_MAX_NUM, IoVec, IoVecCnt, &BlkCnt);
+	}
+	if (Status != XST_SUCCESS) {
+		goto RETURN_PATH;
+	}
+
+	if ((InstancePtr->HC_Version != XSDPS_HC_SPEC_V3) ||
+				((InstancePtr->Host_Caps & XSDPS_CAPS_SLOT_TYPE_MASK)
+				!= XSDPS_CAPS_EMB_SLOT)) {
+		if(InstancePtr->Config.CardDetect != 0U) {
+			/* Check status to ensure card is initialized */
+			PresentStateReg = XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+					XSDPS_PRES_STATE_OFFSET);
+			if ((PresentStateReg & XSDPS_PSR_CARD_INSRT_MASK) == 0x0U) {
+				Status = XST_FAILURE;
+				goto RETURN_PATH;
+			}
+		}
+	}
+
+	/* Set block size to 512 if not already set */
+	if( XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+			XSDPS_BLK_SIZE_OFFSET) != XSDPS_BLK_SIZE_512_MASK ) {
+		Status = XSdPs_SetBlkSize(InstancePtr,
+			XSDPS_BLK_SIZE_512_MASK);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+	}
+
+	if (InstancePtr->HC_Version == XSDPS_HC_SPEC_V3) {
+#if defined(__aarch64__) || defined(__arch64__)
+		XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XSDPS_ADMA_SAR_EXT_OFFSET,
+				(u32)((UINTPTR)(Adma2_DescrTbl64)>>32U));
+#endif
+		XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XSDPS_ADMA_SAR_OFFSET,
+				(u32)(UINTPTR)&(Adma2_DescrTbl64[0]));
+		if (InstancePtr->Config.IsCacheCoherent == 0U) {
+			Xil_DCacheFlushRange((INTPTR)&(Adma2_DescrTbl64[0]),
+				sizeof(XSdPs_Adma2Descriptor64) * XSDPS_DESC_MAX_NUM);
+		}
+	} else {
+		XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XSDPS_ADMA_SAR_OFFSET,
+				(u32)(UINTPTR)&(Adma2_DescrTbl32[0]));
+		if (InstancePtr->Config.IsCacheCoherent == 0U) {
+			Xil_DCacheFlushRange((INTPTR)&(Adma2_DescrTbl32[0]),
+				sizeof(XSdPs_Adma2Descriptor32) * XSDPS_DESC_MAX_NUM);
+		}
+	}
+
+	if (InstancePtr->Config.IsCacheCoherent == 0U) {
+		for (Index = 0U; Index < IoVecCnt; Index++) {
+			if (IsWrite != 0U) {
+				Xil_DCacheFlushRange((INTPTR)IoVec[Index].Address,
+						IoVec[Index].Length);
+			} else {
+				Xil_DCacheInvalidateRange((INTPTR)IoVec[Index].Address,
+						IoVec[Index].Length);
+			}
+		}
+	}
+
+	if (BlkCnt == 1U) {
+		TransferMode = XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK;
+		Cmd = (IsWrite != 0U) ? CMD24 : CMD17;
+	} else {
+		TransferMode = XSDPS_TM_AUTO_CMD12_EN_MASK |
+			XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK |
+			XSDPS_TM_MUL_SIN_BLK_SEL_MASK;
+		Cmd = (IsWrite != 0U) ? CMD25 : CMD18;
+	}
+	if (IsWrite == 0U) {
+		TransferMode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+	}
+
+	Status = XSdPs_CmdTransfer(InstancePtr, Cmd, Arg, BlkCnt);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	/* Check for transfer complete */
+	do {
+		StatusReg = XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+					XSDPS_NORM_INTR_STS_OFFSET);
+		if ((StatusReg & XSDPS_INTR_ERR_MASK) != 0U) {
+			/* Write to clear error bits */
+			XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+					XSDPS_ERR_INTR_STS_OFFSET,
+					XSDPS_ERROR_INTR_ALL_MASK);
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+	} while((StatusReg & XSDPS_INTR_TC_MASK) == 0U);
+
+	/* Write to clear bit */
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_STS_OFFSET, XSDPS_INTR_TC_MASK);
+
+	if ((IsWrite == 0U) && (InstancePtr->Config.IsCacheCoherent == 0U)) {
+		for (Index = 0U; Index < IoVecCnt; Index++) {
+			Xil_DCacheInvalidateRange((INTPTR)IoVec[Index].Address,
+					IoVec[Index].Length);
+		}
+	}
+
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This function performs a vectored SD read in polled mode, scattering the
+* data read from consecutive card blocks into the given segments.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	IoVec is the segment list. The total length must be a
+* 		multiple of the 512 byte block size.
+* @param	IoVecCnt is the number of segments.
+*
+* @return
+* 		- XST_SUCCESS if the read was successful
+* 		- XST_INVALID_PARAM if the segment list is invalid
+* 		- XST_DEVICE_BUSY if queued requests are in progress
+* 		- XST_FAILURE if the card is not present or the read failed
+*
+* @note		At most XSDPS_DESC_MAX_NUM descriptors are available, and a
+*		segment uses one descriptor per started 64 KB.
+*
+******************************************************************************/
+s32 XSdPs_ReadVecPolled(XSdPs *InstancePtr, u32 Arg, const XSdPs_IoVec *IoVec,
+			u32 IoVecCnt)
+{
+	return XSdPs_VecXferPolled(InstancePtr, Arg, IoVec, IoVecCnt, 0U);
+}
+
+/*****************************************************************************/
+/**
+* This function performs a vectored SD write in polled mode, gathering the
+* data written to consecutive card blocks from the given segments.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	IoVec is the segment list. The total length must be a
+* 		multiple of the 512 byte block size.
+* @param	IoVecCnt is the number of segments.
+*
+* @return
+* 		- XST_SUCCESS if the write was successful
+* 		- XST_INVALID_PARAM if the segment list is invalid
+* 		- XST_DEVICE_BUSY if queued requests are in progress
+* 		- XST_FAILURE if the card is not present or the write failed
+*
+* @note		At most XSDPS_DESC_MAX_NUM descriptors are available, and a
+*		segment uses one descriptor per started 64 KB.
+*
+******************************************************************************/
+s32 XSdPs_WriteVecPolled(XSdPs *InstancePtr, u32 Arg, const XSdPs_IoVec *IoVec,
+			u32 IoVecCnt)
+{
+	return XSdPs_VecXferPolled(InstancePtr, Arg, IoVec, IoVecCnt, 1U);
+}
+
 /*****************************************************************************/
 /**
 * Mmc initialization is done in this function
@@ -27,7 +27,7 @@
 /**
 *
 * @file xsdps.h
-* @addtogroup sdps_v3_8
+* @addtogroup sdps_v3_9
 * @{
 * @details
 *
@@ -78,8 +78,13 @@
 * descriptor table and hence care will have to be taken to call read/write
 * API's in a loop for large file sizes.
 *
-* Interrupt mode is not supported because it offers no improvement when used
-* with file system.
+* Non-blocking transfers:
+* XSdPs_SubmitRequest() queues a read or write request and returns as soon
+* as its command has been issued. Completion is processed by
+* XSdPs_InterruptHandler(), either connected to the SD interrupt after
+* XSdPs_SetIntrMode() or polled from XSdPs_WaitRequest(). On completion
+* the next queued request is issued before the request's completion
+* handler is called, so that the card is kept busy while the CPU works.
 *
 * eMMC support:
 * SD driver supports SD and eMMC based on the "enable MMC" parameter in SDK.
@@ -88,7 +93,7 @@
 * using 4-bit and high speed mode currently.
 *
 * Features not supported include - card write protect, password setting,
-* lock/unlock, interrupts, SDMA mode, programmed I/O mode and
+* lock/unlock, card interrupts, SDMA mode, programmed I/O mode and
 * 64-bit addressed ADMA2, erase/pre-erase commands.
 *
 * <pre>
@@ -147,6 +152,13 @@
 * 3.7   mn     02/01/19 Add support for idling of SDIO
 * 3.8   mn     04/12/19 Modified TapDelay code for supporting ZynqMP and Versal
 *       mn     09/17/19 Modified ADMA handling API for 32bit and 64bit addresses
+* 3.9   ag     10/16/26 Added queued non-blocking read/write API with
+*                       completion callbacks (xsdps_intr.c)
+*       ag     10/16/26 Added vectored read/write which builds one ADMA2
+*                       descriptor chain over a list of buffer segments
+*       ag     10/16/26 Added 64-bit DMA address to queued requests. Polled
+*                       transfers return XST_DEVICE_BUSY while requests
+*                       are queued.
 *
 * </pre>
 *
@@ -216,6 +228,39 @@ typedef struct {
 }  __attribute__((__packed__))XSdPs_Adma2Descriptor64;
 #endif
 
+/**
+ * One buffer segment of a vectored transfer. Address and Length must be
+ * multiples of XSDPS_DESC_ADDR_ALIGN, or of XSDPS_DESC_ADDR_ALIGN_64 when
+ * the controller uses 64-bit descriptors (host controller version 3).
+ */
+typedef struct {
+	UINTPTR Address;	/**< Start address of the segment */
+	u32 Length;		/**< Length of the segment in bytes */
+} XSdPs_IoVec;
+
+/**
+ * Completion handler of a queued request. Status is XST_SUCCESS or
+ * XST_FAILURE. It is called from XSdPs_InterruptHandler().
+ */
+typedef void (*XSdPs_RequestHandler) (void *CallBackRef, s32 Status);
+
+/**
+ * Read or write request for XSdPs_SubmitRequest(). The structure is owned
+ * by the caller and linked into the driver queue until it completes.
+ */
+typedef struct XSdPs_RequestS {
+	u32 Arg;		/**< Card address argument, as for ReadPolled */
+	u32 BlkCnt;		/**< Number of 512 byte blocks */
+	u8 *Buff;		/**< Data buffer for the DMA transfer */
+	u64 Dma64BitAddr;	/**< DMA address beyond 32 bits, used instead
+				     of Buff when non zero */
+	u8 IsWrite;		/**< 1 for a write, 0 for a read */
+	XSdPs_RequestHandler Handler;	/**< Completion handler, may be NULL */
+	void *CallBackRef;	/**< Argument passed to the handler */
+	volatile s32 Status;	/**< XST_DEVICE_BUSY until completed */
+	struct XSdPs_RequestS *Next;	/**< Driver internal queue link */
+} XSdPs_Request;
+
 /**
  * The XSdPs driver instance data. The user is required to allocate a
  * variable of this type for every SD device in the system. A pointer
@@ -242,6 +287,9 @@ typedef struct {
 	u32	OTapDelay;		/**< Output Tap Delay */
 	u32	ITapDelay;		/**< Input Tap Delay */
 	u64 Dma64BitAddr;	/**< 64 Bit DMA Address */
+	XSdPs_Request *ReqHead;	/**< Request in progress */
+	XSdPs_Request *ReqTail;	/**< Last queued request */
+	u8 IntrMode;		/**< Completions signalled by interrupt */
 } XSdPs;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -253,6 +301,14 @@ s32 XSdPs_CfgInitialize(XSdPs *InstancePtr, XSdPs_Config *ConfigPtr,
 s32 XSdPs_SdCardInitialize(XSdPs *InstancePtr);
 s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff);
 s32 XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff);
+s32 XSdPs_ReadVecPolled(XSdPs *InstancePtr, u32 Arg, const XSdPs_IoVec *IoVec,
+			u32 IoVecCnt);
+s32 XSdPs_WriteVecPolled(XSdPs *InstancePtr, u32 Arg, const XSdPs_IoVec *IoVec,
+			u32 IoVecCnt);
+s32 XSdPs_BuildADMA2DescTbl32(XSdPs_Adma2Descriptor32 *DescTbl, u32 MaxDesc,
+			const XSdPs_IoVec *IoVec, u32 IoVecCnt, u32 *BlkCnt);
+s32 XSdPs_BuildADMA2DescTbl64(XSdPs_Adma2Descriptor64 *DescTbl, u32 MaxDesc,
+			const XSdPs_IoVec *IoVec, u32 IoVecCnt, u32 *BlkCnt);
 s32 XSdPs_SetBlkSize(XSdPs *InstancePtr, u16 BlkSize);
 s32 XSdPs_Select_Card (XSdPs *InstancePtr);
 s32 XSdPs_Change_ClkFreq(XSdPs *InstancePtr, u32 SelFreq);
@@ -267,6 +323,11 @@ s32 XSdPs_CardInitialize(XSdPs *InstancePtr);
 s32 XSdPs_Get_Mmc_ExtCsd(XSdPs *InstancePtr, u8 *ReadBuff);
 s32 XSdPs_Set_Mmc_ExtCsd(XSdPs *InstancePtr, u32 Arg);
 void XSdPs_Idle(XSdPs *InstancePtr);
+void XSdPs_SetIntrMode(XSdPs *InstancePtr, u8 Enable);
+s32 XSdPs_SubmitRequest(XSdPs *InstancePtr, XSdPs_Request *Req);
+s32 XSdPs_WaitRequest(XSdPs *InstancePtr, XSdPs_Request *Req);
+u32 XSdPs_IsBusy(XSdPs *InstancePtr);
+void XSdPs_InterruptHandler(void *InstancePtr);
 #if defined (ARMR5) || defined (__aarch64__) || defined (ARMA53_32) || defined (__MICROBLAZE__)
 void XSdPs_Identify_UhsMode(XSdPs *InstancePtr, u8 *ReadBuff);
 void XSdPs_ddr50_tapdelay(u32 Bank, u32 DeviceId, u32 CardType);
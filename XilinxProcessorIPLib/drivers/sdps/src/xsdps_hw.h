@@ -27,7 +27,7 @@
 /**
 *
 * @file xsdps_hw.h
-* @addtogroup sdps_v3_8
+* @addtogroup sdps_v3_9
 * @{
 *
 * This header file contains the identifiers and basic HW access driver
@@ -935,6 +935,12 @@ extern "C" {
  */
 
 #define XSDPS_DESC_MAX_LENGTH 65536U
+#define XSDPS_DESC_MAX_NUM	32U	/**< Entries of the vectored table */
+#define XSDPS_DESC_ADDR_ALIGN	4U	/**< Segment address/length alignment,
+						     32-bit descriptors */
+#define XSDPS_DESC_ADDR_ALIGN_64	8U	/**< Segment address/length
+						     alignment, 64-bit
+						     descriptors */
 
 #define XSDPS_DESC_VALID     	(0x1U << 0)
 #define XSDPS_DESC_END       	(0x1U << 1)
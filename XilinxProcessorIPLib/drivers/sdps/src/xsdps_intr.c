@@ -0,0 +1,562 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsdps_intr.c
+* @addtogroup sdps_v3_9
+* @{
+*
+* This file contains the queued, non-blocking read/write API of the XSdPs
+* driver.
+*
+* Requests are submitted with XSdPs_SubmitRequest() and kept in a FIFO queue
+* owned by the caller (the request structures are linked in place, no memory
+* is allocated by the driver). The request at the head of the queue is the
+* one in progress on the card. When its transfer completes,
+* XSdPs_InterruptHandler() removes it from the queue, issues the command of
+* the next queued request so that the card keeps streaming, and then calls
+* the completion handler of the finished request.
+*
+* Commands are issued without waiting for their response. A command error
+* is signalled through the error interrupt like a data error, so neither
+* XSdPs_SubmitRequest() nor XSdPs_InterruptHandler() polls the controller.
+*
+* XSdPs_InterruptHandler() is either connected to the SD interrupt by the
+* application (after XSdPs_SetIntrMode(InstancePtr, 1U)) or, in the default
+* polled completion mode, called by XSdPs_WaitRequest() while it waits.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---    -------- -----------------------------------------------
+* 3.9   ag     10/16/26 First release
+*       ag     10/16/26 Reset the CMD and DAT lines after a failed request.
+*       ag     10/16/26 Honour 64-bit DMA addresses.
+*       ag     10/16/26 Issue request commands without polling for the
+*                       response, so that the handler does not spin.
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsdps.h"
+
+/************************** Constant Definitions *****************************/
+
+#define ADDRESS_BEYOND_32BIT	0x100000000U
+
+/* Normal and error interrupts signalled while a request is in progress */
+#define XSDPS_REQ_NORM_INTR_MASK	(XSDPS_INTR_TC_MASK | XSDPS_INTR_ERR_MASK)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd);
+void XSdPs_SetupADMA2DescTbl(XSdPs *InstancePtr, u32 BlkCnt, const u8 *Buff);
+void XSdPs_SetupADMA2DescTbl64Bit(XSdPs *InstancePtr, u32 BlkCnt);
+static s32 XSdPs_StartRequest(XSdPs *InstancePtr, XSdPs_Request *Req);
+static s32 XSdPs_IssueRequestCmd(XSdPs *InstancePtr, u32 Cmd, u32 Arg,
+		u32 BlkCnt);
+static u16 XSdPs_MaskRequestIntr(const XSdPs *InstancePtr);
+static void XSdPs_RestoreRequestIntr(const XSdPs *InstancePtr, u16 Mask);
+static void XSdPs_ResetCmdDatLines(const XSdPs *InstancePtr);
+
+/************************** Variable Definitions *****************************/
+extern u16 TransferMode;
+
+/*****************************************************************************/
+/**
+*
+* Selects how request completion is detected.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	Enable is 1 if the application has connected
+*		XSdPs_InterruptHandler() to the SD interrupt, 0 if completions
+*		are to be polled by XSdPs_WaitRequest().
+*
+* @return	None.
+*
+* @note		Must be called while no request is queued.
+*
+******************************************************************************/
+void XSdPs_SetIntrMode(XSdPs *InstancePtr, u8 Enable)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid(InstancePtr->ReqHead == NULL);
+
+	InstancePtr->IntrMode = Enable;
+	if (Enable == 0U) {
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Queues a read or write request. If no request is in progress the command
+* is issued immediately, otherwise it is issued when the preceding requests
+* have completed. The function returns without waiting for the transfer.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	Req is the request to queue. Arg, BlkCnt, Buff or
+*		Dma64BitAddr, IsWrite, Handler and CallBackRef must be filled
+*		in by the caller. The request and its buffer must remain valid
+*		until the request has completed.
+*
+* @return
+* 		- XST_SUCCESS if the request was queued
+* 		- XST_FAILURE if the card is not present, the block size could
+* 		not be set or the CMD or DAT lines are inhibited
+*
+* @note		Req->Status is XST_DEVICE_BUSY while the request is queued
+*		and holds the final status once it has completed. The block
+*		count is limited by the ADMA2 descriptor table in the same way
+*		as for XSdPs_ReadPolled() and XSdPs_WritePolled(). A 64-bit
+*		address set in InstancePtr->Dma64BitAddr, as for the polled
+*		transfers, is taken over by the request if Req->Dma64BitAddr
+*		is 0. No cache maintenance is done for 64-bit addresses.
+*		An error response to the command of the request is reported
+*		in Req->Status.
+*
+******************************************************************************/
+s32 XSdPs_SubmitRequest(XSdPs *InstancePtr, XSdPs_Request *Req)
+{
+	s32 Status;
+	u32 PresentStateReg;
+	u16 SigMask;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Req != NULL);
+	Xil_AssertNonvoid(Req->BlkCnt != 0U);
+
+	if (Req->Dma64BitAddr == 0U) {
+		Req->Dma64BitAddr = InstancePtr->Dma64BitAddr;
+	}
+	InstancePtr->Dma64BitAddr = 0U;
+	Xil_AssertNonvoid((Req->Buff != NULL) ||
+			(Req->Dma64BitAddr >= ADDRESS_BEYOND_32BIT));
+
+	if ((InstancePtr->HC_Version != XSDPS_HC_SPEC_V3) ||
+				((InstancePtr->Host_Caps & XSDPS_CAPS_SLOT_TYPE_MASK)
+				!= XSDPS_CAPS_EMB_SLOT)) {
+		if(InstancePtr->Config.CardDetect != 0U) {
+			/* Check status to ensure card is initialized */
+			PresentStateReg = XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+					XSDPS_PRES_STATE_OFFSET);
+			if ((PresentStateReg & XSDPS_PSR_CARD_INSRT_MASK) == 0x0U) {
+				Req->Status = XST_FAILURE;
+				Status = XST_FAILURE;
+				goto RETURN_PATH;
+			}
+		}
+	}
+
+	Req->Status = XST_DEVICE_BUSY;
+	Req->Next = NULL;
+
+	SigMask = XSdPs_MaskRequestIntr(InstancePtr);
+
+	if (InstancePtr->ReqHead != NULL) {
+		/* Issued by the completion of the preceding request */
+		InstancePtr->ReqTail->Next = Req;
+		InstancePtr->ReqTail = Req;
+		XSdPs_RestoreRequestIntr(InstancePtr, SigMask);
+		Status = XST_SUCCESS;
+		goto RETURN_PATH;
+	}
+
+	/* Queue is idle; set block size to 512 if not already set */
+	if (XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+			XSDPS_BLK_SIZE_OFFSET) != XSDPS_BLK_SIZE_512_MASK) {
+		Status = XSdPs_SetBlkSize(InstancePtr, XSDPS_BLK_SIZE_512_MASK);
+		if (Status != XST_SUCCESS) {
+			Req->Status = XST_FAILURE;
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+	}
+
+	InstancePtr->ReqHead = Req;
+	InstancePtr->ReqTail = Req;
+	Status = XSdPs_StartRequest(InstancePtr, Req);
+	if (Status != XST_SUCCESS) {
+		InstancePtr->ReqHead = NULL;
+		InstancePtr->ReqTail = NULL;
+		Req->Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	if (InstancePtr->IntrMode != 0U) {
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_SIG_EN_OFFSET,
+				XSDPS_ERROR_INTR_ALL_MASK);
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET,
+				XSDPS_REQ_NORM_INTR_MASK);
+	}
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Waits until a queued request has completed. In polled completion mode the
+* completion processing of XSdPs_InterruptHandler() is run from here, which
+* also issues the following queued requests.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	Req is the request to wait for.
+*
+* @return	Final status of the request, XST_SUCCESS or XST_FAILURE.
+*
+* @note		In interrupt mode this function must not be called from a
+*		context that blocks the SD interrupt.
+*
+******************************************************************************/
+s32 XSdPs_WaitRequest(XSdPs *InstancePtr, XSdPs_Request *Req)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Req != NULL);
+
+	while (Req->Status == XST_DEVICE_BUSY) {
+		if (InstancePtr->IntrMode == 0U) {
+			XSdPs_InterruptHandler(InstancePtr);
+		}
+	}
+
+	return Req->Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns whether any request is queued or in progress.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	TRUE if requests are pending, FALSE otherwise.
+*
+******************************************************************************/
+u32 XSdPs_IsBusy(XSdPs *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return (InstancePtr->ReqHead != NULL) ? (u32)TRUE : (u32)FALSE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Interrupt handler of the queued request API. Completes the request in
+* progress, issues the next queued request and calls the completion handler
+* of the finished request.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance, passed as a
+*		void pointer so that it can be connected to the interrupt
+*		controller directly.
+*
+* @return	None.
+*
+* @note		Returns without side effects if no transfer has completed.
+*		The handler does not wait on the controller: the command of
+*		the next request is written and its response is left to the
+*		next interrupt.
+*
+******************************************************************************/
+void XSdPs_InterruptHandler(void *InstancePtr)
+{
+	XSdPs *SdPtr = (XSdPs *)InstancePtr;
+	XSdPs_Request *Done;
+	XSdPs_Request *Next;
+	u16 StatusReg;
+	s32 Status;
+
+	Xil_AssertVoid(SdPtr != NULL);
+
+	Done = SdPtr->ReqHead;
+	if (Done == NULL) {
+		return;
+	}
+
+	StatusReg = XSdPs_ReadReg16(SdPtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET);
+	if ((StatusReg & XSDPS_INTR_ERR_MASK) != 0U) {
+		/* Recover the CMD and DAT lines before the next request */
+		XSdPs_ResetCmdDatLines(SdPtr);
+		/* Write to clear error bits */
+		XSdPs_WriteReg16(SdPtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_STS_OFFSET,
+				XSDPS_ERROR_INTR_ALL_MASK);
+		XSdPs_WriteReg16(SdPtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET,
+				XSDPS_INTR_CC_MASK | XSDPS_INTR_TC_MASK);
+		Status = XST_FAILURE;
+	} else if ((StatusReg & XSDPS_INTR_TC_MASK) != 0U) {
+		/* Write to clear bits, command complete was not waited for */
+		XSdPs_WriteReg16(SdPtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET,
+				XSDPS_INTR_CC_MASK | XSDPS_INTR_TC_MASK);
+		Status = XST_SUCCESS;
+	} else {
+		return;
+	}
+
+	if ((Done->IsWrite == 0U) && (SdPtr->Config.IsCacheCoherent == 0U) &&
+			(Done->Dma64BitAddr < ADDRESS_BEYOND_32BIT)) {
+		Xil_DCacheInvalidateRange((INTPTR)Done->Buff,
+				Done->BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+	}
+
+	/* Keep the card busy: issue the next request before any callback */
+	Next = Done->Next;
+	while (Next != NULL) {
+		SdPtr->ReqHead = Next;
+		if (XSdPs_StartRequest(SdPtr, Next) == XST_SUCCESS) {
+			break;
+		}
+		SdPtr->ReqHead = Next->Next;
+		Next->Status = XST_FAILURE;
+		if (Next->Handler != NULL) {
+			Next->Handler(Next->CallBackRef, XST_FAILURE);
+		}
+		Next = SdPtr->ReqHead;
+	}
+	if (Next == NULL) {
+		SdPtr->ReqHead = NULL;
+		SdPtr->ReqTail = NULL;
+		if (SdPtr->IntrMode != 0U) {
+			XSdPs_WriteReg16(SdPtr->Config.BaseAddress,
+					XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+			XSdPs_WriteReg16(SdPtr->Config.BaseAddress,
+					XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+		}
+	}
+
+	Done->Next = NULL;
+	Done->Status = Status;
+	if (Done->Handler != NULL) {
+		Done->Handler(Done->CallBackRef, Status);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets up the ADMA2 descriptors and cache for a request and issues its
+* single or multiple block command.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	Req is the request to start.
+*
+* @return	XST_SUCCESS if the command was issued, XST_FAILURE otherwise.
+*
+******************************************************************************/
+static s32 XSdPs_StartRequest(XSdPs *InstancePtr, XSdPs_Request *Req)
+{
+	s32 Status;
+	u32 Cmd;
+
+	if (Req->Dma64BitAddr >= ADDRESS_BEYOND_32BIT) {
+		/* Consumed and cleared by the 64-bit table setup */
+		InstancePtr->Dma64BitAddr = Req->Dma64BitAddr;
+		XSdPs_SetupADMA2DescTbl64Bit(InstancePtr, Req->BlkCnt);
+	} else {
+		XSdPs_SetupADMA2DescTbl(InstancePtr, Req->BlkCnt, Req->Buff);
+		if (InstancePtr->Config.IsCacheCoherent == 0U) {
+			if (Req->IsWrite != 0U) {
+				Xil_DCacheFlushRange((INTPTR)Req->Buff,
+					Req->BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+			} else {
+				Xil_DCacheInvalidateRange((INTPTR)Req->Buff,
+					Req->BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+			}
+		}
+	}
+
+	if (Req->BlkCnt == 1U) {
+		TransferMode = XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK;
+		Cmd = (Req->IsWrite != 0U) ? CMD24 : CMD17;
+	} else {
+		TransferMode = XSDPS_TM_AUTO_CMD12_EN_MASK |
+			XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK |
+			XSDPS_TM_MUL_SIN_BLK_SEL_MASK;
+		Cmd = (Req->IsWrite != 0U) ? CMD25 : CMD18;
+	}
+	if (Req->IsWrite == 0U) {
+		TransferMode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+	}
+
+	Status = XSdPs_IssueRequestCmd(InstancePtr, Cmd, Req->Arg, Req->BlkCnt);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes the command of a request to the controller. Unlike
+* XSdPs_CmdTransfer() the command response is not polled for; command
+* complete is cleared with transfer complete and a command error ends the
+* request through the error interrupt.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	Cmd is the command index.
+* @param	Arg is the command argument.
+* @param	BlkCnt is the number of blocks of the transfer.
+*
+* @return	XST_SUCCESS if the command was written, XST_FAILURE if the
+*		CMD or DAT lines are inhibited.
+*
+******************************************************************************/
+static s32 XSdPs_IssueRequestCmd(XSdPs *InstancePtr, u32 Cmd, u32 Arg,
+		u32 BlkCnt)
+{
+	u32 PresentStateReg;
+	u32 CommandReg;
+	s32 Status;
+
+	PresentStateReg = XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+			XSDPS_PRES_STATE_OFFSET);
+	if ((PresentStateReg & (XSDPS_PSR_INHIBIT_CMD_MASK |
+			XSDPS_PSR_INHIBIT_DAT_MASK)) != 0U) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_BLK_CNT_OFFSET, (u16)BlkCnt);
+	XSdPs_WriteReg8(InstancePtr->Config.BaseAddress,
+			XSDPS_TIMEOUT_CTRL_OFFSET, 0xEU);
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XSDPS_ARGMT_OFFSET, Arg);
+
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_STS_OFFSET, XSDPS_NORM_INTR_ALL_MASK);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_STS_OFFSET, XSDPS_ERROR_INTR_ALL_MASK);
+
+	/* Mask to avoid writing to reserved bits 31-30 */
+	CommandReg = XSdPs_FrameCmd(InstancePtr, Cmd) & 0x3FFFU;
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_XFER_MODE_OFFSET,
+			(CommandReg << 16) | TransferMode);
+
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Masks the request interrupt signals so that the queue can be updated
+* without racing with XSdPs_InterruptHandler().
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	Previous normal interrupt signal enable value. The error
+*		signals are restored along with it.
+*
+******************************************************************************/
+static u16 XSdPs_MaskRequestIntr(const XSdPs *InstancePtr)
+{
+	u16 Mask = 0U;
+
+	if (InstancePtr->IntrMode != 0U) {
+		Mask = XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET);
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+	}
+
+	return Mask;
+}
+
+/*****************************************************************************/
+/**
+*
+* Restores the request interrupt signals masked by XSdPs_MaskRequestIntr().
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	Mask is the value returned by XSdPs_MaskRequestIntr().
+*
+* @return	None.
+*
+******************************************************************************/
+static void XSdPs_RestoreRequestIntr(const XSdPs *InstancePtr, u16 Mask)
+{
+	if ((InstancePtr->IntrMode != 0U) && (Mask != 0U)) {
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_SIG_EN_OFFSET,
+				XSDPS_ERROR_INTR_ALL_MASK);
+		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET, Mask);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Resets the CMD and DAT line state machines after a failed transfer, so
+* that the command of the next queued request can be issued.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XSdPs_ResetCmdDatLines(const XSdPs *InstancePtr)
+{
+	u32 Timeout = MAX_TIMEOUT;
+	u8 RegVal;
+
+	XSdPs_WriteReg8(InstancePtr->Config.BaseAddress, XSDPS_SW_RST_OFFSET,
+			XSDPS_SWRST_CMD_LINE_MASK | XSDPS_SWRST_DAT_LINE_MASK);
+
+	RegVal = XSdPs_ReadReg8(InstancePtr->Config.BaseAddress,
+			XSDPS_SW_RST_OFFSET);
+	while (((RegVal & (XSDPS_SWRST_CMD_LINE_MASK |
+			XSDPS_SWRST_DAT_LINE_MASK)) != 0U) && (Timeout != 0U)) {
+		RegVal = XSdPs_ReadReg8(InstancePtr->Config.BaseAddress,
+				XSDPS_SW_RST_OFFSET);
+		Timeout = Timeout - 1U;
+	}
+}
+/** @} */
@@ -27,7 +27,7 @@
 /**
 *
 * @file xsdps_options.c
-* @addtogroup sdps_v3_8
+* @addtogroup sdps_v3_9
 * @{
 *
 * Contains API's for changing the various options in host and card.
@@ -76,6 +76,8 @@
 *       mn     05/21/19 Set correct tap delays for Versal
 *       mn     05/21/19 Disable DLL Reset code for Versal
 *       mn     08/29/19 Add call to Cache Invalidation API in XSdPs_Get_BusWidth
+* 3.9   ag     10/16/26 Return XST_DEVICE_BUSY from the register reads with
+*                       a data phase while queued requests are in progress
 *
 * </pre>
 *
@@ -168,6 +170,7 @@ s32 XSdPs_SetBlkSize(XSdPs *InstancePtr, u16 BlkSize)
 *
 * @return
 *		- XST_SUCCESS if successful.
+*		- XST_DEVICE_BUSY if queued requests are in progress.
 *		- XST_FAILURE if fail.
 *
 * @note		None.
@@ -184,6 +187,12 @@ s32 XSdPs_Get_BusWidth(XSdPs *InstancePtr, u8 *ReadBuff)
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	/* The queued request API owns the descriptor table while busy */
+	if (InstancePtr->ReqHead != NULL) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
 	for (LoopCnt = 0; LoopCnt < 8; LoopCnt++) {
 		ReadBuff[LoopCnt] = 0U;
 	}
@@ -397,6 +406,7 @@ s32 XSdPs_Change_BusWidth(XSdPs *InstancePtr)
 *
 * @return
 *		- XST_SUCCESS if successful.
+*		- XST_DEVICE_BUSY if queued requests are in progress.
 *		- XST_FAILURE if fail.
 *
 * @note		None.
@@ -414,6 +424,12 @@ s32 XSdPs_Get_BusSpeed(XSdPs *InstancePtr, u8 *ReadBuff)
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	/* The queued request API owns the descriptor table while busy */
+	if (InstancePtr->ReqHead != NULL) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
 	for (LoopCnt = 0; LoopCnt < 64; LoopCnt++) {
 		ReadBuff[LoopCnt] = 0U;
 	}
@@ -483,6 +499,7 @@ s32 XSdPs_Get_BusSpeed(XSdPs *InstancePtr, u8 *ReadBuff)
 *
 * @return
 *		- XST_SUCCESS if successful.
+*		- XST_DEVICE_BUSY if queued requests are in progress.
 *		- XST_FAILURE if fail.
 *
 * @note		None.
@@ -498,6 +515,12 @@ s32 XSdPs_Get_Status(XSdPs *InstancePtr, u8 *SdStatReg)
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	/* The queued request API owns the descriptor table while busy */
+	if (InstancePtr->ReqHead != NULL) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
 	/* Send block write command */
 	Status = XSdPs_CmdTransfer(InstancePtr, CMD55,
 			InstancePtr->RelCardAddr, 0U);
@@ -927,6 +950,7 @@ s32 XSdPs_Pullup(XSdPs *InstancePtr)
 *
 * @return
 *		- XST_SUCCESS if successful.
+*		- XST_DEVICE_BUSY if queued requests are in progress.
 *		- XST_FAILURE if fail.
 *
 * @note		None.
@@ -944,6 +968,12 @@ s32 XSdPs_Get_Mmc_ExtCsd(XSdPs *InstancePtr, u8 *ReadBuff)
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	/* The queued request API owns the descriptor table while busy */
+	if (InstancePtr->ReqHead != NULL) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
 	for (LoopCnt = 0; LoopCnt < 512; LoopCnt++) {
 		ReadBuff[LoopCnt] = 0U;
 	}
@@ -0,0 +1,316 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file sdhci_mock.c
+*
+* Register model of an SDHCI host controller, see sdhci_mock.h.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "xil_io.h"
+#include "xsdps_hw.h"
+#include "sdhci_mock.h"
+
+/************************** Variable Definitions *****************************/
+
+SdMock SdMockState;
+
+u32 Xil_AssertStatus;
+s32 Xil_AssertWait;
+
+/*****************************************************************************/
+/**
+* Assertion handler of the host build: an assertion is a test failure.
+******************************************************************************/
+void Xil_Assert(const char8 *File, s32 Line)
+{
+	printf("assertion failed at %s:%d\n", File, (int)Line);
+	exit(1);
+}
+
+/*****************************************************************************/
+/**
+* Delay of the host build, only accounted.
+******************************************************************************/
+int usleep(unsigned long useconds)
+{
+	SdMockState.DelayUs += useconds;
+	return 0;
+}
+
+static u32 SdMock_Get(u32 Offset, u32 Size)
+{
+	u32 Value = 0U;
+	u32 Index;
+
+	for (Index = 0U; Index < Size; Index++) {
+		Value |= (u32)SdMockState.Regs[Offset + Index] << (Index * 8U);
+	}
+
+	return Value;
+}
+
+static void SdMock_Put(u32 Offset, u32 Size, u32 Value)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Size; Index++) {
+		SdMockState.Regs[Offset + Index] = (u8)(Value >> (Index * 8U));
+	}
+}
+
+static void SdMock_SetPresState(u32 Set, u32 Clear)
+{
+	u32 Value = SdMock_Get(XSDPS_PRES_STATE_OFFSET, 4U);
+
+	SdMock_Put(XSDPS_PRES_STATE_OFFSET, 4U, (Value & ~Clear) | Set);
+}
+
+/*****************************************************************************/
+/**
+* Resets the model to an idle controller with a card inserted.
+******************************************************************************/
+void SdMock_Reset(void)
+{
+	(void)memset(&SdMockState, 0, sizeof(SdMockState));
+	SdMock_SetPresState(XSDPS_PSR_CARD_INSRT_MASK, 0U);
+}
+
+/*****************************************************************************/
+/**
+* Sets or clears the card inserted bit of the present state register.
+******************************************************************************/
+void SdMock_SetCardInserted(u32 Inserted)
+{
+	if (Inserted != 0U) {
+		SdMock_SetPresState(XSDPS_PSR_CARD_INSRT_MASK, 0U);
+	} else {
+		SdMock_SetPresState(0U, XSDPS_PSR_CARD_INSRT_MASK);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Ends the data transfer in progress. A successful transfer raises transfer
+* complete and releases the DAT lines, a failed one raises a data timeout
+* error and leaves DAT inhibit set until the DAT line is reset.
+******************************************************************************/
+void SdMock_CompleteData(u32 Ok)
+{
+	u32 Sts;
+
+	if (SdMockState.DataPending == 0U) {
+		return;
+	}
+	SdMockState.DataPending = 0U;
+
+	if (Ok != 0U) {
+		Sts = SdMock_Get(XSDPS_NORM_INTR_STS_OFFSET, 2U);
+		SdMock_Put(XSDPS_NORM_INTR_STS_OFFSET, 2U,
+				Sts | XSDPS_INTR_TC_MASK);
+		SdMock_Put(XSDPS_BLK_CNT_OFFSET, 2U, 0U);
+		SdMock_SetPresState(0U, XSDPS_PSR_INHIBIT_DAT_MASK);
+	} else {
+		Sts = SdMock_Get(XSDPS_ERR_INTR_STS_OFFSET, 2U);
+		SdMock_Put(XSDPS_ERR_INTR_STS_OFFSET, 2U,
+				Sts | XSDPS_INTR_ERR_DT_MASK);
+	}
+}
+
+static void SdMock_IssueCmd(u32 Value)
+{
+	u32 CmdReg = Value >> 16U;
+	u32 Inhibit = SdMock_Get(XSDPS_PRES_STATE_OFFSET, 4U);
+	SdMock_Cmd *Cmd;
+	u32 Sts;
+
+	if (((Inhibit & XSDPS_PSR_INHIBIT_CMD_MASK) != 0U) ||
+			(((CmdReg & XSDPS_DAT_PRESENT_SEL_MASK) != 0U) &&
+			((Inhibit & XSDPS_PSR_INHIBIT_DAT_MASK) != 0U))) {
+		SdMockState.InhibitedCmds++;
+		return;
+	}
+
+	if (SdMockState.CmdCount < SDMOCK_MAX_CMDS) {
+		Cmd = &SdMockState.Cmd[SdMockState.CmdCount];
+		Cmd->Index = (CmdReg >> 8U) & 0x3FU;
+		Cmd->Arg = SdMock_Get(XSDPS_ARGMT_OFFSET, 4U);
+		Cmd->BlkCnt = (u16)SdMock_Get(XSDPS_BLK_CNT_OFFSET, 2U);
+		Cmd->XferMode = (u16)Value;
+	}
+	SdMockState.CmdCount++;
+
+	if (SdMockState.CmdLatency != 0U) {
+		SdMockState.CmdWait = SdMockState.CmdLatency;
+	} else {
+		Sts = SdMock_Get(XSDPS_NORM_INTR_STS_OFFSET, 2U);
+		SdMock_Put(XSDPS_NORM_INTR_STS_OFFSET, 2U,
+				Sts | XSDPS_INTR_CC_MASK);
+	}
+	if ((CmdReg & XSDPS_DAT_PRESENT_SEL_MASK) != 0U) {
+		SdMockState.DataPending = 1U;
+		SdMock_SetPresState(XSDPS_PSR_INHIBIT_DAT_MASK, 0U);
+	}
+}
+
+static void SdMock_SoftReset(u8 Value)
+{
+	SdMockState.SwRstCount++;
+	SdMockState.SwRstBits |= Value;
+
+	if ((Value & XSDPS_SWRST_CMD_LINE_MASK) != 0U) {
+		SdMock_SetPresState(0U, XSDPS_PSR_INHIBIT_CMD_MASK);
+	}
+	if ((Value & XSDPS_SWRST_DAT_LINE_MASK) != 0U) {
+		SdMockState.DataPending = 0U;
+		SdMock_SetPresState(0U, XSDPS_PSR_INHIBIT_DAT_MASK);
+	}
+}
+
+static u32 SdMock_Read(UINTPTR Addr, u32 Size)
+{
+	u32 Offset = (u32)(Addr - SDMOCK_BASEADDR);
+	u32 Value;
+	u32 Sts;
+
+	if (Offset + Size > sizeof(SdMockState.Regs)) {
+		printf("read outside the register file: 0x%lx\n",
+				(unsigned long)Addr);
+		exit(1);
+	}
+
+	if (Offset == XSDPS_NORM_INTR_STS_OFFSET) {
+		SdMockState.StsReads++;
+		if (SdMockState.CmdWait != 0U) {
+			SdMockState.CmdWait--;
+			if (SdMockState.CmdWait == 0U) {
+				Sts = SdMock_Get(XSDPS_NORM_INTR_STS_OFFSET, 2U);
+				SdMock_Put(XSDPS_NORM_INTR_STS_OFFSET, 2U,
+						Sts | XSDPS_INTR_CC_MASK);
+			}
+		}
+		if (SdMockState.AutoComplete != 0U) {
+			SdMock_CompleteData(1U);
+		}
+	}
+
+	Value = SdMock_Get(Offset, Size);
+	if ((Offset <= XSDPS_NORM_INTR_STS_OFFSET + 1U) &&
+			(Offset + Size > XSDPS_NORM_INTR_STS_OFFSET + 1U) &&
+			(SdMock_Get(XSDPS_ERR_INTR_STS_OFFSET, 2U) != 0U)) {
+		/* Error interrupt bit of the normal status */
+		Value |= 0x80U <<
+			((XSDPS_NORM_INTR_STS_OFFSET + 1U - Offset) * 8U);
+	}
+
+	return Value;
+}
+
+static void SdMock_Write(UINTPTR Addr, u32 Size, u32 Value)
+{
+	u32 Offset = (u32)(Addr - SDMOCK_BASEADDR);
+	u32 Index;
+	u8 Byte;
+
+	if (Offset + Size > sizeof(SdMockState.Regs)) {
+		printf("write outside the register file: 0x%lx\n",
+				(unsigned long)Addr);
+		exit(1);
+	}
+
+	for (Index = 0U; Index < Size; Index++) {
+		Byte = (u8)(Value >> (Index * 8U));
+		switch (Offset + Index) {
+		case XSDPS_NORM_INTR_STS_OFFSET:
+		case XSDPS_NORM_INTR_STS_OFFSET + 1U:
+		case XSDPS_ERR_INTR_STS_OFFSET:
+		case XSDPS_ERR_INTR_STS_OFFSET + 1U:
+			/* Write 1 to clear */
+			SdMockState.Regs[Offset + Index] &= (u8)~Byte;
+			break;
+		case XSDPS_SW_RST_OFFSET:
+			if (Byte != 0U) {
+				SdMock_SoftReset(Byte);
+			}
+			break;
+		default:
+			SdMockState.Regs[Offset + Index] = Byte;
+			break;
+		}
+	}
+
+	if ((Offset == XSDPS_XFER_MODE_OFFSET) && (Size == 4U)) {
+		SdMock_IssueCmd(Value);
+	}
+}
+
+u8 Xil_In8(UINTPTR Addr)
+{
+	return (u8)SdMock_Read(Addr, 1U);
+}
+
+u16 Xil_In16(UINTPTR Addr)
+{
+	return (u16)SdMock_Read(Addr, 2U);
+}
+
+u32 Xil_In32(UINTPTR Addr)
+{
+	return SdMock_Read(Addr, 4U);
+}
+
+u64 Xil_In64(UINTPTR Addr)
+{
+	return (u64)SdMock_Read(Addr, 4U) |
+		((u64)SdMock_Read(Addr + 4U, 4U) << 32U);
+}
+
+void Xil_Out8(UINTPTR Addr, u8 Value)
+{
+	SdMock_Write(Addr, 1U, Value);
+}
+
+void Xil_Out16(UINTPTR Addr, u16 Value)
+{
+	SdMock_Write(Addr, 2U, Value);
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+	SdMock_Write(Addr, 4U, Value);
+}
+
+void Xil_Out64(UINTPTR Addr, u64 Value)
+{
+	SdMock_Write(Addr, 4U, (u32)Value);
+	SdMock_Write(Addr + 4U, 4U, (u32)(Value >> 32U));
+}
@@ -0,0 +1,99 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file sdhci_mock.h
+*
+* Register model of an SDHCI host controller for host builds of the XSdPs
+* driver. The model implements the registers the data path of the driver
+* uses:
+*
+* - Writing the transfer mode/command register issues the command. Command
+*   complete is signalled at once, or after CmdLatency reads of the normal
+*   interrupt status register. The data transfer of a command with data
+*   stays in progress (DAT inhibit set) until SdMock_CompleteData() ends it.
+* - Normal and error interrupt status registers are write-1-to-clear, the
+*   error interrupt bit of the normal status is the OR of the error status.
+* - Software reset bits self-clear. A CMD line reset clears CMD inhibit, a
+*   DAT line reset aborts the transfer in progress and clears DAT inhibit.
+*   A failed transfer leaves DAT inhibit set, as on the controller.
+* - The block count register reads 0 after a transfer has completed.
+*
+* All other registers read back the last value written.
+*
+******************************************************************************/
+#ifndef SDHCI_MOCK_H
+#define SDHCI_MOCK_H
+
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+#define SDMOCK_BASEADDR		0xFF160000U	/**< Base address of the model */
+#define SDMOCK_MAX_CMDS		64U		/**< Commands kept in the log */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * One command issued to the model.
+ */
+typedef struct {
+	u32 Index;		/**< Command index */
+	u32 Arg;		/**< Argument register at issue time */
+	u16 BlkCnt;		/**< Block count register at issue time */
+	u16 XferMode;		/**< Transfer mode register at issue time */
+} SdMock_Cmd;
+
+/**
+ * State of the model. Fields are read by the tests directly.
+ */
+typedef struct {
+	u8 Regs[0x100];		/**< Register file */
+	SdMock_Cmd Cmd[SDMOCK_MAX_CMDS];	/**< Command log */
+	u32 CmdCount;		/**< Commands issued */
+	u32 InhibitedCmds;	/**< Commands issued while inhibited */
+	u32 DataPending;	/**< Data transfer in progress */
+	u32 AutoComplete;	/**< End transfers on the next status read */
+	u32 CmdLatency;		/**< Status reads before command complete */
+	u32 CmdWait;		/**< Status reads left for the last command */
+	u32 StsReads;		/**< Normal interrupt status reads */
+	u32 SwRstCount;		/**< Software reset writes */
+	u8 SwRstBits;		/**< OR of all software reset values */
+	u64 DelayUs;		/**< Time spent in usleep() */
+} SdMock;
+
+/************************** Variable Definitions *****************************/
+
+extern SdMock SdMockState;
+
+/************************** Function Prototypes ******************************/
+
+void SdMock_Reset(void);
+void SdMock_CompleteData(u32 Ok);
+void SdMock_SetCardInserted(u32 Inserted);
+
+#endif /* SDHCI_MOCK_H */
@@ -0,0 +1,333 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file test_adma2.c
+*
+* Host test of the vectored ADMA2 descriptor table builders
+* XSdPs_BuildADMA2DescTbl32() and XSdPs_BuildADMA2DescTbl64(). The tables
+* are compared byte for byte with the layout of the ADMA2 descriptor
+* (attribute, length, address; little endian, packed): segments are split
+* at 64 KB, a full 64 KB descriptor has a length field of 0, only the last
+* descriptor has the END attribute, and entries past the chain are left
+* untouched. Segment lists the builders must reject are checked as well,
+* including segments aligned for 32-bit but not for 64-bit descriptors.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <string.h>
+#include "xsdps.h"
+
+/************************** Constant Definitions *****************************/
+
+#define TBL_ENTRIES	(XSDPS_DESC_MAX_NUM + 1U)
+#define FILL_BYTE	0xA5U
+#define ATTR_TRAN	(XSDPS_DESC_TRAN | XSDPS_DESC_VALID)
+#define ATTR_LAST	(XSDPS_DESC_TRAN | XSDPS_DESC_VALID | XSDPS_DESC_END)
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CHECK(Cond)	Test_Check((Cond) ? 1U : 0U, #Cond, __LINE__)
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * One expected descriptor.
+ */
+typedef struct {
+	u16 Attribute;
+	u16 Length;
+	u64 Address;
+} Test_Desc;
+
+/************************** Variable Definitions *****************************/
+
+static u32 Failures;
+static XSdPs_Adma2Descriptor32 Tbl32[TBL_ENTRIES];
+static XSdPs_Adma2Descriptor64 Tbl64[TBL_ENTRIES];
+
+/*****************************************************************************/
+static void Test_Check(u32 Ok, const char *Cond, int Line)
+{
+	if (Ok == 0U) {
+		printf("  FAIL line %d: %s\n", Line, Cond);
+		Failures++;
+	}
+}
+
+static u8 *Test_Put(u8 *Ptr, u64 Value, u32 Size)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Size; Index++) {
+		*Ptr = (u8)(Value >> (Index * 8U));
+		Ptr++;
+	}
+
+	return Ptr;
+}
+
+/*****************************************************************************/
+/**
+* Compares a table with the expected descriptors byte for byte. AddrSize is
+* 4 for the 32-bit and 8 for the 64-bit layout. The entries following the
+* chain must still hold the fill pattern.
+******************************************************************************/
+static void Test_CompareTbl(const void *Tbl, u32 AddrSize,
+		const Test_Desc *Exp, u32 ExpCnt, int Line)
+{
+	u8 Image[TBL_ENTRIES * sizeof(XSdPs_Adma2Descriptor64)];
+	u32 DescSize = 4U + AddrSize;
+	u8 *Ptr = Image;
+	u32 Index;
+
+	(void)memset(Image, FILL_BYTE, sizeof(Image));
+	for (Index = 0U; Index < ExpCnt; Index++) {
+		Ptr = Test_Put(Ptr, Exp[Index].Attribute, 2U);
+		Ptr = Test_Put(Ptr, Exp[Index].Length, 2U);
+		Ptr = Test_Put(Ptr, Exp[Index].Address, AddrSize);
+	}
+
+	Test_Check((memcmp(Tbl, Image, TBL_ENTRIES * DescSize) == 0) ?
+			1U : 0U, "descriptor table image", Line);
+}
+
+static void Test_Build(const XSdPs_IoVec *IoVec, u32 IoVecCnt,
+		const Test_Desc *Exp, u32 ExpCnt, u32 ExpBlkCnt, int Line)
+{
+	u32 BlkCnt = 0U;
+	s32 Status;
+
+	(void)memset(Tbl32, FILL_BYTE, sizeof(Tbl32));
+	Status = XSdPs_BuildADMA2DescTbl32(Tbl32, XSDPS_DESC_MAX_NUM,
+			IoVec, IoVecCnt, &BlkCnt);
+	Test_Check((Status == XST_SUCCESS) ? 1U : 0U, "32-bit status", Line);
+	Test_Check((BlkCnt == ExpBlkCnt) ? 1U : 0U, "32-bit BlkCnt", Line);
+	Test_CompareTbl(Tbl32, 4U, Exp, ExpCnt, Line);
+
+	BlkCnt = 0U;
+	(void)memset(Tbl64, FILL_BYTE, sizeof(Tbl64));
+	Status = XSdPs_BuildADMA2DescTbl64(Tbl64, XSDPS_DESC_MAX_NUM,
+			IoVec, IoVecCnt, &BlkCnt);
+	Test_Check((Status == XST_SUCCESS) ? 1U : 0U, "64-bit status", Line);
+	Test_Check((BlkCnt == ExpBlkCnt) ? 1U : 0U, "64-bit BlkCnt", Line);
+	Test_CompareTbl(Tbl64, 8U, Exp, ExpCnt, Line);
+}
+
+static void Test_Reject(const XSdPs_IoVec *IoVec, u32 IoVecCnt, u32 MaxDesc,
+		u32 Is64Ok, int Line)
+{
+	u32 BlkCnt = 0x1234U;
+	s32 Status;
+
+	(void)memset(Tbl32, FILL_BYTE, sizeof(Tbl32));
+	Status = XSdPs_BuildADMA2DescTbl32(Tbl32, MaxDesc, IoVec, IoVecCnt,
+			&BlkCnt);
+	Test_Check((Status == XST_INVALID_PARAM) ? 1U : 0U,
+			"32-bit rejects", Line);
+	Test_Check((BlkCnt == 0x1234U) ? 1U : 0U, "32-bit BlkCnt kept", Line);
+	Test_CompareTbl(Tbl32, 4U, NULL, 0U, Line);
+
+	(void)memset(Tbl64, FILL_BYTE, sizeof(Tbl64));
+	Status = XSdPs_BuildADMA2DescTbl64(Tbl64, MaxDesc, IoVec, IoVecCnt,
+			&BlkCnt);
+	if (Is64Ok != 0U) {
+		Test_Check((Status == XST_SUCCESS) ? 1U : 0U,
+				"64-bit accepts", Line);
+	} else {
+		Test_Check((Status == XST_INVALID_PARAM) ? 1U : 0U,
+				"64-bit rejects", Line);
+		Test_CompareTbl(Tbl64, 8U, NULL, 0U, Line);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Segments below, at and across the 64 KB descriptor limit.
+******************************************************************************/
+static void Test_Split(void)
+{
+	const XSdPs_IoVec Small = { 0x10000000U, 512U };
+	const Test_Desc SmallExp[] = {
+		{ ATTR_LAST, 512U, 0x10000000U },
+	};
+	const XSdPs_IoVec Full = { 0x10000000U, 0x10000U };
+	const Test_Desc FullExp[] = {
+		{ ATTR_LAST, 0U, 0x10000000U },
+	};
+	const XSdPs_IoVec Over = { 0x10000000U, 0x10000U + 512U };
+	const Test_Desc OverExp[] = {
+		{ ATTR_TRAN, 0U, 0x10000000U },
+		{ ATTR_LAST, 512U, 0x10010000U },
+	};
+	/* Unaligned start: splits are relative to the segment start */
+	const XSdPs_IoVec Multi = { 0x10000208U, 3U * 0x10000U + 4096U };
+	const Test_Desc MultiExp[] = {
+		{ ATTR_TRAN, 0U, 0x10000208U },
+		{ ATTR_TRAN, 0U, 0x10010208U },
+		{ ATTR_TRAN, 0U, 0x10020208U },
+		{ ATTR_LAST, 4096U, 0x10030208U },
+	};
+	const XSdPs_IoVec Twice = { 0x10000000U, 2U * 0x10000U };
+	const Test_Desc TwiceExp[] = {
+		{ ATTR_TRAN, 0U, 0x10000000U },
+		{ ATTR_LAST, 0U, 0x10010000U },
+	};
+
+	printf("64 KB boundary splits\n");
+	Test_Build(&Small, 1U, SmallExp, 1U, 1U, __LINE__);
+	Test_Build(&Full, 1U, FullExp, 1U, 128U, __LINE__);
+	Test_Build(&Over, 1U, OverExp, 2U, 129U, __LINE__);
+	Test_Build(&Multi, 1U, MultiExp, 4U, 392U, __LINE__);
+	Test_Build(&Twice, 1U, TwiceExp, 2U, 256U, __LINE__);
+}
+
+/*****************************************************************************/
+/**
+* Segments whose lengths are not multiples of the block size; only the
+* total has to be.
+******************************************************************************/
+static void Test_OddLengths(void)
+{
+	const XSdPs_IoVec Vec[] = {
+		{ 0x20000000U, 104U },
+		{ 0x20001000U, 408U },
+		{ 0x20002008U, 0x10000U + 1016U },
+		{ 0x20040000U, 8U },
+	};
+	const Test_Desc Exp[] = {
+		{ ATTR_TRAN, 104U, 0x20000000U },
+		{ ATTR_TRAN, 408U, 0x20001000U },
+		{ ATTR_TRAN, 0U, 0x20002008U },
+		{ ATTR_TRAN, 1016U, 0x20012008U },
+		{ ATTR_LAST, 8U, 0x20040000U },
+	};
+
+	printf("odd-length segments\n");
+	Test_Build(Vec, 4U, Exp, 5U, 131U, __LINE__);
+}
+
+/*****************************************************************************/
+/**
+* A chain using every descriptor, and 64-bit addresses.
+******************************************************************************/
+static void Test_Limits(void)
+{
+	XSdPs_IoVec Vec[XSDPS_DESC_MAX_NUM];
+	Test_Desc Exp[XSDPS_DESC_MAX_NUM];
+	const XSdPs_IoVec High = { (UINTPTR)0x812345000ULL, 0x10000U + 512U };
+	const Test_Desc HighExp[] = {
+		{ ATTR_TRAN, 0U, 0x812345000ULL },
+		{ ATTR_LAST, 512U, 0x812355000ULL },
+	};
+	u32 BlkCnt = 0U;
+	u32 Index;
+
+	printf("full table and 64-bit addresses\n");
+	for (Index = 0U; Index < XSDPS_DESC_MAX_NUM; Index++) {
+		Vec[Index].Address = 0x30000000U + (Index * 0x1000U);
+		Vec[Index].Length = 256U;
+		Exp[Index].Attribute = ATTR_TRAN;
+		Exp[Index].Length = 256U;
+		Exp[Index].Address = Vec[Index].Address;
+	}
+	Exp[XSDPS_DESC_MAX_NUM - 1U].Attribute = ATTR_LAST;
+	Test_Build(Vec, XSDPS_DESC_MAX_NUM, Exp, XSDPS_DESC_MAX_NUM,
+			XSDPS_DESC_MAX_NUM / 2U, __LINE__);
+
+	(void)memset(Tbl64, FILL_BYTE, sizeof(Tbl64));
+	CHECK(XSdPs_BuildADMA2DescTbl64(Tbl64, XSDPS_DESC_MAX_NUM, &High, 1U,
+			&BlkCnt) == XST_SUCCESS);
+	CHECK(BlkCnt == 129U);
+	Test_CompareTbl(Tbl64, 8U, HighExp, 2U, __LINE__);
+}
+
+/*****************************************************************************/
+/**
+* Segment lists the builders must reject without touching the table.
+******************************************************************************/
+static void Test_Invalid(void)
+{
+	const XSdPs_IoVec OddLen = { 0x10000000U, 511U };
+	const XSdPs_IoVec OddAddr = { 0x10000002U, 512U };
+	const XSdPs_IoVec Zero[] = {
+		{ 0x10000000U, 512U },
+		{ 0x10001000U, 0U },
+	};
+	const XSdPs_IoVec Partial[] = {
+		{ 0x10000000U, 512U },
+		{ 0x10001000U, 100U },
+	};
+	const XSdPs_IoVec Big = { 0x10000000U, 3U * 0x10000U };
+	const XSdPs_IoVec High = { (UINTPTR)0x100000000ULL, 512U };
+	const XSdPs_IoVec Straddle = { 0xFFFFFE00U, 1024U };
+	const XSdPs_IoVec Align4[] = {
+		{ 0x10000004U, 508U },
+		{ 0x10001000U, 4U },
+	};
+	u32 BlkCnt = 0U;
+
+	printf("rejected segment lists\n");
+	Test_Reject(&OddLen, 1U, XSDPS_DESC_MAX_NUM, 0U, __LINE__);
+	Test_Reject(&OddAddr, 1U, XSDPS_DESC_MAX_NUM, 0U, __LINE__);
+	Test_Reject(Zero, 2U, XSDPS_DESC_MAX_NUM, 0U, __LINE__);
+	Test_Reject(Partial, 2U, XSDPS_DESC_MAX_NUM, 0U, __LINE__);
+	Test_Reject(&OddLen, 0U, XSDPS_DESC_MAX_NUM, 0U, __LINE__);
+	/* Three descriptors needed, two available */
+	Test_Reject(&Big, 1U, 2U, 0U, __LINE__);
+	/* Multiples of 4 but not of 8 bytes: 64-bit descriptors only */
+	CHECK(XSdPs_BuildADMA2DescTbl32(Tbl32, XSDPS_DESC_MAX_NUM,
+			Align4, 2U, &BlkCnt) == XST_SUCCESS);
+	CHECK(BlkCnt == 1U);
+	(void)memset(Tbl64, FILL_BYTE, sizeof(Tbl64));
+	CHECK(XSdPs_BuildADMA2DescTbl64(Tbl64, XSDPS_DESC_MAX_NUM,
+			Align4, 2U, &BlkCnt) == XST_INVALID_PARAM);
+	Test_CompareTbl(Tbl64, 8U, NULL, 0U, __LINE__);
+	/* Beyond the reach of a 32-bit descriptor only */
+	Test_Reject(&High, 1U, XSDPS_DESC_MAX_NUM, 1U, __LINE__);
+	Test_Reject(&Straddle, 1U, XSDPS_DESC_MAX_NUM, 1U, __LINE__);
+}
+
+int main(void)
+{
+	CHECK(sizeof(XSdPs_Adma2Descriptor32) == 8U);
+	CHECK(sizeof(XSdPs_Adma2Descriptor64) == 12U);
+
+	Test_Split();
+	Test_OddLengths();
+	Test_Limits();
+	Test_Invalid();
+
+	if (Failures != 0U) {
+		printf("test_adma2: %u check(s) failed\n", Failures);
+		return 1;
+	}
+	printf("test_adma2: all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,411 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file test_request.c
+*
+* Host test of the queued request API of the XSdPs driver (xsdps_intr.c)
+* against the SDHCI register model in sdhci_mock.c. It checks the command
+* stream the queue issues, that the next request is issued before the
+* completion handler of the finished one runs, and that a failed transfer
+* resets the CMD and DAT lines so that the following request can be issued.
+* It also checks that polled transfers are refused while requests are queued,
+* that 64-bit DMA addresses are carried by the request and that the handler
+* does not poll for the response of the command it issues.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <string.h>
+#include "xsdps.h"
+#include "sdhci_mock.h"
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CHECK(Cond)	Test_Check((Cond) ? 1U : 0U, #Cond, __LINE__)
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u32 Calls;		/**< Handler calls */
+	s32 Status;		/**< Status passed to the handler */
+	u32 CmdCount;		/**< Commands issued when the handler ran */
+} Test_Done;
+
+/************************** Variable Definitions *****************************/
+
+static u32 Failures;
+static u8 Buff[3][16U * XSDPS_BLK_SIZE_512_MASK];
+
+/*****************************************************************************/
+static void Test_Check(u32 Ok, const char *Cond, int Line)
+{
+	if (Ok == 0U) {
+		printf("  FAIL line %d: %s\n", Line, Cond);
+		Failures++;
+	}
+}
+
+static void Test_Handler(void *CallBackRef, s32 Status)
+{
+	Test_Done *Done = (Test_Done *)CallBackRef;
+
+	Done->Calls++;
+	Done->Status = Status;
+	Done->CmdCount = SdMockState.CmdCount;
+}
+
+static void Test_InitInstance(XSdPs *Sd)
+{
+	SdMock_Reset();
+	(void)memset(Sd, 0, sizeof(*Sd));
+	Sd->Config.BaseAddress = SDMOCK_BASEADDR;
+	Sd->Config.CardDetect = 1U;
+	Sd->Config.IsCacheCoherent = 1U;
+	Sd->IsReady = XIL_COMPONENT_IS_READY;
+	Sd->HC_Version = XSDPS_HC_SPEC_V3;
+	Sd->CardType = XSDPS_CARD_SD;
+}
+
+static void Test_InitRequest(XSdPs_Request *Req, u32 Arg, u32 BlkCnt,
+		u8 IsWrite, u8 *Data, Test_Done *Done)
+{
+	(void)memset(Req, 0, sizeof(*Req));
+	(void)memset(Done, 0, sizeof(*Done));
+	Req->Arg = Arg;
+	Req->BlkCnt = BlkCnt;
+	Req->Buff = Data;
+	Req->IsWrite = IsWrite;
+	Req->Handler = Test_Handler;
+	Req->CallBackRef = Done;
+}
+
+static void Test_CheckCmd(u32 Num, u32 Index, u32 Arg, u16 BlkCnt, int Line)
+{
+	const SdMock_Cmd *Cmd = &SdMockState.Cmd[Num];
+
+	Test_Check((SdMockState.CmdCount > Num) ? 1U : 0U,
+			"command issued", Line);
+	Test_Check((Cmd->Index == Index) ? 1U : 0U, "command index", Line);
+	Test_Check((Cmd->Arg == Arg) ? 1U : 0U, "command argument", Line);
+	Test_Check((Cmd->BlkCnt == BlkCnt) ? 1U : 0U, "block count", Line);
+}
+
+/*****************************************************************************/
+/**
+* Three requests in interrupt mode: each completion issues the next command
+* before the handler of the finished request is called.
+******************************************************************************/
+static void Test_IntrQueue(void)
+{
+	XSdPs Sd;
+	XSdPs_Request Req[3];
+	Test_Done Done[3];
+
+	printf("interrupt mode queue\n");
+	Test_InitInstance(&Sd);
+	XSdPs_SetIntrMode(&Sd, 1U);
+	Test_InitRequest(&Req[0], 100U, 8U, 0U, Buff[0], &Done[0]);
+	Test_InitRequest(&Req[1], 200U, 1U, 1U, Buff[1], &Done[1]);
+	Test_InitRequest(&Req[2], 300U, 16U, 0U, Buff[2], &Done[2]);
+
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[0]) == XST_SUCCESS);
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[1]) == XST_SUCCESS);
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[2]) == XST_SUCCESS);
+
+	/* CMD16 block size, then only the first request is issued */
+	CHECK(SdMockState.CmdCount == 2U);
+	Test_CheckCmd(0U, 16U, XSDPS_BLK_SIZE_512_MASK, 0U, __LINE__);
+	Test_CheckCmd(1U, 18U, 100U, 8U, __LINE__);
+	CHECK(XSdPs_IsBusy(&Sd) == TRUE);
+	CHECK(Req[0].Status == XST_DEVICE_BUSY);
+	CHECK(XSdPs_ReadReg16(SDMOCK_BASEADDR, XSDPS_NORM_INTR_SIG_EN_OFFSET) ==
+			(XSDPS_INTR_TC_MASK | XSDPS_INTR_ERR_MASK));
+
+	/* No completion pending: no side effects */
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(Done[0].Calls == 0U);
+	CHECK(SdMockState.CmdCount == 2U);
+
+	SdMock_CompleteData(1U);
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(Done[0].Calls == 1U);
+	CHECK(Done[0].Status == XST_SUCCESS);
+	CHECK(Req[0].Status == XST_SUCCESS);
+	CHECK(Done[0].CmdCount == 3U);
+	Test_CheckCmd(2U, 24U, 200U, 1U, __LINE__);
+
+	SdMock_CompleteData(1U);
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(Done[1].Calls == 1U);
+	CHECK(Done[1].CmdCount == 4U);
+	Test_CheckCmd(3U, 18U, 300U, 16U, __LINE__);
+
+	SdMock_CompleteData(1U);
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(Done[2].Calls == 1U);
+	CHECK(Req[2].Status == XST_SUCCESS);
+	CHECK(XSdPs_IsBusy(&Sd) == FALSE);
+	CHECK(SdMockState.CmdCount == 4U);
+	CHECK(SdMockState.SwRstCount == 0U);
+	CHECK(XSdPs_ReadReg16(SDMOCK_BASEADDR,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET) == 0U);
+}
+
+/*****************************************************************************/
+/**
+* A failed transfer leaves DAT inhibit set. The handler must reset the CMD
+* and DAT lines, otherwise the command of the next request is refused.
+******************************************************************************/
+static void Test_ErrorChain(void)
+{
+	XSdPs Sd;
+	XSdPs_Request Req[2];
+	Test_Done Done[2];
+
+	printf("error then chained request\n");
+	Test_InitInstance(&Sd);
+	XSdPs_SetIntrMode(&Sd, 1U);
+	Test_InitRequest(&Req[0], 10U, 4U, 0U, Buff[0], &Done[0]);
+	Test_InitRequest(&Req[1], 20U, 2U, 0U, Buff[1], &Done[1]);
+
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[0]) == XST_SUCCESS);
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[1]) == XST_SUCCESS);
+
+	SdMock_CompleteData(0U);
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(Done[0].Calls == 1U);
+	CHECK(Done[0].Status == XST_FAILURE);
+	CHECK(SdMockState.SwRstCount == 1U);
+	CHECK(SdMockState.SwRstBits ==
+		(XSDPS_SWRST_CMD_LINE_MASK | XSDPS_SWRST_DAT_LINE_MASK));
+	CHECK(XSdPs_ReadReg16(SDMOCK_BASEADDR, XSDPS_ERR_INTR_STS_OFFSET) == 0U);
+	CHECK(SdMockState.InhibitedCmds == 0U);
+	CHECK(Done[1].Calls == 0U);
+	CHECK(Req[1].Status == XST_DEVICE_BUSY);
+	Test_CheckCmd(2U, 18U, 20U, 2U, __LINE__);
+
+	SdMock_CompleteData(1U);
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(Done[1].Calls == 1U);
+	CHECK(Done[1].Status == XST_SUCCESS);
+	CHECK(XSdPs_IsBusy(&Sd) == FALSE);
+}
+
+/*****************************************************************************/
+/**
+* The command response arrives some status reads after the command. The
+* handler must issue the next command and return after reading the status
+* once, the response is seen with the transfer complete interrupt.
+******************************************************************************/
+static void Test_NoPollInHandler(void)
+{
+	XSdPs Sd;
+	XSdPs_Request Req[2];
+	Test_Done Done[2];
+
+	printf("no polling in the handler\n");
+	Test_InitInstance(&Sd);
+	XSdPs_SetIntrMode(&Sd, 1U);
+	SdMockState.CmdLatency = 8U;
+	Test_InitRequest(&Req[0], 40U, 4U, 1U, Buff[0], &Done[0]);
+	Test_InitRequest(&Req[1], 50U, 4U, 1U, Buff[1], &Done[1]);
+
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[0]) == XST_SUCCESS);
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[1]) == XST_SUCCESS);
+	CHECK(SdMockState.CmdCount == 2U);
+
+	SdMock_CompleteData(1U);
+	SdMockState.StsReads = 0U;
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(SdMockState.StsReads == 1U);
+	CHECK(Done[0].Calls == 1U);
+	CHECK(Done[0].Status == XST_SUCCESS);
+	CHECK(Done[0].CmdCount == 3U);
+	Test_CheckCmd(2U, 25U, 50U, 4U, __LINE__);
+	CHECK(SdMockState.CmdWait != 0U);
+
+	SdMock_CompleteData(1U);
+	SdMockState.StsReads = 0U;
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(SdMockState.StsReads == 1U);
+	CHECK(Done[1].Calls == 1U);
+	CHECK(Done[1].Status == XST_SUCCESS);
+	CHECK(XSdPs_IsBusy(&Sd) == FALSE);
+}
+
+/*****************************************************************************/
+/**
+* Polled completion mode: XSdPs_WaitRequest() runs the completion
+* processing and issues the queued requests.
+******************************************************************************/
+static void Test_Polled(void)
+{
+	XSdPs Sd;
+	XSdPs_Request Req[2];
+	Test_Done Done[2];
+
+	printf("polled completion mode\n");
+	Test_InitInstance(&Sd);
+	SdMockState.AutoComplete = 1U;
+	Test_InitRequest(&Req[0], 1000U, 2U, 1U, Buff[0], &Done[0]);
+	Test_InitRequest(&Req[1], 2000U, 3U, 0U, Buff[1], &Done[1]);
+
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[0]) == XST_SUCCESS);
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[1]) == XST_SUCCESS);
+	CHECK(XSdPs_WaitRequest(&Sd, &Req[1]) == XST_SUCCESS);
+	CHECK(Done[0].Calls == 1U);
+	CHECK(Done[1].Calls == 1U);
+	Test_CheckCmd(1U, 25U, 1000U, 2U, __LINE__);
+	Test_CheckCmd(2U, 18U, 2000U, 3U, __LINE__);
+	CHECK(XSdPs_IsBusy(&Sd) == FALSE);
+	CHECK(XSdPs_ReadReg16(SDMOCK_BASEADDR,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET) == 0U);
+}
+
+/*****************************************************************************/
+/**
+* A request submitted without a card fails at once and is not queued.
+******************************************************************************/
+static void Test_NoCard(void)
+{
+	XSdPs Sd;
+	XSdPs_Request Req;
+	Test_Done Done;
+
+	printf("card not inserted\n");
+	Test_InitInstance(&Sd);
+	SdMock_SetCardInserted(0U);
+	Test_InitRequest(&Req, 0U, 1U, 0U, Buff[0], &Done);
+
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req) == XST_FAILURE);
+	CHECK(Req.Status == XST_FAILURE);
+	CHECK(SdMockState.CmdCount == 0U);
+	CHECK(XSdPs_IsBusy(&Sd) == FALSE);
+	CHECK(Done.Calls == 0U);
+}
+
+/*****************************************************************************/
+/**
+* Polled transfers share the ADMA2 descriptor table and the transfer mode
+* with the queue. While a request is in progress they must be refused
+* without touching the controller.
+******************************************************************************/
+static void Test_PolledWhileBusy(void)
+{
+	XSdPs Sd;
+	XSdPs_Request Req;
+	Test_Done Done;
+	XSdPs_IoVec IoVec;
+	u16 XferMode;
+
+	printf("polled transfer while busy\n");
+	Test_InitInstance(&Sd);
+	XSdPs_SetIntrMode(&Sd, 1U);
+	Test_InitRequest(&Req, 100U, 8U, 0U, Buff[0], &Done);
+	IoVec.Address = (UINTPTR)Buff[2];
+	IoVec.Length = XSDPS_BLK_SIZE_512_MASK;
+
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req) == XST_SUCCESS);
+	XferMode = XSdPs_ReadReg16(SDMOCK_BASEADDR, XSDPS_XFER_MODE_OFFSET);
+
+	CHECK(XSdPs_ReadPolled(&Sd, 500U, 1U, Buff[1]) == XST_DEVICE_BUSY);
+	CHECK(XSdPs_WritePolled(&Sd, 500U, 1U, Buff[1]) == XST_DEVICE_BUSY);
+	CHECK(XSdPs_ReadVecPolled(&Sd, 500U, &IoVec, 1U) == XST_DEVICE_BUSY);
+	CHECK(XSdPs_Get_Status(&Sd, Buff[1]) == XST_DEVICE_BUSY);
+	CHECK(SdMockState.CmdCount == 2U);
+	CHECK(XSdPs_ReadReg16(SDMOCK_BASEADDR, XSDPS_XFER_MODE_OFFSET) ==
+			XferMode);
+
+	SdMock_CompleteData(1U);
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(Done.Status == XST_SUCCESS);
+	CHECK(XSdPs_IsBusy(&Sd) == FALSE);
+
+	/* Idle again: the polled API works */
+	SdMockState.AutoComplete = 1U;
+	CHECK(XSdPs_ReadPolled(&Sd, 500U, 1U, Buff[1]) == XST_SUCCESS);
+	Test_CheckCmd(2U, 17U, 500U, 1U, __LINE__);
+}
+
+/*****************************************************************************/
+/**
+* A 64-bit DMA address set in the instance, as for the polled transfers, is
+* taken over by the next submitted request and used when it is issued.
+******************************************************************************/
+static void Test_Dma64Bit(void)
+{
+	XSdPs Sd;
+	XSdPs_Request Req[2];
+	Test_Done Done[2];
+
+	printf("64-bit DMA address\n");
+	Test_InitInstance(&Sd);
+	XSdPs_SetIntrMode(&Sd, 1U);
+	Test_InitRequest(&Req[0], 10U, 2U, 0U, Buff[0], &Done[0]);
+	Test_InitRequest(&Req[1], 20U, 4U, 1U, NULL, &Done[1]);
+	Req[1].Dma64BitAddr = 0x800000000ULL;
+
+	Sd.Dma64BitAddr = 0x400000000ULL;
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[0]) == XST_SUCCESS);
+	CHECK(Req[0].Dma64BitAddr == 0x400000000ULL);
+	CHECK(Sd.Dma64BitAddr == 0U);
+	CHECK(XSdPs_SubmitRequest(&Sd, &Req[1]) == XST_SUCCESS);
+	CHECK(Req[1].Dma64BitAddr == 0x800000000ULL);
+	Test_CheckCmd(1U, 18U, 10U, 2U, __LINE__);
+
+	SdMock_CompleteData(1U);
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(Done[0].Status == XST_SUCCESS);
+	Test_CheckCmd(2U, 25U, 20U, 4U, __LINE__);
+	/* The 64-bit table setup consumes the instance address */
+	CHECK(Sd.Dma64BitAddr == 0U);
+
+	SdMock_CompleteData(1U);
+	XSdPs_InterruptHandler(&Sd);
+	CHECK(Done[1].Status == XST_SUCCESS);
+	CHECK(XSdPs_IsBusy(&Sd) == FALSE);
+}
+
+int main(void)
+{
+	Test_IntrQueue();
+	Test_ErrorChain();
+	Test_NoPollInHandler();
+	Test_Polled();
+	Test_NoCard();
+	Test_PolledWhileBusy();
+	Test_Dma64Bit();
+
+	if (Failures != 0U) {
+		printf("test_request: %u check(s) failed\n", Failures);
+		return 1;
+	}
+	printf("test_request: all checks passed\n");
+	return 0;
+}
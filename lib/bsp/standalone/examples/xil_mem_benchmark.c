@@ -0,0 +1,379 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_mem_benchmark.c
+*
+* This example checks Xil_MemCpy, Xil_MemSet and Xil_MemCmp against simple
+* byte loops and measures both over a range of sizes and source/destination
+* misalignments.
+*
+* On the target the example uses XTime_GetTime for timing. It can also be
+* built on a Linux host by defining XIL_MEM_BENCH_HOST, for example:
+*
+*	gcc -O2 -DXIL_MEM_BENCH_HOST -I../src/common -I<dir with
+*	    xil_printf.h> xil_mem_benchmark.c ../src/common/xil_mem.c
+*
+* where xil_printf may simply map to printf. On an AArch64 host the NEON
+* paths are exercised as well.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 7.1   ag   10/16/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+#include "xil_mem.h"
+#include "xil_printf.h"
+#include "xstatus.h"
+#ifdef XIL_MEM_BENCH_HOST
+#include <time.h>
+#else
+#include "xtime_l.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define BENCH_MAX_SIZE		65536U
+#define BENCH_MAX_ALIGN		8U
+#define BENCH_BYTES_PER_RUN	(4U * 1024U * 1024U)	/* Per measurement */
+
+/**************************** Type Definitions *******************************/
+
+typedef enum {
+	BENCH_OP_CPY = 0,
+	BENCH_OP_SET,
+	BENCH_OP_CMP,
+} BenchOp;
+
+/************************** Function Prototypes ******************************/
+
+static int CheckCorrectness(void);
+static void RunBenchmark(void);
+static u64 TimeOp(BenchOp Op, u32 Size, u32 DstAlign, u32 SrcAlign,
+		u32 UseRef);
+static u64 GetTimeNs(void);
+static void RefMemCpy(u8 *Dst, const u8 *Src, u32 Cnt);
+static void RefMemSet(u8 *Dst, u8 Val, u32 Cnt);
+static s32 RefMemCmp(const u8 *Buf1, const u8 *Buf2, u32 Cnt);
+
+/************************** Variable Definitions *****************************/
+
+static u8 SrcBuf[BENCH_MAX_SIZE + (2U * BENCH_MAX_ALIGN)]
+					__attribute__ ((aligned(64)));
+static u8 DstBuf[BENCH_MAX_SIZE + (2U * BENCH_MAX_ALIGN)]
+					__attribute__ ((aligned(64)));
+static u8 RefBuf[BENCH_MAX_SIZE + (2U * BENCH_MAX_ALIGN)]
+					__attribute__ ((aligned(64)));
+
+static const u32 Sizes[] = { 8U, 16U, 64U, 256U, 1024U, 4096U, 65536U };
+static const u32 Aligns[][2] = {
+	{ 0U, 0U }, { 1U, 1U }, { 4U, 0U }, { 1U, 3U }, { 0U, 7U }
+};
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the memory routine benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+int main(void)
+{
+	xil_printf("Xil_Mem Benchmark\r\n");
+
+	if (CheckCorrectness() != XST_SUCCESS) {
+		xil_printf("Xil_Mem Benchmark failed\r\n");
+		return XST_FAILURE;
+	}
+
+	RunBenchmark();
+
+	xil_printf("Successfully ran Xil_Mem Benchmark\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Compares Xil_MemCpy, Xil_MemSet and Xil_MemCmp with the reference byte
+* loops for every length up to 300 bytes and a few large lengths, at every
+* source and destination offset within a 64-bit word. Guard bytes around the
+* destination are checked so that head and tail handling cannot overrun.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if all results match, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int CheckCorrectness(void)
+{
+	static const u32 Large[] = { 1023U, 4096U, 4101U, 65536U - 8U };
+	u32 Size;
+	u32 Idx;
+	u32 Dst;
+	u32 Src;
+	u32 Byte;
+	u32 Total = BENCH_MAX_SIZE + (2U * BENCH_MAX_ALIGN);
+	s32 Got;
+	s32 Exp;
+
+	for (Byte = 0U; Byte < Total; Byte++) {
+		SrcBuf[Byte] = (u8)((Byte * 7U) + 3U);
+	}
+
+	for (Idx = 0U; Idx < (300U + (sizeof(Large) / sizeof(Large[0])));
+			Idx++) {
+		Size = (Idx < 300U) ? Idx : Large[Idx - 300U];
+		for (Dst = 0U; Dst < BENCH_MAX_ALIGN; Dst++) {
+			for (Src = 0U; Src < BENCH_MAX_ALIGN; Src++) {
+				RefMemSet(DstBuf, 0xA5U, Total);
+				RefMemSet(RefBuf, 0xA5U, Total);
+				Xil_MemCpy(&DstBuf[Dst], &SrcBuf[Src], Size);
+				RefMemCpy(&RefBuf[Dst], &SrcBuf[Src], Size);
+				if (RefMemCmp(DstBuf, RefBuf, Total) != 0) {
+					xil_printf("memcpy mismatch size %d dst %d src %d\r\n",
+						Size, Dst, Src);
+					return XST_FAILURE;
+				}
+
+				Got = Xil_MemCmp(&DstBuf[Dst], &SrcBuf[Src], Size);
+				if (Got != 0) {
+					xil_printf("memcmp equal size %d\r\n", Size);
+					return XST_FAILURE;
+				}
+				if (Size != 0U) {
+					DstBuf[Dst + ((Size * 5U) / 8U)] ^= 0x10U;
+					Got = Xil_MemCmp(&DstBuf[Dst], &SrcBuf[Src], Size);
+					Exp = RefMemCmp(&DstBuf[Dst], &SrcBuf[Src], Size);
+					if ((Got < 0) != (Exp < 0) ||
+						(Got > 0) != (Exp > 0)) {
+						xil_printf("memcmp differ size %d\r\n", Size);
+						return XST_FAILURE;
+					}
+				}
+			}
+
+			RefMemSet(DstBuf, 0xA5U, Total);
+			RefMemSet(RefBuf, 0xA5U, Total);
+			Xil_MemSet(&DstBuf[Dst], (s32)Size, Size);
+			RefMemSet(&RefBuf[Dst], (u8)Size, Size);
+			if (RefMemCmp(DstBuf, RefBuf, Total) != 0) {
+				xil_printf("memset mismatch size %d dst %d\r\n",
+					Size, Dst);
+				return XST_FAILURE;
+			}
+		}
+	}
+
+	xil_printf("Correctness checks passed\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Prints the throughput of the reference loops and of the Xil_Mem routines
+* in MB/s for each size and alignment pair.
+*
+* @param	None
+*
+* @return	None
+*
+******************************************************************************/
+static void RunBenchmark(void)
+{
+	static const char *OpNames[] = { "memcpy", "memset", "memcmp" };
+	u32 Op;
+	u32 SizeIdx;
+	u32 AlignIdx;
+	u32 Size;
+	u64 RefNs;
+	u64 OptNs;
+
+	xil_printf("%-7s %6s %3s %3s %10s %10s\r\n", "op", "size", "dst",
+			"src", "ref MB/s", "xil MB/s");
+
+	for (Op = BENCH_OP_CPY; Op <= BENCH_OP_CMP; Op++) {
+		for (SizeIdx = 0U; SizeIdx < (sizeof(Sizes) / sizeof(Sizes[0]));
+				SizeIdx++) {
+			Size = Sizes[SizeIdx];
+			for (AlignIdx = 0U;
+				AlignIdx < (sizeof(Aligns) / sizeof(Aligns[0]));
+				AlignIdx++) {
+				RefNs = TimeOp((BenchOp)Op, Size, Aligns[AlignIdx][0],
+						Aligns[AlignIdx][1], 1U);
+				OptNs = TimeOp((BenchOp)Op, Size, Aligns[AlignIdx][0],
+						Aligns[AlignIdx][1], 0U);
+				xil_printf("%-7s %6d %3d %3d %10d %10d\r\n",
+					OpNames[Op], Size, Aligns[AlignIdx][0],
+					Aligns[AlignIdx][1],
+					(u32)((BENCH_BYTES_PER_RUN * 1000ULL) /
+						((RefNs != 0U) ? RefNs : 1U)),
+					(u32)((BENCH_BYTES_PER_RUN * 1000ULL) /
+						((OptNs != 0U) ? OptNs : 1U)));
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Runs one operation repeatedly until BENCH_BYTES_PER_RUN bytes have been
+* processed and returns the elapsed time.
+*
+* @param	Op is the operation to time.
+* @param	Size is the length of each call in bytes.
+* @param	DstAlign is the offset of the destination buffer.
+* @param	SrcAlign is the offset of the source buffer.
+* @param	UseRef selects the reference byte loop instead of Xil_Mem*.
+*
+* @return	Elapsed time in nanoseconds.
+*
+******************************************************************************/
+static u64 TimeOp(BenchOp Op, u32 Size, u32 DstAlign, u32 SrcAlign,
+		u32 UseRef)
+{
+	volatile s32 Sink = 0;
+	u32 Iter = BENCH_BYTES_PER_RUN / Size;
+	u32 Count;
+	u64 Start;
+
+	Xil_MemCpy(&DstBuf[DstAlign], &SrcBuf[SrcAlign], Size);
+
+	Start = GetTimeNs();
+	for (Count = 0U; Count < Iter; Count++) {
+		switch (Op) {
+		case BENCH_OP_CPY:
+			if (UseRef != 0U) {
+				RefMemCpy(&DstBuf[DstAlign], &SrcBuf[SrcAlign], Size);
+			} else {
+				Xil_MemCpy(&DstBuf[DstAlign], &SrcBuf[SrcAlign], Size);
+			}
+			break;
+		case BENCH_OP_SET:
+			if (UseRef != 0U) {
+				RefMemSet(&DstBuf[DstAlign], (u8)Count, Size);
+			} else {
+				Xil_MemSet(&DstBuf[DstAlign], (s32)Count, Size);
+			}
+			break;
+		default:
+			if (UseRef != 0U) {
+				Sink += RefMemCmp(&DstBuf[DstAlign],
+						&SrcBuf[SrcAlign], Size);
+			} else {
+				Sink += Xil_MemCmp(&DstBuf[DstAlign],
+						&SrcBuf[SrcAlign], Size);
+			}
+			break;
+		}
+	}
+
+	(void)Sink;
+	return GetTimeNs() - Start;
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns a monotonic time stamp in nanoseconds.
+*
+* @param	None
+*
+* @return	Time stamp in nanoseconds.
+*
+******************************************************************************/
+static u64 GetTimeNs(void)
+{
+#ifdef XIL_MEM_BENCH_HOST
+	struct timespec Ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &Ts);
+	return ((u64)Ts.tv_sec * 1000000000ULL) + (u64)Ts.tv_nsec;
+#else
+	XTime Now;
+
+	XTime_GetTime(&Now);
+	return ((u64)Now * 1000000000ULL) / COUNTS_PER_SECOND;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Reference byte loops. They are kept out of line and operate on volatile
+* data so that the compiler does not replace them with library calls.
+*
+******************************************************************************/
+static void __attribute__ ((noinline)) RefMemCpy(u8 *Dst, const u8 *Src,
+		u32 Cnt)
+{
+	volatile u8 *D = Dst;
+	u32 Index;
+
+	for (Index = 0U; Index < Cnt; Index++) {
+		D[Index] = Src[Index];
+	}
+}
+
+static void __attribute__ ((noinline)) RefMemSet(u8 *Dst, u8 Val, u32 Cnt)
+{
+	volatile u8 *D = Dst;
+	u32 Index;
+
+	for (Index = 0U; Index < Cnt; Index++) {
+		D[Index] = Val;
+	}
+}
+
+static s32 __attribute__ ((noinline)) RefMemCmp(const u8 *Buf1,
+		const u8 *Buf2, u32 Cnt)
+{
+	const volatile u8 *A = Buf1;
+	u32 Index;
+
+	for (Index = 0U; Index < Cnt; Index++) {
+		if (A[Index] != Buf2[Index]) {
+			return (s32)A[Index] - (s32)Buf2[Index];
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,396 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+* @file xil_logbuf.c
+*
+* This file contains the deferred logging ring buffer used by xil_printf.
+* Refer xil_logbuf.h for the description of the buffer.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 7.1   ag       10/16/26 First release.
+*
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include <ctype.h>
+#include "xil_types.h"
+#include "xstatus.h"
+#include "xil_printf.h"
+#include "xil_logbuf.h"
+#if defined (__aarch64__) || defined (__arm__) || defined (__ICCARM__)
+#include "xpseudo_asm.h"
+#endif
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_LOG_PTR_WORDS	((u32)(sizeof(UINTPTR) / sizeof(u32)))
+/* Longest record: header, format pointer and XIL_LOG_MAX_ARGS arguments */
+#define XIL_LOG_MAX_REC_WORDS	(1U + ((1U + XIL_LOG_MAX_ARGS) * \
+					XIL_LOG_PTR_WORDS))
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/*
+ * The ring and its indices are accessed through volatile pointers, so the
+ * compiler keeps their order. The barrier orders them for the other
+ * observers on ARM; MicroBlaze completes data accesses in program order.
+ */
+#if defined (__aarch64__) || defined (__arm__) || defined (__ICCARM__)
+#define XIL_LOG_BARRIER()	dmb()
+#else
+#define XIL_LOG_BARRIER()
+#endif
+
+/************************** Variable Definitions ****************************/
+
+static XilLog *XilLogPtr = NULL;
+
+/************************** Function Prototypes *****************************/
+
+static u32 Xil_LogCountArgs(const char8 *Fmt);
+
+/****************************************************************************/
+/**
+* @brief	Returns the ring of a log buffer.
+*
+* @param	Log: pointer to the log control block
+*
+* @return	Pointer to the first ring word
+*
+*****************************************************************************/
+static inline volatile u32 *Xil_LogRing(XilLog *Log)
+{
+	return (volatile u32 *)(void *)(Log + 1);
+}
+
+/****************************************************************************/
+/**
+* @brief	Writes a pointer sized value to the ring.
+*
+* @param	Log: pointer to the log control block
+* @param	Index: free running word index of the first word
+* @param	Value: value to be written
+*
+* @return	None
+*
+*****************************************************************************/
+static inline void Xil_LogPut(XilLog *Log, u32 Index, UINTPTR Value)
+{
+	volatile u32 *Ring = Xil_LogRing(Log);
+	u32 Mask = Log->Size - 1U;
+	u32 Word;
+
+	for (Word = 0U; Word < XIL_LOG_PTR_WORDS; Word++) {
+		Ring[(Index + Word) & Mask] = (u32)Value;
+		Value = (UINTPTR)(((u64)Value) >> 32U);
+	}
+}
+
+/****************************************************************************/
+/**
+* @brief	Reads a pointer sized value from the ring.
+*
+* @param	Log: pointer to the log control block
+* @param	Index: free running word index of the first word
+*
+* @return	Value read
+*
+*****************************************************************************/
+static inline UINTPTR Xil_LogGetWord(XilLog *Log, u32 Index)
+{
+	volatile u32 *Ring = Xil_LogRing(Log);
+	u32 Mask = Log->Size - 1U;
+	u64 Value = 0U;
+	u32 Word;
+
+	for (Word = XIL_LOG_PTR_WORDS; Word > 0U; Word--) {
+		Value = (Value << 32U) | Ring[(Index + Word - 1U) & Mask];
+	}
+
+	return (UINTPTR)Value;
+}
+
+/****************************************************************************/
+/**
+* @brief	Counts the arguments consumed by a xil_printf format string,
+*		following the conversions which xil_printf supports.
+*
+* @param	Fmt: format string
+*
+* @return	Number of arguments
+*
+*****************************************************************************/
+static u32 Xil_LogCountArgs(const char8 *Fmt)
+{
+	const char8 *Ch = Fmt;
+	u32 Args = 0U;
+
+	while (*Ch != (char8)0) {
+		if (*Ch != '%') {
+			Ch++;
+			continue;
+		}
+		Ch++;
+		while ((isdigit((s32)*Ch) != 0) || (*Ch == '-') ||
+			(*Ch == '.') || (tolower((s32)*Ch) == 'l')) {
+			Ch++;
+		}
+		switch (tolower((s32)*Ch)) {
+		case 'd':
+		case 'i':
+		case 'u':
+		case 'x':
+		case 'p':
+		case 's':
+		case 'c':
+			Args++;
+			break;
+		default:
+			break;
+		}
+		if (*Ch != (char8)0) {
+			Ch++;
+		}
+	}
+
+	return Args;
+}
+
+/****************************************************************************/
+/**
+* @brief	Attaches a buffer to the deferred logging backend. From then
+*		on xil_printf stores its records in the buffer.
+*
+* @param	Buf: word aligned buffer
+* @param	Len: length of the buffer in bytes. The ring is the largest
+*		power of two number of words which fits after the control
+*		block.
+*
+* @return	None. Buffers too small for the longest record are ignored.
+*
+*****************************************************************************/
+void Xil_LogInit(void *Buf, u32 Len)
+{
+	XilLog *Log = (XilLog *)Buf;
+	u32 Words;
+	u32 Size = 1U;
+
+	if ((Buf == NULL) || (Len < sizeof(XilLog))) {
+		return;
+	}
+
+	Words = (Len - (u32)sizeof(XilLog)) / (u32)sizeof(u32);
+	while ((Size << 1U) <= Words) {
+		Size <<= 1U;
+	}
+	if (Size < XIL_LOG_MAX_REC_WORDS) {
+		return;
+	}
+
+	XilLogPtr = NULL;
+	Log->Size = Size;
+	Log->PtrWords = XIL_LOG_PTR_WORDS;
+	Log->Head = 0U;
+	Log->Tail = 0U;
+	Log->Records = 0U;
+	Log->Dropped = 0U;
+	Log->DropReported = 0U;
+	Log->Busy = 0U;
+	Log->Magic = XIL_LOG_MAGIC;
+	XIL_LOG_BARRIER();
+	XilLogPtr = Log;
+}
+
+/****************************************************************************/
+/**
+* @brief	Detaches the log buffer, so that xil_printf prints directly
+*		again. Records still in the buffer are not printed, call
+*		Xil_LogDrain before if they are needed.
+*
+* @return	None
+*
+*****************************************************************************/
+void Xil_LogDisable(void)
+{
+	XilLogPtr = NULL;
+}
+
+/****************************************************************************/
+/**
+* @brief	Stores a xil_printf call in the log buffer.
+*
+* @param	Fmt: format string
+* @param	ArgpPtr: pointer to the arguments of the call
+*
+* @return	XST_SUCCESS if the call was recorded or dropped,
+*		XST_FAILURE if it has to be printed directly because no
+*		buffer is attached, the buffer is in use or the format
+*		takes more than XIL_LOG_MAX_ARGS arguments.
+*
+*****************************************************************************/
+s32 Xil_LogRecord(const char8 *Fmt, va_list *ArgpPtr)
+{
+	XilLog *Log = XilLogPtr;
+	s32 Status = XST_FAILURE;
+	u32 Args;
+	u32 Words;
+	u32 Head;
+	u32 Index;
+
+	if ((Log == NULL) || (Fmt == NULL) || (Log->Busy != 0U)) {
+		goto END;
+	}
+
+	Args = Xil_LogCountArgs(Fmt);
+	if (Args > XIL_LOG_MAX_ARGS) {
+		goto END;
+	}
+
+	Log->Busy = 1U;
+	XIL_LOG_BARRIER();
+
+	Status = XST_SUCCESS;
+	Words = 1U + ((1U + Args) * XIL_LOG_PTR_WORDS);
+	Head = Log->Head;
+	if (Words > (Log->Size - (Head - Log->Tail))) {
+		Log->Dropped++;
+		goto DONE;
+	}
+
+	Xil_LogRing(Log)[Head & (Log->Size - 1U)] =
+			XIL_LOG_REC_HDR(Args, Words);
+	Index = Head + 1U;
+	Xil_LogPut(Log, Index, (UINTPTR)Fmt);
+	for (; Args > 0U; Args--) {
+		Index += XIL_LOG_PTR_WORDS;
+		Xil_LogPut(Log, Index, va_arg(*ArgpPtr, UINTPTR));
+	}
+
+	/* Publish the record after its contents */
+	XIL_LOG_BARRIER();
+	Log->Head = Head + Words;
+	Log->Records++;
+
+DONE:
+	XIL_LOG_BARRIER();
+	Log->Busy = 0U;
+END:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+* @brief	Prints records from the log buffer through xil_printf, followed
+*		by the number of records dropped since the last drain.
+*
+* @param	MaxRecords: maximum number of records to print, 0 for all
+*
+* @return	Number of words still pending in the buffer
+*
+*****************************************************************************/
+u32 Xil_LogDrain(u32 MaxRecords)
+{
+	XilLog *Log = XilLogPtr;
+	UINTPTR Arg[XIL_LOG_MAX_ARGS];
+	const char8 *Fmt;
+	u32 Count = 0U;
+	u32 Pending = 0U;
+	u32 Tail;
+	u32 Hdr;
+	u32 Index;
+	u32 Dropped;
+
+	if ((Log == NULL) || (Log->Busy != 0U)) {
+		goto END;
+	}
+
+	/* Makes the xil_printf calls below print directly */
+	Log->Busy = 1U;
+	XIL_LOG_BARRIER();
+
+	while ((Log->Tail != Log->Head) &&
+		((MaxRecords == 0U) || (Count < MaxRecords))) {
+		Tail = Log->Tail;
+		Hdr = Xil_LogRing(Log)[Tail & (Log->Size - 1U)];
+		if ((XIL_LOG_REC_MARK_OF(Hdr) != XIL_LOG_REC_MARK) ||
+			(XIL_LOG_REC_ARGS(Hdr) > XIL_LOG_MAX_ARGS)) {
+			xil_printf("xil_log: bad record, log discarded\r\n");
+			Log->Tail = Log->Head;
+			break;
+		}
+
+		Fmt = (const char8 *)Xil_LogGetWord(Log, Tail + 1U);
+		for (Index = 0U; Index < XIL_LOG_MAX_ARGS; Index++) {
+			Arg[Index] = 0U;
+			if (Index < XIL_LOG_REC_ARGS(Hdr)) {
+				Arg[Index] = Xil_LogGetWord(Log, Tail + 1U +
+					((Index + 1U) * XIL_LOG_PTR_WORDS));
+			}
+		}
+
+		/* Free the record before the slow output */
+		XIL_LOG_BARRIER();
+		Log->Tail = Tail + XIL_LOG_REC_WORDS(Hdr);
+
+		xil_printf(Fmt, Arg[0], Arg[1], Arg[2], Arg[3], Arg[4],
+				Arg[5], Arg[6], Arg[7]);
+		Count++;
+	}
+
+	Dropped = Log->Dropped;
+	if (Dropped != Log->DropReported) {
+		xil_printf("xil_log: %d records dropped\r\n",
+				Dropped - Log->DropReported);
+		Log->DropReported = Dropped;
+	}
+
+	Pending = Log->Head - Log->Tail;
+	XIL_LOG_BARRIER();
+	Log->Busy = 0U;
+END:
+	return Pending;
+}
+
+/****************************************************************************/
+/**
+* @brief	Returns the attached log buffer, for example to read its
+*		record and drop counters.
+*
+* @return	Pointer to the control block, NULL if no buffer is attached
+*
+*****************************************************************************/
+const XilLog *Xil_LogGet(void)
+{
+	return XilLogPtr;
+}
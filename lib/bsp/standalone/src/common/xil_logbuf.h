@@ -0,0 +1,118 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+* @file xil_logbuf.h
+*
+* @addtogroup common_logbuf_api Deferred xil_printf logging
+*
+* The xil_logbuf.h file contains the deferred logging backend of xil_printf.
+*
+* Once Xil_LogInit has been called with a buffer, xil_printf no longer
+* formats its output. It stores the format string pointer and the raw
+* argument words in a ring buffer and returns. The text is produced later
+* by Xil_LogDrain, which is meant to be called from an idle hook or a low
+* priority task, or offline by tools/xil_log_decode.c from a memory dump
+* of the buffer and the ELF of the application.
+*
+* The ring has a single producer and a single consumer and takes no locks.
+* xil_printf calls which would nest in a call already writing or draining
+* the ring, such as prints from interrupt handlers, are printed directly.
+* Records which do not fit in the ring are dropped and counted.
+*
+* Since only pointers are stored, strings passed for %s must still be
+* valid when the record is drained, as string literals are.
+*
+* @{
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 7.1   ag       10/16/26 First release.
+*
+* </pre>
+*
+*****************************************************************************/
+#ifndef XIL_LOGBUF_H		/* prevent circular inclusions */
+#define XIL_LOGBUF_H		/* by using protection macros */
+
+#include <stdarg.h>
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_LOG_MAGIC		0x474F4C58U	/* "XLOG" */
+#define XIL_LOG_REC_MARK	0xA5U		/* Record header marker */
+#define XIL_LOG_MAX_ARGS	8U		/* Arguments kept per record */
+
+/* Record header word: marker, number of arguments and length in words */
+#define XIL_LOG_REC_HDR(Args, Words) \
+		((XIL_LOG_REC_MARK << 24U) | ((u32)(Args) << 16U) | (u32)(Words))
+#define XIL_LOG_REC_MARK_OF(Hdr)	((Hdr) >> 24U)
+#define XIL_LOG_REC_ARGS(Hdr)		(((Hdr) >> 16U) & 0xFFU)
+#define XIL_LOG_REC_WORDS(Hdr)		((Hdr) & 0xFFFFU)
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Control block at the start of the log buffer, followed by the ring of
+ * Size words. Head and Tail are free running word counts. Each record is
+ * a header word followed by the format string pointer and the arguments,
+ * each of which takes PtrWords words.
+ */
+typedef struct {
+	u32 Magic;		/**< XIL_LOG_MAGIC once initialized */
+	u32 Size;		/**< Ring size in words, a power of two */
+	u32 PtrWords;		/**< Words per pointer and per argument */
+	volatile u32 Head;	/**< Words written, updated by the producer */
+	volatile u32 Tail;	/**< Words consumed, updated by the consumer */
+	volatile u32 Records;	/**< Records written */
+	volatile u32 Dropped;	/**< Records dropped as the ring was full */
+	volatile u32 DropReported; /**< Dropped count already printed */
+	volatile u32 Busy;	/**< Ring being written or drained */
+} XilLog;
+
+/************************** Function Prototypes *****************************/
+
+void Xil_LogInit(void *Buf, u32 Len);
+void Xil_LogDisable(void);
+s32 Xil_LogRecord(const char8 *Fmt, va_list *ArgpPtr);
+u32 Xil_LogDrain(u32 MaxRecords);
+const XilLog *Xil_LogGet(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XIL_LOGBUF_H */
+/**
+* @} End of "addtogroup common_logbuf_api".
+*/
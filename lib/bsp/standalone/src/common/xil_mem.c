@@ -27,8 +27,9 @@
 /**
 * @file xil_mem.c
 *
-* This file contains xil mem copy function to use in case of word aligned
-* data copies.
+* This file contains the xil mem copy, set and compare functions. They align
+* the buffers with a short byte head and then operate on 64-bit words, or on
+* 128-bit NEON registers on AArch64, before finishing with a byte tail.
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -36,6 +37,10 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
+* 7.1   ag       10/16/26 Added alignment fix-up, 64-bit and NEON bulk paths
+*                         to Xil_MemCpy and added Xil_MemSet and Xil_MemCmp.
+*       ag       10/16/26 Copy buffers with different alignment using shifted
+*                         32-bit words instead of bytes.
 *
 * </pre>
 *
@@ -44,12 +49,41 @@
 /***************************** Include Files ********************************/
 
 #include "xil_types.h"
+#include "xil_mem.h"
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define XIL_MEM_USE_NEON
+#endif
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_MEM_DWORD_MASK	((UINTPTR)sizeof(u64) - 1U)
+#define XIL_MEM_WORD_MASK	((UINTPTR)sizeof(u32) - 1U)
+#define XIL_MEM_NEON_BLOCK	64U	/* Bytes moved per NEON iteration */
+#define XIL_MEM_MIN_BULK	16U	/* Shorter buffers are handled bytewise */
+
+/* Merges two consecutive aligned words into the word at byte Shift / 8 */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define XIL_MEM_MERGE(Lo, Hi, Shift) \
+	(((Lo) << (Shift)) | ((Hi) >> (32U - (Shift))))
+#else
+#define XIL_MEM_MERGE(Lo, Hi, Shift) \
+	(((Lo) >> (Shift)) | ((Hi) << (32U - (Shift))))
+#endif
 
 /***************** Inline Functions Definitions ********************/
 /*****************************************************************************/
 /**
 * @brief       This  function copies memory from once location to other.
 *
+*              If source and destination share the same alignment modulo 8,
+*              a byte head aligns both and the bulk is moved with 64-bit
+*              accesses, or 128-bit NEON accesses on AArch64. If they only
+*              share 4 byte alignment, 32-bit accesses are used. Otherwise
+*              the destination is aligned and written with 32-bit stores
+*              of aligned source words merged by shifting, except on
+*              AArch64 where NEON byte loads have no alignment requirement.
+*
 * @param       dst: pointer pointing to destination memory
 *
 * @param       src: pointer pointing to source memory
@@ -59,21 +93,116 @@
 *****************************************************************************/
 void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 {
-	char *d = (char*)(void *)dst;
-	const char *s = src;
-
-	while (cnt >= sizeof (int)) {
-		*(int*)d = *(int*)s;
-		d += sizeof (int);
-		s += sizeof (int);
-		cnt -= sizeof (int);
-	}
-	while (cnt >= sizeof (u16)) {
-		*(u16*)d = *(u16*)s;
-		d += sizeof (u16);
-		s += sizeof (u16);
-		cnt -= sizeof (u16);
+	u8 *d = (u8 *)dst;
+	const u8 *s = (const u8 *)src;
+	UINTPTR Diff = ((UINTPTR)d ^ (UINTPTR)s);
+
+	if (cnt >= XIL_MEM_MIN_BULK) {
+		if ((Diff & XIL_MEM_DWORD_MASK) == 0U) {
+			while (((UINTPTR)d & XIL_MEM_DWORD_MASK) != 0U) {
+				*d = *s;
+				d += 1U;
+				s += 1U;
+				cnt -= 1U;
+			}
+#ifdef XIL_MEM_USE_NEON
+			while (cnt >= XIL_MEM_NEON_BLOCK) {
+				uint8x16_t v0 = vld1q_u8(s);
+				uint8x16_t v1 = vld1q_u8(s + 16U);
+				uint8x16_t v2 = vld1q_u8(s + 32U);
+				uint8x16_t v3 = vld1q_u8(s + 48U);
+				vst1q_u8(d, v0);
+				vst1q_u8(d + 16U, v1);
+				vst1q_u8(d + 32U, v2);
+				vst1q_u8(d + 48U, v3);
+				d += XIL_MEM_NEON_BLOCK;
+				s += XIL_MEM_NEON_BLOCK;
+				cnt -= XIL_MEM_NEON_BLOCK;
+			}
+#endif
+			while (cnt >= (4U * sizeof (u64))) {
+				u64 w0 = ((const u64 *)(const void *)s)[0];
+				u64 w1 = ((const u64 *)(const void *)s)[1];
+				u64 w2 = ((const u64 *)(const void *)s)[2];
+				u64 w3 = ((const u64 *)(const void *)s)[3];
+				((u64 *)(void *)d)[0] = w0;
+				((u64 *)(void *)d)[1] = w1;
+				((u64 *)(void *)d)[2] = w2;
+				((u64 *)(void *)d)[3] = w3;
+				d += 4U * sizeof (u64);
+				s += 4U * sizeof (u64);
+				cnt -= 4U * sizeof (u64);
+			}
+			while (cnt >= sizeof (u64)) {
+				*(u64 *)(void *)d = *(const u64 *)(const void *)s;
+				d += sizeof (u64);
+				s += sizeof (u64);
+				cnt -= sizeof (u64);
+			}
+		} else if ((Diff & XIL_MEM_WORD_MASK) == 0U) {
+			while (((UINTPTR)d & XIL_MEM_WORD_MASK) != 0U) {
+				*d = *s;
+				d += 1U;
+				s += 1U;
+				cnt -= 1U;
+			}
+			while (cnt >= sizeof (u32)) {
+				*(u32 *)(void *)d = *(const u32 *)(const void *)s;
+				d += sizeof (u32);
+				s += sizeof (u32);
+				cnt -= sizeof (u32);
+			}
+		} else {
+#ifdef XIL_MEM_USE_NEON
+			while (cnt >= XIL_MEM_NEON_BLOCK) {
+				uint8x16_t v0 = vld1q_u8(s);
+				uint8x16_t v1 = vld1q_u8(s + 16U);
+				uint8x16_t v2 = vld1q_u8(s + 32U);
+				uint8x16_t v3 = vld1q_u8(s + 48U);
+				vst1q_u8(d, v0);
+				vst1q_u8(d + 16U, v1);
+				vst1q_u8(d + 32U, v2);
+				vst1q_u8(d + 48U, v3);
+				d += XIL_MEM_NEON_BLOCK;
+				s += XIL_MEM_NEON_BLOCK;
+				cnt -= XIL_MEM_NEON_BLOCK;
+			}
+#else
+			u32 *dw;
+			const u32 *sw;
+			u32 Lo;
+			u32 Hi;
+			u32 Shift;
+
+			while (((UINTPTR)d & XIL_MEM_WORD_MASK) != 0U) {
+				*d = *s;
+				d += 1U;
+				s += 1U;
+				cnt -= 1U;
+			}
+			/*
+			 * Only whole aligned source words are read, and each
+			 * holds at least one byte of the source buffer.
+			 */
+			Shift = (u32)((UINTPTR)s & XIL_MEM_WORD_MASK) * 8U;
+			dw = (u32 *)(void *)d;
+			sw = (const u32 *)(const void *)(s - (Shift / 8U));
+			Lo = *sw;
+			sw++;
+			while (cnt >= sizeof (u32)) {
+				Hi = *sw;
+				sw++;
+				*dw = XIL_MEM_MERGE(Lo, Hi, Shift);
+				Lo = Hi;
+				dw++;
+				s += sizeof (u32);
+				cnt -= sizeof (u32);
+			}
+			d = (u8 *)(void *)dw;
+#endif
+		}
 	}
+
 	while ((cnt) > 0U){
 		*d = *s;
 		d += 1U;
@@ -81,3 +210,120 @@ void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 		cnt -= 1U;
 	}
 }
+
+/*****************************************************************************/
+/**
+* @brief       This function fills memory with a constant byte. The
+*              destination is aligned with a byte head and then filled with
+*              64-bit stores, or 128-bit NEON stores on AArch64.
+*
+* @param       dst: pointer pointing to destination memory
+*
+* @param       val: value to be stored; only its low byte is used
+*
+* @param       cnt: 32 bit length of bytes to be set
+*
+*****************************************************************************/
+void Xil_MemSet(void* dst, s32 val, u32 cnt)
+{
+	u8 *d = (u8 *)dst;
+	u8 b = (u8)val;
+	u64 w;
+
+	if (cnt >= XIL_MEM_MIN_BULK) {
+		while (((UINTPTR)d & XIL_MEM_DWORD_MASK) != 0U) {
+			*d = b;
+			d += 1U;
+			cnt -= 1U;
+		}
+#ifdef XIL_MEM_USE_NEON
+		{
+			uint8x16_t v = vdupq_n_u8(b);
+			while (cnt >= XIL_MEM_NEON_BLOCK) {
+				vst1q_u8(d, v);
+				vst1q_u8(d + 16U, v);
+				vst1q_u8(d + 32U, v);
+				vst1q_u8(d + 48U, v);
+				d += XIL_MEM_NEON_BLOCK;
+				cnt -= XIL_MEM_NEON_BLOCK;
+			}
+		}
+#endif
+		w = (u64)b * 0x0101010101010101U;
+		while (cnt >= (4U * sizeof (u64))) {
+			((u64 *)(void *)d)[0] = w;
+			((u64 *)(void *)d)[1] = w;
+			((u64 *)(void *)d)[2] = w;
+			((u64 *)(void *)d)[3] = w;
+			d += 4U * sizeof (u64);
+			cnt -= 4U * sizeof (u64);
+		}
+		while (cnt >= sizeof (u64)) {
+			*(u64 *)(void *)d = w;
+			d += sizeof (u64);
+			cnt -= sizeof (u64);
+		}
+	}
+
+	while (cnt > 0U) {
+		*d = b;
+		d += 1U;
+		cnt -= 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief       This function compares two memory regions. When both share
+*              the same alignment modulo 8 they are compared a 64-bit word
+*              at a time, and only a differing word is scanned bytewise.
+*
+* @param       buf1: pointer pointing to the first memory region
+*
+* @param       buf2: pointer pointing to the second memory region
+*
+* @param       cnt: 32 bit length of bytes to be compared
+*
+* @return      0 if the regions are equal, otherwise the difference between
+*              the first differing bytes of buf1 and buf2, interpreted as
+*              unsigned.
+*
+*****************************************************************************/
+s32 Xil_MemCmp(const void* buf1, const void* buf2, u32 cnt)
+{
+	const u8 *a = (const u8 *)buf1;
+	const u8 *b = (const u8 *)buf2;
+	s32 Result = 0;
+
+	if ((cnt >= XIL_MEM_MIN_BULK) &&
+		((((UINTPTR)a ^ (UINTPTR)b) & XIL_MEM_DWORD_MASK) == 0U)) {
+		while ((((UINTPTR)a & XIL_MEM_DWORD_MASK) != 0U) &&
+				(*a == *b)) {
+			a += 1U;
+			b += 1U;
+			cnt -= 1U;
+		}
+		if (((UINTPTR)a & XIL_MEM_DWORD_MASK) == 0U) {
+			while ((cnt >= sizeof (u64)) &&
+				(*(const u64 *)(const void *)a ==
+					*(const u64 *)(const void *)b)) {
+				a += sizeof (u64);
+				b += sizeof (u64);
+				cnt -= sizeof (u64);
+			}
+		}
+	}
+
+	/* Finds the first differing byte, if any */
+	while ((cnt > 0U) && (*a == *b)) {
+		a += 1U;
+		b += 1U;
+		cnt -= 1U;
+	}
+
+	if (cnt > 0U) {
+		Result = (s32)*a - (s32)*b;
+	}
+
+	return Result;
+}
@@ -41,6 +41,7 @@
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
 * 7.0   mus      01/07/19 Add cpp extern macro
+* 7.1   ag       10/16/26 Added Xil_MemSet and Xil_MemCmp
 *
 * </pre>
 *
@@ -48,6 +49,8 @@
 #ifndef XIL_MEM_H		/* prevent circular inclusions */
 #define XIL_MEM_H		/* by using protection macros */
 
+#include "xil_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -55,6 +58,8 @@ extern "C" {
 /************************** Function Prototypes *****************************/
 
 void Xil_MemCpy(void* dst, const void* src, u32 cnt);
+void Xil_MemSet(void* dst, s32 val, u32 cnt);
+s32 Xil_MemCmp(const void* buf1, const void* buf2, u32 cnt);
 
 #ifdef __cplusplus
 }
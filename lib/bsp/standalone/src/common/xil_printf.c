@@ -8,6 +8,8 @@
 #include "xil_printf.h"
 #include "xil_types.h"
 #include "xil_assert.h"
+#include "xil_logbuf.h"
+#include "xstatus.h"
 #include <ctype.h>
 #include <string.h>
 #include <stdarg.h>
@@ -260,6 +262,12 @@ void xil_printf( const char8 *ctrl1, ...)
 
     va_start( argp, ctrl1);
 
+    /* Only record the call if a deferred log buffer is attached */
+    if (Xil_LogRecord(ctrl1, &argp) == (s32)XST_SUCCESS) {
+        va_end( argp);
+        return;
+    }
+
     while ((ctrl != NULL) && (*ctrl != (char8)0)) {
 
         /* move format string chars to buffer until a  */
@@ -0,0 +1,314 @@
+/******************************************************************************
+* Copyright (C) 2026 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file logbuf_test.c
+*
+* Host test of the deferred xil_printf log buffer (common/xil_logbuf.c).
+* xil_printf.c and xil_logbuf.c are built for the host with outbyte()
+* writing to a capture buffer. The test checks
+* - that the text printed by Xil_LogDrain is the same as that of the
+*   direct xil_printf calls, and that nothing is printed before,
+* - that the records which do not fit are dropped, counted and reported
+*   once by the next drain,
+* - that records wrapping around the end of the ring are drained intact,
+* - that calls made while the ring is busy, as from an interrupt handler
+*   during a write or drain, are printed directly.
+*
+* Usage: logbuf_test [<dump> <expected>]
+*
+* With a dump file, the calls of the first check are recorded and not
+* drained. The log buffer is written to <dump> and the text of the direct
+* calls to <expected>, so that tools/xil_log_decode can be checked against
+* this executable (see the Makefile).
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <string.h>
+#include "xil_printf.h"
+#include "xil_logbuf.h"
+
+/************************** Constant Definitions *****************************/
+
+#define TEST_OUT_LEN		(16384U)
+#define TEST_BUF_WORDS		(1024U)
+#define TEST_SMALL_WORDS	(64U)	/**< Ring of the drop and wrap checks */
+#define TEST_WRAP_ROUNDS	(1000U)
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CHECK(Cond)	Test_Check((Cond) ? 1U : 0U, #Cond, __LINE__)
+
+/************************** Variable Definitions *****************************/
+
+static u32 Failures;
+static char Out[TEST_OUT_LEN];
+static u32 OutLen;
+static char Expected[TEST_OUT_LEN];
+static u32 LogBuf[(sizeof(XilLog) / sizeof(u32)) + TEST_BUF_WORDS];
+
+/*****************************************************************************/
+/**
+* Output of xil_printf: appended to the capture buffer.
+******************************************************************************/
+void outbyte(char8 c)
+{
+	if (OutLen < (TEST_OUT_LEN - 1U)) {
+		Out[OutLen++] = c;
+		Out[OutLen] = '\0';
+	}
+}
+
+static void Test_Check(u32 Ok, const char *Cond, int Line)
+{
+	if (Ok == 0U) {
+		printf("  FAIL line %d: %s\n", Line, Cond);
+		Failures++;
+	}
+}
+
+static void Test_ClearOut(void)
+{
+	OutLen = 0U;
+	Out[0] = '\0';
+}
+
+/*****************************************************************************/
+/**
+* The calls of the comparison, with 0 to XIL_LOG_MAX_ARGS arguments and
+* the conversions and flags xil_printf supports.
+******************************************************************************/
+static void Test_Emit(void)
+{
+	xil_printf("PLM booting\r\n");
+	xil_printf("%d %u %x\r\n", -42, 42U, 0xBEEFU);
+	xil_printf("[%08x] %s: %-6d|\r\n", 0x1234U, "PMC", 7);
+	xil_printf("%c%c%c %5s %-5s|\r\n", 'a', 'b', 'c', "ab", "cd");
+	xil_printf("%d%%\r\n", 99);
+	xil_printf("%x %x %x %x %x %x %x %x\r\n", 1U, 2U, 3U, 4U, 5U, 6U,
+			7U, 0xFFFFFFFFU);
+	xil_printf("CDO 0x%x, Len %d, %s\r\n", 0x20103U, 3, "done");
+}
+
+/*****************************************************************************/
+/**
+* One call of the wrap-around check, with a number of arguments and so a
+* record length which depends on Index.
+******************************************************************************/
+static void Test_EmitRound(u32 Index)
+{
+	switch (Index % 4U) {
+	case 0U:
+		xil_printf("round\r\n");
+		break;
+	case 1U:
+		xil_printf("round %d\r\n", Index);
+		break;
+	case 2U:
+		xil_printf("round %d %x %s\r\n", Index, Index * 3U, "x");
+		break;
+	default:
+		xil_printf("round %d %d %d %d %d\r\n", Index, Index + 1U,
+			Index + 2U, Index + 3U, Index + 4U);
+		break;
+	}
+}
+
+/*****************************************************************************/
+/**
+* Drained text equals the text of the direct calls.
+******************************************************************************/
+static void Test_Drain(void)
+{
+	const XilLog *Log;
+
+	printf("drained output matches direct printing\n");
+	Xil_LogDisable();
+	Test_ClearOut();
+	Test_Emit();
+	(void)strcpy(Expected, Out);
+	CHECK(OutLen != 0U);
+
+	Xil_LogInit(LogBuf, (u32)sizeof(LogBuf));
+	Log = Xil_LogGet();
+	CHECK(Log != NULL);
+	Test_ClearOut();
+	Test_Emit();
+	CHECK(OutLen == 0U);
+	CHECK(Log->Records == 7U);
+
+	/* Partial drain, then the rest */
+	CHECK(Xil_LogDrain(3U) != 0U);
+	CHECK(Xil_LogDrain(0U) == 0U);
+	CHECK(strcmp(Out, Expected) == 0);
+	CHECK(Log->Dropped == 0U);
+	Xil_LogDisable();
+}
+
+/*****************************************************************************/
+/**
+* A full ring drops records; the count is printed once after the records.
+******************************************************************************/
+static void Test_Drop(void)
+{
+	const XilLog *Log;
+	char Line[64];
+	u32 Index;
+
+	printf("dropped records are counted\n");
+	Xil_LogInit(LogBuf, (u32)(sizeof(XilLog) +
+			(TEST_SMALL_WORDS * sizeof(u32))));
+	Log = Xil_LogGet();
+	CHECK(Log->Size == TEST_SMALL_WORDS);
+
+	/* Each record takes 1 + 3 * PtrWords words */
+	Test_ClearOut();
+	for (Index = 0U; Index < 40U; Index++) {
+		xil_printf("drop %d %d\r\n", Index, Index);
+	}
+	CHECK(OutLen == 0U);
+	CHECK(Log->Records == (TEST_SMALL_WORDS / (1U + (3U * Log->PtrWords))));
+	CHECK((Log->Records + Log->Dropped) == 40U);
+
+	Expected[0] = '\0';
+	for (Index = 0U; Index < Log->Records; Index++) {
+		(void)snprintf(Line, sizeof(Line), "drop %u %u\r\n", Index,
+				Index);
+		(void)strcat(Expected, Line);
+	}
+	(void)snprintf(Line, sizeof(Line), "xil_log: %u records dropped\r\n",
+			Log->Dropped);
+	(void)strcat(Expected, Line);
+
+	CHECK(Xil_LogDrain(0U) == 0U);
+	CHECK(strcmp(Out, Expected) == 0);
+	CHECK(Log->DropReported == Log->Dropped);
+
+	/* Reported only once */
+	Test_ClearOut();
+	CHECK(Xil_LogDrain(0U) == 0U);
+	CHECK(OutLen == 0U);
+	Xil_LogDisable();
+}
+
+/*****************************************************************************/
+/**
+* Records of varying length written and drained in rounds, so that records
+* straddle the end of the ring many times.
+******************************************************************************/
+static void Test_Wrap(void)
+{
+	XilLog *Log = (XilLog *)(void *)LogBuf;
+	u32 Index;
+	u32 Ok = 1U;
+
+	printf("records wrap around the ring\n");
+	Xil_LogInit(LogBuf, (u32)(sizeof(XilLog) +
+			(TEST_SMALL_WORDS * sizeof(u32))));
+	CHECK(Xil_LogGet() == Log);
+
+	for (Index = 0U; Index < TEST_WRAP_ROUNDS; Index += 3U) {
+		/* Busy ring: the calls are printed directly */
+		Log->Busy = 1U;
+		Test_ClearOut();
+		Test_EmitRound(Index);
+		Test_EmitRound(Index + 1U);
+		Test_EmitRound(Index + 2U);
+		(void)strcpy(Expected, Out);
+		Log->Busy = 0U;
+		if (Log->Head != Log->Tail) {
+			Ok = 0U;
+		}
+
+		Test_ClearOut();
+		Test_EmitRound(Index);
+		Test_EmitRound(Index + 1U);
+		Test_EmitRound(Index + 2U);
+		if ((OutLen != 0U) || (Xil_LogDrain(0U) != 0U) ||
+				(strcmp(Out, Expected) != 0)) {
+			Ok = 0U;
+		}
+	}
+	CHECK(Ok == 1U);
+	CHECK(Log->Dropped == 0U);
+	CHECK(Log->Head > (10U * Log->Size));
+	Xil_LogDisable();
+}
+
+/*****************************************************************************/
+/**
+* Records the calls of the comparison and writes the log buffer and the
+* text of the direct calls to files, for the decoder check.
+******************************************************************************/
+static int Test_Dump(const char *DumpName, const char *ExpectedName)
+{
+	const XilLog *Log;
+	FILE *Fp;
+	size_t Len;
+
+	Xil_LogDisable();
+	Test_ClearOut();
+	Test_Emit();
+	Fp = fopen(ExpectedName, "wb");
+	if (Fp == NULL) {
+		return 1;
+	}
+	(void)fwrite(Out, 1U, OutLen, Fp);
+	(void)fclose(Fp);
+
+	Xil_LogInit(LogBuf, (u32)sizeof(LogBuf));
+	Log = Xil_LogGet();
+	Test_Emit();
+	Len = sizeof(XilLog) + ((size_t)Log->Size * sizeof(u32));
+	Fp = fopen(DumpName, "wb");
+	if (Fp == NULL) {
+		return 1;
+	}
+	(void)fwrite(LogBuf, 1U, Len, Fp);
+	(void)fclose(Fp);
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc == 3) {
+		return Test_Dump(argv[1], argv[2]);
+	}
+
+	Test_Drain();
+	Test_Drop();
+	Test_Wrap();
+
+	if (Failures != 0U) {
+		printf("logbuf_test: %u check(s) failed\n", Failures);
+		return 1;
+	}
+	printf("logbuf_test: all checks passed\n");
+	return 0;
+}
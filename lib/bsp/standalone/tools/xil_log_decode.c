@@ -0,0 +1,382 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+* @file xil_log_decode.c
+*
+* Host utility which prints the records pending in a deferred xil_printf log
+* buffer (refer common/xil_logbuf.h) from a memory dump of the buffer. The
+* format strings and %s arguments are read from the ELF of the application
+* which wrote the log.
+*
+* Build and run on the host:
+*	gcc -O2 -o xil_log_decode xil_log_decode.c
+*	xil_log_decode <app.elf> <dump.bin> [offset]
+*
+* The dump is a raw binary copy of memory starting at the log control block,
+* or at <offset> bytes before it, and must include the whole ring. For
+* example, with XSDB:
+*	mrd -bin -file dump.bin <buffer address> <buffer length in words>
+*
+* Only the records which were not drained yet are printed, followed by the
+* record and drop counters of the buffer.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 7.1   ag       10/16/26 First release.
+*
+* </pre>
+*
+*****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+
+/* Keep in sync with common/xil_logbuf.h */
+#define XIL_LOG_MAGIC		0x474F4C58U
+#define XIL_LOG_REC_MARK	0xA5U
+#define XIL_LOG_MAX_ARGS	8U
+#define XIL_LOG_HDR_WORDS	9U
+
+#define SHF_ALLOC		0x2U
+#define SHT_NOBITS		8U
+
+typedef struct {
+	uint64_t Addr;
+	uint64_t Size;
+	uint64_t Offset;
+} Section;
+
+static uint8_t *Elf;
+static size_t ElfLen;
+static int BigEndian;
+static Section *Sections;
+static unsigned NumSections;
+
+static uint8_t *ReadFile(const char *Name, size_t *Len)
+{
+	FILE *Fp = fopen(Name, "rb");
+	uint8_t *Buf;
+	long Size;
+
+	if (Fp == NULL) {
+		perror(Name);
+		exit(1);
+	}
+	fseek(Fp, 0, SEEK_END);
+	Size = ftell(Fp);
+	fseek(Fp, 0, SEEK_SET);
+	Buf = malloc((size_t)Size + 1U);
+	if ((Buf == NULL) || (fread(Buf, 1U, (size_t)Size, Fp) != (size_t)Size)) {
+		fprintf(stderr, "%s: read failed\n", Name);
+		exit(1);
+	}
+	fclose(Fp);
+	*Len = (size_t)Size;
+
+	return Buf;
+}
+
+static uint64_t Get(const uint8_t *P, unsigned Bytes)
+{
+	uint64_t Value = 0U;
+	unsigned Index;
+
+	for (Index = 0U; Index < Bytes; Index++) {
+		if (BigEndian != 0) {
+			Value = (Value << 8U) | P[Index];
+		} else {
+			Value |= (uint64_t)P[Index] << (8U * Index);
+		}
+	}
+
+	return Value;
+}
+
+static void ParseElf(void)
+{
+	int Is64;
+	uint64_t ShOff;
+	unsigned ShEntSize;
+	unsigned Index;
+	const uint8_t *Sh;
+
+	if ((ElfLen < 52U) || (memcmp(Elf, "\177ELF", 4U) != 0)) {
+		fprintf(stderr, "not an ELF file\n");
+		exit(1);
+	}
+	Is64 = (Elf[4] == 2U);
+	BigEndian = (Elf[5] == 2U);
+	if (Is64 != 0) {
+		ShOff = Get(&Elf[0x28], 8U);
+		ShEntSize = (unsigned)Get(&Elf[0x3A], 2U);
+		NumSections = (unsigned)Get(&Elf[0x3C], 2U);
+	} else {
+		ShOff = Get(&Elf[0x20], 4U);
+		ShEntSize = (unsigned)Get(&Elf[0x2E], 2U);
+		NumSections = (unsigned)Get(&Elf[0x30], 2U);
+	}
+	if ((ShOff + ((uint64_t)ShEntSize * NumSections)) > ElfLen) {
+		fprintf(stderr, "truncated ELF file\n");
+		exit(1);
+	}
+
+	Sections = calloc(NumSections + 1U, sizeof(Section));
+	for (Index = 0U; Index < NumSections; Index++) {
+		Sh = &Elf[ShOff + ((uint64_t)Index * ShEntSize)];
+		if (Is64 != 0) {
+			if (((Get(&Sh[0x08], 8U) & SHF_ALLOC) == 0U) ||
+				(Get(&Sh[0x04], 4U) == SHT_NOBITS)) {
+				continue;
+			}
+			Sections[Index].Addr = Get(&Sh[0x10], 8U);
+			Sections[Index].Offset = Get(&Sh[0x18], 8U);
+			Sections[Index].Size = Get(&Sh[0x20], 8U);
+		} else {
+			if (((Get(&Sh[0x08], 4U) & SHF_ALLOC) == 0U) ||
+				(Get(&Sh[0x04], 4U) == SHT_NOBITS)) {
+				continue;
+			}
+			Sections[Index].Addr = Get(&Sh[0x0C], 4U);
+			Sections[Index].Offset = Get(&Sh[0x10], 4U);
+			Sections[Index].Size = Get(&Sh[0x14], 4U);
+		}
+	}
+}
+
+/* Returns the NUL terminated string at Addr in the ELF image, or NULL */
+static const char *ElfString(uint64_t Addr)
+{
+	unsigned Index;
+	const Section *Sec;
+	uint64_t Pos;
+
+	for (Index = 0U; Index < NumSections; Index++) {
+		Sec = &Sections[Index];
+		if ((Sec->Size == 0U) || (Addr < Sec->Addr) ||
+			(Addr >= (Sec->Addr + Sec->Size)) ||
+			((Sec->Offset + Sec->Size) > ElfLen)) {
+			continue;
+		}
+		for (Pos = Addr; Pos < (Sec->Addr + Sec->Size); Pos++) {
+			if (Elf[Sec->Offset + (Pos - Sec->Addr)] == 0U) {
+				return (const char *)
+					&Elf[Sec->Offset + (Addr - Sec->Addr)];
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/* Prints one record the way xil_printf formats it */
+static void PrintRecord(const char *Fmt, const uint64_t *Arg, unsigned Args,
+			unsigned PtrWords)
+{
+	char Spec[32];
+	unsigned Len;
+	unsigned Next = 0U;
+	int Long;
+	int Conv;
+	const char *Str;
+	int64_t Signed;
+
+	while (*Fmt != '\0') {
+		if (*Fmt != '%') {
+			putchar(*Fmt++);
+			continue;
+		}
+
+		Len = 0U;
+		Long = 0;
+		Spec[Len++] = *Fmt++;
+		while ((isdigit((unsigned char)*Fmt) != 0) || (*Fmt == '-') ||
+			(*Fmt == '.') || (tolower((unsigned char)*Fmt) == 'l')) {
+			if (tolower((unsigned char)*Fmt) == 'l') {
+				Long = 1;
+			} else if (Len < (sizeof(Spec) - 4U)) {
+				Spec[Len++] = *Fmt;
+			}
+			Fmt++;
+		}
+		Conv = tolower((unsigned char)*Fmt);
+		if (*Fmt != '\0') {
+			Fmt++;
+		}
+
+		if (Conv == '%') {
+			putchar('%');
+			continue;
+		}
+		if (strchr("diuxpsc", Conv) == NULL) {
+			continue;
+		}
+		if (Next >= Args) {
+			printf("<missing>");
+			continue;
+		}
+
+		/* 64-bit values exist for %l and %p on AArch64 only */
+		if ((Long == 0) || (PtrWords == 1U)) {
+			if ((Conv != 'p') || (PtrWords == 1U)) {
+				Signed = (int32_t)Arg[Next];
+			} else {
+				Signed = (int64_t)Arg[Next];
+			}
+		} else {
+			Signed = (int64_t)Arg[Next];
+		}
+
+		switch (Conv) {
+		case 'd':
+		case 'i':
+			strcpy(&Spec[Len], "lld");
+			printf(Spec, (long long)Signed);
+			break;
+		case 'u':
+			strcpy(&Spec[Len], "llu");
+			printf(Spec, (unsigned long long)(((Long == 0) ||
+				(PtrWords == 1U)) ? (uint32_t)Signed :
+				(uint64_t)Signed));
+			break;
+		case 'x':
+		case 'p':
+			strcpy(&Spec[Len], "llX");
+			printf(Spec, (unsigned long long)
+				((((Long == 0) && (Conv != 'p')) ||
+				(PtrWords == 1U)) ? (uint32_t)Signed :
+				(uint64_t)Signed));
+			break;
+		case 's':
+			Str = ElfString(Arg[Next]);
+			if (Str != NULL) {
+				strcpy(&Spec[Len], "s");
+				printf(Spec, Str);
+			} else {
+				printf("<0x%llX>", (unsigned long long)Arg[Next]);
+			}
+			break;
+		default:
+			putchar((int)(Arg[Next] & 0xFFU));
+			break;
+		}
+		Next++;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	uint8_t *Dump;
+	size_t DumpLen;
+	size_t Offset = 0U;
+	const uint8_t *Hdr;
+	const uint8_t *Ring;
+	uint32_t Size, PtrWords, Head, Tail, Records, Dropped, DropReported;
+	uint32_t Word, Rec, Words, Args, Index, Part;
+	uint64_t Value[1U + XIL_LOG_MAX_ARGS];
+	uint32_t Pending = 0U;
+	const char *Fmt;
+
+	if ((argc != 3) && (argc != 4)) {
+		fprintf(stderr, "usage: %s <app.elf> <dump.bin> [offset]\n",
+			argv[0]);
+		return 1;
+	}
+
+	Elf = ReadFile(argv[1], &ElfLen);
+	ParseElf();
+	Dump = ReadFile(argv[2], &DumpLen);
+	if (argc == 4) {
+		Offset = (size_t)strtoul(argv[3], NULL, 0);
+	}
+
+	if ((Offset + (XIL_LOG_HDR_WORDS * 4U)) > DumpLen) {
+		fprintf(stderr, "dump too short\n");
+		return 1;
+	}
+	Hdr = &Dump[Offset];
+	if (Get(&Hdr[0], 4U) != XIL_LOG_MAGIC) {
+		fprintf(stderr, "no log buffer at offset 0x%zx\n", Offset);
+		return 1;
+	}
+	Size = (uint32_t)Get(&Hdr[4], 4U);
+	PtrWords = (uint32_t)Get(&Hdr[8], 4U);
+	Head = (uint32_t)Get(&Hdr[12], 4U);
+	Tail = (uint32_t)Get(&Hdr[16], 4U);
+	Records = (uint32_t)Get(&Hdr[20], 4U);
+	Dropped = (uint32_t)Get(&Hdr[24], 4U);
+	DropReported = (uint32_t)Get(&Hdr[28], 4U);
+	Ring = &Hdr[XIL_LOG_HDR_WORDS * 4U];
+	if ((Size == 0U) || ((Size & (Size - 1U)) != 0U) ||
+		((PtrWords != 1U) && (PtrWords != 2U)) ||
+		((Offset + ((XIL_LOG_HDR_WORDS + (size_t)Size) * 4U)) > DumpLen) ||
+		((Head - Tail) > Size)) {
+		fprintf(stderr, "inconsistent log buffer\n");
+		return 1;
+	}
+
+	while (Tail != Head) {
+		Rec = (uint32_t)Get(&Ring[(Tail & (Size - 1U)) * 4U], 4U);
+		Words = Rec & 0xFFFFU;
+		Args = (Rec >> 16U) & 0xFFU;
+		if (((Rec >> 24U) != XIL_LOG_REC_MARK) ||
+			(Args > XIL_LOG_MAX_ARGS) ||
+			(Words != (1U + ((1U + Args) * PtrWords))) ||
+			(Words > (Head - Tail))) {
+			fprintf(stderr, "bad record at word %u\n", Tail);
+			return 1;
+		}
+		for (Index = 0U; Index <= Args; Index++) {
+			Value[Index] = 0U;
+			for (Part = 0U; Part < PtrWords; Part++) {
+				Word = Tail + 1U + (Index * PtrWords) + Part;
+				Value[Index] |= Get(&Ring[(Word & (Size - 1U))
+					* 4U], 4U) << (32U * Part);
+			}
+		}
+		Fmt = ElfString(Value[0]);
+		if (Fmt != NULL) {
+			PrintRecord(Fmt, &Value[1], Args, PtrWords);
+		} else {
+			printf("<format 0x%llX not in ELF>\n",
+				(unsigned long long)Value[0]);
+		}
+		Tail += Words;
+		Pending++;
+	}
+
+	fprintf(stderr, "%u records pending, %u written, %u dropped "
+		"(%u not yet reported)\n", Pending, Records, Dropped,
+		Dropped - DropReported);
+
+	return 0;
+}
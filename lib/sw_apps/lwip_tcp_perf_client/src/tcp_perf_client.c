@@ -34,6 +34,24 @@ static struct tcp_pcb *c_pcb;
 static char send_buf[TCP_SEND_BUFSIZE];
 static struct perf_stats client;
 
+/* Print the TX settings which the measured bandwidth depends on */
+static void print_tx_config(void)
+{
+#if defined (__MICROBLAZE__) || TCP_ZERO_COPY_TX
+	xil_printf("TX payload: by reference\r\n");
+#else
+	xil_printf("TX payload: copied\r\n");
+#endif
+#if defined (XLWIP_CONFIG_AXI_TX_REAP_LOWAT)
+	xil_printf("AXI Ethernet TX reap low water mark: %d\r\n",
+			XLWIP_CONFIG_AXI_TX_REAP_LOWAT);
+#endif
+#if defined (XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA) && \
+	defined (XLWIP_CONFIG_AXI_DMA_TX_COHERENT)
+	xil_printf("AXI DMA TX coherent\r\n");
+#endif
+}
+
 void print_app_header()
 {
 #if LWIP_IPV6==1
@@ -47,6 +65,7 @@ void print_app_header()
 	xil_printf("On Host: Run $iperf -s -i %d -w 2M\r\n",
 			INTERIM_REPORT_INTERVAL);
 #endif /* LWIP_IPV6 */
+	print_tx_config();
 }
 
 static void print_tcp_conn_stats()
@@ -171,7 +190,10 @@ static err_t tcp_send_perf_traffic(void)
 		return ERR_CONN;
 	}
 
-#ifdef __MICROBLAZE__
+#if TCP_ZERO_COPY_TX
+	/* Zero-copy TX path under measurement, on all processors */
+	apiflags = TCP_WRITE_FLAG_MORE;
+#elif defined (__MICROBLAZE__)
 	/* Zero-copy pbufs is used to get maximum performance for Microblaze.
 	 * For Zynq A9, ZynqMP A53 and R5 zero-copy pbufs does not give
 	 * significant improvement hense not used. */
@@ -30,6 +30,7 @@
 #define __TCP_PERF_CLIENT_H_
 
 #include "lwipopts.h"
+#include "xlwipconfig.h"
 #include "lwip/ip_addr.h"
 #include "lwip/err.h"
 #include "lwip/tcp.h"
@@ -104,4 +105,10 @@ struct perf_stats {
 
 #define TCP_SEND_BUFSIZE (5*TCP_MSS)
 
+/* Set to 1 to queue send_buf by reference on all platforms, so segments
+ * are sent as PBUF_ROM chains, which measures the zero-copy TX path of the
+ * network adapter. Microblaze always does this.
+ */
+#define TCP_ZERO_COPY_TX 0
+
 #endif /* __TCP_PERF_CLIENT_H_ */
@@ -40,12 +40,29 @@ static char send_buf[UDP_SEND_BUFSIZE];
 /* End time in ms */
 #define END_TIME (UDP_TIME_INTERVAL * 1000)
 
+/* Print the TX settings which the measured bandwidth depends on */
+static void print_tx_config(void)
+{
+	xil_printf("TX payload: %s\r\n",
+			UDP_ZERO_COPY_TX ? "by reference" : "copied");
+#if defined (XLWIP_CONFIG_AXI_TX_REAP_LOWAT)
+	xil_printf("AXI Ethernet TX reap low water mark: %d\r\n",
+			XLWIP_CONFIG_AXI_TX_REAP_LOWAT);
+#endif
+#if defined (XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA) && \
+	defined (XLWIP_CONFIG_AXI_DMA_TX_COHERENT)
+	xil_printf("AXI DMA TX coherent\r\n");
+#endif
+	xil_printf("\r\n");
+}
+
 void print_app_header(void)
 {
 	xil_printf("UDP client connecting to %s on port %d\r\n",
 			UDP_SERVER_IP_ADDRESS, UDP_CONN_PORT);
 	xil_printf("On Host: Run $iperf -s -i %d -u\r\n\r\n",
 			INTERIM_REPORT_INTERVAL);
+	print_tx_config();
 }
 
 static void print_udp_conn_stats(void)
@@ -143,6 +160,31 @@ static void reset_stats(void)
 	client.i_report.last_report_time = 0;
 }
 
+#if UDP_ZERO_COPY_TX
+/* Build a datagram whose payload after the packet id is send_buf itself.
+ * send_buf is never written once the test runs, so it can stay queued on
+ * the adapter after udp_send() returns.
+ */
+static struct pbuf *udp_ref_packet_alloc(void)
+{
+	struct pbuf *head, *body;
+
+	head = pbuf_alloc(PBUF_TRANSPORT, sizeof(int), PBUF_RAM);
+	if (!head)
+		return NULL;
+
+	body = pbuf_alloc(PBUF_RAW, UDP_SEND_BUFSIZE - sizeof(int), PBUF_REF);
+	if (!body) {
+		pbuf_free(head);
+		return NULL;
+	}
+	body->payload = &send_buf[sizeof(int)];
+	pbuf_cat(head, body);
+
+	return head;
+}
+#endif
+
 static void udp_packet_send(u8_t finished)
 {
 	int *payload;
@@ -154,6 +196,13 @@ static void udp_packet_send(u8_t finished)
 
 	for (i = 0; i < NUM_OF_PARALLEL_CLIENTS; i++) {
 
+#if UDP_ZERO_COPY_TX
+		packet = udp_ref_packet_alloc();
+		if (!packet) {
+			xil_printf("error allocating pbuf to send\r\n");
+			return;
+		}
+#else
 		packet = pbuf_alloc(PBUF_TRANSPORT, UDP_SEND_BUFSIZE, PBUF_POOL);
 		if (!packet) {
 			xil_printf("error allocating pbuf to send\r\n");
@@ -161,6 +210,7 @@ static void udp_packet_send(u8_t finished)
 		} else {
 			memcpy(packet->payload, send_buf, UDP_SEND_BUFSIZE);
 		}
+#endif
 
 		/* always increment the id */
 		payload = (int*) (packet->payload);
@@ -107,4 +107,11 @@ struct perf_stats {
 /* Number of parallel UDP clients */
 #define NUM_OF_PARALLEL_CLIENTS 2
 
+/* Set to 1 to send the datagram payload by reference instead of copying it
+ * into a pool pbuf. Each datagram is then a chain of a small RAM pbuf with
+ * the packet id and a PBUF_REF pbuf pointing into send_buf, which measures
+ * the zero-copy TX path of the network adapter.
+ */
+#define UDP_ZERO_COPY_TX 0
+
 #endif /* __UDP_PERF_CLIENT_H_ */
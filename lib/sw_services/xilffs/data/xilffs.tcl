@@ -31,6 +31,8 @@
 # 1.00a hk/sg 10/17/13 First release
 # 2.0   hk    12/13/13 Modified to use new TCL API's
 # 4.1   hk    11/21/18 Use additional LFN options
+# 4.3   ag    10/16/26 Generate sector cache parameters
+#             10/16/26 Generate double-buffered SD write parameters
 #
 ##############################################################################
 
@@ -115,6 +117,8 @@ proc xgen_opts_file {libhandle} {
 	set set_fs_rpath [common::get_property CONFIG.set_fs_rpath $libhandle]
 	set word_access [common::get_property CONFIG.word_access $libhandle]
 	set use_chmod [common::get_property CONFIG.use_chmod $libhandle]
+	set enable_cache [common::get_property CONFIG.enable_cache $libhandle]
+	set sd_async_write [common::get_property CONFIG.sd_async_write $libhandle]
 
 	# do processor specific checks
 	set proc  [hsi::get_sw_processor];
@@ -152,6 +156,16 @@ proc xgen_opts_file {libhandle} {
 		if {$periph == "ps7_sdio" || $periph == "psu_sd" || $periph == "psv_pmc_sd"} {
 			if {$fs_interface == 1} {
 				puts $file_handle "\#define FILE_SYSTEM_INTERFACE_SD"
+				if {$sd_async_write == true} {
+					set sd_async_buf [common::get_property CONFIG.sd_async_buf_sectors $libhandle]
+					if {$sd_async_buf < 1 || $sd_async_buf > 128} {
+						puts "WARNING : Invalid SD write buffer size, \
+								setting back to 8\n"
+						set sd_async_buf 8
+					}
+					puts $file_handle "\#define FILE_SYSTEM_SD_ASYNC"
+					puts $file_handle "\#define FILE_SYSTEM_SD_ASYNC_SECTORS ${sd_async_buf}U"
+				}
 				break
 			}
 		}
@@ -201,6 +215,31 @@ proc xgen_opts_file {libhandle} {
 		}
 		puts $file_handle "\#define FILE_SYSTEM_SET_FS_RPATH $set_fs_rpath"
 
+		if {$enable_cache == true} {
+			set cache_num_sets [common::get_property CONFIG.cache_num_sets $libhandle]
+			set cache_num_ways [common::get_property CONFIG.cache_num_ways $libhandle]
+			set cache_burst [common::get_property CONFIG.cache_burst_sectors $libhandle]
+			if {$cache_num_sets < 1 || ($cache_num_sets & ($cache_num_sets - 1)) != 0} {
+				puts "WARNING : Number of cache sets must be a power \
+						of two, setting back to 16\n"
+				set cache_num_sets 16
+			}
+			if {$cache_num_ways < 1} {
+				puts "WARNING : Invalid number of cache ways, setting \
+						back to 4\n"
+				set cache_num_ways 4
+			}
+			if {$cache_burst < 1 || $cache_burst > 128} {
+				puts "WARNING : Invalid cache burst length, setting \
+						back to 8\n"
+				set cache_burst 8
+			}
+			puts $file_handle "\#define FILE_SYSTEM_CACHE"
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_SETS ${cache_num_sets}U"
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_WAYS ${cache_num_ways}U"
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_BURST ${cache_burst}U"
+		}
+
 		# MB does not allow word access from RAM
 		if {$proc_type != "microblaze" && $word_access == true} {
 			puts $file_handle "\#define FILE_SYSTEM_WORD_ACCESS"
@@ -0,0 +1,398 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xilffs_cache_example.c
+*
+*
+* @note This example measures the number of device operations issued by
+* a set of small-file workloads with the sector cache bypassed and enabled.
+* It requires the RAM interface (fs_interface = 2), enable_cache = true,
+* read_only = false and use_mkfs = true. The stream workload appends to
+* one file without syncing and fails unless the cache merges its writes.
+*
+* Since the RAM interface does not touch any peripheral, the example can
+* also be run on a Linux host. Build ff.c, ffsystem.c, ffunicode.c,
+* diskio.c, diskcache.c and this file together with the standalone BSP
+* xil_types.h and an xparameters.h which defines FILE_SYSTEM_INTERFACE_RAM,
+* FILE_SYSTEM_CACHE, FILE_SYSTEM_USE_MKFS, FILE_SYSTEM_NUM_LOGIC_VOL,
+* FILE_SYSTEM_USE_STRFUNC, FILE_SYSTEM_SET_FS_RPATH, RAMFS_SIZE and
+* RAMFS_START_ADDR (for example the address of a static array), and map
+* xil_printf to printf.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 4.3   ag  10/16/26 First release
+*       ag  10/16/26 Added a stream workload whose writes are merged
+*
+*</pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"	/* SDK generated parameters */
+#include "xil_printf.h"
+#include "xstatus.h"
+#include "ff.h"
+#include "diskcache.h"
+
+/************************** Constant Definitions *****************************/
+
+#define LOG_RECORDS		512U	/* Records appended by the logger */
+#define LOG_RECORD_SIZE		64U
+#define LOG_SYNC_INTERVAL	8U	/* f_sync after this many records */
+#define SMALL_FILES		32U	/* Files created by the small file run */
+#define SMALL_FILE_SIZE		200U
+#define STREAM_RECORDS		512U	/* Records appended without a sync */
+
+/**************************** Type Definitions *******************************/
+
+typedef int (*Workload)(void);
+
+/************************** Function Prototypes ******************************/
+
+int FfsCacheExample(void);
+static int FormatVolume(void);
+static int LoggerWorkload(void);
+static int SmallFileWorkload(void);
+static int StreamWorkload(void);
+static int ReadBackWorkload(void);
+
+/************************** Variable Definitions *****************************/
+
+static FIL fil;		/* File object */
+static FATFS fatfs;
+static TCHAR *Path = "0:/";
+static BYTE Record[LOG_RECORD_SIZE];
+static BYTE FileBuf[SMALL_FILE_SIZE];
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the cache example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+
+	xil_printf("XilFFs Sector Cache Example Test \r\n");
+
+	Status = FfsCacheExample();
+	if (Status != XST_SUCCESS) {
+		xil_printf("XilFFs Sector Cache Example Test failed \r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran XilFFs Sector Cache Example Test \r\n");
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Runs every workload on a freshly formatted volume, once with the cache
+* bypassed and once with it enabled, and prints the device operation
+* counters of both runs.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int FfsCacheExample(void)
+{
+	static const Workload Workloads[] = {
+		LoggerWorkload, SmallFileWorkload, ReadBackWorkload,
+		StreamWorkload
+	};
+	static const char *Names[] = {
+		"logger", "small files", "read back", "stream"
+	};
+	DiskCache_Stats Stats;
+	u32 Index;
+	u8 Enable;
+
+	xil_printf("%-12s %-6s %8s %8s %8s %8s %8s\r\n", "workload", "cache",
+			"rd ops", "wr ops", "rd sect", "wr sect", "merged");
+
+	for (Index = 0U; Index < (sizeof(Workloads) / sizeof(Workloads[0]));
+			Index++) {
+		for (Enable = 0U; Enable <= 1U; Enable++) {
+			if (FormatVolume() != XST_SUCCESS) {
+				return XST_FAILURE;
+			}
+			/* The read back workload needs files to read */
+			if ((Workloads[Index] == ReadBackWorkload) &&
+				(SmallFileWorkload() != XST_SUCCESS)) {
+				return XST_FAILURE;
+			}
+
+			if (disk_cache_enable(0U, Enable) != RES_OK) {
+				return XST_FAILURE;
+			}
+			disk_cache_reset_stats(0U);
+			if (Workloads[Index]() != XST_SUCCESS) {
+				return XST_FAILURE;
+			}
+			if (disk_ioctl(0U, CTRL_SYNC, NULL) != RES_OK) {
+				return XST_FAILURE;
+			}
+
+			if (disk_cache_stats(0U, &Stats) != 0U) {
+				return XST_FAILURE;
+			}
+			xil_printf("%-12s %-6s %8d %8d %8d %8d %8d\r\n",
+				Names[Index], (Enable != 0U) ? "on" : "off",
+				Stats.DevReads, Stats.DevWrites,
+				Stats.DevSectorsRead, Stats.DevSectorsWritten,
+				Stats.Coalesced);
+
+			/* Sequential sectors must be written back in runs */
+			if ((Workloads[Index] == StreamWorkload) &&
+				(Enable != 0U) && (Stats.Coalesced == 0U)) {
+				xil_printf("stream writes were not merged\r\n");
+				return XST_FAILURE;
+			}
+		}
+	}
+
+	(void)f_mount(NULL, Path, 0U);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Creates an empty FAT volume on the RAM disk and mounts it.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int FormatVolume(void)
+{
+	BYTE work[FF_MAX_SS];
+	FRESULT Res;
+
+	(void)f_mount(NULL, Path, 0U);
+	(void)disk_cache_enable(0U, 0U);
+
+	Res = f_mkfs(Path, FM_FAT, 0U, work, sizeof work);
+	if (Res != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	Res = f_mount(&fatfs, Path, 1U);
+	if (Res != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Appends fixed size records to one file and syncs it periodically, as a
+* data logger does.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int LoggerWorkload(void)
+{
+	UINT NumBytesWritten;
+	u32 Count;
+	u32 Byte;
+
+	if (f_open(&fil, "log.bin", FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	for (Count = 0U; Count < LOG_RECORDS; Count++) {
+		for (Byte = 0U; Byte < LOG_RECORD_SIZE; Byte++) {
+			Record[Byte] = (BYTE)(Count + Byte);
+		}
+		if ((f_write(&fil, Record, LOG_RECORD_SIZE,
+				&NumBytesWritten) != FR_OK) ||
+				(NumBytesWritten != LOG_RECORD_SIZE)) {
+			return XST_FAILURE;
+		}
+		if (((Count + 1U) % LOG_SYNC_INTERVAL) == 0U) {
+			if (f_sync(&fil) != FR_OK) {
+				return XST_FAILURE;
+			}
+		}
+	}
+
+	if (f_close(&fil) != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Appends small records to one file without syncing it, so its sectors are
+* written one by one in sequence and only flushed when the file is closed.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int StreamWorkload(void)
+{
+	UINT NumBytesWritten;
+	u32 Count;
+	u32 Byte;
+
+	if (f_open(&fil, "stream.bin", FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	for (Count = 0U; Count < STREAM_RECORDS; Count++) {
+		for (Byte = 0U; Byte < LOG_RECORD_SIZE; Byte++) {
+			Record[Byte] = (BYTE)(Count ^ Byte);
+		}
+		if ((f_write(&fil, Record, LOG_RECORD_SIZE,
+				&NumBytesWritten) != FR_OK) ||
+				(NumBytesWritten != LOG_RECORD_SIZE)) {
+			return XST_FAILURE;
+		}
+	}
+
+	if (f_close(&fil) != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Creates a number of small files, each in its own open/write/close cycle.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int SmallFileWorkload(void)
+{
+	char Name[16];
+	UINT NumBytesWritten;
+	u32 Count;
+	u32 Byte;
+
+	for (Count = 0U; Count < SMALL_FILES; Count++) {
+		Name[0] = 'f';
+		Name[1] = (char)('0' + (Count / 10U));
+		Name[2] = (char)('0' + (Count % 10U));
+		Name[3] = '\0';
+		for (Byte = 0U; Byte < SMALL_FILE_SIZE; Byte++) {
+			FileBuf[Byte] = (BYTE)(Count ^ Byte);
+		}
+		if (f_open(&fil, Name, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+			return XST_FAILURE;
+		}
+		if ((f_write(&fil, FileBuf, SMALL_FILE_SIZE,
+				&NumBytesWritten) != FR_OK) ||
+				(NumBytesWritten != SMALL_FILE_SIZE)) {
+			return XST_FAILURE;
+		}
+		if (f_close(&fil) != FR_OK) {
+			return XST_FAILURE;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads back and verifies the files created by SmallFileWorkload.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int ReadBackWorkload(void)
+{
+	char Name[16];
+	UINT NumBytesRead;
+	u32 Count;
+	u32 Byte;
+
+	for (Count = 0U; Count < SMALL_FILES; Count++) {
+		Name[0] = 'f';
+		Name[1] = (char)('0' + (Count / 10U));
+		Name[2] = (char)('0' + (Count % 10U));
+		Name[3] = '\0';
+		if (f_open(&fil, Name, FA_READ) != FR_OK) {
+			return XST_FAILURE;
+		}
+		if ((f_read(&fil, FileBuf, SMALL_FILE_SIZE,
+				&NumBytesRead) != FR_OK) ||
+				(NumBytesRead != SMALL_FILE_SIZE)) {
+			return XST_FAILURE;
+		}
+		for (Byte = 0U; Byte < SMALL_FILE_SIZE; Byte++) {
+			if (FileBuf[Byte] != (BYTE)(Count ^ Byte)) {
+				return XST_FAILURE;
+			}
+		}
+		if (f_close(&fil) != FR_OK) {
+			return XST_FAILURE;
+		}
+	}
+
+	return XST_SUCCESS;
+}
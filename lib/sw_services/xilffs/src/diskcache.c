@@ -0,0 +1,554 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file diskcache.c
+*		This file implements the write-back sector cache used by
+*		disk_read, disk_write and disk_ioctl(CTRL_SYNC) when
+*		FILE_SYSTEM_CACHE is defined.
+*
+*		Single sector reads and writes are served from the cache.
+*		Multi-sector transfers (file data moved directly between the
+*		user buffer and the device by FatFs) bypass it; cached copies
+*		of the affected sectors are kept coherent.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.3   ag   10/16/26 First release
+*       ag   10/16/26 Check the drive number of the public functions
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#include "diskcache.h"
+
+#ifdef FILE_SYSTEM_CACHE
+#include <string.h>
+
+/************************** Constant Definitions *****************************/
+
+#define DISK_CACHE_VALID	0x01U
+#define DISK_CACHE_DIRTY	0x02U
+#define DISK_CACHE_META		0x04U
+
+#define DISK_CACHE_SET_MASK	(FILE_SYSTEM_CACHE_SETS - 1U)
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	DWORD Sector;	/**< Sector number held by the line */
+	u32 Stamp;	/**< Last access stamp, used for LRU */
+	BYTE Pdrv;	/**< Drive the sector belongs to */
+	BYTE Flags;	/**< DISK_CACHE_VALID/DIRTY/META */
+} DiskCache_Line;
+
+/************************** Variable Definitions *****************************/
+
+static DiskCache_Line Lines[DISK_CACHE_NUM_LINES];
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+static u8 LineData[DISK_CACHE_NUM_LINES][DISK_CACHE_SECTOR_SIZE];
+#pragma data_alignment = 32
+static u8 BurstBuf[FILE_SYSTEM_CACHE_BURST * DISK_CACHE_SECTOR_SIZE];
+#else
+static u8 LineData[DISK_CACHE_NUM_LINES][DISK_CACHE_SECTOR_SIZE]
+			__attribute__ ((aligned(32)));
+static u8 BurstBuf[FILE_SYSTEM_CACHE_BURST * DISK_CACHE_SECTOR_SIZE]
+			__attribute__ ((aligned(32)));
+#endif
+
+static DiskCache_Stats Stats[DISK_CACHE_NUM_DRV];
+static u8 Enabled[DISK_CACHE_NUM_DRV] = {1U, 1U};
+static u8 MetaHint[DISK_CACHE_NUM_DRV];
+static u32 Clock;
+
+/*****************************************************************************/
+/*
+*
+* Device access wrappers which maintain the device operation counters.
+*
+******************************************************************************/
+static DRESULT DevRead(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+	Stats[pdrv].DevReads++;
+	Stats[pdrv].DevSectorsRead += count;
+	return disk_dev_read(pdrv, buff, sector, count);
+}
+
+static DRESULT DevWrite(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+{
+	Stats[pdrv].DevWrites++;
+	Stats[pdrv].DevSectorsWritten += count;
+	return disk_dev_write(pdrv, buff, sector, count);
+}
+
+/*****************************************************************************/
+/*
+*
+* Returns the index of the line holding the sector or -1 if it is not cached.
+*
+******************************************************************************/
+static s32 Lookup(BYTE pdrv, DWORD sector)
+{
+	u32 Base = (sector & DISK_CACHE_SET_MASK) * FILE_SYSTEM_CACHE_WAYS;
+	u32 Way;
+
+	for (Way = 0U; Way < FILE_SYSTEM_CACHE_WAYS; Way++) {
+		const DiskCache_Line *Line = &Lines[Base + Way];
+		if (((Line->Flags & DISK_CACHE_VALID) != 0U) &&
+				(Line->Sector == sector) && (Line->Pdrv == pdrv)) {
+			return (s32)(Base + Way);
+		}
+	}
+
+	return -1;
+}
+
+/*****************************************************************************/
+/*
+*
+* Writes back the dirty run containing the given line. The run is extended
+* backwards and forwards over dirty neighbours of the same drive, up to
+* FILE_SYSTEM_CACHE_BURST sectors, and issued as one device write.
+*
+******************************************************************************/
+static DRESULT FlushRun(u32 Idx)
+{
+	BYTE pdrv = Lines[Idx].Pdrv;
+	DWORD Start = Lines[Idx].Sector;
+	s32 Run[FILE_SYSTEM_CACHE_BURST];
+	u32 Cnt = 0U;
+	u32 i;
+	s32 Prev;
+	s32 Next;
+	DRESULT Res;
+
+	while ((Start > 0U) && (Cnt < (FILE_SYSTEM_CACHE_BURST - 1U))) {
+		Prev = Lookup(pdrv, Start - 1U);
+		if ((Prev < 0) ||
+			((Lines[Prev].Flags & DISK_CACHE_DIRTY) == 0U)) {
+			break;
+		}
+		Start--;
+		Cnt++;
+	}
+
+	Cnt = 0U;
+	while (Cnt < FILE_SYSTEM_CACHE_BURST) {
+		Next = Lookup(pdrv, Start + Cnt);
+		if ((Next < 0) ||
+			((Lines[Next].Flags & DISK_CACHE_DIRTY) == 0U)) {
+			break;
+		}
+		Run[Cnt] = Next;
+		Cnt++;
+	}
+
+	if (Cnt == 1U) {
+		Res = DevWrite(pdrv, LineData[Run[0]], Start, 1U);
+	} else {
+		for (i = 0U; i < Cnt; i++) {
+			(void)memcpy(&BurstBuf[i * DISK_CACHE_SECTOR_SIZE],
+					LineData[Run[i]], DISK_CACHE_SECTOR_SIZE);
+		}
+		Res = DevWrite(pdrv, BurstBuf, Start, Cnt);
+	}
+	if (Res != RES_OK) {
+		return Res;
+	}
+
+	for (i = 0U; i < Cnt; i++) {
+		Lines[Run[i]].Flags &= (BYTE)~DISK_CACHE_DIRTY;
+	}
+	Stats[pdrv].WriteBacks += Cnt;
+	Stats[pdrv].Coalesced += Cnt - 1U;
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/*
+*
+* Picks a line in the sector's set for a new allocation and writes it back if
+* it is dirty. Invalid lines are used first, then the least recently used
+* data line; metadata lines are only evicted when the whole set is metadata.
+*
+******************************************************************************/
+static s32 Allocate(BYTE pdrv, DWORD sector)
+{
+	u32 Base = (sector & DISK_CACHE_SET_MASK) * FILE_SYSTEM_CACHE_WAYS;
+	s32 Victim = -1;
+	s32 MetaVictim = -1;
+	u32 Way;
+
+	for (Way = 0U; Way < FILE_SYSTEM_CACHE_WAYS; Way++) {
+		u32 Idx = Base + Way;
+		if ((Lines[Idx].Flags & DISK_CACHE_VALID) == 0U) {
+			Victim = (s32)Idx;
+			break;
+		}
+		if ((Lines[Idx].Flags & DISK_CACHE_META) != 0U) {
+			if ((MetaVictim < 0) ||
+				(Lines[Idx].Stamp < Lines[MetaVictim].Stamp)) {
+				MetaVictim = (s32)Idx;
+			}
+		} else if ((Victim < 0) ||
+				(Lines[Idx].Stamp < Lines[Victim].Stamp)) {
+			Victim = (s32)Idx;
+		}
+	}
+	if (Victim < 0) {
+		Victim = MetaVictim;
+	}
+
+	if ((Lines[Victim].Flags & DISK_CACHE_DIRTY) != 0U) {
+		if (FlushRun((u32)Victim) != RES_OK) {
+			return -1;
+		}
+	}
+
+	Lines[Victim].Pdrv = pdrv;
+	Lines[Victim].Sector = sector;
+	Lines[Victim].Flags = DISK_CACHE_VALID;
+
+	return Victim;
+}
+
+static void Touch(BYTE pdrv, s32 Idx)
+{
+	Lines[Idx].Stamp = ++Clock;
+	if (MetaHint[pdrv] != 0U) {
+		Lines[Idx].Flags |= DISK_CACHE_META;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Invalidates all lines of the drive without writing them back and resets
+* its statistics. Called from disk_initialize.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+void disk_cache_init (BYTE pdrv)
+{
+	u32 Idx;
+
+	if (pdrv >= DISK_CACHE_NUM_DRV) {
+		return;
+	}
+
+	for (Idx = 0U; Idx < DISK_CACHE_NUM_LINES; Idx++) {
+		if (Lines[Idx].Pdrv == pdrv) {
+			Lines[Idx].Flags = 0U;
+		}
+	}
+	MetaHint[pdrv] = 0U;
+	disk_cache_reset_stats(pdrv);
+}
+
+/*****************************************************************************/
+/**
+*
+* Enables or bypasses the cache for a drive. Dirty lines are written back
+* before the cache is bypassed.
+*
+* @param	pdrv - Drive number
+* @param	Enable - 1 to enable, 0 to bypass
+*
+* @return	RES_OK, or RES_PARERR if the drive number is invalid
+*
+******************************************************************************/
+DRESULT disk_cache_enable (BYTE pdrv, u8 Enable)
+{
+	if (pdrv >= DISK_CACHE_NUM_DRV) {
+		return RES_PARERR;
+	}
+
+	if (Enable == 0U) {
+		(void)disk_cache_sync(pdrv);
+		disk_cache_init(pdrv);
+	}
+	Enabled[pdrv] = Enable;
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Marks the next access of the drive as a FAT or directory sector access.
+* FatFs calls this before transferring its sector window.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+void disk_cache_meta (BYTE pdrv)
+{
+	if (pdrv < DISK_CACHE_NUM_DRV) {
+		MetaHint[pdrv] = 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Drops a pending metadata hint. disk_read and disk_write call this when
+* they fail before reaching the cache, so the hint does not apply to the
+* next, unrelated access.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+void disk_cache_clear_meta (BYTE pdrv)
+{
+	if (pdrv < DISK_CACHE_NUM_DRV) {
+		MetaHint[pdrv] = 0U;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors through the cache.
+*
+* @param	pdrv - Drive number
+* @param	buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK, RES_PARERR if the drive number is invalid, or the
+*		result of the failing device access
+*
+******************************************************************************/
+DRESULT disk_cache_read (BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+	DRESULT Res = RES_OK;
+	s32 Idx;
+	UINT i;
+
+	if (pdrv >= DISK_CACHE_NUM_DRV) {
+		return RES_PARERR;
+	}
+
+	if (Enabled[pdrv] == 0U) {
+		MetaHint[pdrv] = 0U;
+		return DevRead(pdrv, buff, sector, count);
+	}
+
+	if (count == 1U) {
+		Idx = Lookup(pdrv, sector);
+		if (Idx >= 0) {
+			Stats[pdrv].Hits++;
+		} else {
+			Stats[pdrv].Misses++;
+			Idx = Allocate(pdrv, sector);
+			if (Idx < 0) {
+				Res = RES_ERROR;
+				goto END;
+			}
+			Res = DevRead(pdrv, LineData[Idx], sector, 1U);
+			if (Res != RES_OK) {
+				Lines[Idx].Flags = 0U;
+				goto END;
+			}
+		}
+		Touch(pdrv, Idx);
+		(void)memcpy(buff, LineData[Idx], DISK_CACHE_SECTOR_SIZE);
+		goto END;
+	}
+
+	/* Bulk read; dirty cached sectors are newer than the device copy */
+	Res = DevRead(pdrv, buff, sector, count);
+	if (Res != RES_OK) {
+		goto END;
+	}
+	for (i = 0U; i < count; i++) {
+		Idx = Lookup(pdrv, sector + i);
+		if ((Idx >= 0) && ((Lines[Idx].Flags & DISK_CACHE_DIRTY) != 0U)) {
+			(void)memcpy(&buff[i * DISK_CACHE_SECTOR_SIZE],
+					LineData[Idx], DISK_CACHE_SECTOR_SIZE);
+		}
+	}
+
+END:
+	MetaHint[pdrv] = 0U;
+	return Res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors through the cache. Single sectors are written back later;
+* multi-sector writes go to the device immediately and refresh any cached
+* copies.
+*
+* @param	pdrv - Drive number
+* @param	buff - Pointer to the data to be written
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK, RES_PARERR if the drive number is invalid, or the
+*		result of the failing device access
+*
+******************************************************************************/
+DRESULT disk_cache_write (BYTE pdrv, const BYTE *buff, DWORD sector,
+		UINT count)
+{
+	DRESULT Res = RES_OK;
+	s32 Idx;
+	UINT i;
+
+	if (pdrv >= DISK_CACHE_NUM_DRV) {
+		return RES_PARERR;
+	}
+
+	if (Enabled[pdrv] == 0U) {
+		MetaHint[pdrv] = 0U;
+		return DevWrite(pdrv, buff, sector, count);
+	}
+
+	if (count == 1U) {
+		Idx = Lookup(pdrv, sector);
+		if (Idx >= 0) {
+			Stats[pdrv].Hits++;
+		} else {
+			Stats[pdrv].Misses++;
+			Idx = Allocate(pdrv, sector);
+			if (Idx < 0) {
+				Res = RES_ERROR;
+				goto END;
+			}
+		}
+		(void)memcpy(LineData[Idx], buff, DISK_CACHE_SECTOR_SIZE);
+		Lines[Idx].Flags |= DISK_CACHE_DIRTY;
+		Touch(pdrv, Idx);
+		goto END;
+	}
+
+	Res = DevWrite(pdrv, buff, sector, count);
+	if (Res != RES_OK) {
+		goto END;
+	}
+	for (i = 0U; i < count; i++) {
+		Idx = Lookup(pdrv, sector + i);
+		if (Idx >= 0) {
+			(void)memcpy(LineData[Idx], &buff[i * DISK_CACHE_SECTOR_SIZE],
+					DISK_CACHE_SECTOR_SIZE);
+			Lines[Idx].Flags &= (BYTE)~DISK_CACHE_DIRTY;
+		}
+	}
+
+END:
+	MetaHint[pdrv] = 0U;
+	return Res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes back all dirty sectors of the drive.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK, RES_PARERR if the drive number is invalid, or the
+*		result of the failing device access
+*
+******************************************************************************/
+DRESULT disk_cache_sync (BYTE pdrv)
+{
+	u32 Idx;
+	DRESULT Res;
+
+	if (pdrv >= DISK_CACHE_NUM_DRV) {
+		return RES_PARERR;
+	}
+
+	for (Idx = 0U; Idx < DISK_CACHE_NUM_LINES; Idx++) {
+		if ((Lines[Idx].Pdrv == pdrv) &&
+			((Lines[Idx].Flags & DISK_CACHE_DIRTY) != 0U)) {
+			Res = FlushRun(Idx);
+			if (Res != RES_OK) {
+				return Res;
+			}
+		}
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Copies the statistics of the drive.
+*
+* @param	pdrv - Drive number
+* @param	StatsPtr - Pointer to the statistics to be filled in
+*
+* @return	0, or STA_NOINIT if the drive number is invalid
+*
+******************************************************************************/
+DSTATUS disk_cache_stats (BYTE pdrv, DiskCache_Stats *StatsPtr)
+{
+	if (pdrv >= DISK_CACHE_NUM_DRV) {
+		return STA_NOINIT;
+	}
+	*StatsPtr = Stats[pdrv];
+
+	return 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* Clears the statistics of the drive.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+void disk_cache_reset_stats (BYTE pdrv)
+{
+	if (pdrv >= DISK_CACHE_NUM_DRV) {
+		return;
+	}
+	(void)memset(&Stats[pdrv], 0, sizeof(DiskCache_Stats));
+}
+#endif /* FILE_SYSTEM_CACHE */
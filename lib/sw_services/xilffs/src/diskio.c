@@ -58,6 +58,12 @@
 *       mn   07/06/18 Fix Cppcheck and Doxygen warnings
 * 4.2   mn   08/16/19 Initialize Status variables with failure values
 *       mn   09/25/19 Check if the SD is powered on or not in disk_status()
+* 4.3   ag   10/16/26 Route sector accesses through the write-back sector
+*                     cache when FILE_SYSTEM_CACHE is defined
+*            10/16/26 Added double-buffered SD writes through the queued
+*                     XSdPs request API when FILE_SYSTEM_SD_ASYNC is defined
+*            10/16/26 Clear the write-behind error once disk_write has
+*                     reported it
 *
 * </pre>
 *
@@ -73,6 +79,9 @@
 #endif
 #include "sleep.h"
 #include "xil_printf.h"
+#ifdef FILE_SYSTEM_CACHE
+#include "diskcache.h"
+#endif
 
 #define HIGH_SPEED_SUPPORT	0x01U
 #define WIDTH_4_BIT_SUPPORT	0x4U
@@ -113,6 +122,64 @@ static u32 CardDetect;
 static u32 WriteProtect;
 static u32 SlotType[2];
 static u8 HostCntrlrVer[2];
+
+#ifdef FILE_SYSTEM_SD_ASYNC
+#ifndef FILE_SYSTEM_SD_ASYNC_SECTORS
+#define FILE_SYSTEM_SD_ASYNC_SECTORS	8U
+#endif
+#define SD_ASYNC_BUF_SIZE	(FILE_SYSTEM_SD_ASYNC_SECTORS * \
+					XSDPS_BLK_SIZE_512_MASK)
+
+/*
+ * Two write buffers per drive. A write is copied into the free buffer and
+ * queued, so disk_write returns while the card is still busy and the next
+ * write can be copied while the previous one is transferred.
+ *
+ * Only writes are asynchronous. FatFs uses the data of disk_read as soon
+ * as it returns, so a read is queued behind the pending writes and waited
+ * for.
+ */
+static XSdPs_Request SdWrReq[2][2];
+static u8 SdWrNext[2];
+static u8 SdWrErr[2];
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+static u8 SdWrBuf[2][2][SD_ASYNC_BUF_SIZE];
+#else
+static u8 SdWrBuf[2][2][SD_ASYNC_BUF_SIZE] __attribute__ ((aligned(32)));
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Waits for the pending write-behind transfers of the drive.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK if all writes since the last flush succeeded,
+*		RES_ERROR otherwise. The error indication is cleared.
+*
+******************************************************************************/
+static DRESULT sd_async_flush(BYTE pdrv)
+{
+	DRESULT res = RES_OK;
+	u32 Index;
+
+	for (Index = 0U; Index < 2U; Index++) {
+		if (XSdPs_WaitRequest(&SdInstance[pdrv],
+				&SdWrReq[pdrv][Index]) != XST_SUCCESS) {
+			res = RES_ERROR;
+		}
+		SdWrReq[pdrv][Index].Status = XST_SUCCESS;
+	}
+	if (SdWrErr[pdrv] != 0U) {
+		res = RES_ERROR;
+	}
+	SdWrErr[pdrv] = 0U;
+
+	return res;
+}
+#endif
 #endif
 
 /*-----------------------------------------------------------------------*/
@@ -309,6 +376,10 @@ DSTATUS disk_initialize (
 	Stat[pdrv] = s;
 #endif
 
+#ifdef FILE_SYSTEM_CACHE
+	disk_cache_init(pdrv);
+#endif
+
 	return s;
 }
 
@@ -343,33 +414,89 @@ DRESULT disk_read (
 )
 {
 	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	s32 Status = XST_FAILURE;
-	DWORD LocSector = sector;
-#endif
 
 	s = disk_status(pdrv);
 
 	if ((s & STA_NOINIT) != 0U) {
+#ifdef FILE_SYSTEM_CACHE
+		disk_cache_clear_meta(pdrv);
+#endif
 		return RES_NOTRDY;
 	}
 	if (count == 0U) {
+#ifdef FILE_SYSTEM_CACHE
+		disk_cache_clear_meta(pdrv);
+#endif
 		return RES_PARERR;
 	}
 
+#ifdef FILE_SYSTEM_CACHE
+	return disk_cache_read(pdrv, buff, sector, count);
+#else
+	return disk_dev_read(pdrv, buff, sector, count);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors from the device, bypassing the sector cache.
+* In case of SD, it reads the SD card using ADMA2 in polled mode.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Read successful
+*		RES_ERROR	Read not successful
+*
+* @note		The caller validates the drive status and the count.
+*
+******************************************************************************/
+DRESULT disk_dev_read (
+		BYTE pdrv,	/* Physical drive number (0) */
+		BYTE *buff,	/* Pointer to the data buffer to store read data */
+		DWORD sector,	/* Start sector number (LBA) */
+		UINT count	/* Sector count (1..128) */
+)
+{
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	s32 Status = XST_FAILURE;
+	DWORD LocSector = sector;
+
 	/* Convert LBA to byte address if needed */
 	if ((SdInstance[pdrv].HCS) == 0U) {
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
 	}
 
+#ifdef FILE_SYSTEM_SD_ASYNC
+	{
+		/* Queued behind any pending writes, which keeps the order */
+		XSdPs_Request Req;
+
+		Req.Arg = (u32)LocSector;
+		Req.BlkCnt = count;
+		Req.Buff = buff;
+		Req.IsWrite = 0U;
+		Req.Handler = NULL;
+		Req.CallBackRef = NULL;
+		Status = XSdPs_SubmitRequest(&SdInstance[pdrv], &Req);
+		if (Status == XST_SUCCESS) {
+			Status = XSdPs_WaitRequest(&SdInstance[pdrv], &Req);
+		}
+	}
+#else
 	Status  = XSdPs_ReadPolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
+#endif
 	if (Status != XST_SUCCESS) {
 		return RES_ERROR;
 	}
 #endif
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
+	(void)pdrv;
 	memcpy(buff, dataramfs + (sector * SECTORSIZE), count * SECTORSIZE);
 #endif
 
@@ -396,7 +523,16 @@ DRESULT disk_ioctl (
 
 	switch (cmd) {
 		case (BYTE)CTRL_SYNC :	/* Make sure that no pending write process */
+#ifdef FILE_SYSTEM_CACHE
+			res = disk_cache_sync(pdrv);
+#else
 			res = RES_OK;
+#endif
+#ifdef FILE_SYSTEM_SD_ASYNC
+			if (sd_async_flush(pdrv) != RES_OK) {
+				res = RES_ERROR;
+			}
+#endif
 			break;
 
 		case (BYTE)GET_SECTOR_COUNT : /* Get number of sectors on the disk (DWORD) */
@@ -418,7 +554,11 @@ DRESULT disk_ioctl (
 #ifdef FILE_SYSTEM_INTERFACE_RAM
 	switch (cmd) {
 	case (BYTE)CTRL_SYNC:
+#ifdef FILE_SYSTEM_CACHE
+		res = disk_cache_sync(pdrv);
+#else
 		res = RES_OK;
+#endif
 		break;
 	case (BYTE)GET_BLOCK_SIZE:
 		*(WORD *)buff = BLOCKSIZE;
@@ -465,8 +605,8 @@ DWORD get_fattime (void)
 /*****************************************************************************/
 /**
 *
-* Reads the drive
-* In case of SD, it reads the SD card using ADMA2 in polled mode.
+* Writes the drive
+* In case of SD, it writes the SD card using ADMA2 in polled mode.
 *
 * @param	pdrv - Drive number
 * @param	*buff - Pointer to the data to be written
@@ -474,11 +614,12 @@ DWORD get_fattime (void)
 * @param	count - Sector count
 *
 * @return
-*		RES_OK		Read successful
+*		RES_OK		Write successful
 *		STA_NOINIT	Drive not initialized
-*		RES_ERROR	Read not successful
+*		RES_ERROR	Write not successful
 *
-* @note
+* @note		With FILE_SYSTEM_CACHE, single sector writes are held in the
+*		sector cache until they are evicted or CTRL_SYNC is issued.
 *
 ******************************************************************************/
 DRESULT disk_write (
@@ -489,26 +630,100 @@ DRESULT disk_write (
 )
 {
 	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	s32 Status = XST_FAILURE;
-	DWORD LocSector = sector;
-#endif
 
 	s = disk_status(pdrv);
 	if ((s & STA_NOINIT) != 0U) {
+#ifdef FILE_SYSTEM_CACHE
+		disk_cache_clear_meta(pdrv);
+#endif
 		return RES_NOTRDY;
 	}
 	if (count == 0U) {
+#ifdef FILE_SYSTEM_CACHE
+		disk_cache_clear_meta(pdrv);
+#endif
 		return RES_PARERR;
 	}
 
+#ifdef FILE_SYSTEM_CACHE
+	return disk_cache_write(pdrv, buff, sector, count);
+#else
+	return disk_dev_write(pdrv, buff, sector, count);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors to the device, bypassing the sector cache.
+* In case of SD, it writes the SD card using ADMA2 in polled mode.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Sector address
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Write successful
+*		RES_ERROR	Write not successful
+*
+* @note		The caller validates the drive status and the count.
+*
+******************************************************************************/
+DRESULT disk_dev_write (
+	BYTE pdrv,			/* Physical drive nmuber (0..) */
+	const BYTE *buff,	/* Data to be written */
+	DWORD sector,		/* Sector address (LBA) */
+	UINT count			/* Number of sectors to write (1..128) */
+)
+{
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	s32 Status = XST_FAILURE;
+	DWORD LocSector = sector;
+
 	/* Convert LBA to byte address if needed */
 	if ((SdInstance[pdrv].HCS) == 0U) {
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
 	}
 
+#ifdef FILE_SYSTEM_SD_ASYNC
+	{
+		const BYTE *Src = buff;
+		XSdPs_Request *Req;
+		UINT Chunk;
+
+		while (count > 0U) {
+			Chunk = (count > FILE_SYSTEM_SD_ASYNC_SECTORS) ?
+					FILE_SYSTEM_SD_ASYNC_SECTORS : count;
+			Req = &SdWrReq[pdrv][SdWrNext[pdrv]];
+			/* Reuse the buffer only once its last write is done */
+			if (XSdPs_WaitRequest(&SdInstance[pdrv], Req) != XST_SUCCESS) {
+				SdWrErr[pdrv] = 1U;
+			}
+			(void)memcpy(SdWrBuf[pdrv][SdWrNext[pdrv]], Src,
+					Chunk * XSDPS_BLK_SIZE_512_MASK);
+			Req->Arg = (u32)LocSector;
+			Req->BlkCnt = Chunk;
+			Req->Buff = SdWrBuf[pdrv][SdWrNext[pdrv]];
+			Req->IsWrite = 1U;
+			Req->Handler = NULL;
+			Req->CallBackRef = NULL;
+			if (XSdPs_SubmitRequest(&SdInstance[pdrv], Req) != XST_SUCCESS) {
+				SdWrErr[pdrv] = 1U;
+			}
+			SdWrNext[pdrv] ^= 1U;
+			Src += Chunk * XSDPS_BLK_SIZE_512_MASK;
+			LocSector += ((SdInstance[pdrv].HCS) == 0U) ?
+					(Chunk * XSDPS_BLK_SIZE_512_MASK) : Chunk;
+			count -= Chunk;
+		}
+		/* Errors of earlier write-behind transfers are reported once */
+		Status = (SdWrErr[pdrv] == 0U) ? XST_SUCCESS : XST_FAILURE;
+		SdWrErr[pdrv] = 0U;
+	}
+#else
 	Status  = XSdPs_WritePolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
+#endif
 	if (Status != XST_SUCCESS) {
 		return RES_ERROR;
 	}
@@ -516,6 +731,7 @@ DRESULT disk_write (
 #endif
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
+	(void)pdrv;
 	memcpy(dataramfs + (sector * SECTORSIZE), buff, count * SECTORSIZE);
 #endif
 
@@ -32,6 +32,9 @@
 #if (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM)
 #include "ff.h"			/* Declarations of FatFs API */
 #include "diskio.h"		/* Declarations of device I/O functions */
+#ifdef FILE_SYSTEM_CACHE
+#include "diskcache.h"		/* Sector cache metadata hint */
+#endif
 #include "xil_printf.h"
 
 
@@ -1055,9 +1058,15 @@ static FRESULT sync_window (	/* Returns FR_OK or FR_DISK_ERR */
 	FRESULT res = FR_DISK_ERR;
 
 	if (fs->wflag) {	/* Is the disk access window dirty */
+#ifdef FILE_SYSTEM_CACHE
+		disk_cache_meta(fs->pdrv);	/* Window holds FAT or directory data */
+#endif
 		if (disk_write(fs->pdrv, fs->win, fs->winsect, 1) == RES_OK) {	/* Write back the window */
 			fs->wflag = 0;	/* Clear window dirty flag */
 			if (fs->winsect - fs->fatbase < fs->fsize) {	/* Is it in the 1st FAT? */
+#ifdef FILE_SYSTEM_CACHE
+				disk_cache_meta(fs->pdrv);
+#endif
 				if (fs->n_fats == 2) disk_write(fs->pdrv, fs->win, fs->winsect + fs->fsize, 1);	/* Reflect it to 2nd FAT if needed */
 			}
 			res = FR_OK;
@@ -1082,6 +1091,9 @@ static FRESULT move_window (	/* Returns FR_OK or FR_DISK_ERR */
 #if !FF_FS_READONLY
 		res = sync_window(fs);		/* Write-back changes */
 		if (res == FR_OK) {			/* Fill sector window with new data */
+#endif
+#ifdef FILE_SYSTEM_CACHE
+			disk_cache_meta(fs->pdrv);	/* Window holds FAT or directory data */
 #endif
 			if (disk_read(fs->pdrv, fs->win, sector, 1) != RES_OK) {
 				sector = 0xFFFFFFFF;	/* Invalidate window if read data is not valid */
@@ -0,0 +1,130 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file diskcache.h
+*		This file contains the declarations of the write-back sector
+*		cache that sits between FatFs and the device glue in diskio.c.
+*
+*		The cache is N-way set associative. Sectors which FatFs
+*		accesses through its window (FAT and directory sectors) are
+*		marked as metadata and are only evicted when no data sector
+*		can be evicted from the set. Dirty sectors are written back on
+*		eviction or on CTRL_SYNC, and runs of adjacent dirty sectors
+*		are coalesced into a single multi-block device write.
+*
+*		The cache is enabled by setting "enable_cache" to true in the
+*		xilffs library options, which defines FILE_SYSTEM_CACHE.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.3   ag   10/16/26 First release
+*       ag   10/16/26 disk_cache_enable and disk_cache_stats report an
+*                     invalid drive number
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#ifndef DISKCACHE_H_
+#define DISKCACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "xil_types.h"
+#include "integer.h"
+#include "diskio.h"
+#include "xparameters.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Number of sets; must be a power of two */
+#ifndef FILE_SYSTEM_CACHE_SETS
+#define FILE_SYSTEM_CACHE_SETS		16U
+#endif
+
+/* Number of ways per set */
+#ifndef FILE_SYSTEM_CACHE_WAYS
+#define FILE_SYSTEM_CACHE_WAYS		4U
+#endif
+
+/* Maximum number of sectors coalesced into one device write */
+#ifndef FILE_SYSTEM_CACHE_BURST
+#define FILE_SYSTEM_CACHE_BURST		8U
+#endif
+
+#define DISK_CACHE_NUM_DRV		2U
+#define DISK_CACHE_SECTOR_SIZE		512U
+#define DISK_CACHE_NUM_LINES		(FILE_SYSTEM_CACHE_SETS * \
+						FILE_SYSTEM_CACHE_WAYS)
+
+#if ((FILE_SYSTEM_CACHE_SETS & (FILE_SYSTEM_CACHE_SETS - 1U)) != 0U)
+#error "FILE_SYSTEM_CACHE_SETS must be a power of two"
+#endif
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Per drive statistics. Dev* counters count the operations issued to the
+ * underlying SD or RAM device and are maintained whether the cache is
+ * enabled or bypassed, so workloads can be compared in both modes.
+ */
+typedef struct {
+	u32 DevReads;		/**< Device read commands */
+	u32 DevWrites;		/**< Device write commands */
+	u32 DevSectorsRead;	/**< Sectors read from the device */
+	u32 DevSectorsWritten;	/**< Sectors written to the device */
+	u32 Hits;		/**< Single sector accesses served by cache */
+	u32 Misses;		/**< Single sector accesses which missed */
+	u32 WriteBacks;		/**< Dirty sectors written back */
+	u32 Coalesced;		/**< Write-backs merged into a preceding run */
+} DiskCache_Stats;
+
+/************************** Function Prototypes ******************************/
+
+void disk_cache_init (BYTE pdrv);
+DRESULT disk_cache_enable (BYTE pdrv, u8 Enable);
+void disk_cache_meta (BYTE pdrv);
+void disk_cache_clear_meta (BYTE pdrv);
+DRESULT disk_cache_read (BYTE pdrv, BYTE *buff, DWORD sector, UINT count);
+DRESULT disk_cache_write (BYTE pdrv, const BYTE *buff, DWORD sector,
+		UINT count);
+DRESULT disk_cache_sync (BYTE pdrv);
+DSTATUS disk_cache_stats (BYTE pdrv, DiskCache_Stats *StatsPtr);
+void disk_cache_reset_stats (BYTE pdrv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DISKCACHE_H_ */
@@ -37,6 +37,10 @@ DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 
+/* Raw device access below the sector cache */
+DRESULT disk_dev_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
+DRESULT disk_dev_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
+
 
 /* Disk Status Bits (DSTATUS) */
 
@@ -34,6 +34,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   07/24/2018 Initial release
+*       ag   10/16/2026 Added XLOADER_IS_COPY_ASYNC
+*       ag   10/16/2026 QSPI and OSPI copies are asynchronous
 *
 * </pre>
 *
@@ -145,6 +147,18 @@ extern "C" {
 #define XLOADER_DEVICE_COPY_STATE_INITIATE	(0x1U)
 #define XLOADER_DEVICE_COPY_STATE_WAIT_DONE	(0x2U)
 
+/**
+ * Boot devices whose copy keeps running in the background after INITIATE.
+ * The other devices complete the copy on INITIATE: SD/eMMC reads go through
+ * FatFs, which has no split read, and SBI reads would clash with the CDO
+ * readback commands which also use the SBI.
+ */
+#define XLOADER_IS_COPY_ASYNC(PdiSrc)	\
+		((((PdiSrc) == XLOADER_PDI_SRC_DDR) || \
+		((PdiSrc) == XLOADER_PDI_SRC_QSPI24) || \
+		((PdiSrc) == XLOADER_PDI_SRC_QSPI32) || \
+		((PdiSrc) == XLOADER_PDI_SRC_OSPI)) ? TRUE : FALSE)
+
 /* Boot Modes */
 enum XLOADER_PDI_SRC {
 	XLOADER_PDI_SRC_JTAG = (0x0U),
@@ -36,6 +36,9 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  bsv   08/23/2018 Initial release
 * 1.01  bsv   09/10/2019 Added support to set OSPI to DDR mode
+*       ag    10/16/2026 Treat the WAIT_DONE copy state as a no-op
+*       ag    10/16/2026 Run an INITIATE copy in the background and
+*                        complete it on WAIT_DONE
 * </pre>
 *
 * @note
@@ -60,10 +63,14 @@
 
 /************************** Function Prototypes ******************************/
 static int FlashReadID(XOspiPsv *OspiPsvPtr);
+static void XLoader_OspiStatusHandler(void *CallBackRef, u32 StatusEvent);
+static int XLoader_OspiWaitDone(void);
 
 /************************** Variable Definitions *****************************/
 static XOspiPsv OspiPsvInstance;
 static XOspiPsv_Msg FlashMsg;
+static u8 OspiCopyPending = FALSE;
+static volatile u32 OspiXferEvent = XST_SPI_TRANSFER_DONE;
 u32 StatusCmd;
 u32 OspiFlashMake;
 u32 OspiFlashSize;
@@ -196,6 +203,13 @@ int XLoader_OspiInit(u32 DeviceFlags)
 	 */
 	XOspiPsv_SetOptions(OspiPsvInstancePtr, XOSPIPSV_IDAC_EN_OPTION);
 	
+	/*
+	 * Background reads are completed by polling the interrupt handler
+	 */
+	XOspiPsv_SetStatusHandler(OspiPsvInstancePtr, NULL,
+			XLoader_OspiStatusHandler);
+	OspiCopyPending = FALSE;
+
 	/*
 	 * Set the prescaler for OSPIPSV clock
 	 */
@@ -248,6 +262,63 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * This function records the status events of a background OSPI read. It is
+ * called from XOspiPsv_IntrHandler, which XLoader_OspiWaitDone polls.
+ *
+ * @param	CallBackRef is unused
+ * @param	StatusEvent is XST_SPI_TRANSFER_DONE or an error event
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XLoader_OspiStatusHandler(void *CallBackRef, u32 StatusEvent)
+{
+	(void)CallBackRef;
+
+	if (OspiXferEvent == XST_SPI_TRANSFER_DONE) {
+		OspiXferEvent = StatusEvent;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * This function waits for a background read started by an INITIATE copy.
+ * The OSPI interrupt is not connected in the PLM, so the driver interrupt
+ * handler is polled until the transfer is complete.
+ *
+ * @param	None
+ *
+ * @return
+ *		- XLOADER_SUCCESS if no read is pending or it completed
+ *		- XLOADER_ERR_OSPI_READ if the read failed
+ *
+ *****************************************************************************/
+static int XLoader_OspiWaitDone(void)
+{
+	int Status = XLOADER_SUCCESS;
+
+	if (OspiCopyPending != TRUE) {
+		goto END;
+	}
+
+	while ((OspiPsvInstance.IsBusy == TRUE) &&
+		(OspiXferEvent == XST_SPI_TRANSFER_DONE)) {
+		(void)XOspiPsv_IntrHandler(&OspiPsvInstance);
+	}
+	OspiCopyPending = FALSE;
+
+	if (OspiXferEvent != XST_SPI_TRANSFER_DONE) {
+		Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_OSPI_READ,
+				OspiXferEvent);
+		XLoader_Printf(DEBUG_GENERAL,"XLOADER_ERR_OSPI_READ\r\n");
+	}
+
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * This function is used to copy the data from OSPI flash to destination
@@ -275,6 +346,17 @@ XStatus XLoader_OspiCopy(u32 SrcAddr, u64 DestAddr, u32 Length, u32 Flags)
 		"Length 0x%0x, Flags 0x%0x\r\n", SrcAddr, (u32)(DestAddr>>32),
 		(u32)(DestAddr), Length, Flags);
 
+	/*
+	 * Complete a background read first. WAIT_DONE only waits for it,
+	 * other copies must not issue commands while it is in flight.
+	 */
+	Status = XLoader_OspiWaitDone();
+	if ((Status != XLOADER_SUCCESS) ||
+		((Flags & XLOADER_DEVICE_COPY_STATE_MASK) ==
+		XLOADER_DEVICE_COPY_STATE_WAIT_DONE)) {
+		goto END;
+	}
+
 	/*
 	 * Read cmd
 	 */
@@ -297,7 +379,17 @@ XStatus XLoader_OspiCopy(u32 SrcAddr, u64 DestAddr, u32 Length, u32 Flags)
 		FlashMsg.Dummy = 8U;
 	}
 	
-	Status = XOspiPsv_PollTransfer(&OspiPsvInstance, &FlashMsg);
+	if ((Flags & XLOADER_DEVICE_COPY_STATE_MASK) ==
+		XLOADER_DEVICE_COPY_STATE_INITIATE) {
+		OspiXferEvent = XST_SPI_TRANSFER_DONE;
+		Status = (XStatus)XOspiPsv_IntrTransfer(&OspiPsvInstance,
+				&FlashMsg);
+		if (Status == XST_SUCCESS) {
+			OspiCopyPending = TRUE;
+		}
+	} else {
+		Status = XOspiPsv_PollTransfer(&OspiPsvInstance, &FlashMsg);
+	}
 	if (Status != XST_SUCCESS) {
 		Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_OSPI_READ, Status);
 		goto END;
@@ -319,7 +411,15 @@ END:
 int XLoader_OspiRelease(void)
 {
 	int Status = XST_FAILURE;
+
+	/* Do not leave a background read running past the image load */
+	Status = XLoader_OspiWaitDone();
+	if (Status != XLOADER_SUCCESS) {
+		goto END;
+	}
 	Status = XLoader_FlashEnterExit4BAddMode(&OspiPsvInstance, 0U);
+
+END:
 	return Status;
 }
 
@@ -35,6 +35,11 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   02/21/2017 Initial release
+*       ag   10/16/2026 Double buffered chunk copy for all boot devices and
+*                       per stage timing of CDO partitions
+*       ag   10/16/2026 Double buffer only devices which copy in the
+*                       background, prefetch secure blocks
+*       ag   10/16/2026 Print secure phase times of CDO partitions
 *
 * </pre>
 *
@@ -54,6 +59,20 @@
 /************************** Constant Definitions *****************************/
 
 /**************************** Type Definitions *******************************/
+/**
+ * Time spent in each stage of CDO partition processing, in PIT ticks.
+ * Copy is the time the PLM waited for chunk copies. With double buffering
+ * it is only the part of the copies which was not hidden behind the
+ * processing of the previous chunk.
+ */
+typedef struct {
+	u64 Copy; /**< Waiting for non secure chunk copies */
+	u64 SecureCopy; /**< Waiting for secure block copies */
+	u64 Secure; /**< Authentication and decryption */
+	u64 Exec; /**< CDO command execution */
+	u32 Chunks; /**< Number of chunks processed */
+	u32 Prefetched; /**< Chunks copied while the previous one executed */
+} XLoader_CdoPerf;
 
 /***************** Macros (Inline Functions) Definitions *********************/
 #define XLOADER_SUCCESS_NOT_PRTN_OWNER	(0x100U)
@@ -65,6 +84,7 @@ static int XLoader_PrtnValidation(XilPdi* PdiPtr, u32 PrtnNum);
 static int XLoader_CheckHandoffCpu (XilPdi* PdiPtr, u32 DstnCpu);
 static void XLoader_UpdateHandoffParam(XilPdi* PdiPtr, u32 PrtnNum);
 static int XLoader_GetLoadAddr(u32 DstnCpu, u64 *LoadAddrPtr, u32 Len);
+static void XLoader_PrintCdoPerf(const XLoader_CdoPerf *Perf, u64 StartTime);
 
 /************************** Variable Definitions *****************************/
 
@@ -566,6 +586,16 @@ END:
  * This function is used to process the CDO partition. It copies and
  * validates if security is enabled.
  *
+ * For boot devices which copy in the background (XLOADER_IS_COPY_ASYNC),
+ * non secure chunks are double buffered between XLOADER_CHUNK_MEMORY and
+ * XLOADER_CHUNK_MEMORY_1. The copy of the next chunk is initiated before
+ * the current chunk is executed and waited for before the next chunk is
+ * executed. Secure blocks are 64K, so they alternate between
+ * XLOADER_CHUNK_MEMORY and XLOADER_SECURE_CHUNK_MEMORY_1 and the copy of
+ * the next block runs while the current block is authenticated, decrypted
+ * and executed, refer XLoader_SecurePrtn. The other devices copy and
+ * process each chunk in turn, with full size chunks.
+ *
  * @param	PdiPtr is pointer to the Plm Instance
  *
  * @param	PrtnNum is the partition number in the image to be loaded
@@ -588,9 +618,14 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 	u32 LastChunk = FALSE;
 	u32 ChunkAddr = XLOADER_CHUNK_MEMORY;
 	u32 IsNextChunkCopyStarted = FALSE;
+	u32 IsCopyAsync;
 	XLoader_SecureParms SecureParams = {0U};
+	XLoader_CdoPerf Perf = {0U};
+	u64 CdoStartTime;
+	u64 StageStartTime;
 
 	XPlmi_Printf(DEBUG_INFO, "Processing CDO partition \n\r");
+	CdoStartTime = XPlmi_GetTimerValue();
 	/* Secure init */
 	Status = XLoader_SecureInit(&SecureParams, PdiPtr, PrtnNum);
 	if (Status != XST_SUCCESS) {
@@ -627,10 +662,12 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 
 	/**
 	 * Process CDO in chunks.
-	 * Chunk size is based on the available PRAM size.
+	 * Chunk size is based on the available PRAM size. Non secure
+	 * chunks are double buffered if the device copies in the
+	 * background, so each of them is half the size.
 	 */
-	if ((PdiPtr->PdiSrc == XLOADER_PDI_SRC_DDR) &&
-		(SecureParams.SecureEn != TRUE))
+	IsCopyAsync = XLOADER_IS_COPY_ASYNC(PdiPtr->PdiSrc);
+	if ((SecureParams.SecureEn != TRUE) && (IsCopyAsync == TRUE))
 	{
 		ChunkLen = XLOADER_CHUNK_SIZE/2;
 	} else {
@@ -638,6 +675,7 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 	}
 
 	SecureParams.IsCdo = TRUE;
+	SecureParams.IsPrefetchEn = IsCopyAsync;
 	while (Len > 0U)
 	{
 		/** Update the len for last chunk */
@@ -648,26 +686,32 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 		}
 
 		if (SecureParams.SecureEn != TRUE) {
+			StageStartTime = XPlmi_GetTimerValue();
 			if (IsNextChunkCopyStarted == TRUE)
 			{
 				IsNextChunkCopyStarted = FALSE;
 				/** wait for copy to get completed */
-				PdiPtr->DeviceCopy(SrcAddr,
+				Status = PdiPtr->DeviceCopy(SrcAddr,
 				  ChunkAddr, ChunkLen,
 				  XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
 			} else {
 				/** Copy the data to PRAM buffer */
-				PdiPtr->DeviceCopy(SrcAddr, ChunkAddr, ChunkLen, 0U);
+				Status = PdiPtr->DeviceCopy(SrcAddr, ChunkAddr,
+					ChunkLen, XLOADER_DEVICE_COPY_STATE_BLK);
+			}
+			Perf.Copy += StageStartTime - XPlmi_GetTimerValue();
+			if (Status != XST_SUCCESS) {
+				goto END;
 			}
 			/** Update variables for next chunk */
 			Cdo.BufPtr = (u32 *)ChunkAddr;
 			Cdo.BufLen = ChunkLen/XIH_PRTN_WORD_LEN;
 			SrcAddr += ChunkLen;
 			Len -= ChunkLen;
-			/** For DDR case, start the copy of the
-			 * next chunk for increasing performance */
-			if ((PdiPtr->PdiSrc == XLOADER_PDI_SRC_DDR)
-			    && (LastChunk != TRUE))
+			/** Start the copy of the next chunk to the other
+			 * buffer, so that it runs while this chunk is
+			 * processed */
+			if ((LastChunk != TRUE) && (IsCopyAsync == TRUE))
 			{
 				/** Update the next chunk address to other part */
 				if (ChunkAddr == XLOADER_CHUNK_MEMORY) {
@@ -682,17 +726,26 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 					LastChunk = TRUE;
 					ChunkLen = Len;
 				}
-				IsNextChunkCopyStarted = TRUE;
 
 				/** Initiate the data copy */
-				PdiPtr->DeviceCopy(SrcAddr,
+				StageStartTime = XPlmi_GetTimerValue();
+				Status = PdiPtr->DeviceCopy(SrcAddr,
 					   ChunkAddr, ChunkLen,
 					   XLOADER_DEVICE_COPY_STATE_INITIATE);
+				Perf.Copy += StageStartTime -
+					XPlmi_GetTimerValue();
+				if (Status != XST_SUCCESS) {
+					goto END;
+				}
+				IsNextChunkCopyStarted = TRUE;
+				Perf.Prefetched++;
 			}
 		} else {
 			/* Call security function */
+			StageStartTime = XPlmi_GetTimerValue();
 			Status = XLoader_SecurePrtn(&SecureParams,
 				SecureParams.SecureData, ChunkLen, LastChunk);
+			Perf.Secure += StageStartTime - XPlmi_GetTimerValue();
 			if(Status != XST_SUCCESS)
 			{
 				goto END;
@@ -704,18 +757,73 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 		}
 
 		/** Process the chunk */
+		StageStartTime = XPlmi_GetTimerValue();
 		Status = XPlmi_ProcessCdo(&Cdo);
+		Perf.Exec += StageStartTime - XPlmi_GetTimerValue();
+		Perf.Chunks++;
 		if(Status != XST_SUCCESS)
 		{
 			goto END;
 		}
 
 	}
+
+	/* The copy wait of secure blocks is accounted inside SecurePrtn */
+	Perf.SecureCopy = SecureParams.Perf.CopyWait;
+	Perf.Secure -= SecureParams.Perf.CopyWait;
+	Perf.Prefetched += SecureParams.Perf.Prefetched;
+	XLoader_PrintCdoPerf(&Perf, CdoStartTime);
+	if (SecureParams.SecureEn == TRUE) {
+		XLoader_PrintSecurePerf(&SecureParams);
+	}
 	Status = XST_SUCCESS;
 END:
+	/** Do not leave a chunk copy in flight on error */
+	if (IsNextChunkCopyStarted == TRUE) {
+		(void)PdiPtr->DeviceCopy(SrcAddr, ChunkAddr, ChunkLen,
+			XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
+	}
+	if (SecureParams.SecureEn == TRUE) {
+		(void)XLoader_SecureStopPrefetch(&SecureParams);
+	}
 	return Status;
 }
 
+/****************************************************************************/
+/**
+ * This function prints the time spent in each stage of CDO partition
+ * processing when PLM_PRINT_PERF_CDO is defined.
+ *
+ * @param	Perf is pointer to the stage times
+ *
+ * @param	StartTime is the time at which the partition processing started
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XLoader_PrintCdoPerf(const XLoader_CdoPerf *Perf, u64 StartTime)
+{
+#ifdef PLM_PRINT_PERF_CDO
+	u64 EndTime = XPlmi_GetTimerValue();
+
+	XPlmi_Printf(DEBUG_PRINT_PERF, "CDO chunks: %d, prefetched: %d\n\r",
+			Perf->Chunks, Perf->Prefetched);
+	XPlmi_PrintTime(Perf->Copy, 0U);
+	XPlmi_Printf(DEBUG_PRINT_PERF, ": Copy wait\n\r");
+	XPlmi_PrintTime(Perf->SecureCopy, 0U);
+	XPlmi_Printf(DEBUG_PRINT_PERF, ": Secure copy wait\n\r");
+	XPlmi_PrintTime(Perf->Secure, 0U);
+	XPlmi_Printf(DEBUG_PRINT_PERF, ": Authentication and decryption\n\r");
+	XPlmi_PrintTime(Perf->Exec, 0U);
+	XPlmi_Printf(DEBUG_PRINT_PERF, ": CDO execution\n\r");
+	XPlmi_PrintTime(StartTime, EndTime);
+	XPlmi_Printf(DEBUG_PRINT_PERF, ": CDO partition total\n\r");
+#else
+	(void)Perf;
+	(void)StartTime;
+#endif
+}
+
 /****************************************************************************/
 /**
  * This function is used to process the partition. It copies and validates if
@@ -35,6 +35,9 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   02/21/2018 Initial release
 *       har  08/28/2018 Fixed MISRA C violations
+*       ag   10/16/2026 Treat the WAIT_DONE copy state as a no-op
+*       ag   10/16/2026 Run the last read of an INITIATE copy in the
+*                       background and complete it on WAIT_DONE
 * </pre>
 *
 * @note
@@ -62,6 +65,10 @@
 
 /************************** Function Prototypes ******************************/
 static int FlashReadID(XQspiPsu *QspiPsuPtr);
+static void XLoader_QspiStatusHandler(const void *CallBackRef,
+		u32 StatusEvent, u32 ByteCount);
+static int XLoader_QspiReadXfer(u32 IsLast, u32 Flags);
+static int XLoader_QspiWaitDone(void);
 
 /************************** Variable Definitions *****************************/
 static XQspiPsu QspiPsuInstance;
@@ -70,6 +77,8 @@ static u32 QspiFlashMake=0U;
 static u32 ReadCommand=0U;
 static XQspiPsu_Msg FlashMsg[5];
 static u8 IssiIdFlag=0U;
+static u8 QspiCopyPending = FALSE;
+static volatile u32 QspiXferEvent = XST_SPI_TRANSFER_DONE;
 
 static u8 TxBfrPtr __attribute__ ((aligned(32)));
 static u8 ReadBuffer[10] __attribute__ ((aligned(32)));
@@ -224,6 +233,13 @@ int XLoader_Qspi24Init(u32 DeviceFlags)
 		goto END;
 	}
 
+	/*
+	 * Background reads are completed by polling the interrupt handler
+	 */
+	XQspiPsu_SetStatusHandler(&QspiPsuInstance, NULL,
+			XLoader_QspiStatusHandler);
+	QspiCopyPending = FALSE;
+
 	/*
 	 * Set Manual Start
 	 */
@@ -609,6 +625,99 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * This function records the status events of a background QSPI read. It is
+ * called from XQspiPsu_InterruptHandler, which XLoader_QspiWaitDone polls.
+ *
+ * @param	CallBackRef is unused
+ * @param	StatusEvent is XST_SPI_TRANSFER_DONE or an error event
+ * @param	ByteCount is unused
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XLoader_QspiStatusHandler(const void *CallBackRef,
+		u32 StatusEvent, u32 ByteCount)
+{
+	(void)CallBackRef;
+	(void)ByteCount;
+
+	if (QspiXferEvent == XST_SPI_TRANSFER_DONE) {
+		QspiXferEvent = StatusEvent;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * This function issues the read command set up in FlashMsg. The last read
+ * of a copy issued with the INITIATE state is started in the background
+ * and is completed by XLoader_QspiWaitDone, all other reads are polled.
+ *
+ * @param	IsLast is TRUE for the last read of a copy
+ * @param	Flags is the copy state passed to the copy function
+ *
+ * @return	XST_SUCCESS on success, driver error code otherwise
+ *
+ *****************************************************************************/
+static int XLoader_QspiReadXfer(u32 IsLast, u32 Flags)
+{
+	int Status;
+
+	if ((IsLast == TRUE) && ((Flags & XLOADER_DEVICE_COPY_STATE_MASK) ==
+		XLOADER_DEVICE_COPY_STATE_INITIATE)) {
+		QspiXferEvent = XST_SPI_TRANSFER_DONE;
+		Status = XQspiPsu_InterruptTransfer(&QspiPsuInstance,
+				&FlashMsg[0], 3);
+		if (Status == XST_SUCCESS) {
+			QspiCopyPending = TRUE;
+		}
+	} else {
+		Status = XQspiPsu_PolledTransfer(&QspiPsuInstance,
+				&FlashMsg[0], 3);
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function waits for a background read started by an INITIATE copy.
+ * The QSPI interrupt is not connected in the PLM, so the driver interrupt
+ * handler is polled until the transfer is complete.
+ *
+ * @param	None
+ *
+ * @return
+ *		- XLOADER_SUCCESS if no read is pending or it completed
+ *		- XLOADER_ERR_QSPI_READ if the read failed
+ *
+ *****************************************************************************/
+static int XLoader_QspiWaitDone(void)
+{
+	int Status = XLOADER_SUCCESS;
+
+	if (QspiCopyPending != TRUE) {
+		goto END;
+	}
+
+	while ((QspiPsuInstance.IsBusy == TRUE) &&
+		(QspiXferEvent == XST_SPI_TRANSFER_DONE)) {
+		(void)XQspiPsu_InterruptHandler(&QspiPsuInstance);
+	}
+	QspiCopyPending = FALSE;
+
+	if (QspiXferEvent != XST_SPI_TRANSFER_DONE) {
+		XQspiPsu_Abort(&QspiPsuInstance);
+		Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_QSPI_READ,
+				QspiXferEvent);
+		XLoader_Printf(DEBUG_GENERAL,"XLOADER_ERR_QSPI_READ\r\n");
+	}
+
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * This function is used to copy the data from QSPI flash to destination
@@ -644,6 +753,17 @@ XStatus XLoader_Qspi24Copy(u32 SrcAddr, u64 DestAddr, u32 Length, u32 Flags)
 			SrcAddr, (u32)(DestAddr>>32), (u32)DestAddr,
 		       Length, Flags);
 
+	/*
+	 * Complete a background read first. WAIT_DONE only waits for it,
+	 * other copies must not issue commands while it is in flight.
+	 */
+	Status = XLoader_QspiWaitDone();
+	if ((Status != XLOADER_SUCCESS) ||
+		((Flags & XLOADER_DEVICE_COPY_STATE_MASK) ==
+		XLOADER_DEVICE_COPY_STATE_WAIT_DONE)) {
+		goto END;
+	}
+
 	/* Set QSPI DMA in AXI FIXED / INCR mode.
 	 * Fixed mode is used for CFI loading */
 
@@ -806,7 +926,9 @@ XStatus XLoader_Qspi24Copy(u32 SrcAddr, u64 DestAddr, u32 Length, u32 Flags)
 		 * of bytes from the Flash, send the read command and address and
 		 * receive the specified number of bytes of data in the data buffer
 		 */
-		Status = XQspiPsu_PolledTransfer(&QspiPsuInstance, &FlashMsg[0], 3);
+		Status = XLoader_QspiReadXfer(
+				(RemainingBytes == TransferBytes) ? TRUE : FALSE,
+				Flags);
 		if (Status != XLOADER_SUCCESS) {
 			Status = XPLMI_UPDATE_STATUS(
 				XLOADER_ERR_QSPI_READ, Status);
@@ -855,7 +977,10 @@ END:
  *****************************************************************************/
 int XLoader_Qspi24Release(void)
 {
-	int Status = XLOADER_SUCCESS;
+	int Status;
+
+	/* Do not leave a background read running past the image load */
+	Status = XLoader_QspiWaitDone();
 
 	return Status;
 }
@@ -899,6 +1024,13 @@ int XLoader_Qspi32Init(u32 DeviceFlags)
 		goto END;
 	}
 
+	/*
+	 * Background reads are completed by polling the interrupt handler
+	 */
+	XQspiPsu_SetStatusHandler(&QspiPsuInstance, NULL,
+			XLoader_QspiStatusHandler);
+	QspiCopyPending = FALSE;
+
 	/*
 	 * Set Manual Start
 	 */
@@ -1088,6 +1220,17 @@ XStatus XLoader_Qspi32Copy(u32 SrcAddr, u64 DestAddr, u32 Length, u32 Flags)
 			SrcAddr, (u32)(DestAddr>>32), (u32)DestAddr,
 		       Length, Flags);
 
+	/*
+	 * Complete a background read first. WAIT_DONE only waits for it,
+	 * other copies must not issue commands while it is in flight.
+	 */
+	Status = XLoader_QspiWaitDone();
+	if ((Status != XLOADER_SUCCESS) ||
+		((Flags & XLOADER_DEVICE_COPY_STATE_MASK) ==
+		XLOADER_DEVICE_COPY_STATE_WAIT_DONE)) {
+		goto END;
+	}
+
 	/* Set QSPI DMA in AXI FIXED / INCR mode.
 	 * Fixed mode is used for CFI loading */
 
@@ -1205,7 +1348,9 @@ XStatus XLoader_Qspi32Copy(u32 SrcAddr, u64 DestAddr, u32 Length, u32 Flags)
 		 * of bytes from the Flash, send the read command and address and
 		 * receive the specified number of bytes of data in the data buffer
 		 */
-		Status = XQspiPsu_PolledTransfer(&QspiPsuInstance, &FlashMsg[0], 3);
+		Status = XLoader_QspiReadXfer(
+				(RemainingBytes == TransferBytes) ? TRUE : FALSE,
+				Flags);
 		if (Status != XLOADER_SUCCESS) {
 			Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_QSPI_READ, 0x0);
 			XLoader_Printf(DEBUG_GENERAL,"XLOADER_ERR_QSPI_READ\r\n");
@@ -1236,7 +1381,10 @@ END:
  *****************************************************************************/
 int XLoader_Qspi32Release(void)
 {
-	int Status = XLOADER_SUCCESS;
+	int Status;
+
+	/* Do not leave a background read running past the image load */
+	Status = XLoader_QspiWaitDone();
 
 	return Status;
 }
@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   09/21/2017 Initial release
+*       ag   10/16/2026 Do not pass copy states to the DMA as flags
 *
 * </pre>
 *
@@ -181,9 +182,21 @@ XStatus XLoader_SbiCopy(u32 SrcAddress, u64 DestAddress, u32 Length, u32 Flags)
 	 */
 	(void) (SrcAddress);
 
-	ReadFlags = Flags | XPLMI_PMCDMA_1;
+	/**
+	 * SBI copies are always completed on INITIATE. Readback commands in
+	 * the CDO being executed switch the SBI direction and use PMCDMA1,
+	 * so no SBI transfer may be left in flight across CDO execution.
+	 */
+	if ((Flags & XLOADER_DEVICE_COPY_STATE_MASK) ==
+		XLOADER_DEVICE_COPY_STATE_WAIT_DONE) {
+		Status = XLOADER_SUCCESS;
+		goto END;
+	}
+
+	ReadFlags = (Flags & ~XLOADER_DEVICE_COPY_STATE_MASK) | XPLMI_PMCDMA_1;
 	Status = XPlmi_SbiDmaXfer(DestAddress, Length/4, ReadFlags);
 
+END:
 	return Status;
 }
 
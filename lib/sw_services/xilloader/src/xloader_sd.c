@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   09/21/2017 Initial release
+*       ag   10/16/2026 Treat the WAIT_DONE copy state as a no-op
 *
 * </pre>
 *
@@ -273,9 +274,18 @@ XStatus XLoader_SdCopy(u32 SrcAddress, u64 DestAddress, u32 Length, u32 Flags)
 	int Status = XST_FAILURE;
 
 	FRESULT rc;	 /* Result code */
-	(void) Flags;
 	UINT br=0U;
 
+	/*
+	 * FatFs has no split read, so the copy is completed on INITIATE and
+	 * WAIT_DONE has nothing left to wait for
+	 */
+	if ((Flags & XLOADER_DEVICE_COPY_STATE_MASK) ==
+		XLOADER_DEVICE_COPY_STATE_WAIT_DONE) {
+		Status = XLOADER_SUCCESS;
+		goto END;
+	}
+
 	rc = f_lseek(&fil, SrcAddress);
 	if (rc != FR_OK) {
 		XLoader_Printf(DEBUG_INFO,
@@ -37,6 +37,10 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.0   vns  04/23/19 First release
 *       har  08/22/19 Fixed MISRA C violations
+*       ag   10/16/26 Overlapped block copy with hash calculation
+*       ag   10/16/26 Added streaming of encrypted blocks and phase times
+*       ag   10/16/26 Prefetch the next block of CDO partitions while the
+*                     current block is verified, decrypted and executed
 * </pre>
 *
 * @note
@@ -56,8 +60,29 @@
 
 /************************** Function Prototypes ******************************/
 
-static u32 XLoader_VerifyHash(XLoader_SecureParms *SecurePtr, u32 Size,
-						u8 Last);
+static u32 XLoader_VerifyHash(XLoader_SecureParms *SecurePtr, u32 SrcAddr,
+						u32 Size, u8 Last);
+static u32 XLoader_CopyNHash(XLoader_SecureParms *SecurePtr,
+		XSecure_Sha3 *Sha3InstancePtr, u32 SrcAddr, u32 Size);
+static u32 XLoader_StartHash(XLoader_SecureParms *SecurePtr,
+		XSecure_Sha3 *Sha3InstancePtr, XCsuDma *CsuDmaPtr);
+static u32 XLoader_CheckHash(XLoader_SecureParms *SecurePtr,
+		XSecure_Sha3 *Sha3InstancePtr, u8 Last);
+static u32 XLoader_ProcessBlk(XLoader_SecureParms *SecurePtr, u32 SrcAddr,
+		u32 Size, u64 DstAddr, u8 Last);
+static u32 XLoader_StartPrefetch(XLoader_SecureParms *SecurePtr, u32 Size,
+		u8 Last);
+static u32 XLoader_EndPrefetch(XLoader_SecureParms *SecurePtr, u32 SrcAddr,
+		u32 Size);
+static u32 XLoader_StreamBlk(XLoader_SecureParms *SecurePtr, u32 SrcAddr,
+		u32 Size, u8 Last);
+static u32 XLoader_StreamStart(XLoader_SecureParms *SecurePtr, u32 SrcAddr,
+		u32 Size, XSecure_Sha3 *Sha3InstancePtr);
+static u32 XLoader_StreamNext(XLoader_SecureParms *SecurePtr);
+static u32 XLoader_StreamWait(XLoader_SecureParms *SecurePtr, u64 Addr);
+static void XLoader_StreamEnd(XLoader_SecureParms *SecurePtr);
+static u32 XLoader_AesDecryptUpdate(XLoader_SecureParms *SecurePtr,
+		XSecure_Aes *AesInstancePtr, u64 InAddr, u64 OutAddr, u32 Size);
 static u32 XLoader_RsaPssSignatureverification(
 		XLoader_SecureParms *SecurePtr,
 		XSecure_Rsa *RsaInstancePtr,
@@ -118,6 +143,9 @@ u32 XLoader_SecureInit(XLoader_SecureParms *SecurePtr, XilPdi *PdiPtr,
 	u32 AcOffset;
 
 	memset(SecurePtr, 0, sizeof(XLoader_SecureParms));
+#ifdef PLM_SECURE_STREAM
+	SecurePtr->IsStreamEn = TRUE;
+#endif
 
 	/* Assign the partition header to local variable */
 	PrtnHdr = &(PdiPtr->MetaHdr.PrtnHdr[PrtnNum]);
@@ -255,6 +283,7 @@ u32 XLoader_SecureCopy(XLoader_SecureParms *SecurePtr, u64 DestAddr, u32 Size)
 			break;
 		}
 	}
+	XLoader_PrintSecurePerf(SecurePtr);
 
 END:
 	if (Status != XST_SUCCESS) {
@@ -298,7 +327,6 @@ u32 XLoader_SecurePrtn(XLoader_SecureParms *SecurePtr, u64 DstAddr,
 	u32 ClrStatus = (u32)XST_FAILURE;
 	u32 TotalSize = BlockSize;
 	u32 SrcAddr;
-	u64 OutAddr;
 
 	XPlmi_Printf(DEBUG_DETAILED,
 			"Processing Block %d \n\r", SecurePtr->BlockNum);
@@ -315,63 +343,126 @@ u32 XLoader_SecurePrtn(XLoader_SecureParms *SecurePtr, u64 DstAddr,
 		SrcAddr = SecurePtr->NextBlkAddr;
 	}
 
+	if (SecurePtr->IsEncrypted == TRUE) {
+		if (Last == TRUE) {
+			TotalSize = SecurePtr->RemainingEncLen;
+		}
+		if ((SecurePtr->BlockNum == 0) && (Last != TRUE)) {
+			/* To include Secure Header */
+			TotalSize = TotalSize + XLOADER_SECURE_HDR_TOTAL_SIZE;
+		}
+	}
+	/*
+	 * If authentication or checksum is enabled, except for the last
+	 * block of data, SHA3 hash(48 bytes) of next block should be
+	 * added for block size
+	 */
+	if (((SecurePtr->IsAuthenticated == TRUE) ||
+		(SecurePtr->IsCheckSumEnabled == TRUE)) && (Last != TRUE)) {
+		TotalSize = TotalSize + XLOADER_SHA3_LEN;
+	}
+	SecurePtr->NextBlkAddr = SrcAddr + TotalSize;
+
+	/* Complete the copy of the block if it was prefetched */
+	Status = XLoader_EndPrefetch(SecurePtr, SrcAddr, TotalSize);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	/*
+	 * Encrypted CDO blocks are copied, hashed and decrypted in one pass.
+	 * They are decrypted in place in the chunk buffer, which is cleared
+	 * below if the hash verification fails. Other partitions would be
+	 * decrypted to their load address before the verification.
+	 */
+	if (XLOADER_IS_STREAM_BLK(SecurePtr) == TRUE) {
+		Status = XLoader_StreamBlk(SecurePtr, SrcAddr, TotalSize, Last);
+	}
+	else {
+		Status = XLoader_ProcessBlk(SecurePtr, SrcAddr, TotalSize,
+				DstAddr, Last);
+	}
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	SecurePtr->BlockNum++;
+
+END:
+	/* Clears whole intermediate buffers on failure */
+	if (Status != XST_SUCCESS) {
+		ClrStatus = XLoader_SecureStopPrefetch(SecurePtr);
+		ClrStatus |= XPlmi_InitNVerifyMem(SecurePtr->ChunkAddr, TotalSize);
+		if (ClrStatus != XST_SUCCESS) {
+				Status = Status | XLOADER_SEC_BUF_CLEAR_ERR;
+		}
+		else {
+			Status = Status | XLOADER_SEC_BUF_CLEAR_SUCCESS;
+		}
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function verifies the hash of a block and then decrypts it, as
+* enabled for the partition.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	SrcAddr		Boot device address of the block.
+* @param	Size		Size of the block in the boot device.
+* @param	DstAddr		Load address of non CDO partitions.
+* @param	Last		Notifies if the block to be processed is
+*		last or not.
+*
+* @return	XST_SUCCESS on success.
+*
+******************************************************************************/
+static u32 XLoader_ProcessBlk(XLoader_SecureParms *SecurePtr, u32 SrcAddr,
+		u32 Size, u64 DstAddr, u8 Last)
+{
+	u32 Status = (u32)XST_SUCCESS;
+	u64 OutAddr;
+	u64 StartTime;
+
 	/*
 	 * If authentication or checksum is enabled validate the data hash
 	 * with expected hash
 	 */
 	if ((SecurePtr->IsAuthenticated == TRUE) ||
 			(SecurePtr->IsCheckSumEnabled == TRUE)) {
-		 if (SecurePtr->IsEncrypted == TRUE) {
-			if (Last == TRUE) {
-				TotalSize = SecurePtr->RemainingEncLen;
-			}
-			if ((SecurePtr->BlockNum == 0) && (Last == FALSE)) {
-				/* To include Secure Header */
-				TotalSize = TotalSize + XLOADER_SECURE_HDR_TOTAL_SIZE;
-			}
-		 }
-		 /*
-		 * Except for the last block of data,
-		 * SHA3 hash(48 bytes) of next block should
-		 * be added for block size
-		 */
-		if (Last != TRUE) {
-			TotalSize = TotalSize + XLOADER_SHA3_LEN;
-		}
-
-		/* Copy to total data to the buffer */
-		SecurePtr->PdiPtr->DeviceCopy(SrcAddr,
-				SecurePtr->ChunkAddr, TotalSize, 0U);
-
-		/* Verify hash */
-		Status = XLoader_VerifyHash(SecurePtr, TotalSize, Last);
+		/* Copy total data to the buffer and verify hash */
+		Status = XLoader_VerifyHash(SecurePtr, SrcAddr, Size, Last);
 		if (Status != XST_SUCCESS) {
 			goto END;
 		}
-
-		if (Last != TRUE) {
-			SecurePtr->NextBlkAddr = SrcAddr + TotalSize;
-		}
 	}
 
 	/* If encryption is enabled */
 	if (SecurePtr->IsEncrypted == TRUE) {
 
 		if (SecurePtr->IsAuthenticated != TRUE) {
-			if (Last == TRUE) {
-				TotalSize = SecurePtr->RemainingEncLen;
-			}
 			/* Copy to total data to the buffer */
-			if ((SecurePtr->BlockNum == 0) && (Last != TRUE)) {
-				/* Secure header is extra here */
-				TotalSize = TotalSize + XLOADER_SECURE_HDR_TOTAL_SIZE;
+			if (SecurePtr->IsBlkCopied != TRUE) {
+				StartTime = XPlmi_GetTimerValue();
+				Status = (u32)SecurePtr->PdiPtr->DeviceCopy(
+					SrcAddr, SecurePtr->ChunkAddr, Size, 0U);
+				SecurePtr->Perf.CopyWait += StartTime -
+					XPlmi_GetTimerValue();
+				if (Status != XST_SUCCESS) {
+					goto END;
+				}
 			}
-
-			SecurePtr->PdiPtr->DeviceCopy(SrcAddr,
-				SecurePtr->ChunkAddr, TotalSize, 0U);
 			SecurePtr->SecureData = SecurePtr->ChunkAddr;
-			SecurePtr->SecureDataLen = TotalSize;
-			SecurePtr->NextBlkAddr = SrcAddr + TotalSize;
+			SecurePtr->SecureDataLen = Size;
+
+			/* Copy the next block while this one is decrypted */
+			Status = XLoader_StartPrefetch(SecurePtr, Size, Last);
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
 		}
 
 		if (SecurePtr->IsCdo != TRUE) {
@@ -380,28 +471,195 @@ u32 XLoader_SecurePrtn(XLoader_SecureParms *SecurePtr, u64 DstAddr,
 		else {
 			OutAddr = SecurePtr->SecureData;
 		}
+		StartTime = XPlmi_GetTimerValue();
 		Status = XLoader_AesDecryption(SecurePtr,
 				SecurePtr->SecureData, OutAddr, SecurePtr->SecureDataLen);
+		SecurePtr->Perf.Decrypt += StartTime - XPlmi_GetTimerValue();
 		if (Status != XST_SUCCESS) {
 			goto END;
 		}
 
 	}
 
-	SecurePtr->BlockNum++;
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function initiates the copy of the next block of a CDO partition to
+* the other chunk buffer, once the current block is in its chunk buffer. The
+* copy runs while the current block is verified, decrypted and executed.
+* Only the part of the other buffer which does not overlap the current block
+* is copied, the rest is copied by XLoader_EndPrefetch. The size of the next
+* block is not known yet for encrypted partitions, so up to
+* XLOADER_SECURE_BLK_MAX_SIZE bytes are copied, within the partition.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	Size		Size of the current block in the boot device.
+* @param	Last		Notifies if the current block is last or not.
+*
+* @return	XST_SUCCESS on success.
+*
+******************************************************************************/
+static u32 XLoader_StartPrefetch(XLoader_SecureParms *SecurePtr, u32 Size,
+		u8 Last)
+{
+	u32 Status = (u32)XST_SUCCESS;
+	XLoader_SecurePrefetch *PfPtr = &SecurePtr->Prefetch;
+	u32 BlkEnd = SecurePtr->ChunkAddr + Size;
+	u32 PrtnEnd;
+	u32 BufAddr;
+	u32 Ofst;
+	u32 End;
+	u64 StartTime;
+
+	if ((SecurePtr->IsPrefetchEn != TRUE) || (Last == TRUE) ||
+		(PfPtr->Len != 0U)) {
+		goto END;
+	}
+
+	if (SecurePtr->ChunkAddr == XLOADER_CHUNK_MEMORY) {
+		BufAddr = XLOADER_SECURE_CHUNK_MEMORY_1;
+		Ofst = 0U;
+		if (BlkEnd > BufAddr) {
+			Ofst = BlkEnd - BufAddr;
+		}
+		End = XLOADER_SECURE_BLK_MAX_SIZE;
+	}
+	else {
+		BufAddr = XLOADER_CHUNK_MEMORY;
+		Ofst = 0U;
+		End = XLOADER_SECURE_BLK_MAX_SIZE;
+		if (SecurePtr->ChunkAddr < (BufAddr + End)) {
+			End = SecurePtr->ChunkAddr - BufAddr;
+		}
+	}
+
+	/* Do not read beyond the partition */
+	PrtnEnd = SecurePtr->PdiPtr->MetaHdr.FlashOfstAddr +
+		((SecurePtr->PrtnHdr->DataWordOfst +
+		SecurePtr->PrtnHdr->TotalDataWordLen) * XIH_PRTN_WORD_LEN);
+	if (SecurePtr->NextBlkAddr >= PrtnEnd) {
+		goto END;
+	}
+	if ((PrtnEnd - SecurePtr->NextBlkAddr) < End) {
+		End = PrtnEnd - SecurePtr->NextBlkAddr;
+	}
+	if (End <= Ofst) {
+		goto END;
+	}
+
+	StartTime = XPlmi_GetTimerValue();
+	Status = (u32)SecurePtr->PdiPtr->DeviceCopy(SecurePtr->NextBlkAddr + Ofst,
+			(u64)BufAddr + Ofst, End - Ofst,
+			XLOADER_DEVICE_COPY_STATE_INITIATE);
+	SecurePtr->Perf.CopyWait += StartTime - XPlmi_GetTimerValue();
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+	PfPtr->BufAddr = BufAddr;
+	PfPtr->Ofst = Ofst;
+	PfPtr->Len = End - Ofst;
 
 END:
-	/* Clears whole intermediate buffers on failure */
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function waits for the prefetch of a block and copies the parts of
+* the block which were not prefetched. The block is then processed in the
+* buffer it was prefetched to. A block which does not fit in that buffer
+* is copied to XLOADER_CHUNK_MEMORY as if it was not prefetched.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	SrcAddr		Boot device address of the block.
+* @param	Size		Size of the block in the boot device.
+*
+* @return	XST_SUCCESS on success.
+*
+******************************************************************************/
+static u32 XLoader_EndPrefetch(XLoader_SecureParms *SecurePtr, u32 SrcAddr,
+		u32 Size)
+{
+	u32 Status = (u32)XST_SUCCESS;
+	XLoader_SecurePrefetch *PfPtr = &SecurePtr->Prefetch;
+	u32 End = PfPtr->Ofst + PfPtr->Len;
+	u64 StartTime = XPlmi_GetTimerValue();
+
+	SecurePtr->IsBlkCopied = FALSE;
+	SecurePtr->ChunkAddr = XLOADER_CHUNK_MEMORY;
+	if (PfPtr->Len == 0U) {
+		goto END;
+	}
+
+	Status = (u32)SecurePtr->PdiPtr->DeviceCopy(SrcAddr + PfPtr->Ofst,
+			(u64)PfPtr->BufAddr + PfPtr->Ofst, PfPtr->Len,
+			XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
 	if (Status != XST_SUCCESS) {
-		ClrStatus = XPlmi_InitNVerifyMem(SecurePtr->ChunkAddr, TotalSize);
-		if (ClrStatus != XST_SUCCESS) {
-				Status = Status | XLOADER_SEC_BUF_CLEAR_ERR;
+		goto END;
+	}
+	PfPtr->Len = 0U;
+	if ((PfPtr->BufAddr + Size) > XIH_BH_PRAM_ADDR) {
+		goto END;
+	}
+
+	SecurePtr->ChunkAddr = PfPtr->BufAddr;
+	if (PfPtr->Ofst != 0U) {
+		Status = (u32)SecurePtr->PdiPtr->DeviceCopy(SrcAddr,
+				SecurePtr->ChunkAddr, PfPtr->Ofst,
+				XLOADER_DEVICE_COPY_STATE_BLK);
+		if (Status != XST_SUCCESS) {
+			goto END;
 		}
-		else {
-			Status = Status | XLOADER_SEC_BUF_CLEAR_SUCCESS;
+	}
+	if (End < Size) {
+		Status = (u32)SecurePtr->PdiPtr->DeviceCopy(SrcAddr + End,
+				(u64)SecurePtr->ChunkAddr + End, Size - End,
+				XLOADER_DEVICE_COPY_STATE_BLK);
+		if (Status != XST_SUCCESS) {
+			goto END;
 		}
 	}
+	SecurePtr->IsBlkCopied = TRUE;
+	SecurePtr->Perf.Prefetched++;
 
+END:
+	SecurePtr->Perf.CopyWait += StartTime - XPlmi_GetTimerValue();
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function waits for a prefetch which is still in flight and clears
+* the prefetched data. It is called when the partition fails.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+*
+* @return	XST_SUCCESS if no prefetched data is left.
+*
+******************************************************************************/
+u32 XLoader_SecureStopPrefetch(XLoader_SecureParms *SecurePtr)
+{
+	u32 Status = (u32)XST_SUCCESS;
+	XLoader_SecurePrefetch *PfPtr = &SecurePtr->Prefetch;
+
+	if (PfPtr->Len == 0U) {
+		goto END;
+	}
+
+	(void)SecurePtr->PdiPtr->DeviceCopy(SecurePtr->NextBlkAddr + PfPtr->Ofst,
+			(u64)PfPtr->BufAddr + PfPtr->Ofst, PfPtr->Len,
+			XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
+	Status = XPlmi_InitNVerifyMem((u64)PfPtr->BufAddr + PfPtr->Ofst,
+			PfPtr->Len);
+	PfPtr->Len = 0U;
+
+END:
 	return Status;
 }
 
@@ -703,7 +961,12 @@ RET:
 * For checksum and authentication(after first block), hash is calculated on block
 * of data and compared with the expected hash.
 *
+* The block is copied from the boot device to the chunk buffer while it is
+* being hashed, refer XLoader_CopyNHash, unless it was prefetched. Once it
+* is copied the prefetch of the next block is initiated.
+*
 * @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	SrcAddr		Boot device address of the data block.
 * @param	Size		Size of the data block to be processed
 *		which includes padding lengths and hash.
 * @param	Last		Notifies if the block to be processed is
@@ -712,35 +975,90 @@ RET:
 * @return	XST_SUCCESS on success.
 *
 ******************************************************************************/
-static u32 XLoader_VerifyHash(XLoader_SecureParms *SecurePtr,
+static u32 XLoader_VerifyHash(XLoader_SecureParms *SecurePtr, u32 SrcAddr,
 					u32 Size, u8 Last)
 {
-	s32 RetStatus = XST_FAILURE;
 	u32 Status = (u32)XST_FAILURE;
 	XSecure_Sha3 Sha3Instance;
 	u8 *Data = (u8 *)SecurePtr->ChunkAddr;
-	u8 CalHash[XLOADER_SHA3_LEN] = {0};
-	u8 *ExpHash = (u8 *)SecurePtr->Sha3Hash;
-	XCsuDma *CsuDmaPtr = SecurePtr->CsuDmaInstPtr;
+
+	Status = XLoader_StartHash(SecurePtr, &Sha3Instance,
+			SecurePtr->CsuDmaInstPtr);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	Status = XLoader_CopyNHash(SecurePtr, &Sha3Instance, SrcAddr, Size);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	/* Copy the next block while this one is verified and decrypted */
+	Status = XLoader_StartPrefetch(SecurePtr, Size, Last);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	Status = XLoader_CheckHash(SecurePtr, &Sha3Instance, Last);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	/* Update the data location */
+	if (Last == 0x00U) {
+		/* Here Authentication overhead is removed in the chunk */
+		SecurePtr->SecureData = (UINTPTR)Data + XLOADER_SHA3_LEN;
+		SecurePtr->SecureDataLen = Size - XLOADER_SHA3_LEN;
+	}
+	else {
+		/* this is the last block */
+		SecurePtr->SecureData = (UINTPTR)Data;
+		SecurePtr->SecureDataLen = Size;
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function initializes and starts the SHA3 engine for the hash of a
+* block. If authentication is enabled the hash of the first block is
+* calculated on AC + Data, so the AC is hashed here.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	Sha3InstancePtr	Pointer to the SHA3 instance to be started.
+* @param	CsuDmaPtr	Pointer to the PMC DMA used for the hash.
+*
+* @return	XST_SUCCESS on success.
+*
+******************************************************************************/
+static u32 XLoader_StartHash(XLoader_SecureParms *SecurePtr,
+		XSecure_Sha3 *Sha3InstancePtr, XCsuDma *CsuDmaPtr)
+{
+	s32 RetStatus = XST_FAILURE;
+	u32 Status = (u32)XST_FAILURE;
 	XLoader_AuthCertificate *AcPtr=
 		(XLoader_AuthCertificate *)SecurePtr->AcPtr;
+
 	if (CsuDmaPtr == NULL) {
 		Status = XST_FAILURE;
 		goto END;
 	}
 
-	RetStatus = XSecure_Sha3Initialize(&Sha3Instance, CsuDmaPtr);
+	RetStatus = XSecure_Sha3Initialize(Sha3InstancePtr, CsuDmaPtr);
 	if (RetStatus != XST_SUCCESS) {
 		Status = XST_FAILURE;
 		goto END;
 	}
 
-	XSecure_Sha3Start(&Sha3Instance);
+	XSecure_Sha3Start(Sha3InstancePtr);
 
 	/* Hash should be calculated on AC + first chunk */
 	if ((SecurePtr->IsAuthenticated == TRUE) &&
 		(SecurePtr->BlockNum == 0x00U)) {
-		Status = XSecure_Sha3Update(&Sha3Instance,
+		Status = XSecure_Sha3Update(Sha3InstancePtr,
 					(u8 *)AcPtr,
 					XLOADER_AUTH_CERT_MIN_SIZE -
 					XLOADER_PARTITION_SIG_SIZE);
@@ -749,12 +1067,38 @@ static u32 XLoader_VerifyHash(XLoader_SecureParms *SecurePtr,
 		}
 	}
 
-	Status = XSecure_Sha3Update(&Sha3Instance, Data, Size);
-	if (Status != XST_SUCCESS) {
-		goto END;
-	}
+	Status = XST_SUCCESS;
 
-	Status = XSecure_Sha3Finish(&Sha3Instance, CalHash);
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function reads the hash of a block and verifies it. For the first
+* block of an authenticated partition the signature is verified, otherwise
+* the hash is compared with the expected hash. The expected hash is then
+* updated with the hash of the next block, which is at the start of the
+* block in the chunk buffer.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	Sha3InstancePtr	Pointer to the SHA3 instance fed with the block.
+* @param	Last		Notifies if the block is last or not.
+*
+* @return	XST_SUCCESS on success.
+*
+******************************************************************************/
+static u32 XLoader_CheckHash(XLoader_SecureParms *SecurePtr,
+		XSecure_Sha3 *Sha3InstancePtr, u8 Last)
+{
+	u32 Status = (u32)XST_FAILURE;
+	u8 *Data = (u8 *)SecurePtr->ChunkAddr;
+	u8 CalHash[XLOADER_SHA3_LEN] = {0};
+	u8 *ExpHash = (u8 *)SecurePtr->Sha3Hash;
+	u64 StartTime = XPlmi_GetTimerValue();
+
+	Status = XSecure_Sha3Finish(Sha3InstancePtr, CalHash);
 	if (Status != XST_SUCCESS) {
 		goto END;
 	}
@@ -781,17 +1125,116 @@ static u32 XLoader_VerifyHash(XLoader_SecureParms *SecurePtr,
 		}
 	}
 
-	/* Update the next expected hash  and data location */
+	/* Update the next expected hash */
 	if (Last == 0x00U) {
 		(void *)XPlmi_MemCpy(ExpHash, Data, XLOADER_SHA3_LEN);
-		/* Here Authentication overhead is removed in the chunk */
-		SecurePtr->SecureData = (UINTPTR)Data + XLOADER_SHA3_LEN;
-		SecurePtr->SecureDataLen = Size - XLOADER_SHA3_LEN;
 	}
-	else {
-		/* this is the last block */
-		SecurePtr->SecureData = (UINTPTR)Data;
-		SecurePtr->SecureDataLen = Size;
+
+	Status = XST_SUCCESS;
+
+END:
+	SecurePtr->Perf.Verify += StartTime - XPlmi_GetTimerValue();
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function copies a data block from the boot device to the chunk buffer
+* and feeds it to the SHA3 engine in sub blocks of XLOADER_SECURE_SUB_BLK_LEN.
+* The copy of the next sub block is initiated before the current sub block
+* is hashed, so with non blocking boot devices (DDR) the device copy on
+* PMCDMA1 overlaps the hash calculation on PMCDMA0. Data is always hashed
+* from the chunk buffer after its copy has completed. A prefetched block is
+* only hashed.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	Sha3InstancePtr	Pointer to the started SHA3 instance.
+* @param	SrcAddr		Boot device address of the data block.
+* @param	Size		Size of the data block.
+*
+* @return	XST_SUCCESS on success.
+*
+******************************************************************************/
+static u32 XLoader_CopyNHash(XLoader_SecureParms *SecurePtr,
+		XSecure_Sha3 *Sha3InstancePtr, u32 SrcAddr, u32 Size)
+{
+	u32 Status = (u32)XST_FAILURE;
+	u32 HashStatus;
+	XilPdi *PdiPtr = SecurePtr->PdiPtr;
+	u32 Offset = 0U;
+	u32 Len;
+	u32 NextLen;
+	u64 CopyStartTime;
+	u64 HashStartTime;
+
+	if (SecurePtr->IsBlkCopied == TRUE) {
+		HashStartTime = XPlmi_GetTimerValue();
+		Status = XSecure_Sha3Update(Sha3InstancePtr,
+				(u8 *)SecurePtr->ChunkAddr, Size);
+		SecurePtr->Perf.HashWait += HashStartTime -
+			XPlmi_GetTimerValue();
+		goto END;
+	}
+
+	Len = Size;
+	if (Len > XLOADER_SECURE_SUB_BLK_LEN) {
+		Len = XLOADER_SECURE_SUB_BLK_LEN;
+	}
+
+	CopyStartTime = XPlmi_GetTimerValue();
+	Status = (u32)PdiPtr->DeviceCopy(SrcAddr, SecurePtr->ChunkAddr, Len,
+				XLOADER_DEVICE_COPY_STATE_BLK);
+	SecurePtr->Perf.CopyWait += CopyStartTime - XPlmi_GetTimerValue();
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	while (Len != 0U) {
+		NextLen = Size - Offset - Len;
+		if (NextLen > XLOADER_SECURE_SUB_BLK_LEN) {
+			NextLen = XLOADER_SECURE_SUB_BLK_LEN;
+		}
+
+		/* Start the copy of the next sub block */
+		if (NextLen != 0U) {
+			CopyStartTime = XPlmi_GetTimerValue();
+			Status = (u32)PdiPtr->DeviceCopy(SrcAddr + Offset + Len,
+				(u64)SecurePtr->ChunkAddr + Offset + Len,
+				NextLen, XLOADER_DEVICE_COPY_STATE_INITIATE);
+			SecurePtr->Perf.CopyWait += CopyStartTime -
+				XPlmi_GetTimerValue();
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+		}
+
+		HashStartTime = XPlmi_GetTimerValue();
+		HashStatus = XSecure_Sha3Update(Sha3InstancePtr,
+				(u8 *)(SecurePtr->ChunkAddr + Offset), Len);
+		SecurePtr->Perf.HashWait += HashStartTime -
+			XPlmi_GetTimerValue();
+
+		/* Wait for the next sub block even if hashing failed */
+		if (NextLen != 0U) {
+			CopyStartTime = XPlmi_GetTimerValue();
+			Status = (u32)PdiPtr->DeviceCopy(SrcAddr + Offset + Len,
+				(u64)SecurePtr->ChunkAddr + Offset + Len,
+				NextLen, XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
+			SecurePtr->Perf.CopyWait += CopyStartTime -
+				XPlmi_GetTimerValue();
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+		}
+
+		if (HashStatus != XST_SUCCESS) {
+			Status = HashStatus;
+			goto END;
+		}
+
+		Offset += Len;
+		Len = NextLen;
 	}
 
 	Status = XST_SUCCESS;
@@ -800,6 +1243,271 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* @brief
+* This function streams an encrypted block of a CDO partition. The block is
+* copied to the chunk buffer in sub blocks and, if authentication is enabled,
+* each copied sub block is hashed on PMCDMA1, while the sub blocks already
+* copied and hashed are decrypted in place on PMCDMA0. The plaintext and the
+* hash are the same as with XLoader_ProcessBlk, but the data is decrypted
+* before the hash of the whole block is verified. The decrypted data never
+* leaves the chunk buffer, which XLoader_SecurePrtn clears on failure.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	SrcAddr		Boot device address of the block.
+* @param	Size		Size of the block in the boot device.
+* @param	Last		Notifies if the block to be processed is
+*		last or not.
+*
+* @return	XST_SUCCESS on success.
+*
+******************************************************************************/
+static u32 XLoader_StreamBlk(XLoader_SecureParms *SecurePtr, u32 SrcAddr,
+		u32 Size, u8 Last)
+{
+	u32 Status = (u32)XST_FAILURE;
+	XSecure_Sha3 Sha3Instance;
+	XSecure_Sha3 *Sha3InstancePtr = NULL;
+	u32 DataOfst = 0U;
+	u64 StartTime;
+	u64 WaitTime;
+
+	if (SecurePtr->IsAuthenticated == TRUE) {
+		Status = XLoader_StartHash(SecurePtr, &Sha3Instance,
+				XPlmi_GetDmaInstance(CSUDMA_1_DEVICE_ID));
+		if (Status != XST_SUCCESS) {
+			goto END;
+		}
+		Sha3InstancePtr = &Sha3Instance;
+		/* Authentication overhead is removed in the chunk */
+		if (Last != TRUE) {
+			DataOfst = XLOADER_SHA3_LEN;
+		}
+	}
+
+	Status = XLoader_StreamStart(SecurePtr, SrcAddr, Size,
+			Sha3InstancePtr);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	SecurePtr->SecureData = SecurePtr->ChunkAddr + DataOfst;
+	SecurePtr->SecureDataLen = Size - DataOfst;
+
+	/* The copy and hash waits are accounted separately */
+	WaitTime = SecurePtr->Perf.CopyWait + SecurePtr->Perf.HashWait;
+	StartTime = XPlmi_GetTimerValue();
+	Status = XLoader_AesDecryption(SecurePtr, SecurePtr->SecureData,
+			SecurePtr->SecureData, SecurePtr->SecureDataLen);
+	SecurePtr->Perf.Decrypt += (StartTime - XPlmi_GetTimerValue()) -
+		(SecurePtr->Perf.CopyWait + SecurePtr->Perf.HashWait - WaitTime);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	/* Wait for the copy and hash of the rest of the block */
+	Status = XLoader_StreamWait(SecurePtr,
+			(u64)SecurePtr->ChunkAddr + Size);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	if (Sha3InstancePtr != NULL) {
+		Status = XLoader_CheckHash(SecurePtr, Sha3InstancePtr, Last);
+	}
+
+END:
+	XLoader_StreamEnd(SecurePtr);
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function starts streaming a block to the chunk buffer. The copies and
+* SHA3 updates of the sub blocks run one at a time on PMCDMA1 and are issued
+* by XLoader_StreamWait.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	SrcAddr		Boot device address of the block.
+* @param	Size		Size of the block.
+* @param	Sha3InstancePtr	Pointer to the started SHA3 instance on PMCDMA1,
+*		NULL if the block is not hashed.
+*
+* @return	XST_SUCCESS on success.
+*
+******************************************************************************/
+static u32 XLoader_StreamStart(XLoader_SecureParms *SecurePtr, u32 SrcAddr,
+		u32 Size, XSecure_Sha3 *Sha3InstancePtr)
+{
+	XLoader_SecureStream *StreamPtr = &SecurePtr->Stream;
+
+	StreamPtr->SrcAddr = SrcAddr;
+	StreamPtr->Len = Size;
+	StreamPtr->CopiedLen = 0U;
+	StreamPtr->CopyLen = 0U;
+	StreamPtr->HashedLen = 0U;
+	StreamPtr->HashLen = 0U;
+	StreamPtr->Sha3Ptr = Sha3InstancePtr;
+
+	return XLoader_StreamNext(SecurePtr);
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function completes the copy or SHA3 update in flight and starts the
+* next one. Copied data is hashed before the next sub block is copied.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+*
+* @return	XST_SUCCESS on success.
+*
+******************************************************************************/
+static u32 XLoader_StreamNext(XLoader_SecureParms *SecurePtr)
+{
+	u32 Status = (u32)XST_SUCCESS;
+	XLoader_SecureStream *StreamPtr = &SecurePtr->Stream;
+	XilPdi *PdiPtr = SecurePtr->PdiPtr;
+	u32 Len;
+	u64 StartTime = XPlmi_GetTimerValue();
+
+	/* Complete the operation in flight */
+	if (StreamPtr->HashLen != 0U) {
+		Status = XSecure_Sha3WaitForUpdate(StreamPtr->Sha3Ptr);
+		SecurePtr->Perf.HashWait += StartTime - XPlmi_GetTimerValue();
+		StreamPtr->HashedLen += StreamPtr->HashLen;
+		StreamPtr->HashLen = 0U;
+	}
+	else if (StreamPtr->CopyLen != 0U) {
+		Status = (u32)PdiPtr->DeviceCopy(
+			StreamPtr->SrcAddr + StreamPtr->CopiedLen,
+			(u64)SecurePtr->ChunkAddr + StreamPtr->CopiedLen,
+			StreamPtr->CopyLen, XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
+		SecurePtr->Perf.CopyWait += StartTime - XPlmi_GetTimerValue();
+		StreamPtr->CopiedLen += StreamPtr->CopyLen;
+		StreamPtr->CopyLen = 0U;
+	}
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	/* Start the next operation */
+	if ((StreamPtr->Sha3Ptr != NULL) &&
+		(StreamPtr->HashedLen < StreamPtr->CopiedLen)) {
+		Len = StreamPtr->CopiedLen - StreamPtr->HashedLen;
+		Status = XSecure_Sha3UpdateStart(StreamPtr->Sha3Ptr,
+			(u8 *)(UINTPTR)(SecurePtr->ChunkAddr +
+			StreamPtr->HashedLen), Len);
+		if (Status != XST_SUCCESS) {
+			goto END;
+		}
+		StreamPtr->HashLen = Len;
+	}
+	else if (StreamPtr->CopiedLen < StreamPtr->Len) {
+		Len = StreamPtr->Len - StreamPtr->CopiedLen;
+		if (Len > XLOADER_SECURE_SUB_BLK_LEN) {
+			Len = XLOADER_SECURE_SUB_BLK_LEN;
+		}
+		StartTime = XPlmi_GetTimerValue();
+		Status = (u32)PdiPtr->DeviceCopy(
+			StreamPtr->SrcAddr + StreamPtr->CopiedLen,
+			(u64)SecurePtr->ChunkAddr + StreamPtr->CopiedLen,
+			Len, XLOADER_DEVICE_COPY_STATE_INITIATE);
+		SecurePtr->Perf.CopyWait += StartTime - XPlmi_GetTimerValue();
+		if (Status != XST_SUCCESS) {
+			goto END;
+		}
+		StreamPtr->CopyLen = Len;
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function waits until the streamed data up to the given chunk buffer
+* address is copied and, if the block is hashed, hashed, so that it can be
+* decrypted in place. It returns with the hash of the next sub block in
+* flight, or its copy if the block is not hashed, so that it runs along
+* with the decryption of the caller.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	Addr		End address of the data needed in the chunk
+*		buffer.
+*
+* @return	XST_SUCCESS on success, or if no block is being streamed.
+*
+******************************************************************************/
+static u32 XLoader_StreamWait(XLoader_SecureParms *SecurePtr, u64 Addr)
+{
+	u32 Status = (u32)XST_SUCCESS;
+	XLoader_SecureStream *StreamPtr = &SecurePtr->Stream;
+	u32 Ofst;
+	u32 DoneLen;
+	u32 InFlightLen;
+
+	if (StreamPtr->Len == 0U) {
+		goto END;
+	}
+
+	Ofst = (u32)(Addr - SecurePtr->ChunkAddr);
+	if (Ofst > StreamPtr->Len) {
+		Ofst = StreamPtr->Len;
+	}
+
+	do {
+		if (StreamPtr->Sha3Ptr != NULL) {
+			DoneLen = StreamPtr->HashedLen;
+			InFlightLen = StreamPtr->HashLen;
+		}
+		else {
+			DoneLen = StreamPtr->CopiedLen;
+			InFlightLen = StreamPtr->CopyLen;
+		}
+		if ((DoneLen >= Ofst) && ((InFlightLen != 0U) ||
+			(DoneLen == StreamPtr->Len))) {
+			break;
+		}
+		Status = XLoader_StreamNext(SecurePtr);
+	} while (Status == XST_SUCCESS);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function ends the streaming of a block. A copy or SHA3 update still
+* in flight on error is waited for.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+*
+* @return	None
+*
+******************************************************************************/
+static void XLoader_StreamEnd(XLoader_SecureParms *SecurePtr)
+{
+	XLoader_SecureStream *StreamPtr = &SecurePtr->Stream;
+
+	if (StreamPtr->HashLen != 0U) {
+		(void)XSecure_Sha3WaitForUpdate(StreamPtr->Sha3Ptr);
+	}
+	if (StreamPtr->CopyLen != 0U) {
+		(void)SecurePtr->PdiPtr->DeviceCopy(
+			StreamPtr->SrcAddr + StreamPtr->CopiedLen,
+			(u64)SecurePtr->ChunkAddr + StreamPtr->CopiedLen,
+			StreamPtr->CopyLen, XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
+	}
+	StreamPtr->Len = 0U;
+	StreamPtr->CopyLen = 0U;
+	StreamPtr->HashLen = 0U;
+}
+
 /*****************************************************************************/
 /**
 * @brief
@@ -1551,6 +2259,12 @@ static u32 XLoader_DecryptSH(XLoader_SecureParms *SecurePtr,
 	u32 Status = (u32)XST_FAILURE;
 	/* decrypt header/footer */
 
+	Status = XLoader_StreamWait(SecurePtr,
+			SrcAddr + XLOADER_SECURE_HDR_TOTAL_SIZE);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
 	/* configure AES engine to push Key and IV */
 	XPlmi_Printf(DEBUG_DETAILED, "Decrypting Secure header\n\r");
 	Status = XSecure_AesCfgKupIv(AesInstancePtr, 1);
@@ -1612,8 +2326,8 @@ static u32 XLoader_DataDecrypt(XLoader_SecureParms *SecurePtr,
 
 	do {
 		/* decrypt the data */
-		Status = XSecure_AesDecryptUpdate(AesInstancePtr,
-				InAddr, OutAddr, SecurePtr->EncNextBlkSize, 0);
+		Status = XLoader_AesDecryptUpdate(SecurePtr, AesInstancePtr,
+				InAddr, OutAddr, SecurePtr->EncNextBlkSize);
 		if (Status != XST_SUCCESS) {
 			goto END;
 		}
@@ -1671,6 +2385,57 @@ static u32 XLoader_DataDecrypt(XLoader_SecureParms *SecurePtr,
 
 
 
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function updates the AES engine with data of a block. When the block
+ * is streamed, the data is decrypted in pieces ending at sub block
+ * boundaries, each once it has been copied and hashed.
+ *
+ * @param	SecurePtr	Pointer to the XLoader_SecureParms
+ * @param	AesInstancePtr	Pointer to the AES instance
+ * @param	InAddr		Address of the encrypted data
+ * @param	OutAddr		Address of the decrypted data
+ * @param	Size		Size of the data
+ *
+ * @return	XST_SUCCESS if decryption was successful.
+ *
+ ******************************************************************************/
+static u32 XLoader_AesDecryptUpdate(XLoader_SecureParms *SecurePtr,
+		XSecure_Aes *AesInstancePtr, u64 InAddr, u64 OutAddr, u32 Size)
+{
+	u32 Status = (u32)XST_FAILURE;
+	u32 Len = Size;
+	u32 Ofst;
+
+	do {
+		if (SecurePtr->Stream.Len != 0U) {
+			Ofst = (u32)(InAddr - SecurePtr->ChunkAddr);
+			Len = XLOADER_SECURE_SUB_BLK_LEN -
+				(Ofst % XLOADER_SECURE_SUB_BLK_LEN);
+			if (Len > Size) {
+				Len = Size;
+			}
+			Status = XLoader_StreamWait(SecurePtr, InAddr + Len);
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+		}
+
+		Status = XSecure_AesDecryptUpdate(AesInstancePtr,
+				InAddr, OutAddr, Len, 0);
+		if (Status != XST_SUCCESS) {
+			goto END;
+		}
+		InAddr = InAddr + Len;
+		OutAddr = OutAddr + Len;
+		Size = Size - Len;
+	} while (Size != 0U);
+
 END:
 	return Status;
 }
@@ -2234,3 +2999,35 @@ static u32 XLoader_DecHdrs(XLoader_SecureParms *SecurePtr,
 END:
 	return Status;
 }
+
+/*****************************************************************************/
+/**
+ *
+ * This function prints the time spent in each phase of the loading of a
+ * secure partition when PLM_PRINT_PERF_SECURE is defined.
+ *
+ * @param	SecurePtr	Pointer to the XLoader_SecureParms
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XLoader_PrintSecurePerf(const XLoader_SecureParms *SecurePtr)
+{
+#ifdef PLM_PRINT_PERF_SECURE
+	const XLoader_SecurePerf *Perf = &SecurePtr->Perf;
+
+	XPlmi_Printf(DEBUG_PRINT_PERF, "Secure blocks: %d, streamed: %d, "
+		"prefetched: %d\n\r", SecurePtr->BlockNum,
+		XLOADER_IS_STREAM_BLK(SecurePtr), Perf->Prefetched);
+	XPlmi_PrintTime(Perf->CopyWait, 0U);
+	XPlmi_Printf(DEBUG_PRINT_PERF, ": Secure copy wait\n\r");
+	XPlmi_PrintTime(Perf->HashWait, 0U);
+	XPlmi_Printf(DEBUG_PRINT_PERF, ": Hash wait\n\r");
+	XPlmi_PrintTime(Perf->Decrypt, 0U);
+	XPlmi_Printf(DEBUG_PRINT_PERF, ": Decryption\n\r");
+	XPlmi_PrintTime(Perf->Verify, 0U);
+	XPlmi_Printf(DEBUG_PRINT_PERF, ": Hash and signature verification\n\r");
+#else
+	(void)SecurePtr;
+#endif
+}
@@ -36,6 +36,9 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.0   vns  04/23/19 First release
+*       ag   10/16/26 Added sub block prefetch while hashing a block
+*       ag   10/16/26 Added streaming of encrypted blocks and phase times
+*       ag   10/16/26 Added prefetch of the next block of CDO partitions
 * </pre>
 *
 * @note
@@ -59,6 +62,14 @@ extern "C" {
 #include "xplmi_util.h"
 
 /***************** Macros (Inline Functions) Definitions *********************/
+/*
+ * Blocks which are streamed. Only encrypted CDO blocks are streamed, as they
+ * are decrypted in place in the chunk buffer before their hash is verified.
+ */
+#define XLOADER_IS_STREAM_BLK(SecurePtr)	\
+		((((SecurePtr)->IsStreamEn == TRUE) && \
+		((SecurePtr)->IsEncrypted == TRUE) && \
+		((SecurePtr)->IsCdo == TRUE)) ? TRUE : FALSE)
 
 /************************** Constant Definitions *****************************/
 #define XLOADER_SHA3_LEN		(48U)
@@ -106,6 +117,23 @@ extern "C" {
 		(XLOADER_SECURE_HDR_SIZE + XLOADER_SECURE_GCM_TAG_SIZE)
 #define XLOADER_SECURE_IV_LEN		(4U)
 
+/*
+ * Blocks are copied and hashed in sub blocks of this size, so that the copy
+ * of the next sub block is in flight while the current one is hashed.
+ * Streamed blocks are also decrypted in sub blocks.
+ */
+#define XLOADER_SECURE_SUB_BLK_LEN	(0x4000U)
+
+/*
+ * Secure blocks of CDO partitions alternate between XLOADER_CHUNK_MEMORY and
+ * a second buffer which ends below the boot header. The two buffers overlap
+ * by a few KB, so only the part of the next block which is outside of the
+ * current block is prefetched.
+ */
+#define XLOADER_SECURE_BLK_MAX_SIZE	(XLOADER_CHUNK_SIZE + 0x100U)
+#define XLOADER_SECURE_CHUNK_MEMORY_1	\
+		(XIH_BH_PRAM_ADDR - XLOADER_SECURE_BLK_MAX_SIZE)
+
 /* AES key source */
 #define XLOADER_UNENCRYPTED		0x00000000 	/* Unencrypted */
 #define XLOADER_EFUSE_KEY		0xA5C3C5A3  /* eFuse Key */
@@ -207,6 +235,37 @@ typedef struct
 	u8 Padding1[8];
 }XLoader_Vars;
 
+/*
+ * Time spent in each phase of secure partition loading, in PIT ticks.
+ * With streaming, CopyWait and HashWait only count the waits which were not
+ * hidden behind decryption.
+ */
+typedef struct {
+	u64 CopyWait; /**< Waiting for block copies */
+	u64 HashWait; /**< Waiting for SHA3 updates */
+	u64 Decrypt; /**< Key load, decryption and GCM tag checks */
+	u64 Verify; /**< Hash compares and signature verification */
+	u32 Prefetched; /**< Blocks copied while the previous one was processed */
+} XLoader_SecurePerf;
+
+/* Copy of the next block, initiated while the current block is processed */
+typedef struct {
+	u32 BufAddr; /**< Chunk buffer of the next block */
+	u32 Ofst; /**< Offset of the prefetched part in the block */
+	u32 Len; /**< Length of the prefetched part, 0 if none */
+} XLoader_SecurePrefetch;
+
+/* Progress of the block being streamed through the chunk buffer */
+typedef struct {
+	u32 SrcAddr; /**< Boot device address of the block */
+	u32 Len; /**< Block length, 0 when not streaming */
+	u32 CopiedLen; /**< Length copied to the chunk buffer */
+	u32 CopyLen; /**< Length of the copy in flight */
+	u32 HashedLen; /**< Length hashed */
+	u32 HashLen; /**< Length of the SHA3 update in flight */
+	XSecure_Sha3 *Sha3Ptr; /**< SHA3 instance, NULL if not hashed */
+} XLoader_SecureStream;
+
 typedef struct {
 	u32 SecureEn;
 	u32 IsCheckSumEnabled;
@@ -228,6 +287,12 @@ typedef struct {
 	u32 EncNextBlkSize;
 	XLoader_AuthCertificate *AcPtr;
 	XCsuDma *CsuDmaInstPtr;
+	u32 IsStreamEn; /**< Encrypted blocks are streamed */
+	XLoader_SecureStream Stream;
+	u32 IsPrefetchEn; /**< Next block is copied during this block */
+	u32 IsBlkCopied; /**< Block is already in the chunk buffer */
+	XLoader_SecurePrefetch Prefetch;
+	XLoader_SecurePerf Perf;
 }XLoader_SecureParms;
 
 typedef enum {
@@ -243,10 +308,12 @@ typedef enum {
 u32 XLoader_SecureInit(XLoader_SecureParms *SecurePtr, XilPdi *PdiPtr, u32 PrtnNum);
 u32 XLoader_SecurePrtn(XLoader_SecureParms *SecurePtr, u64 DstAddr, u32 Size, u8 Last);
 u32 XLoader_SecureCopy(XLoader_SecureParms *SecurePtr, u64 DestAddr, u32 Size);
+u32 XLoader_SecureStopPrefetch(XLoader_SecureParms *SecurePtr);
 u32 XLoader_ImgHdrTblAuth(XLoader_SecureParms *SecurePtr,
 				XilPdi_ImgHdrTable *ImgHdrTbl);
 u32 XLoader_ReadAndVerifySecureHdrs(XLoader_SecureParms *SecurePtr, XilPdi_MetaHdr *ImgHdrTbl);
 u32 XLoader_SecureValidations(XLoader_SecureParms *SecurePtr);
+void XLoader_PrintSecurePerf(const XLoader_SecureParms *SecurePtr);
 
 #ifdef __cplusplus
 }
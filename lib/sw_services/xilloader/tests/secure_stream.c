@@ -0,0 +1,946 @@
+/******************************************************************************
+* Copyright (C) 2026 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file secure_stream.c
+*
+* Host test of the secure block processing of xloader_secure.c. Encrypted
+* and authenticated partitions are loaded block by block with
+* XLoader_SecurePrtn, with and without PLM_SECURE_STREAM and the prefetch
+* of CDO blocks, against models of the boot device copy, the SHA3 engine
+* and the AES engine:
+*
+* - The boot device copy and the SHA3 engine of a streamed block share
+*   PMCDMA1, the AES engine uses PMCDMA0. An operation started on a busy DMA
+*   is an error.
+* - The copy runs in the background on PMCDMA1, as from DDR, through its
+*   loopback path in the SSS. The SSS is configured by xsecure_utils.c; a
+*   configuration which changes the path of a copy or hash in flight is an
+*   error.
+* - The SHA3 and AES engines may only read PMC RAM which has been copied,
+*   and with authentication the AES engine may only read hashed data. Data
+*   of a copy in flight is not copied until the copy is waited for.
+* - Copies may not read beyond the partition.
+* - Streamed pieces of data may not cross a sub block.
+* - Data may only be decrypted outside the PMC RAM once the hash of the
+*   block is verified.
+*
+* The SHA3 digest, the AES key stream and the GCM tag are toy functions;
+* the secure header of each block loads the IV of the next one and its
+* length, as on the hardware. Each partition is also loaded with a
+* corrupted block, which must fail and leave no plaintext behind.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  ag   10/16/2026 Initial release
+*       ag   10/16/2026 Added the SSS and the prefetch of CDO blocks
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdarg.h>
+#include <sys/mman.h>
+#include "../src/xloader_secure.c"
+#include "../../xilsecure/src/common/xsecure_utils.c"
+
+/************************** Constant Definitions *****************************/
+#define PMCRAM_LEN		(0x20000U)
+#define BOOT_LEN		(0x40000U)
+#define BOOT_PRTN_OFST		(0x100U)
+#define DST_LEN			(0x40000U)
+#define DST_FILL		(0xEEU)
+#define PMCRAM_FILL		(0xA5U)
+#define MAX_BLKS		(8U)
+#define SHA3_LANES		(XLOADER_SHA3_LEN / 8U)
+#define TAG_LANES		(XLOADER_SECURE_GCM_TAG_SIZE / 8U)
+#define DMA_0			(0U)
+#define DMA_1			(1U)
+#define SSS_PATH(Src)		(XSECURE_SSS_CFG_MASK << \
+				(XSECURE_SSS_CFG_LEN_IN_BITS * (u32)(Src)))
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	const char *Name;
+	u32 DataLen[MAX_BLKS]; /* Encrypted data of each block, 0 ends */
+} Test_Prtn;
+
+/************************** Variable Definitions *****************************/
+static u8 *PmcRam;
+static u8 Boot[BOOT_LEN];
+static u8 Plain[BOOT_LEN];
+static u8 Dst[DST_LEN];
+static XCsuDma Dma[2];
+static u32 DmaBusy[2];
+static u8 Copied[PMCRAM_LEN];
+static u8 Hashed[PMCRAM_LEN];
+static u32 Errors;
+
+/* Boot device copy in flight */
+static u32 CopySrc;
+static u32 CopyDst;
+static u32 CopyLen;
+static u32 PrtnEnd;
+
+/* SSS model, with the paths of the transfers in flight */
+static XSecure_Sss Sss;
+static u32 SssCfg;
+static u32 SssBusyMask;
+
+/* SHA3 model */
+static u64 ShaLanes[SHA3_LANES];
+static u32 ShaDma;
+static u32 ShaPendOfst;
+static u32 ShaPendLen;
+static u32 IsHashOk;
+
+/* AES model */
+static u32 AesIv[4];
+static u32 AesSeed;
+static u32 AesCount;
+static u32 AesKupCfg;
+static u64 TagLanes[TAG_LANES];
+static u32 AesPieces;
+static u32 AesOverlaps;
+static u32 AesStreamed;
+static u32 InitIv[4];
+
+static XLoader_SecureParms Sp;
+static XilPdi Pdi;
+static XilPdi_PrtnHdr PrtnHdr;
+static u32 PrtnBlkOfst[MAX_BLKS];
+static u32 PrtnBlkLen[MAX_BLKS];
+static u32 PrtnBlks;
+
+/*****************************************************************************/
+#define CHECK(Cond, ...) \
+	do { \
+		if (!(Cond)) { \
+			printf("  error: " __VA_ARGS__); \
+			printf("\n"); \
+			Errors++; \
+		} \
+	} while (0)
+
+static void Fold(u64 *Lanes, u32 NumLanes, const u8 *Data, u32 Len)
+{
+	u32 Index;
+	u32 Lane;
+
+	for (Index = 0U; Index < Len; Index++) {
+		for (Lane = 0U; Lane < NumLanes; Lane++) {
+			Lanes[Lane] = (Lanes[Lane] ^ Data[Index]) *
+				0x100000001B3ULL;
+		}
+	}
+}
+
+static void FoldInit(u64 *Lanes, u32 NumLanes)
+{
+	u32 Lane;
+
+	for (Lane = 0U; Lane < NumLanes; Lane++) {
+		Lanes[Lane] = 0xCBF29CE484222325ULL + Lane * 0x9E3779B97F4A7C15ULL;
+	}
+}
+
+static u8 KeyStream(u32 Seed, u32 Count)
+{
+	u32 Value = (Seed ^ (Count * 0x9E3779B1U)) * 0x85EBCA6BU;
+
+	return (u8)(Value >> 13U);
+}
+
+static u32 IvSeed(const u32 *Iv)
+{
+	return Iv[0U] ^ (Iv[1U] * 3U) ^ (Iv[2U] * 5U) ^ (Iv[3U] * 7U);
+}
+
+static u32 IsPmcRam(u64 Addr, u32 Len)
+{
+	return ((Addr >= XLOADER_CHUNK_MEMORY) &&
+		((Addr + Len) <= (XLOADER_CHUNK_MEMORY + PMCRAM_LEN))) ?
+		TRUE : FALSE;
+}
+
+/*****************************************************************************/
+/* Stubs of the BSP */
+
+u32 Xil_Htonl(u32 Data)
+{
+	return __builtin_bswap32(Data);
+}
+
+u32 Xil_In32(UINTPTR Addr)
+{
+	u32 Ofst = (u32)(Addr - XSECURE_AES_BASEADDR - XSECURE_AES_IV_0_OFFSET);
+
+	if ((Addr >= (XSECURE_AES_BASEADDR + XSECURE_AES_IV_0_OFFSET)) &&
+		(Ofst < sizeof(AesIv))) {
+		return AesIv[Ofst / 4U];
+	}
+	if (Addr == XSECURE_SSS_ADDRESS) {
+		return SssCfg;
+	}
+	CHECK(0, "read of unmodelled register %lx", (unsigned long)Addr);
+	return 0U;
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+	if (Addr == XSECURE_SSS_ADDRESS) {
+		CHECK(((Value ^ SssCfg) & SssBusyMask) == 0U,
+			"SSS %x changes a path in use in %x", Value, SssCfg);
+		SssCfg = Value;
+		return;
+	}
+	CHECK(0, "write of unmodelled register %lx", (unsigned long)Addr);
+}
+
+void xil_printf(const char *Format, ...)
+{
+	va_list Args;
+
+	va_start(Args, Format);
+	vprintf(Format, Args);
+	va_end(Args);
+}
+
+void Xil_MemCpy(void *DstPtr, const void *SrcPtr, u32 Len)
+{
+	(void)memcpy(DstPtr, SrcPtr, Len);
+}
+
+void Xil_Assert(const char8 *File, s32 Line)
+{
+	printf("assert %s:%d\n", File, Line);
+	exit(1);
+}
+u32 Xil_AssertStatus;
+s32 Xil_AssertWait = 0;
+
+u32 Xil_WaitForEvent(u32 RegAddr, u32 EventMask, u32 Event, u32 Timeout)
+{
+	(void)RegAddr; (void)EventMask; (void)Event; (void)Timeout;
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/* Stubs of xilplmi */
+
+u64 XPlmi_GetTimerValue(void)
+{
+	static u64 Time = 0xFFFFFFFFFFFFULL;
+
+	return Time--;
+}
+
+XCsuDma *XPlmi_GetDmaInstance(u32 DeviceId)
+{
+	return (DeviceId <= CSUDMA_1_DEVICE_ID) ? &Dma[DeviceId] : NULL;
+}
+
+int XPlmi_DmaXfr(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags)
+{
+	(void)SrcAddr; (void)DestAddr; (void)Len; (void)Flags;
+	return XST_FAILURE;
+}
+
+int XPlmi_InitNVerifyMem(u64 Addr, u32 Len)
+{
+	u8 *Mem = (u8 *)(UINTPTR)Addr;
+	u32 Index;
+
+	memset(Mem, 0, Len);
+	for (Index = 0U; Index < Len; Index++) {
+		if (Mem[Index] != 0U) {
+			return XST_FAILURE;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+void *XPlmi_MemCpy(void *DestPtr, const void *SrcPtr, u32 Len)
+{
+	return memcpy(DestPtr, SrcPtr, Len);
+}
+
+s32 XPlmi_MemCmp(const void *Buf1Ptr, const void *Buf2Ptr, u32 Len)
+{
+	s32 Status = (memcmp(Buf1Ptr, Buf2Ptr, Len) == 0) ?
+		XST_SUCCESS : XST_FAILURE;
+
+	/* Only the hash compare uses XPlmi_MemCmp */
+	IsHashOk = (Status == XST_SUCCESS) ? TRUE : FALSE;
+
+	return Status;
+}
+
+void XPlmi_PrintArray(u32 DebugType, const u64 BufAddr, u32 Len,
+	const char *Str)
+{
+	(void)DebugType; (void)BufAddr; (void)Len; (void)Str;
+}
+
+/*****************************************************************************/
+/* Boot device model */
+
+static XStatus Test_DeviceCopy(u32 SrcAddr, u64 DestAddr, u32 Length,
+	u32 Flags)
+{
+	u32 Ofst = (u32)(DestAddr - XLOADER_CHUNK_MEMORY);
+
+	Flags &= XLOADER_DEVICE_COPY_STATE_MASK;
+	CHECK(IsPmcRam(DestAddr, Length) == TRUE,
+		"copy outside the PMC RAM");
+	CHECK((SrcAddr >= BOOT_PRTN_OFST) && ((SrcAddr + Length) <= PrtnEnd),
+		"copy of %x+%x outside the partition", SrcAddr, Length);
+
+	if (Flags == XLOADER_DEVICE_COPY_STATE_WAIT_DONE) {
+		CHECK((CopyLen != 0U) && (CopyDst == Ofst) &&
+			(CopyLen == Length), "wait of a copy not in flight");
+		CHECK((SssCfg & SSS_PATH(XSECURE_SSS_DMA1)) ==
+			(XSecure_SssLookupTable[XSECURE_SSS_DMA1][XSECURE_SSS_DMA1]
+			<< (XSECURE_SSS_CFG_LEN_IN_BITS * XSECURE_SSS_DMA1)),
+			"copy done without the PMCDMA1 loopback path");
+		memset(&Copied[CopyDst], 1, CopyLen);
+		CopyLen = 0U;
+		DmaBusy[DMA_1] = FALSE;
+		SssBusyMask &= ~SSS_PATH(XSECURE_SSS_DMA1);
+		return XST_SUCCESS;
+	}
+
+	CHECK(DmaBusy[DMA_1] == FALSE, "copy %x started on busy PMCDMA1",
+		Ofst);
+	CHECK(CopyLen == 0U, "copy started while a copy is in flight");
+	(void)XSecure_SssDmaLoopBack(&Sss, CSUDMA_1_DEVICE_ID);
+	memcpy((u8 *)(UINTPTR)DestAddr, &Boot[SrcAddr], Length);
+	if (Flags == XLOADER_DEVICE_COPY_STATE_INITIATE) {
+		CopySrc = SrcAddr;
+		CopyDst = Ofst;
+		CopyLen = Length;
+		DmaBusy[DMA_1] = TRUE;
+		SssBusyMask |= SSS_PATH(XSECURE_SSS_DMA1);
+		memset(&Copied[Ofst], 0, Length);
+	}
+	else {
+		memset(&Copied[Ofst], 1, Length);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/* SHA3 engine model */
+
+static void Test_Sha3Read(const u8 *Data, u32 Size)
+{
+	u32 Index;
+	u32 Ofst = (u32)((UINTPTR)Data - XLOADER_CHUNK_MEMORY);
+
+	if (IsPmcRam((UINTPTR)Data, Size) == TRUE) {
+		for (Index = 0U; Index < Size; Index++) {
+			if (Copied[Ofst + Index] == 0U) {
+				CHECK(0, "hash of uncopied data at %x",
+					Ofst + Index);
+				break;
+			}
+		}
+	}
+	Fold(ShaLanes, SHA3_LANES, Data, Size);
+}
+
+static void Test_Sha3Done(const u8 *Data, u32 Size)
+{
+	if (IsPmcRam((UINTPTR)Data, Size) == TRUE) {
+		memset(&Hashed[(UINTPTR)Data - XLOADER_CHUNK_MEMORY], 1, Size);
+	}
+}
+
+s32 XSecure_Sha3Initialize(XSecure_Sha3 *InstancePtr, XCsuDma *CsuDmaPtr)
+{
+	InstancePtr->CsuDmaPtr = CsuDmaPtr;
+	return XST_SUCCESS;
+}
+
+void XSecure_Sha3Start(XSecure_Sha3 *InstancePtr)
+{
+	ShaDma = (u32)(InstancePtr->CsuDmaPtr - Dma);
+	FoldInit(ShaLanes, SHA3_LANES);
+	IsHashOk = FALSE;
+}
+
+u32 XSecure_Sha3Update(XSecure_Sha3 *InstancePtr, const u8 *Data,
+	const u32 Size)
+{
+	CHECK(DmaBusy[ShaDma] == FALSE, "hash on busy PMCDMA%u", ShaDma);
+	(void)XSecure_SssSha(&Sss, InstancePtr->CsuDmaPtr->Config.DeviceId);
+	Test_Sha3Read(Data, Size);
+	Test_Sha3Done(Data, Size);
+	return XST_SUCCESS;
+}
+
+u32 XSecure_Sha3UpdateStart(XSecure_Sha3 *InstancePtr, const u8 *Data,
+	const u32 Size)
+{
+	CHECK(DmaBusy[ShaDma] == FALSE, "hash started on busy PMCDMA%u",
+		ShaDma);
+	(void)XSecure_SssSha(&Sss, InstancePtr->CsuDmaPtr->Config.DeviceId);
+	Test_Sha3Read(Data, Size);
+	DmaBusy[ShaDma] = TRUE;
+	SssBusyMask |= SSS_PATH(XSECURE_SSS_SHA);
+	ShaPendOfst = (u32)((UINTPTR)Data - XLOADER_CHUNK_MEMORY);
+	ShaPendLen = Size;
+	return XST_SUCCESS;
+}
+
+u32 XSecure_Sha3WaitForUpdate(XSecure_Sha3 *InstancePtr)
+{
+	(void)InstancePtr;
+	CHECK(ShaPendLen != 0U, "wait of a hash not in flight");
+	Test_Sha3Done((u8 *)(UINTPTR)(XLOADER_CHUNK_MEMORY + ShaPendOfst),
+		ShaPendLen);
+	ShaPendLen = 0U;
+	DmaBusy[ShaDma] = FALSE;
+	SssBusyMask &= ~SSS_PATH(XSECURE_SSS_SHA);
+	return XST_SUCCESS;
+}
+
+u32 XSecure_Sha3Finish(XSecure_Sha3 *InstancePtr, u8 *Hash)
+{
+	CHECK(DmaBusy[ShaDma] == FALSE, "hash read while busy");
+	/* The padding is hashed with a DMA transfer */
+	(void)XSecure_SssSha(&Sss, InstancePtr->CsuDmaPtr->Config.DeviceId);
+	memcpy(Hash, ShaLanes, XLOADER_SHA3_LEN);
+	return XST_SUCCESS;
+}
+
+u32 XSecure_Sha3Digest(XSecure_Sha3 *InstancePtr, const u8 *In,
+	const u32 Size, u8 *Out)
+{
+	(void)InstancePtr; (void)In; (void)Size; (void)Out;
+	return XST_FAILURE;
+}
+
+s32 XSecure_Sha3LastUpdate(XSecure_Sha3 *InstancePtr)
+{
+	(void)InstancePtr;
+	return XST_FAILURE;
+}
+
+void XSecure_Sha3_ReadHash(XSecure_Sha3 *InstancePtr, u8 *Hash)
+{
+	(void)InstancePtr; (void)Hash;
+}
+
+/*****************************************************************************/
+/* AES engine model */
+
+u32 XSecure_AesInitialize(XSecure_Aes *InstancePtr, XCsuDma *CsuDmaPtr)
+{
+	CHECK(CsuDmaPtr == &Dma[DMA_0], "AES not on PMCDMA0");
+	InstancePtr->BaseAddress = XSECURE_AES_BASEADDR;
+	InstancePtr->CsuDmaPtr = CsuDmaPtr;
+	return XST_SUCCESS;
+}
+
+u32 XSecure_AesDecryptInit(XSecure_Aes *InstancePtr,
+	XSecure_AesKeySrc KeySrc, XSecure_AesKeySize KeySize, u64 IvAddr)
+{
+	(void)InstancePtr; (void)KeySrc; (void)KeySize;
+	(void)XSecure_SssAes(&Sss, XSECURE_SSS_DMA0, XSECURE_SSS_DMA0);
+	AesSeed = IvSeed((u32 *)(UINTPTR)IvAddr);
+	AesCount = 0U;
+	FoldInit(TagLanes, TAG_LANES);
+	return XST_SUCCESS;
+}
+
+u32 XSecure_AesCfgKupIv(XSecure_Aes *InstancePtr, u32 EnableCfg)
+{
+	(void)InstancePtr;
+	AesKupCfg = EnableCfg;
+	return XST_SUCCESS;
+}
+
+u32 XSecure_AesDecryptUpdate(XSecure_Aes *InstancePtr, u64 InDataAddr,
+	u64 OutDataAddr, u32 Size, u8 EnLast)
+{
+	const u8 *In = (const u8 *)(UINTPTR)InDataAddr;
+	u8 Sh[XLOADER_SECURE_HDR_SIZE];
+	u8 *Out;
+	u32 Ofst = (u32)(InDataAddr - XLOADER_CHUNK_MEMORY);
+	u32 Index;
+	u8 Byte;
+
+	(void)InstancePtr; (void)EnLast;
+	AesPieces++;
+	if ((DmaBusy[DMA_1] == TRUE) || (ShaPendLen != 0U)) {
+		AesOverlaps++;
+	}
+	CHECK(DmaBusy[DMA_0] == FALSE, "decryption on busy PMCDMA0");
+	(void)XSecure_SssAes(&Sss, XSECURE_SSS_DMA0, XSECURE_SSS_DMA0);
+	CHECK(IsPmcRam(InDataAddr, Size) == TRUE, "decryption outside the PMC RAM");
+	for (Index = 0U; Index < Size; Index++) {
+		if (Copied[Ofst + Index] == 0U) {
+			CHECK(0, "decryption of uncopied data at %x",
+				Ofst + Index);
+			break;
+		}
+		if ((Sp.IsAuthenticated == TRUE) &&
+			(Hashed[Ofst + Index] == 0U)) {
+			CHECK(0, "decryption of unhashed data at %x",
+				Ofst + Index);
+			break;
+		}
+	}
+	if (Sp.Stream.Len != 0U) {
+		AesStreamed++;
+		/* The secure header is waited for as a whole */
+		CHECK((OutDataAddr == XSECURE_AES_NO_CFG_DST_DMA) ||
+			((Ofst / XLOADER_SECURE_SUB_BLK_LEN) ==
+			((Ofst + Size - 1U) / XLOADER_SECURE_SUB_BLK_LEN)),
+			"streamed piece %x+%x crosses a sub block", Ofst, Size);
+	}
+
+	if (OutDataAddr == XSECURE_AES_NO_CFG_DST_DMA) {
+		CHECK((AesKupCfg == TRUE) && (Size == XLOADER_SECURE_HDR_SIZE),
+			"secure header without key update");
+		Out = Sh;
+	}
+	else {
+		CHECK((Sp.IsAuthenticated != TRUE) || (IsHashOk == TRUE) ||
+			(IsPmcRam(OutDataAddr, Size) == TRUE),
+			"decryption to %llx before the hash is verified",
+			(unsigned long long)OutDataAddr);
+		Out = (u8 *)(UINTPTR)OutDataAddr;
+	}
+
+	for (Index = 0U; Index < Size; Index++) {
+		Byte = In[Index];
+		Fold(TagLanes, TAG_LANES, &Byte, 1U);
+		Out[Index] = Byte ^ KeyStream(AesSeed, AesCount++);
+	}
+	if (Out == Sh) {
+		memcpy(AesIv, &Sh[XLOADER_SECURE_HDR_SIZE - sizeof(AesIv)],
+			sizeof(AesIv));
+	}
+
+	return XST_SUCCESS;
+}
+
+u32 XSecure_AesDecryptFinal(XSecure_Aes *InstancePtr, u64 GcmTagAddr)
+{
+	(void)InstancePtr;
+	(void)XSecure_SssAes(&Sss, XSECURE_SSS_DMA0, XSECURE_SSS_DMA0);
+	return (memcmp((u8 *)(UINTPTR)GcmTagAddr, TagLanes,
+		XLOADER_SECURE_GCM_TAG_SIZE) == 0) ? XST_SUCCESS : XST_FAILURE;
+}
+
+u32 XSecure_AesGetNxtBlkLen(XSecure_Aes *InstancePtr, u32 *Size)
+{
+	(void)InstancePtr;
+	*Size = Xil_Htonl(AesIv[3U]) * 4U;
+	return XST_SUCCESS;
+}
+
+u32 XSecure_AesKekDecrypt(XSecure_Aes *InstancePtr,
+	XSecure_AesKekType KeyType, XSecure_AesKeySrc DecKeySrc,
+	XSecure_AesKeySrc DstKeySrc, u64 IvAddr, u32 KeySize)
+{
+	(void)InstancePtr; (void)KeyType; (void)DecKeySrc; (void)DstKeySrc;
+	(void)IvAddr; (void)KeySize;
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/* Not used by the blocks after the first one */
+
+s32 XSecure_RsaInitialize(XSecure_Rsa *InstancePtr, u8 *Mod, u8 *ModExt,
+	u8 *ModExpo)
+{
+	(void)InstancePtr; (void)Mod; (void)ModExt; (void)ModExpo;
+	return XST_FAILURE;
+}
+
+s32 XSecure_RsaPublicEncrypt(XSecure_Rsa *InstancePtr, u8 *Input, u32 Size,
+	u8 *Result)
+{
+	(void)InstancePtr; (void)Input; (void)Size; (void)Result;
+	return XST_FAILURE;
+}
+
+int P384_validatekey(unsigned char *Qx, unsigned char *Qy)
+{
+	(void)Qx; (void)Qy;
+	return 1;
+}
+
+int P384_ecdsaverify(unsigned char *z, unsigned char *Qx,
+	unsigned char *Qy, unsigned char *r, unsigned char *s)
+{
+	(void)z; (void)Qx; (void)Qy; (void)r; (void)s;
+	return 1;
+}
+
+XStatus XilPdi_ReadAndVerifyImgHdr(XilPdi_MetaHdr *MetaHdrPtr)
+{
+	(void)MetaHdrPtr;
+	return XST_FAILURE;
+}
+
+XStatus XilPdi_ReadAndVerifyPrtnHdr(XilPdi_MetaHdr *ImgHdrPtr)
+{
+	(void)ImgHdrPtr;
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+* Builds the boot image of a partition whose first block has already been
+* processed. Each block is the hash of the next block, if authenticated and
+* not last, followed by its encrypted data and secure header. The secure
+* header holds the IV of the next block, whose last word is the length of
+* the next encrypted data in words.
+*/
+static void Test_BuildPrtn(const Test_Prtn *Prtn, u32 IsAuth)
+{
+	u32 Iv[4U] = { 0x01234567U, 0x89ABCDEFU, 0x0F1E2D3CU, 0U };
+	u8 Sh[XLOADER_SECURE_HDR_SIZE];
+	u64 Lanes[TAG_LANES > SHA3_LANES ? TAG_LANES : SHA3_LANES];
+	u32 Seed;
+	u32 Count;
+	u32 Ofst = BOOT_PRTN_OFST;
+	u32 Blk;
+	u32 Index;
+	u32 Len;
+	u8 *Enc;
+
+	memset(Boot, 0, sizeof(Boot));
+	for (PrtnBlks = 0U; Prtn->DataLen[PrtnBlks] != 0U; PrtnBlks++);
+
+	/* Initial IV, loaded by the secure header of the first block */
+	Iv[3U] = Xil_Htonl(Prtn->DataLen[0U] / 4U);
+	memcpy(InitIv, Iv, sizeof(Iv));
+	memcpy(AesIv, Iv, sizeof(Iv));
+	for (Blk = 0U; Blk < PrtnBlks; Blk++) {
+		Len = Prtn->DataLen[Blk];
+		PrtnBlkOfst[Blk] = Ofst;
+		if ((IsAuth == TRUE) && (Blk != (PrtnBlks - 1U))) {
+			Ofst += XLOADER_SHA3_LEN;
+		}
+		Enc = &Boot[Ofst];
+		for (Index = 0U; Index < Len; Index++) {
+			Plain[Ofst + Index] = (u8)((Index * 7U) + Blk + 3U);
+		}
+
+		/* IV of the next block, as read back from the AES engine */
+		for (Index = 0U; Index < 3U; Index++) {
+			Iv[Index] = Iv[Index] * 0x2545F491U + Blk;
+		}
+		Iv[3U] = Xil_Htonl(Prtn->DataLen[Blk + 1U] / 4U);
+		memset(Sh, 0x3C, sizeof(Sh));
+		memcpy(&Sh[sizeof(Sh) - sizeof(Iv)], Iv, sizeof(Iv));
+		memcpy(&Plain[Ofst + Len], Sh, sizeof(Sh));
+
+		/* The previous secure header selected the key stream */
+		{
+			u32 PrevIv[4U];
+
+			for (Index = 0U; Index < 4U; Index++) {
+				PrevIv[Index] = Xil_Htonl(AesIv[Index]);
+			}
+			Seed = IvSeed(PrevIv);
+			memcpy(AesIv, Iv, sizeof(Iv));
+		}
+		FoldInit(Lanes, TAG_LANES);
+		for (Count = 0U; Count < (Len + XLOADER_SECURE_HDR_SIZE);
+			Count++) {
+			Enc[Count] = Plain[Ofst + Count] ^ KeyStream(Seed, Count);
+			Fold(Lanes, TAG_LANES, &Enc[Count], 1U);
+		}
+		memcpy(&Enc[Count], Lanes, XLOADER_SECURE_GCM_TAG_SIZE);
+		Ofst += Len + XLOADER_SECURE_HDR_TOTAL_SIZE;
+		PrtnBlkLen[Blk] = Ofst - PrtnBlkOfst[Blk];
+	}
+	PrtnEnd = Ofst;
+
+	/* Hash of each block, in the block before it */
+	if (IsAuth == TRUE) {
+		for (Blk = PrtnBlks - 1U; Blk > 0U; Blk--) {
+			FoldInit(Lanes, SHA3_LANES);
+			Fold(Lanes, SHA3_LANES, &Boot[PrtnBlkOfst[Blk]],
+				PrtnBlkLen[Blk]);
+			memcpy(&Boot[PrtnBlkOfst[Blk - 1U]], Lanes,
+				XLOADER_SHA3_LEN);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+* Loads the partition built by Test_BuildPrtn, starting from its first
+* block, as after the processing of block 0. The PMC RAM is refilled before
+* each block, except for the data of a prefetch in flight.
+*
+* @return	Index of the block which failed, PrtnBlks on success.
+*/
+static u32 Test_LoadPrtn(const Test_Prtn *Prtn, u32 IsAuth, u32 IsCdo,
+	u32 IsStreamEn, u32 IsPrefetchEn, u32 *FailStatus)
+{
+	u64 Lanes[SHA3_LANES];
+	u32 Blk;
+	u32 Status;
+	u32 BlkSize;
+	u32 DataLen;
+	u32 Last;
+	u32 Ofst;
+	u8 *Out;
+	u32 Index;
+	u32 DstOfst = 0U;
+
+	memset(&Sp, 0, sizeof(Sp));
+	memset(&PrtnHdr, 0, sizeof(PrtnHdr));
+	memset(Dst, DST_FILL, sizeof(Dst));
+	memset(DmaBusy, 0, sizeof(DmaBusy));
+	CopyLen = 0U;
+	ShaPendLen = 0U;
+	SssCfg = 0U;
+	SssBusyMask = 0U;
+	Pdi.DeviceCopy = Test_DeviceCopy;
+	Sp.PdiPtr = &Pdi;
+	Sp.PrtnHdr = &PrtnHdr;
+	Sp.CsuDmaInstPtr = &Dma[DMA_0];
+	Sp.ChunkAddr = XLOADER_CHUNK_MEMORY;
+	Sp.SecureEn = TRUE;
+	Sp.IsEncrypted = TRUE;
+	Sp.IsAuthenticated = IsAuth;
+	Sp.IsCdo = IsCdo;
+	Sp.IsStreamEn = IsStreamEn;
+	Sp.IsPrefetchEn = IsPrefetchEn;
+	Sp.BlockNum = 1U;
+	PrtnHdr.DataWordOfst = BOOT_PRTN_OFST / XIH_PRTN_WORD_LEN;
+	PrtnHdr.TotalDataWordLen = (PrtnEnd - BOOT_PRTN_OFST) /
+		XIH_PRTN_WORD_LEN;
+	Sp.NextBlkAddr = BOOT_PRTN_OFST;
+	Sp.EncNextBlkSize = Prtn->DataLen[0U];
+	Sp.RemainingEncLen = 0U;
+	for (Blk = 0U; Blk < PrtnBlks; Blk++) {
+		Sp.RemainingEncLen += Prtn->DataLen[Blk] +
+			XLOADER_SECURE_HDR_TOTAL_SIZE;
+	}
+	if (IsAuth == TRUE) {
+		FoldInit(Lanes, SHA3_LANES);
+		Fold(Lanes, SHA3_LANES, &Boot[PrtnBlkOfst[0U]], PrtnBlkLen[0U]);
+		memcpy(Sp.Sha3Hash, Lanes, XLOADER_SHA3_LEN);
+	}
+	memcpy(AesIv, InitIv, sizeof(AesIv));
+	AesPieces = 0U;
+	AesOverlaps = 0U;
+	AesStreamed = 0U;
+
+	for (Blk = 0U; Blk < PrtnBlks; Blk++) {
+		DataLen = Prtn->DataLen[Blk];
+		Last = (Blk == (PrtnBlks - 1U)) ? TRUE : FALSE;
+		BlkSize = DataLen + XLOADER_SECURE_HDR_TOTAL_SIZE;
+		memset(PmcRam, PMCRAM_FILL, PMCRAM_LEN);
+		memset(Copied, 0, sizeof(Copied));
+		memset(Hashed, 0, sizeof(Hashed));
+		if (CopyLen != 0U) {
+			memcpy(&PmcRam[CopyDst], &Boot[CopySrc], CopyLen);
+		}
+		Status = XLoader_SecurePrtn(&Sp, (UINTPTR)&Dst[DstOfst],
+			BlkSize, Last);
+		CHECK((ShaPendLen == 0U) && (DmaBusy[DMA_0] == FALSE) &&
+			(((CopyLen == 0U) && (DmaBusy[DMA_1] == FALSE)) ||
+			((IsPrefetchEn == TRUE) && (Last != TRUE) &&
+			(Status == XST_SUCCESS))),
+			"DMA left busy after block %u", Blk);
+		if (Status != XST_SUCCESS) {
+			*FailStatus = Status;
+			return Blk;
+		}
+		CHECK(Sp.SecureDataLen == DataLen, "block %u length %x",
+			Blk, Sp.SecureDataLen);
+
+		/* Plaintext of the block */
+		Ofst = PrtnBlkOfst[Blk];
+		if ((IsAuth == TRUE) && (Last != TRUE)) {
+			Ofst += XLOADER_SHA3_LEN;
+		}
+		if (IsCdo == TRUE) {
+			Out = (u8 *)(UINTPTR)Sp.SecureData;
+		}
+		else {
+			Out = &Dst[DstOfst];
+		}
+		for (Index = 0U; Index < DataLen; Index++) {
+			if (Out[Index] != Plain[Ofst + Index]) {
+				CHECK(0, "block %u plaintext differs at %x",
+					Blk, Index);
+				break;
+			}
+		}
+		DstOfst += DataLen;
+	}
+
+	return PrtnBlks;
+}
+
+/*****************************************************************************/
+/**
+* Loads a partition, then loads it again with a byte of the encrypted data of
+* its second block flipped. The corrupted block must fail the hash check, or
+* the GCM tag check without authentication, and no plaintext of it may be
+* left in the PMC RAM or, once authenticated, at the load address.
+*/
+static void Test_Run(const Test_Prtn *Prtn, u32 IsAuth, u32 IsCdo,
+	u32 IsStreamEn, u32 IsPrefetchEn)
+{
+	u32 Blk;
+	u32 Status = XST_SUCCESS;
+	u32 Index;
+	u32 ClrLen;
+	u32 DstOfst;
+	u32 Pieces;
+	u32 Overlaps;
+	u32 Streamed;
+	u32 Prefetched;
+	u32 ChunkOfst;
+	u32 ErrorsBefore = Errors;
+
+	Test_BuildPrtn(Prtn, IsAuth);
+	Blk = Test_LoadPrtn(Prtn, IsAuth, IsCdo, IsStreamEn, IsPrefetchEn,
+		&Status);
+	CHECK(Blk == PrtnBlks, "block %u failed with %x", Blk, Status);
+	Pieces = AesPieces;
+	Overlaps = AesOverlaps;
+	Streamed = AesStreamed;
+	Prefetched = Sp.Perf.Prefetched;
+	if ((IsPrefetchEn == TRUE) && (Streamed == 0U)) {
+		CHECK(Prefetched != 0U, "no block prefetched");
+	}
+	else {
+		CHECK(Prefetched == 0U, "%u blocks prefetched", Prefetched);
+	}
+	if ((IsStreamEn == TRUE) && (IsCdo == TRUE)) {
+		CHECK(Streamed != 0U, "CDO blocks not streamed");
+		if (IsAuth == TRUE) {
+			CHECK(Overlaps != 0U,
+				"decryption never overlapped a copy or hash");
+		}
+	}
+	else {
+		CHECK(Streamed == 0U, "%u pieces streamed", Streamed);
+	}
+
+	Boot[PrtnBlkOfst[1U] + PrtnBlkLen[1U] / 2U] ^= 0x10U;
+	Blk = Test_LoadPrtn(Prtn, IsAuth, IsCdo, IsStreamEn, IsPrefetchEn,
+		&Status);
+	CHECK(Blk == 1U, "corrupted block %u not rejected", Blk);
+	CHECK((Status & XLOADER_SEC_BUF_CLEAR_SUCCESS) != 0U,
+		"PMC RAM not cleared, status %x", Status);
+	CHECK(CopyLen == 0U, "prefetch left in flight");
+	ClrLen = PrtnBlkLen[1U];
+	ChunkOfst = (u32)(Sp.ChunkAddr - XLOADER_CHUNK_MEMORY);
+	for (Index = 0U; Index < ClrLen; Index++) {
+		if (PmcRam[ChunkOfst + Index] != 0U) {
+			CHECK(0, "PMC RAM not cleared at %x",
+				ChunkOfst + Index);
+			break;
+		}
+	}
+	if ((IsCdo != TRUE) && (IsAuth == TRUE)) {
+		DstOfst = Prtn->DataLen[0U];
+		for (Index = 0U; Index < Prtn->DataLen[1U]; Index++) {
+			if (Dst[DstOfst + Index] != DST_FILL) {
+				CHECK(0, "load address written at %x",
+					DstOfst + Index);
+				break;
+			}
+		}
+	}
+
+	printf("%-8s %-4s %-3s stream %u prefetch %u: %4u AES pieces, "
+		"%3u streamed, %3u overlapped, %u prefetched, "
+		"corrupt block status %x: %s\n",
+		Prtn->Name, (IsAuth == TRUE) ? "auth" : "enc",
+		(IsCdo == TRUE) ? "cdo" : "elf", IsStreamEn, IsPrefetchEn,
+		Pieces, Streamed, Overlaps, Prefetched, Status,
+		(Errors == ErrorsBefore) ? "ok" : "FAIL");
+}
+
+int main(void)
+{
+	static const Test_Prtn Prtns[] = {
+		{ "chunks", { 0xFFC0U, 0xFFC0U, 0x3FF0U } },
+		{ "odd", { 0x4000U, 0x1230U, 0x0FC0U, 0x64U } },
+		{ "subblks", { 0x3FC0U, 0x8000U, 0x40U, 0xBFC0U, 0x10U } },
+	};
+	u32 Prtn;
+	u32 IsAuth;
+	u32 IsCdo;
+	u32 IsStreamEn;
+	u32 IsPrefetchEn;
+
+	Dma[DMA_0].Config.DeviceId = CSUDMA_0_DEVICE_ID;
+	Dma[DMA_1].Config.DeviceId = CSUDMA_1_DEVICE_ID;
+	XSecure_SssInitialize(&Sss);
+	PmcRam = mmap((void *)(UINTPTR)XLOADER_CHUNK_MEMORY, PMCRAM_LEN,
+		PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
+		-1, 0);
+	if (PmcRam != (u8 *)(UINTPTR)XLOADER_CHUNK_MEMORY) {
+		printf("PMC RAM can not be mapped at %x\n",
+			XLOADER_CHUNK_MEMORY);
+		return 1;
+	}
+
+	for (Prtn = 0U; Prtn < (sizeof(Prtns) / sizeof(Prtns[0U])); Prtn++) {
+		for (IsAuth = FALSE; IsAuth <= TRUE; IsAuth++) {
+			for (IsCdo = FALSE; IsCdo <= TRUE; IsCdo++) {
+				for (IsStreamEn = FALSE; IsStreamEn <= TRUE;
+					IsStreamEn++) {
+					/* Only CDO blocks are prefetched */
+					for (IsPrefetchEn = FALSE;
+						IsPrefetchEn <= IsCdo;
+						IsPrefetchEn++) {
+						Test_Run(&Prtns[Prtn], IsAuth,
+							IsCdo, IsStreamEn,
+							IsPrefetchEn);
+					}
+				}
+			}
+		}
+	}
+
+	printf("secure_stream: %s\n", (Errors == 0U) ? "PASS" : "FAIL");
+	return (Errors == 0U) ? 0 : 1;
+}
@@ -35,6 +35,11 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   08/23/2018 Initial release
+*       ag   10/16/2026 Added write coalescing for CDO write commands
+*       ag   10/16/2026 Coalescing is opt-in, kept the command traces and
+*                       report failed write runs against their first command
+*       ag   10/16/2026 Report a failed write run that starts with a command
+*                       split across chunks at its position in the CDO
 *
 * </pre>
 *
@@ -44,17 +49,49 @@
 
 /***************************** Include Files *********************************/
 #include "xplmi_cdo.h"
+#include "xplmi_dma.h"
+#include "xplmi_hw.h"
+#include "xplmi_modules.h"
+#include "xplmi_util.h"
 
 /************************** Constant Definitions *****************************/
 #define XPLMI_CMD_LEN_TEMPBUF		(0x8U)
 
+#ifdef PLM_CDO_COALESCE_WRITES
+/** Command headers of the generic mask write and write commands */
+#define XPLMI_CDO_CMD_MASK_WRITE	((3U << 16U) | \
+					(XPLMI_MODULE_GENERIC_ID << 8U) | 2U)
+#define XPLMI_CDO_CMD_WRITE		((2U << 16U) | \
+					(XPLMI_MODULE_GENERIC_ID << 8U) | 3U)
+
+/** Maximum number of writes collected in one run */
+#define XPLMI_CDO_WRITE_RUN_MAX		(64U)
+/** Shorter runs are written with individual stores instead of DMA */
+#define XPLMI_CDO_WRITE_RUN_MIN		(4U)
+#endif
+
 /**************************** Type Definitions *******************************/
+#ifdef PLM_CDO_COALESCE_WRITES
+/**
+ * Run of pending writes to consecutive addresses, which is issued as a
+ * single DMA transfer once a non-consecutive command is seen.
+ */
+typedef struct {
+	u32 Addr;	/**< Address of the first pending write */
+	u32 Cnt;	/**< Number of pending writes */
+	u32 CdoOffset;	/**< Processed CDO length at the first write */
+	u32 Data[XPLMI_CDO_WRITE_RUN_MAX];	/**< Values to be written */
+} XPlmi_CdoWriteRun;
+#endif
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
 
 /************************** Variable Definitions *****************************/
+#ifdef PLM_CDO_COALESCE_WRITES
+static XPlmi_CdoWriteRun CdoWriteRun;
+#endif
 
 /*****************************************************************************/
 
@@ -356,6 +393,164 @@ END:
 	return Status;
 }
 
+#ifdef PLM_CDO_COALESCE_WRITES
+/*****************************************************************************/
+/**
+ * @brief This function issues the pending run of writes. Runs of at least
+ * XPLMI_CDO_WRITE_RUN_MIN words are written with one PMC DMA transfer,
+ * which stores the words to the incrementing addresses in order, so the
+ * register side effects are the same as those of the individual writes.
+ * A failed transfer is reported against the first write command of the
+ * run, as XPlmi_CdoCmdExecute reports a failed command.
+ *
+ * @param None
+ *
+ * @return XST_SUCCESS in case of success
+ *
+ *****************************************************************************/
+static int XPlmi_CdoFlushWrites(void)
+{
+	int Status = XST_SUCCESS;
+	u32 Index;
+
+	if (CdoWriteRun.Cnt >= XPLMI_CDO_WRITE_RUN_MIN)
+	{
+		Status = XPlmi_DmaXfr((u64)(UINTPTR)CdoWriteRun.Data,
+				(u64)CdoWriteRun.Addr, CdoWriteRun.Cnt,
+				XPLMI_PMCDMA_0);
+		if (Status != XST_SUCCESS)
+		{
+			Status = XPLMI_UPDATE_STATUS(XPLMI_ERR_CMD_HANDLER,
+						     Status);
+			XPlmi_Printf(DEBUG_GENERAL,
+			    "CMD: 0x%0x execute failed, Processed Cdo Length 0x%0x\n\r",
+			     XPLMI_CDO_CMD_WRITE, CdoWriteRun.CdoOffset);
+		}
+	} else {
+		for (Index = 0U; Index < CdoWriteRun.Cnt; Index++)
+		{
+			Xil_Out32(CdoWriteRun.Addr + (Index * 4U),
+				  CdoWriteRun.Data[Index]);
+		}
+	}
+
+	CdoWriteRun.Cnt = 0U;
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function prints the DEBUG_DETAILED traces that
+ * XPlmi_CmdExecute prints for a command, so that commands executed by
+ * XPlmi_CdoFastCmd show up in the log in the same way.
+ *
+ * @param CmdId Command header
+ * @param Len Payload length of the command
+ *
+ * @return None
+ *
+ *****************************************************************************/
+static void XPlmi_CdoTraceCmd(u32 CmdId, u32 Len)
+{
+	XPlmi_Printf(DEBUG_DETAILED, "CMD Execute \n\r");
+	XPlmi_Printf(DEBUG_DETAILED,
+		     "CMD 0x%0x, Len 0x%0x, PayloadLen 0x%0x \n\r",
+		     CmdId, Len, Len);
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function executes generic write and mask write commands
+ * without going through the module handler. A write to the address
+ * following the pending run is appended to the run; any other write
+ * first flushes the run. Only NPI addresses are collected, since the PMC
+ * DMA is not used for PMC local registers.
+ *
+ * Mask writes are not merged because each of them reads the register
+ * before writing it; they flush the pending run and are executed in place.
+ *
+ * @param BufPtr Pointer to the buffer
+ * @param BufLen Len of the buffer
+ * @param CdoOffset Processed CDO length at the command at BufPtr
+ * @param Size Pointer to the size consumed, 0 if the command at BufPtr is
+ * not handled here and must be executed through XPlmi_CdoCmdExecute
+ *
+ * @return XST_SUCCESS in case of success
+ *
+ *****************************************************************************/
+static int XPlmi_CdoFastCmd(const u32 *BufPtr, u32 BufLen, u32 CdoOffset,
+			    u32 *Size)
+{
+	int Status = XST_SUCCESS;
+	u32 Addr;
+
+	*Size = 0U;
+
+	if ((BufPtr[0] == XPLMI_CDO_CMD_WRITE) && (BufLen >= 3U))
+	{
+		Addr = BufPtr[1];
+		XPlmi_CdoTraceCmd(XPLMI_CDO_CMD_WRITE, 2U);
+		XPlmi_Printf(DEBUG_DETAILED,
+			"XPlmi_Write, Addr: 0x%0x,  Val: 0x%0x\n\r",
+			Addr, BufPtr[2]);
+
+		if ((CdoWriteRun.Cnt != 0U) &&
+		    ((Addr != (CdoWriteRun.Addr + (CdoWriteRun.Cnt * 4U))) ||
+		     (CdoWriteRun.Cnt == XPLMI_CDO_WRITE_RUN_MAX)))
+		{
+			Status = XPlmi_CdoFlushWrites();
+			if (Status != XST_SUCCESS)
+			{
+				goto END;
+			}
+		}
+
+		if ((Addr >= XPLMI_NPI_BASEADDR) &&
+		    (Addr <= (XPLMI_NPI_HIGHADDR - 3U)))
+		{
+			if (CdoWriteRun.Cnt == 0U)
+			{
+				CdoWriteRun.Addr = Addr;
+				CdoWriteRun.CdoOffset = CdoOffset;
+			}
+			CdoWriteRun.Data[CdoWriteRun.Cnt] = BufPtr[2];
+			CdoWriteRun.Cnt++;
+		} else {
+			Status = XPlmi_CdoFlushWrites();
+			if (Status != XST_SUCCESS)
+			{
+				goto END;
+			}
+			Xil_Out32(Addr, BufPtr[2]);
+		}
+		*Size = 3U;
+	}
+	else if ((BufPtr[0] == XPLMI_CDO_CMD_MASK_WRITE) && (BufLen >= 4U))
+	{
+		XPlmi_CdoTraceCmd(XPLMI_CDO_CMD_MASK_WRITE, 3U);
+		XPlmi_Printf(DEBUG_DETAILED,
+			"XPlmi_MaskWrite, Addr: 0x%0x,  Mask 0x%0x, Value: 0x%0x\n\r",
+			BufPtr[1], BufPtr[2], BufPtr[3]);
+
+		Status = XPlmi_CdoFlushWrites();
+		if (Status != XST_SUCCESS)
+		{
+			goto END;
+		}
+		XPlmi_UtilRMW(BufPtr[1], BufPtr[2], BufPtr[3]);
+		*Size = 4U;
+	}
+	else
+	{
+		/** Preserve ordering with the command executed next */
+		Status = XPlmi_CdoFlushWrites();
+	}
+
+END:
+	return Status;
+}
+#endif
+
 /*****************************************************************************/
 /**
  * @brief This function process the CDO file
@@ -372,6 +567,9 @@ int XPlmi_ProcessCdo(XPlmiCdo *CdoPtr)
 	u32 CopiedCmdLen = CdoPtr->CopiedCmdLen;
 	u32 *BufPtr = CdoPtr->BufPtr;
 	u32 BufLen = CdoPtr->BufLen;
+#ifdef PLM_CDO_COALESCE_WRITES
+	u32 CdoOffset;
+#endif
 
 	/** verify the header for the first chunk of CDO */
 	if (CdoPtr->Cdo1stChunk == TRUE)
@@ -435,8 +633,30 @@ int XPlmi_ProcessCdo(XPlmiCdo *CdoPtr)
 			Status =
 			   XPlmi_CdoCmdResume(CdoPtr, BufPtr, BufLen, &Size);
 		} else {
+#ifdef PLM_CDO_COALESCE_WRITES
+			/**
+			 * A command copied to the temporary buffer started
+			 * CopiedCmdLen words before the end of the last chunk
+			 */
+			if (CopiedCmdLen != 0U)
+			{
+				CdoOffset = CdoPtr->ProcessedCdoLen -
+						CopiedCmdLen;
+			} else {
+				CdoOffset = CdoPtr->ProcessedCdoLen +
+						CdoPtr->BufLen - BufLen;
+			}
+			Status = XPlmi_CdoFastCmd(BufPtr, BufLen, CdoOffset,
+						  &Size);
+			if ((Status == XST_SUCCESS) && (Size == 0U))
+			{
+				Status = XPlmi_CdoCmdExecute(CdoPtr, BufPtr,
+							     BufLen, &Size);
+			}
+#else
 			Status =
 			   XPlmi_CdoCmdExecute(CdoPtr, BufPtr, BufLen, &Size);
+#endif
 		}
 		/**
 		 * if command end is detected, or in case of any error,
@@ -460,6 +680,15 @@ int XPlmi_ProcessCdo(XPlmiCdo *CdoPtr)
 		}
 	}
 
+#ifdef PLM_CDO_COALESCE_WRITES
+	/** Issue the writes pending at the end of the chunk */
+	Status = XPlmi_CdoFlushWrites();
+	if (Status != XST_SUCCESS)
+	{
+		goto END;
+	}
+#endif
+
 	CdoPtr->ProcessedCdoLen += CdoPtr->BufLen;
 END:
 	return Status;
@@ -89,6 +89,43 @@ extern "C" {
  */
 #define PLM_PRINT_PERF
 
+/**
+ * Enabling the PLM_PRINT_PERF_CDO along with PLM_PRINT_PERF prints, for
+ * every CDO partition, the time spent waiting for chunk copies, in
+ * authentication and decryption and in CDO command execution.
+ */
+//#define PLM_PRINT_PERF_CDO
+
+/**
+ * Enabling the PLM_PRINT_PERF_SECURE along with PLM_PRINT_PERF prints, for
+ * every secure partition, the time spent waiting for block copies and
+ * hashes, in decryption and in hash and signature verification.
+ */
+//#define PLM_PRINT_PERF_SECURE
+
+/**
+ * Enabling the PLM_SECURE_STREAM copies, hashes and decrypts the blocks of
+ * encrypted CDO partitions in a single pass over the PMC RAM, with the SHA3
+ * engine on PMCDMA1 and the AES engine on PMCDMA0 running in parallel.
+ * The data is then decrypted in place in the PMC RAM before the hash of the
+ * block is verified; the PMC RAM is cleared if the verification fails.
+ * Encrypted partitions loaded to other memories are not streamed.
+ */
+//#define PLM_SECURE_STREAM
+
+/**
+ * Enabling the PLM_PRINT_DEFERRED stores the PLM prints in a ring buffer
+ * of XPLMI_LOG_BUF_LEN bytes instead of writing them to the UART. The
+ * buffer is printed when the PLM is idle, so the prints do not stall the
+ * code which issues them. Prints which do not fit in the buffer are
+ * dropped and counted. A dump of the buffer can be decoded with
+ * lib/bsp/standalone/tools/xil_log_decode.c.
+ */
+//#define PLM_PRINT_DEFERRED
+#ifndef XPLMI_LOG_BUF_LEN
+#define XPLMI_LOG_BUF_LEN	(0x1000U)
+#endif
+
 /**
  * @name PLM code include options
  *
@@ -101,6 +138,26 @@ extern "C" {
 //#define PLM_QSPI_EXCLUDE
 //#define PLM_SD_EXCLUDE
 
+/**
+ * @name PLM CDO processing options
+ *
+ *  PLM by default executes every CDO command through its module handler.
+ *  - PLM_CDO_COALESCE_WRITES Runs of CDO write commands to consecutive
+ *    NPI addresses are collected and issued as one PMC DMA transfer, and
+ *    write and mask write commands are executed without the module
+ *    handler lookup. This changes the width and timing of the NPI
+ *    accesses, so it is disabled by default.
+ */
+//#define PLM_CDO_COALESCE_WRITES
+
+/**
+ * @name PLM scheduler options
+ *
+ *  - XPLMI_SCHED_MAX_TASK Number of timers which can be added to the
+ *    scheduler. Each timer takes about 64 bytes. Default is 32.
+ */
+//#define XPLMI_SCHED_MAX_TASK	(32U)
+
 /**
  * @name PLM Error management options
  *
@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   07/13/2018 Initial release
+*       ag   10/16/2026 Added deferred prints
 *
 * </pre>
 *
@@ -54,6 +55,7 @@
 #include "xpm_subsystem.h"
 #include "xpm_nodeid.h"
 #include "xplmi_status.h"
+#include "xil_logbuf.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -74,6 +76,9 @@
 XUartPsv UartPsvIns;          /* The instance of the UART Driver */
 #endif
 u32 LpdInitialized = FALSE;
+#ifdef PLM_PRINT_DEFERRED
+static u32 XPlmi_LogBuf[XPLMI_LOG_BUF_LEN / 4U];
+#endif
 /*****************************************************************************/
 
 
@@ -141,6 +146,35 @@ int XPlmi_InitUart(void )
 	LpdInitialized |= UART_INITIALIZED;
 #endif
 
+#ifdef PLM_PRINT_DEFERRED
+	Xil_LogInit(XPlmi_LogBuf, sizeof(XPlmi_LogBuf));
+#endif
+
 END:
 	return Status;
 }
+
+/*****************************************************************************/
+/**
+ * This function outputs the prints deferred with PLM_PRINT_DEFERRED.
+ *
+ * @param MaxRecords is the maximum number of prints to output, 0 for all.
+ * The task dispatcher outputs XPLMI_LOG_DRAIN_RECORDS prints per idle loop
+ * iteration, so that tasks queued meanwhile are not delayed by the whole
+ * buffer.
+ *
+ * @return	Number of words still pending in the buffer
+ *
+ *****************************************************************************/
+u32 XPlmi_LogDrain(u32 MaxRecords)
+{
+	u32 Pending = 0U;
+
+#ifdef PLM_PRINT_DEFERRED
+	Pending = Xil_LogDrain(MaxRecords);
+#else
+	(void)MaxRecords;
+#endif
+
+	return Pending;
+}
@@ -35,6 +35,7 @@
 * Ver	Who	Date		Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00a kc   07/13/2018 Initial release
+*       ag   10/16/2026 Added XPlmi_LogDrain for deferred prints
 *
 * </pre>
 *
@@ -101,10 +102,14 @@ extern "C" {
 /************************** Function Prototypes ******************************/
 /* Functions defined in xplmi_uart.c */
 int XPlmi_InitUart(void );
+u32 XPlmi_LogDrain(u32 MaxRecords);
 
 /************************** Variable Definitions *****************************/
 extern u32 LpdInitialized;
 
+/* Number of deferred prints output per idle loop iteration */
+#define XPLMI_LOG_DRAIN_RECORDS		(8U)
+
 #define UART_INITIALIZED	1U << 0U
 #define LPD_INITIALIZED		1U << 1U
 #define XPlmi_ResetLpdInitialized()	\
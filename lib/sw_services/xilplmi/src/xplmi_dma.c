@@ -34,6 +34,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   12/21/2018 Initial release
+*       ag   10/16/2026 Release AES and SHA paths of a DMA used for
+*                       DMA transfers
 *
 * </pre>
 *
@@ -53,6 +55,7 @@
 /**************************** Type Definitions *******************************/
 /***************** Macros (Inline Functions) Definitions *********************/
 /************************** Function Prototypes ******************************/
+static void XPlmi_SSSCfgReleaseDma(u32 Flags);
 
 /************************** Variable Definitions *****************************/
 XCsuDma CsuDma0;		/**<Instance of the Csu_Dma Device */
@@ -159,6 +162,39 @@ XCsuDma *XPlmi_GetDmaInstance(u32 DeviceId)
 	return CsuDmaPtr;
 }
 
+/*****************************************************************************/
+/**
+ * This function releases the AES and SHA paths which take the selected DMA
+ * as input. The secure library leaves them configured between the updates
+ * of a message, and the DMA data must not be fed to the engines.
+ *
+ * @param Flags Flags to select PMC DMA
+ * @return  none
+ *****************************************************************************/
+static void XPlmi_SSSCfgReleaseDma(u32 Flags)
+{
+	u32 SssCfg = XPlmi_In32(PMC_GLOBAL_PMC_SSS_CFG);
+	u32 AesDma = 0U;
+	u32 ShaDma = 0U;
+
+	if ((Flags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) {
+		AesDma = XPLMI_SSS_AES_DMA0;
+		ShaDma = XPLMI_SSS_SHA_DMA0;
+	} else if ((Flags & XPLMI_PMCDMA_1) == XPLMI_PMCDMA_1) {
+		AesDma = XPLMI_SSS_AES_DMA1;
+		ShaDma = XPLMI_SSS_SHA_DMA1;
+	}
+
+	if ((AesDma != 0U) && ((SssCfg & XPLMI_SSSCFG_AES_MASK) == AesDma)) {
+		XPlmi_UtilRMW(PMC_GLOBAL_PMC_SSS_CFG,
+				XPLMI_SSSCFG_AES_MASK, 0U);
+	}
+	if ((ShaDma != 0U) && ((SssCfg & XPLMI_SSSCFG_SHA_MASK) == ShaDma)) {
+		XPlmi_UtilRMW(PMC_GLOBAL_PMC_SSS_CFG,
+				XPLMI_SSSCFG_SHA_MASK, 0U);
+	}
+}
+
 /*****************************************************************************/
 /**
  * This function is used set SSS configuration for DMA to DMA
@@ -170,6 +206,7 @@ void XPlmi_SSSCfgDmaDma(u32 Flags)
 {
 
 	XPlmi_Printf(DEBUG_DETAILED, "SSS config for DMA0/1 to DMA0/1\n\r");
+	XPlmi_SSSCfgReleaseDma(Flags);
 
 	/* it is DMA0/1 to DMA0/1 configuration */
 	if ((Flags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) {
@@ -224,6 +261,7 @@ void XPlmi_SSSCfgDmaPzm(u32 Flags)
 {
 
 	XPlmi_Printf(DEBUG_DETAILED, "SSS config for DMA0/1 to PZM\n\r");
+	XPlmi_SSSCfgReleaseDma(Flags);
 
 	/* it is DMA0/1 to DMA0/1 configuration */
 	if ((Flags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) {
@@ -248,6 +286,7 @@ void XPlmi_SSSCfgDmaSbi(u32 Flags)
 {
 
 	XPlmi_Printf(DEBUG_DETAILED, "SSS config for DMA0/1 to SBI\n\r");
+	XPlmi_SSSCfgReleaseDma(Flags);
 
 	if ((Flags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) {
 		XPlmi_UtilRMW(PMC_GLOBAL_PMC_SSS_CFG,
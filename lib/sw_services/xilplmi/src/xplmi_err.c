@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ====  ==== ======== ======================================================-
 * 1.00  kc   02/12/2019 Initial release
+*       ag   10/16/2026 Output deferred prints before the reset
 *
 * </pre>
 *
@@ -84,6 +85,8 @@ void XPlmi_ErrMgr(int Status)
 	if (XPlmi_IsLoadBootPdiDone() == FALSE)
 	{
 		XPlmi_DumpRegisters();
+		/* Output the deferred prints before the reset */
+		(void)XPlmi_LogDrain(0U);
 		/** Update Multiboot register */
 		RegVal = XPlmi_In32(PMC_GLOBAL_PMC_MULTI_BOOT);
 		XPlmi_Out32(PMC_GLOBAL_PMC_MULTI_BOOT, ++RegVal);
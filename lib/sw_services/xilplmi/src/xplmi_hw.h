@@ -105,6 +105,11 @@ extern "C" {
 
 #define XPlmi_Out64(Addr, Data)		swea(Addr, Data)
 
+/**
+ * NPI address range
+ */
+#define XPLMI_NPI_BASEADDR		(0xF6000000U)
+#define XPLMI_NPI_HIGHADDR		(0xF7FFFFFFU)
 
 /**
  * Definitions required from pmc_tap.h
@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   02/07/2019 Initial release
+*       ag   10/16/2026 Exported XPlmi_PrintTime
 *
 * </pre>
 *
@@ -109,6 +110,7 @@ void XPlmi_IntrHandler(void *CallbackRef);
 u64 XPlmi_GetTimerValue(void );
 int XPlmi_SetUpInterruptSystem();
 void XPlmi_MeasurePerfTime(u64 tCur);
+void XPlmi_PrintTime(u64 tCur, u64 tEnd);
 void XPlmi_PlmIntrEnable(u32 IntrId);
 void XPlmi_PlmIntrDisable(u32 IntrId);
 void XPlmi_RegisterHandler(u32 IntrId, Function_t Handler, void * Data);
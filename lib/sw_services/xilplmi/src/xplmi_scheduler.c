@@ -25,63 +25,229 @@
 ******************************************************************************/
 
 
+/*****************************************************************************/
+/**
+*
+* @file xplmi_scheduler.c
+*
+* This file contains the PLM scheduler. Timers are kept in a hierarchical
+* timer wheel of XPLMI_SCHED_WHEEL_LEVELS levels with XPLMI_SCHED_WHEEL_SLOTS
+* slots each. A timer which expires within 64 ticks is placed in level 0,
+* within 64^2 ticks in level 1 and so on. Every tick runs the level 0 slot
+* of the current tick, and whenever a level wraps the matching slot of the
+* next level is cascaded down. The cost of a tick is thus proportional to
+* the number of timers expiring or cascading on it, independent of the
+* number of registered timers.
+*
+* Expired timers are appended to a ready list from the PIT3 interrupt and
+* their callbacks are run, in expiry order, from a single PLM task.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  ag   10/16/2026 Replaced the fixed task scan with a timer wheel,
+*                       added one-shot timers and jitter statistics
+*       ag   10/16/2026 Read the timer statistics with interrupts masked
+*       ag   10/16/2026 Added XPLmi_SchedulerRemoveTask for existing callers
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
 #include "xplmi_scheduler.h"
 #include "xplmi_task.h"
+#include "xplmi_util.h"
+#include "xplmi_debug.h"
+#include "xplmi_status.h"
+
+/************************** Constant Definitions *****************************/
+/** Interrupt enable bit of the MicroBlaze MSR */
+#define XPLMI_SCHED_MSR_IE_MASK		(0x2U)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
 
+/************************** Function Prototypes ******************************/
 
+/************************** Variable Definitions *****************************/
 static XPlmi_Scheduler_t Sched;
 
-static int XPlimi_IsTask_active(XPlmi_Scheduler_t *SchedPtr, int TaskListIndex)
+/*****************************************************************************/
+/**
+ * @brief This function masks the interrupts, so that the timer lists are
+ * not modified by the tick handler while they are being updated
+ *
+ * @param None
+ *
+ * @return Previous MSR value to be passed to XPlmi_SchedUnlock
+ *
+ *****************************************************************************/
+static u32 XPlmi_SchedLock(void)
 {
-	int ReturnVal = FALSE;
+	u32 Msr = (u32)mfmsr();
 
-	/* Periodic */
-	if ((0U != SchedPtr->TaskList[TaskListIndex].Interval)
-		&& (NULL != SchedPtr->TaskList[TaskListIndex].CustomerFunc)
-		&& (0U == (SchedPtr->Tick
-				% SchedPtr->TaskList[TaskListIndex].Interval))) {
-		ReturnVal = TRUE;
-	} else if ((0U == SchedPtr->TaskList[TaskListIndex].Interval)
-			&& (NULL != SchedPtr->TaskList[TaskListIndex].CustomerFunc)) {
-		/* Non-Periodic */
-		ReturnVal = TRUE;
-	} else {
-		/** Do Nothing */
+	microblaze_disable_interrupts();
+	return Msr;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function re-enables the interrupts if they were enabled when
+ * XPlmi_SchedLock was called
+ *
+ * @param Msr MSR value returned by XPlmi_SchedLock
+ *
+ * @return None
+ *
+ *****************************************************************************/
+static void XPlmi_SchedUnlock(u32 Msr)
+{
+	if ((Msr & XPLMI_SCHED_MSR_IE_MASK) != 0U) {
+		microblaze_enable_interrupts();
 	}
+}
 
-	return ReturnVal;
+/*****************************************************************************/
+/**
+ * @brief This function converts milliseconds to scheduler ticks, rounding
+ * up to at least one tick
+ *
+ * @param MilliSeconds Time in milliseconds
+ *
+ * @return Number of ticks
+ *
+ *****************************************************************************/
+static u32 XPlmi_SchedMsToTicks(u32 MilliSeconds)
+{
+	u32 Ticks = (MilliSeconds / XPLMI_SCHED_TICK_MS) +
+		(((MilliSeconds % XPLMI_SCHED_TICK_MS) != 0U) ? 1U : 0U);
+
+	if (Ticks == 0U) {
+		Ticks = 1U;
+	}
+
+	return Ticks;
 }
 
-static int XPlmi_IsTask_NonPeriodic(XPlmi_Scheduler_t *SchedPtr, int TaskListIndex)
+/*****************************************************************************/
+/**
+ * @brief This function places a timer in the wheel slot of its expiry.
+ * The level is chosen by the distance to the expiry, and the slot by the
+ * bits of the expiry tick belonging to that level.
+ *
+ * @param Task Pointer to the timer
+ *
+ * @return None
+ *
+ *****************************************************************************/
+static void XPlmi_SchedInsert(struct XPlmi_Task_t *Task)
 {
-	int ReturnVal = FALSE;
+	u32 Delta = Task->Expires - Sched.Tick;
+	u32 Level = 0U;
+	u32 Slot;
 
-	if ((0U == SchedPtr->TaskList[TaskListIndex].Interval)
-		&& (NULL != SchedPtr->TaskList[TaskListIndex].CustomerFunc)) {
-		ReturnVal = TRUE;
-	} else {
-		/** Do Nothing */
+	while ((Level < (XPLMI_SCHED_WHEEL_LEVELS - 1U)) &&
+		(Delta >= (1U << (XPLMI_SCHED_WHEEL_BITS * (Level + 1U))))) {
+		Level++;
 	}
 
-	return ReturnVal;
+	Slot = (Task->Expires >> (XPLMI_SCHED_WHEEL_BITS * Level)) &
+		XPLMI_SCHED_WHEEL_MASK;
+	metal_list_add_tail(&Sched.Wheel[Level][Slot], &Task->WheelNode);
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function moves the timers of a higher level slot down to
+ * the levels matching their remaining time
+ *
+ * @param Level Wheel level
+ * @param Slot Slot index in the level
+ *
+ * @return None
+ *
+ *****************************************************************************/
+static void XPlmi_SchedCascade(u32 Level, u32 Slot)
+{
+	struct metal_list *List = &Sched.Wheel[Level][Slot];
+	struct metal_list *Node;
+
+	while (!metal_list_is_empty(List)) {
+		Node = List->next;
+		metal_list_del(Node);
+		XPlmi_SchedInsert((struct XPlmi_Task_t *)
+			metal_container_of(Node, struct XPlmi_Task_t, WheelNode));
+	}
 }
 
+/*****************************************************************************/
+/**
+ * @brief This function releases a timer and unlinks it from the wheel and
+ * the ready list
+ *
+ * @param Task Pointer to the timer
+ *
+ * @return None
+ *
+ *****************************************************************************/
+static void XPlmi_SchedFree(struct XPlmi_Task_t *Task)
+{
+	if (!metal_list_is_empty(&Task->WheelNode)) {
+		metal_list_del(&Task->WheelNode);
+	}
+	if (!metal_list_is_empty(&Task->ReadyNode)) {
+		metal_list_del(&Task->ReadyNode);
+	}
+	Task->Interval = 0U;
+	Task->OwnerId = 0U;
+	Task->Status = XPLMI_TASK_STATUS_DISABLED;
+	Task->CustomerFunc = NULL;
+	Sched.TaskCount--;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function initializes the scheduler, with all the timers
+ * disabled and the wheel empty
+ *
+ * @param None
+ *
+ * @return XST_SUCCESS
+ *
+ *****************************************************************************/
 int XPlmi_SchedulerInit(void)
 {
-	int Idx;
+	u32 Idx;
+	u32 Slot;
 	int Status = XST_FAILURE;
 
-
 	/* Disable all the tasks */
 	for (Idx = 0U; Idx < XPLMI_SCHED_MAX_TASK; Idx++) {
 		Sched.TaskList[Idx].Interval = 0U;
 		Sched.TaskList[Idx].CustomerFunc = NULL;
 		Sched.TaskList[Idx].Status = XPLMI_TASK_STATUS_DISABLED;
+		metal_list_init(&Sched.TaskList[Idx].WheelNode);
+		metal_list_init(&Sched.TaskList[Idx].ReadyNode);
 	}
 
+	for (Idx = 0U; Idx < XPLMI_SCHED_WHEEL_LEVELS; Idx++) {
+		for (Slot = 0U; Slot < XPLMI_SCHED_WHEEL_SLOTS; Slot++) {
+			metal_list_init(&Sched.Wheel[Idx][Slot]);
+		}
+	}
+	metal_list_init(&Sched.ReadyList);
+
+	Sched.TaskCount = 0U;
 	Sched.Enabled = FALSE;
-	Sched.PitBaseAddr = 0x0;
+	Sched.PitBaseAddr = 0x0U;
 	Sched.Tick = 0U;
+	Sched.RunPending = FALSE;
 
 	/* Successfully completed init */
 	Status = XST_SUCCESS;
@@ -111,79 +277,349 @@ int XPlmi_SchedulerStop(XPlmi_Scheduler_t *SchedPtr)
 	return XST_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+ * @brief This function advances the timer wheel by one tick. Slots of the
+ * higher levels are cascaded when the lower level wraps, and the timers of
+ * the current level 0 slot are appended to the ready list. Periodic timers
+ * are re-armed relative to their expiry, so they do not drift. A timer
+ * which expires while its previous run is still pending is counted as an
+ * overrun and not queued twice.
+ *
+ * It is called from the PIT3 interrupt, and can be called directly to
+ * drive the scheduler from another tick source.
+ *
+ * @param None
+ *
+ * @return Number of timers queued by this tick
+ *
+ *****************************************************************************/
+u32 XPlmi_SchedulerTick(void)
+{
+	struct metal_list *List;
+	struct metal_list *Node;
+	struct XPlmi_Task_t *Task;
+	u32 Level;
+	u32 Index;
+	u32 Queued = 0U;
+
+	Sched.Tick++;
+
+	Index = Sched.Tick & XPLMI_SCHED_WHEEL_MASK;
+	for (Level = 1U; (Level < XPLMI_SCHED_WHEEL_LEVELS) && (Index == 0U);
+			Level++) {
+		Index = (Sched.Tick >> (XPLMI_SCHED_WHEEL_BITS * Level)) &
+			XPLMI_SCHED_WHEEL_MASK;
+		XPlmi_SchedCascade(Level, Index);
+	}
+
+	List = &Sched.Wheel[0U][Sched.Tick & XPLMI_SCHED_WHEEL_MASK];
+	while (!metal_list_is_empty(List)) {
+		Node = List->next;
+		metal_list_del(Node);
+		Task = (struct XPlmi_Task_t *)
+			metal_container_of(Node, struct XPlmi_Task_t, WheelNode);
+
+		if (Task->Status == XPLMI_TASK_STATUS_TRIGGERED) {
+			Task->Stats.Overruns++;
+		} else {
+			Task->Status = XPLMI_TASK_STATUS_TRIGGERED;
+			Task->QueuedTick = Sched.Tick;
+			metal_list_add_tail(&Sched.ReadyList, &Task->ReadyNode);
+			Queued++;
+		}
+
+		if (Task->Interval != 0U) {
+			Task->Expires += Task->Interval;
+			XPlmi_SchedInsert(Task);
+		}
+	}
+
+	return Queued;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function runs the callbacks of the expired timers in the
+ * order in which they expired, and updates their statistics. One-shot
+ * timers are released before their callback is called, so the callback
+ * may add them again.
+ *
+ * @param Data Not used
+ *
+ * @return XST_SUCCESS, or the last error returned by a callback
+ *
+ *****************************************************************************/
+int XPlmi_SchedulerRunExpired(void *Data)
+{
+	int Status = XST_SUCCESS;
+	int CbStatus;
+	struct metal_list *Node;
+	struct XPlmi_Task_t *Task;
+	XPlmi_Callback_t CallbackFn;
+	u32 Late;
+	u32 Msr;
+
+	(void)Data;
+
+	while (TRUE) {
+		Msr = XPlmi_SchedLock();
+		if (metal_list_is_empty(&Sched.ReadyList)) {
+			Sched.RunPending = FALSE;
+			XPlmi_SchedUnlock(Msr);
+			break;
+		}
+
+		Node = Sched.ReadyList.next;
+		metal_list_del(Node);
+		Task = (struct XPlmi_Task_t *)
+			metal_container_of(Node, struct XPlmi_Task_t, ReadyNode);
+		Task->Status = XPLMI_TASK_STATUS_DISABLED;
+
+		Late = Sched.Tick - Task->QueuedTick;
+		Task->Stats.RunCount++;
+		Task->Stats.LateTotal += Late;
+		if (Late > Task->Stats.LateMax) {
+			Task->Stats.LateMax = Late;
+		}
+
+		CallbackFn = Task->CustomerFunc;
+		if (Task->Interval == 0U) {
+			XPlmi_SchedFree(Task);
+		}
+		XPlmi_SchedUnlock(Msr);
+
+		CbStatus = CallbackFn();
+		if (CbStatus != XST_SUCCESS) {
+			Status = CbStatus;
+		}
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function is the PIT3 interrupt handler. It advances the
+ * timer wheel and, if timers have expired, queues the task which runs
+ * their callbacks.
+ *
+ * @param None
+ *
+ * @return XST_SUCCESS, or an error if the task could not be created
+ *
+ *****************************************************************************/
 int XPlmi_SchedulerHandler(void)
 {
-	int Idx;
 	int Status = XST_FAILURE;
 	XPlmi_TaskNode *Task;
-    /* XPlmi_Printf(DEBUG_GENERAL,"Received :XPlmi_SchedulerHandler\n\r"); */
+
 	XPlmi_UtilRMW(PMC_PMC_MB_IO_IRQ_ACK, PMC_PMC_MB_IO_IRQ_ACK, 0x20);
-	for (Idx = 0U; Idx < XPLMI_SCHED_MAX_TASK; Idx++)
+	(void)XPlmi_SchedulerTick();
+
+	if ((!metal_list_is_empty(&Sched.ReadyList)) &&
+		(Sched.RunPending == FALSE))
 	{
-		/* Check if the task is triggered and has a valid Callback */
-		if (NULL != Sched.TaskList[Idx].CustomerFunc)
+		Task = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_1,
+				XPlmi_SchedulerRunExpired, NULL);
+		if (Task == NULL)
 		{
-			/* Execute the Task */
-			Task = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_1, Sched.TaskList[Idx].CustomerFunc, 0U);
-			if (Task == NULL)
-			{
-				Status = XPLMI_UPDATE_STATUS(XPLM_ERR_TASK_CREATE, 0x0);
-				goto END;
-			}
-			XPlmi_TaskTriggerNow(Task);
-			}
+			Status = XPLMI_UPDATE_STATUS(XPLM_ERR_TASK_CREATE, 0x0);
+			goto END;
+		}
+		Sched.RunPending = TRUE;
+		XPlmi_TaskTriggerNow(Task);
 	}
+	Status = XST_SUCCESS;
+
 END:
 	return Status;
 }
 
-int XPlmi_SchedulerAddTask(XPlmi_Callback_t CallbackFn, int MilliSeconds)
+/*****************************************************************************/
+/**
+ * @brief This function adds a timer
+ *
+ * @param OwnerId Owner of the timer, used to remove it
+ * @param CallbackFn Function called when the timer expires
+ * @param MilliSeconds Period or delay, rounded up to whole ticks of
+ * XPLMI_SCHED_TICK_MS
+ * @param Type XPLMI_SCHED_PERIODIC or XPLMI_SCHED_ONESHOT
+ *
+ * @return XST_SUCCESS, XST_INVALID_PARAM for a NULL callback, invalid type
+ * or a time beyond XPLMI_SCHED_MAX_TICKS, XST_FAILURE if all
+ * XPLMI_SCHED_MAX_TASK timers are in use
+ *
+ *****************************************************************************/
+int XPlmi_SchedulerAddTimer(u32 OwnerId, XPlmi_Callback_t CallbackFn,
+		u32 MilliSeconds, u32 Type)
 {
-	int Idx;
-	int Status = XST_FAILURE;
+	u32 Idx;
+	u32 Ticks = XPlmi_SchedMsToTicks(MilliSeconds);
+	u32 Msr;
+	struct XPlmi_Task_t *Task;
+	int Status = XST_INVALID_PARAM;
+
+	if ((CallbackFn == NULL) || (Ticks > XPLMI_SCHED_MAX_TICKS) ||
+		((Type != XPLMI_SCHED_PERIODIC) &&
+		 (Type != XPLMI_SCHED_ONESHOT))) {
+		goto done;
+	}
+
+	Status = XST_FAILURE;
+	Msr = XPlmi_SchedLock();
 
 	/* Get the Next Free Task Index */
-	for (Idx=0U;Idx < XPLMI_SCHED_MAX_TASK;Idx++) {
-		if (NULL == Sched.TaskList[Idx].CustomerFunc){
+	for (Idx = 0U; Idx < XPLMI_SCHED_MAX_TASK; Idx++) {
+		if (NULL == Sched.TaskList[Idx].CustomerFunc) {
 			break;
 		}
 	}
 
 	/* Check if we have reached Max Task limit */
 	if (XPLMI_SCHED_MAX_TASK == Idx) {
+		XPlmi_SchedUnlock(Msr);
 		goto done;
 	}
 
-	/* Add Interval as a factor of TICK_MILLISECONDS */
-	Sched.TaskList[Idx].Interval = MilliSeconds;
-	Sched.TaskList[Idx].OwnerId = 0;
-	Sched.TaskList[Idx].CustomerFunc = CallbackFn;
+	Task = &Sched.TaskList[Idx];
+	Task->Interval = (Type == XPLMI_SCHED_PERIODIC) ? Ticks : 0U;
+	Task->Expires = Sched.Tick + Ticks;
+	Task->OwnerId = OwnerId;
+	Task->Status = XPLMI_TASK_STATUS_DISABLED;
+	Task->CustomerFunc = CallbackFn;
+	Task->Stats.RunCount = 0U;
+	Task->Stats.Overruns = 0U;
+	Task->Stats.LateMax = 0U;
+	Task->Stats.LateTotal = 0U;
+	XPlmi_SchedInsert(Task);
+	Sched.TaskCount++;
+
+	XPlmi_SchedUnlock(Msr);
 	Status = XST_SUCCESS;
 
 done:
 	return Status;
 }
 
-int XPlmi_SchedulerRemoveTask(XPlmi_Scheduler_t *SchedPtr, int OwnerId, int MilliSeconds, XPlmi_Callback_t CallbackFn)
+/*****************************************************************************/
+/**
+ * @brief This function adds a periodic timer with owner ID 0
+ *
+ * @param CallbackFn Function called every period
+ * @param MilliSeconds Period in milliseconds
+ *
+ * @return XST_SUCCESS on success, see XPlmi_SchedulerAddTimer otherwise
+ *
+ *****************************************************************************/
+int XPlmi_SchedulerAddTask(XPlmi_Callback_t CallbackFn, int MilliSeconds)
 {
-	int Idx;
+	return XPlmi_SchedulerAddTimer(0U, CallbackFn, (u32)MilliSeconds,
+			XPLMI_SCHED_PERIODIC);
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function removes the timers matching the owner and callback.
+ * A pending run of a removed timer is dropped.
+ *
+ * @param OwnerId Owner of the timer
+ * @param MilliSeconds Period or delay of the timer, 0 to match any
+ * @param CallbackFn Callback of the timer
+ *
+ * @return XST_SUCCESS if at least one timer was removed, else XST_FAILURE
+ *
+ *****************************************************************************/
+int XPlmi_SchedulerRemoveTask(u32 OwnerId, u32 MilliSeconds,
+		XPlmi_Callback_t CallbackFn)
+{
+	u32 Idx;
 	u32 TaskCount = 0U;
+	u32 Ticks = XPlmi_SchedMsToTicks(MilliSeconds);
+	u32 Msr;
+	struct XPlmi_Task_t *Task;
+
+	Msr = XPlmi_SchedLock();
 
 	/*Find the Task Index */
 	for (Idx = 0U; Idx < XPLMI_SCHED_MAX_TASK; Idx++) {
-		if ((CallbackFn == SchedPtr->TaskList[Idx].CustomerFunc) &&
-		    (SchedPtr->TaskList[Idx].OwnerId == OwnerId) &&
-		    ((SchedPtr->TaskList[Idx].Interval == (MilliSeconds)) ||
-				(0U == MilliSeconds))) {
-			SchedPtr->TaskList[Idx].Interval = 0U;
-			SchedPtr->TaskList[Idx].OwnerId = 0U;
-			SchedPtr->TaskList[Idx].CustomerFunc = NULL;
+		Task = &Sched.TaskList[Idx];
+		if ((Task->CustomerFunc != NULL) &&
+		    (CallbackFn == Task->CustomerFunc) &&
+		    (Task->OwnerId == OwnerId) &&
+		    ((0U == MilliSeconds) || (Task->Interval == Ticks) ||
+		     ((Task->Interval == 0U) &&
+		      ((Task->Expires - Sched.Tick) <= Ticks)))) {
+			XPlmi_SchedFree(Task);
 			TaskCount++;
 		}
 	}
 
+	XPlmi_SchedUnlock(Msr);
+
 	XPlmi_Printf(DEBUG_DETAILED,"%s: Removed %lu tasks\r\n",
 			__func__, TaskCount);
 
 	return ((TaskCount > 0U) ? XST_SUCCESS : XST_FAILURE);
 }
+
+/*****************************************************************************/
+/**
+ * @brief This function removes the timers matching the owner and callback.
+ * It is the previous interface of XPlmi_SchedulerRemoveTask and is kept for
+ * existing callers.
+ *
+ * @param SchedPtr Unused
+ * @param CustId Owner of the timer
+ * @param MilliSeconds Period or delay of the timer, 0 to match any
+ * @param UserFunc Callback of the timer
+ *
+ * @return XST_SUCCESS if at least one timer was removed, else XST_FAILURE
+ *
+ * @note Deprecated, use XPlmi_SchedulerRemoveTask
+ *
+ *****************************************************************************/
+int XPLmi_SchedulerRemoveTask(XPlmi_Scheduler_t *SchedPtr, int CustId,
+		int MilliSeconds, XPlmi_Callback_t UserFunc)
+{
+	(void)SchedPtr;
+
+	return XPlmi_SchedulerRemoveTask((u32)CustId, (u32)MilliSeconds,
+			UserFunc);
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function returns the statistics of a timer
+ *
+ * @param OwnerId Owner of the timer
+ * @param CallbackFn Callback of the timer
+ * @param Stats Pointer to the statistics to be filled
+ *
+ * @return XST_SUCCESS if the timer was found, else XST_FAILURE
+ *
+ *****************************************************************************/
+int XPlmi_SchedulerGetStats(u32 OwnerId, XPlmi_Callback_t CallbackFn,
+		XPlmi_SchedStats *Stats)
+{
+	u32 Idx;
+	u32 Msr;
+	int Status = XST_FAILURE;
+
+	/* The tick handler and the ready task update the statistics */
+	Msr = XPlmi_SchedLock();
+
+	for (Idx = 0U; Idx < XPLMI_SCHED_MAX_TASK; Idx++) {
+		if ((Sched.TaskList[Idx].CustomerFunc == CallbackFn) &&
+		    (CallbackFn != NULL) &&
+		    (Sched.TaskList[Idx].OwnerId == OwnerId)) {
+			*Stats = Sched.TaskList[Idx].Stats;
+			Status = XST_SUCCESS;
+			break;
+		}
+	}
+
+	XPlmi_SchedUnlock(Msr);
+
+	return Status;
+}
@@ -25,6 +25,32 @@
 ******************************************************************************/
 
 
+/*****************************************************************************/
+/**
+*
+* @file xplmi_scheduler.h
+*
+* This file contains the declarations of the PLM scheduler. Timers are kept
+* in a hierarchical timer wheel which is advanced by the PIT3 tick, so a
+* tick only touches the timers which expire or cascade on it. Expired
+* timers are queued and their callbacks are run from one PLM task.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  ag   10/16/2026 Replaced the fixed task scan with a timer wheel,
+*                       added one-shot timers and jitter statistics
+*       ag   10/16/2026 Kept XPlmiSchedulerStop and XPLmi_SchedulerRemoveTask
+*                       as deprecated names
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
 #ifndef XPLMI_SCHEDULER_H
 #define XPLMI_SCHEDULER_H
 
@@ -32,9 +58,34 @@
 extern "C" {
 #endif
 
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+#include "xplmi_config.h"
+#include "list.h"
+
+/************************** Constant Definitions *****************************/
+/** Number of timers which can be registered, see xplmi_config.h */
+#ifndef XPLMI_SCHED_MAX_TASK
+#define XPLMI_SCHED_MAX_TASK	(32U)
+#endif
+
+/** Scheduler tick period, PIT3 is loaded for 100ms */
+#define XPLMI_SCHED_TICK_MS		(100U)
 
+/** Timer wheel geometry: levels of 64 slots, covering 2^18 ticks */
+#define XPLMI_SCHED_WHEEL_BITS		(6U)
+#define XPLMI_SCHED_WHEEL_SLOTS		(1U << XPLMI_SCHED_WHEEL_BITS)
+#define XPLMI_SCHED_WHEEL_MASK		(XPLMI_SCHED_WHEEL_SLOTS - 1U)
+#define XPLMI_SCHED_WHEEL_LEVELS	(3U)
+#define XPLMI_SCHED_MAX_TICKS		((1U << (XPLMI_SCHED_WHEEL_BITS * \
+					XPLMI_SCHED_WHEEL_LEVELS)) - 1U)
 
-#define XPLMI_SCHED_MAX_TASK	10U
+/** Timer types */
+#define XPLMI_SCHED_PERIODIC		(0U)
+#define XPLMI_SCHED_ONESHOT		(1U)
+
+/** Deprecated name of XPlmi_SchedulerStop, kept for existing callers */
+#define XPlmiSchedulerStop		XPlmi_SchedulerStop
 
 /* Values for TaskPtr->Status */
 #define XPLMI_TASK_STATUS_TRIGGERED	0x5AFEC0C0U
@@ -45,29 +96,61 @@ extern "C" {
 #define PMC_PMC_MB_IO_IRQ_ACK_WIDTH   (0x1U)
 #define PMC_PMC_MB_IO_IRQ_ACK_MASK    (0X0000020U)
 
+/**************************** Type Definitions *******************************/
 typedef int (*XPlmi_Callback_t)(void);
 
+/**
+ * Per timer statistics. Lateness is the number of ticks between the expiry
+ * of a timer and the start of its callback.
+ */
+typedef struct {
+	u32 RunCount;		/**< Number of callback runs */
+	u32 Overruns;		/**< Expiries while the previous run was pending */
+	u32 LateMax;		/**< Largest lateness in ticks */
+	u32 LateTotal;		/**< Sum of lateness over all runs */
+} XPlmi_SchedStats;
+
 struct XPlmi_Task_t{
-	int Interval;
-	int OwnerId;
-	int Status;
+	struct metal_list WheelNode;	/**< Node in a timer wheel slot */
+	struct metal_list ReadyNode;	/**< Node in the expired queue */
+	u32 Interval;		/**< Period in ticks, 0 for one-shot */
+	u32 Expires;		/**< Tick of the next expiry */
+	u32 QueuedTick;		/**< Tick at which it was last queued */
+	u32 OwnerId;
+	u32 Status;		/**< TRIGGERED while queued for execution */
 	XPlmi_Callback_t CustomerFunc;
+	XPlmi_SchedStats Stats;
 };
 
 typedef struct {
 	struct XPlmi_Task_t TaskList[XPLMI_SCHED_MAX_TASK];
-	int TaskCount;
-	int PitBaseAddr;
-	int Tick;
-	int Enabled;
+	struct metal_list Wheel[XPLMI_SCHED_WHEEL_LEVELS]
+			[XPLMI_SCHED_WHEEL_SLOTS];
+	struct metal_list ReadyList;	/**< Expired timers to be run */
+	u32 TaskCount;
+	u32 PitBaseAddr;
+	u32 Tick;		/**< Number of ticks processed */
+	u32 Enabled;
+	u32 RunPending;		/**< Set while the run task is queued */
 } XPlmi_Scheduler_t ;
 
+/************************** Function Prototypes ******************************/
 int XPlmi_SchedulerInit(void);
 int XPlmi_SchedulerStart(XPlmi_Scheduler_t *SchedPtr);
-int XPlmiSchedulerStop(XPlmi_Scheduler_t *SchedPtr);
+int XPlmi_SchedulerStop(XPlmi_Scheduler_t *SchedPtr);
 int XPlmi_SchedulerHandler(void);
 int XPlmi_SchedulerAddTask( XPlmi_Callback_t UserFunc, int MilliSeconds);
-int XPLmi_SchedulerRemoveTask(XPlmi_Scheduler_t *SchedPtr, int CustId, int MilliSeconds,XPlmi_Callback_t UserFunc);
+int XPlmi_SchedulerAddTimer(u32 OwnerId, XPlmi_Callback_t CallbackFn,
+		u32 MilliSeconds, u32 Type);
+int XPlmi_SchedulerRemoveTask(u32 OwnerId, u32 MilliSeconds,
+		XPlmi_Callback_t CallbackFn);
+int XPlmi_SchedulerGetStats(u32 OwnerId, XPlmi_Callback_t CallbackFn,
+		XPlmi_SchedStats *Stats);
+/* Deprecated, use XPlmi_SchedulerRemoveTask */
+int XPLmi_SchedulerRemoveTask(XPlmi_Scheduler_t *SchedPtr, int CustId,
+		int MilliSeconds, XPlmi_Callback_t UserFunc);
+u32 XPlmi_SchedulerTick(void);
+int XPlmi_SchedulerRunExpired(void *Data);
 
 #ifdef __cplusplus
 }
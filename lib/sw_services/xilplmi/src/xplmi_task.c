@@ -37,6 +37,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   02/06/2019 Initial release
+*       ag   10/16/2026 Output deferred prints before going to sleep
 *
 * </pre>
 *
@@ -225,6 +226,14 @@ void XPlmi_TaskDispatchLoop(void )
 			}
 			continue;
 		}
+		/**
+		 * Output deferred prints when idle, checking the queues
+		 * again between batches
+		 */
+		if (XPlmi_LogDrain(XPLMI_LOG_DRAIN_RECORDS) != 0U) {
+			continue;
+		}
+
 		/**
 		 * Goto sleep when all queues are empty
 		 */
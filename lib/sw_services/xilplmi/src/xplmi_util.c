@@ -34,6 +34,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   02/21/2017 Initial release
+*       ag   10/16/2026 XPlmi_MemCpy and XPlmi_MemCmp use the BSP Xil_MemCpy
+*                       and Xil_MemCmp word/NEON routines
 *
 * </pre>
 *
@@ -46,6 +48,7 @@
 #include "xplmi_hw.h"
 #include "xplmi_debug.h"
 #include "sleep.h"
+#include "xil_mem.h"
 /************************** Constant Definitions *****************************/
 
 /**************************** Type Definitions *******************************/
@@ -455,27 +458,18 @@ END:
 
 /*****************************************************************************/
 /**
+ * This function copies Len bytes from SrcPtr to DestPtr.
  *
+ * @param	DestPtr	Pointer to the destination
+ * @param	SrcPtr	Pointer to the source
+ * @param	Len	Length of the data in bytes
  *
- *
- * @param	None
- *
- * @return	None
+ * @return	DestPtr
  *
  ******************************************************************************/
 void* XPlmi_MemCpy(void * DestPtr, const void * SrcPtr, u32 Len)
 {
-	u8 *Dst = DestPtr;
-	const u8 *Src = SrcPtr;
-
-	/* Loop and copy.  */
-	while (Len != 0U)
-	{
-		*Dst = *Src;
-		Dst++;
-		Src++;
-		Len--;
-	}
+	Xil_MemCpy(DestPtr, SrcPtr, Len);
 
 	return DestPtr;
 }
@@ -493,37 +487,23 @@ void* XPlmi_MemCpy(void * DestPtr, const void * SrcPtr, u32 Len)
  ******************************************************************************/
 s32 XPlmi_MemCmp(const void * Buf1Ptr, const void * Buf2Ptr, u32 Len)
 {
-	const u8 *Buf1 = Buf1Ptr;
-	const u8 *Buf2 = Buf2Ptr;
-	u32 Size = Len;
-	s32 Status = XST_FAILURE;
+	s32 Status;
 
 	/* Assert validates the input arguments */
-	Xil_AssertNonvoid(Buf1 != NULL);
-	Xil_AssertNonvoid(Buf2 != NULL);
+	Xil_AssertNonvoid(Buf1Ptr != NULL);
+	Xil_AssertNonvoid(Buf2Ptr != NULL);
 	Xil_AssertNonvoid(Len != (u32)0x00);
 
-	/* Loop and compare */
-	while (Size != 0U)
-	{
-		if (*Buf1 != *Buf2) {
-			if (*Buf1 > *Buf2) {
-				goto END;
-			}
-			else if (*Buf1 < *Buf2) {
-				Status = -1;
-				goto END;
-			}
-
-		}
-		else {
-			Buf1++;
-			Buf2++;
-			Size--;
-		}
+	Status = Xil_MemCmp(Buf1Ptr, Buf2Ptr, Len);
+	if (Status > 0) {
+		Status = XST_FAILURE;
+	}
+	else if (Status < 0) {
+		Status = -1;
+	}
+	else {
+		Status = XST_SUCCESS;
 	}
 
-	Status = XST_SUCCESS;
-END:
 	return Status;
 }
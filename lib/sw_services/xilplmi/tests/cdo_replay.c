@@ -0,0 +1,391 @@
+/******************************************************************************
+* Copyright (C) 2026 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file cdo_replay.c
+*
+* Host replay harness of the CDO processing in xplmi_cdo.c. A CDO is
+* generated from a seed and fed to XPlmi_ProcessCdo() in chunks of random
+* size. Register accesses are written to a register log and the PLM prints
+* to a trace log, so that a build with PLM_CDO_COALESCE_WRITES can be
+* compared with the reference build line by line.
+*
+* The CDO mixes runs of writes to consecutive NPI and PMC addresses, runs
+* crossing the end of the NPI range, mask writes, delays and long commands
+* that are split across chunks. The generic module handlers print the same
+* traces as those of xplmi_generic.c.
+*
+* Usage: cdo_replay <seed> <register log> <trace log> [fail|splitfail]
+*
+* With "fail", the write run at XPLMI_REPLAY_FAIL_ADDR fails: the write
+* handler fails on its first command in the reference build and the DMA
+* transfer fails in the coalescing build. The status and failure report
+* printed on stdout must be the same for both builds.
+*
+* "splitfail" also ends a chunk two words into the first write of the
+* failing run, so that the write is executed from the temporary command
+* buffer. The failure must be reported at the position of that write in
+* the CDO.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "xplmi_cdo.h"
+#include "xplmi_dma.h"
+#include "xplmi_modules.h"
+#include "xplmi_util.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XPLMI_REPLAY_REGS		(1U << 22U)
+#define XPLMI_REPLAY_CDO_WORDS		(200000U)
+#define XPLMI_REPLAY_FAIL_ADDR		(0xF7000000U)
+#define XPLMI_REPLAY_FAIL_RUN		(8U)
+
+/************************** Variable Definitions *****************************/
+
+u32 LpdInitialized = UART_INITIALIZED;
+u32 Xil_AssertStatus;
+s32 Xil_AssertWait;
+XPlmi_Module * Modules[XPLMI_MAX_MODULES];
+
+static u32 Regs[XPLMI_REPLAY_REGS];
+static u32 Cdo[XPLMI_REPLAY_CDO_WORDS + 1024U];
+static FILE *RegLog;
+static FILE *TraceLog;
+static u32 BusOps;
+static u32 DmaXfers;
+static u32 FailMode;
+static u32 FailPos;
+static char FailReport[160];
+
+/*****************************************************************************/
+/* BSP and PLM services of the host build */
+
+void Xil_Assert(const char8 *File, s32 Line)
+{
+	printf("assertion failed at %s:%d\n", File, (int)Line);
+	exit(1);
+}
+
+void xil_printf(const char *Format, ...)
+{
+	char Line[160];
+	va_list Args;
+
+	va_start(Args, Format);
+	(void)vsnprintf(Line, sizeof(Line), Format, Args);
+	va_end(Args);
+	(void)fputs(Line, TraceLog);
+	if (strstr(Line, "failed") != NULL) {
+		(void)strcpy(FailReport, Line);
+		FailReport[strcspn(FailReport, "\n\r")] = '\0';
+	}
+}
+
+static u32 *XPlmi_ReplayReg(UINTPTR Addr)
+{
+	return &Regs[(Addr >> 2U) & (XPLMI_REPLAY_REGS - 1U)];
+}
+
+u32 Xil_In32(UINTPTR Addr)
+{
+	BusOps++;
+	fprintf(RegLog, "R %08lx\n", (unsigned long)Addr);
+	return *XPlmi_ReplayReg(Addr);
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+	BusOps++;
+	fprintf(RegLog, "W %08lx %08x\n", (unsigned long)Addr, Value);
+	*XPlmi_ReplayReg(Addr) = Value;
+}
+
+/* The PMC DMA stores the words to incrementing addresses in order */
+int XPlmi_DmaXfr(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags)
+{
+	const u32 *Src = (const u32 *)(UINTPTR)SrcAddr;
+	u32 Index;
+
+	(void)Flags;
+	BusOps++;
+	DmaXfers++;
+	if ((FailMode != 0U) && (DestAddr == XPLMI_REPLAY_FAIL_ADDR)) {
+		return XST_FAILURE;
+	}
+	for (Index = 0U; Index < Len; Index++) {
+		fprintf(RegLog, "W %08lx %08x\n",
+			(unsigned long)(DestAddr + (Index * 4U)), Src[Index]);
+		*XPlmi_ReplayReg(DestAddr + (Index * 4U)) = Src[Index];
+	}
+
+	return XST_SUCCESS;
+}
+
+void XPlmi_UtilRMW(u32 RegAddr, u32 Mask, u32 Value)
+{
+	u32 Val = Xil_In32(RegAddr);
+
+	Xil_Out32(RegAddr, (Val & ~Mask) | (Mask & Value));
+}
+
+/*****************************************************************************/
+/* Generic module handlers, printing the traces of xplmi_generic.c */
+
+static int XPlmi_Features(XPlmi_Cmd * Cmd)
+{
+	XPlmi_Printf(DEBUG_DETAILED, "%s %p\n\r", __func__, Cmd);
+	return XST_SUCCESS;
+}
+
+static int XPlmi_MaskWrite(XPlmi_Cmd * Cmd)
+{
+	u32 Addr = Cmd->Payload[0];
+	u32 Mask = Cmd->Payload[1];
+	u32 Value = Cmd->Payload[2];
+
+	XPlmi_Printf(DEBUG_DETAILED,
+		"%s, Addr: 0x%0x,  Mask 0x%0x, Value: 0x%0x\n\r",
+		__func__, Addr, Mask, Value);
+
+	XPlmi_UtilRMW(Addr, Mask, Value);
+	return XST_SUCCESS;
+}
+
+static int XPlmi_Write(XPlmi_Cmd * Cmd)
+{
+	u32 Addr = Cmd->Payload[0];
+	u32 Value = Cmd->Payload[1];
+
+	XPlmi_Printf(DEBUG_DETAILED,
+		"%s, Addr: 0x%0x,  Val: 0x%0x\n\r",
+		__func__, Addr, Value);
+
+	if ((FailMode != 0U) && (Addr == XPLMI_REPLAY_FAIL_ADDR)) {
+		return XST_FAILURE;
+	}
+	Xil_Out32(Addr, Value);
+	return XST_SUCCESS;
+}
+
+static int XPlmi_Delay(XPlmi_Cmd * Cmd)
+{
+	XPlmi_Printf(DEBUG_DETAILED, "%s, Delay: %d\n\r",
+		__func__, Cmd->Payload[0]);
+	fprintf(RegLog, "D %u\n", Cmd->Payload[0]);
+	return XST_SUCCESS;
+}
+
+/* Long command; may be resumed over several chunks */
+static int XPlmi_Payload(XPlmi_Cmd * Cmd)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Cmd->PayloadLen; Index++) {
+		fprintf(RegLog, "P %08x\n", Cmd->Payload[Index]);
+	}
+	return XST_SUCCESS;
+}
+
+static XPlmi_ModuleCmd GenericCmds[] = {
+	XPLMI_MODULE_COMMAND(XPlmi_Features),
+	XPLMI_MODULE_COMMAND(XPlmi_Features),
+	XPLMI_MODULE_COMMAND(XPlmi_MaskWrite),
+	XPLMI_MODULE_COMMAND(XPlmi_Write),
+	XPLMI_MODULE_COMMAND(XPlmi_Delay),
+	XPLMI_MODULE_COMMAND(XPlmi_Payload),
+};
+
+static XPlmi_Module GenericModule = {
+	XPLMI_MODULE_GENERIC_ID,
+	GenericCmds,
+	sizeof(GenericCmds) / sizeof(GenericCmds[0]),
+};
+
+/*****************************************************************************/
+/**
+* Generates the CDO: header, commands and the end command. Returns the
+* number of words.
+******************************************************************************/
+static u32 XPlmi_ReplayGenCdo(u32 FailRun)
+{
+	u32 Len = XPLMI_CDO_HDR_LEN;
+	u32 Addr;
+	u32 Cnt;
+	u32 Index;
+	u32 Kind;
+	u32 FailAt = XPLMI_REPLAY_CDO_WORDS / 2U;
+
+	while (Len < XPLMI_REPLAY_CDO_WORDS) {
+		if ((FailRun != 0U) && (Len >= FailAt)) {
+			/* Run starting at the failing address after a delay */
+			Cdo[Len++] = 0x10104U;
+			Cdo[Len++] = 1U;
+			FailPos = Len;
+			for (Index = 0U; Index < XPLMI_REPLAY_FAIL_RUN; Index++) {
+				Cdo[Len++] = 0x20103U;
+				Cdo[Len++] = XPLMI_REPLAY_FAIL_ADDR + (Index * 4U);
+				Cdo[Len++] = (u32)rand();
+			}
+			FailRun = 0U;
+			continue;
+		}
+
+		Kind = (u32)rand() % 10U;
+		if (Kind < 6U) {
+			/* Write run to NPI, PMC or across the NPI end */
+			Cnt = 1U + ((u32)rand() % 100U);
+			if (((u32)rand() % 3U) == 0U) {
+				Addr = 0xF1000000U + (((u32)rand() % 256U) * 4U);
+			} else {
+				Addr = 0xF6000000U + (((u32)rand() % 65536U) * 4U);
+			}
+			if (((u32)rand() % 4U) == 0U) {
+				Addr = 0xF7FFFFF0U;
+			}
+			for (Index = 0U; Index < Cnt; Index++) {
+				Cdo[Len++] = 0x20103U;
+				Cdo[Len++] = Addr + (Index * 4U);
+				Cdo[Len++] = (u32)rand();
+			}
+		} else if (Kind < 8U) {
+			Cdo[Len++] = 0x30102U;
+			Cdo[Len++] = 0xF6000000U + (((u32)rand() % 65536U) * 4U);
+			Cdo[Len++] = (u32)rand();
+			Cdo[Len++] = (u32)rand();
+		} else if (Kind < 9U) {
+			Cdo[Len++] = 0x10104U;
+			Cdo[Len++] = (u32)rand() % 100U;
+		} else {
+			/* Short or long (extended length) payload command */
+			Cnt = (((u32)rand() % 2U) != 0U) ? ((u32)rand() % 20U) :
+				(300U + ((u32)rand() % 300U));
+			if (Cnt >= 255U) {
+				Cdo[Len++] = 0xFF0105U;
+				Cdo[Len++] = Cnt;
+			} else {
+				Cdo[Len++] = (Cnt << 16U) | 0x105U;
+			}
+			for (Index = 0U; Index < Cnt; Index++) {
+				Cdo[Len++] = (u32)rand();
+			}
+		}
+	}
+	Cdo[Len++] = XPLMI_CMD_END;
+
+	Cdo[0] = 0x0U;
+	Cdo[1] = XPLMI_CDO_HDR_IDN_WRD;
+	Cdo[2] = 0x200U;
+	Cdo[3] = Len - XPLMI_CDO_HDR_LEN;
+	Cdo[4] = ~(Cdo[0] + Cdo[1] + Cdo[2] + Cdo[3]);
+
+	return Len;
+}
+
+int main(int argc, char **argv)
+{
+	XPlmiCdo CdoInst;
+	u32 Len;
+	u32 Offset = 0U;
+	u32 ChunkLen;
+	u32 SplitAt = 0U;
+	char Expected[64];
+	int Status = XST_SUCCESS;
+
+	if (argc < 4) {
+		printf("usage: %s <seed> <register log> <trace log> "
+			"[fail|splitfail]\n",
+			argv[0]);
+		return 2;
+	}
+	srand((unsigned)atoi(argv[1]));
+	RegLog = fopen(argv[2], "w");
+	TraceLog = fopen(argv[3], "w");
+	if ((RegLog == NULL) || (TraceLog == NULL)) {
+		printf("cannot open the logs\n");
+		return 2;
+	}
+	if (argc > 4) {
+		FailMode = (strcmp(argv[4], "fail") == 0) ? 1U : 0U;
+		if (strcmp(argv[4], "splitfail") == 0) {
+			FailMode = 2U;
+		}
+	}
+
+	Modules[XPLMI_MODULE_GENERIC_ID] = &GenericModule;
+	Len = XPlmi_ReplayGenCdo(FailMode);
+	XPlmi_InitCdo(&CdoInst);
+	if (FailMode == 2U) {
+		SplitAt = FailPos + 2U;
+	}
+
+	while (Offset < Len) {
+		ChunkLen = 1U + ((u32)rand() % 4096U);
+		if ((Offset + ChunkLen) > Len) {
+			ChunkLen = Len - Offset;
+		}
+		if ((Offset < SplitAt) && ((Offset + ChunkLen) > SplitAt)) {
+			ChunkLen = SplitAt - Offset;
+		}
+		CdoInst.BufPtr = &Cdo[Offset];
+		CdoInst.BufLen = ChunkLen;
+		Status = XPlmi_ProcessCdo(&CdoInst);
+		if (Status != XST_SUCCESS) {
+			break;
+		}
+		Offset += ChunkLen;
+	}
+
+	(void)fclose(RegLog);
+	(void)fclose(TraceLog);
+
+	if (FailMode != 0U) {
+		printf("status 0x%x, %s\n", (unsigned)Status, FailReport);
+		if (FailMode == 2U) {
+			/* Processed length counts from the end of the header */
+			(void)snprintf(Expected, sizeof(Expected),
+				"Processed Cdo Length 0x%x",
+				FailPos - XPLMI_CDO_HDR_LEN);
+			if (strstr(FailReport, Expected) == NULL) {
+				printf("expected %s\n", Expected);
+				return 1;
+			}
+		}
+		return (Status != XST_SUCCESS) ? 0 : 1;
+	}
+	if (Status != XST_SUCCESS) {
+		printf("CDO processing failed, status 0x%x\n", (unsigned)Status);
+		return 1;
+	}
+	printf("%u words, %u bus operations, %u DMA transfers\n",
+		Len, BusOps, DmaXfers);
+	return 0;
+}
@@ -0,0 +1,456 @@
+/******************************************************************************
+* Copyright (C) 2026 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file sched_stress.c
+*
+* Host stress test of the PLM scheduler (xplmi_scheduler.c) driven by a
+* fake tick source. The MicroBlaze interrupt enable bit is modelled in
+* stub/mb_interface.h: a tick raised while interrupts are masked stays
+* pending and is delivered when XPlmi_SchedUnlock enables them again, the
+* same way the PIT3 interrupt is taken on the target.
+*
+* Ticks are raised from the main loop and from inside timer callbacks,
+* which run with interrupts enabled, and the callbacks add and remove
+* timers and read statistics while ticks arrive. The test checks
+* - for every periodic timer, that runs plus overruns equal the number of
+*   expiries since it was added,
+* - that every one-shot timer runs once unless it was removed first,
+* - that add, remove and statistics calls mask the tick while they access
+*   the timer lists, by raising a tick at the moment they lock, and that
+*   interrupts are enabled again when they return,
+* - that the deprecated XPLmi_SchedulerRemoveTask still removes a timer.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "xplmi_scheduler.h"
+#include "xplmi_task.h"
+#include "xplmi_debug.h"
+
+/************************** Constant Definitions *****************************/
+
+#define STRESS_MSR_IE		(0x2U)
+#define STRESS_TICKS		(300000U)
+#define STRESS_STABLE		(96U)	/**< Periodic timers kept all along */
+#define STRESS_CHURN		(32U)	/**< Periodic timers added and removed */
+#define STRESS_ONESHOT_MAX	(64U)	/**< One-shot timers armed at a time */
+#define STRESS_ONESHOT_IDS	(40000U)
+#define STRESS_CHURN_ID		(1000U)
+#define STRESS_ONESHOT_ID	(2000U)
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CHECK(Cond)	Stress_Check((Cond) ? 1U : 0U, #Cond, __LINE__)
+
+/************************** Function Prototypes ******************************/
+
+static void Stress_Check(u32 Ok, const char *Cond, int Line);
+
+/************************** Variable Definitions *****************************/
+
+u32 XPlmi_FakeMsr = STRESS_MSR_IE;
+u32 LpdInitialized = UART_INITIALIZED;
+u32 Xil_AssertStatus;
+s32 Xil_AssertWait;
+
+static u32 Failures;
+static u32 IrqPending;
+static u32 RaiseOnLock;
+static u32 Ticks;
+static XPlmi_TaskNode RunTask;
+static u32 RunQueued;
+
+static u32 StableAddTick[STRESS_STABLE];
+static u32 StablePeriod[STRESS_STABLE];
+static u32 StableCalls;
+static u32 ChurnActive[STRESS_CHURN];
+static u32 ChurnAddTick[STRESS_CHURN];
+static u8 OneShotState[STRESS_ONESHOT_IDS];
+static u32 OneShotAdded;
+static u32 OneShotRemoved;
+static u32 OneShotCalls;
+static u32 LockChecks;
+
+/*****************************************************************************/
+/* BSP and PLM services of the host build */
+
+void Xil_Assert(const char8 *File, s32 Line)
+{
+	printf("assertion failed at %s:%d\n", File, (int)Line);
+	exit(1);
+}
+
+void xil_printf(const char *Format, ...)
+{
+	(void)Format;
+}
+
+u32 Xil_In32(UINTPTR Addr)
+{
+	(void)Addr;
+	return 0U;
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+	(void)Addr;
+	(void)Value;
+}
+
+void XPlmi_UtilRMW(u32 RegAddr, u32 Mask, u32 Value)
+{
+	(void)RegAddr;
+	(void)Mask;
+	(void)Value;
+}
+
+XPlmi_TaskNode * XPlmi_TaskCreate(u32 Priority,
+	int (*Handler)(void * PrivData), void * PrivData)
+{
+	(void)Priority;
+	CHECK(RunQueued == 0U);
+	RunTask.Handler = Handler;
+	RunTask.PrivData = PrivData;
+	return &RunTask;
+}
+
+void XPlmi_TaskTriggerNow(XPlmi_TaskNode * Task)
+{
+	(void)Task;
+	RunQueued = 1U;
+}
+
+/*****************************************************************************/
+/* Fake interrupt controller */
+
+static void Stress_Check(u32 Ok, const char *Cond, int Line)
+{
+	if (Ok == 0U) {
+		if (Failures < 20U) {
+			printf("  FAIL line %d (tick %u): %s\n", Line, Ticks,
+				Cond);
+		}
+		Failures++;
+	}
+}
+
+/* Takes the pending ticks while interrupts are enabled */
+static void Stress_Deliver(void)
+{
+	while ((IrqPending != 0U) &&
+		((XPlmi_FakeMsr & STRESS_MSR_IE) != 0U)) {
+		IrqPending--;
+		/* Interrupt entry masks interrupts, return enables them */
+		XPlmi_FakeMsr &= ~STRESS_MSR_IE;
+		CHECK(XPlmi_SchedulerHandler() == XST_SUCCESS);
+		Ticks++;
+		XPlmi_FakeMsr |= STRESS_MSR_IE;
+	}
+}
+
+static void Stress_RaiseTick(void)
+{
+	IrqPending++;
+	Stress_Deliver();
+}
+
+void XPlmi_FakeIrqDisable(void)
+{
+	XPlmi_FakeMsr &= ~STRESS_MSR_IE;
+	if (RaiseOnLock != 0U) {
+		/* The tick arrives just after the lock was taken */
+		RaiseOnLock = 0U;
+		IrqPending++;
+	}
+}
+
+void XPlmi_FakeIrqEnable(void)
+{
+	XPlmi_FakeMsr |= STRESS_MSR_IE;
+	Stress_Deliver();
+}
+
+/*
+ * Raises a tick as the next scheduler call locks. The tick must only be
+ * taken once the call has unlocked, so it is pending inside the call and
+ * delivered when the call returns.
+ */
+static void Stress_ArmLockCheck(u32 *TicksBefore)
+{
+	*TicksBefore = Ticks;
+	RaiseOnLock = 1U;
+}
+
+static void Stress_EndLockCheck(u32 TicksBefore, int Line)
+{
+	Stress_Check((RaiseOnLock == 0U) ? 1U : 0U, "call masked the tick",
+		Line);
+	Stress_Check((Ticks == (TicksBefore + 1U)) ? 1U : 0U,
+		"tick taken at unlock", Line);
+	Stress_Check(((XPlmi_FakeMsr & STRESS_MSR_IE) != 0U) ? 1U : 0U,
+		"interrupts enabled on return", Line);
+	RaiseOnLock = 0U;
+	LockChecks++;
+}
+
+/*****************************************************************************/
+/* Timer callbacks */
+
+static u32 Stress_MsFor(u32 TickCnt)
+{
+	return TickCnt * XPLMI_SCHED_TICK_MS;
+}
+
+static int Stress_StableCb(void)
+{
+	StableCalls++;
+	/* Long callback: a tick arrives while it runs */
+	if (((u32)rand() % 16U) == 0U) {
+		Stress_RaiseTick();
+	}
+	return XST_SUCCESS;
+}
+
+static int Stress_OneShotCb(void)
+{
+	OneShotCalls++;
+	return XST_SUCCESS;
+}
+
+static void Stress_AddOneShot(void)
+{
+	u32 Id = OneShotAdded;
+	u32 Before;
+
+	if ((Id >= STRESS_ONESHOT_IDS) ||
+		((OneShotAdded - OneShotRemoved - OneShotCalls) >=
+		 STRESS_ONESHOT_MAX)) {
+		return;
+	}
+	Stress_ArmLockCheck(&Before);
+	CHECK(XPlmi_SchedulerAddTimer(STRESS_ONESHOT_ID + Id,
+		Stress_OneShotCb, Stress_MsFor(1U + ((u32)rand() % 200U)),
+		XPLMI_SCHED_ONESHOT) == XST_SUCCESS);
+	Stress_EndLockCheck(Before, __LINE__);
+	OneShotState[Id] = 1U;
+	OneShotAdded++;
+}
+
+static void Stress_RemoveOneShot(void)
+{
+	u32 Id;
+	int Status;
+
+	if (OneShotAdded == 0U) {
+		return;
+	}
+	Id = (u32)rand() % OneShotAdded;
+	Status = XPlmi_SchedulerRemoveTask(STRESS_ONESHOT_ID + Id, 0U,
+			Stress_OneShotCb);
+	if (OneShotState[Id] == 2U) {
+		CHECK(Status == XST_FAILURE);
+	} else if (Status == XST_SUCCESS) {
+		/* Armed and not yet run */
+		OneShotState[Id] = 2U;
+		OneShotRemoved++;
+	}
+}
+
+static void Stress_Churn(void)
+{
+	u32 Idx = (u32)rand() % STRESS_CHURN;
+	u32 Before;
+	int Status;
+
+	Stress_ArmLockCheck(&Before);
+	if (ChurnActive[Idx] != 0U) {
+		Status = XPlmi_SchedulerRemoveTask(STRESS_CHURN_ID + Idx, 0U,
+				Stress_StableCb);
+		ChurnActive[Idx] = 0U;
+	} else {
+		Status = XPlmi_SchedulerAddTimer(STRESS_CHURN_ID + Idx,
+			Stress_StableCb, Stress_MsFor(1U + ((u32)rand() % 50U)),
+			XPLMI_SCHED_PERIODIC);
+		ChurnActive[Idx] = 1U;
+		ChurnAddTick[Idx] = Ticks;
+	}
+	CHECK(Status == XST_SUCCESS);
+	Stress_EndLockCheck(Before, __LINE__);
+}
+
+static void Stress_ReadStats(void)
+{
+	XPlmi_SchedStats Stats;
+	u32 Idx = (u32)rand() % STRESS_STABLE;
+	u32 Before;
+
+	Stress_ArmLockCheck(&Before);
+	CHECK(XPlmi_SchedulerGetStats(Idx, Stress_StableCb, &Stats) ==
+		XST_SUCCESS);
+	Stress_EndLockCheck(Before, __LINE__);
+	CHECK(Stats.LateTotal >= Stats.LateMax);
+}
+
+static int Stress_ChurnCb(void)
+{
+	switch ((u32)rand() % 6U) {
+	case 0U:
+		Stress_AddOneShot();
+		break;
+	case 1U:
+		Stress_RemoveOneShot();
+		break;
+	case 2U:
+		Stress_Churn();
+		break;
+	case 3U:
+		Stress_ReadStats();
+		break;
+	case 4U:
+		Stress_RaiseTick();
+		break;
+	default:
+		break;
+	}
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+
+static void Stress_RunTask(void)
+{
+	while (RunQueued != 0U) {
+		RunQueued = 0U;
+		CHECK(RunTask.Handler(RunTask.PrivData) == XST_SUCCESS);
+	}
+}
+
+static void Stress_AddStable(void)
+{
+	u32 Idx;
+	u32 Kind;
+	u32 Period;
+
+	for (Idx = 0U; Idx < STRESS_STABLE; Idx++) {
+		Kind = (u32)rand() % 4U;
+		if (Kind < 2U) {
+			Period = 1U + ((u32)rand() % 63U);
+		} else if (Kind == 2U) {
+			Period = 64U + ((u32)rand() % 4032U);
+		} else {
+			Period = 4096U + ((u32)rand() % 100000U);
+		}
+		StablePeriod[Idx] = Period;
+		StableAddTick[Idx] = Ticks;
+		CHECK(XPlmi_SchedulerAddTimer(Idx, Stress_StableCb,
+			Stress_MsFor(Period), XPLMI_SCHED_PERIODIC) ==
+			XST_SUCCESS);
+		/* Spread the timers over the wheel */
+		Stress_RaiseTick();
+		Stress_RunTask();
+	}
+}
+
+static void Stress_CheckTotals(void)
+{
+	XPlmi_SchedStats Stats;
+	u32 Idx;
+	u32 Expiries;
+	u32 Expected = 0U;
+
+	for (Idx = 0U; Idx < STRESS_STABLE; Idx++) {
+		Expiries = (Ticks - StableAddTick[Idx]) / StablePeriod[Idx];
+		CHECK(XPlmi_SchedulerGetStats(Idx, Stress_StableCb, &Stats) ==
+			XST_SUCCESS);
+		CHECK((Stats.RunCount + Stats.Overruns) == Expiries);
+		CHECK(Stats.LateTotal <= (Stats.RunCount * Stats.LateMax));
+	}
+
+	/* Every one-shot timer which is not armed any more has run once */
+	for (Idx = 0U; Idx < OneShotAdded; Idx++) {
+		if ((OneShotState[Idx] == 1U) &&
+			(XPlmi_SchedulerGetStats(STRESS_ONESHOT_ID + Idx,
+				Stress_OneShotCb, &Stats) != XST_SUCCESS)) {
+			Expected++;
+		}
+	}
+	CHECK(OneShotCalls == Expected);
+}
+
+int main(void)
+{
+	u32 Step;
+	u32 Before;
+
+	srand(11U);
+	CHECK(XPlmi_SchedulerInit() == XST_SUCCESS);
+	Stress_AddStable();
+	CHECK(XPlmi_SchedulerAddTimer(STRESS_CHURN_ID + STRESS_CHURN,
+		Stress_ChurnCb, Stress_MsFor(1U), XPLMI_SCHED_PERIODIC) ==
+		XST_SUCCESS);
+
+	for (Step = 0U; Step < STRESS_TICKS; Step++) {
+		Stress_RaiseTick();
+		Stress_RunTask();
+		if ((Step % 97U) == 0U) {
+			Stress_ReadStats();
+			Stress_Churn();
+		}
+	}
+
+	/* Stop the churn and drain the expired timers */
+	Stress_ArmLockCheck(&Before);
+	CHECK(XPlmi_SchedulerRemoveTask(STRESS_CHURN_ID + STRESS_CHURN, 0U,
+		Stress_ChurnCb) == XST_SUCCESS);
+	Stress_EndLockCheck(Before, __LINE__);
+	Stress_RunTask();
+	Stress_CheckTotals();
+
+	/* Deprecated removal interface */
+	CHECK(XPlmi_SchedulerAddTimer(STRESS_CHURN_ID + STRESS_CHURN + 1U,
+		Stress_ChurnCb, Stress_MsFor(1U), XPLMI_SCHED_ONESHOT) ==
+		XST_SUCCESS);
+	CHECK(XPLmi_SchedulerRemoveTask(NULL,
+		(int)(STRESS_CHURN_ID + STRESS_CHURN + 1U), 0,
+		Stress_ChurnCb) == XST_SUCCESS);
+	CHECK(XPLmi_SchedulerRemoveTask(NULL,
+		(int)(STRESS_CHURN_ID + STRESS_CHURN + 1U), 0,
+		Stress_ChurnCb) == XST_FAILURE);
+
+	printf("%u ticks, %u periodic runs, %u one-shot timers (%u removed,"
+		" %u run), %u lock checks\n", Ticks, StableCalls, OneShotAdded,
+		OneShotRemoved, OneShotCalls, LockChecks);
+	if (Failures != 0U) {
+		printf("sched_stress: %u check(s) failed\n", Failures);
+		return 1;
+	}
+	printf("sched_stress: all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,48 @@
+/******************************************************************************
+* Copyright (C) 2026 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file mb_interface.h
+*
+* Host build replacement of the MicroBlaze interface header. The interrupt
+* enable bit of the MSR is modelled by the test harness, which delivers
+* pending fake timer interrupts when interrupts are enabled again.
+*
+******************************************************************************/
+#ifndef MB_INTERFACE_H
+#define MB_INTERFACE_H
+
+#include "xil_types.h"
+
+extern u32 XPlmi_FakeMsr;
+void XPlmi_FakeIrqDisable(void);
+void XPlmi_FakeIrqEnable(void);
+
+#define mfmsr()				(XPlmi_FakeMsr)
+#define microblaze_disable_interrupts()	XPlmi_FakeIrqDisable()
+#define microblaze_enable_interrupts()	XPlmi_FakeIrqEnable()
+
+#endif /* MB_INTERFACE_H */
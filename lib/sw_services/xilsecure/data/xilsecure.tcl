@@ -34,6 +34,7 @@
 # 2.0   srm 02/16/18 Updated to pick up latest freertos port 10.0
 # 3.1   vns 04/13/18 Added user configurable macro secure environment
 # 4.0   vns 03/20/19 Added support for versal
+# 4.1   ag  10/16/26 Added sha3_sw_max_len parameter
 ##############################################################################
 
 #---------------------------------------------
@@ -142,4 +143,16 @@ proc xgen_opts_file {libhandle} {
 
 		close $file_handle
 	}
+
+	# Get the largest message hashed by the SHA3 software engine
+	set value [common::get_property CONFIG.sha3_sw_max_len $libhandle]
+	if {$value != ""} {
+		# Open xparameters.h file
+		set file_handle [hsi::utils::open_include_file "xparameters.h"]
+
+		puts $file_handle "\n/* Xilinx Secure library SHA3 Settings */"
+		puts $file_handle "#define XSECURE_SHA3_SW_MAX_LEN (${value}U)\n"
+
+		close $file_handle
+	}
 }
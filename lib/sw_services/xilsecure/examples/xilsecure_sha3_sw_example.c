@@ -0,0 +1,535 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file	xilsecure_sha3_sw_example.c
+* @addtogroup xsecure_sha3_sw_example_apis XilSecure SHA3 Software Engine
+* Example Usage
+* @{
+* This example checks the software SHA3 engine against known answers, against
+* the CSU SHA3 engine and XSecure_Sha3DigestMulti against single digests, and
+* then measures the time per message of both engines over a range of sizes.
+*
+* On the target the example uses XTime_GetTime for timing. The software
+* engine alone can also be checked and measured on a Linux host by defining
+* XSECURE_SHA3_SW_HOST, for example:
+*
+*	gcc -O2 -DXSECURE_SHA3_SW_HOST -I../src/common -I<dir with
+*	    xil_types.h, xil_printf.h and xstatus.h> xilsecure_sha3_sw_example.c
+*	    ../src/common/xsecure_sha3_sw.c
+*
+* where xil_printf may simply map to printf. On an AArch64 host the NEON
+* two way permutation is exercised as well.
+*
+* MODIFICATION HISTORY:
+* <pre>
+* Ver   Who    Date     Changes
+* ----- ------ -------- -------------------------------------------------
+* 4.1   ag     10/16/26 First Release
+*
+* </pre>
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xil_types.h"
+#include "xil_printf.h"
+#include "xstatus.h"
+#include "xsecure_sha3_sw.h"
+#ifdef XSECURE_SHA3_SW_HOST
+#include <time.h>
+#else
+#include "xparameters.h"
+#include "xsecure_sha.h"
+#include "xtime_l.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define SHA3_HASH_LEN		XSECURE_SHA3_SW_HASH_LEN
+#define SHA3_MAX_SIZE		16384U
+#define SHA3_CHECK_MAX_SIZE	600U	/* Sizes checked one by one */
+#define SHA3_MULTI_COUNT	4U
+#define SHA3_BYTES_PER_RUN	(1024U * 1024U)	/* Per measurement */
+
+/**************************** Type Definitions *******************************/
+
+typedef enum {
+	SHA3_RUN_HW = 0,
+	SHA3_RUN_SW,
+	SHA3_RUN_MULTI,
+} Sha3Run;
+
+typedef struct {
+	const char8 *Name;
+	u8 Byte;	/* Message is Size bytes of this value */
+	u32 Size;
+	u8 Hash[SHA3_HASH_LEN];
+} Sha3Kat;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static int CheckKat(void);
+static int CheckEngines(void);
+static int CheckMulti(void);
+static void RunBenchmark(void);
+static int Sha3Hash(Sha3Run Run, const u8 *In, u32 Size, u8 *Out);
+static int Sha3HashMulti(const u8 * const In[], const u32 Size[],
+		u8 * const Out[], u32 Count);
+static u64 TimeRun(Sha3Run Run, u32 Size);
+static u64 GetTimeNs(void);
+static void PrintHash(const u8 *Hash);
+
+/************************** Variable Definitions *****************************/
+
+#ifndef XSECURE_SHA3_SW_HOST
+static XSecure_Sha3 Secure_Sha3;
+static XCsuDma CsuDma;
+#endif
+
+static u8 Msg[SHA3_MULTI_COUNT][SHA3_MAX_SIZE] __attribute__ ((aligned(64)));
+
+static const Sha3Kat Kats[] = {
+	{ "empty", 0x00U, 0U, {
+	  0x0c, 0x63, 0xa7, 0x5b, 0x84, 0x5e, 0x4f, 0x7d, 0x01, 0x10, 0x7d, 0x85,
+	  0x2e, 0x4c, 0x24, 0x85, 0xc5, 0x1a, 0x50, 0xaa, 0xaa, 0x94, 0xfc, 0x61,
+	  0x99, 0x5e, 0x71, 0xbb, 0xee, 0x98, 0x3a, 0x2a, 0xc3, 0x71, 0x38, 0x31,
+	  0x26, 0x4a, 0xdb, 0x47, 0xfb, 0x6b, 0xd1, 0xe0, 0x58, 0xd5, 0xf0, 0x04 }
+	},
+	{ "200 x a3", 0xa3U, 200U, {
+	  0x18, 0x81, 0xde, 0x2c, 0xa7, 0xe4, 0x1e, 0xf9, 0x5d, 0xc4, 0x73, 0x2b,
+	  0x8f, 0x5f, 0x00, 0x2b, 0x18, 0x9c, 0xc1, 0xe4, 0x2b, 0x74, 0x16, 0x8e,
+	  0xd1, 0x73, 0x26, 0x49, 0xce, 0x1d, 0xbc, 0xdd, 0x76, 0x19, 0x7a, 0x31,
+	  0xfd, 0x55, 0xee, 0x98, 0x9f, 0x2d, 0x70, 0x50, 0xdd, 0x47, 0x3e, 0x8f }
+	},
+};
+
+static const u32 Sizes[] = { 64U, 256U, 1024U, 4096U, 16384U };
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the SHA3 software engine example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+int main(void)
+{
+	u32 Index;
+	u32 Pos;
+#ifndef XSECURE_SHA3_SW_HOST
+	XCsuDma_Config *Config;
+	int Status;
+
+	Config = XCsuDma_LookupConfig(0);
+	if (NULL == Config) {
+		xil_printf("config  failed\n\r");
+		return XST_FAILURE;
+	}
+
+	Status = XCsuDma_CfgInitialize(&CsuDma, Config, Config->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	(void)XSecure_Sha3Initialize(&Secure_Sha3, &CsuDma);
+#endif
+
+	xil_printf("SHA3 Software Engine Example\r\n");
+
+	/* Different pseudo random content in each message */
+	for (Index = 0U; Index < SHA3_MULTI_COUNT; Index++) {
+		for (Pos = 0U; Pos < SHA3_MAX_SIZE; Pos++) {
+			Msg[Index][Pos] = (u8)((Pos * 131U) + (Index * 7U) +
+					(Pos >> 8U));
+		}
+	}
+
+	if ((CheckKat() != XST_SUCCESS) || (CheckEngines() != XST_SUCCESS) ||
+		(CheckMulti() != XST_SUCCESS)) {
+		xil_printf("SHA3 Software Engine Example failed\r\n");
+		return XST_FAILURE;
+	}
+
+	RunBenchmark();
+
+	xil_printf("Successfully ran SHA3 Software Engine Example\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Checks the software engine against the known answers of FIPS 202 SHA3-384.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if all digests match, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int CheckKat(void)
+{
+	u8 In[256];
+	u8 Hash[SHA3_HASH_LEN];
+	u32 Index;
+
+	for (Index = 0U; Index < (sizeof(Kats) / sizeof(Kats[0])); Index++) {
+		(void)memset(In, Kats[Index].Byte, Kats[Index].Size);
+		if ((Sha3Hash(SHA3_RUN_SW, In, Kats[Index].Size, Hash) !=
+			XST_SUCCESS) ||
+			(memcmp(Hash, Kats[Index].Hash, SHA3_HASH_LEN) != 0)) {
+			xil_printf("Known answer %s failed\r\n",
+					Kats[Index].Name);
+			PrintHash(Hash);
+			return XST_FAILURE;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Checks the software engine against the CSU SHA3 engine for every size up
+* to SHA3_CHECK_MAX_SIZE bytes and at an unaligned start. Only the software
+* engine is hashed on the host, one update at a time and split in two
+* updates at every offset, which must give the same digest.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if all digests match, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int CheckEngines(void)
+{
+	u8 Ref[SHA3_HASH_LEN];
+	u8 Hash[SHA3_HASH_LEN];
+	u32 Size;
+#ifdef XSECURE_SHA3_SW_HOST
+	XSecure_Sha3SwCtx Ctx;
+	u32 Split;
+#endif
+
+	for (Size = 1U; Size <= SHA3_CHECK_MAX_SIZE; Size++) {
+		if (Sha3Hash(SHA3_RUN_SW, &Msg[0][1], Size, Hash) !=
+			XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+#ifdef XSECURE_SHA3_SW_HOST
+		for (Split = 0U; Split <= Size; Split++) {
+			XSecure_Sha3SwStart(&Ctx);
+			XSecure_Sha3SwUpdate(&Ctx, &Msg[0][1], Split);
+			XSecure_Sha3SwUpdate(&Ctx, &Msg[0][1U + Split],
+					Size - Split);
+			XSecure_Sha3SwFinish(&Ctx, XSECURE_SHA3_SW_NIST_PAD,
+					Ref);
+			if (memcmp(Hash, Ref, SHA3_HASH_LEN) != 0) {
+				xil_printf("Split %d of size %d failed\r\n",
+						Split, Size);
+				return XST_FAILURE;
+			}
+		}
+#else
+		if (Sha3Hash(SHA3_RUN_HW, &Msg[0][1], Size, Ref) !=
+			XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		if (memcmp(Hash, Ref, SHA3_HASH_LEN) != 0) {
+			xil_printf("Size %d differs from hardware\r\n", Size);
+			PrintHash(Ref);
+			PrintHash(Hash);
+			return XST_FAILURE;
+		}
+#endif
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Checks multi-buffer hashing against single digests, with messages of
+* different lengths so that the two way NEON path ends its lockstep part at
+* every block boundary.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if all digests match, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int CheckMulti(void)
+{
+	const u8 *In[SHA3_MULTI_COUNT];
+	u32 Size[SHA3_MULTI_COUNT];
+	u8 Hash[SHA3_MULTI_COUNT][SHA3_HASH_LEN];
+	u8 *Out[SHA3_MULTI_COUNT];
+	u8 Ref[SHA3_HASH_LEN];
+	u32 Count;
+	u32 Base;
+	u32 Index;
+
+	for (Base = 0U; Base < SHA3_CHECK_MAX_SIZE; Base += 37U) {
+		for (Index = 0U; Index < SHA3_MULTI_COUNT; Index++) {
+			In[Index] = Msg[Index];
+			Size[Index] = Base + (Index * XSECURE_SHA3_SW_RATE) +
+					(Index * 5U);
+			Out[Index] = Hash[Index];
+		}
+		/* Every other round drops the last message for an odd count */
+		Count = SHA3_MULTI_COUNT - ((Base / 37U) % 2U);
+		if (Sha3HashMulti(In, Size, Out, Count) != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		for (Index = 0U; Index < Count; Index++) {
+			if ((Sha3Hash(SHA3_RUN_SW, In[Index], Size[Index],
+				Ref) != XST_SUCCESS) ||
+				(memcmp(Hash[Index], Ref, SHA3_HASH_LEN) != 0)) {
+				xil_printf("Multi-buffer message %d of size %d "
+					"failed\r\n", Index, Size[Index]);
+				return XST_FAILURE;
+			}
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Prints the time per message of the CSU SHA3 engine, of the software engine
+* and of the software engine hashing SHA3_MULTI_COUNT messages per call.
+*
+* @param	None
+*
+* @return	None
+*
+******************************************************************************/
+static void RunBenchmark(void)
+{
+	u32 Index;
+
+	xil_printf("Nanoseconds per message\r\n");
+	xil_printf("    Size        HW        SW     Multi\r\n");
+	for (Index = 0U; Index < (sizeof(Sizes) / sizeof(Sizes[0])); Index++) {
+		xil_printf("%8d  %8d  %8d  %8d\r\n", Sizes[Index],
+#ifdef XSECURE_SHA3_SW_HOST
+			0,
+#else
+			(u32)TimeRun(SHA3_RUN_HW, Sizes[Index]),
+#endif
+			(u32)TimeRun(SHA3_RUN_SW, Sizes[Index]),
+			(u32)TimeRun(SHA3_RUN_MULTI, Sizes[Index]));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Hashes about SHA3_BYTES_PER_RUN bytes in messages of one size.
+*
+* @param	Run	Engine to be measured.
+* @param	Size	Size of each message in bytes.
+*
+* @return	Average time per message in nanoseconds.
+*
+******************************************************************************/
+static u64 TimeRun(Sha3Run Run, u32 Size)
+{
+	const u8 *In[SHA3_MULTI_COUNT];
+	u32 Sizes4[SHA3_MULTI_COUNT];
+	u8 Hash[SHA3_MULTI_COUNT][SHA3_HASH_LEN];
+	u8 *Out[SHA3_MULTI_COUNT];
+	u32 Count = SHA3_BYTES_PER_RUN / Size;
+	u32 Iter;
+	u32 Index;
+	u64 Start;
+
+	for (Index = 0U; Index < SHA3_MULTI_COUNT; Index++) {
+		In[Index] = Msg[Index];
+		Sizes4[Index] = Size;
+		Out[Index] = Hash[Index];
+	}
+
+	if (Count < SHA3_MULTI_COUNT) {
+		Count = SHA3_MULTI_COUNT;
+	}
+	Count -= Count % SHA3_MULTI_COUNT;
+
+	Start = GetTimeNs();
+	if (Run == SHA3_RUN_MULTI) {
+		for (Iter = 0U; Iter < Count; Iter += SHA3_MULTI_COUNT) {
+			(void)Sha3HashMulti(In, Sizes4, Out, SHA3_MULTI_COUNT);
+		}
+	} else {
+		for (Iter = 0U; Iter < Count; Iter++) {
+			(void)Sha3Hash(Run, Msg[Iter % SHA3_MULTI_COUNT], Size,
+					Hash[0]);
+		}
+	}
+
+	return (GetTimeNs() - Start) / Count;
+}
+
+/*****************************************************************************/
+/**
+*
+* Hashes one message on the given engine.
+*
+* @param	Run	SHA3_RUN_HW or SHA3_RUN_SW.
+* @param	In	Pointer to the message.
+* @param	Size	Size of the message in bytes.
+* @param	Out	Pointer to the digest.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int Sha3Hash(Sha3Run Run, const u8 *In, u32 Size, u8 *Out)
+{
+#ifdef XSECURE_SHA3_SW_HOST
+	XSecure_Sha3SwCtx Ctx;
+
+	if (Run != SHA3_RUN_SW) {
+		return XST_FAILURE;
+	}
+
+	XSecure_Sha3SwStart(&Ctx);
+	XSecure_Sha3SwUpdate(&Ctx, In, Size);
+	XSecure_Sha3SwFinish(&Ctx, XSECURE_SHA3_SW_NIST_PAD, Out);
+
+	return XST_SUCCESS;
+#else
+	u32 Status;
+
+	Status = (u32)XSecure_Sha3EngineSelection(&Secure_Sha3,
+			(Run == SHA3_RUN_SW) ? XSECURE_SHA3_ENGINE_SW :
+			XSECURE_SHA3_ENGINE_HW);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XSecure_Sha3Start(&Secure_Sha3);
+	if (Size != 0U) {
+		Status = XSecure_Sha3Update(&Secure_Sha3, In, Size);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+	Status = XSecure_Sha3Finish(&Secure_Sha3, Out);
+
+	return (Status == XST_SUCCESS) ? XST_SUCCESS : XST_FAILURE;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Hashes several messages in one call on the software engine.
+*
+* @param	In	Array of pointers to the messages.
+* @param	Size	Array of sizes of the messages in bytes.
+* @param	Out	Array of pointers to the digests.
+* @param	Count	Number of messages.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+static int Sha3HashMulti(const u8 * const In[], const u32 Size[],
+		u8 * const Out[], u32 Count)
+{
+#ifdef XSECURE_SHA3_SW_HOST
+	XSecure_Sha3SwDigestMulti(XSECURE_SHA3_SW_NIST_PAD, In, Size, Out,
+			Count);
+
+	return XST_SUCCESS;
+#else
+	u32 Status;
+
+	Status = (u32)XSecure_Sha3EngineSelection(&Secure_Sha3,
+			XSECURE_SHA3_ENGINE_SW);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Status = XSecure_Sha3DigestMulti(&Secure_Sha3, In, Size, Out, Count);
+
+	return (Status == XST_SUCCESS) ? XST_SUCCESS : XST_FAILURE;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns a monotonic time stamp in nanoseconds.
+*
+* @param	None
+*
+* @return	Time stamp in nanoseconds.
+*
+******************************************************************************/
+static u64 GetTimeNs(void)
+{
+#ifdef XSECURE_SHA3_SW_HOST
+	struct timespec Ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &Ts);
+	return ((u64)Ts.tv_sec * 1000000000ULL) + (u64)Ts.tv_nsec;
+#else
+	XTime Now;
+
+	XTime_GetTime(&Now);
+	return ((u64)Now * 1000000000ULL) / COUNTS_PER_SECOND;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Prints a digest.
+*
+* @param	Hash	Pointer to the digest.
+*
+* @return	None
+*
+******************************************************************************/
+static void PrintHash(const u8 *Hash)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < SHA3_HASH_LEN; Index++) {
+		xil_printf("%02x", Hash[Index]);
+	}
+	xil_printf("\r\n");
+}
+/** @} */
@@ -59,6 +59,10 @@
 *       psl  07/02/19 Fixed Coverity warnings.
 *       mmd  07/05/19 Optimized the code
 *       psl  07/31/19 Fixed MISRA-C violation
+*       ag   10/16/26 Added non blocking XSecure_Sha3UpdateStart and
+*                     XSecure_Sha3WaitForUpdate
+*       ag   10/16/26 Added software engine, which XSecure_Sha3Digest uses for
+*                     small messages, and XSecure_Sha3DigestMulti
 *
 * </pre>
 *
@@ -93,6 +97,12 @@ static void XSecure_Sha3KeccakPadd(XSecure_Sha3 *InstancePtr, u8 *Dst,
 					u32 MsgLen);
 static void XSecure_Sha3NistPadd(XSecure_Sha3 *InstancePtr, u8 *Dst,
 					u32 MsgLen);
+static void XSecure_Sha3EngineStart(XSecure_Sha3 *InstancePtr, u32 UseSw);
+static u32 XSecure_Sha3UseSw(const XSecure_Sha3 *InstancePtr, u32 Size);
+static u32 XSecure_Sha3HwFinish(XSecure_Sha3 *InstancePtr, u8 *Hash);
+#ifdef XSECURE_SHA3_SW_ENGINE
+static u8 XSecure_Sha3SwPadByte(const XSecure_Sha3 *InstancePtr);
+#endif
 
 /************************** Variable Definitions *****************************/
 
@@ -128,6 +138,10 @@ s32 XSecure_Sha3Initialize(XSecure_Sha3 *InstancePtr, XCsuDma* CsuDmaPtr)
 	InstancePtr->CsuDmaPtr = CsuDmaPtr;
 	InstancePtr->Sha3PadType = XSECURE_CSU_NIST_SHA3;
 	InstancePtr->IsLastUpdate = FALSE;
+#ifdef XSECURE_SHA3_SW_ENGINE
+	InstancePtr->Engine = XSECURE_SHA3_ENGINE_AUTO;
+	InstancePtr->IsSwActive = FALSE;
+#endif
 
 	XSecure_SssInitialize(&(InstancePtr->SssInstance));
 
@@ -178,6 +192,51 @@ END:
 	return Status;
 }
 
+#ifdef XSECURE_SHA3_SW_ENGINE
+/*****************************************************************************/
+/**
+ * @brief
+ * This function selects the engine used for the following hashes.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Sha3 instance.
+ * @param	Engine		Engine to be used.
+ * 			 - XSECURE_SHA3_ENGINE_AUTO to hash messages of up to
+ * 			   XSECURE_SHA3_SW_MAX_LEN bytes in software when the
+ * 			   size is known upfront, as in XSecure_Sha3Digest
+ * 			 - XSECURE_SHA3_ENGINE_HW for the CSU SHA3 engine
+ * 			 - XSECURE_SHA3_ENGINE_SW for the software engine
+ *
+ * @return	XST_SUCCESS if engine selection is successful.
+ * 		XST_FAILURE if a hash is in progress.
+ *
+ * @note	The default is XSECURE_SHA3_ENGINE_AUTO. XSecure_Sha3Start
+ *		followed by updates uses the hardware in that case, as the
+ *		size of the message is not known when the engine is started.
+ *
+ ******************************************************************************/
+s32 XSecure_Sha3EngineSelection(XSecure_Sha3 *InstancePtr,
+		XSecure_Sha3Engine Engine)
+{
+	s32 Status;
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid((Engine == XSECURE_SHA3_ENGINE_AUTO) ||
+			(Engine == XSECURE_SHA3_ENGINE_HW) ||
+			(Engine == XSECURE_SHA3_ENGINE_SW));
+
+	/* If operation is in between can't be modified */
+	if (InstancePtr->Sha3State != XSECURE_SHA3_INITIALIZED) {
+		Status = (s32)XST_FAILURE;
+		goto END;
+	}
+	InstancePtr->Engine = Engine;
+	Status = XST_SUCCESS;
+END:
+	return Status;
+}
+#endif
+
  /****************************************************************************/
  /**
  * @brief
@@ -257,6 +316,8 @@ static void XSecure_Sha3NistPadd(XSecure_Sha3 *InstancePtr, u8 *Dst, u32 MsgLen)
  *
  * @return	None
  *
+ * @note	The software engine is started instead if it has been selected
+ *		with XSecure_Sha3EngineSelection.
  *
  ******************************************************************************/
 void XSecure_Sha3Start(XSecure_Sha3 *InstancePtr)
@@ -265,21 +326,99 @@ void XSecure_Sha3Start(XSecure_Sha3 *InstancePtr)
 	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(InstancePtr->Sha3State == XSECURE_SHA3_INITIALIZED);
 
+	XSecure_Sha3EngineStart(InstancePtr,
+		XSecure_Sha3UseSw(InstancePtr, XSECURE_CSU_DMA_MAX_TRANSFER));
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function starts either the SHA-3 engine or the software engine.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	UseSw		TRUE to start the software engine.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+static void XSecure_Sha3EngineStart(XSecure_Sha3 *InstancePtr, u32 UseSw)
+{
 	InstancePtr->Sha3Len = 0U;
 	InstancePtr->PartialLen = 0U;
 	(void)memset(InstancePtr->PartialData, 0, XSECURE_SHA3_BLOCK_LEN);
 
-	/* Reset SHA3 engine. */
-	XSecure_ReleaseReset(InstancePtr->BaseAddress,
-			XSECURE_CSU_SHA3_RESET_OFFSET);
-
-	/* Start SHA3 engine. */
-	XSecure_WriteReg(InstancePtr->BaseAddress,
-			XSECURE_CSU_SHA3_START_OFFSET,
-			XSECURE_CSU_SHA3_START_START);
+	if (UseSw == (u32)TRUE) {
+#ifdef XSECURE_SHA3_SW_ENGINE
+		InstancePtr->IsSwActive = TRUE;
+		XSecure_Sha3SwStart(&InstancePtr->SwCtx);
+#endif
+	}
+	else {
+#ifdef XSECURE_SHA3_SW_ENGINE
+		InstancePtr->IsSwActive = FALSE;
+#endif
+		/* Reset SHA3 engine. */
+		XSecure_ReleaseReset(InstancePtr->BaseAddress,
+				XSECURE_CSU_SHA3_RESET_OFFSET);
+
+		/* Start SHA3 engine. */
+		XSecure_WriteReg(InstancePtr->BaseAddress,
+				XSECURE_CSU_SHA3_START_OFFSET,
+				XSECURE_CSU_SHA3_START_START);
+	}
 	InstancePtr->Sha3State = XSECURE_SHA3_ENGINE_STARTED;
 }
 
+/*****************************************************************************/
+/**
+ * @brief
+ * This function tells whether a message is to be hashed by the software
+ * engine, as per the engine selection and the size of the message.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	Size		Size of the message in bytes, or
+ *		XSECURE_CSU_DMA_MAX_TRANSFER when it is not known.
+ *
+ * @return	TRUE if the software engine is to be used, FALSE otherwise
+ *
+ ******************************************************************************/
+static u32 XSecure_Sha3UseSw(const XSecure_Sha3 *InstancePtr, u32 Size)
+{
+	u32 UseSw = FALSE;
+
+#ifdef XSECURE_SHA3_SW_ENGINE
+	if ((InstancePtr->Engine == XSECURE_SHA3_ENGINE_SW) ||
+		((InstancePtr->Engine == XSECURE_SHA3_ENGINE_AUTO) &&
+		(Size <= XSECURE_SHA3_SW_MAX_LEN))) {
+		UseSw = TRUE;
+	}
+#else
+	(void)InstancePtr;
+	(void)Size;
+#endif
+
+	return UseSw;
+}
+
+#ifdef XSECURE_SHA3_SW_ENGINE
+/*****************************************************************************/
+/**
+ * @brief
+ * This function returns the software engine padding for the selected SHA-3
+ * padding type.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	XSECURE_SHA3_SW_KECCAK_PAD or XSECURE_SHA3_SW_NIST_PAD
+ *
+ ******************************************************************************/
+static u8 XSecure_Sha3SwPadByte(const XSecure_Sha3 *InstancePtr)
+{
+	return (InstancePtr->Sha3PadType == XSECURE_CSU_KECCAK_SHA3) ?
+		(u8)XSECURE_SHA3_SW_KECCAK_PAD : (u8)XSECURE_SHA3_SW_NIST_PAD;
+}
+#endif
+
 /*****************************************************************************/
 /**
  * @brief
@@ -305,6 +444,15 @@ u32 XSecure_Sha3Update(XSecure_Sha3 *InstancePtr, const u8 *Data,
 	Xil_AssertNonvoid(Size > (u32)0x00U);
 	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
 
+#ifdef XSECURE_SHA3_SW_ENGINE
+	if (InstancePtr->IsSwActive == (u32)TRUE) {
+		InstancePtr->Sha3Len += Size;
+		XSecure_Sha3SwUpdate(&InstancePtr->SwCtx, Data, Size);
+		Status = (u32)XST_SUCCESS;
+		goto END;
+	}
+#endif
+
 	InstancePtr->Sha3Len += Size;
 	DataSize = Size;
 	TransferredBytes = 0U;
@@ -337,6 +485,110 @@ END:
 }
 
 
+/*****************************************************************************/
+/**
+ * @brief
+ * This function starts the SHA3 engine update with the input data and returns
+ * without waiting for the CSU DMA transfer to complete, so that the caller can
+ * use the other DMA meanwhile. XSecure_Sha3WaitForUpdate shall be called
+ * before any other operation on the instance or on its CSU DMA.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	Data 		Pointer to the input data for hashing, word
+ *		aligned.
+ * @param	Size 		Size of the input data in bytes, multiple of
+ *		words.
+ *
+ * @return	XST_SUCCESS if the transfer is started
+ * 		XST_FAILURE if the data is not word aligned, earlier data is
+ *		still buffered by XSecure_Sha3Update or the SSS config fails
+ *
+ * @note	On the software engine the update is done before returning.
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3UpdateStart(XSecure_Sha3 *InstancePtr, const u8 *Data,
+						const u32 Size)
+{
+	u32 Status = (u32)XST_FAILURE;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Size > (u32)0x00U);
+	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
+
+#ifdef XSECURE_SHA3_SW_ENGINE
+	if (InstancePtr->IsSwActive == (u32)TRUE) {
+		InstancePtr->Sha3Len += Size;
+		XSecure_Sha3SwUpdate(&InstancePtr->SwCtx, Data, Size);
+		Status = (u32)XST_SUCCESS;
+		goto END;
+	}
+#endif
+
+	if (((Size % 4U) != 0U) || (Size > XSECURE_CSU_DMA_MAX_TRANSFER) ||
+		(InstancePtr->PartialLen != 0U) ||
+		(((UINTPTR)Data & XCSUDMA_ADDR_LSB_MASK) != 0U)) {
+		goto END;
+	}
+
+	/* Configure the SSS for SHA3 hashing. */
+	Status = XSecure_SssSha(&(InstancePtr->SssInstance),
+				InstancePtr->CsuDmaPtr->Config.DeviceId);
+	if (Status != (u32)XST_SUCCESS){
+		goto END;
+	}
+
+	InstancePtr->Sha3Len += Size;
+	XCsuDma_Transfer(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+			(UINTPTR)Data, Size/4U, (u8)InstancePtr->IsLastUpdate);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function waits for the completion of the update started with
+ * XSecure_Sha3UpdateStart.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	XST_SUCCESS if the update is completed
+ * 		XST_FAILURE if the CSU DMA transfer times out
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3WaitForUpdate(XSecure_Sha3 *InstancePtr)
+{
+	u32 Status = (u32)XST_FAILURE;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+#ifdef XSECURE_SHA3_SW_ENGINE
+	if (InstancePtr->IsSwActive == (u32)TRUE) {
+		Status = (u32)XST_SUCCESS;
+		goto END;
+	}
+#endif
+
+	Status = XCsuDma_WaitForDoneTimeout(InstancePtr->CsuDmaPtr,
+						XCSUDMA_SRC_CHANNEL);
+	if (Status != (u32)XST_SUCCESS) {
+		/* Set SHA under reset on failure condition */
+		XSecure_SetReset(InstancePtr->BaseAddress,
+					XSECURE_CSU_SHA3_RESET_OFFSET);
+		goto END;
+	}
+
+	/* Acknowledge the transfer has completed */
+	XCsuDma_IntrClear(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+				XCSUDMA_IXR_DONE_MASK);
+
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * @brief
@@ -353,7 +605,6 @@ END:
  *****************************************************************************/
 u32 XSecure_Sha3Finish(XSecure_Sha3 *InstancePtr, u8 *Hash)
 {
-	u32 PartialLen;
 	u32 Status = (u32)XST_FAILURE;
 
 	/* Asserts validate the input arguments */
@@ -361,6 +612,42 @@ u32 XSecure_Sha3Finish(XSecure_Sha3 *InstancePtr, u8 *Hash)
 	Xil_AssertNonvoid(Hash != NULL);
 	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
 
+#ifdef XSECURE_SHA3_SW_ENGINE
+	if (InstancePtr->IsSwActive == (u32)TRUE) {
+		XSecure_Sha3SwFinish(&InstancePtr->SwCtx,
+			XSecure_Sha3SwPadByte(InstancePtr), Hash);
+		InstancePtr->Sha3State = XSECURE_SHA3_INITIALIZED;
+		Status = (u32)XST_SUCCESS;
+		goto END;
+	}
+#endif
+
+	Status = XSecure_Sha3HwFinish(InstancePtr, Hash);
+
+#ifdef XSECURE_SHA3_SW_ENGINE
+END:
+#endif
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function pads the data on the SHA-3 engine and reads the final hash.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Sha3 instance.
+ * @param	Hash		Pointer to location where resulting hash will
+ *		be written
+ *
+ * @return	XST_SUCCESS if finished without any errors
+ *		XST_FAILURE if Sha3PadType is other than KECCAK or NIST
+ *
+ *****************************************************************************/
+static u32 XSecure_Sha3HwFinish(XSecure_Sha3 *InstancePtr, u8 *Hash)
+{
+	u32 PartialLen;
+	u32 Status = (u32)XST_FAILURE;
+
 	PartialLen = InstancePtr->Sha3Len % XSECURE_SHA3_BLOCK_LEN;
 
 	PartialLen = (PartialLen == 0U)?(XSECURE_SHA3_BLOCK_LEN) :
@@ -437,6 +724,10 @@ END:
  * @return	XST_SUCCESS if digest calculation done successfully
  *		XST_FAILURE if any error from Sha3Update or Sha3Finish.
  *
+ * @note	With XSECURE_SHA3_ENGINE_AUTO selected, messages of up to
+ *		XSECURE_SHA3_SW_MAX_LEN bytes are hashed by the software
+ *		engine, where it is built.
+ *
  ******************************************************************************/
 u32 XSecure_Sha3Digest(XSecure_Sha3 *InstancePtr, const u8 *In, const u32 Size,
 								u8 *Out)
@@ -447,8 +738,10 @@ u32 XSecure_Sha3Digest(XSecure_Sha3 *InstancePtr, const u8 *In, const u32 Size,
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(Size > (u32)0x00U);
 	Xil_AssertNonvoid(Out != NULL);
+	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_INITIALIZED);
 
-	XSecure_Sha3Start(InstancePtr);
+	XSecure_Sha3EngineStart(InstancePtr,
+		XSecure_Sha3UseSw(InstancePtr, Size));
 	Status = XSecure_Sha3Update(InstancePtr, In, Size);
 	if (Status != (u32)XST_SUCCESS){
 		goto END;
@@ -462,6 +755,71 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * @brief
+ * This function calculates the SHA-3 digests of several independent messages
+ * in one call.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Sha3 instance.
+ * @param	In		Array of Count pointers to the input data
+ * @param	Size		Array of Count sizes of the input data
+ * @param	Out		Array of Count pointers to locations where the
+ *		resulting hashes will be written.
+ * @param	Count		Number of messages
+ *
+ * @return	XST_SUCCESS if digest calculation done successfully
+ *		XST_FAILURE if any error from Sha3Digest.
+ *
+ * @note	When the software engine would be used for every message, the
+ *		messages are hashed together by the software engine, two at a
+ *		time where NEON is available. Otherwise they are hashed one
+ *		after the other by XSecure_Sha3Digest.
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3DigestMulti(XSecure_Sha3 *InstancePtr, const u8 * const In[],
+		const u32 Size[], u8 * const Out[], u32 Count)
+{
+	u32 Index;
+	u32 Status = (u32)XST_FAILURE;
+#ifdef XSECURE_SHA3_SW_ENGINE
+	u32 UseSw = TRUE;
+#endif
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(In != NULL);
+	Xil_AssertNonvoid(Size != NULL);
+	Xil_AssertNonvoid(Out != NULL);
+	Xil_AssertNonvoid(Count > (u32)0x00U);
+	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_INITIALIZED);
+
+#ifdef XSECURE_SHA3_SW_ENGINE
+	for (Index = 0U; Index < Count; Index++) {
+		if (XSecure_Sha3UseSw(InstancePtr, Size[Index]) != (u32)TRUE) {
+			UseSw = FALSE;
+		}
+	}
+	if (UseSw == (u32)TRUE) {
+		XSecure_Sha3SwDigestMulti(XSecure_Sha3SwPadByte(InstancePtr),
+			In, Size, Out, Count);
+		Status = (u32)XST_SUCCESS;
+		goto END;
+	}
+#endif
+
+	for (Index = 0U; Index < Count; Index++) {
+		Status = XSecure_Sha3Digest(InstancePtr, In[Index], Size[Index],
+				Out[Index]);
+		if (Status != (u32)XST_SUCCESS) {
+			goto END;
+		}
+	}
+
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * @brief
@@ -484,12 +842,23 @@ void XSecure_Sha3_ReadHash(XSecure_Sha3 *InstancePtr, u8 *Hash)
 	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(Hash != NULL);
 
+#ifdef XSECURE_SHA3_SW_ENGINE
+	if (InstancePtr->IsSwActive == (u32)TRUE) {
+		XSecure_Sha3SwReadHash(&InstancePtr->SwCtx, Hash);
+		goto END;
+	}
+#endif
+
 	for (Index = 0U; Index < XSECURE_CSU_SHA3_HASH_LENGTH_IN_WORDS; Index++)
 	{
 		RegVal = XSecure_ReadReg(InstancePtr->BaseAddress,
 			XSECURE_CSU_SHA3_DIGEST_0_OFFSET + (Index * 4U));
 		HashPtr[XSECURE_CSU_SHA3_HASH_LENGTH_IN_WORDS - Index - 1] = RegVal;
 	}
+#ifdef XSECURE_SHA3_SW_ENGINE
+END:
+#endif
+	return;
 }
 /*****************************************************************************/
 /**
@@ -36,6 +36,9 @@
 * This driver supports the following features:
 *
 * - SHA-3 hash calculation
+* - Software SHA-3 engine on A53, A72 and R5, used for small messages or
+*   when selected with XSecure_Sha3EngineSelection
+* - Hashing of several messages in one call with XSecure_Sha3DigestMulti
 *
 * <b>Initialization & Configuration</b>
 *
@@ -65,6 +68,8 @@
                       as void to u32.
 *       psl  03/26/19 Fixed MISRA-C violation
 * 4.1   mmd  07/05/19 Optimized the code
+*       ag   10/16/26 Added XSecure_Sha3UpdateStart and XSecure_Sha3WaitForUpdate
+*       ag   10/16/26 Added software engine selection and XSecure_Sha3DigestMulti
 *
 * </pre>
 *
@@ -81,6 +86,7 @@ extern "C" {
 
 /***************************** Include Files *********************************/
 #include "xsecure_sha_hw.h"
+#include "xsecure_sha3_sw.h"
 #include "xcsudma.h"
 #include "xil_assert.h"
 #include "xil_util.h"
@@ -107,6 +113,15 @@ extern "C" {
 							rate in bytes*/
 #define XSECURE_SHA_TIMEOUT_MAX         (0x1FFFFU)
 
+/**
+ * Largest message hashed by the software engine when the engine selection is
+ * XSECURE_SHA3_ENGINE_AUTO. It can be set with the sha3_sw_max_len parameter
+ * of the library.
+ */
+#ifndef XSECURE_SHA3_SW_MAX_LEN
+#define XSECURE_SHA3_SW_MAX_LEN		(4096U)
+#endif
+
 /***************************** Type Definitions******************************/
 
 /* SHA3 type selection */
@@ -122,6 +137,17 @@ typedef enum {
 	XSECURE_SHA3_ENGINE_STARTED
 } XSecure_Sha3State;
 
+#ifdef XSECURE_SHA3_SW_ENGINE
+/* SHA3 engine selection */
+typedef enum {
+	XSECURE_SHA3_ENGINE_AUTO, /**< Software for XSecure_Sha3Digest and
+				    *  XSecure_Sha3DigestMulti of messages up to
+				    *  XSECURE_SHA3_SW_MAX_LEN, else hardware */
+	XSECURE_SHA3_ENGINE_HW, /**< CSU SHA3 engine */
+	XSECURE_SHA3_ENGINE_SW /**< Software engine */
+} XSecure_Sha3Engine;
+#endif
+
 /**
  * The SHA-3 driver instance data structure. A pointer to an instance data
  * structure is passed around by functions to refer to a specific driver
@@ -137,6 +163,11 @@ typedef struct {
 	u8 PartialData[XSECURE_SHA3_BLOCK_LEN];
 	XSecure_Sss SssInstance;
 	XSecure_Sha3State Sha3State;
+#ifdef XSECURE_SHA3_SW_ENGINE
+	XSecure_Sha3Engine Engine; /**< Engine selection */
+	u32 IsSwActive; /**< Current hash runs on the software engine */
+	XSecure_Sha3SwCtx SwCtx; /**< Software engine state */
+#endif
 } XSecure_Sha3;
 /**
 @}
@@ -169,11 +200,16 @@ void XSecure_Sha3Start(XSecure_Sha3 *InstancePtr);
 /* Data Transfer */
 u32 XSecure_Sha3Update(XSecure_Sha3 *InstancePtr, const u8 *Data,
 						const u32 Size);
+u32 XSecure_Sha3UpdateStart(XSecure_Sha3 *InstancePtr, const u8 *Data,
+						const u32 Size);
+u32 XSecure_Sha3WaitForUpdate(XSecure_Sha3 *InstancePtr);
 u32 XSecure_Sha3Finish(XSecure_Sha3 *InstancePtr, u8 *Hash);
 
 /* Complete SHA digest calculation */
 u32 XSecure_Sha3Digest(XSecure_Sha3 *InstancePtr, const u8 *In,
 						const u32 Size, u8 *Out);
+u32 XSecure_Sha3DigestMulti(XSecure_Sha3 *InstancePtr, const u8 * const In[],
+		const u32 Size[], u8 * const Out[], u32 Count);
 
 void XSecure_Sha3_ReadHash(XSecure_Sha3 *InstancePtr, u8 *Hash);
 
@@ -182,6 +218,11 @@ s32 XSecure_Sha3PadSelection(XSecure_Sha3 *InstancePtr,
 
 s32 XSecure_Sha3LastUpdate(XSecure_Sha3 *InstancePtr);
 
+#ifdef XSECURE_SHA3_SW_ENGINE
+s32 XSecure_Sha3EngineSelection(XSecure_Sha3 *InstancePtr,
+		XSecure_Sha3Engine Engine);
+#endif
+
 #ifdef __cplusplus
 extern "C" }
 #endif
@@ -0,0 +1,482 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsecure_sha3_sw.c
+*
+* This file contains the software Keccak-f[1600] engine used by the SHA-3
+* driver. Refer to the header file xsecure_sha3_sw.h for more detailed
+* information.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.1   ag   10/16/26 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "xsecure_sha3_sw.h"
+
+#ifdef XSECURE_SHA3_SW_ENGINE
+#ifdef XSECURE_SHA3_SW_NEON
+#include <arm_neon.h>
+#endif
+
+/************************** Constant Definitions *****************************/
+#define XSECURE_SHA3_SW_ROUNDS		(24U) /**< Keccak-f[1600] rounds */
+#define XSECURE_SHA3_SW_RATE_LANES	(XSECURE_SHA3_SW_RATE / 8U)
+#define XSECURE_SHA3_SW_LAST_PAD	(0x80U) /**< Last bit of padding */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * One permutation of the state A of lanes of type T. The lane operations
+ * XSECURE_SW_XOR, XSECURE_SW_XOR5, XSECURE_SW_ROL, XSECURE_SW_CHI and
+ * XSECURE_SW_IOTA are defined before each use for the lane type, so that
+ * the scalar and the NEON permutations share this one round.
+ */
+#define XSECURE_SHA3_SW_PERMUTE(T, A)						\
+{										\
+	T C0, C1, C2, C3, C4;							\
+	T D0, D1, D2, D3, D4;							\
+	T B[XSECURE_SHA3_SW_LANES];						\
+	u32 Round;								\
+										\
+	for (Round = 0U; Round < XSECURE_SHA3_SW_ROUNDS; Round++) {		\
+		/* Theta */							\
+		C0 = XSECURE_SW_XOR5(A[0U], A[5U], A[10U], A[15U], A[20U]);	\
+		C1 = XSECURE_SW_XOR5(A[1U], A[6U], A[11U], A[16U], A[21U]);	\
+		C2 = XSECURE_SW_XOR5(A[2U], A[7U], A[12U], A[17U], A[22U]);	\
+		C3 = XSECURE_SW_XOR5(A[3U], A[8U], A[13U], A[18U], A[23U]);	\
+		C4 = XSECURE_SW_XOR5(A[4U], A[9U], A[14U], A[19U], A[24U]);	\
+		D0 = XSECURE_SW_XOR(C4, XSECURE_SW_ROL(C1, 1U));		\
+		D1 = XSECURE_SW_XOR(C0, XSECURE_SW_ROL(C2, 1U));		\
+		D2 = XSECURE_SW_XOR(C1, XSECURE_SW_ROL(C3, 1U));		\
+		D3 = XSECURE_SW_XOR(C2, XSECURE_SW_ROL(C4, 1U));		\
+		D4 = XSECURE_SW_XOR(C3, XSECURE_SW_ROL(C0, 1U));		\
+		/* Rho and Pi */						\
+		B[0U] = XSECURE_SW_XOR(A[0U], D0);				\
+		B[1U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[6U], D1), 44U);		\
+		B[2U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[12U], D2), 43U);	\
+		B[3U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[18U], D3), 21U);	\
+		B[4U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[24U], D4), 14U);	\
+		B[5U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[3U], D3), 28U);		\
+		B[6U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[9U], D4), 20U);		\
+		B[7U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[10U], D0), 3U);		\
+		B[8U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[16U], D1), 45U);	\
+		B[9U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[22U], D2), 61U);	\
+		B[10U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[1U], D1), 1U);		\
+		B[11U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[7U], D2), 6U);		\
+		B[12U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[13U], D3), 25U);	\
+		B[13U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[19U], D4), 8U);	\
+		B[14U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[20U], D0), 18U);	\
+		B[15U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[4U], D4), 27U);	\
+		B[16U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[5U], D0), 36U);	\
+		B[17U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[11U], D1), 10U);	\
+		B[18U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[17U], D2), 15U);	\
+		B[19U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[23U], D3), 56U);	\
+		B[20U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[2U], D2), 62U);	\
+		B[21U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[8U], D3), 55U);	\
+		B[22U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[14U], D4), 39U);	\
+		B[23U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[15U], D0), 41U);	\
+		B[24U] = XSECURE_SW_ROL(XSECURE_SW_XOR(A[21U], D1), 2U);	\
+		/* Chi */							\
+		A[0U] = XSECURE_SW_CHI(B[0U], B[1U], B[2U]);			\
+		A[1U] = XSECURE_SW_CHI(B[1U], B[2U], B[3U]);			\
+		A[2U] = XSECURE_SW_CHI(B[2U], B[3U], B[4U]);			\
+		A[3U] = XSECURE_SW_CHI(B[3U], B[4U], B[0U]);			\
+		A[4U] = XSECURE_SW_CHI(B[4U], B[0U], B[1U]);			\
+		A[5U] = XSECURE_SW_CHI(B[5U], B[6U], B[7U]);			\
+		A[6U] = XSECURE_SW_CHI(B[6U], B[7U], B[8U]);			\
+		A[7U] = XSECURE_SW_CHI(B[7U], B[8U], B[9U]);			\
+		A[8U] = XSECURE_SW_CHI(B[8U], B[9U], B[5U]);			\
+		A[9U] = XSECURE_SW_CHI(B[9U], B[5U], B[6U]);			\
+		A[10U] = XSECURE_SW_CHI(B[10U], B[11U], B[12U]);		\
+		A[11U] = XSECURE_SW_CHI(B[11U], B[12U], B[13U]);		\
+		A[12U] = XSECURE_SW_CHI(B[12U], B[13U], B[14U]);		\
+		A[13U] = XSECURE_SW_CHI(B[13U], B[14U], B[10U]);		\
+		A[14U] = XSECURE_SW_CHI(B[14U], B[10U], B[11U]);		\
+		A[15U] = XSECURE_SW_CHI(B[15U], B[16U], B[17U]);		\
+		A[16U] = XSECURE_SW_CHI(B[16U], B[17U], B[18U]);		\
+		A[17U] = XSECURE_SW_CHI(B[17U], B[18U], B[19U]);		\
+		A[18U] = XSECURE_SW_CHI(B[18U], B[19U], B[15U]);		\
+		A[19U] = XSECURE_SW_CHI(B[19U], B[15U], B[16U]);		\
+		A[20U] = XSECURE_SW_CHI(B[20U], B[21U], B[22U]);		\
+		A[21U] = XSECURE_SW_CHI(B[21U], B[22U], B[23U]);		\
+		A[22U] = XSECURE_SW_CHI(B[22U], B[23U], B[24U]);		\
+		A[23U] = XSECURE_SW_CHI(B[23U], B[24U], B[20U]);		\
+		A[24U] = XSECURE_SW_CHI(B[24U], B[20U], B[21U]);		\
+		/* Iota */							\
+		A[0U] = XSECURE_SW_IOTA(A[0U], Round);				\
+	}									\
+}
+
+/************************** Function Prototypes ******************************/
+
+static void XSecure_Sha3SwPermute(u64 *A);
+static void XSecure_Sha3SwAbsorb(u64 *Lanes, const u8 *Data);
+#ifdef XSECURE_SHA3_SW_NEON
+static void XSecure_Sha3SwPermuteX2(uint64x2_t *A);
+static void XSecure_Sha3SwDigestX2(u8 PadByte, const u8 *In0, u32 Size0,
+		const u8 *In1, u32 Size1, u8 *Out0, u8 *Out1);
+#endif
+
+/************************** Variable Definitions *****************************/
+
+static const u64 XSecure_Sha3SwRc[XSECURE_SHA3_SW_ROUNDS] = {
+	0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL,
+	0x8000000080008000ULL, 0x000000000000808BULL, 0x0000000080000001ULL,
+	0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008AULL,
+	0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+	0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL,
+	0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+	0x000000000000800AULL, 0x800000008000000AULL, 0x8000000080008081ULL,
+	0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function loads a little endian lane from a message, which need not be
+ * aligned.
+ *
+ * @param	Src	Pointer to the eight message bytes.
+ *
+ * @return	Lane value
+ *
+ ******************************************************************************/
+static inline u64 XSecure_Sha3SwLoad(const u8 *Src)
+{
+	u64 Lane;
+
+	(void)memcpy(&Lane, Src, sizeof(Lane));
+
+	return Lane;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function xors one byte into the state at byte offset Pos.
+ *
+ * @param	Lanes	Pointer to the state.
+ * @param	Pos	Byte offset in the state.
+ * @param	Byte	Value to be xored.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+static inline void XSecure_Sha3SwXorByte(u64 *Lanes, u32 Pos, u8 Byte)
+{
+	Lanes[Pos / 8U] ^= (u64)Byte << (8U * (Pos % 8U));
+}
+
+#define XSECURE_SW_XOR(X, Y)		((X) ^ (Y))
+#define XSECURE_SW_XOR5(V, W, X, Y, Z)	((V) ^ (W) ^ (X) ^ (Y) ^ (Z))
+#define XSECURE_SW_ROL(X, N)		(((X) << (N)) | ((X) >> (64U - (N))))
+#define XSECURE_SW_CHI(X, Y, Z)		((X) ^ ((~(Y)) & (Z)))
+#define XSECURE_SW_IOTA(X, R)		((X) ^ XSecure_Sha3SwRc[(R)])
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function applies Keccak-f[1600] to the state.
+ *
+ * @param	A	Pointer to the 25 lanes of the state.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+static void XSecure_Sha3SwPermute(u64 *A)
+XSECURE_SHA3_SW_PERMUTE(u64, A)
+
+#undef XSECURE_SW_XOR
+#undef XSECURE_SW_XOR5
+#undef XSECURE_SW_ROL
+#undef XSECURE_SW_CHI
+#undef XSECURE_SW_IOTA
+
+#ifdef XSECURE_SHA3_SW_NEON
+#define XSECURE_SW_XOR(X, Y)		veorq_u64((X), (Y))
+#define XSECURE_SW_XOR5(V, W, X, Y, Z)	\
+	veorq_u64(veorq_u64(veorq_u64((V), (W)), veorq_u64((X), (Y))), (Z))
+#define XSECURE_SW_ROL(X, N)		\
+	vsliq_n_u64(vshrq_n_u64((X), 64U - (N)), (X), (N))
+#define XSECURE_SW_CHI(X, Y, Z)		veorq_u64((X), vbicq_u64((Z), (Y)))
+#define XSECURE_SW_IOTA(X, R)		\
+	veorq_u64((X), vdupq_n_u64(XSecure_Sha3SwRc[(R)]))
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function applies Keccak-f[1600] to two states at once, one in each
+ * half of the NEON lanes.
+ *
+ * @param	A	Pointer to the 25 interleaved lanes of the states.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+static void XSecure_Sha3SwPermuteX2(uint64x2_t *A)
+XSECURE_SHA3_SW_PERMUTE(uint64x2_t, A)
+
+#undef XSECURE_SW_XOR
+#undef XSECURE_SW_XOR5
+#undef XSECURE_SW_ROL
+#undef XSECURE_SW_CHI
+#undef XSECURE_SW_IOTA
+#endif
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function absorbs one full block of the message into the state.
+ *
+ * @param	Lanes	Pointer to the state.
+ * @param	Data	Pointer to XSECURE_SHA3_SW_RATE bytes of message.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+static void XSecure_Sha3SwAbsorb(u64 *Lanes, const u8 *Data)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < XSECURE_SHA3_SW_RATE_LANES; Index++) {
+		Lanes[Index] ^= XSecure_Sha3SwLoad(&Data[Index * 8U]);
+	}
+	XSecure_Sha3SwPermute(Lanes);
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function starts a new software hash.
+ *
+ * @param	Ctx	Pointer to the software hash state.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_Sha3SwStart(XSecure_Sha3SwCtx *Ctx)
+{
+	(void)memset(Ctx->Lanes, 0, sizeof(Ctx->Lanes));
+	Ctx->Pos = 0U;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function absorbs message data into the software hash. Full blocks
+ * are absorbed a lane at a time and only the bytes which do not complete a
+ * block are absorbed one by one.
+ *
+ * @param	Ctx	Pointer to the software hash state.
+ * @param	Data	Pointer to the message data, of any alignment.
+ * @param	Size	Size of the message data in bytes.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_Sha3SwUpdate(XSecure_Sha3SwCtx *Ctx, const u8 *Data, u32 Size)
+{
+	u32 Offset = 0U;
+
+	while (Offset < Size) {
+		if ((Ctx->Pos == 0U) &&
+			((Size - Offset) >= XSECURE_SHA3_SW_RATE)) {
+			XSecure_Sha3SwAbsorb(Ctx->Lanes, &Data[Offset]);
+			Offset += XSECURE_SHA3_SW_RATE;
+		}
+		else {
+			XSecure_Sha3SwXorByte(Ctx->Lanes, Ctx->Pos, Data[Offset]);
+			Offset++;
+			Ctx->Pos++;
+			if (Ctx->Pos == XSECURE_SHA3_SW_RATE) {
+				XSecure_Sha3SwPermute(Ctx->Lanes);
+				Ctx->Pos = 0U;
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function pads the message and writes the digest of the software hash.
+ *
+ * @param	Ctx	Pointer to the software hash state.
+ * @param	PadByte	XSECURE_SHA3_SW_NIST_PAD or XSECURE_SHA3_SW_KECCAK_PAD.
+ * @param	Hash	Pointer to XSECURE_SHA3_SW_HASH_LEN bytes for the digest.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_Sha3SwFinish(XSecure_Sha3SwCtx *Ctx, u8 PadByte, u8 *Hash)
+{
+	XSecure_Sha3SwXorByte(Ctx->Lanes, Ctx->Pos, PadByte);
+	XSecure_Sha3SwXorByte(Ctx->Lanes, XSECURE_SHA3_SW_RATE - 1U,
+			XSECURE_SHA3_SW_LAST_PAD);
+	XSecure_Sha3SwPermute(Ctx->Lanes);
+	Ctx->Pos = 0U;
+
+	XSecure_Sha3SwReadHash(Ctx, Hash);
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function reads the first XSECURE_SHA3_SW_HASH_LEN bytes of the state,
+ * which hold the digest once XSecure_Sha3SwFinish has been called.
+ *
+ * @param	Ctx	Pointer to the software hash state.
+ * @param	Hash	Pointer to XSECURE_SHA3_SW_HASH_LEN bytes for the digest.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_Sha3SwReadHash(const XSecure_Sha3SwCtx *Ctx, u8 *Hash)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < XSECURE_SHA3_SW_HASH_LEN; Index++) {
+		Hash[Index] = (u8)(Ctx->Lanes[Index / 8U] >> (8U * (Index % 8U)));
+	}
+}
+
+#ifdef XSECURE_SHA3_SW_NEON
+/*****************************************************************************/
+/**
+ * @brief
+ * This function hashes two messages together. The blocks both messages have
+ * are absorbed in lockstep with the two way permutation, the rest of the
+ * longer message and the padding of both are done on the scalar states.
+ *
+ * @param	PadByte	XSECURE_SHA3_SW_NIST_PAD or XSECURE_SHA3_SW_KECCAK_PAD.
+ * @param	In0	Pointer to the first message.
+ * @param	Size0	Size of the first message in bytes.
+ * @param	In1	Pointer to the second message.
+ * @param	Size1	Size of the second message in bytes.
+ * @param	Out0	Pointer to the digest of the first message.
+ * @param	Out1	Pointer to the digest of the second message.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+static void XSecure_Sha3SwDigestX2(u8 PadByte, const u8 *In0, u32 Size0,
+		const u8 *In1, u32 Size1, u8 *Out0, u8 *Out1)
+{
+	uint64x2_t State[XSECURE_SHA3_SW_LANES];
+	XSecure_Sha3SwCtx Ctx0;
+	XSecure_Sha3SwCtx Ctx1;
+	u32 Offset = 0U;
+	u32 Common;
+	u32 Index;
+
+	Common = ((Size0 < Size1) ? Size0 : Size1);
+	Common -= Common % XSECURE_SHA3_SW_RATE;
+
+	for (Index = 0U; Index < XSECURE_SHA3_SW_LANES; Index++) {
+		State[Index] = vdupq_n_u64(0U);
+	}
+
+	while (Offset < Common) {
+		for (Index = 0U; Index < XSECURE_SHA3_SW_RATE_LANES; Index++) {
+			State[Index] = veorq_u64(State[Index], vcombine_u64(
+				vcreate_u64(XSecure_Sha3SwLoad(
+					&In0[Offset + (Index * 8U)])),
+				vcreate_u64(XSecure_Sha3SwLoad(
+					&In1[Offset + (Index * 8U)]))));
+		}
+		XSecure_Sha3SwPermuteX2(State);
+		Offset += XSECURE_SHA3_SW_RATE;
+	}
+
+	for (Index = 0U; Index < XSECURE_SHA3_SW_LANES; Index++) {
+		Ctx0.Lanes[Index] = vgetq_lane_u64(State[Index], 0);
+		Ctx1.Lanes[Index] = vgetq_lane_u64(State[Index], 1);
+	}
+	Ctx0.Pos = 0U;
+	Ctx1.Pos = 0U;
+
+	XSecure_Sha3SwUpdate(&Ctx0, &In0[Offset], Size0 - Offset);
+	XSecure_Sha3SwUpdate(&Ctx1, &In1[Offset], Size1 - Offset);
+	XSecure_Sha3SwFinish(&Ctx0, PadByte, Out0);
+	XSecure_Sha3SwFinish(&Ctx1, PadByte, Out1);
+}
+#endif
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function calculates the digests of several independent messages.
+ * With NEON the messages are hashed two at a time.
+ *
+ * @param	PadByte	XSECURE_SHA3_SW_NIST_PAD or XSECURE_SHA3_SW_KECCAK_PAD.
+ * @param	In	Array of pointers to the messages.
+ * @param	Size	Array of sizes of the messages in bytes.
+ * @param	Out	Array of pointers to XSECURE_SHA3_SW_HASH_LEN bytes for
+ *		the digests.
+ * @param	Count	Number of messages.
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void XSecure_Sha3SwDigestMulti(u8 PadByte, const u8 * const In[],
+		const u32 Size[], u8 * const Out[], u32 Count)
+{
+	XSecure_Sha3SwCtx Ctx;
+	u32 Index = 0U;
+
+#ifdef XSECURE_SHA3_SW_NEON
+	while ((Index + 1U) < Count) {
+		XSecure_Sha3SwDigestX2(PadByte, In[Index], Size[Index],
+			In[Index + 1U], Size[Index + 1U], Out[Index],
+			Out[Index + 1U]);
+		Index += 2U;
+	}
+#endif
+	while (Index < Count) {
+		XSecure_Sha3SwStart(&Ctx);
+		XSecure_Sha3SwUpdate(&Ctx, In[Index], Size[Index]);
+		XSecure_Sha3SwFinish(&Ctx, PadByte, Out[Index]);
+		Index++;
+	}
+}
+#endif /* XSECURE_SHA3_SW_ENGINE */
@@ -0,0 +1,114 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsecure_sha3_sw.h
+* @addtogroup xsecure_sha3_apis SHA-3
+* @{
+* @cond xsecure_internal
+* This file contains the software Keccak-f[1600] engine used by the SHA-3
+* driver on the application and real time processors, where hashing small
+* buffers in software is faster than going through the CSU SHA3 engine and
+* does not serialize all callers on the one hardware instance.
+*
+* The engine computes SHA3-384 with 64-bit lanes. When NEON is available
+* two independent states are permuted together by
+* XSecure_Sha3SwDigestMulti. The engine is not built for MicroBlaze based
+* PMU and PMC, which keep using the hardware only.
+*
+* Lanes are loaded from the message as little endian words, as all the
+* processors this engine is built for run little endian.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.1   ag   10/16/26 Initial release
+*
+* </pre>
+* @endcond
+******************************************************************************/
+
+#ifndef XSECURE_SHA3_SW_H
+#define XSECURE_SHA3_SW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+
+/************************** Constant Definitions ****************************/
+/** @cond xsecure_internal
+@{
+*/
+#if !defined(__MICROBLAZE__) && !defined(XSECURE_SHA3_SW_DISABLE)
+#define XSECURE_SHA3_SW_ENGINE	/**< Software SHA3 engine is built */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define XSECURE_SHA3_SW_NEON	/**< Two way NEON permutation is built */
+#endif
+#endif
+
+#define XSECURE_SHA3_SW_LANES		(25U) /**< 64-bit lanes of the state */
+#define XSECURE_SHA3_SW_RATE		(104U) /**< SHA3-384 rate in bytes */
+#define XSECURE_SHA3_SW_HASH_LEN	(48U) /**< SHA3-384 digest in bytes */
+
+#define XSECURE_SHA3_SW_NIST_PAD	(0x06U) /**< NIST SHA3 domain padding */
+#define XSECURE_SHA3_SW_KECCAK_PAD	(0x01U) /**< Keccak padding */
+
+/***************************** Type Definitions******************************/
+
+/**
+ * State of one software hash. Pos is the number of bytes of the current
+ * block already absorbed into Lanes.
+ */
+typedef struct {
+	u64 Lanes[XSECURE_SHA3_SW_LANES]; /**< Keccak state */
+	u32 Pos; /**< Bytes absorbed in the current block */
+} XSecure_Sha3SwCtx;
+
+/***************************** Function Prototypes ***************************/
+#ifdef XSECURE_SHA3_SW_ENGINE
+void XSecure_Sha3SwStart(XSecure_Sha3SwCtx *Ctx);
+void XSecure_Sha3SwUpdate(XSecure_Sha3SwCtx *Ctx, const u8 *Data, u32 Size);
+void XSecure_Sha3SwFinish(XSecure_Sha3SwCtx *Ctx, u8 PadByte, u8 *Hash);
+void XSecure_Sha3SwReadHash(const XSecure_Sha3SwCtx *Ctx, u8 *Hash);
+void XSecure_Sha3SwDigestMulti(u8 PadByte, const u8 * const In[],
+		const u32 Size[], u8 * const Out[], u32 Count);
+#endif
+/**
+@}
+@endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XSECURE_SHA3_SW_H */
+/* @} */
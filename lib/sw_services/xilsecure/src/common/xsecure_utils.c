@@ -40,6 +40,9 @@
 *       psl     03/26/19 Fixed MISRA-C violation
 *       psl     04/05/19 Fixed IAR warnings.
 * 4.1   psl     07/31/19 Fixed MISRA-C violation
+*       ag      10/16/26 XSecure_MemCpy uses the BSP Xil_MemCpy routine
+*       ag      10/16/26 Versal SSS configuration keeps the paths of other
+*                       resources
 * </pre>
 *
 ******************************************************************************/
@@ -47,6 +50,7 @@
 /***************************** Include Files *********************************/
 
 #include "xsecure_utils.h"
+#include "xil_mem.h"
 
 /************************** Constant Definitions *****************************/
 #ifdef XSECURE_VERSAL
@@ -243,6 +247,10 @@ static void XSecure_SssDmaSrc(u16 DmaId, XSecure_SssSrc *Resource)
  * @return	- XST_SUCCESS - on successful configuration of the switch
  *
  * @note	Resource, InputSrc, OutputSrc are of type XSecure_SssSrc.
+ *		On Versal only the paths of the given resource are updated,
+ *		so that a transfer on the other PMC DMA keeps its path. Paths
+ *		of other resources which take InputSrc or Resource as input
+ *		are released, as a source feeds a single resource.
  *
  *****************************************************************************/
 static u32 XSecure_SssCfg (XSecure_Sss *InstancePtr, XSecure_SssSrc Resource,
@@ -251,6 +259,11 @@ static u32 XSecure_SssCfg (XSecure_Sss *InstancePtr, XSecure_SssSrc Resource,
 	u32 InputSrcCfg = 0x00;
 	u32 OutputSrcCfg = 0x00;
 	u32 SssCfg = 0x00;
+#ifdef XSECURE_VERSAL
+	u32 Index;
+	u32 Shift;
+	u32 Field;
+#endif
 
 	/*
 	 * Configure source of the input for given resource
@@ -267,7 +280,22 @@ static u32 XSecure_SssCfg (XSecure_Sss *InstancePtr, XSecure_SssSrc Resource,
 	OutputSrcCfg = (u32) XSecure_SssLookupTable [OutputSrc][Resource] <<
 			(XSECURE_SSS_CFG_LEN_IN_BITS * (u32)OutputSrc);
 
+#ifdef XSECURE_VERSAL
+	SssCfg = XSecure_In32(InstancePtr->Address);
+	for (Index = 0U; Index < (u32)XSECURE_SSS_INVALID; Index++) {
+		Shift = XSECURE_SSS_CFG_LEN_IN_BITS * Index;
+		Field = (SssCfg >> Shift) & XSECURE_SSS_CFG_MASK;
+		if ((Index == (u32)Resource) || (Index == (u32)OutputSrc) ||
+			((Field != 0x00U) &&
+			((Field == XSecure_SssLookupTable[Index][InputSrc]) ||
+			(Field == XSecure_SssLookupTable[Index][Resource])))) {
+			SssCfg &= ~(XSECURE_SSS_CFG_MASK << Shift);
+		}
+	}
+	SssCfg |= InputSrcCfg | OutputSrcCfg;
+#else
 	SssCfg = InputSrcCfg | OutputSrcCfg;
+#endif
 
 	XSecure_Out32(InstancePtr->Address, SssCfg);
 
@@ -291,18 +319,7 @@ static u32 XSecure_SssCfg (XSecure_Sss *InstancePtr, XSecure_SssSrc Resource,
  *****************************************************************************/
 void* XSecure_MemCpy(void * DestPtr, const void * SrcPtr, u32 Len)
 {
-	u8 *Dst = (u8 *)(UINTPTR)DestPtr;
-	const u8 *Src = (const u8 *)SrcPtr;
-	u32 Length = Len;
-
-	/* Loop and copy.  */
-	while (Length != 0U)
-	{
-		*Dst = *Src;
-		Dst++;
-		Src++;
-		Length--;
-	}
+	Xil_MemCpy(DestPtr, SrcPtr, Len);
 
 	return DestPtr;
 }
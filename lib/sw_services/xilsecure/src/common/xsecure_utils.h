@@ -41,6 +41,7 @@
 * 4.0   vns     03/12/19 Initial Release
 * 4.1	kal	05/20/19 Updated doxygen tags
 *       psl     08/05/19 Fixed MISRA-C violation
+*       ag      10/16/26 Added XSECURE_SSS_CFG_MASK
 * </pre>
 * @endcond
 ******************************************************************************/
@@ -73,6 +74,7 @@ extern "C" {
 					/**< To take the core out of reset */
 
 #define XSECURE_SSS_CFG_LEN_IN_BITS	(4U) /**< Length is bits */
+#define XSECURE_SSS_CFG_MASK		(0xFU) /**< Mask of a resource path */
 
 #ifdef XSECURE_VERSAL
 #define XSECURE_SSS_ADDRESS		(0xF1110500U) /**< SSS base address */
@@ -93,64 +93,134 @@ static u32 MCapProcessRBT(FILE *fptr, u32 *buf)
 	return len;
 }
 
-static u32 MCapProcessBIT(FILE *fptr, u32 *buf, int sz)
+static const u8 *MCapFindSyncWord(const u8 *buf, size_t sz)
 {
-	int err;
-	u8 value, len = 0;
+	const u8 *p = buf, *end = buf + sz;
 
 	/*
 	 * .bit files are not guaranteed to be aligned with
 	 * the bitstream sync word on a 32-bit boundary. So,
-	 * we need to check every byte here.
+	 * memchr() looks for the first byte at any offset and
+	 * the others are checked where it is found.
 	 */
-	while ((err = fread(&value, 1, 1, fptr)) == 1) {
-		len++; if (value == MCAP_SYNC_BYTE0)
-		  if ((err = fread(&value, 1, 1, fptr)) == 1) {
-		    len++; if (value == MCAP_SYNC_BYTE1)
-		      if ((err = fread(&value, 1, 1, fptr)) == 1) {
-			len++; if (value == MCAP_SYNC_BYTE2)
-			  if ((err = fread(&value, 1, 1, fptr)) == 1) {
-				len++; if (value == MCAP_SYNC_BYTE3)
-					break;
-			  }
-		      }
-		}
+	while (end - p >= 4) {
+		p = memchr(p, MCAP_SYNC_BYTE0, end - p - 3);
+		if (!p)
+			break;
+		if (p[1] == MCAP_SYNC_BYTE1 && p[2] == MCAP_SYNC_BYTE2 &&
+		    p[3] == MCAP_SYNC_BYTE3)
+			return p;
+		p++;
 	}
 
-	if (err != 1 && !feof(fptr)) {
-		pr_err("Failed to Read BIT file\n");
-		return 0;
-	}
+	return NULL;
+}
 
-	if (err != 1 && feof(fptr)) {
-		pr_err("Failed to find SYNC Word in BIT file\n");
-		return 0;
+u32 MCapRegRead(struct mcap_dev *mdev, int offset)
+{
+	u32 value;
+
+	if (mdev->cfg_fd < 0)
+		return pci_read_long(mdev->pdev, mdev->reg_base + offset);
+
+	if (pread(mdev->cfg_fd, &value, 4, mdev->reg_base + offset) != 4)
+		return 0xFFFFFFFF;
+
+	return le32toh(value);
+}
+
+void MCapRegWrite(struct mcap_dev *mdev, int offset, u32 value)
+{
+	if (mdev->cfg_fd < 0) {
+		pci_write_long(mdev->pdev, mdev->reg_base + offset, value);
+		return;
 	}
 
-	*buf++ = __bswap_32(MCAP_SYNC_DWORD);
+	value = htole32(value);
+	if (pwrite(mdev->cfg_fd, &value, 4, mdev->reg_base + offset) != 4)
+		pr_err("Failed to write MCAP register 0x%x\n", offset);
+}
 
-	while ((err = fread(buf, sz - len, 1, fptr)) == 1)
-		;
+static int MCapWriteDataRegs(struct mcap_dev *mdev, const u32 *data,
+			     int len)
+{
+	off_t pos = mdev->reg_base + MCAP_DATA;
+	u32 value;
+	int count;
 
-	if (err != 1 && !feof(fptr)) {
-		pr_err("Failed to Read BIT file\n");
+	if (mdev->cfg_fd < 0) {
+		for (count = 0; count < len; count++)
+			pci_write_long(mdev->pdev, pos, data[count]);
 		return 0;
 	}
 
-	return (sz - len)/4 + 1;
+	/* The mock config space file, one dword at a time as on the bus */
+	for (count = 0; count < len; count++) {
+		value = htole32(data[count]);
+		if (pwrite(mdev->cfg_fd, &value, 4, pos) != 4)
+			return -EMCAPWRITE;
+	}
+
+	return 0;
 }
 
-static u32 MCapProcessBIN(FILE *fptr, u32 *buf, int sz)
+static double MCapElapsed(const struct timespec *start)
 {
-	int err;
+	struct timespec now;
 
-	err = fread(buf, sz, 1, fptr);
-	if (err != 1 && !feof(fptr)) {
-		pr_err("Failed to Read BIN file\n");
-		return 0;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (now.tv_sec - start->tv_sec) +
+		(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static int MCapWriteData(struct mcap_dev *mdev, const void *data,
+			 int len, u8 bswap)
+{
+	u32 chunk[MCAP_CHUNK_WORDS];
+	const u8 *src = data;
+	struct timespec start;
+	int count, n, i, err, report = MCAP_PROGRESS_WORDS;
+	double secs;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (count = 0; count < len; count += n) {
+		n = len - count;
+		if (n > MCAP_CHUNK_WORDS)
+			n = MCAP_CHUNK_WORDS;
+
+		/* The data need not be aligned, as in a mapped .bit file */
+		memcpy(chunk, src + (size_t)count * 4, (size_t)n * 4);
+		if (bswap) {
+			for (i = 0; i < n; i++)
+				chunk[i] = __bswap_32(chunk[i]);
+		}
+
+		err = MCapWriteDataRegs(mdev, chunk, n);
+		if (err) {
+			pr_err("\nFailed to Write Bitstream Data\n");
+			return err;
+		}
+
+		if (count + n >= report && count + n < len) {
+			secs = MCapElapsed(&start);
+			pr_info("\rProgramming: %3d%% (%d of %d KB, %.2f MB/s)",
+				(int)((count + n) * 100LL / len),
+				(count + n) / 256, len / 256,
+				secs > 0 ? (count + n) * 4 / secs / 1e6 : 0);
+			fflush(stdout);
+			report += MCAP_PROGRESS_WORDS;
+		}
 	}
 
-	return sz/4;
+	secs = MCapElapsed(&start);
+	if (len > MCAP_PROGRESS_WORDS)
+		pr_info("\n");
+	pr_info("Wrote %d KB in %.3f s (%.2f MB/s)\n", len / 256, secs,
+		secs > 0 ? len * 4.0 / secs / 1e6 : 0);
+
+	return 0;
 }
 
 static int MCapDoBusWalk(struct mcap_dev *mdev)
@@ -220,11 +290,11 @@ static int Checkforcompletion(struct mcap_dev *mdev)
 	return 0;
 }
 
-static int MCapWritePartialBitStream(struct mcap_dev *mdev, u32 *data,
+static int MCapWritePartialBitStream(struct mcap_dev *mdev, const void *data,
 					int len, u8 bswap)
 {
 	u32 set, restore;
-	int err, count = 0, i;
+	int err, i;
 
 	if (!data || !len) {
 		pr_err("Invalid Arguments\n");
@@ -254,12 +324,10 @@ static int MCapWritePartialBitStream(struct mcap_dev *mdev, u32 *data,
 	MCapRegWrite(mdev, MCAP_CONTROL, set);
 
 	/* Write Data */
-	if (!bswap) {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, data[count]);
-	} else {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, __bswap_32(data[count]));
+	err = MCapWriteData(mdev, data, len, bswap);
+	if (err) {
+		MCapRegWrite(mdev, MCAP_CONTROL, restore);
+		return err;
 	}
 
 	for (i = 0 ; i < EMCAP_EOS_LOOP_COUNT; i++) {
@@ -283,11 +351,11 @@ static int MCapWritePartialBitStream(struct mcap_dev *mdev, u32 *data,
 	return 0;
 }
 
-static int MCapWriteBitStream(struct mcap_dev *mdev, u32 *data,
+static int MCapWriteBitStream(struct mcap_dev *mdev, const void *data,
 			      int len, u8 bswap)
 {
 	u32 set, restore;
-	int err, count = 0;
+	int err;
 
 	if (!data || !len) {
 		pr_err("Invalid Arguments\n");
@@ -319,12 +387,10 @@ static int MCapWriteBitStream(struct mcap_dev *mdev, u32 *data,
 	}
 
 	/* Write Data */
-	if (!bswap) {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, data[count]);
-	} else {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, __bswap_32(data[count]));
+	err = MCapWriteData(mdev, data, len, bswap);
+	if (err) {
+		MCapRegWrite(mdev, MCAP_CONTROL, restore);
+		return err;
 	}
 
 	/* Check for Completion */
@@ -350,21 +416,56 @@ static int MCapWriteBitStream(struct mcap_dev *mdev, u32 *data,
 void MCapLibFree(struct mcap_dev *mdev)
 {
 	if (mdev) {
-		pci_cleanup(mdev->pacc);
+		if (mdev->cfg_fd >= 0)
+			close(mdev->cfg_fd);
+		if (mdev->pacc)
+			pci_cleanup(mdev->pacc);
 		free(mdev);
 	}
 }
 
+static struct mcap_dev *MCapMockInit(const char *path)
+{
+	struct mcap_dev *mdev;
+
+	mdev = calloc(1, sizeof(struct mcap_dev));
+	if (!mdev)
+		return NULL;
+
+	mdev->reg_base = MCAP_MOCK_REG_BASE;
+	mdev->is_mock = 1;
+	mdev->cfg_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (mdev->cfg_fd < 0 ||
+	    ftruncate(mdev->cfg_fd, MCAP_CONFIG_SIZE)) {
+		pr_err("Unable to create the mock config space %s\n", path);
+		MCapLibFree(mdev);
+		return NULL;
+	}
+
+	/* An idle device that signals end of startup once programmed */
+	MCapRegWrite(mdev, MCAP_EXT_CAP_HEADER, MCAP_EXT_CAP_ID);
+	MCapRegWrite(mdev, MCAP_STATUS, MCAP_STS_EOS_MASK);
+	pr_info("Mock MCAP device, config space in %s\n", path);
+
+	return mdev;
+}
+
 struct mcap_dev *MCapLibInit(int device_id)
 {
 	struct pci_dev *dev;
 	struct mcap_dev *mdev;
+	const char *mock = getenv(MCAP_MOCK_ENV);
+
+	if (mock)
+		return MCapMockInit(mock);
 
 	/* Allocate MCAP device */
-	mdev = malloc(sizeof(struct mcap_dev));
+	mdev = calloc(1, sizeof(struct mcap_dev));
 	if (!mdev)
 		return NULL;
 
+	mdev->cfg_fd = -1;
+
 	/* Get the pci_access structure */
 	mdev->pacc = pci_alloc();
 
@@ -591,41 +692,56 @@ void MCapDumpRegs(struct mcap_dev *mdev)
 
 int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type)
 {
-	FILE *fptr;
-	u32 *data;
-	u32 binsz, wrdatasz;
-	int err = 0;
+	FILE *fptr = NULL;
+	struct stat st;
+	const u8 *map = MAP_FAILED, *sync;
+	const void *data = NULL;
+	u32 *buf = NULL;
+	u32 wrdatasz = 0;
+	int fd, err = -EMCAPCFG;
 	u8 bswap = 0;
 
-	/* Get the size */
-	fptr = fopen(file_path, "rb");
-	if (fptr == NULL)
+	fd = open(file_path, O_RDONLY);
+	if (fd < 0)
 		return -EMCAPCFG;
-	fseek(fptr, 0L, SEEK_END);
-	binsz = ftell(fptr);
-	fseek(fptr, 0L, SEEK_SET);
-
-	/* Allocate the buffer */
-	data = malloc(binsz);
-	if (data == NULL)
+	if (fstat(fd, &st) || !st.st_size) {
+		close(fd);
 		return -EMCAPCFG;
+	}
 
 	/* Process files and Read the data */
 	if (MCapFindTypeofFile(file_path, MCAP_RBT_FILE)) {
 
-		/* Read the RBT file */
-		wrdatasz = MCapProcessRBT(fptr, data);
-
-	} else if (MCapFindTypeofFile(file_path, MCAP_BIT_FILE)) {
-
-		/* Read the BIT file */
-		wrdatasz = MCapProcessBIT(fptr, data, binsz);
-		bswap = 1;
-
-	} else if (MCapFindTypeofFile(file_path, MCAP_BIN_FILE)) {
+		/* Read the RBT file, one word per line of text */
+		fptr = fdopen(fd, "r");
+		buf = malloc(st.st_size);
+		if (fptr == NULL || buf == NULL)
+			goto free_resources;
+		wrdatasz = MCapProcessRBT(fptr, buf);
+		data = buf;
+
+	} else if (MCapFindTypeofFile(file_path, MCAP_BIT_FILE) ||
+		   MCapFindTypeofFile(file_path, MCAP_BIN_FILE)) {
+
+		/* Map the BIT/BIN file, the words are swapped as written */
+		map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map == MAP_FAILED) {
+			pr_err("Failed to Read %s\n", file_path);
+			goto free_resources;
+		}
+		madvise((void *)map, st.st_size, MADV_SEQUENTIAL);
 
-		/* Read the BIN file */
-		wrdatasz = MCapProcessBIN(fptr, data, binsz);
+		if (MCapFindTypeofFile(file_path, MCAP_BIT_FILE)) {
+			sync = MCapFindSyncWord(map, st.st_size);
+			if (!sync) {
+				pr_err("Failed to find SYNC Word in BIT file\n");
+				goto free_resources;
+			}
+		} else {
+			sync = map;
+		}
+		data = sync;
+		wrdatasz = (st.st_size - (sync - map)) / 4;
 		bswap = 1;
 
 	} else {
@@ -633,26 +749,37 @@ int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type)
 		pr_err(" due to .bit/.bin/.rbt files does not exist at the.");
 		pr_err(" specified location, Please cross check the");
 		pr_err(" path is correct or not\n");
+		err = 0;
 		goto free_resources;
 	}
 
 	/* Program FPGA */
+	err = 0;
 	if (bitfile_type == EMCAP_PARTIALCONFIG_FILE) {
 		err = MCapWritePartialBitStream(mdev, data, wrdatasz, bswap);
-		if (err)
-			return -EMCAPCFG;
+		if (err) {
+			err = -EMCAPCFG;
+			goto free_resources;
+		}
 		pr_info("FPGA Partial Configuration Done!!\n");
 	} else if (bitfile_type == EMCAP_CONFIG_FILE) {
 		err = MCapWriteBitStream(mdev, data, wrdatasz, bswap);
-		if (err)
-			return -EMCAPCFG;
+		if (err) {
+			err = -EMCAPCFG;
+			goto free_resources;
+		}
 		pr_info("FPGA Configuration Done!!\n");
 	}
 
 free_resources:
-	if (data)
-		free(data);
-	fclose(fptr);
+	if (map != MAP_FAILED)
+		munmap((void *)map, st.st_size);
+	if (buf)
+		free(buf);
+	if (fptr)
+		fclose(fptr);
+	else
+		close(fd);
 
 	return err;
 }
@@ -662,6 +789,11 @@ int MCapAccessConfigSpace(struct mcap_dev *mdev, int argc, char **argv)
 	unsigned long wrval, rdval;
 	int pos, access_type;
 
+	if (mdev->is_mock) {
+		pr_err("Not supported on the mock device\n");
+		return -EMCAPCFGACC;
+	}
+
 	pos = (int) strtol(argv[4], NULL, 16);
 	access_type = tolower(argv[5][0]);
 
@@ -708,6 +840,11 @@ int MCapShowDevice(struct mcap_dev *mdev, int verbose)
 	char command[80];
 	u16 vendor_id, device_id;
 
+	if (mdev->is_mock) {
+		pr_info("Mock MCAP device\n");
+		return 0;
+	}
+
 	vendor_id = mdev->pdev->vendor_id;
 	device_id = mdev->pdev->device_id;
 
@@ -34,6 +34,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <endian.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 
 #include "pci.h"
@@ -69,6 +76,21 @@
 #define MCAP_STS_FIFO_OCCUPANCY_MASK	(15 << 12)
 #define MCAP_STS_CFG_MCAP_REQ_MASK	(1 << 24)
 
+/* Words copied out of the image and byte-swapped at a time */
+#define MCAP_CHUNK_WORDS	4096
+
+/* Words written between progress reports */
+#define MCAP_PROGRESS_WORDS	(256 * 1024)
+
+/*
+ * Mock device: when this environment variable names a file, it is used as
+ * the config space of an MCAP device instead of a PCI device, so that the
+ * write path can be timed on a host without an FPGA.
+ */
+#define MCAP_MOCK_ENV		"MCAP_MOCK_CONFIG"
+#define MCAP_MOCK_REG_BASE	0x340
+#define MCAP_CONFIG_SIZE	4096
+
 /* Maximum FIFO Depth */
 #define MCAP_FIFO_DEPTH		16
 
@@ -110,14 +132,10 @@ struct mcap_dev {
 	struct pci_access *pacc;
 	unsigned int reg_base;
 	u32 is_multiplebit;
+	int cfg_fd;		/* Mock config space file, -1 for libpci */
+	int is_mock;
 };
 
-#define MCapRegWrite(mdev, offset, value) \
-	pci_write_long(mdev->pdev, mdev->reg_base + offset, value)
-
-#define MCapRegRead(mdev, offset) \
-	pci_read_long(mdev->pdev, mdev->reg_base + offset)
-
 #define IsResetSet(mdev) \
 	(MCapRegRead(mdev, MCAP_CONTROL) & \
 		MCAP_CTRL_RESET_MASK ? 1 : 0)
@@ -147,6 +165,8 @@ struct mcap_dev {
 		MCAP_STS_REG_READ_COUNT_MASK) >> 5)
 
 /* Function Prototypes */
+u32 MCapRegRead(struct mcap_dev *mdev, int offset);
+void MCapRegWrite(struct mcap_dev *mdev, int offset, u32 value);
 struct mcap_dev *MCapLibInit(int device_id);
 void MCapLibFree(struct mcap_dev *mdev);
 void MCapDumpRegs(struct mcap_dev *mdev);